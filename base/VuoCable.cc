@@ -8,6 +8,7 @@
  */
 
 #include "VuoCable.hh"
+#include "VuoComposition.hh"
 #include "VuoPublishedPort.hh"
 
 /**
@@ -82,6 +83,8 @@ void VuoCable::setFrom(VuoNode *fromNode, VuoPort *fromPort)
 
 	this->fromPort = fromPort;
 	this->fromNode = fromNode;
+
+	VuoComposition::structureChanged();
 }
 
 /**
@@ -103,6 +106,8 @@ void VuoCable::setTo(VuoNode *toNode, VuoPort *toPort)
 
 	this->toPort = toPort;
 	this->toNode = toNode;
+
+	VuoComposition::structureChanged();
 }
 
 /**
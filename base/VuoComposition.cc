@@ -13,6 +13,10 @@
 #include "VuoProtocol.hh"
 #include "VuoPublishedPort.hh"
 #include "VuoStringUtilities.hh"
+#include <atomic>
+
+/// Incremented each time a node, cable, or published port is added to, removed from, or reconnected within any composition.
+static std::atomic<unsigned long> structureVersion(1);
 
 /**
  * Creates an empty composition.
@@ -76,6 +80,7 @@ string VuoComposition::getDirectory(void)
 void VuoComposition::addNode(VuoNode *node)
 {
 	nodes.insert(node);
+	structureChanged();
 }
 
 /**
@@ -86,6 +91,7 @@ void VuoComposition::addNode(VuoNode *node)
 void VuoComposition::removeNode(VuoNode *node)
 {
 	nodes.erase(node);
+	structureChanged();
 }
 
 /**
@@ -104,6 +110,7 @@ set<VuoNode *> VuoComposition::getNodes(void)
 void VuoComposition::addCable(VuoCable *cable)
 {
 	cables.insert(cable);
+	structureChanged();
 }
 
 /**
@@ -115,6 +122,7 @@ void VuoComposition::removeCable(VuoCable *cable)
 	cable->setTo(NULL, NULL);
 
 	cables.erase(cable);
+	structureChanged();
 }
 
 /**
@@ -155,6 +163,7 @@ set<VuoComment *> VuoComposition::getComments(void)
 void VuoComposition::addPublishedInputPort(VuoPublishedPort *port, int index)
 {
 	publishedInputPorts.insert(publishedInputPorts.begin() + index, port);
+	structureChanged();
 }
 
 /**
@@ -163,6 +172,7 @@ void VuoComposition::addPublishedInputPort(VuoPublishedPort *port, int index)
 void VuoComposition::addPublishedOutputPort(VuoPublishedPort *port, int index)
 {
 	publishedOutputPorts.insert(publishedOutputPorts.begin() + index, port);
+	structureChanged();
 }
 
 /**
@@ -171,6 +181,7 @@ void VuoComposition::addPublishedOutputPort(VuoPublishedPort *port, int index)
 void VuoComposition::removePublishedInputPort(int index)
 {
 	publishedInputPorts.erase(publishedInputPorts.begin() + index);
+	structureChanged();
 }
 
 /**
@@ -179,6 +190,7 @@ void VuoComposition::removePublishedInputPort(int index)
 void VuoComposition::removePublishedOutputPort(int index)
 {
 	publishedOutputPorts.erase(publishedOutputPorts.begin() + index);
+	structureChanged();
 }
 
 /**
@@ -278,3 +290,26 @@ vector<VuoPublishedPort *> VuoComposition::getProtocolAwarePublishedPortOrder(Vu
 
 	return sortedPublishedPorts;
 }
+
+/**
+ * Returns a number that changes whenever the structure of any composition in this process — its nodes, cables,
+ * published ports, or the endpoints of its cables — may have changed.
+ *
+ * This lets a cached analysis of a composition's structure (such as VuoCompilerGraph) cheaply check
+ * whether it's still current.
+ */
+unsigned long VuoComposition::getStructureVersion(void)
+{
+	return structureVersion;
+}
+
+/**
+ * Indicates that the structure of some composition may have changed, for the sake of getStructureVersion().
+ *
+ * The add/remove functions of this class and VuoCable::setFrom() / VuoCable::setTo() call this automatically.
+ * Other code that modifies a composition's structure in place should call it, too.
+ */
+void VuoComposition::structureChanged(void)
+{
+	++structureVersion;
+}
@@ -58,6 +58,9 @@ public:
 	int getIndexOfPublishedPort(VuoPublishedPort *port, bool isInput);
 	vector<VuoPublishedPort *> getProtocolAwarePublishedPortOrder(VuoProtocol *protocol, bool publishedInputs);
 
+	static unsigned long getStructureVersion(void);
+	static void structureChanged(void);
+
 private:
 	VuoCompositionMetadata *metadata;
 	bool ownsMetadata;
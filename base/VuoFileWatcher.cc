@@ -7,18 +7,43 @@
  * For more information, see https://vuo.org/license.
  */
 
+#include <CoreServices/CoreServices.h>
 #include <dirent.h>
+#include <sys/stat.h>
 #include "VuoFileWatcher.hh"
+#include "VuoFileUtilities.hh"
+#include "VuoStringUtilities.hh"
 
+const double VuoFileWatcher::defaultCoalescingWindowSeconds = 0.25;  ///< How long to wait (during a rapid series of events) before notifying the delegate, unless otherwise specified.
+const double VuoFileWatcher::streamLatencySeconds = 0.05;  ///< How long FSEvents waits to collect events before passing them to this class.
 const double VuoFileWatcher::checkIntervalSeconds = 2;  ///< How frequently to recheck for the existence of a file/folder.
-const double VuoFileWatcher::changeNotificationDelaySeconds = 0.25;  ///< How long to wait (during a rapid series of events) before notifying the delegate.
+
+/**
+ * The FSEvents stream through which a @ref VuoFileWatcher receives changes.
+ * Defined here so that VuoFileWatcher.hh doesn't need to include CoreServices.
+ */
+struct VuoFileWatcher::Stream
+{
+	FSEventStreamRef ref;  ///< The stream.
+
+	/**
+	 * Receives events from the FSEvents stream.
+	 *
+	 * @threadQueue{queue}
+	 */
+	static void callback(ConstFSEventStreamRef stream, void *info, size_t numEvents, void *eventPaths, const FSEventStreamEventFlags eventFlags[], const FSEventStreamEventId eventIds[])
+	{
+		VuoFileWatcher *watcher = static_cast<VuoFileWatcher *>(info);
+		watcher->eventsReceived(numEvents, static_cast<char **>(eventPaths), eventFlags);
+	}
+};
 
 /**
  * Starts watching a file or folder.
  *
  * If @a persistent is true:
- * If the file/folder doesn't exist, or exists and is later deleted or moved/renamed,
- * it is periodically checked for existence, then watching begins (again).
+ * If the file/folder doesn't exist, it is periodically checked for existence, then watching begins.
+ * If it exists and is later deleted or moved/renamed, watching resumes when it reappears.
  *
  * If @a persistent is false:
  * If the file/folder doesn't exist, this class instance does nothing.
@@ -26,131 +51,167 @@ const double VuoFileWatcher::changeNotificationDelaySeconds = 0.25;  ///< How lo
  * this class instance stops watching it
  * (even if another file/folder with the same name later reappears,
  * or if the same file/folder is renamed back into place).
+ *
+ * @param delegate The object to notify of changes.
+ * @param fileOrFolderToWatch The path of the file or folder.
+ * @param persistent See above.
+ * @param coalescingWindowSeconds How long to wait for further changes before notifying @a delegate.
+ *     Each change observed during the wait restarts the wait.
  */
-VuoFileWatcher::VuoFileWatcher(VuoFileWatcherDelegate *delegate, const string &fileOrFolderToWatch, bool persistent)
+VuoFileWatcher::VuoFileWatcher(VuoFileWatcherDelegate *delegate, const string &fileOrFolderToWatch, bool persistent, double coalescingWindowSeconds)
 {
+	this->delegate = delegate;
+	this->fileToWatch = fileOrFolderToWatch;
+	this->persistent = persistent;
+	this->coalescingWindowSeconds = coalescingWindowSeconds;
+	this->stream = NULL;
+	this->isWatching = false;
+	this->periodicCheckForExistence = NULL;
+	this->periodicCheckForExistenceRunning = dispatch_group_create();
+	this->changeNotificationDelay = NULL;
+	this->changeNotificationDelayRunning = dispatch_group_create();
+
+	// Remove any trailing slashes, so that paths within the folder can be formed by appending to it.
+	while (fileToWatch.length() > 1 && VuoStringUtilities::endsWith(fileToWatch, "/"))
+		fileToWatch.erase(fileToWatch.length() - 1);
+
 	queue = dispatch_queue_create("org.vuo.filewatcher", NULL);
 	dispatch_sync(queue, ^{
-		initialize(delegate, fileOrFolderToWatch, persistent, NULL);
+		struct stat s;
+		if (stat(fileToWatch.c_str(), &s) == 0)
+		{
+			startWatching();
+		}
+		else if (errno == ENOENT)
+		{
+			if (persistent)
+				periodicallyCheckForExistence();
+		}
+		else
+		{
+			VUserLog("Error: Couldn't access '%s': %s", fileToWatch.c_str(), strerror(errno));
+		}
 	});
 }
 
 /**
- * Private constructor for child watchers.
- */
-VuoFileWatcher::VuoFileWatcher(VuoFileWatcherDelegate *delegate, const string &fileOrFolderToWatch, bool persistent, VuoFileWatcher *parent)
-{
-	queue = parent->queue;
-	initialize(delegate, fileOrFolderToWatch, persistent, parent);
-}
-
-/**
- * Helper function for constructors.
+ * Starts an FSEvents stream that watches @ref fileToWatch and everything inside it.
+ *
+ * If @ref fileToWatch is a file rather than a folder, the stream watches the folder containing it,
+ * and events for other files in the folder are ignored.
  *
  * @threadQueue{queue}
  */
-void VuoFileWatcher::initialize(VuoFileWatcherDelegate *delegate, const string &fileOrFolderToWatch, bool persistent, VuoFileWatcher *parent)
+void VuoFileWatcher::startWatching()
 {
-	this->parent = parent;
-	this->fileToWatch = fileOrFolderToWatch;
-	this->delegate = delegate;
-	this->persistent = persistent;
-	this->fileToWatchSource = NULL;
-	this->fileToWatchSourceRunning = dispatch_group_create();
-	this->reopen = false;
-	this->periodicCheckForExistence = NULL;
-	this->periodicCheckForExistenceRunning = dispatch_group_create();
-	this->childWatchersQueue = dispatch_queue_create("org.vuo.filewatcher.child", NULL);
-	this->changeNotificationDelay = NULL;
-	this->changeNotificationDelayRunning = dispatch_group_create();
-
-	DIR *d = opendir(fileOrFolderToWatch.c_str());
-	if (d)
-	{
-		closedir(d);
-		startWatching();
-	}
-	else if (errno == ENOTDIR)
+	// FSEvents reports paths with symlinks resolved, so resolve them in the path being watched, too.
+	char resolvedPath[PATH_MAX];
+	if (! realpath(fileToWatch.c_str(), resolvedPath))
 	{
-		startWatching();
+		VUserLog("Error: Couldn't resolve '%s': %s", fileToWatch.c_str(), strerror(errno));
+		return;
 	}
-	else if (errno == ENOENT)
+	resolvedFileToWatch = resolvedPath;
+	isWatching = true;
+
+	if (stream)
+		return;  // Already watching — the file/folder was removed and has reappeared.
+
+	string folderToWatch = resolvedFileToWatch;
+	struct stat s;
+	if (stat(resolvedFileToWatch.c_str(), &s) == 0 && ! S_ISDIR(s.st_mode))
 	{
-		if (persistent)
-			periodicallyCheckForExistence();
+		string file, extension;
+		VuoFileUtilities::splitPath(resolvedFileToWatch, folderToWatch, file, extension);
 	}
-	else
+
+	CFStringRef pathCF = CFStringCreateWithCString(NULL, folderToWatch.c_str(), kCFStringEncodingUTF8);
+	CFArrayRef pathsCF = CFArrayCreate(NULL, (const void **)&pathCF, 1, &kCFTypeArrayCallBacks);
+	FSEventStreamContext context = { 0, this, NULL, NULL, NULL };
+	stream = new Stream;
+	stream->ref = FSEventStreamCreate(NULL, &Stream::callback, &context, pathsCF, kFSEventStreamEventIdSinceNow, streamLatencySeconds,
+									  kFSEventStreamCreateFlagFileEvents | kFSEventStreamCreateFlagWatchRoot | kFSEventStreamCreateFlagNoDefer);
+	CFRelease(pathsCF);
+	CFRelease(pathCF);
+
+	FSEventStreamSetDispatchQueue(stream->ref, queue);
+	if (! FSEventStreamStart(stream->ref))
 	{
-		VUserLog("Error: Couldn't access '%s': %s", fileOrFolderToWatch.c_str(), strerror(errno));
+		VUserLog("Error: Couldn't start watching '%s'.", fileToWatch.c_str());
+		FSEventStreamInvalidate(stream->ref);
+		FSEventStreamRelease(stream->ref);
+		delete stream;
+		stream = NULL;
+		isWatching = false;
 	}
 }
 
 /**
- * Starts watching @ref fileToWatch and, if it's a directory, the files it contains.
+ * Classifies each event from the FSEvents stream as an addition, modification, or removal,
+ * and records it to be passed along to the delegate.
+ *
+ * The flags on an event may describe several things that happened to the path since the last event,
+ * so whether the path still exists is what determines whether it was added or removed.
  *
  * @threadQueue{queue}
  */
-void VuoFileWatcher::startWatching()
+void VuoFileWatcher::eventsReceived(size_t numEvents, const char * const *eventPaths, const uint32_t eventFlags[])
 {
-	fileToWatchFD = open(fileToWatch.c_str(), O_EVTONLY);
-	if (fileToWatchFD < 0)
-	{
-		VUserLog("Error: %s", strerror(errno));
+	if (! isWatching)
 		return;
-	}
 
-	dispatch_group_enter(fileToWatchSourceRunning);
-
-	unsigned long mask = DISPATCH_VNODE_DELETE | DISPATCH_VNODE_RENAME | DISPATCH_VNODE_WRITE;
-	fileToWatchSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_VNODE, fileToWatchFD, mask, queue);
-	dispatch_source_set_event_handler(fileToWatchSource, ^{
-		unsigned long l = dispatch_source_get_data(fileToWatchSource);
+	for (size_t i = 0; i < numEvents; ++i)
+	{
+		string resolvedPath = eventPaths[i];
+		FSEventStreamEventFlags flags = eventFlags[i];
 
-		if (l & DISPATCH_VNODE_DELETE
-		 || l & DISPATCH_VNODE_RENAME)
+		if (flags & (kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagUserDropped | kFSEventStreamEventFlagKernelDropped))
 		{
-			DIR *d = opendir(fileToWatch.c_str());
-			if (d)
-			{
-				// got a delete event, but it still exists and is a folder — not sure how this could happen
-				closedir(d);
-			}
-			else if (errno == ENOTDIR)
-			{
-				changeObserved();
-				reopen = true;
-				dispatch_source_cancel(fileToWatchSource);
-			}
-			else if (errno == ENOENT)
-			{
-				changeObserved();
-				dispatch_source_cancel(fileToWatchSource);
-				if (persistent)
-					periodicallyCheckForExistence();
-			}
-		}
-		else if (l & DISPATCH_VNODE_WRITE)
-		{
-			changeObserved();
-			updateChildWatchers();
+			// FSEvents couldn't keep up, so it doesn't know exactly what changed.
+			changeObserved(fileToWatch, Modified);
+			continue;
 		}
-	});
-	dispatch_source_set_cancel_handler(fileToWatchSource, ^{
-		close(fileToWatchFD);
 
-		dispatch_release(fileToWatchSource);
-		fileToWatchSource = NULL;
-		dispatch_group_leave(fileToWatchSourceRunning);
+		bool isRoot = (flags & kFSEventStreamEventFlagRootChanged) || resolvedPath == resolvedFileToWatch;
+		if (! isRoot && ! VuoStringUtilities::beginsWith(resolvedPath, resolvedFileToWatch + "/"))
+			continue;  // Another file in the folder containing the file being watched.
+
+		string path = isRoot ? fileToWatch : fileToWatch + resolvedPath.substr(resolvedFileToWatch.length());
 
-		if (reopen)
+		if (VuoStringUtilities::endsWith(path, "/.DS_Store"))
+			continue;
+
+		struct stat s;
+		bool exists = (lstat((isRoot ? resolvedFileToWatch : resolvedPath).c_str(), &s) == 0);
+
+		if (! exists)
+			changeObserved(path, Removed);
+		else if (flags & (kFSEventStreamEventFlagItemCreated | kFSEventStreamEventFlagItemRenamed | kFSEventStreamEventFlagRootChanged))
+			changeObserved(path, Added);
+		else
+			changeObserved(path, Modified);
+
+		if (isRoot && ! exists && ! persistent)
 		{
-			reopen = false;
-			startWatching();
+			// Ignore the file/folder if it reappears. The stream is released when this watcher is destroyed.
+			isWatching = false;
+			break;
 		}
-	});
-	dispatch_resume(fileToWatchSource);
+	}
+}
 
-	updateChildWatchers();
+/**
+ * @private method for TestVuoFileWatcher.
+ *
+ * Behaves as if FSEvents reported that it had dropped events, so the delegate should rescan everything.
+ */
+void VuoFileWatcher::simulateDroppedEvents(void)
+{
+	dispatch_sync(queue, ^{
+		const char *eventPath = resolvedFileToWatch.c_str();
+		uint32_t eventFlags = kFSEventStreamEventFlagUserDropped;
+		eventsReceived(1, &eventPath, &eventFlags);
+	});
 }
 
 /**
@@ -166,11 +227,10 @@ void VuoFileWatcher::periodicallyCheckForExistence()
 	periodicCheckForExistence = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
 	dispatch_source_set_timer(periodicCheckForExistence, dispatch_time(DISPATCH_TIME_NOW, checkIntervalSeconds*NSEC_PER_SEC), checkIntervalSeconds*NSEC_PER_SEC, checkIntervalSeconds*NSEC_PER_SEC/10);
 	dispatch_source_set_event_handler(periodicCheckForExistence, ^{
-		DIR *d = opendir(fileToWatch.c_str());
-		if (d)
+		struct stat s;
+		if (stat(fileToWatch.c_str(), &s) == 0)
 		{
-			closedir(d);
-			changeObserved();
+			changeObserved(fileToWatch, Added);
 			startWatching();
 			dispatch_source_cancel(periodicCheckForExistence);
 		}
@@ -184,91 +244,61 @@ void VuoFileWatcher::periodicallyCheckForExistence()
 }
 
 /**
- * If @ref fileToWatch is a directory, starts watching any of the files in it that are not already
- * being watched, and stops watching (if not persistent) or starts checking for the recreation of
- * (if persistent) any files that were being watched but have disappeared.
+ * Records a change to @a path, and coalesces multiple rapid changes into a single delegate notification.
+ *
+ * Successive changes to the same path are combined. For example, a file that's added then modified is reported as added,
+ * and a file that's removed then added (replaced) is reported as modified. A file that's added then removed isn't reported.
  *
  * @threadQueue{queue}
  */
-void VuoFileWatcher::updateChildWatchers()
+void VuoFileWatcher::changeObserved(const string &path, Change change)
 {
-	DIR *d = opendir(fileToWatch.c_str());
-	if (!d)
-		return;
-
-	__block vector<VuoFileWatcher *> childWatchersToDestroy;
-	dispatch_sync(childWatchersQueue, ^{
-
-	// Add new child watchers for new files/folders.
-	struct dirent *de;
-	while ((de = readdir(d)) != NULL)
+	map<string, Change>::iterator pendingIter = pendingChanges.find(path);
+	if (pendingIter == pendingChanges.end())
+		pendingChanges[path] = change;
+	else if (pendingIter->second == Added)
 	{
-		if (strcmp(de->d_name, ".") == 0
-		 || strcmp(de->d_name, "..") == 0
-		 || strcmp(de->d_name, ".DS_Store") == 0)
-			continue;
-
-		string compositePath = fileToWatch + '/' + de->d_name;
-
-		bool haveExistingWatcher = false;
-		for (vector<VuoFileWatcher *>::iterator i = childWatchers.begin(); i != childWatchers.end(); ++i)
-			if ((*i)->fileToWatch == compositePath)
-			{
-				haveExistingWatcher = true;
-				break;
-			}
-
-		if (haveExistingWatcher)
-			continue;
-
-		childWatchers.push_back(new VuoFileWatcher(delegate, compositePath, false, this));
+		if (change == Removed)
+			pendingChanges.erase(pendingIter);
 	}
-
-	// Remove obsolete child watchers.
-	for (vector<VuoFileWatcher *>::iterator i = childWatchers.begin(); i != childWatchers.end(); )
+	else if (pendingIter->second == Removed)
 	{
-		if (!(*i)->fileToWatchSource
-		 && !(*i)->periodicCheckForExistence)
-		{
-			childWatchersToDestroy.push_back(*i);
-			i = childWatchers.erase(i);
-		}
-		else
-			++i;
+		if (change != Removed)
+			pendingIter->second = Modified;
 	}
-
-	});
-
-	for (VuoFileWatcher *childWatcher : childWatchersToDestroy)
-		delete childWatcher;
-
-	closedir(d);
-}
-
-/**
- * Coalesces multiple rapid changes into a single delegate notification.
- *
- * @threadQueue{queue}
- */
-void VuoFileWatcher::changeObserved()
-{
-	if (parent)
+	else
 	{
-		parent->changeObserved();
-		return;
+		if (change == Removed)
+			pendingIter->second = Removed;
 	}
 
 	if (changeNotificationDelay)
 		// Push the timer back.
-		dispatch_source_set_timer(changeNotificationDelay, dispatch_time(DISPATCH_TIME_NOW, changeNotificationDelaySeconds*NSEC_PER_SEC), DISPATCH_TIME_FOREVER, changeNotificationDelaySeconds*NSEC_PER_SEC/10);
+		dispatch_source_set_timer(changeNotificationDelay, dispatch_time(DISPATCH_TIME_NOW, coalescingWindowSeconds*NSEC_PER_SEC), DISPATCH_TIME_FOREVER, coalescingWindowSeconds*NSEC_PER_SEC/10);
 	else
 	{
 		dispatch_group_enter(changeNotificationDelayRunning);
 
 		changeNotificationDelay = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
-		dispatch_source_set_timer(changeNotificationDelay, dispatch_time(DISPATCH_TIME_NOW, changeNotificationDelaySeconds*NSEC_PER_SEC), DISPATCH_TIME_FOREVER, changeNotificationDelaySeconds*NSEC_PER_SEC/10);
+		dispatch_source_set_timer(changeNotificationDelay, dispatch_time(DISPATCH_TIME_NOW, coalescingWindowSeconds*NSEC_PER_SEC), DISPATCH_TIME_FOREVER, coalescingWindowSeconds*NSEC_PER_SEC/10);
 		dispatch_source_set_event_handler(changeNotificationDelay, ^{
-			delegate->fileChanged(fileToWatch);
+			set<string> pathsAdded;
+			set<string> pathsModified;
+			set<string> pathsRemoved;
+			for (const map<string, Change>::value_type &i : pendingChanges)
+			{
+				if (i.second == Added)
+					pathsAdded.insert(i.first);
+				else if (i.second == Modified)
+					pathsModified.insert(i.first);
+				else
+					pathsRemoved.insert(i.first);
+			}
+			pendingChanges.clear();
+
+			if (! (pathsAdded.empty() && pathsModified.empty() && pathsRemoved.empty()))
+				delegate->filesChanged(fileToWatch, pathsAdded, pathsModified, pathsRemoved);
+
 			dispatch_source_cancel(changeNotificationDelay);
 		});
 		dispatch_source_set_cancel_handler(changeNotificationDelay, ^{
@@ -281,42 +311,33 @@ void VuoFileWatcher::changeObserved()
 }
 
 /**
- * Stops watching the folder.
+ * Stops watching the file or folder.
  */
 VuoFileWatcher::~VuoFileWatcher()
 {
-	__block vector<VuoFileWatcher *> childWatchersCopy;
-	dispatch_sync(childWatchersQueue, ^{
-		childWatchersCopy = childWatchers;
-		childWatchers.clear();
-	});
+	dispatch_sync(queue, ^{
+		if (stream)
+		{
+			FSEventStreamStop(stream->ref);
+			FSEventStreamInvalidate(stream->ref);
+			FSEventStreamRelease(stream->ref);
+			delete stream;
+			stream = NULL;
+		}
+		isWatching = false;
 
-	for (VuoFileWatcher *childWatcher : childWatchersCopy)
-		delete childWatcher;
+		if (periodicCheckForExistence)
+			dispatch_source_cancel(periodicCheckForExistence);
 
-	if (fileToWatchSource)
-	{
-		dispatch_source_cancel(fileToWatchSource);
-		dispatch_group_wait(fileToWatchSourceRunning, DISPATCH_TIME_FOREVER);
-	}
-	dispatch_release(fileToWatchSourceRunning);
+		if (changeNotificationDelay)
+			dispatch_source_cancel(changeNotificationDelay);
+	});
 
-	if (periodicCheckForExistence)
-	{
-		dispatch_source_cancel(periodicCheckForExistence);
-		dispatch_group_wait(periodicCheckForExistenceRunning, DISPATCH_TIME_FOREVER);
-	}
+	dispatch_group_wait(periodicCheckForExistenceRunning, DISPATCH_TIME_FOREVER);
 	dispatch_release(periodicCheckForExistenceRunning);
 
-	if (changeNotificationDelay)
-	{
-		dispatch_source_cancel(changeNotificationDelay);
-		dispatch_group_wait(changeNotificationDelayRunning, DISPATCH_TIME_FOREVER);
-	}
+	dispatch_group_wait(changeNotificationDelayRunning, DISPATCH_TIME_FOREVER);
 	dispatch_release(changeNotificationDelayRunning);
 
-	if (! parent)
-		dispatch_release(queue);
-
-	dispatch_release(childWatchersQueue);
+	dispatch_release(queue);
 }
@@ -18,7 +18,7 @@ class VuoFileWatcherDelegate
 {
 public:
 	/**
-	 * This delegate method is invoked each time the file watcher detects a change in the folder
+	 * This delegate method is invoked each time the file watcher detects changes in the folder
 	 * being watched (or one of its subfolders).
 	 *
 	 *    - a file/folder is added to or removed from the folder (or its subfolders)
@@ -28,47 +28,66 @@ public:
 	 * (such as when multiple files are copied into a folder,
 	 * or when a file is edited by a tempfile-using editor like `vim`).
 	 *
+	 * The paths begin with @a fileBeingWatched. If the operating system wasn't able to report individual changes,
+	 * @a pathsModified contains @a fileBeingWatched itself, meaning that anything within it may have changed.
+	 *
 	 * @param fileBeingWatched The file path that was passed to @ref VuoFileWatcher::VuoFileWatcher.
+	 * @param pathsAdded The files/folders that were created or moved into place.
+	 * @param pathsModified The files/folders whose contents or attributes were modified, or that were replaced.
+	 * @param pathsRemoved The files/folders that were deleted or moved away.
 	 */
-	virtual void fileChanged(const string &fileBeingWatched) = 0;
+	virtual void filesChanged(const string &fileBeingWatched, const set<string> &pathsAdded, const set<string> &pathsModified, const set<string> &pathsRemoved) = 0;
 };
 
 /**
  * Notifies a delegate about changes to a file or folder.
+ *
+ * A folder and all of its subfolders are watched through a single FSEvents stream.
+ * A file is watched through a stream on the folder containing it.
  */
 class VuoFileWatcher
 {
 public:
-	VuoFileWatcher(VuoFileWatcherDelegate *delegate, const string &fileToWatch, bool persistent=true);
+	VuoFileWatcher(VuoFileWatcherDelegate *delegate, const string &fileToWatch, bool persistent=true, double coalescingWindowSeconds=defaultCoalescingWindowSeconds);
 	~VuoFileWatcher();
 
+	static const double defaultCoalescingWindowSeconds;
+
+	void simulateDroppedEvents(void);
+
 private:
-	VuoFileWatcher *parent;
+	/**
+	 * The kinds of changes reported to the delegate.
+	 */
+	enum Change
+	{
+		Added,
+		Modified,
+		Removed
+	};
+
 	VuoFileWatcherDelegate *delegate;
 	string fileToWatch;
 	bool persistent;
+	double coalescingWindowSeconds;
 	dispatch_queue_t queue;
 
-	VuoFileWatcher(VuoFileWatcherDelegate *delegate, const string &fileToWatch, bool persistent, VuoFileWatcher *parent);
-	void initialize(VuoFileWatcherDelegate *delegate, const string &fileToWatch, bool persistent, VuoFileWatcher *parent);
+	struct Stream;
 
 	void startWatching();
-	int fileToWatchFD;
-	dispatch_source_t fileToWatchSource;
-	dispatch_group_t fileToWatchSourceRunning;
-	bool reopen;
+	Stream *stream;
+	string resolvedFileToWatch;
+	bool isWatching;
+	void eventsReceived(size_t numEvents, const char * const *eventPaths, const uint32_t eventFlags[]);
+	static const double streamLatencySeconds;
 
 	void periodicallyCheckForExistence();
 	dispatch_source_t periodicCheckForExistence;
 	dispatch_group_t periodicCheckForExistenceRunning;
 	static const double checkIntervalSeconds;
 
-	void updateChildWatchers();
-	vector<VuoFileWatcher *> childWatchers;
-	dispatch_queue_t childWatchersQueue;
-
-	void changeObserved();
+	void changeObserved(const string &path, Change change);
+	map<string, Change> pendingChanges;
 	dispatch_source_t changeNotificationDelay;
 	dispatch_group_t changeNotificationDelayRunning;
-	static const double changeNotificationDelaySeconds;
 };
@@ -8,6 +8,7 @@
  */
 
 #include "VuoPortClass.hh"
+#include "VuoComposition.hh"
 
 /**
  * Creates a base port class.
@@ -36,6 +37,9 @@ string VuoPortClass::getName(void)
 void VuoPortClass::setName(string name)
 {
 	this->name = name;
+
+	// Published ports are renamed in place.
+	VuoComposition::structureChanged();
 }
 
 /**
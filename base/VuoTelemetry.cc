@@ -59,6 +59,17 @@ extern "C" void vuoInitMessageWithBool(zmq_msg_t *message, bool value)
 	memcpy(zmq_msg_data(message), &value, messageSize);
 }
 
+/**
+ * Copies the unsigned long value into the message data, as a 64-bit integer.
+ */
+extern "C" void vuoInitMessageWithUnsignedInt64(zmq_msg_t *message, unsigned long value)
+{
+	uint64_t number = value;
+	size_t messageSize = sizeof(number);
+	zmq_msg_init_size(message, messageSize);
+	memcpy(zmq_msg_data(message), &number, messageSize);
+}
+
 /**
  * Returns true if there are more messages to receive on the socket currently.
  */
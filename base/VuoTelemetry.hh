@@ -10,6 +10,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "zmq/zmq.h"
 
 /**
@@ -240,7 +241,13 @@ enum VuoControlRequest
 	 * Includes data message-parts:
 	 *      @arg @c char *compositionIdentifier;
 	 */
-	VuoControlRequestAllTelemetryUnsubscribe
+	VuoControlRequestAllTelemetryUnsubscribe,
+
+	/**
+	 * Request that the composition send node execution and port update telemetry
+	 * in batches (@ref VuoTelemetryBatch) rather than as individual messages.
+	 */
+	VuoControlRequestTelemetryBatchingEnable
 };
 
 /**
@@ -442,7 +449,12 @@ enum VuoControlReply
 	/**
 	 * The composition has stopped sending all telemetry.
 	 */
-	VuoControlReplyAllTelemetryUnsubscribed
+	VuoControlReplyAllTelemetryUnsubscribed,
+
+	/**
+	 * The composition has started sending node execution and port update telemetry in batches.
+	 */
+	VuoControlReplyTelemetryBatchingEnabled
 };
 
 /**
@@ -589,9 +601,59 @@ enum VuoTelemetry
 	/**
 	 * Published when a node in the composition requests that the composition stop.
 	 */
-	VuoTelemetryStopRequested
+	VuoTelemetryStopRequested,
+
+	/**
+	 * Published along with a heartbeat when the counts of node claims (see VuoNodeSynchronization)
+	 * have changed since they were last published. The counts are cumulative since the composition started.
+	 *
+	 * Includes data message-parts:
+	 *		@arg @c unsigned long uncontendedClaims;
+	 *		@arg @c unsigned long spinningClaims;
+	 *		@arg @c unsigned long parkedClaims;
+	 */
+	VuoTelemetryNodeSynchronizationStats,
+
+	/**
+	 * Published about once per frame, after @ref VuoControlRequestTelemetryBatchingEnable,
+	 * in place of the individual @ref VuoTelemetryNodeExecutionStarted, @ref VuoTelemetryNodeExecutionFinished,
+	 * @ref VuoTelemetryInputPortsUpdated, and @ref VuoTelemetryOutputPortsUpdated messages that occurred since the last batch.
+	 * Also published just before any other telemetry message, so batched telemetry isn't reordered relative to it.
+	 *
+	 * Includes data message-parts:
+	 *		@arg @c char strings[]; — A table of the strings referenced by the records, each null-terminated.
+	 *		@arg @c VuoTelemetryRecord records[]; — In the order the telemetry occurred.
+	 */
+	VuoTelemetryBatch
+};
+
+/**
+ * Bits of @ref VuoTelemetryRecord::flags.
+ */
+enum VuoTelemetryRecordFlag
+{
+	VuoTelemetryRecordFlagEvent = 1 << 0,	///< The port received/sent an event.
+	VuoTelemetryRecordFlagData = 1 << 1	///< The port received/sent data.
 };
 
+/**
+ * One item of telemetry within a @ref VuoTelemetryBatch message.
+ */
+typedef struct
+{
+	uint8_t type;	///< The @ref VuoTelemetry type this record stands in for.
+	uint8_t flags;	///< A combination of @ref VuoTelemetryRecordFlag values (for port updates).
+	uint16_t reserved;	///< Padding; always 0.
+	uint32_t compositionIdentifier;	///< Index into the batch's string table.
+	uint32_t identifier;	///< Index into the batch's string table: the node identifier (for node execution) or port identifier (for port updates).
+	uint32_t portDataSummary;	///< Index into the batch's string table, or @ref VuoTelemetryRecord_noSummary.
+} VuoTelemetryRecord;
+
+/**
+ * A @ref VuoTelemetryRecord::portDataSummary value indicating that the record doesn't include a summary.
+ */
+#define VuoTelemetryRecord_noSummary UINT32_MAX
+
 
 extern "C" {
 
@@ -599,6 +661,7 @@ char * vuoCopyStringFromMessage(zmq_msg_t *message);
 void vuoInitMessageWithString(zmq_msg_t *message, const char *string);
 void vuoInitMessageWithInt(zmq_msg_t *message, int value);
 void vuoInitMessageWithBool(zmq_msg_t *message, bool value);
+void vuoInitMessageWithUnsignedInt64(zmq_msg_t *message, unsigned long value);
 bool VuoTelemetry_hasMoreToReceive(void *socket);
 char * vuoReceiveAndCopyString(void *socket, char **error);
 unsigned long vuoReceiveUnsignedInt64(void *socket, char **error);
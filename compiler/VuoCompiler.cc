@@ -15,6 +15,8 @@
 #include <sys/stat.h>
 #include <sstream>
 #include <CoreFoundation/CoreFoundation.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Target/TargetMachine.h>
 #include "VuoClangIssues.hh"
 #include "VuoCompilerBitcodeGenerator.hh"
 #include "VuoCompilerCodeGenUtilities.hh"
@@ -47,6 +49,7 @@
 #include "VuoNode.hh"
 #include "VuoNodeClass.hh"
 #include "VuoNodeSet.hh"
+#include "VuoObjectCodeCache.hh"
 #include "VuoPublishedPort.hh"
 #include "VuoRunner.hh"
 #include "VuoRunningCompositionLibraries.hh"
@@ -65,6 +68,7 @@ map<VuoCompilerEnvironment *, set<VuoCompilerModule *>> VuoCompiler::addedModule
 map<VuoCompilerEnvironment *, set<pair<VuoCompilerModule *, VuoCompilerModule *>>> VuoCompiler::modifiedModulesAwaitingReification;
 dispatch_group_t VuoCompiler::moduleSourceCompilersExistGlobally = dispatch_group_create();
 string VuoCompiler::vuoFrameworkInProgressPath;
+bool VuoCompiler::shouldCompileModulesInParallel = false;
 
 dispatch_queue_t llvmQueue = NULL;  ///< Synchronizes access to LLVM's global context. Don't call environmentQueue from this queue.
 
@@ -89,6 +93,8 @@ static void __attribute__((constructor)) VuoCompiler_init(void)
 					  // llvm::InitializeNativeTarget();
 					  llvm::InitializeAllTargetMCs();
 					  llvm::InitializeAllTargets();
+					  llvm::InitializeAllAsmPrinters();  // Needed for codegen to object files in VuoCompiler::writeModuleToObjectFile.
+					  llvm::InitializeAllAsmParsers();
 					  // TargetRegistry::printRegisteredTargetsForVersion();
 
 					  VuoCompiler::globalLLVMContext = new llvm::LLVMContext;
@@ -2046,6 +2052,7 @@ VuoModuleCompiler * VuoCompiler::createModuleCompiler(const string &moduleKey, c
 
 	settings.target = target;
 	settings.isVerbose = isVerbose;
+	settings.shouldUseOwnLLVMContext = shouldCompileModulesInParallel;
 
 	settings.vuoFrameworkPath = getVuoFrameworkPath();
 	if (settings.vuoFrameworkPath.empty())
@@ -3160,30 +3167,59 @@ void VuoCompiler::prepareModuleCaches(void)
  * @param target The LLVM target-triple to build.
  * @param onlyGenerateModules If true, this function only generates the modules for the module cache's
  *    compiled modules directory; it doesn't create the module cache dylib.
+ * @param compileInParallel Whether to compile the modules in parallel (see @ref setShouldCompileModulesInParallel).
+ *    This only applies during this call; the setting for compilers constructed later in this process isn't changed.
  * @version200New
  */
-void VuoCompiler::generateBuiltInModuleCache(string vuoFrameworkPath, string target, bool onlyGenerateModules)
+void VuoCompiler::generateBuiltInModuleCache(string vuoFrameworkPath, string target, bool onlyGenerateModules, bool compileInParallel)
 {
 	vuoFrameworkInProgressPath = vuoFrameworkPath;
 
+	bool wasCompilingModulesInParallel = shouldCompileModulesInParallel;
+	shouldCompileModulesInParallel = compileInParallel;
+
 	// Delete the non-built-in caches to ensure that all specialized modules that are dependencies of built-in modules
 	// will be generated and saved to the built-in cache rather than being loaded from a non-built-in cache.
 	string cachePath = VuoFileUtilities::getCachePath();
 	if (! cachePath.empty())
 		VuoFileUtilities::deleteDir(cachePath);
 
-	VuoCompiler compiler("", target);
-	compiler.generatedEnvironment = compiler.environments.at(0).at(1);
-
-	if (onlyGenerateModules)
 	{
-		compiler.loadModulesIfNeeded();
-		dispatch_group_wait(compiler.moduleSourceCompilersExist, DISPATCH_TIME_FOREVER);
-	}
-	else
-	{
-		compiler.makeModuleCachesAvailable(false, true, target);
+		VuoCompiler compiler("", target);
+		compiler.generatedEnvironment = compiler.environments.at(0).at(1);
+
+		if (onlyGenerateModules)
+		{
+			compiler.loadModulesIfNeeded();
+			dispatch_group_wait(compiler.moduleSourceCompilersExist, DISPATCH_TIME_FOREVER);
+		}
+		else
+		{
+			compiler.makeModuleCachesAvailable(false, true, target);
+		}
 	}
+
+	shouldCompileModulesInParallel = wasCompilingModulesInParallel;
+	vuoFrameworkInProgressPath = "";
+}
+
+/**
+ * Controls whether C/C++/Objective-C modules (including specializations of generic node classes and types)
+ * are compiled in parallel.
+ *
+ * By default, all LLVM code generation happens one module at a time in the global LLVM context.
+ * When this is enabled, each module is instead generated in an LLVM context of its own and transferred
+ * to the global context afterward as bitcode, so independent modules — for example, those being compiled
+ * while building a module cache — can be compiled simultaneously on separate threads.
+ *
+ * The compiled modules are equivalent either way, and each module's code doesn't depend on the order
+ * in which the modules happen to finish compiling.
+ *
+ * This applies to all VuoCompiler instances in the process.
+ */
+void VuoCompiler::setShouldCompileModulesInParallel(bool shouldCompileModulesInParallel)
+{
+	VuoCompiler::shouldCompileModulesInParallel = shouldCompileModulesInParallel;
 }
 
 /**
@@ -3238,37 +3274,72 @@ void VuoCompiler::link(string outputPath, const VuoLinkerInputs &linkerInputs,
 		ownsIssues = true;
 	}
 
-	// Write all the modules with renamed symbols to a composite module file (since the linker can't operate on in-memory modules).
-	string compositeModulePath = VuoFileUtilities::makeTmpFile("composite", "bc");
-	dispatch_sync(llvmQueue, ^{
-					  double t0 = VuoLogGetTime();
+	// Generate native code for the in-memory modules and the bitcode files (since the linker can't operate on them directly),
+	// reusing the object file from a previous link for each module that hasn't changed.
+	// The modules' bitcode is hashed rather than compared by name, since a module can change without being renamed.
 
-					  unique_ptr<Module> compositeModule(new Module("composite", *globalLLVMContext));
-					  Linker linker(*compositeModule);
-					  setTargetForModule(compositeModule.get(), target);
+	double codegenStartTime = VuoLogGetTime();
+	VuoObjectCodeCache *objectCodeCache = VuoObjectCodeCache::getSharedCache();
+	vector<string> objectPaths;
+	vector<string> tmpObjectPaths;
+	unsigned long objectFilesReused = 0;
+	unsigned long objectFilesCacheable = 0;
 
-					  for (auto i : linkerInputs.getModules())
-					  {
-						  unique_ptr<Module> upi = llvm::CloneModule(i);
-						  if (linker.linkInModule(std::move(upi)))
-						  {
-							  VuoCompilerIssue issue(VuoCompilerIssue::IssueType::Error, "linking composite module", "",
-													 "", "Failed to link in the module with ID '" + i->getModuleIdentifier() + "'");
-							  issues->append(issue);
-						  }
-					  }
+	auto generateObjectFile = [this, issues] (Module *module, string objectPath)
+	{
+		__block bool ok = false;
+		dispatch_sync(llvmQueue, ^{
+			try
+			{
+				verifyModule(module, issues);
+				writeModuleToObjectFile(module, target, objectPath, issues);
+				ok = true;
+			}
+			catch (VuoCompilerException &e) {}
+		});
 
-					  try
-					  {
-						  verifyModule(compositeModule.get(), issues);
-						  writeModuleToBitcode(compositeModule.get(), target, compositeModulePath, issues);
-					  }
-					  catch (VuoCompilerException &e) {}
+		if (! ok)
+			throw VuoCompilerException(issues, false);
+	};
 
-					  double linkModulesTime = VuoLogGetTime() - t0;
-					  if (linkModulesTime > 0.1)
-						  VUserLog("\tLinkModules took %5.2fs", linkModulesTime);
-				  });
+	auto useCachedObjectFile = [&] (const string &bitcodeHash, std::function<void(const string &)> generate)
+	{
+		try
+		{
+			bool wasReused, isTemporary;
+			string objectPath = objectCodeCache->useObjectFile(bitcodeHash, target, generate, wasReused, isTemporary);
+			objectPaths.push_back(objectPath);
+			if (isTemporary)
+				tmpObjectPaths.push_back(objectPath);
+
+			++objectFilesCacheable;
+			if (wasReused)
+				++objectFilesReused;
+		}
+		catch (VuoCompilerException &e)
+		{
+			if (e.getIssues() != issues)
+				issues->append(e.getIssues());
+		}
+	};
+
+	set<Module *> modules = linkerInputs.getModules();
+	__block map<Module *, string> bitcodeHashForModule;
+	dispatch_sync(llvmQueue, ^{
+		for (Module *module : modules)
+		{
+			string bitcode;
+			raw_string_ostream out(bitcode);
+			llvm::WriteBitcodeToFile(module, out);
+			out.flush();
+			bitcodeHashForModule[module] = VuoStringUtilities::calculateSHA256(bitcode);
+		}
+	});
+
+	for (Module *module : modules)
+		useCachedObjectFile(bitcodeHashForModule[module], [&generateObjectFile, module] (const string &objectPath) {
+			generateObjectFile(module, objectPath);
+		});
 
 
 	// llvm-3.1/llvm/tools/clang/tools/driver/driver.cpp
@@ -3286,31 +3357,100 @@ void VuoCompiler::link(string outputPath, const VuoLinkerInputs &linkerInputs,
 		argsToFree.push_back(outputPathZ);
 	}
 
-	args.push_back(compositeModulePath.c_str());
+	// Pass the objects to the linker before the libraries, so that archive members they depend on get loaded.
+	vector<const char *> libraryArgs;
 
 	vector<string> coreDependencies = getCoreVuoDependencies();
+	set<string> externalLibraries = linkerInputs.getExternalLibraries();
 	for (string library : linkerInputs.getLibraries())
 	{
 		for (vector<string>::iterator j = coreDependencies.begin(); j != coreDependencies.end(); ++j)
 		{
 			string coreDependency = *j;
 			if (VuoStringUtilities::endsWith(library, "lib" + coreDependency + ".a"))
-				args.push_back("-force_load");  // Load all symbols of static core dependencies, not just those used in the objects.
+				libraryArgs.push_back("-force_load");  // Load all symbols of static core dependencies, not just those used in the objects.
 		}
 
-		// Use the pre-built native object file if it exists (faster than converting .bc to .o every build).
 		if (VuoStringUtilities::endsWith(library, ".bc"))
 		{
+			// Use the pre-built native object file if it exists (faster than converting .bc to .o every build).
 			string libraryObject = VuoStringUtilities::substrBefore(library, ".bc") + ".o";
 			if (VuoFileUtilities::fileExists(libraryObject))
 				library = libraryObject;
+			else
+			{
+				auto generateObjectFileFromBitcodeFile = [this, &generateObjectFile, library] (const string &objectPath)
+				{
+					Module *module = readModuleFromBitcode(library, getTargetArch(target));
+					if (! module)
+					{
+						VuoCompilerIssue issue(VuoCompilerIssue::Error, "linking composition", library, "", "Couldn't read the bitcode file.");
+						throw VuoCompilerException(issue);
+					}
+					VuoDefer(^{ destroyLlvmModule(module); });
+
+					generateObjectFile(module, objectPath);
+				};
+
+				if (externalLibraries.find(library) != externalLibraries.end())
+				{
+					// Bitcode files from outside the environments (such as the compiled composition) typically change
+					// every time they're linked, so generate them fresh rather than filling up the cache.
+					string dir, file, ext;
+					VuoFileUtilities::splitPath(library, dir, file, ext);
+					string objectPath = VuoFileUtilities::makeTmpFile(file, "o");
+					tmpObjectPaths.push_back(objectPath);
+					try
+					{
+						generateObjectFileFromBitcodeFile(objectPath);
+						objectPaths.push_back(objectPath);
+					}
+					catch (VuoCompilerException &e)
+					{
+						if (e.getIssues() != issues)
+							issues->append(e.getIssues());
+					}
+				}
+				else
+				{
+					useCachedObjectFile(VuoFileUtilities::calculateFileSHA256(library), generateObjectFileFromBitcodeFile);
+				}
+
+				continue;
+			}
 		}
 
 		char *libraryZ = strdup(library.c_str());
-		args.push_back(libraryZ);
+		libraryArgs.push_back(libraryZ);
 		argsToFree.push_back(libraryZ);
 	}
 
+	if (objectFilesCacheable > 0)
+		VUserLog("\tCodegen     took %5.2fs (reused %lu of %lu object files from the cache, %.0f%%)",
+				 VuoLogGetTime() - codegenStartTime, objectFilesReused, objectFilesCacheable, 100. * objectFilesReused / objectFilesCacheable);
+
+	auto deleteTmpObjectFiles = [&tmpObjectPaths] ()
+	{
+		for (const string &objectPath : tmpObjectPaths)
+			VuoFileUtilities::deleteFile(objectPath);
+	};
+
+	if (issues->hasErrors())
+	{
+		for (auto i : argsToFree)
+			free(i);
+		deleteTmpObjectFiles();
+		throw VuoCompilerException(issues, ownsIssues);
+	}
+
+	for (const string &objectPath : objectPaths)
+	{
+		char *objectPathZ = strdup(objectPath.c_str());
+		args.push_back(objectPathZ);
+		argsToFree.push_back(objectPathZ);
+	}
+	args.insert(args.end(), libraryArgs.begin(), libraryArgs.end());
+
 	// Add framework search paths
 	vector<string> frameworkArguments;
 
@@ -3438,8 +3578,7 @@ void VuoCompiler::link(string outputPath, const VuoLinkerInputs &linkerInputs,
 	for (auto i : argsToFree)
 		free(i);
 
-	// Clean up composite module file.
-	remove(compositeModulePath.c_str());
+	deleteTmpObjectFiles();
 
 	if (!isDylib)
 		// Ensure the linked binary has the execute permission set
@@ -3681,6 +3820,51 @@ void VuoCompiler::writeModuleToBitcode(Module *module, string target, string out
 	llvm::WriteBitcodeToFile(module, out);
 }
 
+/**
+ * Generates native code for a copy of the module (leaving @a module unchanged) and writes it to @a outputPath
+ * (a Mach-O object file), so that the linker doesn't have to convert the bitcode itself.
+ *
+ * @throw VuoCompilerException Code generation or writing failed.
+ *
+ * @threadQueue{llvmQueue}
+ */
+void VuoCompiler::writeModuleToObjectFile(Module *module, string target, string outputPath, VuoCompilerIssues *issues)
+{
+	auto fail = [module, issues] (const string &details)
+	{
+		VuoCompilerIssue issue(VuoCompilerIssue::Error, "linking composition", "", "Code generation failed for module '" + module->getModuleIdentifier() + "'",
+							   details);
+		issue.setModuleKey(module->getModuleIdentifier());
+		issues->append(issue);
+		throw VuoCompilerException(issues, false);
+	};
+
+	unique_ptr<Module> moduleCopy = llvm::CloneModule(module);
+	setTargetForModule(moduleCopy.get(), target);
+
+	string error;
+	auto llvmTarget = TargetRegistry::lookupTarget(moduleCopy->getTargetTriple(), error);
+	if (! llvmTarget)
+		fail("Couldn't look up target: " + error);
+
+	unique_ptr<TargetMachine> targetMachine(llvmTarget->createTargetMachine(moduleCopy->getTargetTriple(), "", "", TargetOptions(),
+																			 Reloc::PIC_, Optional<CodeModel::Model>(), CodeGenOpt::None));
+	if (! targetMachine)
+		fail("Couldn't create target machine.");
+
+	std::error_code err;
+	raw_fd_ostream out(outputPath.c_str(), err, sys::fs::F_None);
+	if (err)
+		fail("Couldn't write to '" + outputPath + "': " + err.message());
+
+	legacy::PassManager passManager;
+	if (targetMachine->addPassesToEmitFile(passManager, out, TargetMachine::CGFT_ObjectFile))
+		fail("The target can't emit object files.");
+
+	passManager.run(*moduleCopy);
+	out.flush();
+}
+
 /**
  * Sets the target triple and data layout for @a module, using the architecture and OS
  * from @a targetTriple and a default OS version.
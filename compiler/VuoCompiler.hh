@@ -80,6 +80,7 @@ private:
 	VuoDirectedAcyclicNetwork *dependencyGraph;  ///< A full dependency graph, containing all modules that have been loaded and their dependencies.
 	VuoDirectedAcyclicNetwork *compositionDependencyGraph;  ///< A partial dependency graph, containing all subcompositions (loaded or not) and the node classes that are their direct dependencies.
 	static string vuoFrameworkInProgressPath;  ///< The path to use for Vuo.framework during a call to @ref VuoCompiler::generateBuiltInModuleCaches.
+	static bool shouldCompileModulesInParallel;  ///< If true, module compilers generate each module in its own LLVM context instead of waiting their turn for `llvmQueue`.
 	string clangPath;
 	string target;  ///< The LLVM target triple (architecture, vendor, OS) used when compiling a module or composition.
 	string requestedTarget;  ///< The LLVM target triple that the caller specified when creating this VuoCompiler instance (or empty if none).
@@ -117,6 +118,7 @@ private:
 	static Module *readModuleFromBitcodeData(char *inputData, size_t inputDataBytes, string arch, set<string> &availableArchs, string &error);
 	static void verifyModule(Module *module, VuoCompilerIssues *issues);
 	static void writeModuleToBitcode(Module *module, string target, string outputPath, VuoCompilerIssues *issues);
+	static void writeModuleToObjectFile(Module *module, string target, string outputPath, VuoCompilerIssues *issues);
 	VuoNode * createPublishedNode(const string &nodeClassName, const vector<VuoPublishedPort *> &publishedPorts);
 	static void setTargetForModule(Module *module, string target);
 	static string getProcessTarget(void);
@@ -170,7 +172,8 @@ public:
 	set<string> getDylibDependencyPathsForComposition(VuoCompilerComposition *composition);
 	VuoCompilerCompatibility getCompatibilityOfDependencies(const set<string> &dependencies);
 	void prepareModuleCaches(void);
-	static void generateBuiltInModuleCache(string vuoFrameworkPath, string target, bool onlyGenerateModules);
+	static void generateBuiltInModuleCache(string vuoFrameworkPath, string target, bool onlyGenerateModules, bool compileInParallel = true);
+	static void setShouldCompileModulesInParallel(bool shouldCompileModulesInParallel);
 	string getTarget(void);
 	string getArch(void);
 	static string getTargetArch(string target);
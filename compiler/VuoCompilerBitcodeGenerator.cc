@@ -727,10 +727,9 @@ void VuoCompilerBitcodeGenerator::generateCompositionPerformDataOnlyTransmission
 		Function *subcompositionFunctionSrc = node->getBase()->getNodeClass()->getCompiler()->getCompositionPerformDataOnlyTransmissionsFunction();
 		if (subcompositionFunctionSrc)
 		{
-			Value *runtimeStateValue = VuoCompilerCodeGenUtilities::generateGetCompositionStateRuntimeState(module, block, compositionStateValue);
 			Value *compositionIdentifierValue = VuoCompilerCodeGenUtilities::generateGetCompositionStateCompositionIdentifier(module, block, compositionStateValue);
 			Value *subcompositionIdentifierValue = node->generateSubcompositionIdentifierValue(module, block, compositionIdentifierValue);
-			Value *subcompositionStateValue = VuoCompilerCodeGenUtilities::generateCreateCompositionState(module, block, runtimeStateValue, subcompositionIdentifierValue);
+			Value *subcompositionStateValue = VuoCompilerCodeGenUtilities::generateCreateSubcompositionState(module, block, compositionStateValue, node->getIndexInOrderedNodes(), subcompositionIdentifierValue);
 			Value *subcompositionStateValueDst = new BitCastInst(subcompositionStateValue, subcompositionFunctionSrc->getFunctionType()->getParamType(0), "", block);
 
 			// Copy the subcomposition node's input port values to the subcomposition's published input node's input ports.
@@ -1579,7 +1578,8 @@ void VuoCompilerBitcodeGenerator::generateCompositionGetPortValueFunction(void)
  *
  *     if (shouldSendTelemetry)
  *     {
- *       sendInputPortsUpdated(portIdentifier, false, true, summary);
+ *       unsigned long portIndex = vuoGetPortIndexForPort(compositionState, portIdentifier);
+ *       sendInputPortsUpdated(nodeIndex, portIndex, portIdentifier, false, true, summary);
  *       free(summary);
  *     }
  *   }
@@ -1780,7 +1780,8 @@ void VuoCompilerBitcodeGenerator::generateCompositionSetPortValueFunction(void)
 
 	// if (shouldSendTelemetry)
 	// {
-	//   sendInputPortsUpdated(portIdentifier, false, true, summary);
+	//   unsigned long portIndex = vuoGetPortIndexForPort(compositionState, portIdentifier);
+	//   sendInputPortsUpdated(nodeIndex, portIndex, portIdentifier, false, true, summary);
 	//   free(summary);
 	// }
 
@@ -1788,8 +1789,9 @@ void VuoCompilerBitcodeGenerator::generateCompositionSetPortValueFunction(void)
 	BranchInst::Create(sendBlock, finalBlock, shouldSendTelemetryIsTrue, checkSendBlock);
 
 	Value *summaryValue = new LoadInst(summaryVariable, "", false, sendBlock);
+	Value *portIndexValue = VuoCompilerCodeGenUtilities::generateGetPortIndexForPort(module, sendBlock, compositionStateValue, portIdentifierValue);
 
-	VuoCompilerCodeGenUtilities::generateSendInputPortsUpdated(module, sendBlock, compositionStateValue, portIdentifierValue,
+	VuoCompilerCodeGenUtilities::generateSendInputPortsUpdated(module, sendBlock, compositionStateValue, nodeIndexValue, portIndexValue, portIdentifierValue,
 															   false, true, summaryValue);
 
 	VuoCompilerCodeGenUtilities::generateFreeCall(module, sendBlock, summaryValue);
@@ -2582,20 +2584,21 @@ void VuoCompilerBitcodeGenerator::generateTransmissionFromOutputPort(Function *f
 		{
 			VuoCompilerCable *cable = *i;
 
+			VuoCompilerNode *inputNode = cable->getBase()->getToNode()->getCompiler();
 			VuoCompilerPort *inputPort = static_cast<VuoCompilerPort *>(cable->getBase()->getToPort()->getCompiler());
 			ICmpInst *shouldSendDataForInput = VuoCompilerCodeGenUtilities::generateShouldSendDataTelemetryComparison(module, currentBlock,
-																													  inputPort->getIdentifier(),
-																													  compositionStateValue,
-																													  constantsCache);
+																													  inputNode->getIndexInOrderedNodes(),
+																													  inputPort->getIndexInPortContexts(),
+																													  compositionStateValue);
 			shouldSummarizeInput[inputPort] = shouldSendDataForInput;
 		}
 
 		if (dataPointer)
 		{
 			Value *shouldSummarizeOutput = VuoCompilerCodeGenUtilities::generateShouldSendDataTelemetryComparison(module, currentBlock,
-																												  outputPort->getIdentifier(),
-																												  compositionStateValue,
-																												  constantsCache);
+																												  outputNode->getIndexInOrderedNodes(),
+																												  outputPort->getIndexInPortContexts(),
+																												  compositionStateValue);
 
 			for (set<VuoCompilerCable *>::iterator i = outgoingCables.begin(); i != outgoingCables.end(); ++i)
 			{
@@ -2630,9 +2633,11 @@ void VuoCompilerBitcodeGenerator::generateTransmissionFromOutputPort(Function *f
 			Value *dataSummaryValue = new LoadInst(dataSummaryVariable, "", false, currentBlock);
 
 			Constant *outputPortIdentifierValue = constantsCache->get(outputPort->getIdentifier());
+			Constant *outputNodeIndexValue = ConstantInt::get(module->getContext(), APInt(64, outputNode->getIndexInOrderedNodes()));
+			Constant *outputPortIndexValue = ConstantInt::get(module->getContext(), APInt(64, outputPort->getIndexInPortContexts()));
 
-			VuoCompilerCodeGenUtilities::generateSendOutputPortsUpdated(module, currentBlock, compositionStateValue, outputPortIdentifierValue,
-																		transmittedEventValue, sentDataValue, dataSummaryValue);
+			VuoCompilerCodeGenUtilities::generateSendOutputPortsUpdated(module, currentBlock, compositionStateValue, outputNodeIndexValue, outputPortIndexValue,
+																		outputPortIdentifierValue, transmittedEventValue, sentDataValue, dataSummaryValue);
 		}
 	}
 
@@ -2710,9 +2715,11 @@ void VuoCompilerBitcodeGenerator::generateTransmissionFromOutputPort(Function *f
 			Value *inputDataSummaryValue = new LoadInst(inputDataSummaryVariable, "", false, transmissionBlock);
 
 			Constant *inputPortIdentifierValue = constantsCache->get(inputPort->getIdentifier());
+			Constant *inputNodeIndexValue = ConstantInt::get(module->getContext(), APInt(64, inputNode->getIndexInOrderedNodes()));
+			Constant *inputPortIndexValue = ConstantInt::get(module->getContext(), APInt(64, inputPort->getIndexInPortContexts()));
 
-			VuoCompilerCodeGenUtilities::generateSendInputPortsUpdated(module, transmissionBlock, compositionStateValue, inputPortIdentifierValue,
-																	   transmittedEventValue, receivedDataValue, inputDataSummaryValue);
+			VuoCompilerCodeGenUtilities::generateSendInputPortsUpdated(module, transmissionBlock, compositionStateValue, inputNodeIndexValue, inputPortIndexValue,
+																	   inputPortIdentifierValue, transmittedEventValue, receivedDataValue, inputDataSummaryValue);
 
 			if (inputDataType && ! transmittedDataPointer)
 			{
@@ -3410,7 +3417,7 @@ Function * VuoCompilerBitcodeGenerator::generateTriggerSchedulerFunction(VuoType
 
 		// Send telemetry that the event has been dropped.
 		Constant *portIdentifierValue = constantsCache->get(portIdentifier);
-		VuoCompilerCodeGenUtilities::generateSendEventDropped(module, dropEventBlock, compositionStateValue, portIdentifierValue);
+		VuoCompilerCodeGenUtilities::generateSendEventDropped(module, dropEventBlock, compositionStateValue, nodeIndex, portContextIndex, portIdentifierValue);
 
 		VuoCompilerCodeGenUtilities::generateReleaseCall(module, dropEventBlock, compositionStateValue);
 
@@ -15,6 +15,7 @@
 #include "VuoCompilerNode.hh"
 #include "VuoCompilerPortClass.hh"
 #include "VuoCompilerType.hh"
+#include "VuoComposition.hh"
 #include "VuoNode.hh"
 #include "VuoNodeClass.hh"
 #include "VuoPort.hh"
@@ -42,6 +43,8 @@ VuoCompilerCable::VuoCompilerCable(VuoCompilerNode * fromNode, VuoCompilerPort *
 void VuoCompilerCable::setAlwaysEventOnly(bool isEventOnly)
 {
 	this->isAlwaysEventOnly = isEventOnly;
+
+	VuoComposition::structureChanged();
 }
 
 /**
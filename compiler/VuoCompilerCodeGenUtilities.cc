@@ -1424,6 +1424,38 @@ Value * VuoCompilerCodeGenUtilities::generateCreateCompositionState(Module *modu
 	return CallInst::Create(function, args, "", block);
 }
 
+/**
+ * Generates code that creates a `VuoCompositionState *` for the subcomposition instance of the node at @a nodeIndex
+ * in the (sub)composition that @a compositionStateValue refers to.
+ */
+Value * VuoCompilerCodeGenUtilities::generateCreateSubcompositionState(Module *module, BasicBlock *block, Value *compositionStateValue, size_t nodeIndex, Value *subcompositionIdentifierValue)
+{
+	const char *functionName = "vuoCreateSubcompositionState";
+	Function *function = module->getFunction(functionName);
+	if (! function)
+	{
+		PointerType *pointerToChar = PointerType::get(IntegerType::get(module->getContext(), 8), 0);
+		PointerType *pointerToCompositionState = PointerType::get(getCompositionStateType(module), 0);
+		Type *unsignedLongType = IntegerType::get(module->getContext(), 64);
+
+		vector<Type *> params;
+		params.push_back(pointerToCompositionState);
+		params.push_back(unsignedLongType);
+		params.push_back(pointerToChar);
+
+		FunctionType *functionType = FunctionType::get(pointerToCompositionState, params, false);
+		function = Function::Create(functionType, GlobalValue::ExternalLinkage, functionName, module);
+	}
+
+	Constant *nodeIndexValue = ConstantInt::get(module->getContext(), APInt(64, nodeIndex));
+
+	vector<Value *> args;
+	args.push_back(compositionStateValue);
+	args.push_back(nodeIndexValue);
+	args.push_back(subcompositionIdentifierValue);
+	return CallInst::Create(function, args, "", block);
+}
+
 /**
  * Generates code that gets the `runtimeState` field of a `VuoCompositionState *`.
  */
@@ -1549,6 +1581,33 @@ Value * VuoCompilerCodeGenUtilities::generateGetNodeIndexForPort(Module *module,
 	return CallInst::Create(function, args, "", block);
 }
 
+/**
+ * Generates code that retrieves the index of a port in its node's port contexts, given the port's identifier.
+ */
+Value * VuoCompilerCodeGenUtilities::generateGetPortIndexForPort(Module *module, BasicBlock *block,
+																 Value *compositionStateValue, Value *portIdentifierValue)
+{
+	const char *functionName = "vuoGetPortIndexForPort";
+	Function *function = module->getFunction(functionName);
+	if (! function)
+	{
+		PointerType *pointerToCharType = PointerType::get(IntegerType::get(module->getContext(), 8), 0);
+		Type *unsignedLongType = IntegerType::get(module->getContext(), 64);
+
+		vector<Type *> params;
+		params.push_back(compositionStateValue->getType());
+		params.push_back(pointerToCharType);
+
+		FunctionType *functionType = FunctionType::get(unsignedLongType, params, false);
+		function = Function::Create(functionType, GlobalValue::ExternalLinkage, functionName, module);
+	}
+
+	vector<Value *> args;
+	args.push_back(compositionStateValue);
+	args.push_back(portIdentifierValue);
+	return CallInst::Create(function, args, "", block);
+}
+
 /**
  * Generates code that retrieves the index (in VuoCompilerBitcodeGenerator::orderedTypes) of a port's type, given the port's identifier.
  */
@@ -3002,24 +3061,29 @@ void VuoCompilerCodeGenUtilities::generateSendNodeExecutionFinished(Module *modu
 
 /**
  * Generates a call to `vuoSendInputPortsUpdated()`.
+ *
+ * @a nodeIndexValue is the node's index in `VuoCompilerBitcodeGenerator::orderedNodes`, and @a portIndexValue is the port's index in the node's port contexts.
  */
 void VuoCompilerCodeGenUtilities::generateSendInputPortsUpdated(Module *module, BasicBlock *block,
-																Value *compositionStateValue, Value *portIdentifierValue,
-																bool receivedEvent, bool receivedData,
+																Value *compositionStateValue, Value *nodeIndexValue, Value *portIndexValue,
+																Value *portIdentifierValue, bool receivedEvent, bool receivedData,
 																Value *portDataSummaryValue)
 {
 	IntegerType *boolType = IntegerType::get(module->getContext(), 1);
 	Value *receivedEventValue = ConstantInt::get(boolType, receivedEvent ? 1 : 0);
 	Value *receivedDataValue = ConstantInt::get(boolType, receivedData ? 1 : 0);
-	generateSendInputPortsUpdated(module, block, compositionStateValue, portIdentifierValue, receivedEventValue, receivedDataValue, portDataSummaryValue);
+	generateSendInputPortsUpdated(module, block, compositionStateValue, nodeIndexValue, portIndexValue, portIdentifierValue,
+								  receivedEventValue, receivedDataValue, portDataSummaryValue);
 }
 
 /**
  * Generates a call to `vuoSendInputPortsUpdated()`.
+ *
+ * @a nodeIndexValue is the node's index in `VuoCompilerBitcodeGenerator::orderedNodes`, and @a portIndexValue is the port's index in the node's port contexts.
  */
 void VuoCompilerCodeGenUtilities::generateSendInputPortsUpdated(Module *module, BasicBlock *block,
-																Value *compositionStateValue, Value *portIdentifierValue,
-																Value *receivedEventValue, Value *receivedDataValue,
+																Value *compositionStateValue, Value *nodeIndexValue, Value *portIndexValue,
+																Value *portIdentifierValue, Value *receivedEventValue, Value *receivedDataValue,
 																Value *portDataSummaryValue)
 {
 	const char *functionName = "vuoSendInputPortsUpdated";
@@ -3029,9 +3093,12 @@ void VuoCompilerCodeGenUtilities::generateSendInputPortsUpdated(Module *module,
 		PointerType *pointerToCompositionState = PointerType::get(getCompositionStateType(module), 0);
 		PointerType *pointerToCharType = PointerType::get(IntegerType::get(module->getContext(), 8), 0);
 		IntegerType *boolType = IntegerType::get(module->getContext(), 1);
+		Type *unsignedLongType = IntegerType::get(module->getContext(), 64);
 
 		vector<Type *> functionParams;
 		functionParams.push_back(pointerToCompositionState);
+		functionParams.push_back(unsignedLongType);
+		functionParams.push_back(unsignedLongType);
 		functionParams.push_back(pointerToCharType);
 		functionParams.push_back(boolType);
 		functionParams.push_back(boolType);
@@ -3042,6 +3109,8 @@ void VuoCompilerCodeGenUtilities::generateSendInputPortsUpdated(Module *module,
 
 	vector<Value *> args;
 	args.push_back(compositionStateValue);
+	args.push_back(nodeIndexValue);
+	args.push_back(portIndexValue);
 	args.push_back(portIdentifierValue);
 	args.push_back(receivedEventValue);
 	args.push_back(receivedDataValue);
@@ -3051,10 +3120,12 @@ void VuoCompilerCodeGenUtilities::generateSendInputPortsUpdated(Module *module,
 
 /**
  * Generates a call to `vuoSendOutputPortsUpdated()`.
+ *
+ * @a nodeIndexValue is the node's index in `VuoCompilerBitcodeGenerator::orderedNodes`, and @a portIndexValue is the port's index in the node's port contexts.
  */
 void VuoCompilerCodeGenUtilities::generateSendOutputPortsUpdated(Module *module, BasicBlock *block,
-																 Value *compositionStateValue, Value *portIdentifierValue,
-																 Value *sentEventValue, Value *sentDataValue,
+																 Value *compositionStateValue, Value *nodeIndexValue, Value *portIndexValue,
+																 Value *portIdentifierValue, Value *sentEventValue, Value *sentDataValue,
 																 Value *portDataSummaryValue)
 {
 	const char *functionName = "vuoSendOutputPortsUpdated";
@@ -3064,9 +3135,12 @@ void VuoCompilerCodeGenUtilities::generateSendOutputPortsUpdated(Module *module,
 		PointerType *pointerToCompositionState = PointerType::get(getCompositionStateType(module), 0);
 		PointerType *pointerToCharType = PointerType::get(IntegerType::get(module->getContext(), 8), 0);
 		IntegerType *boolType = IntegerType::get(module->getContext(), 1);
+		Type *unsignedLongType = IntegerType::get(module->getContext(), 64);
 
 		vector<Type *> functionParams;
 		functionParams.push_back(pointerToCompositionState);
+		functionParams.push_back(unsignedLongType);
+		functionParams.push_back(unsignedLongType);
 		functionParams.push_back(pointerToCharType);
 		functionParams.push_back(boolType);
 		functionParams.push_back(boolType);
@@ -3077,6 +3151,8 @@ void VuoCompilerCodeGenUtilities::generateSendOutputPortsUpdated(Module *module,
 
 	vector<Value *> args;
 	args.push_back(compositionStateValue);
+	args.push_back(nodeIndexValue);
+	args.push_back(portIndexValue);
 	args.push_back(portIdentifierValue);
 	args.push_back(sentEventValue);
 	args.push_back(sentDataValue);
@@ -3144,9 +3220,12 @@ void VuoCompilerCodeGenUtilities::generateSendEventFinished(Module *module, Basi
 
 /**
  * Generates a call to `vuoSendEventDropped()`.
+ *
+ * @a nodeIndex is the trigger node's index in `VuoCompilerBitcodeGenerator::orderedNodes`, and @a portIndex is the trigger port's index in the node's port contexts.
  */
 void VuoCompilerCodeGenUtilities::generateSendEventDropped(Module *module, BasicBlock *block,
-														   Value *compositionStateValue, Value *portIdentifierValue)
+														   Value *compositionStateValue, size_t nodeIndex, size_t portIndex,
+														   Value *portIdentifierValue)
 {
 	const char *functionName = "vuoSendEventDropped";
 	Function *function = module->getFunction(functionName);
@@ -3154,46 +3233,57 @@ void VuoCompilerCodeGenUtilities::generateSendEventDropped(Module *module, Basic
 	{
 		PointerType *pointerToCompositionState = PointerType::get(getCompositionStateType(module), 0);
 		PointerType *pointerToCharType = PointerType::get(IntegerType::get(module->getContext(), 8), 0);
+		Type *unsignedLongType = IntegerType::get(module->getContext(), 64);
 
 		vector<Type *> functionParams;
 		functionParams.push_back(pointerToCompositionState);
+		functionParams.push_back(unsignedLongType);
+		functionParams.push_back(unsignedLongType);
 		functionParams.push_back(pointerToCharType);
 		FunctionType *functionType = FunctionType::get(Type::getVoidTy(module->getContext()), functionParams, false);
 		function = Function::Create(functionType, GlobalValue::ExternalLinkage, functionName, module);
 	}
 
+	Type *unsignedLongType = function->getFunctionType()->getParamType(1);
+
 	vector<Value *> args;
 	args.push_back(compositionStateValue);
+	args.push_back(ConstantInt::get(unsignedLongType, nodeIndex));
+	args.push_back(ConstantInt::get(unsignedLongType, portIndex));
 	args.push_back(portIdentifierValue);
 	CallInst::Create(function, args, "", block);
 }
 
 /**
- * Generates code that gets the return value of the `vuoShouldSendPortDataTelemetry()` function as a comparison value.
+ * Generates code that gets the return value of the `vuoShouldSendPortDataTelemetryForIndexes()` function as a comparison value.
+ *
+ * @a nodeIndex is the node's index in `VuoCompilerBitcodeGenerator::orderedNodes`, and @a portIndex is the port's index in the node's port contexts.
  */
-ICmpInst * VuoCompilerCodeGenUtilities::generateShouldSendDataTelemetryComparison(Module *module, BasicBlock *block, string portIdentifier,
-																				  Value *compositionStateValue,
-																				  VuoCompilerConstantsCache *constantsCache)
+ICmpInst * VuoCompilerCodeGenUtilities::generateShouldSendDataTelemetryComparison(Module *module, BasicBlock *block,
+																				  size_t nodeIndex, size_t portIndex,
+																				  Value *compositionStateValue)
 {
-	const char *functionName = "vuoShouldSendPortDataTelemetry";
+	const char *functionName = "vuoShouldSendPortDataTelemetryForIndexes";
 	Function *shouldSendTelemetryFunction = module->getFunction(functionName);
 	if (! shouldSendTelemetryFunction)
 	{
 		PointerType *pointerToCompositionState = PointerType::get(getCompositionStateType(module), 0);
-		PointerType *pointerToCharType = PointerType::get(IntegerType::get(module->getContext(), 8), 0);
+		Type *unsignedLongType = IntegerType::get(module->getContext(), 64);
 
 		vector<Type *> functionParams;
 		functionParams.push_back(pointerToCompositionState);
-		functionParams.push_back(pointerToCharType);
+		functionParams.push_back(unsignedLongType);
+		functionParams.push_back(unsignedLongType);
 		FunctionType *functionType = FunctionType::get(IntegerType::get(module->getContext(), 32), functionParams, false);
 		shouldSendTelemetryFunction = Function::Create(functionType, GlobalValue::ExternalLinkage, functionName, module);
 	}
 
-	Constant *portIdentifierValue = constantsCache->get(portIdentifier);
+	Type *unsignedLongType = shouldSendTelemetryFunction->getFunctionType()->getParamType(1);
 
 	vector<Value *> args;
 	args.push_back(compositionStateValue);
-	args.push_back(portIdentifierValue);
+	args.push_back(ConstantInt::get(unsignedLongType, nodeIndex));
+	args.push_back(ConstantInt::get(unsignedLongType, portIndex));
 	CallInst *retValue = CallInst::Create(shouldSendTelemetryFunction, args, "", block);
 
 	Constant *zeroValue = ConstantInt::get(retValue->getType(), 0);
@@ -3947,6 +4037,7 @@ StructType * VuoCompilerCodeGenUtilities::getCompositionStateType(Module *module
 		vector<Type *> fields;
 		fields.push_back(voidPointerType);
 		fields.push_back(pointerToCharType);
+		fields.push_back(voidPointerType);
 		compositionStateType->setBody(fields, false);
 	}
 
@@ -42,7 +42,8 @@ VuoCompilerComposition::VuoCompilerComposition(VuoComposition *baseComposition,
 	getBase()->setCompiler(this);
 
 	graph = nullptr;
-	graphHash = 0;
+	graphVersion = 0;
+	graphWithPotentialCables = nullptr;
 	manuallyFirableInputNode = nullptr;
 	manuallyFirableInputPort = nullptr;
 	module = nullptr;
@@ -88,6 +89,7 @@ VuoCompilerComposition::VuoCompilerComposition(VuoComposition *baseComposition,
 VuoCompilerComposition::~VuoCompilerComposition(void)
 {
 	delete graph;
+	delete graphWithPotentialCables;
 	VuoCompiler::destroyLlvmModule(module);
 }
 
@@ -183,27 +185,34 @@ void VuoCompilerComposition::replaceNode(VuoNode *oldNode, VuoNode *newNode)
 
 /**
  * Returns the graph for this composition, using the most recently generated graph if it still applies.
+ *
+ * If the composition's structure has changed since then (according to VuoComposition::getStructureVersion()),
+ * the graph is updated incrementally, or regenerated if that's not possible.
  */
 VuoCompilerGraph * VuoCompilerComposition::getCachedGraph(VuoCompiler *compiler)
 {
-	long currentHash = VuoCompilerGraph::getHash(this);
-	bool compositionChanged = (currentHash != graphHash);
+	bool shouldRegenerate = ! graph;
 
-	bool shouldAddPublishedNodeImplementations = false;
-	if (! compositionChanged && compiler)
+	if (! shouldRegenerate && compiler)
 	{
+		// Add the published node implementations if the graph was generated without them.
 		VuoCompilerNode *publishedInputNode = graph->getPublishedInputNode();
 		if (publishedInputNode && ! publishedInputNode->getBase()->getNodeClass()->getCompiler()->getEventFunction())
-			shouldAddPublishedNodeImplementations = true;
+			shouldRegenerate = true;
 	}
 
-	if (compositionChanged || shouldAddPublishedNodeImplementations)
+	if (! shouldRegenerate && graphVersion != VuoComposition::getStructureVersion())
+		shouldRegenerate = ! graph->update(this);
+
+	if (shouldRegenerate)
 	{
 		delete graph;
 		graph = new VuoCompilerGraph(this, compiler);
-		graphHash = currentHash;
 	}
 
+	// Check the version after generating/updating the graph, since that may create cables.
+	graphVersion = VuoComposition::getStructureVersion();
+
 	return graph;
 }
 
@@ -214,7 +223,10 @@ void VuoCompilerComposition::invalidateCachedGraph(void)
 {
 	delete graph;
 	graph = nullptr;
-	graphHash = 0;
+	graphVersion = 0;
+
+	delete graphWithPotentialCables;
+	graphWithPotentialCables = nullptr;
 }
 
 /**
@@ -389,15 +401,21 @@ void VuoCompilerComposition::checkForEventFlowIssues(set<VuoCompilerCable *> pot
 {
 	VuoCompilerGraph *graph;
 	if (! potentialCables.empty())
-		graph = new VuoCompilerGraph(this, nullptr, potentialCables);
+	{
+		// The potential cables change each time (e.g. while a cable is being dragged), so keep a separate graph
+		// for them and update it incrementally, rather than disturbing the cached graph for the composition itself.
+		if (! graphWithPotentialCables || ! graphWithPotentialCables->update(this, potentialCables))
+		{
+			delete graphWithPotentialCables;
+			graphWithPotentialCables = new VuoCompilerGraph(this, nullptr, potentialCables);
+		}
+		graph = graphWithPotentialCables;
+	}
 	else
 		graph = getCachedGraph();
 
 	graph->checkForInfiniteFeedback(issues);
 	graph->checkForDeadlockedFeedback(issues);
-
-	if (! potentialCables.empty())
-		delete graph;
 }
 
 /**
@@ -925,6 +943,8 @@ void VuoCompilerComposition::setManuallyFirableInputPort(VuoNode *nodeContaining
 {
 	this->manuallyFirableInputNode = nodeContainingPort;
 	this->manuallyFirableInputPort = portFiredInto;
+
+	VuoComposition::structureChanged();
 }
 
 /**
@@ -75,7 +75,8 @@ public:
 
 private:
 	VuoCompilerGraph *graph;
-	long graphHash;
+	unsigned long graphVersion;
+	VuoCompilerGraph *graphWithPotentialCables;
 	map<unsigned int, bool> genericTypeSuffixUsed;
 	map<string, VuoNode *> nodeGraphvizIdentifierUsed;
 	map<string, VuoComment *> commentGraphvizIdentifierUsed;
@@ -775,14 +775,33 @@ void VuoCompilerEnvironment::stopWatchingModuleSearchPaths(void)
 }
 
 /**
- * VuoFileWatcher delegate function, called when one or more files in @a moduleSearchPath
- * have been added, modified, or removed.
+ * VuoFileWatcher delegate function, called with a batch of files in @a moduleSearchPath
+ * that have been added, modified, or removed.
+ *
+ * The whole batch is handled by a single update of the module search path. If the batch only
+ * contains files that can't be modules (such as macOS resource forks), the update is skipped.
  *
  * @threadNoQueue{VuoCompiler::environmentQueue}
  * @threadNoQueue{moduleSearchPathContentsChangedQueue}
  */
-void VuoCompilerEnvironment::fileChanged(const string &moduleSearchPath)
+void VuoCompilerEnvironment::filesChanged(const string &moduleSearchPath, const set<string> &pathsAdded, const set<string> &pathsModified, const set<string> &pathsRemoved)
 {
+	auto isIrrelevant = [] (const string &path)
+	{
+		string dir, file, extension;
+		VuoFileUtilities::splitPath(path, dir, file, extension);
+		return VuoStringUtilities::beginsWith(file, "._") || (file.empty() && extension == "DS_Store");
+	};
+
+	bool anyRelevant = false;
+	for (const set<string> *paths : { &pathsAdded, &pathsModified, &pathsRemoved })
+		for (const string &path : *paths)
+			if (! isIrrelevant(path))
+				anyRelevant = true;
+
+	if (! anyRelevant)
+		return;
+
 	dispatch_sync(moduleSearchPathContentsChangedQueue, ^{
 					  moduleSearchPathContentsChanged(moduleSearchPath);
 				  });
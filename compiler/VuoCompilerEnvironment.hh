@@ -67,7 +67,7 @@ private:
 	bool generated;  ///< True if this environment is for generated modules, false if for original modules.
 	set<VuoCompiler *> compilersToNotify;  ///< The compilers that this environment notifies when it loads/unloads modules as a result of changes to the watched search paths.
 	dispatch_queue_t compilersToNotifyQueue;  ///< Synchronizes access to `compilersToNotify`.
-	set<VuoFileWatcher *> moduleSearchPathWatchers;  ///< Dispatch sources watching module search paths for changes.
+	set<VuoFileWatcher *> moduleSearchPathWatchers;  ///< Watchers for changes to module search paths, each with a single FSEvents stream covering the path's subfolders.
 	map<string, VuoCompilerNodeClass *> nodeClasses;  ///< Node classes loaded, plus specialized node classes generated by the compiler.
 	map<string, VuoCompilerType *> types;  ///< Types loaded.
 	map<string, VuoNodeSet *> nodeSetForName;  ///< Node sets loaded.
@@ -148,7 +148,7 @@ public:
 	static vector<string> getBuiltInLibrarySearchPaths(void);
 	static vector<string> getBuiltInFrameworkSearchPaths(void);
 	void stopWatchingModuleSearchPaths(void);
-	void fileChanged(const string &moduleSearchPath);
+	void filesChanged(const string &moduleSearchPath, const set<string> &pathsAdded, const set<string> &pathsModified, const set<string> &pathsRemoved);
 	void moduleSearchPathContentsChanged(const string &moduleSearchPath);
 	void moduleFileChanged(const string &moduleKey, const string &modulePath, const string &moduleSourceCode, std::function<void(void)> moduleLoadedCallback, VuoCompiler *compiler, VuoCompilerIssues *issues = nullptr);
 	void deleteOverriddenModuleFile(const string &moduleKey);
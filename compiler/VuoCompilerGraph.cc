@@ -34,7 +34,7 @@
  * of the composition.
  *
  * @param composition The composition to represent. The graph representation is a snapshot of the composition passed
- *		into this constructor, and does not update if the composition is modified.
+ *		into this constructor, and does not update if the composition is modified unless update() is called.
  * @param compiler A compiler that may be used to generate published input and output nodes.
  * @param potentialCables Cables that are not yet in @a composition but should be added to the graph representation.
  *      If they would displace existing cables, the potentially displaced cables are omitted from the graph representation.
@@ -126,13 +126,162 @@ void VuoCompilerGraph::initializeInstance(VuoCompilerComposition *composition, s
 	this->publishedInputNode = publishedInputNode;
 	this->publishedOutputNode = publishedOutputNode;
 	this->ownsPublishedNodeClasses = ownsPublishedNodeClasses;
+	this->publishedInputTriggerNode = publishedInputTriggerNode;
+	this->manuallyFirableTriggerNode = manuallyFirableTriggerNode;
 	this->publishedInputTrigger = nullptr;
+	this->publishedInputSpinOffCable = nullptr;
+	this->manuallyFirableSpinOffCable = nullptr;
 
-	// Nodes in the composition
+	if (publishedInputNode && publishedOutputNode)
+	{
+		VuoPort *publishedInputTriggerPort = publishedInputTriggerNode->getBase()->getOutputPorts().at(VuoNodeClass::unreservedOutputPortStartIndex);
+		this->publishedInputTrigger = static_cast<VuoCompilerTriggerPort *>(publishedInputTriggerPort->getCompiler());
+	}
+
+	VuoPort *manuallyFirableTriggerPort = manuallyFirableTriggerNode->getBase()->getOutputPorts().at(VuoNodeClass::unreservedOutputPortStartIndex);
+	this->manuallyFirableTrigger = static_cast<VuoCompilerTriggerPort *>(manuallyFirableTriggerPort->getCompiler());
+
+	publishedInputPortsAnalyzed = getPublishedPortsAndNames(composition->getBase()->getPublishedInputPorts());
+	publishedOutputPortsAnalyzed = getPublishedPortsAndNames(composition->getBase()->getPublishedOutputPorts());
+
+	set<VuoNode *> nodesToAnalyze;
+	collectNodesAndCables(composition, potentialCables, nodesToAnalyze, analyzedCables);
+
+	for (VuoNode *node : nodesToAnalyze)
+		nodes.insert(node->getCompiler());
+
+	numberNodes();
+	makeTriggers(nodesToAnalyze);
+	analyzeTriggers(triggers);
+	makeDownstreamNodesViaDataOnlyTransmission(nodesToAnalyze, analyzedCables);
+}
+
+/**
+ * Brings this graph representation up to date with the current state of @a composition, as if it had been
+ * newly constructed from @a composition and @a potentialCables.
+ *
+ * Only the triggers that may have reached an added, removed, or reconnected cable are reanalyzed. The rest of
+ * the graph representation, including the results cached for those triggers, is kept.
+ *
+ * If the composition's published ports have changed, the published input and output nodes need to be recreated,
+ * so the graph representation can't be updated. The caller should construct a new VuoCompilerGraph instead.
+ *
+ * @return True if the graph representation was updated, false if it needs to be replaced.
+ */
+bool VuoCompilerGraph::update(VuoCompilerComposition *composition, set<VuoCompilerCable *> potentialCables)
+{
+	if (getPublishedPortsAndNames(composition->getBase()->getPublishedInputPorts()) != publishedInputPortsAnalyzed ||
+			getPublishedPortsAndNames(composition->getBase()->getPublishedOutputPorts()) != publishedOutputPortsAnalyzed)
+		return false;
 
-	set<VuoNode *> nodesIncludingInvalid = composition->getBase()->getNodes();
 	set<VuoNode *> nodesToAnalyze;
-	for (VuoNode *node : nodesIncludingInvalid)
+	map<VuoCable *, CableState> cablesToAnalyze;
+	collectNodesAndCables(composition, potentialCables, nodesToAnalyze, cablesToAnalyze);
+
+	set<VuoCompilerNode *> currentNodes;
+	for (VuoNode *node : nodesToAnalyze)
+		currentNodes.insert(node->getCompiler());
+
+	// Find where the cables that have been added, removed, or changed since the last analysis come from.
+	// Only pointers are compared, since the removed cables and their nodes may no longer exist.
+
+	set<VuoCompilerNode *> changedFromNodes;
+	set<VuoCompilerPort *> changedFromPorts;
+	auto addChangedCables = [&changedFromNodes, &changedFromPorts] (const map<VuoCable *, CableState> &cables, const map<VuoCable *, CableState> &otherCables)
+	{
+		for (const map<VuoCable *, CableState>::value_type &i : cables)
+		{
+			map<VuoCable *, CableState>::const_iterator otherIter = otherCables.find(i.first);
+			if (otherIter == otherCables.end() || otherIter->second != i.second)
+			{
+				changedFromNodes.insert(i.second.fromNode);
+				changedFromPorts.insert(i.second.fromPort);
+			}
+		}
+	};
+	addChangedCables(analyzedCables, cablesToAnalyze);
+	addChangedCables(cablesToAnalyze, analyzedCables);
+
+	if (changedFromNodes.empty() && currentNodes == nodes)
+		return true;
+
+	// Discard the analysis for each trigger that has been removed or that may have reached a changed cable.
+	// A trigger whose events can't reach the changed cables isn't affected by them.
+
+	set<VuoCompilerTriggerPort *> triggersForgotten;
+	for (VuoCompilerTriggerPort *trigger : triggers)
+	{
+		bool isAffected = (currentNodes.find(nodeForTrigger[trigger]) == currentNodes.end() ||
+						   changedFromPorts.find(trigger) != changedFromPorts.end());
+
+		if (! isAffected)
+		{
+			for (const Vertex &vertex : vertices[trigger])
+			{
+				if (changedFromNodes.find(vertex.toNode) != changedFromNodes.end())
+				{
+					isAffected = true;
+					break;
+				}
+			}
+		}
+
+		if (isAffected)
+		{
+			forgetTrigger(trigger);
+			triggersForgotten.insert(trigger);
+		}
+	}
+
+	// Reanalyze the affected triggers and any added triggers.
+
+	set<VuoCompilerTriggerPort *> previousTriggers(triggers.begin(), triggers.end());
+
+	if (currentNodes != nodes)
+	{
+		// The bitsets of nodes have to be resized and renumbered, so recompute them as needed for all triggers.
+		nodes = currentNodes;
+		numberNodes();
+		nodeReachability.clear();
+	}
+
+	triggers.clear();
+	nodeForTrigger.clear();
+	makeTriggers(nodesToAnalyze);
+
+	analyzedCables = cablesToAnalyze;
+
+	vector<VuoCompilerTriggerPort *> triggersToAnalyze;
+	for (VuoCompilerTriggerPort *trigger : triggers)
+		if (previousTriggers.find(trigger) == previousTriggers.end() || triggersForgotten.find(trigger) != triggersForgotten.end())
+			triggersToAnalyze.push_back(trigger);
+
+	analyzeTriggers(triggersToAnalyze);
+
+	// The remaining analysis spans triggers, so redo it from scratch.
+
+	downstreamNodesViaDataOnlyTransmission.clear();
+	makeDownstreamNodesViaDataOnlyTransmission(nodesToAnalyze, analyzedCables);
+
+	downstreamVerticesNonBlocking.clear();
+	downstreamVerticesNonBlockingOrDoor.clear();
+
+	return true;
+}
+
+/**
+ * Collects the nodes and cables that make up the internal representation of @a composition described in
+ * initializeInstance(), except for the gather cables.
+ *
+ * The cables that this class creates to replace published cables and to connect the `Spin Off Event` nodes
+ * are reused from the previous call if they still apply.
+ */
+void VuoCompilerGraph::collectNodesAndCables(VuoCompilerComposition *composition, const set<VuoCompilerCable *> &potentialCables,
+											 set<VuoNode *> &nodesToAnalyze, map<VuoCable *, CableState> &cablesToAnalyze)
+{
+	// Nodes in the composition
+
+	for (VuoNode *node : composition->getBase()->getNodes())
 		if (node->hasCompiler())  // Ignore nodes with missing node classes.
 			nodesToAnalyze.insert(node);
 
@@ -146,18 +295,12 @@ void VuoCompilerGraph::initializeInstance(VuoCompilerComposition *composition, s
 		// `Spin Off Event` node for published inputs
 
 		nodesToAnalyze.insert(publishedInputTriggerNode->getBase());
-
-		VuoPort *publishedInputTriggerPort = publishedInputTriggerNode->getBase()->getOutputPorts().at(VuoNodeClass::unreservedOutputPortStartIndex);
-		this->publishedInputTrigger = static_cast<VuoCompilerTriggerPort *>(publishedInputTriggerPort->getCompiler());
 	}
 
 	// `Spin Off Event` node for manually firable trigger
 
 	nodesToAnalyze.insert(manuallyFirableTriggerNode->getBase());
 
-	VuoPort *manuallyFirableTriggerPort = manuallyFirableTriggerNode->getBase()->getOutputPorts().at(VuoNodeClass::unreservedOutputPortStartIndex);
-	this->manuallyFirableTrigger = static_cast<VuoCompilerTriggerPort *>(manuallyFirableTriggerPort->getCompiler());
-
 	// Internal cables in the composition
 
 	set<VuoPort *> potentialCableInputs;
@@ -165,9 +308,8 @@ void VuoCompilerGraph::initializeInstance(VuoCompilerComposition *composition, s
 		if (cable->carriesData())
 			potentialCableInputs.insert(cable->getBase()->getToPort());
 
-	set<VuoCable *> cablesIncludingInvalidAndPublished = composition->getBase()->getCables();
-	set<VuoCable *> cablesToAnalyze;
-	for (VuoCable *cable : cablesIncludingInvalidAndPublished)
+	set<VuoCable *> publishedCables;
+	for (VuoCable *cable : composition->getBase()->getCables())
 	{
 		if ((cable->getFromPort() && cable->getToPort())  // Ignore disconnected cables.
 				&& (cable->getFromPort()->hasCompiler() && cable->getToPort()->hasCompiler())  // Ignore cables on nodes with missing node classes.
@@ -177,7 +319,7 @@ void VuoCompilerGraph::initializeInstance(VuoCompilerComposition *composition, s
 			if (cable->isPublished())
 				publishedCables.insert(cable);
 			else
-				cablesToAnalyze.insert(cable);
+				cablesToAnalyze[cable] = CableState(cable);
 		}
 	}
 
@@ -188,15 +330,26 @@ void VuoCompilerGraph::initializeInstance(VuoCompilerComposition *composition, s
 		if (cable->getBase()->isPublished())
 			publishedCables.insert(cable->getBase());
 		else
-			cablesToAnalyze.insert(cable->getBase());
+			cablesToAnalyze[cable->getBase()] = CableState(cable->getBase());
 	}
 
 	// Cables connected to published input/output nodes
 
 	vector<VuoPublishedPort *> publishedInputPorts = composition->getBase()->getPublishedInputPorts();
 	vector<VuoPublishedPort *> publishedOutputPorts = composition->getBase()->getPublishedOutputPorts();
+	map<VuoCable *, pair<CableState, VuoCable *> > replacements;
 	for (VuoCable *cable : publishedCables)
 	{
+		CableState state(cable);
+
+		auto previousIter = replacementForPublishedCable.find(cable);
+		if (previousIter != replacementForPublishedCable.end() && previousIter->second.first == state)
+		{
+			replacements[cable] = previousIter->second;
+			cablesToAnalyze[previousIter->second.second] = CableState(previousIter->second.second);
+			continue;
+		}
+
 		VuoNode *fromNode = nullptr;
 		VuoNode *toNode = nullptr;
 		VuoPort *fromPort = nullptr;
@@ -224,17 +377,24 @@ void VuoCompilerGraph::initializeInstance(VuoCompilerComposition *composition, s
 		VuoCompilerCable *replacement = new VuoCompilerCable(fromNode->getCompiler(), static_cast<VuoCompilerPort *>(fromPort->getCompiler()),
 															 toNode->getCompiler(), static_cast<VuoCompilerPort *>(toPort->getCompiler()), false);
 		replacement->setAlwaysEventOnly(cable->getCompiler()->getAlwaysEventOnly());
-		cablesToAnalyze.insert(replacement->getBase());
+		replacements[cable] = { state, replacement->getBase() };
+		cablesToAnalyze[replacement->getBase()] = CableState(replacement->getBase());
 	}
+	replacementForPublishedCable = replacements;
 
 	// Cable from `Spin Off Event` to published input node
 
 	if (publishedInputTrigger)
 	{
-		VuoPort *toPort = publishedInputNode->getBase()->getInputPorts().at(0);
-		VuoCompilerCable *spinOffCable = new VuoCompilerCable(publishedInputTriggerNode, publishedInputTrigger,
-															  publishedInputNode, static_cast<VuoCompilerPort *>(toPort->getCompiler()), false);
-		cablesToAnalyze.insert(spinOffCable->getBase());
+		if (! publishedInputSpinOffCable)
+		{
+			VuoPort *toPort = publishedInputNode->getBase()->getInputPorts().at(0);
+			VuoCompilerCable *spinOffCable = new VuoCompilerCable(publishedInputTriggerNode, publishedInputTrigger,
+																  publishedInputNode, static_cast<VuoCompilerPort *>(toPort->getCompiler()), false);
+			publishedInputSpinOffCable = spinOffCable->getBase();
+		}
+
+		cablesToAnalyze[publishedInputSpinOffCable] = CableState(publishedInputSpinOffCable);
 	}
 
 	// Cable from `Spin Off Event` to manually firable input port
@@ -244,21 +404,30 @@ void VuoCompilerGraph::initializeInstance(VuoCompilerComposition *composition, s
 		VuoPort *toPort = composition->getManuallyFirableInputPort();
 		if (toNode && toPort && toNode->hasCompiler() && toPort->hasCompiler())
 		{
-			VuoCompilerCable *spinOffCable = new VuoCompilerCable(manuallyFirableTriggerNode, manuallyFirableTrigger,
-																  toNode->getCompiler(), static_cast<VuoCompilerPort *>(toPort->getCompiler()), false);
-			cablesToAnalyze.insert(spinOffCable->getBase());
+			if (! (manuallyFirableSpinOffCable && manuallyFirableSpinOffCable->getToNode() == toNode && manuallyFirableSpinOffCable->getToPort() == toPort))
+			{
+				VuoCompilerCable *spinOffCable = new VuoCompilerCable(manuallyFirableTriggerNode, manuallyFirableTrigger,
+																	  toNode->getCompiler(), static_cast<VuoCompilerPort *>(toPort->getCompiler()), false);
+				manuallyFirableSpinOffCable = spinOffCable->getBase();
+			}
+
+			cablesToAnalyze[manuallyFirableSpinOffCable] = CableState(manuallyFirableSpinOffCable);
 		}
+		else
+			manuallyFirableSpinOffCable = nullptr;
 	}
+}
 
-	for (VuoNode *node : nodesToAnalyze)
-		nodes.insert(node->getCompiler());
+/**
+ * Returns each of @a publishedPorts paired with its current name.
+ */
+vector< pair<VuoPublishedPort *, string> > VuoCompilerGraph::getPublishedPortsAndNames(const vector<VuoPublishedPort *> &publishedPorts)
+{
+	vector< pair<VuoPublishedPort *, string> > portsAndNames;
+	for (VuoPublishedPort *port : publishedPorts)
+		portsAndNames.push_back({ port, port->getClass()->getName() });
 
-	makeTriggers(nodesToAnalyze);
-	makeVerticesAndEdges(cablesToAnalyze);
-	makeDownstreamVertices();
-	sortVertices();
-	makeVertexDistances();
-	makeDownstreamNodesViaDataOnlyTransmission(nodesToAnalyze, cablesToAnalyze);
+	return portsAndNames;
 }
 
 /**
@@ -266,8 +435,6 @@ void VuoCompilerGraph::initializeInstance(VuoCompilerComposition *composition, s
  */
 VuoCompilerGraph::~VuoCompilerGraph(void)
 {
-	VuoCompilerNode *publishedInputTriggerNode = nodeForTrigger[publishedInputTrigger];
-
 	if (ownsPublishedNodeClasses)
 	{
 		delete publishedInputNode->getBase()->getNodeClass()->getCompiler();
@@ -300,15 +467,51 @@ void VuoCompilerGraph::makeTriggers(set<VuoNode *> nodes)
 }
 
 /**
- * Sets up VuoCompilerGraph::vertices (not yet in topological order) and VuoCompilerGraph::edges.
+ * Sets up the vertices, edges, and per-trigger data derived from them for each of @a triggersToAnalyze.
+ */
+void VuoCompilerGraph::analyzeTriggers(const vector<VuoCompilerTriggerPort *> &triggersToAnalyze)
+{
+	makeVerticesAndEdges(triggersToAnalyze);
+
+	for (VuoCompilerTriggerPort *trigger : triggersToAnalyze)
+	{
+		makeDownstreamVertices(trigger);
+		sortVertices(trigger);
+		makeVertexDistances(trigger);
+	}
+}
+
+/**
+ * Discards the vertices, edges, and cached results for @a trigger.
+ *
+ * @a trigger is only used as a key, so it's OK if the port has already been destroyed.
  */
-void VuoCompilerGraph::makeVerticesAndEdges(const set<VuoCable *> &cables)
+void VuoCompilerGraph::forgetTrigger(VuoCompilerTriggerPort *trigger)
+{
+	vertices.erase(trigger);
+	edges.erase(trigger);
+	downstreamVertices.erase(trigger);
+	repeatedVertices.erase(trigger);
+	vertexDistanceFromTrigger.erase(trigger);
+	triggerMustTransmitToVertex.erase(trigger);
+	chains.erase(trigger);
+	numVerticesWithToNode.erase(trigger);
+	nodeReachability.erase(trigger);
+	publishedOutputNames.erase(trigger);
+}
+
+/**
+ * Sets up VuoCompilerGraph::vertices (not yet in topological order) and VuoCompilerGraph::edges
+ * for each of @a triggersToAnalyze, based on VuoCompilerGraph::analyzedCables.
+ */
+void VuoCompilerGraph::makeVerticesAndEdges(const vector<VuoCompilerTriggerPort *> &triggersToAnalyze)
 {
 	// Create vertices to visit for all cables.
 
 	set<Vertex> allVertices;
-	for (VuoCable *cable : cables)
+	for (const map<VuoCable *, CableState>::value_type &i : analyzedCables)
 	{
+		VuoCable *cable = i.first;
 		VuoCompilerPort *fromPort = cable->getFromPort() ? static_cast<VuoCompilerPort *>(cable->getFromPort()->getCompiler()) : nullptr;
 		VuoCompilerTriggerPort *fromTrigger = dynamic_cast<VuoCompilerTriggerPort *>(fromPort);
 		VuoCompilerNode *fromNode = cable->getFromNode()->getCompiler();
@@ -326,30 +529,33 @@ void VuoCompilerGraph::makeVerticesAndEdges(const set<VuoCable *> &cables)
 		allVertices.insert(vertex);
 	}
 
+	map<VuoCompilerTriggerPort *, set<Vertex> > outgoingVerticesForTrigger;  // Cached data to speed up search for vertices to start from.
+	map<VuoCompilerNode *, set<Vertex> > outgoingVerticesForNode;  // Cached data to speed up search for outgoing vertices.
+	for (const Vertex &vertex : allVertices)
+	{
+		if (vertex.fromTrigger)
+			outgoingVerticesForTrigger[vertex.fromTrigger].insert(vertex);
+		else
+			outgoingVerticesForNode[vertex.fromNode].insert(vertex);
+	}
+
 	// For each trigger, add all vertices reachable from it.
 
-	for (VuoCompilerTriggerPort *trigger : triggers)
+	for (VuoCompilerTriggerPort *trigger : triggersToAnalyze)
 	{
-		set<Vertex> verticesToVisit;
+		set<Vertex> verticesToVisit = outgoingVerticesForTrigger[trigger];
+		set<Vertex> verticesVisited;
 		set<Edge> edgesVisited;
 
-		for (set<Vertex>::iterator j = allVertices.begin(); j != allVertices.end(); ++j)
-			if ((*j).fromTrigger == trigger)
-				verticesToVisit.insert(*j);
-
-		map<VuoCompilerNode *, set<Vertex> > outgoingVerticesForNode;  // Cached data to speed up search for outgoing vertices.
-		for (set<Vertex>::iterator j = allVertices.begin(); j != allVertices.end(); ++j)
-			outgoingVerticesForNode[(*j).fromNode].insert(*j);
-
 		while (! verticesToVisit.empty())
 		{
 			Vertex vertex = *verticesToVisit.begin();
-			if (find(vertices[trigger].begin(), vertices[trigger].end(), vertex) == vertices[trigger].end())
+			if (verticesVisited.insert(vertex).second)
 				vertices[trigger].push_back(vertex);
 			verticesToVisit.erase(verticesToVisit.begin());
 
-			set<Vertex> potentialOutgoingVertices = outgoingVerticesForNode[vertex.toNode];
-			for (set<Vertex>::iterator j = potentialOutgoingVertices.begin(); j != potentialOutgoingVertices.end(); ++j)
+			const set<Vertex> &potentialOutgoingVertices = outgoingVerticesForNode[vertex.toNode];
+			for (set<Vertex>::const_iterator j = potentialOutgoingVertices.begin(); j != potentialOutgoingVertices.end(); ++j)
 			{
 				Vertex outgoingVertex = *j;
 
@@ -441,21 +647,18 @@ void VuoCompilerGraph::makeDownstreamVerticesWithInclusionRule(VuoCompilerTrigge
 }
 
 /**
- * Sets up VuoCompilerGraph::downstreamVertices and VuoCompilerGraph::repeatedVertices.
+ * Sets up VuoCompilerGraph::downstreamVertices and VuoCompilerGraph::repeatedVertices for @a trigger.
  */
-void VuoCompilerGraph::makeDownstreamVertices(void)
+void VuoCompilerGraph::makeDownstreamVertices(VuoCompilerTriggerPort *trigger)
 {
 	auto includeAllEdges = [] (Edge edge) { return true; };
 
-	for (VuoCompilerTriggerPort *trigger : triggers)
-	{
-		makeDownstreamVerticesWithInclusionRule(trigger, includeAllEdges, downstreamVertices[trigger], repeatedVertices[trigger]);
+	makeDownstreamVerticesWithInclusionRule(trigger, includeAllEdges, downstreamVertices[trigger], repeatedVertices[trigger]);
 
-		if (repeatedVertices[trigger].empty())
-			repeatedVertices.erase(trigger);
-	}
+	if (repeatedVertices[trigger].empty())
+		repeatedVertices.erase(trigger);
 
-	// For each trigger, add a cable and vertex from each leaf trigger/vertex to the published output node's gather port.
+	// Add a cable and vertex from each leaf trigger/vertex to the published output node's gather port.
 	//    - For the published input trigger and triggers that spin off events from it, this ensures that the
 	// composition doesn't notify its runner (for top-level compositions) or parent composition (for subcompositions)
 	// until the event has finished propagating through the composition.
@@ -464,174 +667,169 @@ void VuoCompilerGraph::makeDownstreamVertices(void)
 
 	if (publishedOutputNode)
 	{
-		for (VuoCompilerTriggerPort *trigger : triggers)
-		{
-			set< pair<VuoCompilerTriggerPort *, Vertex> > leaves;
-			if (trigger != publishedInputTrigger && trigger != manuallyFirableTrigger && downstreamVertices[trigger].empty())
-				leaves.insert({ trigger, Vertex() });
-			else
-				for (auto i : downstreamVertices[trigger])
-					if (i.first.toNode != publishedOutputNode && i.second.empty())
-						leaves.insert({ nullptr, i.first });
+		set< pair<VuoCompilerTriggerPort *, Vertex> > leaves;
+		if (trigger != publishedInputTrigger && trigger != manuallyFirableTrigger && downstreamVertices[trigger].empty())
+			leaves.insert({ trigger, Vertex() });
+		else
+			for (auto i : downstreamVertices[trigger])
+				if (i.first.toNode != publishedOutputNode && i.second.empty())
+					leaves.insert({ nullptr, i.first });
 
-			for (auto &leaf : leaves)
-			{
-				VuoCompilerNode *fromNode = (leaf.first ? nodeForTrigger[leaf.first] : leaf.second.toNode);
-				VuoCompilerTriggerPort *fromPort = (leaf.first ? leaf.first : nullptr);
-				VuoPort *toPort = getGatherPortOnPublishedOutputNode();
+		for (auto &leaf : leaves)
+		{
+			VuoCompilerNode *fromNode = (leaf.first ? nodeForTrigger[leaf.first] : leaf.second.toNode);
+			VuoCompilerTriggerPort *fromPort = (leaf.first ? leaf.first : nullptr);
+			VuoPort *toPort = getGatherPortOnPublishedOutputNode();
 
-				VuoCompilerCable *gather = new VuoCompilerCable(fromNode, fromPort,
-																publishedOutputNode, static_cast<VuoCompilerPort *>(toPort->getCompiler()), false);
+			VuoCompilerCable *gather = new VuoCompilerCable(fromNode, fromPort,
+															publishedOutputNode, static_cast<VuoCompilerPort *>(toPort->getCompiler()), false);
 
-				Vertex gatherVertex = (leaf.first ? Vertex(fromPort, publishedOutputNode) : Vertex(fromNode, publishedOutputNode));
-				gatherVertex.cableBundle.insert(gather);
-				vertices[trigger].push_back(gatherVertex);
+			Vertex gatherVertex = (leaf.first ? Vertex(fromPort, publishedOutputNode) : Vertex(fromNode, publishedOutputNode));
+			gatherVertex.cableBundle.insert(gather);
+			vertices[trigger].push_back(gatherVertex);
 
-				if (! leaf.first)
-				{
-					Vertex leafVertex = leaf.second;
-					Edge gatherEdge(leafVertex, gatherVertex);
-					edges[trigger].insert(gatherEdge);
-					downstreamVertices[trigger][leafVertex].insert(gatherVertex);
-				}
+			if (! leaf.first)
+			{
+				Vertex leafVertex = leaf.second;
+				Edge gatherEdge(leafVertex, gatherVertex);
+				edges[trigger].insert(gatherEdge);
+				downstreamVertices[trigger][leafVertex].insert(gatherVertex);
 			}
 		}
 	}
 }
 
 /**
- * Puts VuoCompilerGraph::vertices in topological order.
+ * Puts VuoCompilerGraph::vertices in topological order for @a trigger.
  */
-void VuoCompilerGraph::sortVertices(void)
+void VuoCompilerGraph::sortVertices(VuoCompilerTriggerPort *trigger)
 {
-	for (map<VuoCompilerTriggerPort *, vector<Vertex> >::iterator i = vertices.begin(); i != vertices.end(); ++i)
-	{
-		VuoCompilerTriggerPort *trigger = i->first;
-		vector<Vertex> verticesToSort = i->second;
+	vector<Vertex> verticesToSort = vertices[trigger];
 
-		map<Vertex, set<Vertex> > dependentVertices;
-		list<Vertex> verticesToVisit;  // Used as a stack, except for a call to find().
-		map<Vertex, bool> verticesCompleted;
+	map<Vertex, set<Vertex> > dependentVertices;
+	list<Vertex> verticesToVisit;  // Used as a stack, except for a call to find().
+	map<Vertex, bool> verticesCompleted;
 
-		for (vector<Vertex>::iterator j = verticesToSort.begin(); j != verticesToSort.end(); ++j)
-			if ((*j).fromTrigger == trigger)
-				verticesToVisit.push_back(*j);
+	for (vector<Vertex>::iterator j = verticesToSort.begin(); j != verticesToSort.end(); ++j)
+		if ((*j).fromTrigger == trigger)
+			verticesToVisit.push_back(*j);
 
-		map<VuoCompilerNode *, set<Vertex> > outgoingVerticesForNode;  // Cached data to speed up topological sort.
-		for (vector<Vertex>::iterator j = verticesToSort.begin(); j != verticesToSort.end(); ++j)
-			outgoingVerticesForNode[(*j).fromNode].insert(*j);
+	map<VuoCompilerNode *, set<Vertex> > outgoingVerticesForNode;  // Cached data to speed up topological sort.
+	for (vector<Vertex>::iterator j = verticesToSort.begin(); j != verticesToSort.end(); ++j)
+		outgoingVerticesForNode[(*j).fromNode].insert(*j);
 
-		while (! verticesToVisit.empty())
+	while (! verticesToVisit.empty())
+	{
+		// Visit the vertex at the top of the stack.
+		Vertex currentVertex = verticesToVisit.back();
+
+		set<Vertex> currentDependentVertices;
+		bool areDependentVerticesComplete = true;
+
+		// Form a list of vertices immediately dependent on this vertex's to-node.
+		// This includes vertices that are not downstream of this vertex because of a wall.
+		// But, if this vertex is at the end of a feedback loop, it doesn't include vertices
+		// beyond the end of the feedback loop.
+		set<Vertex> outgoingVertices;
+		set<Vertex> potentialOutgoingVertices = outgoingVerticesForNode[currentVertex.toNode];
+		for (set<Vertex>::iterator j = potentialOutgoingVertices.begin(); j != potentialOutgoingVertices.end(); ++j)
 		{
-			// Visit the vertex at the top of the stack.
-			Vertex currentVertex = verticesToVisit.back();
-
-			set<Vertex> currentDependentVertices;
-			bool areDependentVerticesComplete = true;
-
-			// Form a list of vertices immediately dependent on this vertex's to-node.
-			// This includes vertices that are not downstream of this vertex because of a wall.
-			// But, if this vertex is at the end of a feedback loop, it doesn't include vertices
-			// beyond the end of the feedback loop.
-			set<Vertex> outgoingVertices;
-			set<Vertex> potentialOutgoingVertices = outgoingVerticesForNode[currentVertex.toNode];
-			for (set<Vertex>::iterator j = potentialOutgoingVertices.begin(); j != potentialOutgoingVertices.end(); ++j)
+			Vertex outgoingVertex = *j;
+			if (downstreamVertices[trigger][outgoingVertex].find(currentVertex) == downstreamVertices[trigger][outgoingVertex].end())
+				outgoingVertices.insert(outgoingVertex);
+			else
 			{
-				Vertex outgoingVertex = *j;
-				if (downstreamVertices[trigger][outgoingVertex].find(currentVertex) == downstreamVertices[trigger][outgoingVertex].end())
-					outgoingVertices.insert(outgoingVertex);
-				else
-				{
-					outgoingVertices.clear();
-					break;
-				}
+				outgoingVertices.clear();
+				break;
 			}
+		}
 
-			for (set<Vertex>::iterator j = outgoingVertices.begin(); j != outgoingVertices.end(); ++j)
-			{
-				Vertex outgoingVertex = *j;
-				currentDependentVertices.insert(outgoingVertex);
+		for (set<Vertex>::iterator j = outgoingVertices.begin(); j != outgoingVertices.end(); ++j)
+		{
+			Vertex outgoingVertex = *j;
+			currentDependentVertices.insert(outgoingVertex);
 
-				if (verticesCompleted[outgoingVertex])
-				{
-					// The dependent vertex has already been visited, so add its dependent vertices to this vertex's.
-					currentDependentVertices.insert( dependentVertices[outgoingVertex].begin(), dependentVertices[outgoingVertex].end() );
-				}
-				else if (find(verticesToVisit.begin(), verticesToVisit.end(), outgoingVertex) == verticesToVisit.end())
-				{
-					// The dependent vertex has not yet been visited, so add it to the stack.
-					verticesToVisit.push_back(outgoingVertex);
-					areDependentVerticesComplete = false;
-				}
+			if (verticesCompleted[outgoingVertex])
+			{
+				// The dependent vertex has already been visited, so add its dependent vertices to this vertex's.
+				currentDependentVertices.insert( dependentVertices[outgoingVertex].begin(), dependentVertices[outgoingVertex].end() );
 			}
-
-			if (areDependentVerticesComplete)
+			else if (find(verticesToVisit.begin(), verticesToVisit.end(), outgoingVertex) == verticesToVisit.end())
 			{
-				dependentVertices[currentVertex] = currentDependentVertices;
-				verticesToVisit.pop_back();
-				verticesCompleted[currentVertex] = true;
+				// The dependent vertex has not yet been visited, so add it to the stack.
+				verticesToVisit.push_back(outgoingVertex);
+				areDependentVerticesComplete = false;
 			}
 		}
 
-		// Put the vertices in descending order of the number of vertices that can't be reached until after the vertex.
-		vector< pair<size_t, Vertex> > verticesAndDependents;
-		for (map<Vertex, set<Vertex> >::iterator j = dependentVertices.begin(); j != dependentVertices.end(); ++j)
-			verticesAndDependents.push_back( make_pair(j->second.size(), j->first) );
-		sort(verticesAndDependents.begin(), verticesAndDependents.end());
+		if (areDependentVerticesComplete)
+		{
+			dependentVertices[currentVertex] = currentDependentVertices;
+			verticesToVisit.pop_back();
+			verticesCompleted[currentVertex] = true;
+		}
+	}
 
-		vector<Vertex> sortedVertices;
-		for (vector< pair<size_t, Vertex> >::reverse_iterator j = verticesAndDependents.rbegin(); j != verticesAndDependents.rend(); ++j)
-			sortedVertices.push_back((*j).second);
+	// Put the vertices in descending order of the number of vertices that can't be reached until after the vertex.
+	vector< pair<size_t, Vertex> > verticesAndDependents;
+	for (map<Vertex, set<Vertex> >::iterator j = dependentVertices.begin(); j != dependentVertices.end(); ++j)
+		verticesAndDependents.push_back( make_pair(j->second.size(), j->first) );
+	sort(verticesAndDependents.begin(), verticesAndDependents.end());
 
-		vertices[trigger] = sortedVertices;
-	}
+	vector<Vertex> sortedVertices;
+	for (vector< pair<size_t, Vertex> >::reverse_iterator j = verticesAndDependents.rbegin(); j != verticesAndDependents.rend(); ++j)
+		sortedVertices.push_back((*j).second);
+
+	vertices[trigger] = sortedVertices;
 }
 
 /**
- * Sets up VuoCompilerGraph::vertexDistanceFromTrigger and VuoCompilerGraph::vertexMustTransmitFromTrigger.
+ * Sets up VuoCompilerGraph::vertexDistanceFromTrigger and VuoCompilerGraph::vertexMustTransmitFromTrigger for @a trigger.
  */
-void VuoCompilerGraph::makeVertexDistances(void)
+void VuoCompilerGraph::makeVertexDistances(VuoCompilerTriggerPort *trigger)
 {
-	for (map<VuoCompilerTriggerPort *, vector<Vertex> >::iterator i = vertices.begin(); i != vertices.end(); ++i)
-	{
-		VuoCompilerTriggerPort *trigger = i->first;
-		vector<Vertex> verticesDownstream = i->second;
+	const vector<Vertex> &verticesDownstream = vertices[trigger];
 
-		map<VuoCompilerNode *, set<Vertex> > incomingVerticesForNode;  // Cached data to speed up search for incoming vertices.
-		for (vector<Vertex>::iterator j = verticesDownstream.begin(); j != verticesDownstream.end(); ++j)
-			incomingVerticesForNode[(*j).toNode].insert(*j);
+	map<VuoCompilerNode *, set<Vertex> > incomingVerticesForNode;  // Cached data to speed up search for incoming vertices.
+	map<VuoCompilerNode *, set<VuoCompilerCable *> > outgoingCablesForNode;  // Cached data to speed up mustTransmit().
+	for (vector<Vertex>::const_iterator j = verticesDownstream.begin(); j != verticesDownstream.end(); ++j)
+	{
+		incomingVerticesForNode[(*j).toNode].insert(*j);
+		if ((*j).fromNode)
+			outgoingCablesForNode[(*j).fromNode].insert((*j).cableBundle.begin(), (*j).cableBundle.end());
+	}
 
-		// Handle vertices immediately downstream of the trigger.
-		for (vector<Vertex>::iterator j = verticesDownstream.begin(); j != verticesDownstream.end(); ++j)
+	// Handle vertices immediately downstream of the trigger.
+	for (vector<Vertex>::const_iterator j = verticesDownstream.begin(); j != verticesDownstream.end(); ++j)
+	{
+		Vertex vertex = *j;
+		if (vertex.fromTrigger == trigger)
 		{
-			Vertex vertex = *j;
-			if (vertex.fromTrigger == trigger)
-			{
-				vertexDistanceFromTrigger[trigger][vertex] = 1;
-				triggerMustTransmitToVertex[trigger][vertex] = true;
-			}
+			vertexDistanceFromTrigger[trigger][vertex] = 1;
+			triggerMustTransmitToVertex[trigger][vertex] = true;
 		}
+	}
 
-		// Handle vertices further downstream.
-		for (vector<Vertex>::iterator j = verticesDownstream.begin(); j != verticesDownstream.end(); ++j)
+	// Handle vertices further downstream.
+	for (vector<Vertex>::const_iterator j = verticesDownstream.begin(); j != verticesDownstream.end(); ++j)
+	{
+		Vertex vertex = *j;
+		if (vertex.fromTrigger != trigger)
 		{
-			Vertex vertex = *j;
-			if (vertex.fromTrigger != trigger)
+			size_t minDistance = verticesDownstream.size();
+			bool anyMustTransmit = false;
+			for (set<Vertex>::iterator k = incomingVerticesForNode[vertex.fromNode].begin(); k != incomingVerticesForNode[vertex.fromNode].end(); ++k)
 			{
-				size_t minDistance = verticesDownstream.size();
-				bool anyMustTransmit = false;
-				for (set<Vertex>::iterator k = incomingVerticesForNode[vertex.fromNode].begin(); k != incomingVerticesForNode[vertex.fromNode].end(); ++k)
-				{
-					Vertex upstreamVertex = *k;
-
-					minDistance = min(vertexDistanceFromTrigger[trigger][upstreamVertex], minDistance);
-					bool currMustTransmit = triggerMustTransmitToVertex[trigger][upstreamVertex] && mustTransmit(upstreamVertex, trigger);
-					anyMustTransmit = currMustTransmit || anyMustTransmit;
-				}
+				Vertex upstreamVertex = *k;
 
-				vertexDistanceFromTrigger[trigger][vertex] = minDistance + 1;
-				triggerMustTransmitToVertex[trigger][vertex] = anyMustTransmit;
+				minDistance = min(vertexDistanceFromTrigger[trigger][upstreamVertex], minDistance);
+				bool currMustTransmit = triggerMustTransmitToVertex[trigger][upstreamVertex] &&
+										mustTransmit(upstreamVertex.cableBundle, outgoingCablesForNode[upstreamVertex.toNode]);
+				anyMustTransmit = currMustTransmit || anyMustTransmit;
 			}
+
+			vertexDistanceFromTrigger[trigger][vertex] = minDistance + 1;
+			triggerMustTransmitToVertex[trigger][vertex] = anyMustTransmit;
 		}
 	}
 }
@@ -639,7 +837,7 @@ void VuoCompilerGraph::makeVertexDistances(void)
 /**
  * Sets up VuoCompilerGraph::eventlesslyDownstreamNodes.
  */
-void VuoCompilerGraph::makeDownstreamNodesViaDataOnlyTransmission(set<VuoNode *> nodes, set<VuoCable *> cables)
+void VuoCompilerGraph::makeDownstreamNodesViaDataOnlyTransmission(set<VuoNode *> nodes, const map<VuoCable *, CableState> &cables)
 {
 	// @todo Maybe this could be refactored to call makeDownstreamVerticesWithInclusionRule.
 
@@ -648,8 +846,9 @@ void VuoCompilerGraph::makeDownstreamNodesViaDataOnlyTransmission(set<VuoNode *>
 
 	map<VuoCompilerNode *, set<VuoCompilerNode *> > remainingIncomingNodes;
 	map<VuoCompilerNode *, set<VuoCompilerNode *> > remainingOutgoingNodes;
-	for (VuoCable *cable : cables)
+	for (const map<VuoCable *, CableState>::value_type &i : cables)
 	{
+		VuoCable *cable = i.first;
 		VuoCompilerPort *fromPort = cable->getFromPort() ? static_cast<VuoCompilerPort *>(cable->getFromPort()->getCompiler()) : nullptr;
 		VuoCompilerTriggerPort *fromTrigger = dynamic_cast<VuoCompilerTriggerPort *>(fromPort);
 		if (fromTrigger || ! cable->getCompiler()->carriesData())
@@ -847,11 +1046,14 @@ bool VuoCompilerGraph::mayTransmit(VuoCompilerNode *node, VuoCompilerTriggerPort
  */
 bool VuoCompilerGraph::mayTransmit(VuoCompilerNode *fromNode, VuoCompilerNode *toNode, VuoCompilerTriggerPort *trigger)
 {
-	if (vertexMayTransmit[trigger].empty() && ! vertices[trigger].empty())
-		for (vector<Vertex>::iterator i = vertices[trigger].begin(); i != vertices[trigger].end(); ++i)
-			vertexMayTransmit[trigger][(*i).fromNode][(*i).toNode] = true;
+	unordered_map<VuoCompilerNode *, size_t>::iterator toIter = indexForNode.find(toNode);
+	if (toIter == indexForNode.end())
+		return false;
 
-	return vertexMayTransmit[trigger][fromNode][toNode];
+	const uint64_t *downstreamBits = (fromNode ?
+										  getDownstreamNodeBits(fromNode, trigger, true) :
+										  getNodeReachability(trigger).immediatelyDownstreamOfTrigger.data());
+	return downstreamBits && isBitSet(downstreamBits, toIter->second);
 }
 
 /**
@@ -1015,11 +1217,13 @@ size_t VuoCompilerGraph::getNumVerticesWithToNode(VuoCompilerNode *toNode, VuoCo
  */
 map<VuoCompilerTriggerPort *, vector<VuoCompilerChain *> > VuoCompilerGraph::getChains(void)
 {
-	if (! chains.empty())
-		return chains;
-
 	for (VuoCompilerTriggerPort *trigger : triggers)
 	{
+		if (chains.find(trigger) != chains.end())
+			continue;  // Already cached.
+
+		vector<VuoCompilerChain *> &chainsForTrigger = chains[trigger];
+
 		// Visit the vertices in topological order, and put the nodes into lists (chains-in-progress).
 		vector< vector<VuoCompilerNode *> > chainsInProgress;
 		set<VuoCompilerNode *> nodesAdded;
@@ -1071,7 +1275,7 @@ map<VuoCompilerTriggerPort *, vector<VuoCompilerChain *> > VuoCompilerGraph::get
 		{
 			vector<VuoCompilerNode *> chainNodes = *j;
 			VuoCompilerChain *chain = new VuoCompilerChain(chainNodes, false);
-			chains[trigger].push_back(chain);
+			chainsForTrigger.push_back(chain);
 		}
 
 		// Create a new chain for each node that is the repeated node in a feedback loop.
@@ -1086,7 +1290,7 @@ map<VuoCompilerTriggerPort *, vector<VuoCompilerChain *> > VuoCompilerGraph::get
 			if (isRepeatedInFeedbackLoop(node, trigger))
 			{
 				VuoCompilerChain *chain = new VuoCompilerChain(vector<VuoCompilerNode *>(1, node), true);
-				chains[trigger].push_back(chain);
+				chainsForTrigger.push_back(chain);
 			}
 		}
 
@@ -1094,7 +1298,7 @@ map<VuoCompilerTriggerPort *, vector<VuoCompilerChain *> > VuoCompilerGraph::get
 		if (skippedPublishedOutputNode)
 		{
 			VuoCompilerChain *chain = new VuoCompilerChain(vector<VuoCompilerNode *>(1, publishedOutputNode), false);
-			chains[trigger].push_back(chain);
+			chainsForTrigger.push_back(chain);
 		}
 	}
 
@@ -1106,12 +1310,7 @@ map<VuoCompilerTriggerPort *, vector<VuoCompilerChain *> > VuoCompilerGraph::get
  */
 vector<VuoCompilerNode *> VuoCompilerGraph::getNodesImmediatelyDownstream(VuoCompilerTriggerPort *trigger)
 {
-	set<VuoCompilerNode *> downstreamNodes;
-	for (vector<Vertex>::iterator i = vertices[trigger].begin(); i != vertices[trigger].end(); ++i)
-		if ((*i).fromTrigger == trigger)
-			downstreamNodes.insert((*i).toNode);
-
-	return vector<VuoCompilerNode *>(downstreamNodes.begin(), downstreamNodes.end());
+	return getNodesForBits(getNodeReachability(trigger).immediatelyDownstreamOfTrigger.data());
 }
 
 /**
@@ -1119,12 +1318,8 @@ vector<VuoCompilerNode *> VuoCompilerGraph::getNodesImmediatelyDownstream(VuoCom
  */
 vector<VuoCompilerNode *> VuoCompilerGraph::getNodesImmediatelyDownstream(VuoCompilerNode *node, VuoCompilerTriggerPort *trigger)
 {
-	set<VuoCompilerNode *> downstreamNodes;
-	for (vector<Vertex>::iterator i = vertices[trigger].begin(); i != vertices[trigger].end(); ++i)
-		if ((*i).fromNode == node)
-			downstreamNodes.insert((*i).toNode);
-
-	return vector<VuoCompilerNode *>(downstreamNodes.begin(), downstreamNodes.end());
+	const uint64_t *downstreamBits = getDownstreamNodeBits(node, trigger, true);
+	return downstreamBits ? getNodesForBits(downstreamBits) : vector<VuoCompilerNode *>();
 }
 
 /**
@@ -1132,57 +1327,140 @@ vector<VuoCompilerNode *> VuoCompilerGraph::getNodesImmediatelyDownstream(VuoCom
  */
 vector<VuoCompilerNode *> VuoCompilerGraph::getNodesDownstream(VuoCompilerTriggerPort *trigger)
 {
-	map<VuoCompilerTriggerPort *, vector<VuoCompilerNode *> >::iterator triggerIter = downstreamNodesForTrigger.find(trigger);
-	if (triggerIter != downstreamNodesForTrigger.end())
-		return triggerIter->second;
+	return getNodesForBits(getNodeReachability(trigger).downstreamOfTrigger.data());
+}
 
-	set<VuoCompilerNode *> downstreamNodes;
-	vector<VuoCompilerNode *> immediatelyDownstreamNodes = getNodesImmediatelyDownstream(trigger);
-	downstreamNodes.insert(immediatelyDownstreamNodes.begin(), immediatelyDownstreamNodes.end());
+/**
+ * Returns the nodes that can be reached by an event from @a trigger that has passed through @a node.
+ */
+vector<VuoCompilerNode *> VuoCompilerGraph::getNodesDownstream(VuoCompilerNode *node, VuoCompilerTriggerPort *trigger)
+{
+	const uint64_t *downstreamBits = getDownstreamNodeBits(node, trigger, false);
+	return downstreamBits ? getNodesForBits(downstreamBits) : vector<VuoCompilerNode *>();
+}
 
-	for (vector<VuoCompilerNode *>::iterator i = immediatelyDownstreamNodes.begin(); i != immediatelyDownstreamNodes.end(); ++i)
-	{
-		vector<VuoCompilerNode *> furtherDownstreamNodes = getNodesDownstream(*i, trigger);
-		downstreamNodes.insert(furtherDownstreamNodes.begin(), furtherDownstreamNodes.end());
-	}
+/**
+ * Numbers the nodes in @ref nodes for use in bitsets of nodes.
+ */
+void VuoCompilerGraph::numberNodes(void)
+{
+	indexForNode.clear();
+	nodeForIndex.assign(nodes.begin(), nodes.end());
+	for (size_t i = 0; i < nodeForIndex.size(); ++i)
+		indexForNode[nodeForIndex[i]] = i;
 
-	vector<VuoCompilerNode *> downstreamNodesVector(downstreamNodes.begin(), downstreamNodes.end());
-	downstreamNodesForTrigger[trigger] = downstreamNodesVector;
-	return downstreamNodesVector;
+	nodeBitsetWords = (nodeForIndex.size() + 63) / 64;
 }
 
 /**
- * Returns the nodes that can be reached by an event from @a trigger that has passed through @a node.
+ * Returns bitsets of the nodes that an event from @a trigger can reach, computing them from
+ * VuoCompilerGraph::vertices and VuoCompilerGraph::downstreamVertices the first time they're needed.
  */
-vector<VuoCompilerNode *> VuoCompilerGraph::getNodesDownstream(VuoCompilerNode *node, VuoCompilerTriggerPort *trigger)
+VuoCompilerGraph::NodeReachability & VuoCompilerGraph::getNodeReachability(VuoCompilerTriggerPort *trigger)
 {
-	map<VuoCompilerTriggerPort *, map<VuoCompilerNode *, vector<VuoCompilerNode *> > >::iterator triggerIter = downstreamNodesForNode.find(trigger);
-	if (triggerIter != downstreamNodesForNode.end())
+	map<VuoCompilerTriggerPort *, NodeReachability>::iterator reachabilityIter = nodeReachability.find(trigger);
+	if (reachabilityIter != nodeReachability.end())
+		return reachabilityIter->second;
+
+	NodeReachability &reachability = nodeReachability[trigger];
+	reachability.immediatelyDownstreamOfTrigger.assign(nodeBitsetWords, 0);
+	reachability.downstreamOfTrigger.assign(nodeBitsetWords, 0);
+	reachability.rowForNode.assign(nodeForIndex.size(), NodeReachability::noRow);
+
+	map<Vertex, set<Vertex> > &downstreamVerticesForTrigger = downstreamVertices[trigger];
+	for (const Vertex &vertex : vertices[trigger])
 	{
-		map<VuoCompilerNode *, vector<VuoCompilerNode *> >::iterator nodeIter = triggerIter->second.find(node);
-		if (nodeIter != triggerIter->second.end())
-			return nodeIter->second;
+		size_t toIndex = indexForNode.at(vertex.toNode);
+
+		if (vertex.fromTrigger == trigger)
+		{
+			setBit(reachability.immediatelyDownstreamOfTrigger.data(), toIndex);
+			continue;
+		}
+
+		size_t &row = reachability.rowForNode[indexForNode.at(vertex.fromNode)];
+		if (row == NodeReachability::noRow)
+		{
+			row = reachability.immediatelyDownstream.size() / nodeBitsetWords;
+			reachability.immediatelyDownstream.resize(reachability.immediatelyDownstream.size() + nodeBitsetWords, 0);
+			reachability.downstream.resize(reachability.downstream.size() + nodeBitsetWords, 0);
+		}
+
+		setBit(&reachability.immediatelyDownstream[row * nodeBitsetWords], toIndex);
+
+		uint64_t *downstreamBits = &reachability.downstream[row * nodeBitsetWords];
+		setBit(downstreamBits, toIndex);
+
+		map<Vertex, set<Vertex> >::iterator downstreamIter = downstreamVerticesForTrigger.find(vertex);
+		if (downstreamIter != downstreamVerticesForTrigger.end())
+			for (const Vertex &downstreamVertex : downstreamIter->second)
+				setBit(downstreamBits, indexForNode.at(downstreamVertex.toNode));
 	}
 
-	set<Vertex> verticesWithDownstreamNodes;
-	for (vector<Vertex>::iterator i = vertices[trigger].begin(); i != vertices[trigger].end(); ++i)
+	// The nodes downstream of the trigger are those directly connected to it, plus those downstream of them.
+	for (size_t i = 0; i < nodeBitsetWords; ++i)
 	{
-		Vertex vertex = *i;
-		if (vertex.fromNode == node)
+		reachability.downstreamOfTrigger[i] |= reachability.immediatelyDownstreamOfTrigger[i];
+
+		for (uint64_t word = reachability.immediatelyDownstreamOfTrigger[i]; word; word &= word - 1)
 		{
-			verticesWithDownstreamNodes.insert(vertex);
-			set<Vertex> downstream = downstreamVertices[trigger][vertex];
-			verticesWithDownstreamNodes.insert(downstream.begin(), downstream.end());
+			size_t row = reachability.rowForNode[i * 64 + __builtin_ctzll(word)];
+			if (row == NodeReachability::noRow)
+				continue;
+
+			const uint64_t *downstreamBits = &reachability.downstream[row * nodeBitsetWords];
+			for (size_t j = 0; j < nodeBitsetWords; ++j)
+				reachability.downstreamOfTrigger[j] |= downstreamBits[j];
 		}
 	}
 
-	set<VuoCompilerNode *> downstreamNodes;
-	for (set<Vertex>::iterator i = verticesWithDownstreamNodes.begin(); i != verticesWithDownstreamNodes.end(); ++i)
-		downstreamNodes.insert((*i).toNode);
+	return reachability;
+}
+
+/**
+ * Returns the bitset of nodes that an event from @a trigger can reach after passing through @a node —
+ * either directly connected to @a node (if @a immediately is true) or through any number of cables.
+ *
+ * Returns null if there are no such nodes.
+ */
+const uint64_t * VuoCompilerGraph::getDownstreamNodeBits(VuoCompilerNode *node, VuoCompilerTriggerPort *trigger, bool immediately)
+{
+	unordered_map<VuoCompilerNode *, size_t>::iterator nodeIter = indexForNode.find(node);
+	if (nodeIter == indexForNode.end())
+		return nullptr;
+
+	NodeReachability &reachability = getNodeReachability(trigger);
+	size_t row = reachability.rowForNode[nodeIter->second];
+	if (row == NodeReachability::noRow)
+		return nullptr;
+
+	const vector<uint64_t> &rows = (immediately ? reachability.immediatelyDownstream : reachability.downstream);
+	return &rows[row * nodeBitsetWords];
+}
+
+/**
+ * Returns the nodes whose bits are set in @a nodeBits, in the same order as VuoCompilerGraph::nodes.
+ */
+vector<VuoCompilerNode *> VuoCompilerGraph::getNodesForBits(const uint64_t *nodeBits)
+{
+	vector<VuoCompilerNode *> nodesForBits;
+	for (size_t i = 0; i < nodeBitsetWords; ++i)
+		for (uint64_t word = nodeBits[i]; word; word &= word - 1)
+			nodesForBits.push_back(nodeForIndex[i * 64 + __builtin_ctzll(word)]);
 
-	vector<VuoCompilerNode *> downstreamNodesVector(downstreamNodes.begin(), downstreamNodes.end());
-	downstreamNodesForNode[trigger][node] = downstreamNodesVector;
-	return downstreamNodesVector;
+	return nodesForBits;
+}
+
+/**
+ * Returns the number of nodes whose bits are set in @a nodeBits.
+ */
+size_t VuoCompilerGraph::countBits(const uint64_t *nodeBits)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < nodeBitsetWords; ++i)
+		count += __builtin_popcountll(nodeBits[i]);
+
+	return count;
 }
 
 /**
@@ -1298,14 +1576,16 @@ void VuoCompilerGraph::getWorkerThreadsNeeded(VuoCompilerTriggerPort *trigger, i
 		VuoCompilerChain *chain = *i;
 		VuoCompilerNode *lastNodeInThisChain = chain->getNodes().back();
 
-		vector<VuoCompilerNode *> nodesDownstream = getNodesDownstream(lastNodeInThisChain, trigger);
+		const uint64_t *nodesDownstream = getDownstreamNodeBits(lastNodeInThisChain, trigger, false);
+		if (! nodesDownstream)
+			continue;
 
 		for (vector<VuoCompilerChain *>::iterator j = i+1; j != chainsForTrigger.end(); ++j)
 		{
 			VuoCompilerChain *otherChain = *j;
 			VuoCompilerNode *firstNodeInOtherChain = otherChain->getNodes().front();
 
-			if (find(nodesDownstream.begin(), nodesDownstream.end(), firstNodeInOtherChain) != nodesDownstream.end())
+			if (isBitSet(nodesDownstream, indexForNode.at(firstNodeInOtherChain)))
 				chainsDownstream[chain].insert(otherChain);
 		}
 	}
@@ -1318,14 +1598,16 @@ void VuoCompilerGraph::getWorkerThreadsNeeded(VuoCompilerTriggerPort *trigger, i
 		VuoCompilerChain *chain = *i;
 		VuoCompilerNode *lastNodeInThisChain = chain->getNodes().back();
 
-		vector<VuoCompilerNode *> nodesDownstream = getNodesImmediatelyDownstream(lastNodeInThisChain, trigger);
+		const uint64_t *nodesDownstream = getDownstreamNodeBits(lastNodeInThisChain, trigger, true);
+		if (! nodesDownstream)
+			continue;
 
 		for (vector<VuoCompilerChain *>::iterator j = i+1; j != chainsForTrigger.end(); ++j)
 		{
 			VuoCompilerChain *otherChain = *j;
 			VuoCompilerNode *firstNodeInOtherChain = otherChain->getNodes().front();
 
-			if (find(nodesDownstream.begin(), nodesDownstream.end(), firstNodeInOtherChain) != nodesDownstream.end())
+			if (isBitSet(nodesDownstream, indexForNode.at(firstNodeInOtherChain)))
 			{
 				chainsImmediatelyDownstream[chain].insert(otherChain);
 				chainsImmediatelyUpstream[otherChain].insert(chain);
@@ -1701,8 +1983,8 @@ bool VuoCompilerGraph::mayEventsReachPublishedOutputPorts(void)
  */
 bool VuoCompilerGraph::isRepeatedInFeedbackLoop(VuoCompilerNode *node, VuoCompilerTriggerPort *trigger)
 {
-	vector<VuoCompilerNode *> downstreamNodes = getNodesDownstream(node, trigger);
-	return find(downstreamNodes.begin(), downstreamNodes.end(), node) != downstreamNodes.end();
+	const uint64_t *downstreamBits = getDownstreamNodeBits(node, trigger, false);
+	return downstreamBits && isBitSet(downstreamBits, indexForNode.at(node));
 }
 
 /**
@@ -1724,12 +2006,10 @@ bool VuoCompilerGraph::hasGatherDownstream(VuoCompilerNode *node, VuoCompilerTri
  */
 bool VuoCompilerGraph::hasScatterPartiallyOverlappedByAnotherTrigger(VuoCompilerTriggerPort *trigger)
 {
-	bool isScatterAtTrigger = getNodesImmediatelyDownstream(trigger).size() > 1;
+	NodeReachability &reachability = getNodeReachability(trigger);
+	bool isScatterAtTrigger = countBits(reachability.immediatelyDownstreamOfTrigger.data()) > 1;
 	if (isScatterAtTrigger)
-	{
-		vector<VuoCompilerNode *> downstreamNodes = getNodesDownstream(trigger);
-		return areNodesPartiallyOverlappedByAnotherTrigger(downstreamNodes, trigger);
-	}
+		return areNodesPartiallyOverlappedByAnotherTrigger(reachability.downstreamOfTrigger.data(), trigger);
 
 	return false;
 }
@@ -1740,20 +2020,18 @@ bool VuoCompilerGraph::hasScatterPartiallyOverlappedByAnotherTrigger(VuoCompiler
  */
 bool VuoCompilerGraph::hasScatterPartiallyOverlappedByAnotherTrigger(VuoCompilerNode *node, VuoCompilerTriggerPort *trigger)
 {
-	bool isScatterAtNode = getNodesImmediatelyDownstream(node, trigger).size() > 1;
+	const uint64_t *immediatelyDownstreamBits = getDownstreamNodeBits(node, trigger, true);
+	bool isScatterAtNode = immediatelyDownstreamBits && countBits(immediatelyDownstreamBits) > 1;
 	if (isScatterAtNode)
-	{
-		vector<VuoCompilerNode *> downstreamNodes = getNodesDownstream(node, trigger);
-		return areNodesPartiallyOverlappedByAnotherTrigger(downstreamNodes, trigger);
-	}
+		return areNodesPartiallyOverlappedByAnotherTrigger(getDownstreamNodeBits(node, trigger, false), trigger);
 
 	return false;
 }
 
 /**
- * Returns true if there is a trigger that is upstream of some but not all of @a nodes.
+ * Returns true if there is a trigger that is upstream of some but not all of the nodes in the bitset @a nodeBits.
  */
-bool VuoCompilerGraph::areNodesPartiallyOverlappedByAnotherTrigger(const vector<VuoCompilerNode *> &nodes, VuoCompilerTriggerPort *trigger)
+bool VuoCompilerGraph::areNodesPartiallyOverlappedByAnotherTrigger(const uint64_t *nodeBits, VuoCompilerTriggerPort *trigger)
 {
 	for (vector<VuoCompilerTriggerPort *>::iterator i = triggers.begin(); i != triggers.end(); ++i)
 	{
@@ -1761,19 +2039,19 @@ bool VuoCompilerGraph::areNodesPartiallyOverlappedByAnotherTrigger(const vector<
 		if (otherTrigger == trigger)
 			continue;
 
-		vector<VuoCompilerNode *> nodesDownstreamOfOtherTrigger = getNodesDownstream(otherTrigger);
-		nodesDownstreamOfOtherTrigger.push_back(nodeForTrigger[otherTrigger]);
+		const vector<uint64_t> &nodesDownstreamOfOtherTrigger = getNodeReachability(otherTrigger).downstreamOfTrigger;
+		size_t otherTriggerNodeIndex = indexForNode.at(nodeForTrigger[otherTrigger]);
 
 		bool hasOverlappedNode = false;
 		bool hasNonOverlappedNode = false;
-		for (vector<VuoCompilerNode *>::const_iterator j = nodes.begin(); j != nodes.end(); ++j)
+		for (size_t j = 0; j < nodeBitsetWords; ++j)
 		{
-			VuoCompilerNode *downstreamNode = *j;
+			uint64_t otherWord = nodesDownstreamOfOtherTrigger[j];
+			if (j == otherTriggerNodeIndex / 64)
+				otherWord |= 1ULL << (otherTriggerNodeIndex % 64);
 
-			if (find(nodesDownstreamOfOtherTrigger.begin(), nodesDownstreamOfOtherTrigger.end(), downstreamNode) != nodesDownstreamOfOtherTrigger.end())
-				hasOverlappedNode = true;
-			else
-				hasNonOverlappedNode = true;
+			hasOverlappedNode = hasOverlappedNode || (nodeBits[j] & otherWord);
+			hasNonOverlappedNode = hasNonOverlappedNode || (nodeBits[j] & ~otherWord);
 		}
 
 		if (hasOverlappedNode && hasNonOverlappedNode)
@@ -2142,6 +2420,37 @@ VuoCompilerGraph::Vertex::Vertex(void)
 	this->toNode = NULL;
 }
 
+/**
+ * Records the current state of @a cable.
+ */
+VuoCompilerGraph::CableState::CableState(VuoCable *cable)
+{
+	VuoNode *fromBaseNode = cable->getFromNode();
+	VuoNode *toBaseNode = cable->getToNode();
+	VuoPort *fromBasePort = cable->getFromPort();
+	VuoPort *toBasePort = cable->getToPort();
+
+	this->fromNode = (fromBaseNode && fromBaseNode->hasCompiler()) ? fromBaseNode->getCompiler() : nullptr;
+	this->fromPort = (fromBasePort && fromBasePort->hasCompiler()) ? static_cast<VuoCompilerPort *>(fromBasePort->getCompiler()) : nullptr;
+	this->toNode = (toBaseNode && toBaseNode->hasCompiler()) ? toBaseNode->getCompiler() : nullptr;
+	this->toPort = (toBasePort && toBasePort->hasCompiler()) ? static_cast<VuoCompilerPort *>(toBasePort->getCompiler()) : nullptr;
+	this->carriesData = cable->hasCompiler() && cable->getCompiler()->carriesData();
+	this->alwaysEventOnly = cable->hasCompiler() && cable->getCompiler()->getAlwaysEventOnly();
+}
+
+/**
+ * Needed so this type can be used in STL containers.
+ */
+VuoCompilerGraph::CableState::CableState(void)
+{
+	this->fromNode = NULL;
+	this->fromPort = NULL;
+	this->toNode = NULL;
+	this->toPort = NULL;
+	this->carriesData = false;
+	this->alwaysEventOnly = false;
+}
+
 /**
  * Creates an edge from @a fromVertex to @a toVertex.
  */
@@ -2195,6 +2504,24 @@ bool operator<(const VuoCompilerGraph::Edge &lhs, const VuoCompilerGraph::Edge &
 								  lhs.toVertex < rhs.toVertex);
 }
 
+/**
+ * Returns true if the cable states have the same endpoints and event-only status.
+ */
+bool operator==(const VuoCompilerGraph::CableState &lhs, const VuoCompilerGraph::CableState &rhs)
+{
+	return (lhs.fromNode == rhs.fromNode && lhs.fromPort == rhs.fromPort &&
+			lhs.toNode == rhs.toNode && lhs.toPort == rhs.toPort &&
+			lhs.carriesData == rhs.carriesData && lhs.alwaysEventOnly == rhs.alwaysEventOnly);
+}
+
+/**
+ * Returns true if the cable states differ in their endpoints or event-only status.
+ */
+bool operator!=(const VuoCompilerGraph::CableState &lhs, const VuoCompilerGraph::CableState &rhs)
+{
+	return ! (lhs == rhs);
+}
+
 /**
  * For debugging.
  */
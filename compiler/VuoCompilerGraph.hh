@@ -25,6 +25,7 @@ class VuoPort;
 class VuoPublishedPort;
 
 #include "VuoPortClass.hh"
+#include <unordered_map>
 
 /**
  * Data structure used for performing graph analysis on a composition in order to compile it or check its validity.
@@ -39,6 +40,7 @@ class VuoCompilerGraph
 public:
 	VuoCompilerGraph(VuoCompilerComposition *composition, VuoCompiler *compiler = nullptr, set<VuoCompilerCable *> potentialCables = set<VuoCompilerCable *>());
 	~VuoCompilerGraph(void);
+	bool update(VuoCompilerComposition *composition, set<VuoCompilerCable *> potentialCables = set<VuoCompilerCable *>());
 	bool mayTransmit(VuoCompilerNode *fromNode, VuoCompilerNode *toNode, VuoCompilerTriggerPort *trigger);
 	bool mayTransmitDataOnly(VuoCompilerNode *node);
 	vector<VuoCompilerTriggerPort *> getTriggerPorts(void);
@@ -110,10 +112,47 @@ private:
 		string toString(void) const;
 	};
 
+	/**
+	 * The endpoints and event-only status of a cable at the time it was analyzed, used to detect cables
+	 * that have been reconnected or changed in place since then.
+	 *
+	 * Only pointers are stored, so this remains safe to compare after the cable, nodes, and ports have been destroyed.
+	 */
+	class CableState
+	{
+	public:
+		VuoCompilerNode *fromNode;
+		VuoCompilerPort *fromPort;
+		VuoCompilerNode *toNode;
+		VuoCompilerPort *toPort;
+		bool carriesData;
+		bool alwaysEventOnly;
+		CableState(VuoCable *cable);
+		CableState(void);
+	};
+
+	/**
+	 * For one trigger, the nodes that an event from the trigger can reach, as bitsets indexed by @ref indexForNode.
+	 *
+	 * Rows are only allocated for the nodes that have outgoing vertices for the trigger.
+	 */
+	class NodeReachability
+	{
+	public:
+		vector<uint64_t> immediatelyDownstreamOfTrigger;  ///< The nodes directly connected to the trigger.
+		vector<uint64_t> downstreamOfTrigger;  ///< The nodes that can be reached from the trigger.
+		vector<size_t> rowForNode;  ///< For each node index, the row in @ref immediatelyDownstream and @ref downstream, or @ref noRow.
+		vector<uint64_t> immediatelyDownstream;  ///< For each row, the nodes directly connected to the row's node.
+		vector<uint64_t> downstream;  ///< For each row, the nodes that can be reached after passing through the row's node.
+		static const size_t noRow = (size_t)-1;  ///< The value of @ref rowForNode for nodes without a row.
+	};
+
 	friend bool operator==(const Vertex &lhs, const Vertex &rhs);
 	friend bool operator!=(const Vertex &lhs, const Vertex &rhs);
 	friend bool operator<(const Vertex &lhs, const Vertex &rhs);
 	friend bool operator<(const Edge &lhs, const Edge &rhs);
+	friend bool operator==(const CableState &lhs, const CableState &rhs);
+	friend bool operator!=(const CableState &lhs, const CableState &rhs);
 
 	/// The vertices reachable from each trigger, including those for all published input and output ports.
 	/// The vertices are listed in topological order.
@@ -154,9 +193,31 @@ private:
 	/// responsible for destroying them.
 	bool ownsPublishedNodeClasses;
 
-	/// The published input and output cables in the composition. This class's internal representation of the composition replaces
-	/// these cables with ones connected to the published input and output nodes.
-	set<VuoCable *> publishedCables;
+	/// The `Spin Off Event` node containing @ref publishedInputTrigger.
+	VuoCompilerNode *publishedInputTriggerNode;
+
+	/// The `Spin Off Event` node containing @ref manuallyFirableTrigger.
+	VuoCompilerNode *manuallyFirableTriggerNode;
+
+	/// The published input ports (and their names) for which @ref publishedInputNode was created.
+	vector< pair<VuoPublishedPort *, string> > publishedInputPortsAnalyzed;
+
+	/// The published output ports (and their names) for which @ref publishedOutputNode was created.
+	vector< pair<VuoPublishedPort *, string> > publishedOutputPortsAnalyzed;
+
+	/// The cables from which the vertices were made, with their state at the time. These are the valid internal cables
+	/// in the composition, the potential cables, and the cables created by this class for analysis (except gather cables).
+	map<VuoCable *, CableState> analyzedCables;
+
+	/// The published input and output cables in the composition, with their state at the time they were analyzed. This class's
+	/// internal representation of the composition replaces these cables with ones connected to the published input and output nodes.
+	map<VuoCable *, pair<CableState, VuoCable *> > replacementForPublishedCable;
+
+	/// The cable from the `Spin Off Event` node to @ref publishedInputNode, if any.
+	VuoCable *publishedInputSpinOffCable;
+
+	/// The cable from the `Spin Off Event` node to VuoCompilerComposition's manually firable input port, if any.
+	VuoCable *manuallyFirableSpinOffCable;
 
 	/// The minimum number of vertices that must be traversed to get from the trigger to the vertex, counting the vertex itself.
 	map<VuoCompilerTriggerPort *, map<Vertex, size_t> > vertexDistanceFromTrigger;
@@ -172,17 +233,20 @@ private:
 	/// Cached results of getChains().
 	map<VuoCompilerTriggerPort *, vector<VuoCompilerChain *> > chains;
 
-	/// Cached results of mayTransmit(VuoCompilerNode *, VuoCompilerNode *, VuoCompilerTriggerPort *).
-	map<VuoCompilerTriggerPort *, map<VuoCompilerNode *, map<VuoCompilerNode *, bool> > > vertexMayTransmit;
-
 	/// Cached results of getNumVerticesWithToNode().
 	map<VuoCompilerTriggerPort *, map<VuoCompilerNode *, size_t> > numVerticesWithToNode;
 
-	/// Cached results of getNodesDownstream(VuoCompilerTriggerPort *).
-	map<VuoCompilerTriggerPort *, vector<VuoCompilerNode *> > downstreamNodesForTrigger;
+	/// Each node in @ref nodes, numbered in the order they're listed there, for indexing into bitsets of nodes.
+	unordered_map<VuoCompilerNode *, size_t> indexForNode;
+
+	/// The inverse of @ref indexForNode.
+	vector<VuoCompilerNode *> nodeForIndex;
+
+	/// The number of 64-bit words in each bitset of nodes.
+	size_t nodeBitsetWords;
 
-	/// Cached results of getNodesDownstream(VuoCompilerNode *, VuoCompilerTriggerPort *).
-	map<VuoCompilerTriggerPort *, map<VuoCompilerNode *, vector<VuoCompilerNode *> > > downstreamNodesForNode;
+	/// Cached results of getNodeReachability(), used by mayTransmit(), getNodesDownstream(), and related functions.
+	map<VuoCompilerTriggerPort *, NodeReachability> nodeReachability;
 
 	/// Cached intermediate data of getPublishedInputEventBlocking().
 	map<Vertex, set<Vertex> > downstreamVerticesNonBlocking;
@@ -194,14 +258,18 @@ private:
 	map<VuoCompilerTriggerPort *, set<string> > publishedOutputNames;
 
 	void initializeInstance(VuoCompilerComposition *composition, set<VuoCompilerCable *> potentialCables, VuoCompilerNode *publishedInputNode, VuoCompilerNode *publishedOutputNode, VuoCompilerNode *publishedInputTriggerNode, bool ownsPublishedNodeClasses, VuoCompilerNode *manuallyFirableTriggerNode);
+	void collectNodesAndCables(VuoCompilerComposition *composition, const set<VuoCompilerCable *> &potentialCables, set<VuoNode *> &nodesToAnalyze, map<VuoCable *, CableState> &cablesToAnalyze);
+	static vector< pair<VuoPublishedPort *, string> > getPublishedPortsAndNames(const vector<VuoPublishedPort *> &publishedPorts);
 	void makeTriggers(set<VuoNode *> nodes);
-	void makeVerticesAndEdges(const set<VuoCable *> &cables);
+	void analyzeTriggers(const vector<VuoCompilerTriggerPort *> &triggersToAnalyze);
+	void forgetTrigger(VuoCompilerTriggerPort *trigger);
+	void makeVerticesAndEdges(const vector<VuoCompilerTriggerPort *> &triggersToAnalyze);
 	void makeDownstreamVerticesWithInclusionRule(VuoCompilerTriggerPort *trigger, std::function<bool(Edge)> includeEdge, map<Vertex, set<Vertex> > &_downstreamVertices, set<Vertex> &_repeatedVertices);
-	void makeDownstreamVertices(void);
-	void sortVertices(void);
-	void makeVertexDistances(void);
+	void makeDownstreamVertices(VuoCompilerTriggerPort *trigger);
+	void sortVertices(VuoCompilerTriggerPort *trigger);
+	void makeVertexDistances(VuoCompilerTriggerPort *trigger);
 	static bool compareTriggers(const pair<VuoCompilerTriggerPort *, size_t> &lhs, const pair<VuoCompilerTriggerPort *, size_t> &rhs);
-	void makeDownstreamNodesViaDataOnlyTransmission(set<VuoNode *> nodes, set<VuoCable *> cables);
+	void makeDownstreamNodesViaDataOnlyTransmission(set<VuoNode *> nodes, const map<VuoCable *, CableState> &cables);
 	static bool mustTransmit(const set<VuoCompilerCable *> &fromCables, const set<VuoCompilerCable *> &toCables);
 	static bool mayTransmit(const set<VuoCompilerCable *> &fromCables, const set<VuoCompilerCable *> &toCables);
 	bool mustTransmit(Vertex vertex, VuoCompilerTriggerPort *trigger);
@@ -211,7 +279,28 @@ private:
 	VuoPort * getOutputPortOnPublishedInputNode(size_t publishedInputPortIndex);
 	size_t getNumVerticesWithFromNode(VuoCompilerNode *fromNode, VuoCompilerTriggerPort *trigger);
 	size_t getNumVerticesWithToNode(VuoCompilerNode *toNode, VuoCompilerTriggerPort *trigger);
-	bool areNodesPartiallyOverlappedByAnotherTrigger(const vector<VuoCompilerNode *> &nodes, VuoCompilerTriggerPort *trigger);
+	bool areNodesPartiallyOverlappedByAnotherTrigger(const uint64_t *nodeBits, VuoCompilerTriggerPort *trigger);
+	void numberNodes(void);
+	NodeReachability & getNodeReachability(VuoCompilerTriggerPort *trigger);
+	const uint64_t * getDownstreamNodeBits(VuoCompilerNode *node, VuoCompilerTriggerPort *trigger, bool immediately);
+	vector<VuoCompilerNode *> getNodesForBits(const uint64_t *nodeBits);
+	size_t countBits(const uint64_t *nodeBits);
+
+	/**
+	 * Returns true if bit @a index is set in @a bits.
+	 */
+	static bool isBitSet(const uint64_t *bits, size_t index)
+	{
+		return bits[index / 64] & (1ULL << (index % 64));
+	}
+
+	/**
+	 * Sets bit @a index in @a bits.
+	 */
+	static void setBit(uint64_t *bits, size_t index)
+	{
+		bits[index / 64] |= 1ULL << (index % 64);
+	}
 
 	friend class TestVuoCompilerBitcodeGenerator;
 };
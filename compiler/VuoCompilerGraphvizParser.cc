@@ -8,7 +8,6 @@
  */
 
 #include <regex>
-#include <sstream>
 #include <stdlib.h>
 #include <graphviz/gvc.h>
 
@@ -77,63 +76,28 @@ VuoCompilerGraphvizParser * VuoCompilerGraphvizParser::newParserFromCompositionF
 /**
  * Parses a .vuo-formatted string, using the node classes provided by the compiler.
  *
+ * The string is read just once. The node class and type names found in it are looked up from the compiler,
+ * and then used to create the nodes, cables, and published ports.
+ *
  * @throw VuoCompilerException Couldn't parse the composition.
  */
 VuoCompilerGraphvizParser * VuoCompilerGraphvizParser::newParserFromCompositionString(const string &composition, VuoCompiler *compiler)
 {
-	// First pass: Just parse the names of node classes and types.
-
-	VuoCompilerGraphvizParser partialParser;
-	partialParser.parse(composition);
-
-	// Look up the node classes and types from the compiler. Doing this now, instead of later when we're on graphvizQueue,
-	// avoids deadlock when loading subcompositions. (VuoCompiler::environmentQueue can call graphvizQueue, but not vice versa.)
+	VuoCompilerGraphvizParser *parser = new VuoCompilerGraphvizParser(compiler);
 
-	map<string, VuoCompilerNodeClass *> compilerNodeClasses;
-	map<string, VuoCompilerType *> compilerTypes;
-	set<string> compilerProNodeClassNames;
-
-	auto addPortTypes = [&](const vector<VuoPortClass *> &portClasses)
+	try
 	{
-		for (VuoPortClass *portClass : portClasses)
-		{
-			VuoType *type = static_cast<VuoCompilerPortClass *>(portClass->getCompiler())->getDataVuoType();
-			if (type)
-				compilerTypes[type->getModuleKey()] = compiler->getType(type->getModuleKey());
-		}
-	};
-
-	for (auto nodeClass : partialParser.dummyNodeClassForName)
+		parser->parse(composition);
+		parser->lookUpNodeClassesAndTypes();
+		parser->makeComposition();
+	}
+	catch (...)
 	{
-		VuoCompilerNodeClass *compilerNodeClass = compiler->getNodeClass(nodeClass.first);
-		compilerNodeClasses[nodeClass.first] = compilerNodeClass;
-
-		if (compilerNodeClass)
-		{
-			addPortTypes(compilerNodeClass->getBase()->getInputPortClasses());
-			addPortTypes(compilerNodeClass->getBase()->getOutputPortClasses());
-		}
+		delete parser;
+		throw;
 	}
 
-	for (auto type : partialParser.typeForPublishedInputPort)
-		if (type.second != "event")
-			compilerTypes[type.second] = compiler->getType(type.second);
-
-	for (auto type : partialParser.typeForPublishedOutputPort)
-		if (type.second != "event")
-			compilerTypes[type.second] = compiler->getType(type.second);
-
-#if VUO_PRO
-	for (auto nodeClass : partialParser.dummyNodeClassForName)
-		if (compiler->isProModule(nodeClass.first))
-			compilerProNodeClassNames.insert(nodeClass.first);
-#endif
-
-	// Second pass: Do the full parsing.
-
-	VuoCompilerGraphvizParser *fullParser = new VuoCompilerGraphvizParser(compiler, compilerNodeClasses, compilerTypes, compilerProNodeClassNames);
-	fullParser->parse(composition);
-	return fullParser;
+	return parser;
 }
 
 /**
@@ -149,7 +113,7 @@ set<string> VuoCompilerGraphvizParser::getNodeClassNamesFromCompositionFile(cons
 	{
 		string composition = VuoFileUtilities::readFileToString(path);
 
-		VuoCompilerGraphvizParser parser;
+		VuoCompilerGraphvizParser parser(nullptr);
 		parser.parse(composition);
 
 		for (auto i : parser.dummyNodeClassForName)
@@ -184,59 +148,148 @@ static int VuoCompilerGraphvizParser_error(char *message)
 }
 
 /**
- * Constructs an object that can only parse preliminary information from a composition (e.g. node class names),
- * which can then be used to call the other constructor.
+ * Constructs an object that is fully capable of parsing a composition, or (if @a compiler is null)
+ * that can only parse preliminary information from a composition (e.g. node class names).
  */
-VuoCompilerGraphvizParser::VuoCompilerGraphvizParser(void) :
-	compiler(nullptr)
+VuoCompilerGraphvizParser::VuoCompilerGraphvizParser(VuoCompiler *compiler) :
+	compiler(compiler),
+	graph(nullptr),
+	publishedInputNode(nullptr),
+	publishedOutputNode(nullptr),
+	manuallyFirableInputNode(nullptr),
+	manuallyFirableInputPort(nullptr),
+	metadata(nullptr)
 {
-	init();
 }
 
 /**
- * Constructs an object that is fully capable of parsing a composition.
+ * Destroys the parsed DOT syntax, if it's still around. The objects that make up the composition are not destroyed.
+ */
+VuoCompilerGraphvizParser::~VuoCompilerGraphvizParser(void)
+{
+	delete graph;
+}
+
+/**
+ * Reads a .vuo-formatted string, creating a dummy node class for each node class name and noting
+ * the data types of published ports.
  *
- * This object will only call @a compiler functions that don't use `environmentQueue`.
+ * This doesn't go through Graphviz or any other global state, so it can run concurrently on multiple threads.
+ *
+ * @throw VuoCompilerException Couldn't parse the composition.
  */
-VuoCompilerGraphvizParser::VuoCompilerGraphvizParser(VuoCompiler *compiler,
-													 const map<string, VuoCompilerNodeClass *> &compilerNodeClasses,
-													 const map<string, VuoCompilerType *> &compilerTypes,
-													 const set<string> &compilerProNodeClassNames) :
-	compiler(compiler),
-	compilerNodeClasses(compilerNodeClasses),
-	compilerTypes(compilerTypes),
-	compilerProNodeClassNames(compilerProNodeClassNames)
+void VuoCompilerGraphvizParser::parse(const string &compositionAsStringOrig)
+{
+	if (compositionAsStringOrig.empty())
+		throw VuoCompilerException(VuoCompilerIssue(VuoCompilerIssue::Error, "parsing composition string", "", "composition string is empty", ""));
+
+	// Backwards compatibility:
+	// If the composition contains the 'manuallyFirable' attribute name without a value, add an empty value so it can be parsed.
+	if (compositionAsStringOrig.find("_manuallyFirable") != string::npos)
+		compositionAsString = std::regex_replace(compositionAsStringOrig, std::regex("(_\\w+_manuallyFirable)(\\s*[^=])"), "$1=\"yes\"$2");
+	else
+		compositionAsString = compositionAsStringOrig;
+
+	graph = new VuoCompilerGraphvizReader(compositionAsString);
+
+	makeDummyNodeClasses();
+	parsePublishedPortTypes();
+}
+
+/**
+ * Looks up the node classes and types referenced by the composition from the compiler.
+ */
+void VuoCompilerGraphvizParser::lookUpNodeClassesAndTypes(void)
 {
-	init();
+	auto addPortTypes = [&](const vector<VuoPortClass *> &portClasses)
+	{
+		for (VuoPortClass *portClass : portClasses)
+		{
+			VuoType *type = static_cast<VuoCompilerPortClass *>(portClass->getCompiler())->getDataVuoType();
+			if (type)
+				compilerTypes[type->getModuleKey()] = compiler->getType(type->getModuleKey());
+		}
+	};
+
+	for (auto nodeClass : dummyNodeClassForName)
+	{
+		VuoCompilerNodeClass *compilerNodeClass = compiler->getNodeClass(nodeClass.first);
+		compilerNodeClasses[nodeClass.first] = compilerNodeClass;
+
+		if (compilerNodeClass)
+		{
+			addPortTypes(compilerNodeClass->getBase()->getInputPortClasses());
+			addPortTypes(compilerNodeClass->getBase()->getOutputPortClasses());
+		}
+	}
+
+	for (auto type : typeForPublishedInputPort)
+		if (type.second != "event")
+			compilerTypes[type.second] = compiler->getType(type.second);
+
+	for (auto type : typeForPublishedOutputPort)
+		if (type.second != "event")
+			compilerTypes[type.second] = compiler->getType(type.second);
+
+#if VUO_PRO
+	for (auto nodeClass : dummyNodeClassForName)
+		if (compiler->isProModule(nodeClass.first))
+			compilerProNodeClassNames.insert(nodeClass.first);
+#endif
 }
 
 /**
- * Helper for constructors.
+ * Creates the nodes, cables, comments, and published ports, using the node classes and types
+ * from lookUpNodeClassesAndTypes().
+ *
+ * @throw VuoCompilerException Couldn't lay out nodes that lack coordinates.
  */
-void VuoCompilerGraphvizParser::init(void)
+void VuoCompilerGraphvizParser::makeComposition(void)
 {
-	publishedInputNode = nullptr;
-	publishedOutputNode = nullptr;
-	manuallyFirableInputNode = nullptr;
-	manuallyFirableInputPort = nullptr;
-	metadata = nullptr;
+	layOutNodesWithoutPositions();
+
+	makeNodeClasses();
+	makeNodes();
+	makeCables();
+	makeComments();
+	makePublishedPorts();
+	setInputPortConstantValues();
+	setPublishedPortDetails();
+	setTriggerPortEventThrottling();
+	setManuallyFirableInputPort();
+	saveNodeDeclarations(compositionAsString);
+	metadata = new VuoCompositionMetadata(compositionAsString);
+
+	delete graph;
+	graph = nullptr;
 }
 
 /**
- * Parses a .vuo-formatted string.
+ * If any nodes or comments lack a valid `pos` attribute (as in some hand-written compositions),
+ * lays out the composition with Graphviz's `dot` algorithm to come up with coordinates for them.
  *
- * @throw VuoCompilerException Couldn't parse the composition.
+ * Compositions saved by the editor always have positions, so this is rarely needed.
+ *
+ * @throw VuoCompilerException Graphviz couldn't parse or lay out the composition.
  *
  * @threadNoQueue{graphvizQueue}
  */
-void VuoCompilerGraphvizParser::parse(const string &compositionAsStringOrig)
+void VuoCompilerGraphvizParser::layOutNodesWithoutPositions(void)
 {
-	if (compositionAsStringOrig.empty())
-		throw VuoCompilerException(VuoCompilerIssue(VuoCompilerIssue::Error, "parsing composition string", "", "composition string is empty", ""));
+	bool hasNodesWithoutPositions = false;
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
+	{
+		double x, y;
+		const char *pos = n->getAttribute("pos");
+		if (!(pos && sscanf(pos, "%20lf,%20lf", &x, &y) == 2))
+		{
+			hasNodesWithoutPositions = true;
+			break;
+		}
+	}
 
-	// Backwards compatibility:
-	// If the composition contains the 'manuallyFirable' attribute name without a value, add an empty value so graphviz can parse it.
-	string compositionAsString = std::regex_replace(compositionAsStringOrig, std::regex("(_\\w+_manuallyFirable)(\\s*[^=])"), "$1=\"yes\"$2");
+	if (! hasNodesWithoutPositions)
+		return;
 
 	VuoCompilerIssues *issues = new VuoCompilerIssues();
 	dispatch_sync(graphvizQueue, ^{
@@ -247,8 +300,8 @@ void VuoCompilerGraphvizParser::parse(const string &compositionAsStringOrig)
 					  bool demandLoading = false;
 					  GVC_t *context = gvContextPlugins(lt_preloaded_symbols, demandLoading);
 
-					  graph = agmemread((char *)compositionAsString.c_str());
-					  if (!graph)
+					  Agraph_t *layoutGraph = agmemread((char *)compositionAsString.c_str());
+					  if (!layoutGraph)
 					  {
 						  VuoCompilerIssue issue(VuoCompilerIssue::Error, "parsing composition", "",
 												 "Graphviz couldn't parse the composition", VuoCompilerGraphvizParser_lastError);
@@ -257,56 +310,50 @@ void VuoCompilerGraphvizParser::parse(const string &compositionAsStringOrig)
 						  gvFreeContext(context);
 						  return;
 					  }
-					  agattr(graph, AGRAPH, (char *)"rankdir", (char *)"LR");
-					  agattr(graph, AGRAPH, (char *)"ranksep", (char *)"0.75");
-					  agattr(graph, AGNODE, (char *)"fontsize", (char *)"18");
-					  agattr(graph, AGNODE, (char *)"shape", (char *)"Mrecord");
-					  if (gvLayout(context, graph, "dot"))  // without this, port names are NULL
+					  agattr(layoutGraph, AGRAPH, (char *)"rankdir", (char *)"LR");
+					  agattr(layoutGraph, AGRAPH, (char *)"ranksep", (char *)"0.75");
+					  agattr(layoutGraph, AGNODE, (char *)"fontsize", (char *)"18");
+					  agattr(layoutGraph, AGNODE, (char *)"shape", (char *)"Mrecord");
+					  if (gvLayout(context, layoutGraph, "dot"))
 					  {
 						  VuoCompilerIssue issue(VuoCompilerIssue::Error, "parsing composition", "",
 												 "Graphviz couldn't lay out the composition", VuoCompilerGraphvizParser_lastError);
 						  issues->append(issue);
-						  agclose(graph);
-						  gvFreeContext(context);
-						  return;
-					  }
-
-					  try
-					  {
-						  makeDummyNodeClasses();
-						  parsePublishedPortTypes();
-					  }
-					  catch (VuoCompilerException &e)
-					  {
-						  issues->append(e.getIssues());
-						  gvFreeLayout(context, graph);
-						  agclose(graph);
+						  agclose(layoutGraph);
 						  gvFreeContext(context);
 						  return;
 					  }
 
-					  if (compiler)
+					  for (Agnode_t *n = agfstnode(layoutGraph); n; n = agnxtnode(layoutGraph, n))
 					  {
-						  makeNodeClasses();
-						  makeNodes();
-						  makeCables();
-						  makeComments();
-						  makePublishedPorts();
-						  setInputPortConstantValues();
-						  setPublishedPortDetails();
-						  setTriggerPortEventThrottling();
-						  setManuallyFirableInputPort();
-						  saveNodeDeclarations(compositionAsString);
-						  metadata = new VuoCompositionMetadata(compositionAsString);
+						  // Flip origin from bottom-left to top-left, to match Qt's origin.
+						  layoutPositionForNodeName[agnameof(n)] = make_pair(ND_coord(n).x, GD_bb(layoutGraph).UR.y - ND_coord(n).y);
 					  }
 
-					  gvFreeLayout(context, graph);
-					  agclose(graph);
+					  gvFreeLayout(context, layoutGraph);
+					  agclose(layoutGraph);
 					  gvFreeContext(context);
 				  });
 
 	if (! issues->isEmpty())
 		throw VuoCompilerException(issues, true);
+
+	delete issues;
+}
+
+/**
+ * Outputs the coordinates of a node or comment from its `pos` attribute or, if that's unspecified or invalid,
+ * from layOutNodesWithoutPositions().
+ */
+void VuoCompilerGraphvizParser::getPosition(VuoCompilerGraphvizReader::Node *n, double &x, double &y)
+{
+	const char *pos = n->getAttribute("pos");
+	if (!(pos && sscanf(pos, "%20lf,%20lf", &x, &y) == 2))
+	{
+		pair<double, double> position = layoutPositionForNodeName[n->getName()];
+		x = position.first;
+		y = position.second;
+	}
 }
 
 /**
@@ -317,9 +364,9 @@ void VuoCompilerGraphvizParser::parse(const string &compositionAsStringOrig)
 void VuoCompilerGraphvizParser::makeDummyNodeClasses(void)
 {
 	map<string, bool> nodeClassNamesSeen;
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
 	{
-		char *nodeClassNameCstr = agget(n, (char *)"type");
+		const char *nodeClassNameCstr = n->getAttribute("type");
 		if (! nodeClassNameCstr)
 		{
 			VuoCompilerIssue issue(VuoCompilerIssue::Error, "parsing composition", "",
@@ -346,34 +393,30 @@ void VuoCompilerGraphvizParser::makeDummyNodeClasses(void)
 		vector<string> inputPortClassNames;
 		vector<string> outputPortClassNames;
 		{
-			field_t *nodeInfo = (field_t *)ND_shape_info(n);
-			int numNodeInfoFields = nodeInfo->n_flds;
-			for (int i = 0; i < numNodeInfoFields; i++)
+			for (const VuoCompilerGraphvizReader::Field &field : n->getFields())
 			{
-				field_t *nodeInfoField = nodeInfo->fld[i];
-
 				// Skip the node instance's title.
-				if (! nodeInfoField->id)
+				if (! field.hasId)
 					continue;
 
 				// The port text should end with '\l' or '\r', indicating whether the port is on left or right side of the node.
-				char * lr = strchr(nodeInfoField->lp->text, '\\');
-				if (! lr)
+				size_t lr = field.text.find('\\');
+				if (lr == string::npos)
 					continue;
 
-				if (lr[1] == 'l')	// input port
+				if (field.text[lr + 1] == 'l')	// input port
 				{
 					// Skip the refresh port, which is added by VuoNodeClass's constructor below.
-					if (strcmp(nodeInfoField->id,"refresh") == 0)
+					if (field.id == "refresh")
 						continue;
 
-					if (find(inputPortClassNames.begin(), inputPortClassNames.end(), nodeInfoField->id) == inputPortClassNames.end())
-						inputPortClassNames.push_back(nodeInfoField->id);
+					if (find(inputPortClassNames.begin(), inputPortClassNames.end(), field.id) == inputPortClassNames.end())
+						inputPortClassNames.push_back(field.id);
 				}
 				else	// output port
 				{
-					if (find(outputPortClassNames.begin(), outputPortClassNames.end(), nodeInfoField->id) == outputPortClassNames.end())
-						outputPortClassNames.push_back(nodeInfoField->id);
+					if (find(outputPortClassNames.begin(), outputPortClassNames.end(), field.id) == outputPortClassNames.end())
+						outputPortClassNames.push_back(field.id);
 				}
 			}
 		}
@@ -419,33 +462,21 @@ void VuoCompilerGraphvizParser::makeNodeClasses(void)
  */
 void VuoCompilerGraphvizParser::makeNodes(void)
 {
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
 	{
-		string nodeClassName = agget(n, (char *)"type");
+		string nodeClassName = n->getAttribute("type");
 		if (nodeClassName == VuoComment::commentTypeName)
 			continue;
 
 		double x,y;
-		char * pos = agget(n, (char *)"pos");
-		if (!(pos && sscanf(pos,"%20lf,%20lf",&x,&y) == 2))
-		{
-			// If the 'pos' attribute is unspecified or invalid, use the post-dot-layout coordinates.
-			x = ND_coord(n).x;
-			// Flip origin from bottom-left to top-left, to match Qt's origin.
-			y = GD_bb(graph).UR.y - ND_coord(n).y;
-		}
+		getPosition(n, x, y);
 
-		string nodeName(agnameof(n));
+		string nodeName(n->getName());
 
 		string nodeTitle;
-		field_t *nodeInfo = (field_t *)ND_shape_info(n);
-		int numNodeInfoFields = nodeInfo->n_flds;
-		for (int i = 0; i < numNodeInfoFields; i++)
-		{
-			field_t *nodeInfoField = nodeInfo->fld[i];
-			if (! nodeInfoField->id)  // title, as opposed to a port
-				nodeTitle = VuoStringUtilities::transcodeFromGraphvizIdentifier(nodeInfoField->lp->text);
-		}
+		for (const VuoCompilerGraphvizReader::Field &field : n->getFields())
+			if (! field.hasId)  // title, as opposed to a port
+				nodeTitle = VuoStringUtilities::transcodeFromGraphvizIdentifier(field.text);
 
 		VuoNodeClass *nodeClass = nodeClassForName[nodeClassName];
 
@@ -469,11 +500,11 @@ void VuoCompilerGraphvizParser::makeNodes(void)
 			nodeClass->setDefaultTitle(nodeTitle);
 		}
 
-		char * nodeTintColor = agget(n, (char *)"fillcolor");
+		const char *nodeTintColor = n->getAttribute("fillcolor");
 		if (nodeTintColor)
 			node->setTintColor(VuoNode::getTintWithGraphvizName(nodeTintColor));
 
-		char *nodeCollapsed = agget(n, (char *)"collapsed");
+		const char *nodeCollapsed = n->getAttribute("collapsed");
 		if (nodeCollapsed && strcmp(nodeCollapsed, "true") == 0)
 			node->setCollapsed(true);
 
@@ -491,74 +522,65 @@ void VuoCompilerGraphvizParser::makeNodes(void)
 }
 
 /**
- * Creates a cable for each Agedge_t in the .vuo file representing a non-published cable,
+ * Creates a cable for each edge in the .vuo file representing a non-published cable,
  * and a placeholder for each one representing a published cable.
  */
 void VuoCompilerGraphvizParser::makeCables(void)
 {
-	map<string, bool> nodeNamesSeen;
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Edge *e : graph->getEdges())
 	{
-		for (Agedge_t *e = agfstedge(graph, n); e; e = agnxtedge(graph, e, n))
-		{
-			string fromNodeName(agnameof(agtail(e)));
-			string toNodeName(agnameof(aghead(e)));
-			string fromPortName(ED_tail_port(e).name);
-			string toPortName(ED_head_port(e).name);
-
-			if (nodeNamesSeen[fromNodeName] || nodeNamesSeen[toNodeName])
-				continue;  // edge N1 -> N2 appears in N1's edge list and in N2's edge list
-
-			VuoNode *fromNode = nodeForName[fromNodeName];
-			VuoNode *toNode = nodeForName[toNodeName];
+		string fromNodeName = e->getTail()->getName();
+		string toNodeName = e->getHead()->getName();
+		string fromPortName = e->getTailPort();
+		string toPortName = e->getHeadPort();
 
-			VuoPort *toPort = toNode->getInputPortWithName(toPortName);
-			VuoPort *fromPort = fromNode->getOutputPortWithName(fromPortName);
-			if (! toPort || ! fromPort)
-				continue;
+		VuoNode *fromNode = nodeForName[fromNodeName];
+		VuoNode *toNode = nodeForName[toNodeName];
 
-			VuoCompilerNode *fromCompilerNode = NULL;
-			VuoCompilerPort *fromCompilerPort = NULL;
-			if (fromNode->hasCompiler())
-			{
-				fromCompilerNode = fromNode->getCompiler();
-				fromCompilerPort = static_cast<VuoCompilerPort *>(fromPort->getCompiler());
-			}
-
-			VuoCompilerNode *toCompilerNode = NULL;
-			VuoCompilerPort *toCompilerPort = NULL;
-			if (toNode->hasCompiler())
-			{
-				toCompilerNode = toNode->getCompiler();
-				toCompilerPort = static_cast<VuoCompilerPort *>(toPort->getCompiler());
-			}
+		VuoPort *toPort = toNode->getInputPortWithName(toPortName);
+		VuoPort *fromPort = fromNode->getOutputPortWithName(fromPortName);
+		if (! toPort || ! fromPort)
+			continue;
 
-			VuoCompilerCable *cable = new VuoCompilerCable(fromCompilerNode, fromCompilerPort, toCompilerNode, toCompilerPort);
-			if (! fromCompilerNode && fromNode != publishedInputNode)
-				cable->getBase()->setFrom(fromNode, fromPort);
-			if (! toCompilerNode && toNode != publishedOutputNode)
-				cable->getBase()->setTo(toNode, toPort);
+		VuoCompilerNode *fromCompilerNode = NULL;
+		VuoCompilerPort *fromCompilerPort = NULL;
+		if (fromNode->hasCompiler())
+		{
+			fromCompilerNode = fromNode->getCompiler();
+			fromCompilerPort = static_cast<VuoCompilerPort *>(fromPort->getCompiler());
+		}
 
-			if (fromNode == publishedInputNode || toNode == publishedOutputNode)
-			{
-				publishedCablesInProgress[orderedCables.size()] = make_pair(cable, make_pair(fromPortName, toPortName));
-				orderedCables.push_back(NULL);
-			}
-			else
-			{
-				orderedCables.push_back(cable->getBase());
-			}
+		VuoCompilerNode *toCompilerNode = NULL;
+		VuoCompilerPort *toCompilerPort = NULL;
+		if (toNode->hasCompiler())
+		{
+			toCompilerNode = toNode->getCompiler();
+			toCompilerPort = static_cast<VuoCompilerPort *>(toPort->getCompiler());
+		}
 
-			char *eventOnlyAttribute = agget(e, (char *)"event");
-			if (eventOnlyAttribute && strcmp(eventOnlyAttribute, "true") == 0)
-				cable->setAlwaysEventOnly(true);
+		VuoCompilerCable *cable = new VuoCompilerCable(fromCompilerNode, fromCompilerPort, toCompilerNode, toCompilerPort);
+		if (! fromCompilerNode && fromNode != publishedInputNode)
+			cable->getBase()->setFrom(fromNode, fromPort);
+		if (! toCompilerNode && toNode != publishedOutputNode)
+			cable->getBase()->setTo(toNode, toPort);
 
-			char *hiddenAttribute = agget(e, (char *)"style");
-			if (hiddenAttribute && strcmp(hiddenAttribute, "invis") == 0)
-				cable->setHidden(true);
+		if (fromNode == publishedInputNode || toNode == publishedOutputNode)
+		{
+			publishedCablesInProgress[orderedCables.size()] = make_pair(cable, make_pair(fromPortName, toPortName));
+			orderedCables.push_back(NULL);
 		}
+		else
+		{
+			orderedCables.push_back(cable->getBase());
+		}
+
+		const char *eventOnlyAttribute = e->getAttribute("event");
+		if (eventOnlyAttribute && strcmp(eventOnlyAttribute, "true") == 0)
+			cable->setAlwaysEventOnly(true);
 
-		nodeNamesSeen[agnameof(n)] = true;
+		const char *hiddenAttribute = e->getAttribute("style");
+		if (hiddenAttribute && strcmp(hiddenAttribute, "invis") == 0)
+			cable->setHidden(true);
 	}
 }
 
@@ -567,42 +589,30 @@ void VuoCompilerGraphvizParser::makeCables(void)
  */
 void VuoCompilerGraphvizParser::makeComments(void)
 {
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
 	{
-		string typeName = agget(n, (char *)"type");
+		string typeName = n->getAttribute("type");
 		if (typeName != VuoComment::commentTypeName)
 			continue;
 
 		double x,y;
-		char * pos = agget(n, (char *)"pos");
-		if (!(pos && sscanf(pos,"%20lf,%20lf",&x,&y) == 2))
-		{
-			// If the 'pos' attribute is unspecified or invalid, use the post-dot-layout coordinates.
-			x = ND_coord(n).x;
-			// Flip origin from bottom-left to top-left, to match Qt's origin.
-			y = GD_bb(graph).UR.y - ND_coord(n).y;
-		}
+		getPosition(n, x, y);
 
 		double widthVal, heightVal;
-		char *width = agget(n, (char *)"width");
+		const char *width = n->getAttribute("width");
 		if (!(width && sscanf(width,"%20lf",&widthVal) == 1))
 			width = 0;
 
-		char *height = agget(n, (char *)"height");
+		const char *height = n->getAttribute("height");
 		if (!(height && sscanf(height,"%20lf",&heightVal) == 1))
 			height = 0;
 
-		string commentName(agnameof(n));
+		string commentName(n->getName());
 
 		string commentContent;
-		field_t *commentInfo = (field_t *)ND_shape_info(n);
-		int numCommentInfoFields = commentInfo->n_flds;
-		for (int i = 0; i < numCommentInfoFields; i++)
-		{
-			field_t *commentInfoField = commentInfo->fld[i];
-			if (! commentInfoField->id)  // text content
-				commentContent = VuoStringUtilities::transcodeFromGraphvizIdentifier(commentInfoField->lp->text);
-		}
+		for (const VuoCompilerGraphvizReader::Field &field : n->getFields())
+			if (! field.hasId)  // text content
+				commentContent = VuoStringUtilities::transcodeFromGraphvizIdentifier(field.text);
 
 		if (commentForName[commentName])
 		{
@@ -613,7 +623,7 @@ void VuoCompilerGraphvizParser::makeComments(void)
 		VuoComment *comment = (new VuoCompilerComment(((widthVal > 0 && heightVal > 0)?
 														  new VuoComment(commentContent, x, y, widthVal, heightVal) :
 														  new VuoComment(commentContent, x, y))))->getBase();
-		char * commentTintColor = agget(n, (char *)"fillcolor");
+		const char *commentTintColor = n->getAttribute("fillcolor");
 		if (commentTintColor)
 			comment->setTintColor(VuoNode::getTintWithGraphvizName(commentTintColor));
 
@@ -631,9 +641,9 @@ void VuoCompilerGraphvizParser::makeComments(void)
  */
 void VuoCompilerGraphvizParser::parsePublishedPortTypes(void)
 {
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
 	{
-		string nodeClassName = agget(n, (char *)"type");
+		string nodeClassName = n->getAttribute("type");
 		if (! (nodeClassName == VuoNodeClass::publishedInputNodeClassName || nodeClassName == VuoNodeClass::publishedOutputNodeClassName) )
 			continue;
 
@@ -794,13 +804,13 @@ void VuoCompilerGraphvizParser::setInputPortConstantValues(void)
 {
 	// Find the constant value of each published input port.
 	map<string, string> constantForPublishedInputPort;
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
 	{
-		string nodeClassName = agget(n, (char *)"type");
+		string nodeClassName = n->getAttribute("type");
 		if (nodeClassName == VuoComment::commentTypeName)
 			continue;
 
-		if (nodeForName[agnameof(n)] == publishedInputNode)
+		if (nodeForName[n->getName()] == publishedInputNode)
 			constantForPublishedInputPort = parsePortConstantValues(n);
 	}
 
@@ -815,13 +825,13 @@ void VuoCompilerGraphvizParser::setInputPortConstantValues(void)
 	}
 
 	// Find and set the constant value of each internal input port.
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
 	{
-		string nodeClassName = agget(n, (char *)"type");
+		string nodeClassName = n->getAttribute("type");
 		if (nodeClassName == VuoComment::commentTypeName)
 			continue;
 
-		VuoNode *node = nodeForName[agnameof(n)];
+		VuoNode *node = nodeForName[n->getName()];
 
 		map<string, string> constantForInputPort = parsePortConstantValues(n);
 
@@ -883,9 +893,9 @@ void VuoCompilerGraphvizParser::setInputPortConstantValues(void)
  */
 void VuoCompilerGraphvizParser::setPublishedPortDetails(void)
 {
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
 	{
-		string nodeClassName = agget(n, (char *)"type");
+		string nodeClassName = n->getAttribute("type");
 
 		if (nodeClassName == VuoNodeClass::publishedInputNodeClassName)
 		{
@@ -919,13 +929,13 @@ void VuoCompilerGraphvizParser::setPublishedPortDetails(void)
  */
 void VuoCompilerGraphvizParser::setTriggerPortEventThrottling(void)
 {
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
 	{
-		string nodeClassName = agget(n, (char *)"type");
+		string nodeClassName = n->getAttribute("type");
 		if (nodeClassName == VuoComment::commentTypeName)
 			continue;
 
-		VuoNode *node = nodeForName[agnameof(n)];
+		VuoNode *node = nodeForName[n->getName()];
 
 		vector<VuoPort *> outputPorts = node->getOutputPorts();
 		for (vector<VuoPort *>::iterator i = outputPorts.begin(); i != outputPorts.end(); ++i)
@@ -953,13 +963,13 @@ void VuoCompilerGraphvizParser::setTriggerPortEventThrottling(void)
  */
 void VuoCompilerGraphvizParser::setManuallyFirableInputPort(void)
 {
-	for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+	for (VuoCompilerGraphvizReader::Node *n : graph->getNodes())
 	{
-		string nodeClassName = agget(n, (char *)"type");
+		string nodeClassName = n->getAttribute("type");
 		if (nodeClassName == VuoComment::commentTypeName)
 			continue;
 
-		VuoNode *node = nodeForName[agnameof(n)];
+		VuoNode *node = nodeForName[n->getName()];
 
 		for (VuoPort *port : node->getInputPorts())
 		{
@@ -980,22 +990,18 @@ void VuoCompilerGraphvizParser::setManuallyFirableInputPort(void)
  *
  * A port name only appears in the map if it has a constant value defined in the composition.
  */
-map<string, string> VuoCompilerGraphvizParser::parsePortConstantValues(Agnode_t *n)
+map<string, string> VuoCompilerGraphvizParser::parsePortConstantValues(VuoCompilerGraphvizReader::Node *n)
 {
 	map<string, string> constantForInputPort;
 
-	field_t *nodeInfo = (field_t *)ND_shape_info(n);
-	int numNodeInfoFields = nodeInfo->n_flds;
-	for (int i = 0; i < numNodeInfoFields; i++)
+	for (const VuoCompilerGraphvizReader::Field &field : n->getFields())
 	{
-		field_t *nodeInfoField = nodeInfo->fld[i];
-		char *inputPortName = nodeInfoField->id;
-		if (! inputPortName)
+		if (! field.hasId)
 			continue;
 
 		string constantValue;
-		if (parseAttributeOfPort(n, inputPortName, "", constantValue))
-			constantForInputPort[inputPortName] = constantValue;
+		if (parseAttributeOfPort(n, field.id, "", constantValue))
+			constantForInputPort[field.id] = constantValue;
 	}
 
 	return constantForInputPort;
@@ -1006,16 +1012,13 @@ map<string, string> VuoCompilerGraphvizParser::parsePortConstantValues(Agnode_t
  *
  * If the port attribute is found, returns true and sets @a attributeValue. Otherwise, returns false.
  */
-bool VuoCompilerGraphvizParser::parseAttributeOfPort(Agnode_t *n, string portName, string suffix, string &attributeValue)
+bool VuoCompilerGraphvizParser::parseAttributeOfPort(VuoCompilerGraphvizReader::Node *n, string portName, string suffix, string &attributeValue)
 {
-	ostringstream oss;
-	oss << "_" << portName;
+	string attributeName = "_" + portName;
 	if (! suffix.empty())
-		oss << "_" << suffix;
-	char *attributeName = strdup(oss.str().c_str());
+		attributeName += "_" + suffix;
 
-	char *rawAttributeValue = agget(n, attributeName);
-	free(attributeName);
+	const char *rawAttributeValue = n->getAttribute(attributeName);
 
 	// The Graphviz parser may return a constant value of the empty string if a constant value was defined
 	// for another identically named port within the same composition, even if it wasn't defined for this port.
@@ -24,9 +24,7 @@ class VuoCompilerNodeClass;
 class VuoCompilerPort;
 class VuoCompilerType;
 
-typedef struct Agraph_s Agraph_t;  ///< From `graphviz/cgraph.h`.
-typedef struct Agnode_s Agnode_t;  ///< From `graphviz/cgraph.h`.
-
+#include "VuoCompilerGraphvizReader.hh"
 #include "VuoHeap.h"
 
 /**
@@ -35,9 +33,11 @@ typedef struct Agnode_s Agnode_t;  ///< From `graphviz/cgraph.h`.
 class VuoCompilerGraphvizParser
 {
 private:
-	static dispatch_queue_t graphvizQueue;  ///< Serializes calls to Graphviz parsing functions.
+	static dispatch_queue_t graphvizQueue;  ///< Serializes calls to Graphviz layout functions.
 	VuoCompiler *compiler;
-	Agraph_t *graph;
+	string compositionAsString;
+	VuoCompilerGraphvizReader *graph;
+	map<string, pair<double, double> > layoutPositionForNodeName;
 	map<string, VuoNodeClass *> dummyNodeClassForName;
 	map<string, VuoNodeClass *> nodeClassForName;
 	map<string, VuoNode *> nodeForName;
@@ -60,10 +60,12 @@ private:
 	map<string, VuoCompilerType *> compilerTypes;
 	set<string> compilerProNodeClassNames;
 
-	VuoCompilerGraphvizParser(void);
-	VuoCompilerGraphvizParser(VuoCompiler *compiler, const map<string, VuoCompilerNodeClass *> &compilerNodeClasses, const map<string, VuoCompilerType *> &compilerTypes, const set<string> &compilerProNodeClassNames);
-	void init(void);
+	VuoCompilerGraphvizParser(VuoCompiler *compiler);
 	void parse(const string &compositionAsStringOrig);
+	void lookUpNodeClassesAndTypes(void);
+	void makeComposition(void);
+	void layOutNodesWithoutPositions(void);
+	void getPosition(VuoCompilerGraphvizReader::Node *n, double &x, double &y);
 	void makeDummyNodeClasses(void);
 	void makeNodeClasses(void);
 	void makeNodes(void);
@@ -75,8 +77,8 @@ private:
 	void setPublishedPortDetails(void);
 	void setTriggerPortEventThrottling(void);
 	void setManuallyFirableInputPort(void);
-	map<string, string> parsePortConstantValues(Agnode_t *n);
-	bool parseAttributeOfPort(Agnode_t *n, string portName, string suffix, string &attributeValue);
+	map<string, string> parsePortConstantValues(VuoCompilerGraphvizReader::Node *n);
+	bool parseAttributeOfPort(VuoCompilerGraphvizReader::Node *n, string portName, string suffix, string &attributeValue);
 	void checkPortClasses(string nodeClassName, vector<VuoPortClass *> dummy, vector<VuoPortClass *> actual);
 	void saveNodeDeclarations(const string &compositionAsString);
 	static VuoType * inferTypeForPublishedPort(string name, const set<VuoCompilerPort *> &connectedPorts);
@@ -85,6 +87,7 @@ public:
 	static VuoCompilerGraphvizParser * newParserFromCompositionFile(const string &path, VuoCompiler *compiler);
 	static VuoCompilerGraphvizParser * newParserFromCompositionString(const string &composition, VuoCompiler *compiler);
 	static set<string> getNodeClassNamesFromCompositionFile(const string &path);
+	~VuoCompilerGraphvizParser(void);
 	vector<VuoNode *> getNodes(void);
 	vector<VuoCable *> getCables(void);
 	vector<VuoComment *> getComments(void);
@@ -0,0 +1,1066 @@
+/**
+ * @file
+ * VuoCompilerGraphvizReader implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+#include "VuoCompilerException.hh"
+#include "VuoCompilerGraphvizReader.hh"
+#include "VuoCompilerIssue.hh"
+
+/**
+ * Reads all nodes, edges, and attributes from a .vuo-formatted string.
+ *
+ * As with Graphviz, only the first graph in the string is read.
+ *
+ * @throw VuoCompilerException The string isn't in the subset of the DOT language that this class reads.
+ */
+VuoCompilerGraphvizReader::VuoCompilerGraphvizReader(const string &composition)
+{
+	begin = composition.c_str();
+	cursor = begin;
+	end = begin + composition.length();
+	line = 1;
+	isStrict = false;
+
+	// Skip the UTF-8 byte order mark, if any.
+	if (composition.compare(0, 3, "\xef\xbb\xbf") == 0)
+		cursor += 3;
+
+	try
+	{
+		readGraph();
+
+		for (Node *node : nodes)
+			parseRecordLabel(node);
+
+		sortEdgesInNodeOrder();
+	}
+	catch (...)
+	{
+		for (Node *node : nodes)
+			delete node;
+		for (Edge *edge : edges)
+			delete edge;
+		throw;
+	}
+}
+
+/**
+ * Destroys the nodes and edges.
+ */
+VuoCompilerGraphvizReader::~VuoCompilerGraphvizReader(void)
+{
+	for (Node *node : nodes)
+		delete node;
+	for (Edge *edge : edges)
+		delete edge;
+}
+
+/**
+ * Returns the graph's name (`G` in `digraph G`), or an empty string if it doesn't have one.
+ */
+string VuoCompilerGraphvizReader::getGraphName(void)
+{
+	return graphName;
+}
+
+/**
+ * Returns the nodes in the order they were first mentioned, which is the order in which Graphviz's
+ * `agfstnode()`/`agnxtnode()` visit them.
+ */
+const vector<VuoCompilerGraphvizReader::Node *> & VuoCompilerGraphvizReader::getNodes(void)
+{
+	return nodes;
+}
+
+/**
+ * Returns each edge once, in the order Graphviz's `agfstedge()`/`agnxtedge()` visit them when iterating
+ * over each node's edges, skipping edges already visited from a previous node.
+ */
+const vector<VuoCompilerGraphvizReader::Edge *> & VuoCompilerGraphvizReader::getEdges(void)
+{
+	return edgesInNodeOrder;
+}
+
+/**
+ * Reads `[strict] (digraph|graph) [name] { statements }`.
+ */
+void VuoCompilerGraphvizReader::readGraph(void)
+{
+	advance();
+
+	if (isAt(Token::Keyword, "strict"))
+	{
+		isStrict = true;
+		advance();
+	}
+
+	if (! (isAt(Token::Keyword, "digraph") || isAt(Token::Keyword, "graph")))
+		throwSyntaxError("'digraph'");
+	advance();
+
+	if (isAt(Token::Id) || isAt(Token::QuotedId))
+	{
+		graphName = token.text;
+		advance();
+	}
+
+	expect(Token::Punctuation, "{", "'{'");
+
+	while (! isAt(Token::Punctuation, "}"))
+	{
+		if (isAt(Token::End))
+			throwSyntaxError("'}'");
+
+		readStatement();
+	}
+}
+
+/**
+ * Reads an attribute statement, graph attribute assignment, node statement, or edge statement.
+ */
+void VuoCompilerGraphvizReader::readStatement(void)
+{
+	if (isAt(Token::Keyword, "graph") || isAt(Token::Keyword, "node") || isAt(Token::Keyword, "edge"))
+	{
+		string kind = token.text;
+		advance();
+
+		if (! isAt(Token::Punctuation, "["))
+			throwSyntaxError("'['");
+
+		for (pair<string, string> attribute : readAttributeLists())
+		{
+			if (kind == "graph")
+				graphAttributes[attribute.first] = attribute.second;
+			else if (kind == "node")
+				nodeAttributes.declare(attribute.first, attribute.second, nodes.size());
+			else
+				edgeAttributes.declare(attribute.first, attribute.second, edges.size());
+		}
+	}
+	else if (isAt(Token::Keyword, "subgraph") || isAt(Token::Punctuation, "{"))
+	{
+		throwError("Subgraphs aren't supported (line " + std::to_string(token.line) + ").");
+	}
+	else if (isAt(Token::Id) || isAt(Token::QuotedId))
+	{
+		string firstId = token.text;
+		advance();
+
+		if (isAt(Token::Punctuation, "="))
+		{
+			advance();
+			graphAttributes[firstId] = readId("an attribute value");
+		}
+		else
+		{
+			vector< vector<NodeReference> > nodeGroups(1);
+			nodeGroups.back().push_back(readNodeReference(firstId));
+
+			while (true)
+			{
+				if (isAt(Token::Punctuation, ","))
+				{
+					advance();
+					string name = readId("a node name");
+					nodeGroups.back().push_back(readNodeReference(name));
+				}
+				else if (isAt(Token::EdgeOp))
+				{
+					advance();
+					if (isAt(Token::Keyword, "subgraph") || isAt(Token::Punctuation, "{"))
+						throwError("Subgraphs aren't supported (line " + std::to_string(token.line) + ").");
+
+					string name = readId("a node name");
+					nodeGroups.push_back(vector<NodeReference>());
+					nodeGroups.back().push_back(readNodeReference(name));
+				}
+				else
+					break;
+			}
+
+			vector< pair<string, string> > attributes;
+			if (isAt(Token::Punctuation, "["))
+				attributes = readAttributeLists();
+
+			if (nodeGroups.size() == 1)
+			{
+				for (NodeReference &reference : nodeGroups.front())
+				{
+					for (pair<string, string> attribute : attributes)
+					{
+						nodeAttributes.declareIfNeeded(attribute.first, nodes.size());
+						reference.node->attributes[attribute.first] = attribute.second;
+					}
+				}
+			}
+			else
+				addEdges(nodeGroups, attributes);
+		}
+	}
+	else
+		throwSyntaxError("a statement");
+
+	if (isAt(Token::Punctuation, ";"))
+		advance();
+}
+
+/**
+ * Reads one or more consecutive `[name=value, …]` lists.
+ */
+vector< pair<string, string> > VuoCompilerGraphvizReader::readAttributeLists(void)
+{
+	vector< pair<string, string> > attributes;
+
+	while (isAt(Token::Punctuation, "["))
+	{
+		advance();
+
+		while (! isAt(Token::Punctuation, "]"))
+		{
+			string name = readId("an attribute name");
+			expect(Token::Punctuation, "=", "'='");
+			string value = readId("an attribute value");
+			attributes.push_back(make_pair(name, value));
+
+			if (isAt(Token::Punctuation, ",") || isAt(Token::Punctuation, ";"))
+				advance();
+		}
+
+		advance();
+	}
+
+	return attributes;
+}
+
+/**
+ * Adds the node named @a name if it hasn't been mentioned before, and reads the `:port` or `:port:compass`
+ * that may follow the name.
+ */
+VuoCompilerGraphvizReader::NodeReference VuoCompilerGraphvizReader::readNodeReference(const string &name)
+{
+	NodeReference reference;
+	reference.node = getOrAddNode(name);
+	reference.hasPort = false;
+
+	if (isAt(Token::Punctuation, ":"))
+	{
+		advance();
+		reference.port = readId("a port name");
+		reference.hasPort = true;
+
+		if (isAt(Token::Punctuation, ":"))
+		{
+			advance();
+			reference.port += ":" + readId("a compass point");
+		}
+	}
+
+	return reference;
+}
+
+/**
+ * Reads an unquoted or quoted identifier.
+ */
+string VuoCompilerGraphvizReader::readId(const string &description)
+{
+	if (! (isAt(Token::Id) || isAt(Token::QuotedId)))
+		throwSyntaxError(description);
+
+	string id = token.text;
+	advance();
+	return id;
+}
+
+/**
+ * Adds an edge from each node in each group to each node in the next group, as in `a, b -> c -> d`.
+ */
+void VuoCompilerGraphvizReader::addEdges(const vector< vector<NodeReference> > &nodeGroups, const vector< pair<string, string> > &attributes)
+{
+	for (size_t i = 0; i + 1 < nodeGroups.size(); ++i)
+	{
+		for (const NodeReference &tail : nodeGroups[i])
+		{
+			for (const NodeReference &head : nodeGroups[i+1])
+			{
+				Edge *edge = nullptr;
+
+				// A strict graph has at most one edge between each pair of nodes.
+				if (isStrict)
+				{
+					auto foundEdge = std::find_if(edges.begin(), edges.end(), [&](Edge *e) {
+						return e->tail == tail.node && e->head == head.node;
+					});
+					if (foundEdge != edges.end())
+						edge = *foundEdge;
+				}
+
+				if (! edge)
+				{
+					edge = new Edge(this, tail.node, head.node, edges.size());
+					edges.push_back(edge);
+				}
+
+				if (tail.hasPort)
+				{
+					edgeAttributes.declareIfNeeded("tailport", edges.size());
+					edge->attributes["tailport"] = tail.port;
+				}
+
+				if (head.hasPort)
+				{
+					edgeAttributes.declareIfNeeded("headport", edges.size());
+					edge->attributes["headport"] = head.port;
+				}
+
+				for (const pair<string, string> &attribute : attributes)
+				{
+					edgeAttributes.declareIfNeeded(attribute.first, edges.size());
+					edge->attributes[attribute.first] = attribute.second;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Returns the node named @a name, adding it if it hasn't been mentioned before.
+ */
+VuoCompilerGraphvizReader::Node * VuoCompilerGraphvizReader::getOrAddNode(const string &name)
+{
+	auto nodeIter = nodeForName.find(name);
+	if (nodeIter != nodeForName.end())
+		return nodeIter->second;
+
+	Node *node = new Node(this, name, nodes.size());
+	nodes.push_back(node);
+	nodeForName[name] = node;
+	return node;
+}
+
+/**
+ * Puts the edges in the order described in getEdges().
+ *
+ * Graphviz visits each node's out-edges sorted by head node, then its in-edges sorted by tail node
+ * (with ties broken by the order in which the edges were added). Since an edge is skipped if it was
+ * already visited from an earlier node, each edge is visited from whichever of its nodes comes first.
+ */
+void VuoCompilerGraphvizReader::sortEdgesInNodeOrder(void)
+{
+	vector< vector<Edge *> > outEdges(nodes.size());
+	vector< vector<Edge *> > inEdges(nodes.size());
+	for (Edge *edge : edges)
+	{
+		if (edge->head->index >= edge->tail->index)
+			outEdges[edge->tail->index].push_back(edge);
+		else
+			inEdges[edge->head->index].push_back(edge);
+	}
+
+	edgesInNodeOrder.reserve(edges.size());
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		std::stable_sort(outEdges[i].begin(), outEdges[i].end(), [](Edge *a, Edge *b) {
+			return a->head->index < b->head->index;
+		});
+		std::stable_sort(inEdges[i].begin(), inEdges[i].end(), [](Edge *a, Edge *b) {
+			return a->tail->index < b->tail->index;
+		});
+
+		edgesInNodeOrder.insert(edgesInNodeOrder.end(), outEdges[i].begin(), outEdges[i].end());
+		edgesInNodeOrder.insert(edgesInNodeOrder.end(), inEdges[i].begin(), inEdges[i].end());
+	}
+}
+
+/**
+ * Splits the node's label into fields, the way Graphviz does for record-shaped nodes.
+ */
+void VuoCompilerGraphvizReader::parseRecordLabel(Node *node)
+{
+	const char *label = node->getAttribute("label");
+
+	if (! parseRecordLabelFields(node, label ? label : "\\N", node->fields))
+	{
+		// Like Graphviz, if the label is malformed, fall back to the node name.
+		node->fields.clear();
+		parseRecordLabelFields(node, "\\N", node->fields);
+	}
+}
+
+/**
+ * Helper for parseRecordLabel(). Follows Graphviz's `parse_reclbl()`, including its handling of whitespace
+ * and escapes, but treats nested fields (`{…}`), which .vuo files don't use, as malformed.
+ *
+ * Returns false if the label is malformed.
+ */
+bool VuoCompilerGraphvizReader::parseRecordLabelFields(Node *node, const string &label, vector<Field> &fields)
+{
+	enum
+	{
+		HasText = 1,
+		HasPort = 2,
+		InText = 4,
+		InPort = 8
+	};
+
+	// As in Graphviz, the text and the port name share a buffer.
+	vector<char> buffer(label.length() + 2);
+	char *text = buffer.data();
+	char *tsp = text;
+	char *psp = text;
+	char *hstsp = text;
+	char *hspsp = nullptr;
+
+	int mode = 0;
+	bool hasPort = false;
+	string port;
+
+	const char *p = label.c_str();
+	while (true)
+	{
+		// Ignore non-printing characters.
+		unsigned char c = *p;
+		if (c && c < ' ')
+		{
+			++p;
+			continue;
+		}
+
+		bool isHardSpace = false;
+
+		switch (*p)
+		{
+			case '<':
+				if (mode & HasPort)
+					return false;
+				mode |= HasPort | InPort;
+				++p;
+				hspsp = psp = text;
+				break;
+
+			case '>':
+				if (! (mode & InPort))
+					return false;
+				if (psp > text + 1 && psp - 1 != hspsp && *(psp - 1) == ' ')
+					--psp;
+				*psp = 0;
+				port = text;
+				hasPort = true;
+				mode &= ~InPort;
+				++p;
+				break;
+
+			case '{':
+			case '}':
+				return false;
+
+			case '|':
+			case '\0':
+			{
+				if (mode & InPort)
+					return false;
+
+				Field field;
+				field.hasId = hasPort;
+				field.id = port;
+				hasPort = false;
+				port.clear();
+
+				if (! (mode & HasText))
+				{
+					mode |= HasText;
+					*tsp++ = ' ';
+				}
+
+				if (tsp > text + 1 && tsp - 1 != hstsp && *(tsp - 1) == ' ')
+					--tsp;
+				*tsp = 0;
+				field.text = substituteEscapesAndEntities(node, text);
+				fields.push_back(field);
+				hstsp = tsp = text;
+
+				if (! *p)
+					return true;
+
+				mode = 0;
+				++p;
+				break;
+			}
+
+			case '\\':
+				if (p[1])
+				{
+					if (p[1] == '{' || p[1] == '}' || p[1] == '|' || p[1] == '<' || p[1] == '>')
+						++p;
+					else if (p[1] == ' ')
+					{
+						isHardSpace = true;
+						++p;
+					}
+					else
+					{
+						*tsp++ = '\\';
+						mode |= InText | HasText;
+						++p;
+					}
+				}
+				[[clang::fallthrough]];
+
+			default:
+				if (! (mode & (InText | InPort)) && *p != ' ')
+					mode |= InText | HasText;
+
+				if (mode & InText)
+				{
+					if (! (*p == ' ' && ! isHardSpace && *(tsp - 1) == ' '))
+						*tsp++ = *p;
+					if (isHardSpace)
+						hstsp = tsp - 1;
+				}
+				else if (mode & InPort)
+				{
+					if (! (*p == ' ' && ! isHardSpace && (psp == text || *(psp - 1) == ' ')))
+						*psp++ = *p;
+					if (isHardSpace)
+						hspsp = psp - 1;
+				}
+
+				++p;
+				while (*p & 128)
+					*tsp++ = *p++;
+				break;
+		}
+	}
+}
+
+/**
+ * Does what Graphviz's `make_label()` does to the text of each record field:
+ * replaces `\N` with the node name, `\G` with the graph name, and `\L` with the node's label,
+ * and then replaces HTML character entities with UTF-8 characters.
+ *
+ * Numeric entities and the named entities `&amp;`, `&lt;`, `&gt;`, `&quot;`, and `&nbsp;` are replaced.
+ */
+string VuoCompilerGraphvizReader::substituteEscapesAndEntities(Node *node, const string &text)
+{
+	string substituted;
+	if (text.find('\\') == string::npos)
+		substituted = text;
+	else
+	{
+		substituted.reserve(text.length());
+		for (size_t i = 0; i < text.length(); ++i)
+		{
+			if (text[i] != '\\' || i + 1 == text.length())
+			{
+				substituted += text[i];
+				continue;
+			}
+
+			char c = text[++i];
+			if (c == 'N')
+				substituted += node->name;
+			else if (c == 'G')
+				substituted += graphName;
+			else if (c == 'L')
+			{
+				const char *label = node->getAttribute("label");
+				substituted += label ? label : "\\N";
+			}
+			else
+			{
+				substituted += '\\';
+				substituted += c;
+			}
+		}
+	}
+
+	if (substituted.find('&') == string::npos)
+		return substituted;
+
+	string decoded;
+	decoded.reserve(substituted.length());
+	for (size_t i = 0; i < substituted.length(); ++i)
+	{
+		if (substituted[i] != '&')
+		{
+			decoded += substituted[i];
+			continue;
+		}
+
+		const char *s = substituted.c_str() + i + 1;
+		unsigned int value = 0;
+		size_t entityLength = 0;
+
+		if (s[0] == '#')
+		{
+			bool isHex = (s[1] == 'x' || s[1] == 'X');
+			size_t j = isHex ? 2 : 1;
+			for ( ; j < 8; ++j)
+			{
+				int digit;
+				if (s[j] >= '0' && s[j] <= '9')
+					digit = s[j] - '0';
+				else if (isHex && s[j] >= 'a' && s[j] <= 'f')
+					digit = s[j] - 'a' + 10;
+				else if (isHex && s[j] >= 'A' && s[j] <= 'F')
+					digit = s[j] - 'A' + 10;
+				else
+					break;
+				value = value * (isHex ? 16 : 10) + digit;
+			}
+
+			if (j < 8 && s[j] == ';')
+				entityLength = j + 1;
+			else
+				value = 0;
+		}
+		else
+		{
+			const char *semicolon = static_cast<const char *>(memchr(s, ';', strnlen(s, 8)));
+			if (semicolon)
+			{
+				string name(s, semicolon - s);
+				if (name == "amp")
+					value = '&';
+				else if (name == "lt")
+					value = '<';
+				else if (name == "gt")
+					value = '>';
+				else if (name == "quot")
+					value = '"';
+				else if (name == "nbsp")
+					value = 0xa0;
+
+				if (value)
+					entityLength = name.length() + 1;
+			}
+		}
+
+		if (! value)
+		{
+			decoded += '&';
+			continue;
+		}
+
+		if (value < 0x7f)
+			decoded += (char)value;
+		else if (value < 0x7ff)
+		{
+			decoded += (char)((value >> 6) | 0xc0);
+			decoded += (char)((value & 0x3f) | 0x80);
+		}
+		else
+		{
+			decoded += (char)((value >> 12) | 0xe0);
+			decoded += (char)(((value >> 6) & 0x3f) | 0x80);
+			decoded += (char)((value & 0x3f) | 0x80);
+		}
+
+		i += entityLength;
+	}
+
+	return decoded;
+}
+
+/**
+ * Reads the next token into @ref token.
+ */
+void VuoCompilerGraphvizReader::advance(void)
+{
+	skipWhitespaceAndComments();
+
+	token.line = line;
+	token.text.clear();
+
+	if (cursor >= end)
+	{
+		token.type = Token::End;
+		return;
+	}
+
+	char c = *cursor;
+	auto isIdChar = [](char c, bool isFirst)
+	{
+		return isalpha((unsigned char)c) || c == '_' || (c & 0x80) || (! isFirst && isdigit((unsigned char)c));
+	};
+
+	if (c == '"')
+	{
+		token.type = Token::QuotedId;
+		token.text = readQuotedString();
+
+		// Concatenate `"a" + "b"`.
+		while (true)
+		{
+			const char *savedCursor = cursor;
+			int savedLine = line;
+
+			skipWhitespaceAndComments();
+			if (cursor < end && *cursor == '+')
+			{
+				++cursor;
+				skipWhitespaceAndComments();
+				if (! (cursor < end && *cursor == '"'))
+					throwSyntaxError("a quoted string after '+'");
+				token.text += readQuotedString();
+			}
+			else
+			{
+				cursor = savedCursor;
+				line = savedLine;
+				break;
+			}
+		}
+	}
+	else if (c == '-' && cursor + 1 < end && (cursor[1] == '>' || cursor[1] == '-'))
+	{
+		token.type = Token::EdgeOp;
+		token.text.assign(cursor, 2);
+		cursor += 2;
+	}
+	else if (isIdChar(c, true))
+	{
+		const char *start = cursor;
+		while (cursor < end && isIdChar(*cursor, false))
+			++cursor;
+		token.text.assign(start, cursor - start);
+
+		string lowercase = token.text;
+		std::transform(lowercase.begin(), lowercase.end(), lowercase.begin(), ::tolower);
+		if (lowercase == "node" || lowercase == "edge" || lowercase == "graph" || lowercase == "digraph"
+				|| lowercase == "subgraph" || lowercase == "strict")
+		{
+			token.type = Token::Keyword;
+			token.text = lowercase;
+		}
+		else
+			token.type = Token::Id;
+	}
+	else if (isdigit((unsigned char)c) || c == '.' || c == '-')
+	{
+		// -?(\.[0-9]+|[0-9]+(\.[0-9]*)?)
+		const char *start = cursor;
+		if (*cursor == '-')
+			++cursor;
+
+		bool hasDigits = false;
+		while (cursor < end && isdigit((unsigned char)*cursor))
+		{
+			++cursor;
+			hasDigits = true;
+		}
+		if (cursor < end && *cursor == '.')
+		{
+			++cursor;
+			while (cursor < end && isdigit((unsigned char)*cursor))
+			{
+				++cursor;
+				hasDigits = true;
+			}
+		}
+
+		if (! hasDigits)
+		{
+			cursor = start;
+			throwSyntaxError("a number");
+		}
+
+		token.type = Token::Id;
+		token.text.assign(start, cursor - start);
+	}
+	else if (c && strchr("{}[]=;,:", c))
+	{
+		token.type = Token::Punctuation;
+		token.text = c;
+		++cursor;
+	}
+	else
+		throwSyntaxError("a token");
+}
+
+/**
+ * Skips whitespace, C- and C++-style comments, and lines beginning with `#`.
+ */
+void VuoCompilerGraphvizReader::skipWhitespaceAndComments(void)
+{
+	while (cursor < end)
+	{
+		char c = *cursor;
+		if (c == '\n')
+		{
+			++line;
+			++cursor;
+		}
+		else if (isspace((unsigned char)c))
+			++cursor;
+		else if (c == '/' && cursor + 1 < end && cursor[1] == '*')
+		{
+			cursor += 2;
+			while (cursor < end && ! (*cursor == '*' && cursor + 1 < end && cursor[1] == '/'))
+			{
+				if (*cursor == '\n')
+					++line;
+				++cursor;
+			}
+			cursor = std::min(cursor + 2, end);
+		}
+		else if ((c == '/' && cursor + 1 < end && cursor[1] == '/')
+				 || (c == '#' && (cursor == begin || cursor[-1] == '\n')))
+		{
+			while (cursor < end && *cursor != '\n')
+				++cursor;
+		}
+		else
+			break;
+	}
+}
+
+/**
+ * Reads a double-quoted string, starting at the opening quote.
+ *
+ * Like Graphviz, this unescapes `\"`, removes escaped newlines, and leaves other escape sequences as is.
+ */
+string VuoCompilerGraphvizReader::readQuotedString(void)
+{
+	int startLine = line;
+	string s;
+
+	++cursor;
+	while (true)
+	{
+		const char *start = cursor;
+		while (cursor < end && *cursor != '"' && *cursor != '\\' && *cursor != '\n')
+			++cursor;
+		s.append(start, cursor - start);
+
+		if (cursor >= end)
+			throwError("Unterminated quoted string starting on line " + std::to_string(startLine) + ".");
+
+		if (*cursor == '"')
+		{
+			++cursor;
+			return s;
+		}
+		else if (*cursor == '\n')
+		{
+			s += '\n';
+			++line;
+			++cursor;
+		}
+		else if (cursor + 1 < end && cursor[1] == '"')
+		{
+			s += '"';
+			cursor += 2;
+		}
+		else if (cursor + 1 < end && cursor[1] == '\\')
+		{
+			s += "\\\\";
+			cursor += 2;
+		}
+		else if (cursor + 1 < end && cursor[1] == '\n')
+		{
+			++line;
+			cursor += 2;
+		}
+		else
+		{
+			s += '\\';
+			++cursor;
+		}
+	}
+}
+
+/**
+ * Returns true if the current token has the given type and (if not empty) text.
+ */
+bool VuoCompilerGraphvizReader::isAt(Token::Type type, const string &text)
+{
+	return token.type == type && (text.empty() || token.text == text);
+}
+
+/**
+ * Skips the current token if it has the given type and text.
+ *
+ * @throw VuoCompilerException The current token is something else.
+ */
+void VuoCompilerGraphvizReader::expect(Token::Type type, const string &text, const string &description)
+{
+	if (! isAt(type, text))
+		throwSyntaxError(description);
+
+	advance();
+}
+
+/**
+ * @throw VuoCompilerException Describes what was expected and what was found at the current position.
+ */
+void VuoCompilerGraphvizReader::throwSyntaxError(const string &expected)
+{
+	string found;
+	if (token.type == Token::End && cursor >= end)
+		found = "the end of the composition";
+	else
+		found = "'" + (token.text.empty() ? string(cursor, std::min<size_t>(end - cursor, 20)) : token.text) + "'";
+
+	throwError("Syntax error on line " + std::to_string(token.line) + ": expected " + expected + " but found " + found + ".");
+}
+
+/**
+ * @throw VuoCompilerException An issue with the given details.
+ */
+void VuoCompilerGraphvizReader::throwError(const string &details)
+{
+	VuoCompilerIssue issue(VuoCompilerIssue::Error, "parsing composition", "",
+						   "Vuo couldn't parse the composition", details);
+	throw VuoCompilerException(issue);
+}
+
+/**
+ * Records that the attribute was declared with a `node [name=defaultValue]` or `edge [name=defaultValue]` statement.
+ *
+ * As in Graphviz, the first declaration of an attribute provides the value for all objects created before it,
+ * and each declaration provides the value for objects created after it (unless overridden per object).
+ */
+void VuoCompilerGraphvizReader::AttributeDeclarations::declare(const string &name, const string &defaultValue, size_t objectCount)
+{
+	defaultsForName[name].push_back(make_pair(objectCount, defaultValue));
+}
+
+/**
+ * Declares the attribute with an empty default value, if it hasn't already been declared.
+ * Graphviz does this when an attribute is first set on an individual object.
+ */
+void VuoCompilerGraphvizReader::AttributeDeclarations::declareIfNeeded(const string &name, size_t objectCount)
+{
+	vector< pair<size_t, string> > &defaults = defaultsForName[name];
+	if (defaults.empty())
+		defaults.push_back(make_pair(objectCount, ""));
+}
+
+/**
+ * Returns the value that Graphviz's `agget()` would return for the object:
+ * its own value if set, otherwise the default value in effect when the object was created,
+ * or null if the attribute has never been declared.
+ */
+const char * VuoCompilerGraphvizReader::AttributeDeclarations::getValue(const string &name, const map<string, string> &attributes, size_t objectIndex) const
+{
+	auto attributeIter = attributes.find(name);
+	if (attributeIter != attributes.end())
+		return attributeIter->second.c_str();
+
+	auto defaultsIter = defaultsForName.find(name);
+	if (defaultsIter == defaultsForName.end())
+		return nullptr;
+
+	const vector< pair<size_t, string> > &defaults = defaultsIter->second;
+	for (auto i = defaults.rbegin(); i != defaults.rend(); ++i)
+		if (i->first <= objectIndex)
+			return i->second.c_str();
+
+	return defaults.front().second.c_str();
+}
+
+/**
+ * Creates a node with no attributes.
+ */
+VuoCompilerGraphvizReader::Node::Node(VuoCompilerGraphvizReader *reader, const string &name, size_t index) :
+	reader(reader),
+	name(name),
+	index(index)
+{
+}
+
+/**
+ * Returns the node's name (identifier).
+ */
+string VuoCompilerGraphvizReader::Node::getName(void) const
+{
+	return name;
+}
+
+/**
+ * Returns the node's value for the attribute, an empty string if the attribute was set on some other node
+ * but not this one, or null if the attribute was never set on any node.
+ */
+const char * VuoCompilerGraphvizReader::Node::getAttribute(const string &name) const
+{
+	return reader->nodeAttributes.getValue(name, attributes, index);
+}
+
+/**
+ * Returns the fields of the node's record-shaped label.
+ */
+const vector<VuoCompilerGraphvizReader::Field> & VuoCompilerGraphvizReader::Node::getFields(void) const
+{
+	return fields;
+}
+
+/**
+ * Creates an edge with no attributes.
+ */
+VuoCompilerGraphvizReader::Edge::Edge(VuoCompilerGraphvizReader *reader, Node *tail, Node *head, size_t index) :
+	reader(reader),
+	tail(tail),
+	head(head),
+	index(index)
+{
+}
+
+/**
+ * Returns the node that the edge comes from.
+ */
+VuoCompilerGraphvizReader::Node * VuoCompilerGraphvizReader::Edge::getTail(void) const
+{
+	return tail;
+}
+
+/**
+ * Returns the node that the edge goes to.
+ */
+VuoCompilerGraphvizReader::Node * VuoCompilerGraphvizReader::Edge::getHead(void) const
+{
+	return head;
+}
+
+/**
+ * Returns the name of the port that the edge comes from, or an empty string if none was specified.
+ */
+string VuoCompilerGraphvizReader::Edge::getTailPort(void) const
+{
+	return getPortName("tailport");
+}
+
+/**
+ * Returns the name of the port that the edge goes to, or an empty string if none was specified.
+ */
+string VuoCompilerGraphvizReader::Edge::getHeadPort(void) const
+{
+	return getPortName("headport");
+}
+
+/**
+ * Returns the edge's value for the attribute, with the same defaults as Node::getAttribute().
+ */
+const char * VuoCompilerGraphvizReader::Edge::getAttribute(const string &name) const
+{
+	return reader->edgeAttributes.getValue(name, attributes, index);
+}
+
+/**
+ * Helper for getTailPort() and getHeadPort().
+ */
+string VuoCompilerGraphvizReader::Edge::getPortName(const string &attributeName) const
+{
+	const char *port = getAttribute(attributeName);
+	if (! port)
+		return "";
+
+	// Like Graphviz's dot layout, if the port is followed by a compass point, use the part after the colon.
+	const char *colon = strchr(port, ':');
+	return colon ? colon + 1 : port;
+}
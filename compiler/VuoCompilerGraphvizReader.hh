@@ -0,0 +1,166 @@
+/**
+ * @file
+ * VuoCompilerGraphvizReader interface.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This interface description may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+#pragma once
+
+/**
+ * Reads the subset of the Graphviz DOT language that .vuo files are written in.
+ *
+ * This interprets nodes, edges, attributes, and record-shaped node labels the same way that Graphviz's
+ * `agmemread()` and record layout do, but without any global state, so many compositions can be read
+ * on different threads at the same time. Subgraphs and HTML-like strings are not supported.
+ */
+class VuoCompilerGraphvizReader
+{
+public:
+	/**
+	 * One of the `|`-separated fields in a node's record-shaped label, such as `<refresh>refresh\l`.
+	 */
+	struct Field
+	{
+		bool hasId;  ///< True if the field begins with a port name in angle brackets.
+		string id;  ///< The port name in angle brackets.
+		string text;  ///< The text following the port name, still containing Graphviz escape sequences such as `\l`.
+	};
+
+	/**
+	 * A node, along with the attributes from all statements that mention it.
+	 */
+	class Node
+	{
+	public:
+		string getName(void) const;
+		const char * getAttribute(const string &name) const;
+		const vector<Field> & getFields(void) const;
+
+	private:
+		Node(VuoCompilerGraphvizReader *reader, const string &name, size_t index);
+
+		VuoCompilerGraphvizReader *reader;
+		string name;
+		size_t index;
+		map<string, string> attributes;
+		vector<Field> fields;
+
+		friend class VuoCompilerGraphvizReader;
+	};
+
+	/**
+	 * An edge between two nodes' ports.
+	 */
+	class Edge
+	{
+	public:
+		Node * getTail(void) const;
+		Node * getHead(void) const;
+		string getTailPort(void) const;
+		string getHeadPort(void) const;
+		const char * getAttribute(const string &name) const;
+
+	private:
+		Edge(VuoCompilerGraphvizReader *reader, Node *tail, Node *head, size_t index);
+		string getPortName(const string &attributeName) const;
+
+		VuoCompilerGraphvizReader *reader;
+		Node *tail;
+		Node *head;
+		size_t index;
+		map<string, string> attributes;
+
+		friend class VuoCompilerGraphvizReader;
+	};
+
+	VuoCompilerGraphvizReader(const string &composition);
+	~VuoCompilerGraphvizReader(void);
+	string getGraphName(void);
+	const vector<Node *> & getNodes(void);
+	const vector<Edge *> & getEdges(void);
+
+private:
+	/**
+	 * The attributes declared for one kind of object (nodes or edges), and how their default values have changed
+	 * as the objects were created.
+	 */
+	class AttributeDeclarations
+	{
+	public:
+		void declare(const string &name, const string &defaultValue, size_t objectCount);
+		void declareIfNeeded(const string &name, size_t objectCount);
+		const char * getValue(const string &name, const map<string, string> &attributes, size_t objectIndex) const;
+
+	private:
+		map< string, vector< pair<size_t, string> > > defaultsForName;
+	};
+
+	/**
+	 * A lexical token in the DOT language.
+	 */
+	struct Token
+	{
+		/// The kinds of tokens.
+		enum Type
+		{
+			End,
+			Id,
+			QuotedId,
+			Keyword,
+			EdgeOp,
+			Punctuation
+		};
+
+		Type type;  ///< The kind of token.
+		string text;  ///< The identifier (with quotes and escapes removed), keyword (lowercase), or punctuation character.
+		int line;  ///< The line on which the token starts.
+	};
+
+	/**
+	 * A node mentioned in a statement, along with the port that the statement specified.
+	 */
+	struct NodeReference
+	{
+		Node *node;  ///< The node.
+		string port;  ///< The port, possibly followed by `:` and a compass point, or empty if none was specified.
+		bool hasPort;  ///< True if the statement specified a port.
+	};
+
+	const char *begin;
+	const char *cursor;
+	const char *end;
+	int line;
+	Token token;
+	bool isStrict;
+	string graphName;
+	map<string, string> graphAttributes;
+	vector<Node *> nodes;
+	map<string, Node *> nodeForName;
+	vector<Edge *> edges;
+	vector<Edge *> edgesInNodeOrder;
+	AttributeDeclarations nodeAttributes;
+	AttributeDeclarations edgeAttributes;
+
+	void readGraph(void);
+	void readStatement(void);
+	vector< pair<string, string> > readAttributeLists(void);
+	NodeReference readNodeReference(const string &name);
+	string readId(const string &description);
+	void addEdges(const vector< vector<NodeReference> > &nodeGroups, const vector< pair<string, string> > &attributes);
+	Node * getOrAddNode(const string &name);
+	void sortEdgesInNodeOrder(void);
+	void parseRecordLabel(Node *node);
+	bool parseRecordLabelFields(Node *node, const string &label, vector<Field> &fields);
+	string substituteEscapesAndEntities(Node *node, const string &text);
+
+	void advance(void);
+	void skipWhitespaceAndComments(void);
+	string readQuotedString(void);
+	bool isAt(Token::Type type, const string &text = "");
+	void expect(Token::Type type, const string &text, const string &description);
+	void throwSyntaxError(const string &expected);
+	void throwError(const string &details);
+};
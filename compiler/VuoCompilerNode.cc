@@ -380,10 +380,9 @@ CallInst * VuoCompilerNode::generateFunctionCall(Function *functionSrc, Module *
 	Value *subcompositionStateValue = NULL;
 	if (getBase()->getNodeClass()->getCompiler()->isSubcomposition())
 	{
-		Value *runtimeStateValue = VuoCompilerCodeGenUtilities::generateGetCompositionStateRuntimeState(module, block, compositionStateValue);
 		Value *compositionIdentifierValue = VuoCompilerCodeGenUtilities::generateGetCompositionStateCompositionIdentifier(module, block, compositionStateValue);
 		subcompositionIdentifierValue = generateSubcompositionIdentifierValue(module, block, compositionIdentifierValue);
-		subcompositionStateValue = VuoCompilerCodeGenUtilities::generateCreateCompositionState(module, block, runtimeStateValue, subcompositionIdentifierValue);
+		subcompositionStateValue = VuoCompilerCodeGenUtilities::generateCreateSubcompositionState(module, block, compositionStateValue, indexInOrderedNodes, subcompositionIdentifierValue);
 		args[0] = new BitCastInst(subcompositionStateValue, functionDst->getFunctionType()->getParamType(0), "", block);
 	}
 
@@ -19,7 +19,8 @@ VuoDirectedAcyclicGraph::Vertex::~Vertex(void)
  */
 VuoDirectedAcyclicGraph::VuoDirectedAcyclicGraph(void)
 {
-	cycleVerticesCacheReady = false;
+	closureRowWords = 0;
+	isClosureValid = false;
 }
 
 /**
@@ -27,8 +28,8 @@ VuoDirectedAcyclicGraph::VuoDirectedAcyclicGraph(void)
  */
 VuoDirectedAcyclicGraph::~VuoDirectedAcyclicGraph(void)
 {
-	for (map< Vertex *, vector<Vertex *> >::iterator i = edges.begin(); i != edges.end(); ++i)
-		delete i->first;
+	for (Vertex *vertex : vertexForId)
+		delete vertex;
 }
 
 /**
@@ -40,7 +41,7 @@ void VuoDirectedAcyclicGraph::addVertex(Vertex *vertex)
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	edges[vertex];
+	getOrAddVertexId(vertex);
 }
 
 /**
@@ -50,30 +51,55 @@ void VuoDirectedAcyclicGraph::removeVertex(Vertex *vertex)
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	for (map< Vertex *, vector<Vertex *> >::iterator i = edges.begin(); i != edges.end(); ++i)
+	size_t id;
+	if (! getVertexId(vertex, id))
+		return;
+
+	// Only the vertices upstream of the removed vertex can lose reachable vertices or have edges to it.
+	vector<size_t> upstreamIds;
+	if (isClosureValid)
 	{
-		for (vector<Vertex *>::iterator j = i->second.begin(); j != i->second.end(); )
-		{
-			if (*j == vertex)
-				j = i->second.erase(j);
-			else
-				++j;
-		}
+		for (size_t upstreamId : getUpstreamVertexIds(id))
+			if (upstreamId != id)
+				upstreamIds.push_back(upstreamId);
+	}
+	else
+	{
+		for (size_t i = 0; i < vertexForId.size(); ++i)
+			if (vertexForId[i] && i != id)
+				upstreamIds.push_back(i);
 	}
 
-	for (map< Vertex *, vector<Vertex *> >::iterator i = edges.begin(); i != edges.end(); )
+	for (size_t upstreamId : upstreamIds)
+		successors[upstreamId].erase(std::remove(successors[upstreamId].begin(), successors[upstreamId].end(), id), successors[upstreamId].end());
+
+	successors[id].clear();
+	idForVertex.erase(vertex);
+	vertexForId[id] = nullptr;
+	freeIds.push_back(id);
+
+	auto keyIter = vertexForKey.find(vertex->key());
+	if (keyIter != vertexForKey.end() && keyIter->second == vertex)
 	{
-		if (i->first == vertex)
-			edges.erase(i++);
-		else
-			++i;
+		vertexForKey.erase(keyIter);
+
+		// If another vertex has the same key, it's now the one that findVertex() returns.
+		for (Vertex *v : vertexForId)
+			if (v && v->key() == vertex->key())
+			{
+				vertexForKey[v->key()] = v;
+				break;
+			}
 	}
 
 	delete vertex;
 
-	downstreamVerticesCache.clear();
-	upstreamVerticesCache.clear();
-	cycleVerticesCacheReady = false;
+	if (isClosureValid)
+	{
+		std::fill(closureRow(id), closureRow(id) + closureRowWords, 0);
+		recomputeClosure(upstreamIds);
+	}
+
 	longestDownstreamPathsCache.clear();
 }
 
@@ -84,9 +110,9 @@ VuoDirectedAcyclicGraph::Vertex * VuoDirectedAcyclicGraph::findVertex(const stri
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	for (map< Vertex *, vector<Vertex *> >::iterator i = edges.begin(); i != edges.end(); ++i)
-		if (i->first->key() == key)
-			return i->first;
+	auto iter = vertexForKey.find(key);
+	if (iter != vertexForKey.end())
+		return iter->second;
 
 	return NULL;
 }
@@ -101,16 +127,36 @@ void VuoDirectedAcyclicGraph::addEdge(Vertex *fromVertex, Vertex *toVertex)
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	if (find(edges[fromVertex].begin(), edges[fromVertex].end(), toVertex) == edges[fromVertex].end())
-	{
-		edges[fromVertex].push_back(toVertex);
-		edges[toVertex];
-	}
+	size_t fromId = getOrAddVertexId(fromVertex);
+	size_t toId = getOrAddVertexId(toVertex);
+
+	if (find(successors[fromId].begin(), successors[fromId].end(), toId) != successors[fromId].end())
+		return;
 
-	downstreamVerticesCache.clear();
-	upstreamVerticesCache.clear();
-	cycleVerticesCacheReady = false;
+	successors[fromId].push_back(toId);
 	longestDownstreamPathsCache.clear();
+
+	if (! isClosureValid)
+		return;
+
+	// If `toVertex` was already reachable, the new edge doesn't change reachability.
+	if (isBitSet(closureRow(fromId), toId))
+		return;
+
+	// Otherwise, everything that can reach `fromVertex` can now reach `toVertex` and everything downstream of it.
+	vector<uint64_t> newlyReachable(closureRow(toId), closureRow(toId) + closureRowWords);
+	newlyReachable[toId / 64] |= 1ULL << (toId % 64);
+
+	vector<size_t> ids = getUpstreamVertexIds(fromId);
+	if (! isBitSet(closureRow(fromId), fromId))
+		ids.push_back(fromId);
+
+	for (size_t id : ids)
+	{
+		uint64_t *row = closureRow(id);
+		for (size_t i = 0; i < closureRowWords; ++i)
+			row[i] |= newlyReachable[i];
+	}
 }
 
 /**
@@ -120,14 +166,44 @@ void VuoDirectedAcyclicGraph::removeEdge(Vertex *fromVertex, Vertex *toVertex)
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	auto iter = find(edges[fromVertex].begin(), edges[fromVertex].end(), toVertex);
-	if (iter != edges[fromVertex].end())
-		edges[fromVertex].erase(iter);
+	size_t fromId;
+	size_t toId;
+	if (! getVertexId(fromVertex, fromId) || ! getVertexId(toVertex, toId))
+		return;
 
-	downstreamVerticesCache.clear();
-	upstreamVerticesCache.clear();
-	cycleVerticesCacheReady = false;
+	auto iter = find(successors[fromId].begin(), successors[fromId].end(), toId);
+	if (iter == successors[fromId].end())
+		return;
+
+	successors[fromId].erase(iter);
 	longestDownstreamPathsCache.clear();
+
+	if (! isClosureValid)
+		return;
+
+	if (! isBitSet(closureRow(fromId), fromId))
+	{
+		// If `fromVertex` isn't in a cycle, its successors' bitsets don't depend on the removed edge.
+		// If they still cover everything that `fromVertex` could reach, nothing upstream changes either.
+		vector<uint64_t> stillReachable(closureRowWords, 0);
+		for (size_t nextId : successors[fromId])
+		{
+			const uint64_t *nextRow = closureRow(nextId);
+			for (size_t w = 0; w < closureRowWords; ++w)
+				stillReachable[w] |= nextRow[w];
+			stillReachable[nextId / 64] |= 1ULL << (nextId % 64);
+		}
+
+		if (std::equal(stillReachable.begin(), stillReachable.end(), closureRow(fromId)))
+			return;
+	}
+
+	// Otherwise, only `fromVertex` and the vertices upstream of it can lose reachable vertices.
+	vector<size_t> ids = getUpstreamVertexIds(fromId);
+	if (! isBitSet(closureRow(fromId), fromId))
+		ids.push_back(fromId);
+
+	recomputeClosure(ids);
 }
 
 /**
@@ -137,7 +213,14 @@ vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicGraph::getImmediatel
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	return edges[vertex];
+	vector<Vertex *> downstreamVertices;
+
+	size_t id;
+	if (getVertexId(vertex, id))
+		for (size_t downstreamId : successors[id])
+			downstreamVertices.push_back(vertexForId[downstreamId]);
+
+	return downstreamVertices;
 }
 
 /**
@@ -150,24 +233,13 @@ vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicGraph::getDownstream
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	return getDownstreamVerticesInternal(vertex);
-}
-
-/**
- * Thread-unsafe version of VuoDirectedAcyclicGraph::getDownstreamVertices().
- */
-vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicGraph::getDownstreamVerticesInternal(Vertex *vertex)
-{
-	map< Vertex *, vector<Vertex *> >::iterator iter = downstreamVerticesCache.find(vertex);
-	if (iter != downstreamVerticesCache.end())
-		return iter->second;
-
-	set<Vertex *> unused;
-	vector<Vertex *> downstreamVertices = getReachableVertices(vertex, edges, unused);
+	size_t id;
+	if (! getVertexId(vertex, id))
+		return vector<Vertex *>();
 
-	downstreamVerticesCache[vertex] = downstreamVertices;
+	ensureClosureIsValid();
 
-	return downstreamVertices;
+	return getVerticesForIds(closureRow(id));
 }
 
 /**
@@ -177,15 +249,17 @@ vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicGraph::getImmediatel
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	vector<VuoDirectedAcyclicGraph::Vertex *> upstreamVertices;
+	vector<Vertex *> upstreamVertices;
 
-	for (auto i : edges)
-	{
-		Vertex *fromVertex = i.first;
-		for (Vertex *toVertex : i.second)
-			if (toVertex == vertex && find(upstreamVertices.begin(), upstreamVertices.end(), fromVertex) == upstreamVertices.end())
-				upstreamVertices.push_back(fromVertex);
-	}
+	size_t id;
+	if (! getVertexId(vertex, id))
+		return upstreamVertices;
+
+	// Scan the adjacency lists directly (O(V+E)) rather than narrowing down the candidates with the closure,
+	// which may need to be rebuilt from scratch (O(V²)) after vertices have been added.
+	for (size_t upstreamId = 0; upstreamId < successors.size(); ++upstreamId)
+		if (find(successors[upstreamId].begin(), successors[upstreamId].end(), id) != successors[upstreamId].end())
+			upstreamVertices.push_back(vertexForId[upstreamId]);
 
 	return upstreamVertices;
 }
@@ -200,24 +274,16 @@ vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicGraph::getUpstreamVe
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	map< Vertex *, vector<Vertex *> >::iterator iter = upstreamVerticesCache.find(vertex);
-	if (iter != upstreamVerticesCache.end())
-		return iter->second;
-
-	map< Vertex *, vector<Vertex *> > backEdges;
-	for (map< Vertex *, vector<Vertex *> >::iterator i = edges.begin(); i != edges.end(); ++i)
-	{
-		for (vector<Vertex *>::iterator j = i->second.begin(); j != i->second.end(); ++j)
-			if (find(backEdges[*j].begin(), backEdges[*j].end(), i->first) == backEdges[*j].end())
-				backEdges[*j].push_back(i->first);
+	vector<Vertex *> upstreamVertices;
 
-		backEdges[i->first];
-	}
+	size_t id;
+	if (! getVertexId(vertex, id))
+		return upstreamVertices;
 
-	set<Vertex *> unused;
-	vector<Vertex *> upstreamVertices = getReachableVertices(vertex, backEdges, unused);
+	ensureClosureIsValid();
 
-	upstreamVerticesCache[vertex] = upstreamVertices;
+	for (size_t upstreamId : getUpstreamVertexIds(id))
+		upstreamVertices.push_back(vertexForId[upstreamId]);
 
 	return upstreamVertices;
 }
@@ -229,115 +295,289 @@ set<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicGraph::getCycleVertices
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	if (cycleVerticesCacheReady)
-		return cycleVerticesCache;
+	ensureClosureIsValid();
 
 	set<Vertex *> cycleVertices;
-	for (map< Vertex *, vector<Vertex *> >::iterator i = edges.begin(); i != edges.end(); ++i)
-	{
-		set<Vertex *> c;
-		getReachableVertices(i->first, edges, c);
-		cycleVertices.insert(c.begin(), c.end());
-	}
-
-	cycleVerticesCacheReady = true;
-	cycleVerticesCache = cycleVertices;
+	for (size_t id = 0; id < vertexForId.size(); ++id)
+		if (vertexForId[id] && isBitSet(closureRow(id), id))
+			cycleVertices.insert(vertexForId[id]);
 
 	return cycleVertices;
 }
 
 /**
  * Returns the number of vertices in the longest path downstream of @a vertex (not counting @a vertex itself).
+ *
+ * Edges that would close a cycle are not followed.
  */
 int VuoDirectedAcyclicGraph::getLongestDownstreamPath(Vertex *vertex)
 {
 	std::lock_guard<std::mutex> lock(graphMutex);
 
-	return getLongestDownstreamPathInternal(vertex);
+	size_t id;
+	if (! getVertexId(vertex, id))
+		return 0;
+
+	return getLongestDownstreamPathInternal(id);
 }
 
 /**
  * Thread-unsafe version of @ref VuoDirectedAcyclicGraph::getLongestDownstreamPath().
  */
-int VuoDirectedAcyclicGraph::getLongestDownstreamPathInternal(Vertex *vertex)
+int VuoDirectedAcyclicGraph::getLongestDownstreamPathInternal(size_t id)
 {
-	auto iter = longestDownstreamPathsCache.find(vertex);
-	if (iter != longestDownstreamPathsCache.end())
-		return iter->second;
+	const int notComputed = -1;
+	const int inProgress = -2;
 
-	int longest = -1;
-	for (Vertex *v : getDownstreamVerticesInternal(vertex))
+	if (longestDownstreamPathsCache.size() != vertexForId.size())
+		longestDownstreamPathsCache.assign(vertexForId.size(), notComputed);
+
+	if (longestDownstreamPathsCache[id] >= 0)
+		return longestDownstreamPathsCache[id];
+
+	// Depth-first search, computing each vertex's path length after all of its successors'.
+	vector< pair<size_t, size_t> > stack;  // vertex ID, index of next successor to visit
+	stack.push_back({id, 0});
+	longestDownstreamPathsCache[id] = inProgress;
+
+	while (! stack.empty())
 	{
-		int curr = getLongestDownstreamPathInternal(v);
-		longest = std::max(longest, curr);
+		size_t currId = stack.back().first;
+		size_t &nextIndex = stack.back().second;
+
+		if (nextIndex < successors[currId].size())
+		{
+			size_t nextId = successors[currId][nextIndex++];
+			if (longestDownstreamPathsCache[nextId] == notComputed)
+			{
+				longestDownstreamPathsCache[nextId] = inProgress;
+				stack.push_back({nextId, 0});
+			}
+		}
+		else
+		{
+			int longest = 0;
+			for (size_t nextId : successors[currId])
+				if (longestDownstreamPathsCache[nextId] >= 0)
+					longest = std::max(longest, longestDownstreamPathsCache[nextId] + 1);
+
+			longestDownstreamPathsCache[currId] = longest;
+			stack.pop_back();
+		}
 	}
 
-	return longest + 1;
+	return longestDownstreamPathsCache[id];
 }
 
 /**
- * Helper function.
+ * Returns the ID of @a vertex, first adding it to the graph if needed.
  */
-vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicGraph::getReachableVertices(Vertex *vertex,
-																						const map< Vertex *, vector<Vertex *> > &edges,
-																						set<Vertex *> &cycleVertices)
+size_t VuoDirectedAcyclicGraph::getOrAddVertexId(Vertex *vertex)
 {
-	map<Vertex *, vector<Vertex *> > reachableVertices;
+	size_t id;
+	if (getVertexId(vertex, id))
+		return id;
 
-	if (edges.find(vertex) == edges.end())
-		return vector<Vertex *>();
+	if (! freeIds.empty())
+	{
+		id = freeIds.back();
+		freeIds.pop_back();
+		vertexForId[id] = vertex;
+	}
+	else
+	{
+		id = vertexForId.size();
+		vertexForId.push_back(vertex);
+		successors.emplace_back();
+
+		// The closure's bitsets have room for a limited number of IDs.
+		if (vertexForId.size() > closureRowWords * 64)
+			isClosureValid = false;
+	}
 
-	list<Vertex *> toVisit;  // Used as a stack, except for a call to find().
-	toVisit.push_back(vertex);
+	idForVertex[vertex] = id;
+	vertexForKey.insert({vertex->key(), vertex});
+	longestDownstreamPathsCache.clear();
 
-	while (! toVisit.empty())
+	return id;
+}
+
+/**
+ * Looks up the ID of @a vertex, returning false if it's not in the graph.
+ */
+bool VuoDirectedAcyclicGraph::getVertexId(Vertex *vertex, size_t &id)
+{
+	auto iter = idForVertex.find(vertex);
+	if (iter == idForVertex.end())
+		return false;
+
+	id = iter->second;
+	return true;
+}
+
+/**
+ * Returns true if @a vertex is in the graph.
+ */
+bool VuoDirectedAcyclicGraph::containsVertex(Vertex *vertex)
+{
+	std::lock_guard<std::mutex> lock(graphMutex);
+
+	return idForVertex.find(vertex) != idForVertex.end();
+}
+
+/**
+ * If the closure has been invalidated (by adding more vertices than it has room for), reallocates and recomputes it.
+ */
+void VuoDirectedAcyclicGraph::ensureClosureIsValid(void)
+{
+	if (isClosureValid)
+		return;
+
+	// Leave room for more vertices to be added without recomputing from scratch.
+	size_t capacity = std::max<size_t>(vertexForId.size() + vertexForId.size() / 4, 64);
+	closureRowWords = (capacity + 63) / 64;
+	closure.assign(closureRowWords * closureRowWords * 64, 0);
+
+	vector<size_t> ids;
+	for (size_t id = 0; id < vertexForId.size(); ++id)
+		if (vertexForId[id])
+			ids.push_back(id);
+
+	isClosureValid = true;
+	recomputeClosure(ids);
+}
+
+/**
+ * Recomputes the closure for the vertices in @a ids, assuming that the closure is up to date for all other vertices.
+ *
+ * This visits the strongly connected components of the subgraph formed by @a ids (using Tarjan's algorithm),
+ * which yields each component after all of the components downstream of it. So each component's bitset
+ * can be formed from the already-computed bitsets of the vertices that it has edges to.
+ */
+void VuoDirectedAcyclicGraph::recomputeClosure(const vector<size_t> &ids)
+{
+	const size_t unvisited = SIZE_MAX;
+	vector<size_t> index(vertexForId.size(), unvisited);
+	vector<size_t> lowLink(vertexForId.size(), 0);
+	vector<bool> isOnStack(vertexForId.size(), false);
+	vector<size_t> componentRoot(vertexForId.size(), unvisited);
+	vector<bool> isRecomputing(vertexForId.size(), false);
+	for (size_t id : ids)
+		isRecomputing[id] = true;
+
+	vector<size_t> componentStack;
+	vector< pair<size_t, size_t> > callStack;  // vertex ID, index of next successor to visit
+	vector<uint64_t> componentRow(closureRowWords);
+	size_t nextIndex = 0;
+
+	for (size_t rootId : ids)
 	{
-		// Visit the vertex at the top of the stack.
-		Vertex *currVertex = toVisit.back();
+		if (index[rootId] != unvisited)
+			continue;
 
-		set<Vertex *> nextVertices;
-		bool areCurrVerticesComplete = true;
+		index[rootId] = lowLink[rootId] = nextIndex++;
+		componentStack.push_back(rootId);
+		isOnStack[rootId] = true;
+		callStack.push_back({rootId, 0});
 
-		// Consider each vertex immediately downstream of this vertex.
-		map< Vertex *, vector<Vertex *> >::const_iterator edgesIter = edges.find(currVertex);
-		if (edgesIter != edges.end())
+		while (! callStack.empty())
 		{
-			for (vector<Vertex *>::const_iterator j = edgesIter->second.begin(); j != edgesIter->second.end(); ++j)
+			size_t currId = callStack.back().first;
+			size_t &successorIndex = callStack.back().second;
+
+			if (successorIndex < successors[currId].size())
 			{
-				Vertex *nextVertex = *j;
-				nextVertices.insert(nextVertex);
+				size_t nextId = successors[currId][successorIndex++];
+				if (! isRecomputing[nextId])
+					continue;
 
-				map<Vertex *, vector<Vertex *> >::iterator nextNextVerticesIter = reachableVertices.find(nextVertex);
-				if (nextNextVerticesIter != reachableVertices.end())
+				if (index[nextId] == unvisited)
 				{
-					// The downstream vertex has already been visited, so add its downstream vertices to this vertex's.
-					nextVertices.insert( nextNextVerticesIter->second.begin(), nextNextVerticesIter->second.end() );
+					index[nextId] = lowLink[nextId] = nextIndex++;
+					componentStack.push_back(nextId);
+					isOnStack[nextId] = true;
+					callStack.push_back({nextId, 0});
 				}
-				else
+				else if (isOnStack[nextId])
+					lowLink[currId] = std::min(lowLink[currId], index[nextId]);
+
+				continue;
+			}
+
+			callStack.pop_back();
+			if (! callStack.empty())
+			{
+				size_t parentId = callStack.back().first;
+				lowLink[parentId] = std::min(lowLink[parentId], lowLink[currId]);
+			}
+
+			if (lowLink[currId] != index[currId])
+				continue;
+
+			// `currId` is the root of a strongly connected component, which is on top of `componentStack`.
+			auto componentBegin = std::find(componentStack.begin(), componentStack.end(), currId);
+			for (auto i = componentBegin; i != componentStack.end(); ++i)
+			{
+				isOnStack[*i] = false;
+				componentRoot[*i] = currId;
+			}
+
+			std::fill(componentRow.begin(), componentRow.end(), 0);
+			for (auto i = componentBegin; i != componentStack.end(); ++i)
+			{
+				for (size_t nextId : successors[*i])
 				{
-					if (find(toVisit.begin(), toVisit.end(), nextVertex) != toVisit.end())
-					{
-						// The downstream vertex is already on the stack, so there's a cycle.
-						cycleVertices.insert(nextVertex);
-					}
-					else
+					componentRow[nextId / 64] |= 1ULL << (nextId % 64);
+
+					// Successors in this component haven't been computed yet, but they're all reachable from each other anyway.
+					if (componentRoot[nextId] != currId)
 					{
-						// The downstream vertex has not yet been visited, so add it to the stack.
-						toVisit.push_back(nextVertex);
-						areCurrVerticesComplete = false;
+						const uint64_t *nextRow = closureRow(nextId);
+						for (size_t w = 0; w < closureRowWords; ++w)
+							componentRow[w] |= nextRow[w];
 					}
 				}
 			}
+
+			for (auto i = componentBegin; i != componentStack.end(); ++i)
+				std::copy(componentRow.begin(), componentRow.end(), closureRow(*i));
+
+			componentStack.erase(componentBegin, componentStack.end());
 		}
+	}
+}
 
-		if (areCurrVerticesComplete)
+/**
+ * Returns the IDs of the vertices that can reach the vertex with ID @a id. Assumes the closure is valid.
+ */
+vector<size_t> VuoDirectedAcyclicGraph::getUpstreamVertexIds(size_t id)
+{
+	vector<size_t> upstreamIds;
+	for (size_t upstreamId = 0; upstreamId < vertexForId.size(); ++upstreamId)
+		if (vertexForId[upstreamId] && isBitSet(closureRow(upstreamId), id))
+			upstreamIds.push_back(upstreamId);
+
+	return upstreamIds;
+}
+
+/**
+ * Returns the vertices whose IDs are set in the bitset @a bits.
+ */
+vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicGraph::getVerticesForIds(const uint64_t *bits)
+{
+	vector<Vertex *> vertices;
+	for (size_t w = 0; w < closureRowWords; ++w)
+	{
+		uint64_t word = bits[w];
+		while (word)
 		{
-			reachableVertices[currVertex].insert(reachableVertices[currVertex].end(), nextVertices.begin(), nextVertices.end());
-			toVisit.pop_back();
+			size_t id = w * 64 + __builtin_ctzll(word);
+			vertices.push_back(vertexForId[id]);
+			word &= word - 1;
 		}
 	}
 
-	return reachableVertices[vertex];
+	return vertices;
 }
 
 /**
@@ -349,15 +589,19 @@ string VuoDirectedAcyclicGraph::toString(bool showVertexPointers)
 
 	ostringstream ss;
 
-	for (map< Vertex *, vector<Vertex *> >::iterator i = edges.begin(); i != edges.end(); ++i)
+	for (size_t id = 0; id < vertexForId.size(); ++id)
 	{
-		ss << i->first->key();
+		if (! vertexForId[id])
+			continue;
+
+		ss << vertexForId[id]->key();
 		if (showVertexPointers)
-			ss << " (" << i->first << ")";
+			ss << " (" << vertexForId[id] << ")";
 		ss << " ->";
 
-		for (Vertex *vertex : i->second)
+		for (size_t downstreamId : successors[id])
 		{
+			Vertex *vertex = vertexForId[downstreamId];
 			ss << " " << vertex->key();
 			if (showVertexPointers)
 				ss << " (" << vertex << ")";
@@ -481,11 +725,12 @@ vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicNetwork::getReachabl
 																						  bool isDownstream, bool isImmediate)
 {
 	vector<VuoDirectedAcyclicGraph::Vertex *> reachableVertices;
+	set<VuoDirectedAcyclicGraph::Vertex *> reachableVerticesSet;
 
 	VuoDirectedAcyclicGraph *containingGraph = NULL;
 	for (map< VuoDirectedAcyclicGraph *, vector<VuoDirectedAcyclicGraph *> >::const_iterator i = edges.begin(); i != edges.end(); ++i)
 	{
-		if (i->first->edges.find(vertex) != i->first->edges.end())
+		if (i->first->containsVertex(vertex))
 		{
 			containingGraph = i->first;
 			break;
@@ -524,7 +769,7 @@ vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicNetwork::getReachabl
 				{
 					VuoDirectedAcyclicGraph::Vertex *currReachableVertex = *j;
 
-					if (find(reachableVertices.begin(), reachableVertices.end(), currReachableVertex) == reachableVertices.end())
+					if (reachableVerticesSet.insert(currReachableVertex).second)
 						reachableVertices.push_back(currReachableVertex);
 				}
 
@@ -553,7 +798,7 @@ vector<VuoDirectedAcyclicGraph::Vertex *> VuoDirectedAcyclicNetwork::getReachabl
 						{
 							moreToVisit[otherGraph].push_back(matchingVertexInOtherGraph);
 
-							if (find(reachableVertices.begin(), reachableVertices.end(), matchingVertexInOtherGraph) == reachableVertices.end())
+							if (reachableVerticesSet.insert(matchingVertexInOtherGraph).second)
 								reachableVertices.push_back(matchingVertexInOtherGraph);
 						}
 					}
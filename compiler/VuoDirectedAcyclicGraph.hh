@@ -10,6 +10,7 @@
 #pragma once
 
 #include <mutex>
+#include <unordered_map>
 
 /**
  * A directed acyclic graph (DAG) data structure with informative error reporting for cycles.
@@ -47,16 +48,40 @@ public:
 	string toString(bool showVertexAddresses=false);
 
 private:
-	vector<Vertex *> getDownstreamVerticesInternal(Vertex *vertex);
-	int getLongestDownstreamPathInternal(Vertex *vertex);
-	static vector<Vertex *> getReachableVertices(Vertex *vertex, const map< Vertex *, vector<Vertex *> > &edges, set<Vertex *> &cycleVertices);
+	size_t getOrAddVertexId(Vertex *vertex);
+	bool getVertexId(Vertex *vertex, size_t &id);
+	void ensureClosureIsValid(void);
+	void recomputeClosure(const vector<size_t> &ids);
+	vector<size_t> getUpstreamVertexIds(size_t id);
+	vector<Vertex *> getVerticesForIds(const uint64_t *bits);
+	int getLongestDownstreamPathInternal(size_t id);
+	bool containsVertex(Vertex *vertex);
 
-	map< Vertex *, vector<Vertex *> > edges;  ///< Adjacency list. Every vertex has a key in this map, even if it doesn't have any outgoing edges.
-	map< Vertex *, vector<Vertex *> > downstreamVerticesCache;
-	map< Vertex *, vector<Vertex *> > upstreamVerticesCache;
-	bool cycleVerticesCacheReady;
-	set<Vertex *> cycleVerticesCache;
-	map< Vertex *, int > longestDownstreamPathsCache;
+	/**
+	 * Returns the row of @ref closure for the vertex with ID `id`.
+	 */
+	uint64_t * closureRow(size_t id)
+	{
+		return closure.data() + id * closureRowWords;
+	}
+
+	/**
+	 * Returns true if bit `id` is set in `row`.
+	 */
+	static bool isBitSet(const uint64_t *row, size_t id)
+	{
+		return row[id / 64] & (1ULL << (id % 64));
+	}
+
+	unordered_map<Vertex *, size_t> idForVertex;  ///< Each vertex's ID, an index into the per-vertex vectors below.
+	vector<Vertex *> vertexForId;  ///< Null for IDs that have been freed by @ref removeVertex.
+	vector<size_t> freeIds;  ///< IDs that can be reused by the next vertex added.
+	vector< vector<size_t> > successors;  ///< Adjacency list, indexed by vertex ID, listing the IDs of immediately downstream vertices in the order their edges were added.
+	unordered_map<string, Vertex *> vertexForKey;  ///< Index for @ref findVertex.
+	vector<uint64_t> closure;  ///< Transitive closure — a bitset for each vertex ID, with a bit set for each vertex ID reachable from it via a path of one or more edges.
+	size_t closureRowWords;  ///< The number of words in each of @ref closure's bitsets.
+	bool isClosureValid;  ///< If false, @ref closure needs to be recomputed from scratch before it can be used.
+	vector<int> longestDownstreamPathsCache;  ///< Indexed by vertex ID. -1 if not yet computed.
 	std::mutex graphMutex;  ///< Synchronizes access to the graph data structures.
 
 	friend class VuoDirectedAcyclicNetwork;
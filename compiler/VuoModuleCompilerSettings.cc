@@ -16,4 +16,5 @@ VuoModuleCompilerSettings::VuoModuleCompilerSettings(void)
 {
 	nodeSet = nullptr;
 	isVerbose = false;
+	shouldUseOwnLLVMContext = false;
 }
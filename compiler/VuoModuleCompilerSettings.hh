@@ -26,4 +26,5 @@ public:
 	vector<string> headerSearchPaths;  ///< Where to look for header files when compiling the module.
 	string target;  ///< The target triple that the module should be compiled for.
 	bool isVerbose;  ///< Whether to output extra messages when compiling the module.
+	bool shouldUseOwnLLVMContext;  ///< Whether to generate the module in an LLVM context of its own, so that it can be compiled in parallel with other modules, and then transfer it to VuoCompiler::globalLLVMContext.
 };
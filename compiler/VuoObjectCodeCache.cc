@@ -0,0 +1,159 @@
+/**
+ * @file
+ * VuoObjectCodeCache implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+#include "VuoObjectCodeCache.hh"
+
+#include "VuoException.hh"
+#include "VuoFileUtilities.hh"
+#include "VuoStringUtilities.hh"
+#include <sys/time.h>
+
+/**
+ * Returns the cache shared by all VuoCompiler instances in this process.
+ */
+VuoObjectCodeCache * VuoObjectCodeCache::getSharedCache(void)
+{
+	static VuoObjectCodeCache *sharedCache = nullptr;
+	static once_flag once;
+	std::call_once(once, [](){
+		string cachePath = VuoFileUtilities::getCachePath();
+		sharedCache = new VuoObjectCodeCache(cachePath.empty() ? "" : cachePath + "/ObjectCode");
+	});
+	return sharedCache;
+}
+
+/**
+ * Creates a cache whose object files are stored in @a cacheDirectoryPath, and cleans out object files
+ * left over from earlier processes that haven't been used recently.
+ */
+VuoObjectCodeCache::VuoObjectCodeCache(const string &cacheDirectoryPath) :
+	cacheDirectoryPath(cacheDirectoryPath)
+{
+	hitCount = 0;
+	lookupCount = 0;
+
+	if (! cacheDirectoryPath.empty())
+	{
+		try
+		{
+			VuoFileUtilities::makeDir(cacheDirectoryPath);
+			deleteUnusedObjectFiles();
+		}
+		catch (VuoException &e)
+		{
+			VUserLog("Warning: Couldn't use the object code cache: %s", e.what());
+			this->cacheDirectoryPath = "";
+		}
+	}
+}
+
+/**
+ * Deletes object files that haven't been accessed in the past 30 days.
+ */
+void VuoObjectCodeCache::deleteUnusedObjectFiles(void)
+{
+	double maxSeconds = 30 * 24 * 60 * 60;  // 30 days
+
+	set<VuoFileUtilities::File *> objectFiles = VuoFileUtilities::findFilesInDirectory(cacheDirectoryPath, {"o"});
+	for (VuoFileUtilities::File *objectFile : objectFiles)
+	{
+		string path = objectFile->path();
+		if (VuoFileUtilities::getSecondsSinceFileLastAccessed(path) > maxSeconds)
+			VuoFileUtilities::deleteFile(path);
+
+		delete objectFile;
+	}
+}
+
+/**
+ * Returns the path of an object file containing the native code for some LLVM bitcode.
+ *
+ * If the cache already has an object file for @a bitcodeHash and @a target, returns it.
+ * Otherwise, calls @a generateObjectFile to write a new object file to the path passed to it,
+ * and adds that file to the cache.
+ *
+ * If there's no cache directory (or the object file couldn't be added to it), the returned object file
+ * is a temporary file; the caller is responsible for deleting it.
+ *
+ * @param bitcodeHash A hash of the bitcode, which should change whenever the bitcode does.
+ * @param target The LLVM target triple that the object file is generated for.
+ * @param generateObjectFile A function that generates the object file at the given path.
+ * @param[out] wasReused True if the object file was already in the cache, false if it was just generated.
+ * @param[out] isTemporary True if the object file is a temporary file rather than belonging to the cache.
+ * @throw VuoCompilerException @a generateObjectFile failed.
+ */
+string VuoObjectCodeCache::useObjectFile(const string &bitcodeHash, const string &target,
+										 std::function<void(const string &)> generateObjectFile, bool &wasReused, bool &isTemporary)
+{
+	string key = VuoStringUtilities::calculateSHA256(target + "\n" + bitcodeHash);
+	string objectPath = cacheDirectoryPath.empty() ? "" : cacheDirectoryPath + "/" + key + ".o";
+
+	bool isHit = ! objectPath.empty() && VuoFileUtilities::fileExists(objectPath);
+	{
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+		++lookupCount;
+		if (isHit)
+			++hitCount;
+	}
+
+	if (isHit)
+	{
+		// Mark the object file as recently used, so deleteUnusedObjectFiles() doesn't delete it.
+		utimes(objectPath.c_str(), nullptr);
+
+		wasReused = true;
+		isTemporary = false;
+		return objectPath;
+	}
+
+	// Generate the object file under a temporary name (in the same directory, so it can be renamed),
+	// then move it into place, so that other processes using the cache never see a partially written file.
+	wasReused = false;
+
+	string tmpPath = cacheDirectoryPath.empty() ?
+						 VuoFileUtilities::makeTmpFile(key, "o") :
+						 VuoFileUtilities::makeTmpFile("." + key, "o", cacheDirectoryPath);
+	try
+	{
+		generateObjectFile(tmpPath);
+	}
+	catch (...)
+	{
+		VuoFileUtilities::deleteFile(tmpPath);
+		throw;
+	}
+
+	if (! objectPath.empty())
+	{
+		try
+		{
+			VuoFileUtilities::moveFile(tmpPath, objectPath);
+			isTemporary = false;
+			return objectPath;
+		}
+		catch (VuoException &e)
+		{
+			VUserLog("Warning: Couldn't add an object file to the cache: %s", e.what());
+		}
+	}
+
+	isTemporary = true;
+	return tmpPath;
+}
+
+/**
+ * Outputs the number of calls to @ref useObjectFile that found an existing object file,
+ * out of the total number of calls, since this process started.
+ */
+void VuoObjectCodeCache::getStatistics(unsigned long &hitCount, unsigned long &lookupCount)
+{
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	hitCount = this->hitCount;
+	lookupCount = this->lookupCount;
+}
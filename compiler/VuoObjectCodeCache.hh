@@ -0,0 +1,39 @@
+/**
+ * @file
+ * VuoObjectCodeCache interface.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This interface description may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+#pragma once
+
+#include <mutex>
+
+/**
+ * A content-addressed cache of native object files, generated from LLVM bitcode when linking compositions.
+ *
+ * Each object file is keyed by a hash of the bitcode it was generated from and the target it was generated for,
+ * so a module that hasn't changed since a previous link (in this process or an earlier one) doesn't go through
+ * code generation again.
+ *
+ * The cache is stored in the filesystem, alongside the module caches. Object files that haven't been used
+ * in a while are deleted the first time the cache is used in a process.
+ */
+class VuoObjectCodeCache
+{
+public:
+	static VuoObjectCodeCache * getSharedCache(void);
+	string useObjectFile(const string &bitcodeHash, const string &target, std::function<void(const string &)> generateObjectFile, bool &wasReused, bool &isTemporary);
+	void getStatistics(unsigned long &hitCount, unsigned long &lookupCount);
+
+private:
+	VuoObjectCodeCache(const string &cacheDirectoryPath);
+	void deleteUnusedObjectFiles(void);
+
+	string cacheDirectoryPath;  ///< The directory containing the object files, or empty if there's nowhere to cache them.
+	unsigned long hitCount;  ///< The number of lookups that found an existing object file.
+	unsigned long lookupCount;  ///< The number of calls to @ref useObjectFile.
+	std::mutex statisticsMutex;  ///< Synchronizes access to `hitCount` and `lookupCount`.
+};
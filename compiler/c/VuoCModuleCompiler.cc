@@ -923,6 +923,10 @@ string VuoCModuleCompiler::abridgeUnspecializedGenericType(const string &inputSo
 /**
  * Compiles the source code to LLVM bitcode.
  *
+ * If VuoModuleCompilerSettings::shouldUseOwnLLVMContext is set, the source code is compiled into an LLVM context
+ * created just for this module, so that it doesn't have to wait on @a llvmQueue (and other modules can be compiled
+ * at the same time). The resulting module is then transferred to VuoCompiler::globalLLVMContext by way of bitcode.
+ *
  * @throw VuoCompilerException The source code could not be parsed into an AST.
  */
 llvm::Module * VuoCModuleCompiler::compileTransformedSourceCode(const string &inputSourceCode, dispatch_queue_t llvmQueue,
@@ -930,47 +934,94 @@ llvm::Module * VuoCModuleCompiler::compileTransformedSourceCode(const string &in
 {
 	__block llvm::Module *module = nullptr;
 
-	dispatch_sync(llvmQueue, ^{
-		IntrusiveRefCntPtr<vfs::InMemoryFileSystem> inMemoryFileSystem;
-		string dependencyFilePath;
-		unique_ptr<CompilerInstance> compilerInstance = createCompilerInstance(inputSourceCode, false, true, true, dependencyFilePath, inMemoryFileSystem);
+	if (! settings.shouldUseOwnLLVMContext)
+	{
+		dispatch_sync(llvmQueue, ^{
+			module = generateModule(inputSourceCode, VuoCompiler::globalLLVMContext, makeDependencies).release();
+		});
 
-		unique_ptr<VuoPreprocessorCallbacks> preprocessorCallbacks(new VuoPreprocessorCallbacks(this, inMemoryFileSystem.get(), true));
+		return module;
+	}
 
-		// Pass in an LLVM context that will outlive the EmitLLVMOnlyAction so that the generated Module
-		// can still be used after the EmitLLVMOnlyAction is destroyed.
-		VuoEmitLLVMOnlyAction action(VuoCompiler::globalLLVMContext, std::move(preprocessorCallbacks));
+	// A fresh context for each module (rather than one per thread, reused) keeps the generated code independent of
+	// which modules happened to be compiled before it on the same thread.
+	SmallVector<char, 0> bitcode;
+	{
+		LLVMContext context;
+		unique_ptr<llvm::Module> ownModule = generateModule(inputSourceCode, &context, makeDependencies);
+		if (! ownModule)
+			return nullptr;
 
-		// If the action fails, VuoCompilerDiagnosticConsumer appends to `clangIssues`.
-		bool ok = compilerInstance->ExecuteAction(action);
+		raw_svector_ostream out(bitcode);
+		llvm::WriteBitcodeToFile(ownModule.get(), out);
+	}
 
-		if (ok)
+	const char *bitcodeData = bitcode.data();
+	size_t bitcodeSize = bitcode.size();
+	dispatch_sync(llvmQueue, ^{
+		MemoryBufferRef bitcodeBuffer(StringRef(bitcodeData, bitcodeSize), moduleKey);
+		auto wrappedModule = llvm::parseBitcodeFile(bitcodeBuffer, *VuoCompiler::globalLLVMContext);
+		if (wrappedModule)
+			module = wrappedModule.get().release();
+		else
 		{
-			unique_ptr<llvm::Module> modulePtr = action.takeModule();
-			if (modulePtr)
-			{
-				module = modulePtr.release();
+			string error;
+			handleAllErrors(wrappedModule.takeError(), [&error](const ErrorInfoBase &ei) {
+				error += " " + ei.message();
+			});
 
-				try
-				{
-					makeDependencies = VuoMakeDependencies::createFromFile(dependencyFilePath);
-					replaceVirtualPathsInDependencyFile(makeDependencies, inMemoryFileSystem.get());
-				}
-				catch (VuoException &e) {}
-
-				VuoFileUtilities::deleteFile(dependencyFilePath);
-			}
-			else
-			{
-				VuoCompilerIssue issue(VuoCompilerIssue::Error, "compiling module", sourcePath, "", "Failed to generate an LLVM module.");
-				compileIssues->append(issue);
-			}
+			VuoCompilerIssue issue(VuoCompilerIssue::Error, "compiling module", sourcePath, "", "Failed to transfer the LLVM module to the global context:" + error);
+			compileIssues->append(issue);
 		}
 	});
 
 	return module;
 }
 
+/**
+ * Runs Clang on the source code, generating an LLVM module in @a context.
+ *
+ * @threadQueue{llvmQueue} (if @a context is VuoCompiler::globalLLVMContext)
+ */
+unique_ptr<llvm::Module> VuoCModuleCompiler::generateModule(const string &inputSourceCode, LLVMContext *context,
+															 shared_ptr<VuoMakeDependencies> &makeDependencies)
+{
+	IntrusiveRefCntPtr<vfs::InMemoryFileSystem> inMemoryFileSystem;
+	string dependencyFilePath;
+	unique_ptr<CompilerInstance> compilerInstance = createCompilerInstance(inputSourceCode, false, true, true, dependencyFilePath, inMemoryFileSystem);
+
+	unique_ptr<VuoPreprocessorCallbacks> preprocessorCallbacks(new VuoPreprocessorCallbacks(this, inMemoryFileSystem.get(), true));
+
+	// Pass in an LLVM context that will outlive the EmitLLVMOnlyAction so that the generated Module
+	// can still be used after the EmitLLVMOnlyAction is destroyed.
+	VuoEmitLLVMOnlyAction action(context, std::move(preprocessorCallbacks));
+
+	// If the action fails, VuoCompilerDiagnosticConsumer appends to `clangIssues`.
+	bool ok = compilerInstance->ExecuteAction(action);
+	if (! ok)
+		return nullptr;
+
+	unique_ptr<llvm::Module> module = action.takeModule();
+	if (module)
+	{
+		try
+		{
+			makeDependencies = VuoMakeDependencies::createFromFile(dependencyFilePath);
+			replaceVirtualPathsInDependencyFile(makeDependencies, inMemoryFileSystem.get());
+		}
+		catch (VuoException &e) {}
+
+		VuoFileUtilities::deleteFile(dependencyFilePath);
+	}
+	else
+	{
+		VuoCompilerIssue issue(VuoCompilerIssue::Error, "compiling module", sourcePath, "", "Failed to generate an LLVM module.");
+		compileIssues->append(issue);
+	}
+
+	return module;
+}
+
 /**
  * Returns the path name found in @a line after @a prefix.
  */
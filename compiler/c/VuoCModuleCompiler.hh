@@ -41,6 +41,7 @@ private:
 	string replaceGenericTypes(const string &inputSourceCode);
 	string abridgeUnspecializedGenericType(const string &inputSourceCode);
 	Module * compileTransformedSourceCode(const string &inputSourceCode, dispatch_queue_t llvmQueue, shared_ptr<VuoMakeDependencies> &makeDependencies);
+	unique_ptr<Module> generateModule(const string &inputSourceCode, LLVMContext *context, shared_ptr<VuoMakeDependencies> &makeDependencies);
 	string extractPath(const char *line, const char *prefix);
 	unique_ptr<VuoFileUtilities::File> findHeaderFile(const string &path);
 	unique_ptr<VuoFileUtilities::File> findGenericHeaderFile(const string &specializedModuleKey, string &genericPrefix);
@@ -49,6 +49,10 @@ class TelemetryLogger : public VuoRunnerDelegate
 	{
 		printf("lostContactWithComposition\n");
 	}
+	void receivedTelemetryNodeSynchronizationStats(unsigned long uncontendedClaims, unsigned long spinningClaims, unsigned long parkedClaims)
+	{
+		printf("nodeSynchronizationStats: %lu %lu %lu\n", uncontendedClaims, spinningClaims, parkedClaims);
+	}
 };
 
 int main (int argc, char * const argv[])
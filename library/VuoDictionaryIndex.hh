@@ -0,0 +1,142 @@
+/**
+ * @file
+ * VuoDictionaryIndex interface and implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the MIT License.
+ * For more information, see https://vuo.org/license.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+#include "VuoHeap.h"
+
+/**
+ * A hash index from each key in a dictionary with text keys to the key's position in the dictionary's lists.
+ *
+ * The dictionary owns its keys list, and its functions only ever append keys to it, so the index just needs
+ * to check whether the dictionary has a different keys list or more keys than last time, rather than comparing
+ * the keys themselves. The index holds a reference to the keys list it indexed, so the list (and the keys it holds)
+ * can't be deallocated and another list allocated at the same address.
+ *
+ * Copies of a dictionary share its index, so it's safe for multiple threads to call @ref find on the same index.
+ */
+class VuoDictionaryIndex
+{
+public:
+	/**
+	 * Dictionaries with at most this many keys are searched linearly, since that's faster than hashing.
+	 */
+	static const unsigned long threshold = 8;
+
+	/**
+	 * Creates an empty, reference-counted index, to be filled in the first time a key is looked up.
+	 */
+	static void *make(void)
+	{
+		void *memory = VuoHeap_allocRefCounted(sizeof(VuoDictionaryIndex), destroy);
+		return new (memory) VuoDictionaryIndex;
+	}
+
+	/**
+	 * Returns the 1-based position of @a key in @a keys (whose data is @a keysData and count is @a count),
+	 * or 0 if the key isn't found.
+	 *
+	 * @a index may be null (for a dictionary initialized directly from lists), in which case the keys are scanned.
+	 */
+	static unsigned long find(void *index, const void *keys, const char * const *keysData, unsigned long count, const char *key)
+	{
+		if (!key)
+			return 0;
+
+		VuoDictionaryIndex *i = static_cast<VuoDictionaryIndex *>(index);
+		if (!i || count <= threshold)
+		{
+			for (unsigned long k = 0; k < count; ++k)
+				if (keysData[k] && strcmp(key, keysData[k]) == 0)
+					return k + 1;
+
+			return 0;
+		}
+
+		std::lock_guard<std::mutex> lock(i->mutex);
+
+		if (keys != i->indexedKeys || count < i->indexedCount)
+			i->reset(keys);
+
+		// Add just the keys appended since the last lookup.
+		if (i->indexedCount < count)
+		{
+			i->positions.reserve(count);
+			for (unsigned long k = i->indexedCount; k < count; ++k)
+				if (keysData[k])
+					i->positions.emplace(keysData[k], k + 1);
+			i->indexedCount = count;
+		}
+
+		auto found = i->positions.find(key);
+		return found != i->positions.end() ? found->second : 0;
+	}
+
+private:
+	/**
+	 * Hashes a key (FNV-1a).
+	 */
+	struct KeyHash
+	{
+		size_t operator()(const char *key) const
+		{
+			uint64_t hash = 0xcbf29ce484222325ULL;
+			for (const unsigned char *c = (const unsigned char *)key; *c; ++c)
+				hash = (hash ^ *c) * 0x100000001b3ULL;
+			return hash;
+		}
+	};
+
+	/**
+	 * Compares keys.
+	 */
+	struct KeyEqual
+	{
+		bool operator()(const char *a, const char *b) const
+		{
+			return strcmp(a, b) == 0;
+		}
+	};
+
+	std::mutex mutex;  ///< Synchronizes access to the other members.
+	const void *indexedKeys = nullptr;  ///< The keys list that @ref positions refers to. Retained by the index.
+	unsigned long indexedCount = 0;  ///< The number of items in @ref indexedKeys that have been added to @ref positions.
+	std::unordered_map<const char *, unsigned long, KeyHash, KeyEqual> positions;  ///< Each key's 1-based position in the lists. If a key occurs more than once, its first position.
+
+	~VuoDictionaryIndex(void)
+	{
+		VuoRelease(indexedKeys);
+	}
+
+	/**
+	 * Empties the index, and starts indexing @a keys.
+	 */
+	void reset(const void *keys)
+	{
+		positions.clear();
+		indexedCount = 0;
+		VuoRetain(keys);
+		VuoRelease(indexedKeys);
+		indexedKeys = keys;
+	}
+
+	/**
+	 * Destroys a VuoDictionaryIndex.
+	 */
+	static void destroy(void *index)
+	{
+		static_cast<VuoDictionaryIndex *>(index)->~VuoDictionaryIndex();
+	}
+};
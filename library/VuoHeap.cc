@@ -12,16 +12,19 @@
 #include <dlfcn.h>
 #include <sys/errno.h>
 #include <sys/mman.h>
-#include <map>
+#include <atomic>
 #include <set>
 #include <sstream>
 #include <iomanip>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 using namespace std;
 #include "VuoLog.h"
 #include "VuoRuntime.h"
 
 static set<const void *> *VuoHeap_trace;	///< Heap pointers to trace.
-static pthread_mutex_t VuoHeap_mutex = PTHREAD_MUTEX_INITIALIZER;  ///< Protects access to `referenceCounts`.
+static pthread_mutex_t VuoHeap_traceMutex = PTHREAD_MUTEX_INITIALIZER;  ///< Protects access to `VuoHeap_trace`.
 
 /**
  * Calls the vuoSendError() function defined in the runtime (without introducing a direct dependency on the runtime).
@@ -83,8 +86,391 @@ typedef struct
 #endif
 } VuoHeapEntry;
 
-static map<const void *, VuoHeapEntry> *referenceCounts;  ///< The reference count for each pointer.
-static set<const void *> *singletons;  ///< Known singleton pointers.
+/**
+ * log2 of the number of independently-locked portions of the reference-counting table.
+ */
+#define VuoHeap_shardCountLog2 6
+
+/**
+ * The number of independently-locked portions of the reference-counting table.
+ */
+#define VuoHeap_shardCount (1 << VuoHeap_shardCountLog2)
+
+/**
+ * A portion of the reference-counting table.
+ *
+ * Each heap pointer always maps to the same shard (see @ref VuoHeap_getShard),
+ * so retains/releases of unrelated pointers on different threads usually take different locks.
+ *
+ * Aligned to a cache line so that neighboring shards' mutexes don't falsely share.
+ */
+struct alignas(64) VuoHeapShard
+{
+	pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;  ///< Protects access to `referenceCounts`, `singletons`, and `unpooledValues`.
+	unordered_map<const void *, VuoHeapEntry> referenceCounts;  ///< The reference count for each pointer in this shard.
+	unordered_set<const void *> singletons;  ///< Known singleton pointers in this shard.
+	unordered_set<const void *> unpooledValues;  ///< Values in this shard allocated by @ref VuoHeap_allocRefCounted that were too large for the pool.  Their reference counts are in their headers.
+};
+
+static VuoHeapShard *referenceCounts;  ///< The reference-counting table, split into @ref VuoHeap_shardCount shards.
+
+/**
+ * Returns the shard of the reference-counting table that `heapPointer` belongs to.
+ */
+static inline VuoHeapShard *VuoHeap_getShard(const void *heapPointer)
+{
+	// Heap pointers are 16-byte aligned, so the low 4 bits carry no information.
+	// Fibonacci hashing spreads consecutive allocations across all shards.
+	uint64_t p = (uintptr_t)heapPointer >> 4;
+	return &referenceCounts[(p * 0x9e3779b97f4a7c15ULL) >> (64 - VuoHeap_shardCountLog2)];
+}
+
+/**
+ * Flags for @ref VuoHeapHeader.
+ */
+enum VuoHeapHeaderFlags
+{
+	VuoHeapHeader_Singleton = 1 << 0,  ///< The value was passed to @ref VuoRegisterSingleton; retain and release have no effect.
+	VuoHeapHeader_TypeFlagsShift = 16,  ///< The bits from here up hold the flags passed to @ref VuoHeap_setTypeFlags.
+};
+
+/**
+ * Bookkeeping stored immediately before each value allocated by @ref VuoHeap_allocRefCounted,
+ * so retaining and releasing it doesn't need to consult the reference-counting table.
+ */
+typedef struct
+{
+	uintptr_t check;  ///< The payload address XORed with @ref VuoHeap_headerCookie; distinguishes headed values from other pointers.
+	DeallocateFunctionType deallocateFunction;  ///< Releases anything the payload refers to.  May be NULL.
+	atomic<int> referenceCount;
+	atomic<unsigned int> flags;  ///< A combination of @ref VuoHeapHeaderFlags.
+	uintptr_t pool;  ///< For pooled values, the owning @ref VuoHeapThreadCache ORed with the size class.  0 for values from `posix_memalign`.
+} VuoHeapHeader;
+static_assert(sizeof(VuoHeapHeader) == 32, "VuoHeapHeader should be 32 bytes");
+
+static uintptr_t VuoHeap_headerCookie;  ///< A per-process random value, mixed into @ref VuoHeapHeader::check.
+
+#ifdef VUOHEAP_TRACE
+static atomic<long> VuoHeap_refCountedValuesLive;  ///< The number of headed values that haven't yet been deallocated.
+#endif
+
+/**
+ * Pooled blocks (header + payload) are multiples of this size, and are aligned to it.
+ */
+#define VuoHeapPool_blockAlignment 64
+
+/**
+ * The number of pooled block sizes: 64, 128, …, 1024 bytes (header included).
+ * Larger values are allocated with `posix_memalign`.
+ */
+#define VuoHeapPool_sizeClassCount 16
+
+/**
+ * log2 of @ref VuoHeapPool_slabSize.
+ */
+#define VuoHeapPool_slabSizeLog2 18
+
+/**
+ * The amount of memory each thread cache requests at once to carve into blocks.  Slabs are aligned to this size.
+ */
+#define VuoHeapPool_slabSize (1 << VuoHeapPool_slabSizeLog2)
+
+/**
+ * log2 of the number of slabs each leaf of @ref VuoHeapPool_slabMap covers.
+ */
+#define VuoHeapPool_slabMapLeafLog2 16
+
+/**
+ * The number of leaves in @ref VuoHeapPool_slabMap, enough to cover 48 bits of address space (see @ref VuoHeap_isPointerValid).
+ */
+#define VuoHeapPool_slabMapLeafCount (1 << (48 - VuoHeapPool_slabSizeLog2 - VuoHeapPool_slabMapLeafLog2))
+
+/**
+ * A two-level bitmap with one bit for each slab-sized, slab-aligned region of the address space,
+ * set if the region is a slab.  Leaves are allocated as needed, and (like slabs) are never freed.
+ *
+ * This lets @ref VuoHeapPool_getHeader determine whether a pointer could be a pooled value
+ * without reading any memory outside the pool.
+ */
+static atomic<atomic<uint64_t> *> VuoHeapPool_slabMap[VuoHeapPool_slabMapLeafCount];
+
+/**
+ * Records that `slab` (which must be aligned to @ref VuoHeapPool_slabSize) belongs to the pool.
+ */
+static void VuoHeapPool_addSlab(const void *slab)
+{
+	uintptr_t slabIndex = (uintptr_t)slab >> VuoHeapPool_slabSizeLog2;
+	atomic<atomic<uint64_t> *> &leafPointer = VuoHeapPool_slabMap[slabIndex >> VuoHeapPool_slabMapLeafLog2];
+
+	atomic<uint64_t> *leaf = leafPointer.load(memory_order_acquire);
+	if (!leaf)
+	{
+		atomic<uint64_t> *newLeaf = new atomic<uint64_t>[(1 << VuoHeapPool_slabMapLeafLog2) / 64]();
+		if (leafPointer.compare_exchange_strong(leaf, newLeaf, memory_order_acq_rel, memory_order_acquire))
+			leaf = newLeaf;
+		else
+			delete[] newLeaf;
+	}
+
+	uintptr_t bit = slabIndex & ((1 << VuoHeapPool_slabMapLeafLog2) - 1);
+	leaf[bit / 64].fetch_or(1ULL << (bit % 64), memory_order_release);
+}
+
+/**
+ * Returns true if `pointer` is within a slab.
+ *
+ * `pointer` must pass @ref VuoHeap_isPointerValid.
+ */
+static inline bool VuoHeapPool_isInSlab(const void *pointer)
+{
+	uintptr_t slabIndex = (uintptr_t)pointer >> VuoHeapPool_slabSizeLog2;
+	atomic<uint64_t> *leaf = VuoHeapPool_slabMap[slabIndex >> VuoHeapPool_slabMapLeafLog2].load(memory_order_acquire);
+	if (!leaf)
+		return false;
+
+	uintptr_t bit = slabIndex & ((1 << VuoHeapPool_slabMapLeafLog2) - 1);
+	return leaf[bit / 64].load(memory_order_acquire) & (1ULL << (bit % 64));
+}
+
+/**
+ * A pooled block that isn't currently allocated.  Stored in the block's payload, so its header's `check` stays 0.
+ */
+struct VuoHeapFreeBlock
+{
+	VuoHeapFreeBlock *next;
+};
+
+/**
+ * Free lists for blocks owned by one thread.
+ *
+ * The owning thread allocates and frees without synchronization.
+ * Other threads return blocks to `returnedBlocks`, which the owner reclaims all at once when its own free list runs dry.
+ *
+ * Caches outlive their threads: when a thread exits, its cache is orphaned, then adopted by the next thread that needs a cache,
+ * so blocks still in use elsewhere always have somewhere to go.
+ */
+struct alignas(VuoHeapPool_blockAlignment) VuoHeapThreadCache
+{
+	VuoHeapFreeBlock *freeBlocks[VuoHeapPool_sizeClassCount] = {};  ///< Blocks freed by the owning thread.
+	atomic<VuoHeapFreeBlock *> returnedBlocks[VuoHeapPool_sizeClassCount] = {};  ///< Blocks freed by other threads.
+
+	char *slabCursor = nullptr;  ///< The next uncarved byte in the current slab.
+	char *slabEnd = nullptr;  ///< The end of the current slab.
+
+	// Statistics, written only by the owning thread (approximate when read elsewhere).
+	uint64_t allocations = 0;  ///< The number of blocks handed out.
+	uint64_t reusedAllocations = 0;  ///< The number of blocks handed out from a free list (rather than carved from a slab).
+	uint64_t slabs = 0;  ///< The number of slabs requested.
+	atomic<uint64_t> crossThreadFrees = {0};  ///< The number of blocks returned by other threads.
+
+	VuoHeapThreadCache *nextOrphan = nullptr;  ///< The next cache in @ref VuoHeapPool_orphans.
+};
+
+static thread_local VuoHeapThreadCache *VuoHeapPool_cache;  ///< The current thread's cache.
+static pthread_key_t VuoHeapPool_cacheKey;  ///< Used to orphan a thread's cache when the thread exits.
+static pthread_mutex_t VuoHeapPool_mutex = PTHREAD_MUTEX_INITIALIZER;  ///< Protects access to `VuoHeapPool_orphans` and `VuoHeapPool_caches`.
+static VuoHeapThreadCache *VuoHeapPool_orphans;  ///< Caches whose threads have exited.
+static vector<VuoHeapThreadCache *> *VuoHeapPool_caches;  ///< All caches ever created, for statistics.
+
+/**
+ * Called when a thread exits.  Makes its cache available to another thread.
+ */
+static void VuoHeapPool_orphanCache(void *c)
+{
+	VuoHeapThreadCache *cache = (VuoHeapThreadCache *)c;
+	VuoHeapPool_cache = nullptr;
+
+	pthread_mutex_lock(&VuoHeapPool_mutex);
+	cache->nextOrphan = VuoHeapPool_orphans;
+	VuoHeapPool_orphans = cache;
+	pthread_mutex_unlock(&VuoHeapPool_mutex);
+}
+
+/**
+ * Returns the current thread's cache, adopting an orphaned cache or creating one if needed.
+ */
+static inline VuoHeapThreadCache *VuoHeapPool_getCache(void)
+{
+	VuoHeapThreadCache *cache = VuoHeapPool_cache;
+	if (cache)
+		return cache;
+
+	pthread_mutex_lock(&VuoHeapPool_mutex);
+	cache = VuoHeapPool_orphans;
+	if (cache)
+		VuoHeapPool_orphans = cache->nextOrphan;
+	else
+	{
+		cache = new VuoHeapThreadCache;
+		VuoHeapPool_caches->push_back(cache);
+	}
+	pthread_mutex_unlock(&VuoHeapPool_mutex);
+
+	cache->nextOrphan = nullptr;
+	VuoHeapPool_cache = cache;
+	pthread_setspecific(VuoHeapPool_cacheKey, cache);
+	return cache;
+}
+
+/**
+ * Returns an uninitialized block of `(sizeClass + 1) * VuoHeapPool_blockAlignment` bytes,
+ * or NULL if memory is exhausted.
+ */
+static VuoHeapHeader *VuoHeapPool_alloc(int sizeClass)
+{
+	VuoHeapThreadCache *cache = VuoHeapPool_getCache();
+	++cache->allocations;
+
+	VuoHeapFreeBlock *block = cache->freeBlocks[sizeClass];
+	if (!block)
+		block = cache->returnedBlocks[sizeClass].exchange(nullptr, memory_order_acquire);
+	if (block)
+	{
+		cache->freeBlocks[sizeClass] = block->next;
+		++cache->reusedAllocations;
+		return (VuoHeapHeader *)block - 1;
+	}
+
+	size_t blockSize = (sizeClass + 1) * VuoHeapPool_blockAlignment;
+	if (cache->slabCursor + blockSize > cache->slabEnd)
+	{
+		// Abandon the remainder of the current slab (less than one block).
+		void *slab;
+		if (posix_memalign(&slab, VuoHeapPool_slabSize, VuoHeapPool_slabSize))
+			return NULL;
+		VuoHeapPool_addSlab(slab);
+		cache->slabCursor = (char *)slab;
+		cache->slabEnd = cache->slabCursor + VuoHeapPool_slabSize;
+		++cache->slabs;
+	}
+
+	VuoHeapHeader *header = (VuoHeapHeader *)cache->slabCursor;
+	cache->slabCursor += blockSize;
+	return header;
+}
+
+/**
+ * Returns a block to the free list of the cache that allocated it.
+ */
+static void VuoHeapPool_free(VuoHeapHeader *header)
+{
+	VuoHeapThreadCache *owner = (VuoHeapThreadCache *)(header->pool & ~(uintptr_t)(VuoHeapPool_blockAlignment - 1));
+	int sizeClass = header->pool & (VuoHeapPool_blockAlignment - 1);
+	VuoHeapFreeBlock *block = (VuoHeapFreeBlock *)(header + 1);
+
+	if (owner == VuoHeapPool_cache)
+	{
+		block->next = owner->freeBlocks[sizeClass];
+		owner->freeBlocks[sizeClass] = block;
+	}
+	else
+	{
+		block->next = owner->returnedBlocks[sizeClass].load(memory_order_relaxed);
+		while (!owner->returnedBlocks[sizeClass].compare_exchange_weak(block->next, block, memory_order_release, memory_order_relaxed));
+		owner->crossThreadFrees.fetch_add(1, memory_order_relaxed);
+	}
+}
+
+/**
+ * If `heapPointer` was allocated by @ref VuoHeap_allocRefCounted from the pool, returns its header.  Otherwise returns NULL.
+ *
+ * Doesn't read any memory unless `heapPointer` is within a slab, so it's safe to call with any pointer
+ * that passes @ref VuoHeap_isPointerValid (including pointers to `malloc`ed, static, or stack memory).
+ */
+static inline VuoHeapHeader *VuoHeapPool_getHeader(const void *heapPointer)
+{
+	if (!VuoHeapPool_isInSlab(heapPointer))
+		return NULL;
+
+	// Each block starts at a multiple of VuoHeapPool_blockAlignment within its slab, and its payload follows the header,
+	// so any other offset can't be a pooled value's payload.  Since the header is then in the same slab, it's safe to read.
+	if (((uintptr_t)heapPointer & (VuoHeapPool_blockAlignment - 1)) != sizeof(VuoHeapHeader))
+		return NULL;
+
+	VuoHeapHeader *header = (VuoHeapHeader *)heapPointer - 1;
+	if (header->check != ((uintptr_t)heapPointer ^ VuoHeap_headerCookie))
+		return NULL;
+
+	return header;
+}
+
+/**
+ * If `heapPointer` was allocated by @ref VuoHeap_allocRefCounted, returns its header.  Otherwise returns NULL.
+ *
+ * `heapPointer` must pass @ref VuoHeap_isPointerValid.
+ * For values that aren't pooled, this takes the lock on `heapPointer`'s shard of the reference-counting table.
+ */
+static VuoHeapHeader *VuoHeap_getHeader(const void *heapPointer)
+{
+	if (VuoHeapHeader *header = VuoHeapPool_getHeader(heapPointer))
+		return header;
+
+	VuoHeapShard *shard = VuoHeap_getShard(heapPointer);
+	pthread_mutex_lock(&shard->mutex);
+	bool isUnpooled = shard->unpooledValues.find(heapPointer) != shard->unpooledValues.end();
+	pthread_mutex_unlock(&shard->mutex);
+
+	return isUnpooled ? (VuoHeapHeader *)heapPointer - 1 : NULL;
+}
+
+/**
+ * Logs statistics about pooled allocations (when debug logging is enabled).
+ */
+static void VuoHeapPool_report(void)
+{
+	if (!VuoIsDebugEnabled())
+		return;
+
+	uint64_t allocations = 0, reusedAllocations = 0, slabs = 0, crossThreadFrees = 0;
+	size_t cacheCount;
+	pthread_mutex_lock(&VuoHeapPool_mutex);
+	cacheCount = VuoHeapPool_caches->size();
+	for (VuoHeapThreadCache *cache : *VuoHeapPool_caches)
+	{
+		allocations += cache->allocations;
+		reusedAllocations += cache->reusedAllocations;
+		slabs += cache->slabs;
+		crossThreadFrees += cache->crossThreadFrees.load(memory_order_relaxed);
+	}
+	pthread_mutex_unlock(&VuoHeapPool_mutex);
+
+	VDebugLog("Pooled allocations: %llu (%.1f%% reused from free lists), %llu cross-thread frees, %llu slabs (%llu KB), %zu thread caches",
+			  allocations,
+			  allocations ? 100. * reusedAllocations / allocations : 0.,
+			  crossThreadFrees,
+			  slabs,
+			  slabs * VuoHeapPool_slabSize / 1024,
+			  cacheCount);
+}
+
+#ifdef VUOHEAP_TRACE
+/**
+ * Returns true if `heapPointer` has been passed to @ref VuoHeap_addTrace.
+ */
+static bool VuoHeap_isTraced(const void *heapPointer)
+{
+	pthread_mutex_lock(&VuoHeap_traceMutex);
+	bool traced = VuoHeap_trace->find(heapPointer) != VuoHeap_trace->end();
+	pthread_mutex_unlock(&VuoHeap_traceMutex);
+	return traced;
+}
+
+/**
+ * Logs an operation on a value allocated by @ref VuoHeap_allocRefCounted, if the value is being traced.
+ */
+static void VuoHeap_traceRefCounted(const char *operation, const void *heapPointer)
+{
+#ifdef VUOHEAP_TRACEALL
+	if (VuoHeap_isComposition())
+#else
+	if (VuoHeap_isTraced(heapPointer))
+#endif
+	{
+		fprintf(stderr, "table=%p  %s(%p)  (allocated by VuoHeap_allocRefCounted())\n", referenceCounts, operation, heapPointer);
+		VuoLog_backtrace();
+	}
+}
+#endif
 
 /**
  * Returns true if `pointer` looks like a valid pointer.
@@ -209,9 +595,11 @@ static char *VuoHeap_makeDescription(VuoHeapEntry e)
  */
 static void __attribute__((constructor(101))) VuoHeap_init()
 {
-	referenceCounts = new map<const void *, VuoHeapEntry>;
-	singletons = new set<const void *>;
+	referenceCounts = new VuoHeapShard[VuoHeap_shardCount];
 	VuoHeap_trace = new set<const void *>;
+	arc4random_buf(&VuoHeap_headerCookie, sizeof(VuoHeap_headerCookie));
+	VuoHeapPool_caches = new vector<VuoHeapThreadCache *>;
+	pthread_key_create(&VuoHeapPool_cacheKey, VuoHeapPool_orphanCache);
 
 #if 0
 	// Periodically dump the referenceCounts table, to help find leaks.
@@ -220,17 +608,21 @@ static void __attribute__((constructor(101))) VuoHeap_init()
 	dispatch_source_set_timer(timer, dispatch_walltime(NULL,0), NSEC_PER_SEC*dumpInterval, NSEC_PER_SEC*dumpInterval);
 	dispatch_source_set_event_handler(timer, ^{
 										  fprintf(stderr, "\n\n\n\n\nreferenceCounts:\n");
-										  pthread_mutex_lock(&VuoHeap_mutex);
-										  for (map<const void *, VuoHeapEntry>::iterator i = referenceCounts->begin(); i != referenceCounts->end(); ++i)
+										  for (int s = 0; s < VuoHeap_shardCount; ++s)
 										  {
-											  const void *heapPointer = i->first;
-											  char pointerSummary[17];
-											  VuoHeap_makeSafePointerSummary(pointerSummary, heapPointer);
-											  char *description = VuoHeap_makeDescription(i->second);
-											  fprintf(stderr, "\t% 3d refs to %p \"%s\", registered at %s\n", i->second.referenceCount, heapPointer, pointerSummary, description);
-											  free(description);
+											  VuoHeapShard *shard = &referenceCounts[s];
+											  pthread_mutex_lock(&shard->mutex);
+											  for (auto i = shard->referenceCounts.begin(); i != shard->referenceCounts.end(); ++i)
+											  {
+												  const void *heapPointer = i->first;
+												  char pointerSummary[17];
+												  VuoHeap_makeSafePointerSummary(pointerSummary, heapPointer);
+												  char *description = VuoHeap_makeDescription(i->second);
+												  fprintf(stderr, "\t% 3d refs to %p \"%s\", registered at %s\n", i->second.referenceCount, heapPointer, pointerSummary, description);
+												  free(description);
+											  }
+											  pthread_mutex_unlock(&shard->mutex);
 										  }
-										  pthread_mutex_unlock(&VuoHeap_mutex);
 									  });
 	dispatch_resume(timer);
 #endif
@@ -241,15 +633,23 @@ static void __attribute__((constructor(101))) VuoHeap_init()
  */
 void VuoHeap_report(void)
 {
-	pthread_mutex_lock(&VuoHeap_mutex);
+	ostringstream errorMessage;
+	bool foundLeaks = false;
 
-	if (! referenceCounts->empty())
+	for (int s = 0; s < VuoHeap_shardCount; ++s)
 	{
-		ostringstream errorMessage;
-		errorMessage << "On reference table " << referenceCounts
-					 << ", VuoRelease was not called enough times for:" << endl;
-		for (map<const void *, VuoHeapEntry>::iterator i = referenceCounts->begin(); i != referenceCounts->end(); ++i)
+		VuoHeapShard *shard = &referenceCounts[s];
+		pthread_mutex_lock(&shard->mutex);
+
+		for (auto i = shard->referenceCounts.begin(); i != shard->referenceCounts.end(); ++i)
 		{
+			if (!foundLeaks)
+			{
+				errorMessage << "On reference table " << referenceCounts
+							 << ", VuoRelease was not called enough times for:" << endl;
+				foundLeaks = true;
+			}
+
 			const void *heapPointer = i->first;
 			char pointerSummary[17];
 			VuoHeap_makeSafePointerSummary(pointerSummary, heapPointer);
@@ -257,10 +657,212 @@ void VuoHeap_report(void)
 			errorMessage << "\t" << setw(3) << i->second.referenceCount << " refs to " << heapPointer << " \"" << pointerSummary << "\", registered at " << description << endl;
 			free(description);
 		}
+
+		pthread_mutex_unlock(&shard->mutex);
+	}
+
+#ifdef VUOHEAP_TRACE
+	long refCountedValuesLive = VuoHeap_refCountedValuesLive;
+	if (refCountedValuesLive)
+	{
+		if (!foundLeaks)
+			errorMessage << "On reference table " << referenceCounts
+						 << ", VuoRelease was not called enough times for:" << endl;
+		errorMessage << "\t" << refCountedValuesLive << " values allocated by VuoHeap_allocRefCounted()" << endl;
+		foundLeaks = true;
+	}
+#endif
+
+	if (foundLeaks)
 		sendErrorWrapper(errorMessage.str().c_str());
+
+	VuoHeapPool_report();
+}
+
+/**
+ * @ingroup ReferenceCountingFunctions
+ * Allocates `size` bytes of zero-filled memory that is already registered for reference counting,
+ * with its reference count stored in a header in front of the returned pointer.
+ *
+ * Use this instead of `calloc` + @ref VuoRegister for frequently-allocated values:
+ * @ref VuoRetain and @ref VuoRelease recognize these values and update their reference counts
+ * with a single atomic operation, without taking a lock or looking up the reference-counting table.
+ *
+ * Unlike with @ref VuoRegister, `deallocate` should only release what the value refers to
+ * (it may be NULL if the value doesn't refer to anything);
+ * VuoHeap frees the value's own memory after calling it.
+ * The returned pointer must not be passed to `free` or `realloc`.
+ *
+ * Values up to about 1 KB come from per-thread pools of fixed-size blocks,
+ * which are recycled without returning to the system allocator,
+ * even when the value is released on a different thread than the one that allocated it.
+ *
+ * @version200New
+ */
+void *VuoHeap_allocRefCounted(size_t size, DeallocateFunctionType deallocate)
+{
+	size_t blockSize = sizeof(VuoHeapHeader) + size;
+	size_t sizeClass = (blockSize - 1) / VuoHeapPool_blockAlignment;
+	VuoHeapHeader *header;
+	if (sizeClass < VuoHeapPool_sizeClassCount)
+	{
+		header = VuoHeapPool_alloc(sizeClass);
+		if (!header)
+			return NULL;
+		bzero(header, blockSize);
+		header->pool = (uintptr_t)VuoHeapPool_cache | sizeClass;
+	}
+	else
+	{
+		if (posix_memalign((void **)&header, VuoHeapPool_blockAlignment, blockSize))
+			return NULL;
+		bzero(header, blockSize);
+	}
+
+	void *heapPointer = header + 1;
+	header->check = (uintptr_t)heapPointer ^ VuoHeap_headerCookie;
+	header->deallocateFunction = deallocate;
+
+	if (!header->pool)
+	{
+		VuoHeapShard *shard = VuoHeap_getShard(heapPointer);
+		pthread_mutex_lock(&shard->mutex);
+		shard->unpooledValues.insert(heapPointer);
+		pthread_mutex_unlock(&shard->mutex);
+	}
+
+#ifdef VUOHEAP_TRACE
+	++VuoHeap_refCountedValuesLive;
+#endif
+
+	return heapPointer;
+}
+
+/**
+ * Deallocates a value allocated by @ref VuoHeap_allocRefCounted.
+ */
+static void VuoHeap_freeRefCounted(VuoHeapHeader *header, const void *heapPointer)
+{
+#ifdef VUOHEAP_TRACE
+	VuoHeap_traceRefCounted("VuoDeallocate", heapPointer);
+#ifndef VUOHEAP_TRACEALL
+	pthread_mutex_lock(&VuoHeap_traceMutex);
+	VuoHeap_trace->erase(heapPointer);
+	pthread_mutex_unlock(&VuoHeap_traceMutex);
+#endif
+#endif
+
+	if (header->deallocateFunction)
+		header->deallocateFunction((void *)heapPointer);
+
+	// Ensure a stale header can't be mistaken for a live one if the memory is reused.
+	header->check = 0;
+	if (header->pool)
+		VuoHeapPool_free(header);
+	else
+	{
+		VuoHeapShard *shard = VuoHeap_getShard(heapPointer);
+		pthread_mutex_lock(&shard->mutex);
+		shard->unpooledValues.erase(heapPointer);
+		pthread_mutex_unlock(&shard->mutex);
+
+		free(header);
 	}
 
-	pthread_mutex_unlock(&VuoHeap_mutex);
+#ifdef VUOHEAP_TRACE
+	--VuoHeap_refCountedValuesLive;
+#endif
+}
+
+/**
+ * Increments the reference count of a value allocated by @ref VuoHeap_allocRefCounted.
+ */
+static int VuoHeap_retainRefCounted(VuoHeapHeader *header, const void *heapPointer)
+{
+#ifdef VUOHEAP_TRACE
+	VuoHeap_traceRefCounted("VuoRetain", heapPointer);
+#endif
+
+	if (header->flags & VuoHeapHeader_Singleton)
+		return -1;
+
+	return header->referenceCount.fetch_add(1, memory_order_relaxed) + 1;
+}
+
+/**
+ * Decrements the reference count of a value allocated by @ref VuoHeap_allocRefCounted, and deallocates it if the count becomes 0.
+ */
+static int VuoHeap_releaseRefCounted(VuoHeapHeader *header, const void *heapPointer)
+{
+#ifdef VUOHEAP_TRACE
+	VuoHeap_traceRefCounted("VuoRelease", heapPointer);
+#endif
+
+	if (header->flags & VuoHeapHeader_Singleton)
+		return -1;
+
+	int count = header->referenceCount.load(memory_order_relaxed);
+	do
+	{
+		if (count <= 0)
+		{
+			ostringstream errorMessage;
+			errorMessage << "On reference table " << referenceCounts
+						 << ", VuoRelease was called for unretained pointer " << heapPointer
+						 << " (allocated by VuoHeap_allocRefCounted())";
+			sendErrorWrapper(errorMessage.str().c_str());
+			return -1;
+		}
+	} while (!header->referenceCount.compare_exchange_weak(count, count - 1, memory_order_acq_rel, memory_order_relaxed));
+
+	if (count == 1)
+		VuoHeap_freeRefCounted(header, heapPointer);
+
+	return count - 1;
+}
+
+/**
+ * @ingroup ReferenceCountingFunctions
+ * Returns the flags most recently stored by @ref VuoHeap_setTypeFlags for `heapPointer`.
+ *
+ * Returns 0 if no flags have been stored, or if `heapPointer` wasn't allocated from VuoHeap's pool
+ * by @ref VuoHeap_allocRefCounted (so only values up to about 1 KB have room for flags).
+ *
+ * This doesn't take any locks.
+ *
+ * @version200New
+ */
+unsigned int VuoHeap_getTypeFlags(const void *heapPointer)
+{
+	if (!heapPointer || !VuoHeap_isPointerValid(heapPointer))
+		return 0;
+
+	VuoHeapHeader *header = VuoHeapPool_getHeader(heapPointer);
+	if (!header)
+		return 0;
+
+	return header->flags.load(memory_order_relaxed) >> VuoHeapHeader_TypeFlagsShift;
+}
+
+/**
+ * @ingroup ReferenceCountingFunctions
+ * Adds `typeFlags` (up to 16 bits) to the flags that @ref VuoHeap_getTypeFlags returns for `heapPointer`.
+ *
+ * Lets a type cache something it has computed about an immutable value, such as the encoding of a @ref VuoText.
+ * Has no effect if `heapPointer` wasn't allocated from VuoHeap's pool by @ref VuoHeap_allocRefCounted.
+ *
+ * @version200New
+ */
+void VuoHeap_setTypeFlags(const void *heapPointer, unsigned int typeFlags)
+{
+	if (!heapPointer || !VuoHeap_isPointerValid(heapPointer))
+		return;
+
+	VuoHeapHeader *header = VuoHeapPool_getHeader(heapPointer);
+	if (!header)
+		return;
+
+	header->flags.fetch_or(typeFlags << VuoHeapHeader_TypeFlagsShift, memory_order_relaxed);
 }
 
 /**
@@ -301,34 +903,40 @@ int VuoRegisterF(const void *heapPointer, DeallocateFunctionType deallocate, con
 	bool isAlreadyReferenceCounted;
 	int updatedCount;
 
-	pthread_mutex_lock(&VuoHeap_mutex);
+	VuoHeapHeader *header = VuoHeap_isPointerValid(heapPointer) ? VuoHeap_getHeader(heapPointer) : NULL;
+	if (header)
+	{
+		// Values from VuoHeap_allocRefCounted() are registered when they're allocated.
+		isAlreadyReferenceCounted = true;
+		updatedCount = header->referenceCount;
+	}
+	else
 	{
+		VuoHeapShard *shard = VuoHeap_getShard(heapPointer);
+		pthread_mutex_lock(&shard->mutex);
+		{
 #ifdef VUOHEAP_TRACE
 #ifdef VUOHEAP_TRACEALL
-		if (VuoHeap_isComposition())
+			if (VuoHeap_isComposition())
 #else
-		if (VuoHeap_trace->find(heapPointer) != VuoHeap_trace->end())
+			if (VuoHeap_isTraced(heapPointer))
 #endif
-		{
-			fprintf(stderr, "table=%p  VuoRegister(%p)  %s\n", referenceCounts, heapPointer, pointerName);
-			VuoLog_backtrace();
-		}
+			{
+				fprintf(stderr, "table=%p  VuoRegister(%p)  %s\n", referenceCounts, heapPointer, pointerName);
+				VuoLog_backtrace();
+			}
 #endif
 
-		isAlreadyReferenceCounted = referenceCounts->count(heapPointer);
-		if (! isAlreadyReferenceCounted)
-		{
-			updatedCount = 0;
-			(*referenceCounts)[heapPointer] = (VuoHeapEntry){updatedCount, deallocate, file, linenumber, func, pointerName,
+			auto inserted = shard->referenceCounts.emplace(heapPointer, (VuoHeapEntry){0, deallocate, file, linenumber, func, pointerName,
 #ifdef VUOHEAP_TRACE
 				VuoLog_getBacktrace(),
 #endif
-			};
+			});
+			isAlreadyReferenceCounted = !inserted.second;
+			updatedCount = inserted.first->second.referenceCount;
 		}
-		else
-			updatedCount = (*referenceCounts)[heapPointer].referenceCount;
+		pthread_mutex_unlock(&shard->mutex);
 	}
-	pthread_mutex_unlock(&VuoHeap_mutex);
 
 	if (isAlreadyReferenceCounted)
 	{
@@ -374,30 +982,39 @@ int VuoRegisterSingletonF(const void *heapPointer, const char *file, unsigned in
 
 	bool isAlreadyReferenceCounted;
 
-	pthread_mutex_lock(&VuoHeap_mutex);
+	VuoHeapHeader *header = VuoHeap_isPointerValid(heapPointer) ? VuoHeap_getHeader(heapPointer) : NULL;
+	if (header)
 	{
+		// Reclassify a value from VuoHeap_allocRefCounted() in place.
+		isAlreadyReferenceCounted = header->flags & VuoHeapHeader_Singleton;
+		header->flags |= VuoHeapHeader_Singleton;
+	}
+	else
+	{
+		VuoHeapShard *shard = VuoHeap_getShard(heapPointer);
+		pthread_mutex_lock(&shard->mutex);
+		{
 #ifdef VUOHEAP_TRACE
 #ifdef VUOHEAP_TRACEALL
-		if (VuoHeap_isComposition())
+			if (VuoHeap_isComposition())
 #else
-		if (VuoHeap_trace->find(heapPointer) != VuoHeap_trace->end())
+			if (VuoHeap_isTraced(heapPointer))
 #endif
-		{
-			fprintf(stderr, "table=%p  VuoRegisterSingleton(%p)  %s\n", referenceCounts, heapPointer, pointerName);
-			VuoLog_backtrace();
-		}
+			{
+				fprintf(stderr, "table=%p  VuoRegisterSingleton(%p)  %s\n", referenceCounts, heapPointer, pointerName);
+				VuoLog_backtrace();
+			}
 #endif
 
-		// Remove the singleton from the main reference-counting table, if it exists there.
-		// Enables reclassifying a pointer that was already VuoRegister()ed.
-		referenceCounts->erase(heapPointer);
+			// Remove the singleton from the main reference-counting table, if it exists there.
+			// Enables reclassifying a pointer that was already VuoRegister()ed.
+			shard->referenceCounts.erase(heapPointer);
 
-		// Add the singleton to the singleton table.
-		isAlreadyReferenceCounted = (singletons->find(heapPointer) != singletons->end());
-		if (! isAlreadyReferenceCounted)
-			singletons->insert(heapPointer);
+			// Add the singleton to the singleton table.
+			isAlreadyReferenceCounted = !shard->singletons.insert(heapPointer).second;
+		}
+		pthread_mutex_unlock(&shard->mutex);
 	}
-	pthread_mutex_unlock(&VuoHeap_mutex);
 
 	if (isAlreadyReferenceCounted)
 	{
@@ -452,32 +1069,41 @@ int VuoRetain(const void *heapPointer)
 					 << " \"" << pointerSummary << "\"";
 		sendErrorWrapper(errorMessage.str().c_str());
 	}
+	else if (VuoHeapHeader *header = VuoHeapPool_getHeader(heapPointer))
+		return VuoHeap_retainRefCounted(header, heapPointer);
 
 	int updatedCount = -1;
 	bool foundSingleton = false;
+	bool isUnpooled = false;
 
-	pthread_mutex_lock(&VuoHeap_mutex);
+	VuoHeapShard *shard = VuoHeap_getShard(heapPointer);
+	pthread_mutex_lock(&shard->mutex);
 	{
-		map<const void *, VuoHeapEntry>::iterator i = referenceCounts->find(heapPointer);
+		auto i = shard->referenceCounts.find(heapPointer);
 
 #ifdef VUOHEAP_TRACE
 #ifdef VUOHEAP_TRACEALL
 		if (VuoHeap_isComposition())
 #else
-		if (VuoHeap_trace->find(heapPointer) != VuoHeap_trace->end())
+		if (VuoHeap_isTraced(heapPointer))
 #endif
 		{
-			fprintf(stderr, "table=%p  VuoRetain(%p)  %s\n", referenceCounts, heapPointer, (i != referenceCounts->end()) ? i->second.variable : "");
+			fprintf(stderr, "table=%p  VuoRetain(%p)  %s\n", referenceCounts, heapPointer, (i != shard->referenceCounts.end()) ? i->second.variable : "");
 			VuoLog_backtrace();
 		}
 #endif
 
-		if (i != referenceCounts->end())
+		if (i != shard->referenceCounts.end())
 			updatedCount = ++(i->second.referenceCount);
+		else if (shard->unpooledValues.find(heapPointer) != shard->unpooledValues.end())
+			isUnpooled = true;
 		else
-			foundSingleton = singletons->find(heapPointer) != singletons->end();
+			foundSingleton = shard->singletons.find(heapPointer) != shard->singletons.end();
 	}
-	pthread_mutex_unlock(&VuoHeap_mutex);
+	pthread_mutex_unlock(&shard->mutex);
+
+	if (isUnpooled)
+		return VuoHeap_retainRefCounted((VuoHeapHeader *)heapPointer - 1, heapPointer);
 
 	if (updatedCount == -1 && !foundSingleton)
 	{
@@ -529,29 +1155,33 @@ int VuoRelease(const void *heapPointer)
 					 << " \"" << pointerSummary << "\"";
 		sendErrorWrapper(errorMessage.str().c_str());
 	}
+	else if (VuoHeapHeader *header = VuoHeapPool_getHeader(heapPointer))
+		return VuoHeap_releaseRefCounted(header, heapPointer);
 
 	int updatedCount = -1;
 	bool foundSingleton = false;
 	bool isRegisteredWithoutRetain = false;
+	bool isUnpooled = false;
 	DeallocateFunctionType deallocate = NULL;
 
-	pthread_mutex_lock(&VuoHeap_mutex);
+	VuoHeapShard *shard = VuoHeap_getShard(heapPointer);
+	pthread_mutex_lock(&shard->mutex);
 	{
-		map<const void *, VuoHeapEntry>::iterator i = referenceCounts->find(heapPointer);
+		auto i = shard->referenceCounts.find(heapPointer);
 
 #ifdef VUOHEAP_TRACE
 #ifdef VUOHEAP_TRACEALL
 		if (VuoHeap_isComposition())
 #else
-		if (VuoHeap_trace->find(heapPointer) != VuoHeap_trace->end())
+		if (VuoHeap_isTraced(heapPointer))
 #endif
 		{
-			fprintf(stderr, "table=%p  VuoRelease(%p)  %s\n", referenceCounts, heapPointer, (i != referenceCounts->end()) ? i->second.variable : "");
+			fprintf(stderr, "table=%p  VuoRelease(%p)  %s\n", referenceCounts, heapPointer, (i != shard->referenceCounts.end()) ? i->second.variable : "");
 			VuoLog_backtrace();
 		}
 #endif
 
-		if (i != referenceCounts->end())
+		if (i != shard->referenceCounts.end())
 		{
 			if (i->second.referenceCount == 0)
 			{
@@ -564,12 +1194,14 @@ int VuoRelease(const void *heapPointer)
 				if (updatedCount == 0)
 				{
 					deallocate = i->second.deallocateFunction;
-					referenceCounts->erase(heapPointer);
+					shard->referenceCounts.erase(i);
 				}
 			}
 		}
+		else if (shard->unpooledValues.find(heapPointer) != shard->unpooledValues.end())
+			isUnpooled = true;
 		else
-			foundSingleton = singletons->find(heapPointer) != singletons->end();
+			foundSingleton = shard->singletons.find(heapPointer) != shard->singletons.end();
 
 #ifdef VUOHEAP_TRACE
 		if (updatedCount == 0)
@@ -578,9 +1210,11 @@ int VuoRelease(const void *heapPointer)
 			if (VuoHeap_isComposition())
 			{
 #else
-			if (VuoHeap_trace->find(heapPointer) != VuoHeap_trace->end())
+			if (VuoHeap_isTraced(heapPointer))
 			{
+				pthread_mutex_lock(&VuoHeap_traceMutex);
 				VuoHeap_trace->erase(heapPointer);
+				pthread_mutex_unlock(&VuoHeap_traceMutex);
 #endif
 				fprintf(stderr, "table=%p  VuoDeallocate(%p)\n", referenceCounts, heapPointer);
 //				VuoLog_backtrace();
@@ -588,7 +1222,10 @@ int VuoRelease(const void *heapPointer)
 		}
 #endif
 	}
-	pthread_mutex_unlock(&VuoHeap_mutex);
+	pthread_mutex_unlock(&shard->mutex);
+
+	if (isUnpooled)
+		return VuoHeap_releaseRefCounted((VuoHeapHeader *)heapPointer - 1, heapPointer);
 
 	if (updatedCount == 0)
 		deallocate((void *)heapPointer);
@@ -619,13 +1256,17 @@ char *VuoHeap_getDescription(const void *heapPointer)
 {
 	char *description = nullptr;
 
-	pthread_mutex_lock(&VuoHeap_mutex);
+	if (VuoHeap_isPointerValid(heapPointer) && VuoHeap_getHeader(heapPointer))
+		return strdup("(allocated by VuoHeap_allocRefCounted())");
+
+	VuoHeapShard *shard = VuoHeap_getShard(heapPointer);
+	pthread_mutex_lock(&shard->mutex);
 
-	map<const void *, VuoHeapEntry>::iterator i = referenceCounts->find(heapPointer);
-	if (i != referenceCounts->end())
+	auto i = shard->referenceCounts.find(heapPointer);
+	if (i != shard->referenceCounts.end())
 		description = VuoHeap_makeDescription(i->second);
 
-	pthread_mutex_unlock(&VuoHeap_mutex);
+	pthread_mutex_unlock(&shard->mutex);
 
 	if (description)
 		return description;
@@ -640,9 +1281,9 @@ char *VuoHeap_getDescription(const void *heapPointer)
  */
 void VuoHeap_addTrace(const void *heapPointer)
 {
-	pthread_mutex_lock(&VuoHeap_mutex);
+	pthread_mutex_lock(&VuoHeap_traceMutex);
 
 	VuoHeap_trace->insert(heapPointer);
 
-	pthread_mutex_unlock(&VuoHeap_mutex);
+	pthread_mutex_unlock(&VuoHeap_traceMutex);
 }
@@ -62,6 +62,10 @@ int VuoRegisterF(const void *heapPointer, DeallocateFunctionType deallocate, con
 #define VuoRegisterSingleton(heapPointer) VuoRegisterSingletonF(heapPointer, __FILE__, __LINE__, __func__, #heapPointer)
 int VuoRegisterSingletonF(const void *heapPointer, const char *file, unsigned int linenumber, const char *func, const char *pointerName);
 
+void *VuoHeap_allocRefCounted(size_t size, DeallocateFunctionType deallocate);
+unsigned int VuoHeap_getTypeFlags(const void *heapPointer);
+void VuoHeap_setTypeFlags(const void *heapPointer, unsigned int typeFlags);
+
 int VuoRetain(const void *heapPointer);
 
 int VuoRelease(const void *heapPointer);
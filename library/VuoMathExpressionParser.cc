@@ -8,6 +8,7 @@
  */
 
 #include <muParser/muParser.h>
+#include <list>
 #include <set>
 using namespace std;
 
@@ -21,6 +22,7 @@ VuoModuleMetadata({
 					  "title" : "VuoMathExpressionParser",
 					  "dependencies" : [
 						"VuoInteger",
+						"VuoPoint3d",
 						"VuoReal",
 						"VuoText",
 						"VuoList_VuoInteger",
@@ -663,9 +665,11 @@ VuoDictionary_VuoText_VuoReal VuoMathExpressionParser_calculate(VuoMathExpressio
 	double *results = mi->muParser.Eval(outputCount);
 
 	VuoList_VuoText keys = VuoListCreateWithCount_VuoText(outputCount, NULL);
+	VuoLocal(keys);
 	VuoText *keysArray = VuoListGetData_VuoText(keys);
 
 	VuoList_VuoReal values = VuoListCreateWithCount_VuoReal(outputCount, 0);
+	VuoLocal(values);
 	VuoReal *valuesArray = VuoListGetData_VuoReal(values);
 
 	for (int i = 0; i < outputCount; ++i)
@@ -747,3 +751,233 @@ VuoList_VuoReal VuoMathExpressionParser_calculateList(VuoMathExpressionParser m,
 
 	return results;
 }
+
+
+/**
+ * C++ implementation of opaque C type VuoMathExpressionParametric.
+ *
+ * The X, Y, and Z expressions are each parsed into a muParser bytecode program when the instance is created.
+ * `time` and the user-defined constants are bound as variables rather than muParser constants,
+ * so their values can change from one event to the next without the expressions being parsed again.
+ */
+class VuoMathExpressionParametricInternal
+{
+public:
+	string key;  ///< Identifies the expressions, dimensions, and constant names this instance was parsed with.
+	mu::Parser muParsers[3];  ///< Evaluate the X, Y, and Z expressions.
+	double u;  ///< Storage for the `u` variable.
+	double v;  ///< Storage for the `v` variable.
+	double i;  ///< Storage for the `i` variable.
+	double j;  ///< Storage for the `j` variable.
+	double time;  ///< Storage for the `time` variable.
+	vector<double> constantValues;  ///< Storage for the user-defined constants, in the order their names were given.
+
+	/**
+	 * Parses the X, Y, and Z expressions in @a expressions.
+	 *
+	 * @throw mu::ParserError One of the expressions contains a syntax error or uses an undefined variable.
+	 */
+	VuoMathExpressionParametricInternal(const string &key, const string expressions[3], int dimensionCount, const vector<string> &constantNames) :
+		key(key),
+		constantValues(constantNames.size(), 0)
+	{
+		u = v = i = j = time = 0;
+
+		for (int k = 0; k < 3; ++k)
+			defineAndParse(muParsers[k], expressions[k], dimensionCount, constantNames);
+	}
+
+private:
+	/**
+	 * Binds @a muParser's variables to this instance's storage, then parses @a expression.
+	 */
+	void defineAndParse(mu::Parser &muParser, const string &expression, int dimensionCount, const vector<string> &constantNames)
+	{
+		VuoMathExpressionParser_defineStandardLibrary(&muParser);
+
+		// As when they were muParser constants, user-defined constants take precedence over the built-in variables.
+		set<string> constantNameSet(constantNames.begin(), constantNames.end());
+		auto defineVariable = [&muParser, &constantNameSet](const char *name, double *value)
+		{
+			if (constantNameSet.find(name) == constantNameSet.end())
+				muParser.DefineVar(name, value);
+		};
+
+		defineVariable("u", &u); defineVariable("U", &u);
+		defineVariable("i", &i); defineVariable("I", &i);
+		if (dimensionCount > 1)
+		{
+			defineVariable("v", &v); defineVariable("V", &v);
+			defineVariable("j", &j); defineVariable("J", &j);
+		}
+		defineVariable("time", &time); defineVariable("Time", &time); defineVariable("TIME", &time);
+
+		for (size_t k = 0; k < constantNames.size(); ++k)
+		{
+			try
+			{
+				muParser.DefineVar(constantNames[k], &constantValues[k]);
+			}
+			catch (mu::ParserError &e)
+			{
+				// The name is invalid or conflicts with one of the standard library's constants, so it can't be used in the expressions.
+			}
+		}
+
+		muParser.SetExpr(expression);
+		muParser.Eval();  // Parses the expression, so errors are caught here rather than while generating.
+	}
+};
+
+static const size_t VuoMathExpressionParametric_idleMaxCount = 64;  ///< Maximum number of parsed instances to keep around for reuse (enough for one per thread when generating in parallel).
+static list<VuoMathExpressionParametricInternal *> *VuoMathExpressionParametric_idle;  ///< Parsed instances not currently in use, most recently used first.
+static dispatch_semaphore_t VuoMathExpressionParametric_idleSemaphore;  ///< Serializes access to @ref VuoMathExpressionParametric_idle.
+
+/**
+ * Initializes the pool of parsed instances.
+ */
+static void VuoMathExpressionParametric_init(void)
+{
+	static dispatch_once_t once = 0;
+	dispatch_once(&once, ^{
+		VuoMathExpressionParametric_idle = new list<VuoMathExpressionParametricInternal *>;
+		VuoMathExpressionParametric_idleSemaphore = dispatch_semaphore_create(1);
+	});
+}
+
+/**
+ * Returns an instance that evaluates @a xExpression, @a yExpression, and @a zExpression
+ * in terms of `u`, `i` (and, if @a dimensionCount is 2, `v` and `j`), `time`, and the names in @a constants.
+ *
+ * If an instance for the same expressions and constant names was recently relinquished with
+ * @ref VuoMathExpressionParametric_disuse, it's reused rather than parsing the expressions again.
+ * Otherwise, a new instance is created.
+ *
+ * The caller has exclusive use of the returned instance until it calls @ref VuoMathExpressionParametric_disuse,
+ * and should call @ref VuoMathExpressionParametric_setConstants before evaluating it.
+ *
+ * If parsing fails, returns null and sets @a error.
+ *
+ * @threadAny
+ */
+VuoMathExpressionParametric VuoMathExpressionParametric_use(VuoText xExpression, VuoText yExpression, VuoText zExpression,
+															 int dimensionCount, VuoDictionary_VuoText_VuoReal *constants,
+															 VuoMathExpressionError *error)
+{
+	VuoMathExpressionParametric_init();
+
+	string expressions[3] = {
+		xExpression ? xExpression : "",
+		yExpression ? yExpression : "",
+		zExpression ? zExpression : "",
+	};
+
+	vector<string> constantNames;
+	if (constants)
+	{
+		unsigned long constantCount = VuoListGetCount_VuoText(constants->keys);
+		VuoText *constantKeys = VuoListGetData_VuoText(constants->keys);
+		for (unsigned long k = 0; k < constantCount; ++k)
+			constantNames.push_back(constantKeys[k] ? constantKeys[k] : "");
+	}
+
+	string key = to_string(dimensionCount);
+	for (const string &expression : expressions)
+		key += "\n" + to_string(expression.length()) + ":" + expression;
+	for (const string &name : constantNames)
+		key += "\n" + name;
+
+	VuoMathExpressionParametricInternal *p = nullptr;
+	dispatch_semaphore_wait(VuoMathExpressionParametric_idleSemaphore, DISPATCH_TIME_FOREVER);
+	for (auto i = VuoMathExpressionParametric_idle->begin(); i != VuoMathExpressionParametric_idle->end(); ++i)
+		if ((*i)->key == key)
+		{
+			p = *i;
+			VuoMathExpressionParametric_idle->erase(i);
+			break;
+		}
+	dispatch_semaphore_signal(VuoMathExpressionParametric_idleSemaphore);
+
+	if (p)
+		return p;
+
+	try
+	{
+		return new VuoMathExpressionParametricInternal(key, expressions, dimensionCount, constantNames);
+	}
+	catch (mu::ParserError &e)
+	{
+		*error = new VuoMathExpressionErrorInternal(e);
+		return nullptr;
+	}
+}
+
+/**
+ * Indicates that the caller is done using @a p, so it can be reused by a later call to @ref VuoMathExpressionParametric_use.
+ *
+ * @threadAny
+ */
+void VuoMathExpressionParametric_disuse(VuoMathExpressionParametric p)
+{
+	if (! p)
+		return;
+
+	VuoMathExpressionParametricInternal *evicted = nullptr;
+
+	dispatch_semaphore_wait(VuoMathExpressionParametric_idleSemaphore, DISPATCH_TIME_FOREVER);
+	VuoMathExpressionParametric_idle->push_front(static_cast<VuoMathExpressionParametricInternal *>(p));
+	if (VuoMathExpressionParametric_idle->size() > VuoMathExpressionParametric_idleMaxCount)
+	{
+		evicted = VuoMathExpressionParametric_idle->back();
+		VuoMathExpressionParametric_idle->pop_back();
+	}
+	dispatch_semaphore_signal(VuoMathExpressionParametric_idleSemaphore);
+
+	delete evicted;
+}
+
+/**
+ * Sets the values of `time` and the user-defined constants for subsequent calls to @ref VuoMathExpressionParametric_evaluate.
+ *
+ * @a constants should have the same names, in the same order, as were passed to @ref VuoMathExpressionParametric_use.
+ */
+void VuoMathExpressionParametric_setConstants(VuoMathExpressionParametric p, VuoReal time, VuoDictionary_VuoText_VuoReal *constants)
+{
+	VuoMathExpressionParametricInternal *pi = static_cast<VuoMathExpressionParametricInternal *>(p);
+
+	pi->time = time;
+
+	if (constants)
+	{
+		unsigned long constantCount = MIN(VuoListGetCount_VuoReal(constants->values), pi->constantValues.size());
+		VuoReal *constantValues = VuoListGetData_VuoReal(constants->values);
+		for (unsigned long k = 0; k < constantCount; ++k)
+			pi->constantValues[k] = constantValues[k];
+	}
+}
+
+/**
+ * Evaluates the X, Y, and Z expressions at the given parameters, and outputs the results in @a position.
+ *
+ * If evaluation fails, logs the error and returns false.
+ */
+bool VuoMathExpressionParametric_evaluate(VuoMathExpressionParametric p, VuoReal u, VuoReal v, VuoInteger i, VuoInteger j, VuoPoint3d *position)
+{
+	VuoMathExpressionParametricInternal *pi = static_cast<VuoMathExpressionParametricInternal *>(p);
+
+	pi->u = u;
+	pi->v = v;
+	pi->i = i;
+	pi->j = j;
+
+	try
+	{
+		*position = (VuoPoint3d){ (float)pi->muParsers[0].Eval(), (float)pi->muParsers[1].Eval(), (float)pi->muParsers[2].Eval() };
+		return true;
+	}
+	catch (mu::ParserError &e)
+	{
+		VUserLog("Error: %s", e.GetMsg().c_str());
+		return false;
+	}
+}
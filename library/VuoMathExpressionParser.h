@@ -15,6 +15,7 @@ extern "C"
 #endif
 
 #include "VuoInteger.h"
+#include "VuoPoint3d.h"
 #include "VuoReal.h"
 #include "VuoText.h"
 #include "VuoList_VuoInteger.h"
@@ -24,6 +25,7 @@ extern "C"
 
 typedef void * VuoMathExpressionParser;  ///< Parses and performs calculations with mathematical expressions.
 typedef void * VuoMathExpressionError;  ///< Error caused by invalid expression given to VuoMathExpressionParser.
+typedef void * VuoMathExpressionParametric;  ///< Evaluates a set of X, Y, Z expressions at many points on a parametric curve or surface.
 
 void VuoMathExpressionParser_defineStandardLibrary(void *muparser);
 
@@ -36,6 +38,13 @@ VuoList_VuoText VuoMathExpressionParser_getOutputVariables(VuoMathExpressionPars
 VuoDictionary_VuoText_VuoReal VuoMathExpressionParser_calculate(VuoMathExpressionParser m, VuoDictionary_VuoText_VuoReal inputValues);
 VuoList_VuoReal VuoMathExpressionParser_calculateList(VuoMathExpressionParser m, VuoList_VuoReal xValues, VuoDictionary_VuoText_VuoReal constants);
 
+VuoMathExpressionParametric VuoMathExpressionParametric_use(VuoText xExpression, VuoText yExpression, VuoText zExpression,
+															 int dimensionCount, VuoDictionary_VuoText_VuoReal *constants,
+															 VuoMathExpressionError *error);
+void VuoMathExpressionParametric_disuse(VuoMathExpressionParametric p);
+void VuoMathExpressionParametric_setConstants(VuoMathExpressionParametric p, VuoReal time, VuoDictionary_VuoText_VuoReal *constants);
+bool VuoMathExpressionParametric_evaluate(VuoMathExpressionParametric p, VuoReal u, VuoReal v, VuoInteger i, VuoInteger j, VuoPoint3d *position);
+
 const char * VuoMathExpressionError_getMessage(VuoMathExpressionError error);
 VuoList_VuoInteger VuoMathExpressionError_getExpressionIndices(VuoMathExpressionError error);
 void VuoMathExpressionError_free(VuoMathExpressionError error);
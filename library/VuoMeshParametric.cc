@@ -8,9 +8,11 @@
  */
 
 #include "VuoMeshParametric.h"
-#include <muParser/muParser.h>
 #include "VuoMathExpressionParser.h"
 #include "VuoMeshUtility.h"
+#include <unistd.h>
+#include <vector>
+using namespace std;
 
 extern "C"
 {
@@ -18,7 +20,6 @@ extern "C"
 VuoModuleMetadata({
 					 "title" : "VuoMeshParametric",
 					 "dependencies" : [
-						 "muparser",
 						 "VuoMathExpressionParser",
 						 "VuoMeshUtility"
 					 ]
@@ -27,100 +28,106 @@ VuoModuleMetadata({
 }
 
 /**
- * Adds a normal to a running sum.
+ * Minimum number of vertices per thread.
+ * Below this, distributing the work among threads costs more than it saves.
  */
-static inline void add(float *normals, int index, VuoPoint3d normal)
+static const int VuoMeshParametric_minVerticesPerChunk = 4096;
+
+/**
+ * Divides `rowCount` rows into `chunkCount` contiguous ranges, and calls `block` for each range —
+ * concurrently, if there's more than one.
+ */
+static void VuoMeshParametric_applyToRows(int rowCount, int chunkCount, void (^block)(int chunk, int firstRow, int endRow))
 {
-	normals[index * 3    ] += normal.x;
-	normals[index * 3 + 1] += normal.y;
-	normals[index * 3 + 2] += normal.z;
+	if (chunkCount <= 1)
+	{
+		block(0, 0, rowCount);
+		return;
+	}
+
+	dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk){
+		block(chunk, rowCount * chunk / chunkCount, rowCount * (chunk + 1) / chunkCount);
+	});
 }
 
 /**
  * Generates a mesh given a set of mathematical expressions specifying a warped surface.
+ *
+ * Large meshes are generated by multiple threads, each evaluating a range of rows.
  */
 VuoMesh VuoMeshParametric_generate(VuoReal time, VuoText xExp, VuoText yExp, VuoText zExp, VuoInteger uSubdivisions, VuoInteger vSubdivisions, bool closeU, VuoReal uMin, VuoReal uMax, bool closeV, VuoReal vMin, VuoReal vMax, VuoDictionary_VuoText_VuoReal *constants)
 {
 	if (uSubdivisions < 2 || vSubdivisions < 2 || VuoText_isEmpty(xExp) || VuoText_isEmpty(yExp) || VuoText_isEmpty(zExp))
 		return nullptr;
 
-	mu::Parser xParser, yParser, zParser;
-
-	xParser.SetExpr(xExp);
-	yParser.SetExpr(yExp);
-	zParser.SetExpr(zExp);
-
-	mu::value_type uVar = 0;
-	mu::value_type vVar = 0;
-
-	xParser.DefineVar("u", &uVar); xParser.DefineVar("U", &uVar);
-	yParser.DefineVar("u", &uVar); yParser.DefineVar("U", &uVar);
-	zParser.DefineVar("u", &uVar); zParser.DefineVar("U", &uVar);
-	xParser.DefineVar("v", &vVar); xParser.DefineVar("V", &vVar);
-	yParser.DefineVar("v", &vVar); yParser.DefineVar("V", &vVar);
-	zParser.DefineVar("v", &vVar); zParser.DefineVar("V", &vVar);
-
-	mu::value_type iVar = 0;
-	mu::value_type jVar = 0;
-
-	xParser.DefineVar("i", &iVar); xParser.DefineVar("I", &iVar);
-	yParser.DefineVar("i", &iVar); yParser.DefineVar("I", &iVar);
-	zParser.DefineVar("i", &iVar); zParser.DefineVar("I", &iVar);
-	xParser.DefineVar("j", &jVar); xParser.DefineVar("J", &jVar);
-	yParser.DefineVar("j", &jVar); yParser.DefineVar("J", &jVar);
-	zParser.DefineVar("j", &jVar); zParser.DefineVar("J", &jVar);
-
-	xParser.DefineConst("time", (double)time); xParser.DefineConst("Time", (double)time); xParser.DefineConst("TIME", (double)time);
-	yParser.DefineConst("time", (double)time); yParser.DefineConst("Time", (double)time); yParser.DefineConst("TIME", (double)time);
-	zParser.DefineConst("time", (double)time); zParser.DefineConst("Time", (double)time); zParser.DefineConst("TIME", (double)time);
+	int width = uSubdivisions;
+	int height = vSubdivisions;
+	int vertexCount = width * height;
 
-	VuoMathExpressionParser_defineStandardLibrary(&xParser);
-	VuoMathExpressionParser_defineStandardLibrary(&yParser);
-	VuoMathExpressionParser_defineStandardLibrary(&zParser);
+	int chunkCount = MAX(1, MIN(MIN(vertexCount / VuoMeshParametric_minVerticesPerChunk, (int)sysconf(_SC_NPROCESSORS_ONLN)), height - 1));
 
-	if (constants)
+	// Each thread needs its own evaluator, since evaluating modifies the evaluator's variables.
+	vector<VuoMathExpressionParametric> parametrics(chunkCount, nullptr);
+	auto disuseParametrics = [&parametrics]() {
+		for (VuoMathExpressionParametric parametric : parametrics)
+			VuoMathExpressionParametric_disuse(parametric);
+	};
+	for (int chunk = 0; chunk < chunkCount; ++chunk)
 	{
-		unsigned long constantCount = VuoListGetCount_VuoText(constants->keys);
-		VuoText *constantKeys = VuoListGetData_VuoText(constants->keys);
-		VuoReal *constantValues = VuoListGetData_VuoReal(constants->values);
-		for (unsigned long i = 0; i < constantCount; ++i)
+		VuoMathExpressionError error = nullptr;
+		parametrics[chunk] = VuoMathExpressionParametric_use(xExp, yExp, zExp, 2, constants, &error);
+		if (!parametrics[chunk])
 		{
-			xParser.DefineConst(constantKeys[i], constantValues[i]);
-			yParser.DefineConst(constantKeys[i], constantValues[i]);
-			zParser.DefineConst(constantKeys[i], constantValues[i]);
+			VUserLog("Error: %s", VuoMathExpressionError_getMessage(error));
+			VuoMathExpressionError_free(error);
+			disuseParametrics();
+			return nullptr;
 		}
+		VuoMathExpressionParametric_setConstants(parametrics[chunk], time, constants);
 	}
 
-	int width = uSubdivisions;
-	int height = vSubdivisions;
-
 	float ustep = 1./(width-1.), vstep = 1./(height-1.);
 
-	int vertexCount = width * height;
+	// Accumulate the texture coordinates' `v` serially, so they come out the same regardless of how the rows are divided among threads.
+	vector<float> vs(height);
+	float v = 0.;
+	for (int y = 0; y < height; y++)
+	{
+		vs[y] = v;
+		v += vstep;
+	}
 
 	unsigned int elementCount = ((uSubdivisions-1)*(vSubdivisions-1))*3*2;
 	float *positions, *normals, *textureCoordinates;
 	unsigned int *elements;
 	VuoMesh_allocateCPUBuffers(vertexCount, &positions, &normals, &textureCoordinates, nullptr, elementCount, &elements);
-	bzero(normals, sizeof(float) * 3 * vertexCount);
 
-	try
-	{
-		int i = 0;
-		float u = 0., v = 0.;
-		for(int y = 0; y < height; y++)
+	__block bool succeeded = true;
+	const float *vsData = vs.data();
+	VuoMathExpressionParametric *parametricsData = parametrics.data();
+	VuoMeshParametric_applyToRows(height, chunkCount, ^(int chunk, int firstRow, int endRow){
+		VuoMathExpressionParametric parametric = parametricsData[chunk];
+		for (int y = firstRow; y < endRow; y++)
 		{
-			vVar = VuoReal_lerp(vMin, vMax, (closeV && y==height-1) ? 0 : v);
-			for(int x = 0; x < width; x++)
+			float v = vsData[y];
+			VuoReal vVar = VuoReal_lerp(vMin, vMax, (closeV && y==height-1) ? 0 : v);
+
+			int i = y * width;
+			float u = 0.;
+			for (int x = 0; x < width; x++)
 			{
-				uVar = VuoReal_lerp(uMin, uMax, (closeU && x==width-1) ? 0 : u);
+				VuoReal uVar = VuoReal_lerp(uMin, uMax, (closeU && x==width-1) ? 0 : u);
 
-				iVar = x + 1;
-				jVar = y + 1;
+				VuoPoint3d position;
+				if (!VuoMathExpressionParametric_evaluate(parametric, uVar, vVar, x + 1, y + 1, &position))
+				{
+					succeeded = false;
+					return;
+				}
 
-				positions[i * 3    ] = xParser.Eval();
-				positions[i * 3 + 1] = yParser.Eval();
-				positions[i * 3 + 2] = zParser.Eval();
+				positions[i * 3    ] = position.x;
+				positions[i * 3 + 1] = position.y;
+				positions[i * 3 + 2] = position.z;
 
 				textureCoordinates[i * 2    ] = u;
 				textureCoordinates[i * 2 + 1] = v;
@@ -128,121 +135,117 @@ VuoMesh VuoMeshParametric_generate(VuoReal time, VuoText xExp, VuoText yExp, Vuo
 				u += ustep;
 				i++;
 			}
-
-			u = 0.;
-			v += vstep;
 		}
-	}
-	catch (mu::Parser::exception_type &e)
+	});
+
+	disuseParametrics();
+
+	if (!succeeded)
 	{
-		VUserLog("Error: %s", e.GetMsg().c_str());
 		free(positions);
 		free(normals);
 		free(textureCoordinates);
+		free(elements);
 		return nullptr;
 	}
 
-	// wind triangles
-
-	width = uSubdivisions-1;
-	height = vSubdivisions-1;
-
-	// Prepare an array to count how many neighboring face normals have been added to the vertex normal, so we can divide later to get the average.
-	unsigned int* normalCount = (unsigned int*)calloc(sizeof(unsigned int) * vertexCount, sizeof(unsigned int));
+	// Calculate each face's normal, and wind its triangles.
 
-	int index = 0;
-	int one, two, three, four;
-	int row = 0;
-	index = 0;
+	int faceWidth = width - 1;
+	int faceHeight = height - 1;
+	VuoPoint3d *faceNormals = (VuoPoint3d *)malloc(sizeof(VuoPoint3d) * faceWidth * faceHeight);
 
-	int stride = width+1;
-
-	for(int y=0;y<height;++y)
-	{
-		for(int x=0;x<width;++x)
+	VuoMeshParametric_applyToRows(faceHeight, chunkCount, ^(int chunk, int firstRow, int endRow){
+		for (int y = firstRow; y < endRow; ++y)
 		{
-			one = x + row;
-			two = x+row+1;
-			three = x+row+stride;
-			four = x+row+stride+1;
-
-			// calculate face normal, add to normals, augment normalCount for subsequent averaging
-			VuoPoint3d faceNormal = VuoMeshUtility_faceNormal(
-				VuoPoint3d_makeFromArray(&positions[one   * 3]),
-				VuoPoint3d_makeFromArray(&positions[two   * 3]),
-				VuoPoint3d_makeFromArray(&positions[three * 3]));
-
-			add(normals, one, faceNormal);
-			add(normals, two, faceNormal);
-			add(normals, three, faceNormal);
-			add(normals, four, faceNormal);
-
-			normalCount[one]++;
-			normalCount[two]++;
-			normalCount[three]++;
-			normalCount[four]++;
-
-			if(closeU && x == width-1)
+			for (int x = 0; x < faceWidth; ++x)
 			{
-				// Add the first face in row normal to right-most vertices
-				VuoPoint3d uNrm = VuoMeshUtility_faceNormal(
-					VuoPoint3d_makeFromArray(&positions[row            * 3]),
-					VuoPoint3d_makeFromArray(&positions[(row + 1)      * 3]),
-					VuoPoint3d_makeFromArray(&positions[(row + stride) * 3]));
-
-				add(normals, two,          uNrm);
-				add(normals, four,         uNrm);
-				// And add the current face normal to the origin row vertex normals
-				add(normals, row,          faceNormal);
-				add(normals, row + stride, faceNormal);
-
-				normalCount[two]++;
-				normalCount[four]++;
-				normalCount[row]++;
-				normalCount[row+stride]++;
+				int one   = y * width + x;
+				int two   = one + 1;
+				int three = one + width;
+				int four  = three + 1;
+
+				faceNormals[y * faceWidth + x] = VuoMeshUtility_faceNormal(
+					VuoPoint3d_makeFromArray(&positions[one   * 3]),
+					VuoPoint3d_makeFromArray(&positions[two   * 3]),
+					VuoPoint3d_makeFromArray(&positions[three * 3]));
+
+				// Elements are wound to be front-facing for Vuo's right-handed coordinate system.
+				// Order the elements so that the diagonal edge of each triangle
+				// is last, so that vuo.shader.make.wireframe can optionally omit them.
+				unsigned int *faceElements = &elements[(y * faceWidth + x) * 6];
+				faceElements[0] = three;
+				faceElements[1] = one;
+				faceElements[2] = two;
+				faceElements[3] = two;
+				faceElements[4] = four;
+				faceElements[5] = three;
 			}
+		}
+	});
 
-			if(closeV && y==height-1)
+	// Average the normals of the faces surrounding each vertex.
+	// Each vertex gathers its faces' normals in a fixed order (rather than each face scattering its normal to its vertices),
+	// so threads never write to the same vertex, and the sums come out the same regardless of how the rows are divided among threads.
+
+	VuoMeshParametric_applyToRows(height, chunkCount, ^(int chunk, int firstRow, int endRow){
+		for (int y = firstRow; y < endRow; ++y)
+		{
+			for (int x = 0; x < width; ++x)
 			{
-				VuoPoint3d vNrm = VuoMeshUtility_faceNormal(
-					VuoPoint3d_makeFromArray(&positions[x            * 3]),
-					VuoPoint3d_makeFromArray(&positions[(x + 1)      * 3]),
-					VuoPoint3d_makeFromArray(&positions[(x + stride) * 3]));
-
-				add(normals, three, vNrm);
-				add(normals, four,  vNrm);
-				add(normals, x,     faceNormal);
-				add(normals, x + 1, faceNormal);
-
-				normalCount[three]++;
-				normalCount[four]++;
-				normalCount[x]++;
-				normalCount[x+1]++;
+				VuoPoint3d sum = (VuoPoint3d){0,0,0};
+				int count = 0;
+
+				for (int faceY = y - 1; faceY <= y; ++faceY)
+				{
+					if (faceY < 0 || faceY >= faceHeight)
+						continue;
+
+					for (int faceX = x - 1; faceX <= x; ++faceX)
+					{
+						if (faceX < 0 || faceX >= faceWidth)
+							continue;
+
+						sum += faceNormals[faceY * faceWidth + faceX];
+						++count;
+					}
+
+					// Where the surface is closed in U, the first and last columns of vertices coincide,
+					// so each also gets the normals of the faces adjacent to the other.
+					if (closeU && x == faceWidth)
+					{
+						sum += faceNormals[faceY * faceWidth];
+						++count;
+					}
+					if (closeU && x == 0)
+					{
+						sum += faceNormals[faceY * faceWidth + faceWidth - 1];
+						++count;
+					}
+				}
+
+				// Likewise for the first and last rows of vertices, where the surface is closed in V.
+				if (closeV && (y == faceHeight || y == 0))
+				{
+					int faceY = (y == 0) ? faceHeight - 1 : 0;
+					for (int faceX = x - 1; faceX <= x; ++faceX)
+					{
+						if (faceX < 0 || faceX >= faceWidth)
+							continue;
+
+						sum += faceNormals[faceY * faceWidth + faceX];
+						++count;
+					}
+				}
+
+				normals[(y * width + x) * 3    ] = sum.x / count;
+				normals[(y * width + x) * 3 + 1] = sum.y / count;
+				normals[(y * width + x) * 3 + 2] = sum.z / count;
 			}
-
-			// Elements are wound to be front-facing for Vuo's right-handed coordinate system.
-			// Order the elements so that the diagonal edge of each triangle
-			// is last, so that vuo.shader.make.wireframe can optionally omit them.
-			elements[index    ] = three;
-			elements[index + 1] = one;
-			elements[index + 2] = two;
-			elements[index + 3] = two;
-			elements[index + 4] = four;
-			elements[index + 5] = three;
-
-			index += 6;
 		}
-		row += stride;
-	}
+	});
 
-	// average normals
-	for(int i = 0; i < vertexCount; i++)
-	{
-		normals[i * 3    ] /= normalCount[i];
-		normals[i * 3 + 1] /= normalCount[i];
-		normals[i * 3 + 2] /= normalCount[i];
-	}
-	free(normalCount);
+	free(faceNormals);
 
 	return VuoMesh_makeFromCPUBuffers(vertexCount,
 		positions, normals, textureCoordinates, nullptr,
@@ -9,7 +9,9 @@
 
 #include "VuoPointsParametric.h"
 #include "VuoMathExpressionParser.h"
-#include <muParser/muParser.h>
+#include <unistd.h>
+#include <vector>
+using namespace std;
 
 extern "C"
 {
@@ -22,13 +24,18 @@ VuoModuleMetadata({
 						 "VuoReal",
 						 "VuoText",
 						 "VuoList_VuoPoint3d",
-						 "VuoMathExpressionParser",
-						 "muparser"
+						 "VuoMathExpressionParser"
 					 ]
 				 });
 #endif
 }
 
+/**
+ * Minimum number of points per thread.
+ * Below this, distributing the work among threads costs more than it saves.
+ */
+static const int VuoPointsParametric_minPointsPerChunk = 4096;
+
 /**
  * Generates a mesh given a set of mathematical expressions specifying a warped surface.
  */
@@ -44,56 +51,32 @@ VuoList_VuoPoint3d VuoPointsParametric1d_generate(
 	if (subdivisions <= 0 || VuoText_isEmpty(xExp) || VuoText_isEmpty(yExp) || VuoText_isEmpty(zExp))
 		return VuoListCreate_VuoPoint3d();
 
-	mu::Parser xParser, yParser, zParser;
-
-	xParser.SetExpr(xExp);
-	yParser.SetExpr(yExp);
-	zParser.SetExpr(zExp);
-
-	mu::value_type uVar = 0;
-
-	xParser.DefineVar("u", &uVar); xParser.DefineVar("U", &uVar);
-	yParser.DefineVar("u", &uVar); yParser.DefineVar("U", &uVar);
-	zParser.DefineVar("u", &uVar); zParser.DefineVar("U", &uVar);
-
-	mu::value_type iVar = 0;
-
-	xParser.DefineVar("i", &iVar); xParser.DefineVar("I", &iVar);
-	yParser.DefineVar("i", &iVar); yParser.DefineVar("I", &iVar);
-	zParser.DefineVar("i", &iVar); zParser.DefineVar("I", &iVar);
-
-	xParser.DefineConst("time", (double)time); xParser.DefineConst("Time", (double)time); xParser.DefineConst("TIME", (double)time);
-	yParser.DefineConst("time", (double)time); yParser.DefineConst("Time", (double)time); yParser.DefineConst("TIME", (double)time);
-	zParser.DefineConst("time", (double)time); zParser.DefineConst("Time", (double)time); zParser.DefineConst("TIME", (double)time);
-
-	VuoMathExpressionParser_defineStandardLibrary(&xParser);
-	VuoMathExpressionParser_defineStandardLibrary(&yParser);
-	VuoMathExpressionParser_defineStandardLibrary(&zParser);
-
 	VuoList_VuoPoint3d points = VuoListCreateWithCount_VuoPoint3d(subdivisions, (VuoPoint3d){0,0,0});
 	VuoPoint3d *pointsArray = VuoListGetData_VuoPoint3d(points);
 
-	try
+	VuoMathExpressionError error = NULL;
+	VuoMathExpressionParametric parametric = VuoMathExpressionParametric_use(xExp, yExp, zExp, 1, NULL, &error);
+	if (!parametric)
 	{
-		for(int x = 0; x < subdivisions; x++)
-		{
-			if (subdivisions > 1)
-				uVar = VuoReal_lerp(uMin, uMax, x/(float)(subdivisions-1.));
-			else
-				uVar = (uMin + uMax)/2.;
-
-			iVar = x + 1;
-
-			pointsArray[x] = (VuoPoint3d){
-				(float)xParser.Eval(),
-				(float)yParser.Eval(),
-				(float)zParser.Eval()};
-		}
+		VUserLog("Error: %s", VuoMathExpressionError_getMessage(error));
+		VuoMathExpressionError_free(error);
+		return points;
 	}
-	catch (mu::Parser::exception_type &e)
+	VuoMathExpressionParametric_setConstants(parametric, time, NULL);
+
+	for(int x = 0; x < subdivisions; x++)
 	{
-		VUserLog("Error: %s", e.GetMsg().c_str());
+		VuoReal uVar;
+		if (subdivisions > 1)
+			uVar = VuoReal_lerp(uMin, uMax, x/(float)(subdivisions-1.));
+		else
+			uVar = (uMin + uMax)/2.;
+
+		if (!VuoMathExpressionParametric_evaluate(parametric, uVar, 0, x + 1, 0, &pointsArray[x]))
+			break;
 	}
+
+	VuoMathExpressionParametric_disuse(parametric);
 	return points;
 }
 
@@ -115,47 +98,34 @@ VuoList_VuoPoint3d VuoPointsParametric2d_generate(
 	if (rows <= 0 || columns <= 0 || VuoText_isEmpty(xExp) || VuoText_isEmpty(yExp) || VuoText_isEmpty(zExp))
 		return VuoListCreate_VuoPoint3d();
 
-	mu::Parser xParser, yParser, zParser;
-
-	xParser.SetExpr(xExp);
-	yParser.SetExpr(yExp);
-	zParser.SetExpr(zExp);
-
-	mu::value_type uVar = 0;
-	mu::value_type vVar = 0;
-
-	xParser.DefineVar("u", &uVar); xParser.DefineVar("U", &uVar);
-	yParser.DefineVar("u", &uVar); yParser.DefineVar("U", &uVar);
-	zParser.DefineVar("u", &uVar); zParser.DefineVar("U", &uVar);
-	xParser.DefineVar("v", &vVar); xParser.DefineVar("V", &vVar);
-	yParser.DefineVar("v", &vVar); yParser.DefineVar("V", &vVar);
-	zParser.DefineVar("v", &vVar); zParser.DefineVar("V", &vVar);
-
-	mu::value_type iVar = 0;
-	mu::value_type jVar = 0;
-
-	xParser.DefineVar("i", &iVar); xParser.DefineVar("I", &iVar);
-	yParser.DefineVar("i", &iVar); yParser.DefineVar("I", &iVar);
-	zParser.DefineVar("i", &iVar); zParser.DefineVar("I", &iVar);
-	xParser.DefineVar("j", &jVar); xParser.DefineVar("J", &jVar);
-	yParser.DefineVar("j", &jVar); yParser.DefineVar("J", &jVar);
-	zParser.DefineVar("j", &jVar); zParser.DefineVar("J", &jVar);
-
-	xParser.DefineConst("time", (double)time); xParser.DefineConst("Time", (double)time); xParser.DefineConst("TIME", (double)time);
-	yParser.DefineConst("time", (double)time); yParser.DefineConst("Time", (double)time); yParser.DefineConst("TIME", (double)time);
-	zParser.DefineConst("time", (double)time); zParser.DefineConst("Time", (double)time); zParser.DefineConst("TIME", (double)time);
-
-	VuoMathExpressionParser_defineStandardLibrary(&xParser);
-	VuoMathExpressionParser_defineStandardLibrary(&yParser);
-	VuoMathExpressionParser_defineStandardLibrary(&zParser);
-
 	VuoList_VuoPoint3d points = VuoListCreateWithCount_VuoPoint3d(rows*columns, (VuoPoint3d){0,0,0});
 	VuoPoint3d *pointsArray = VuoListGetData_VuoPoint3d(points);
 
-	try
+	int chunkCount = MAX(1, MIN(MIN(rows * columns / VuoPointsParametric_minPointsPerChunk, (int)sysconf(_SC_NPROCESSORS_ONLN)), rows));
+
+	// Each thread needs its own evaluator, since evaluating modifies the evaluator's variables.
+	vector<VuoMathExpressionParametric> parametrics(chunkCount, NULL);
+	for (int chunk = 0; chunk < chunkCount; ++chunk)
 	{
-		for(int y = 0; y < rows; y++)
+		VuoMathExpressionError error = NULL;
+		parametrics[chunk] = VuoMathExpressionParametric_use(xExp, yExp, zExp, 2, NULL, &error);
+		if (!parametrics[chunk])
 		{
+			VUserLog("Error: %s", VuoMathExpressionError_getMessage(error));
+			VuoMathExpressionError_free(error);
+			for (VuoMathExpressionParametric parametric : parametrics)
+				VuoMathExpressionParametric_disuse(parametric);
+			return points;
+		}
+		VuoMathExpressionParametric_setConstants(parametrics[chunk], time, NULL);
+	}
+
+	// Divide the rows into contiguous ranges, and evaluate the ranges concurrently.
+	VuoMathExpressionParametric *parametricsData = parametrics.data();
+	void (^generateRows)(size_t) = ^(size_t chunk){
+		for(int y = rows * chunk / chunkCount; y < rows * (chunk + 1) / chunkCount; y++)
+		{
+			VuoReal vVar;
 			if (rows > 1)
 				vVar = VuoReal_lerp(vMin, vMax, y/(float)(rows-1));
 			else
@@ -163,24 +133,23 @@ VuoList_VuoPoint3d VuoPointsParametric2d_generate(
 
 			for(int x = 0; x < columns; x++)
 			{
+				VuoReal uVar;
 				if (columns > 1)
 					uVar = VuoReal_lerp(uMin, uMax, x/(float)(columns-1.));
 				else
 					uVar = (uMin + uMax)/2.;
 
-				iVar = x + 1;
-				jVar = y + 1;
-
-				pointsArray[y*columns + x] = (VuoPoint3d){
-					(float)xParser.Eval(),
-					(float)yParser.Eval(),
-					(float)zParser.Eval()};
+				if (!VuoMathExpressionParametric_evaluate(parametricsData[chunk], uVar, vVar, x + 1, y + 1, &pointsArray[y*columns + x]))
+					return;
 			}
 		}
-	}
-	catch (mu::Parser::exception_type &e)
-	{
-		VUserLog("Error: %s", e.GetMsg().c_str());
-	}
+	};
+	if (chunkCount > 1)
+		dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), generateRows);
+	else
+		generateRows(0);
+
+	for (VuoMathExpressionParametric parametric : parametrics)
+		VuoMathExpressionParametric_disuse(parametric);
 	return points;
 }
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <map>
 #include <dispatch/dispatch.h>
@@ -21,6 +23,10 @@
  * (that is, when the `useSharedInstance` and `disuseSharedInstance` calls are balanced).
  *
  * It's safe for multiple threads to simultaneously call any public methods on the same pool.
+ *
+ * The pool's contents are kept in an immutable snapshot, so looking up an existing shared object
+ * doesn't wait for other threads; only allocating, and removing the last use of, a shared object
+ * copies the snapshot and publishes the copy.
  */
 template<typename KeyType, typename InstanceType>
 class VuoKeyedPool
@@ -36,11 +42,20 @@ public:
 	unsigned int size(void);
 
 private:
+	/// A shared object, along with the number of callers currently using it.
+	struct Entry
+	{
+		InstanceType instance;	///< The shared object.  The pool holds a reference to it for as long as it's in the pool.
+		std::atomic<int> users;	///< The number of `useSharedInstance` calls not yet balanced by `disuseSharedInstance`.  Only goes from 0 to 1 on @ref queue.
+	};
+
 	std::string instanceTypeString;	///< The name of the data type this pool holds (for debugging).
 	AllocateFunctionType allocate;	///< To be called when a new shared instance is needed.
-	dispatch_queue_t queue;			///< Protects access to a pool instance's ivars.
-	typedef std::map<KeyType,InstanceType> PoolType;
-	PoolType pool;
+	dispatch_queue_t queue;			///< Serializes changes to @ref pool (but not lookups).
+	typedef std::map<KeyType, std::shared_ptr<Entry> > PoolType;
+	std::shared_ptr<const PoolType> pool;	///< The most recently published snapshot.  Only accessed with `std::atomic_load()` and `std::atomic_store()`.
+
+	static bool useIfInUse(Entry *entry);
 };
 
 /**
@@ -67,6 +82,23 @@ VuoKeyedPool<KeyType,InstanceType>::VuoKeyedPool(std::string instanceTypeString,
 	this->instanceTypeString = instanceTypeString;
 	this->allocate = allocate;
 	this->queue = dispatch_queue_create(instanceTypeString.c_str(), NULL);
+	this->pool = std::make_shared<const PoolType>();
+}
+
+/**
+ * If `entry` has at least one user, adds another one and returns true.
+ * Otherwise `entry` is about to be removed from the pool, so this returns false.
+ *
+ * @threadAny
+ */
+template<typename KeyType, typename InstanceType>
+bool VuoKeyedPool<KeyType,InstanceType>::useIfInUse(Entry *entry)
+{
+	int users = entry->users.load();
+	while (users > 0)
+		if (entry->users.compare_exchange_weak(users, users + 1))
+			return true;
+	return false;
 }
 
 /**
@@ -83,15 +115,38 @@ template<typename KeyType, typename InstanceType>
 InstanceType VuoKeyedPool<KeyType,InstanceType>::useSharedInstance(KeyType key)
 {
 //	VLog("%s key=%d",instanceTypeString.c_str(),key);
+	{
+		std::shared_ptr<const PoolType> p = std::atomic_load(&pool);
+		typename PoolType::const_iterator it = p->find(key);
+		if (it != p->end() && useIfInUse(it->second.get()))
+		{
+			VuoRetain(it->second->instance);
+			return it->second->instance;
+		}
+	}
+
 	__block InstanceType instance;
 	dispatch_sync(queue, ^{
-		typename PoolType::iterator it = pool.find(key);
-		if (it != pool.end())
-			instance = it->second;
+		std::shared_ptr<const PoolType> p = std::atomic_load(&pool);
+		typename PoolType::const_iterator it = p->find(key);
+		if (it != p->end())
+		{
+			// Even if the last user just disused it, the entry stays in the pool until it's removed on this queue, so it can be revived.
+			++it->second->users;
+			instance = it->second->instance;
+		}
 		else
 		{
-			instance = allocate(key);
-			pool[key] = instance;
+			std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+			entry->instance = allocate(key);
+			entry->users = 1;
+			VuoRetain(entry->instance);
+
+			PoolType *newPool = new PoolType(*p);
+			(*newPool)[key] = entry;
+			std::atomic_store(&pool, std::shared_ptr<const PoolType>(newPool));
+
+			instance = entry->instance;
 		}
 
 		VuoRetain(instance);
@@ -111,18 +166,34 @@ void VuoKeyedPool<KeyType,InstanceType>::disuseSharedInstance(InstanceType insta
 		return;
 
 //	VLog("%s key=%d",instanceTypeString.c_str(),key);
-	dispatch_sync(queue, ^{
-		for (auto it = pool.begin(); it != pool.end(); ++it)
-			if (it->second == instance)
-			{
-				int referenceCount = VuoRelease(it->second);
-				if (referenceCount == 0)
-				{
-					pool.erase(it);
-					break;
-				}
-			}
-	});
+	std::shared_ptr<const PoolType> p = std::atomic_load(&pool);
+	for (typename PoolType::const_iterator it = p->begin(); it != p->end(); ++it)
+		if (it->second->instance == instance)
+		{
+			KeyType key = it->first;
+			std::shared_ptr<Entry> entry = it->second;
+			p.reset();
+
+			// The pool still holds a reference, so this never deallocates the instance.
+			VuoRelease(instance);
+
+			if (--entry->users == 0)
+				dispatch_sync(queue, ^{
+					// Skip if another caller revived the entry, or if an earlier call already removed it.
+					std::shared_ptr<const PoolType> current = std::atomic_load(&pool);
+					typename PoolType::const_iterator currentIt = current->find(key);
+					if (entry->users > 0 || currentIt == current->end() || currentIt->second != entry)
+						return;
+
+					PoolType *newPool = new PoolType(*current);
+					newPool->erase(key);
+					std::atomic_store(&pool, std::shared_ptr<const PoolType>(newPool));
+
+					VuoRelease(instance);
+				});
+
+			return;
+		}
 }
 
 /**
@@ -133,10 +204,9 @@ void VuoKeyedPool<KeyType,InstanceType>::disuseSharedInstance(InstanceType insta
 template<typename KeyType, typename InstanceType>
 void VuoKeyedPool<KeyType,InstanceType>::visit(void (^b)(KeyType,InstanceType))
 {
-	dispatch_sync(queue, ^{
-		for (typename PoolType::iterator i = pool.begin(); i != pool.end(); ++i)
-			b(i->first, i->second);
-	});
+	std::shared_ptr<const PoolType> p = std::atomic_load(&pool);
+	for (typename PoolType::const_iterator i = p->begin(); i != p->end(); ++i)
+		b(i->first, i->second->instance);
 }
 
 /**
@@ -147,9 +217,5 @@ void VuoKeyedPool<KeyType,InstanceType>::visit(void (^b)(KeyType,InstanceType))
 template<typename KeyType, typename InstanceType>
 unsigned int VuoKeyedPool<KeyType,InstanceType>::size(void)
 {
-	__block unsigned int c;
-	dispatch_sync(queue, ^{
-		c = pool.size();
-	});
-	return c;
+	return std::atomic_load(&pool)->size();
 }
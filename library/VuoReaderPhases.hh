@@ -0,0 +1,129 @@
+/**
+ * @file
+ * VuoReaderPhases interface and implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the MIT License.
+ * For more information, see https://vuo.org/license.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+/**
+ * Lets a writer that has just published a new version of some shared data wait until no reader can still be
+ * using a version it replaced, so the writer can free the replaced versions.
+ *
+ * Each reader counts itself in one of the writer-provided @ref Counts while it runs, in whichever of the two
+ * phases was current when it started. @ref waitForReaders flips the phase twice, each time waiting for the
+ * readers that started in the previous phase, so that a reader that loaded the phase just before a flip
+ * is still waited for. Readers that start during the wait use the other phase, so continual reading
+ * can't hold up the writer indefinitely.
+ *
+ * Readers must count themselves before loading the shared data, and writers must publish the new version
+ * before calling @ref waitForReaders.
+ */
+class VuoReaderPhases
+{
+public:
+	/**
+	 * The number of readers that started in each phase and haven't yet finished.
+	 *
+	 * Padded to the size of a cache line, so readers using different elements of an array of counts don't contend.
+	 */
+	struct Counts
+	{
+		std::atomic<unsigned int> count[2];  ///< Indexed by phase.
+		char padding[64 - 2 * sizeof(std::atomic<unsigned int>)];  ///< Unused.
+
+		/**
+		 * Creates counts of zero.
+		 */
+		Counts(void)
+		{
+			count[0] = 0;
+			count[1] = 0;
+		}
+	};
+
+	/**
+	 * Starts in phase 0.
+	 */
+	VuoReaderPhases(void)
+	{
+		phase = 0;
+	}
+
+	/**
+	 * Counts a reader as in progress in @a counts, which may be shared by several threads.
+	 * Returns the phase to pass to @ref endReading().
+	 *
+	 * @threadAny
+	 */
+	unsigned int beginReading(Counts &counts)
+	{
+		unsigned int p = phase.load(std::memory_order_relaxed) & 1;
+		counts.count[p].fetch_add(1);
+		return p;
+	}
+
+	/**
+	 * Counts a reader that started with @ref beginReading() as finished.
+	 *
+	 * @threadAny
+	 */
+	void endReading(Counts &counts, unsigned int p)
+	{
+		counts.count[p].fetch_sub(1, std::memory_order_release);
+	}
+
+	/**
+	 * Counts a reader as in progress in @a counts, which only the current thread updates.
+	 * Returns the phase to pass to @ref endReadingOnThread().
+	 *
+	 * Since no other thread changes @a counts, this stores the new count instead of atomically incrementing it,
+	 * and only needs a fence to keep the store from being reordered after the reader loads the shared data.
+	 *
+	 * @threadAny
+	 */
+	unsigned int beginReadingOnThread(Counts &counts)
+	{
+		unsigned int p = phase.load(std::memory_order_relaxed) & 1;
+		counts.count[p].store(counts.count[p].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return p;
+	}
+
+	/**
+	 * Counts a reader that started with @ref beginReadingOnThread() as finished.
+	 *
+	 * @threadAny
+	 */
+	void endReadingOnThread(Counts &counts, unsigned int p)
+	{
+		counts.count[p].store(counts.count[p].load(std::memory_order_relaxed) - 1, std::memory_order_release);
+	}
+
+	/**
+	 * Waits until no reader counted in any of @a countsCount elements of @a counts can still be using
+	 * a version of the shared data that was replaced before this function was called.
+	 *
+	 * Calls to this function must be serialized.
+	 */
+	void waitForReaders(const Counts *counts, size_t countsCount)
+	{
+		for (int i = 0; i < 2; ++i)
+		{
+			unsigned int previousPhase = phase.fetch_add(1) & 1;
+			for (size_t j = 0; j < countsCount; ++j)
+				while (counts[j].count[previousPhase].load() > 0)
+					std::this_thread::yield();
+		}
+	}
+
+private:
+	std::atomic<unsigned int> phase;  ///< Its low bit selects which element of @ref Counts::count new readers increment.
+};
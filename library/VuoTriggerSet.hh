@@ -9,13 +9,26 @@
 
 #pragma once
 
-#include <set>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 #include <dispatch/dispatch.h>
 
+#include "VuoReaderPhases.hh"
+
 /**
  * Manages a set of callbacks for nodes' trigger ports.
  *
  * It's safe for multiple threads to call @ref addTrigger(), @ref removeTrigger(), @ref size(), and @ref fire() on the same set.
+ *
+ * The triggers are kept in an immutable snapshot. @ref fire() just takes a reference to the current snapshot,
+ * so it doesn't wait for other threads that are firing or changing the set. @ref addTrigger() and @ref removeTrigger()
+ * copy the snapshot, change the copy, and publish it in place of the original.
+ *
+ * Each call to @ref fire() counts itself in @ref firingCounts while it runs, and @ref removeTrigger() waits
+ * for every call that might have loaded an earlier snapshot (not just the one it replaced) to finish,
+ * so once @ref removeTrigger() returns, the removed trigger won't be called again.
  */
 template<typename TriggerDataType, typename TriggerContextType = void *>
 class VuoTriggerSet
@@ -36,9 +49,19 @@ public:
 	void fire(void (^)(TriggerFunctionType trigger, TriggerContextType context));
 
 private:
-	dispatch_queue_t queue;	///< Serializes access to the following trigger method.
-	std::set<TriggerFunctionType> triggers;
-	std::set< std::pair<TriggerFunctionType, TriggerContextType> > triggersWithContext;
+	/// The triggers in the set at one point in time.  Never modified once published.
+	struct Triggers
+	{
+		std::vector<TriggerFunctionType> triggers;  ///< The contextless triggers.
+		std::vector< std::pair<TriggerFunctionType, TriggerContextType> > triggersWithContext;  ///< The context-having triggers.
+	};
+
+	dispatch_queue_t queue;	///< Serializes changes to the set (but not firing).
+	std::shared_ptr<const Triggers> current;  ///< The most recently published snapshot.  Only accessed with `std::atomic_load()` and `std::atomic_exchange()`.
+	VuoReaderPhases firingPhases;  ///< Lets @ref removeTrigger() wait for calls to @ref fire() in progress.
+	VuoReaderPhases::Counts firingCounts;  ///< The calls to @ref fire() in progress.
+
+	void publish(Triggers *triggers);
 };
 
 /**
@@ -48,6 +71,7 @@ template<typename TriggerDataType, typename TriggerContextType>
 VuoTriggerSet<TriggerDataType, TriggerContextType>::VuoTriggerSet()
 {
 	this->queue = dispatch_queue_create("VuoTriggerSet", NULL);
+	this->current = std::make_shared<const Triggers>();
 }
 
 /**
@@ -61,6 +85,17 @@ VuoTriggerSet<TriggerDataType, TriggerContextType>::~VuoTriggerSet()
 #endif
 }
 
+/**
+ * Replaces the current snapshot with `triggers`, taking ownership of it.
+ *
+ * Must be called on @ref queue.
+ */
+template<typename TriggerDataType, typename TriggerContextType>
+void VuoTriggerSet<TriggerDataType, TriggerContextType>::publish(Triggers *triggers)
+{
+	std::atomic_exchange(&current, std::shared_ptr<const Triggers>(triggers));
+}
+
 /**
  * Adds a trigger method to the trigger set.
  *
@@ -70,7 +105,13 @@ template<typename TriggerDataType, typename TriggerContextType>
 void VuoTriggerSet<TriggerDataType, TriggerContextType>::addTrigger(TriggerFunctionType trigger)
 {
 	dispatch_sync(queue, ^{
-		triggers.insert(trigger);
+		std::shared_ptr<const Triggers> previous = std::atomic_load(&current);
+		if (std::find(previous->triggers.begin(), previous->triggers.end(), trigger) != previous->triggers.end())
+			return;
+
+		Triggers *triggers = new Triggers(*previous);
+		triggers->triggers.push_back(trigger);
+		publish(triggers);
 	});
 }
 
@@ -83,26 +124,49 @@ template<typename TriggerDataType, typename TriggerContextType>
 void VuoTriggerSet<TriggerDataType, TriggerContextType>::addTrigger(TriggerFunctionType trigger, TriggerContextType context)
 {
 	dispatch_sync(queue, ^{
-		triggersWithContext.insert(std::make_pair(trigger, context));
+		std::shared_ptr<const Triggers> previous = std::atomic_load(&current);
+		std::pair<TriggerFunctionType, TriggerContextType> triggerWithContext = std::make_pair(trigger, context);
+		if (std::find(previous->triggersWithContext.begin(), previous->triggersWithContext.end(), triggerWithContext) != previous->triggersWithContext.end())
+			return;
+
+		Triggers *triggers = new Triggers(*previous);
+		triggers->triggersWithContext.push_back(triggerWithContext);
+		publish(triggers);
 	});
 }
 
 /**
  * Removes a trigger method from the trigger set.
  *
+ * If another thread is currently firing the trigger, this waits for it to finish.
+ * This must not be called from within one of this set's trigger methods.
+ *
  * @threadAny
  */
 template<typename TriggerDataType, typename TriggerContextType>
 void VuoTriggerSet<TriggerDataType, TriggerContextType>::removeTrigger(TriggerFunctionType trigger)
 {
 	dispatch_sync(queue, ^{
-		triggers.erase(trigger);
-
-		for (typename std::set< std::pair<TriggerFunctionType, TriggerContextType> >::iterator it = triggersWithContext.begin(); it != triggersWithContext.end(); )
-			if (it->first == trigger)
-				triggersWithContext.erase(it++);
-			else
-				++it;
+		std::shared_ptr<const Triggers> previous = std::atomic_load(&current);
+
+		Triggers *triggers = new Triggers(*previous);
+		triggers->triggers.erase(std::remove(triggers->triggers.begin(), triggers->triggers.end(), trigger), triggers->triggers.end());
+		triggers->triggersWithContext.erase(std::remove_if(triggers->triggersWithContext.begin(), triggers->triggersWithContext.end(),
+														   [=](const std::pair<TriggerFunctionType, TriggerContextType> &t){ return t.first == trigger; }),
+											triggers->triggersWithContext.end());
+
+		if (triggers->triggers.size() == previous->triggers.size()
+		 && triggers->triggersWithContext.size() == previous->triggersWithContext.size())
+		{
+			delete triggers;
+			return;
+		}
+
+		publish(triggers);
+
+		// Wait for every call to fire() that might be using an earlier snapshot (not just the one replaced here),
+		// since a call may have loaded a snapshot before others were published while it was running.
+		firingPhases.waitForReaders(&firingCounts, 1);
 	});
 }
 
@@ -114,11 +178,8 @@ void VuoTriggerSet<TriggerDataType, TriggerContextType>::removeTrigger(TriggerFu
 template<typename TriggerDataType, typename TriggerContextType>
 unsigned int VuoTriggerSet<TriggerDataType, TriggerContextType>::size(void)
 {
-	__block unsigned int size;
-	dispatch_sync(queue, ^{
-		size = triggers.size() + triggersWithContext.size();
-	});
-	return size;
+	std::shared_ptr<const Triggers> triggers = std::atomic_load(&current);
+	return triggers->triggers.size() + triggers->triggersWithContext.size();
 }
 
 /**
@@ -129,10 +190,13 @@ unsigned int VuoTriggerSet<TriggerDataType, TriggerContextType>::size(void)
 template<typename TriggerDataType, typename TriggerContextType>
 void VuoTriggerSet<TriggerDataType, TriggerContextType>::fire(TriggerDataType data)
 {
-	dispatch_sync(queue, ^{
-					   for (typename std::set<TriggerFunctionType>::iterator it = triggers.begin(); it != triggers.end(); ++it)
-						   (*it)(data);
-				   });
+	unsigned int phase = firingPhases.beginReading(firingCounts);
+	{
+		std::shared_ptr<const Triggers> triggers = std::atomic_load(&current);
+		for (TriggerFunctionType trigger : triggers->triggers)
+			trigger(data);
+	}
+	firingPhases.endReading(firingCounts, phase);
 }
 
 /**
@@ -143,8 +207,11 @@ void VuoTriggerSet<TriggerDataType, TriggerContextType>::fire(TriggerDataType da
 template<typename TriggerDataType, typename TriggerContextType>
 void VuoTriggerSet<TriggerDataType, TriggerContextType>::fire(void (^block)(TriggerFunctionType trigger, TriggerContextType context))
 {
-	dispatch_sync(queue, ^{
-		for (typename std::set< std::pair<TriggerFunctionType, TriggerContextType> >::iterator it = triggersWithContext.begin(); it != triggersWithContext.end(); ++it)
-			block(it->first, it->second);
-	});
+	unsigned int phase = firingPhases.beginReading(firingCounts);
+	{
+		std::shared_ptr<const Triggers> triggers = std::atomic_load(&current);
+		for (const std::pair<TriggerFunctionType, TriggerContextType> &triggerWithContext : triggers->triggersWithContext)
+			block(triggerWithContext.first, triggerWithContext.second);
+	}
+	firingPhases.endReading(firingCounts, phase);
 }
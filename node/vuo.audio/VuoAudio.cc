@@ -19,7 +19,8 @@
 #include <RtAudio/RtAudio.h>
 #pragma clang diagnostic pop
 
-#include <queue>
+#include <atomic>
+#include <climits>
 #include <CoreAudio/CoreAudio.h>
 #include <objc/objc-runtime.h>
 
@@ -194,15 +195,145 @@ void VuoAudio_removeDevicesChangedTriggers(VuoOutputTrigger(inputDevices, VuoLis
 	VuoAudio_outputDeviceCallbacks.removeTrigger(outputDevices);
 }
 
+const unsigned int VuoAudio_ringCapacity = 4 * VuoAudio_queueSize;	///< The number of buffers each ring can hold before new buffers are dropped.
+const unsigned int VuoAudio_maxOutputSources = 32;	///< The number of unique sources that can simultaneously send to a single audio device.
+
+/**
+ * The number of consecutive buffers a source can go without sending audio
+ * before its slot is made available to other sources (about 2 seconds).
+ */
+const unsigned int VuoAudio_idleBuffersBeforeReleasingSource = 2 * VuoAudioSamples_sampleRate / VuoAudioSamples_bufferSize;
+
+/**
+ * One buffer's worth of non-interleaved samples, allocated up front and recycled by @ref VuoAudioRing.
+ */
+typedef struct
+{
+	double *samples;			///< `channelCount` consecutive runs of `frameCount` samples.
+	bool *channelHasSamples;	///< For each channel, whether the sender provided samples (output only).
+	double streamTime;			///< The stream time at which this buffer was received or requested.
+} VuoAudioRingFrame;
+
+/**
+ * A fixed-capacity queue of sample buffers, shared between exactly one producer thread and one consumer thread.
+ *
+ * All buffers are allocated when the ring is created and then reused,
+ * and the read/write counters are the only state the two threads share,
+ * so neither end allocates memory or takes a lock.
+ */
+class VuoAudioRing
+{
+public:
+	/**
+	 * Allocates `capacity` buffers, each holding `frameCount` samples for each of `channelCount` channels.
+	 */
+	VuoAudioRing(unsigned int capacity, unsigned int channelCount, unsigned int frameCount)
+		: capacity(capacity), readCount(0), writeCount(0)
+	{
+		frames = (VuoAudioRingFrame *)calloc(capacity, sizeof(VuoAudioRingFrame));
+		samples = (double *)calloc((size_t)capacity * channelCount * frameCount, sizeof(double));
+		channelHasSamples = (bool *)calloc((size_t)capacity * channelCount, sizeof(bool));
+		for (unsigned int i = 0; i < capacity; ++i)
+		{
+			frames[i].samples = samples + (size_t)i * channelCount * frameCount;
+			frames[i].channelHasSamples = channelHasSamples + (size_t)i * channelCount;
+		}
+	}
+
+	~VuoAudioRing()
+	{
+		free(frames);
+		free(samples);
+		free(channelHasSamples);
+	}
+
+	/**
+	 * Producer only: returns the next buffer to fill in, or NULL if the ring is full.
+	 */
+	VuoAudioRingFrame *beginWrite(void)
+	{
+		unsigned long write = writeCount.load(std::memory_order_relaxed);
+		if (write - readCount.load(std::memory_order_acquire) >= capacity)
+			return NULL;
+		return &frames[write % capacity];
+	}
+
+	/**
+	 * Producer only: makes the buffer returned by @ref beginWrite available to the consumer.
+	 */
+	void endWrite(void)
+	{
+		writeCount.store(writeCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/**
+	 * Consumer only: returns the oldest buffer, or NULL if the ring is empty.
+	 */
+	VuoAudioRingFrame *front(void)
+	{
+		unsigned long read = readCount.load(std::memory_order_relaxed);
+		if (read == writeCount.load(std::memory_order_acquire))
+			return NULL;
+		return &frames[read % capacity];
+	}
+
+	/**
+	 * Consumer only: returns the buffer returned by @ref front to the producer for reuse.
+	 */
+	void pop(void)
+	{
+		readCount.store(readCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/**
+	 * Consumer only: discards all buffers.
+	 */
+	void clear(void)
+	{
+		readCount.store(writeCount.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	/**
+	 * Consumer only: returns the number of buffers waiting to be consumed.
+	 */
+	unsigned long size(void)
+	{
+		return writeCount.load(std::memory_order_acquire) - readCount.load(std::memory_order_relaxed);
+	}
+
+private:
+	const unsigned int capacity;	///< The maximum number of buffers the ring can hold.
+	VuoAudioRingFrame *frames;		///< The buffers, indexed by count modulo capacity.
+	double *samples;				///< Storage for all buffers' samples.
+	bool *channelHasSamples;		///< Storage for all buffers' channel flags.
+	std::atomic<unsigned long> readCount;	///< The total number of buffers ever popped.
+	std::atomic<unsigned long> writeCount;	///< The total number of buffers ever pushed.
+};
+
 /**
- * For each unique audio source (identified by `void *`), a queue of buffers to output.
+ * The value of @ref VuoAudioOutputSource::writerCount while the audio thread is releasing the slot.
  */
-typedef std::map<void *, std::queue<VuoList_VuoAudioSamples> > pendingOutputType;
+const unsigned int VuoAudio_sourceReleasing = UINT_MAX;
 
 /**
- * For each unique audio source (identified by `void *`), the last sample value that was output on each channel.
+ * A slot through which one unique audio source (identified by `void *`) sends buffers to the audio device.
+ *
+ * The sender is the slot's ring's only producer, and the audio thread is its only consumer.
+ * To keep it that way when the slot passes from one source to another, a sender only writes to the ring
+ * between @ref VuoAudio_beginSending and @ref VuoAudio_endSending, and the audio thread only releases the slot
+ * (@ref VuoAudio_releaseSource) when no sender is between those calls.
  */
-typedef std::map<void *, std::map<VuoInteger, VuoReal> > lastOutputSampleType;
+typedef struct
+{
+	std::atomic<void *> id;						///< The source using this slot, or NULL if the slot is available.  Claimed by @ref VuoAudioOut_sendChannels; released by the audio thread once the source goes idle.
+	std::atomic<unsigned int> writerCount;		///< The number of senders currently writing to @ref pendingOutput, or @ref VuoAudio_sourceReleasing.
+	std::atomic<VuoAudioRing *> pendingOutput;	///< Sample buffers waiting to be output.  Allocated by the first source to claim this slot, then reused (empty) by later sources.
+
+	// The following are only accessed by the audio thread.
+	double *lastOutputSample;		///< For each channel, the last sample value that was output (to smoothly move back to 0 DC when there's a dropout).
+	bool *channelIsPlaying;			///< For each channel, whether a buffer was output during the last callback.
+	unsigned int idleBufferCount;	///< The number of consecutive callbacks during which this source didn't output a buffer.
+} VuoAudioOutputSource;
 
 /**
  * Private data for a VuoAudio instance.
@@ -212,148 +343,265 @@ typedef struct _VuoAudio_internal
 	RtAudio *rta;	///< RtAudio's device pointer.
 	VuoAudioInputDevice inputDevice;		///< The device's id must be nonnegative, and channelCount must be set.
 	VuoAudioOutputDevice outputDevice;		///< The device's id must be nonnegative, and channelCount must be set.
+	unsigned int frameCount;				///< The number of samples per channel per buffer, as negotiated with the device.
+	VuoReal samplesPerSecond;				///< The stream's sample rate, as negotiated with the device.
 
 	VuoTriggerSet<VuoList_VuoAudioSamples> inputTriggers;	///< Trigger methods to call when an audio buffer is received.
 	VuoTriggerSet<VuoReal> outputTriggers;	///< Trigger methods to call when an audio buffer is needed.
 
-	dispatch_queue_t pendingOutputQueue;	///< Serializes access to the following set of buffers.
-	pendingOutputType pendingOutput;		///< Sample buffers waiting to be output.
+	VuoAudioRing *receivedInput;			///< Input buffers copied by the audio thread, waiting to be delivered to @ref inputTriggers.  NULL if the device has no input channels.
+	VuoAudioRing *outputRequests;			///< Stream times at which the audio thread needed output, waiting to be delivered to @ref outputTriggers.
+	dispatch_queue_t deliveryQueue;			///< Fires triggers on behalf of the audio thread.
+	dispatch_source_t deliverySource;		///< Signaled by the audio thread when it has added to @ref receivedInput or @ref outputRequests.
 
-	lastOutputSampleType lastOutputSample;	///< The last sample value sent on each channel (to smoothly move back to 0 DC when there's a dropout).  Not present means no buffer was sent to the channel during the last frame.
+	VuoAudioOutputSource outputSources[VuoAudio_maxOutputSources];	///< Sample buffers waiting to be mixed into the output.
 
-	VuoReal priorStreamTime;				///< The time at which the prior VuoAudio_receivedEvent() happened, to track stream overflows.
+	std::atomic<VuoInteger> inputOverrunCount;		///< The number of input buffers dropped, since the device or the delivery queue couldn't keep up.
+	std::atomic<VuoInteger> outputUnderrunCount;	///< The number of times a playing source or the device ran out of output buffers.
+	std::atomic<VuoInteger> outputOverrunCount;		///< The number of output buffers dropped, since a source was sending faster than the device was playing.
+
+	std::atomic<VuoInteger> deviceInputOverflowCount;	///< The number of times RtAudio reported that the device dropped input.
+	std::atomic<VuoInteger> deviceOutputUnderflowCount;	///< The number of times RtAudio reported that the device ran out of output.
+	VuoInteger loggedDeviceInputOverflowCount;		///< The value of @ref deviceInputOverflowCount when last logged (only accessed on @ref deliveryQueue).
+	VuoInteger loggedDeviceOutputUnderflowCount;	///< The value of @ref deviceOutputUnderflowCount when last logged (only accessed on @ref deliveryQueue).
+	std::atomic<bool> loggedOutputUnsupported;		///< Whether we've already warned that a source tried to send to an input-only device.
 } *VuoAudio_internal;
 
 /**
- * RtAudio calls this function when a new sample buffer is ready or needed.
+ * Runs on the delivery queue after the audio thread has received input or requested output.
+ * Does the work that isn't safe to do on the audio thread:
+ * firing triggers, allocating sample lists, and logging.
  */
-int VuoAudio_receivedEvent(void *outputBuffer, void *inputBuffer, unsigned int nBufferFrames, double streamTime, RtAudioStreamStatus status, void *userData)
+static void VuoAudio_deliver(VuoAudio_internal ai)
 {
-	VuoAudio_internal ai = (VuoAudio_internal)userData;
-
-//	if (streamTime - ai->priorStreamTime > ((float)VuoAudioSamples_bufferSize/VuoAudioSamples_sampleRate)*1.02)
-//		VLog("called too late: %g (should have been < %g)", streamTime-ai->priorStreamTime, ((float)VuoAudioSamples_bufferSize/VuoAudioSamples_sampleRate)*1.02);
-//	ai->priorStreamTime=streamTime;
+	VuoInteger inputOverflowCount = ai->deviceInputOverflowCount.load(std::memory_order_relaxed);
+	if (inputOverflowCount != ai->loggedDeviceInputOverflowCount)
+	{
+		VUserLog("Stream overflow (%lld times) on %s.", inputOverflowCount - ai->loggedDeviceInputOverflowCount, ai->inputDevice.name);
+		ai->loggedDeviceInputOverflowCount = inputOverflowCount;
+	}
 
-	if (status)
-		VUserLog("Stream %s (%d) on %s.",
-				 status == RTAUDIO_INPUT_OVERFLOW ? "overflow"
-					 : (status == RTAUDIO_OUTPUT_UNDERFLOW ? "underflow" : "error"),
-				 status,
-				 ai->inputDevice.name);
+	VuoInteger outputUnderflowCount = ai->deviceOutputUnderflowCount.load(std::memory_order_relaxed);
+	if (outputUnderflowCount != ai->loggedDeviceOutputUnderflowCount)
+	{
+		VUserLog("Stream underflow (%lld times) on %s.", outputUnderflowCount - ai->loggedDeviceOutputUnderflowCount, ai->outputDevice.name);
+		ai->loggedDeviceOutputUnderflowCount = outputUnderflowCount;
+	}
 
 	// Fire triggers requesting audio output buffers.
-	ai->outputTriggers.fire(streamTime);
+	VuoAudioRingFrame *request;
+	while ((request = ai->outputRequests->front()))
+	{
+		VuoReal streamTime = request->streamTime;
+		ai->outputRequests->pop();
+		ai->outputTriggers.fire(streamTime);
+	}
 
 	// Fire triggers providing audio input buffers.
-	if (ai->inputTriggers.size())
+	if (!ai->receivedInput)
+		return;
+
+	VuoAudioRingFrame *frame;
+	while ((frame = ai->receivedInput->front()))
 	{
-		VuoList_VuoAudioSamples channels = VuoListCreate_VuoAudioSamples();
-		VuoRetain(channels);
+		if (ai->inputTriggers.size())
+		{
+			VuoList_VuoAudioSamples channels = VuoListCreate_VuoAudioSamples();
+			VuoRetain(channels);
 
-		unsigned int samplesPerSecond = ai->rta->getStreamSampleRate();
+			for (VuoInteger i = 0; i < ai->inputDevice.channelCount; ++i)
+			{
+				VuoAudioSamples samples = VuoAudioSamples_alloc(ai->frameCount);
+				samples.samplesPerSecond = ai->samplesPerSecond;
+				memcpy(samples.samples, frame->samples + i * ai->frameCount, sizeof(VuoReal) * ai->frameCount);
+				VuoListAppendValue_VuoAudioSamples(channels, samples);
+			}
+
+			ai->receivedInput->pop();
+			ai->inputTriggers.fire(channels);
+			VuoRelease(channels);
+		}
+		else
+			ai->receivedInput->pop();
+	}
+}
 
-		// When creating the stream, we requested that inputBuffer be non-interleaved, so the samples should appear consecutively.
-		for (VuoInteger i = 0; i < ai->inputDevice.channelCount; ++i)
+/**
+ * If no sender is writing to `source`, discards its pending buffers and makes it available to other sources.
+ * Otherwise leaves it as is, to be released during a later callback.
+ *
+ * Runs on the audio thread.
+ */
+static void VuoAudio_releaseSource(VuoAudio_internal ai, VuoAudioOutputSource *source, VuoAudioRing *pendingOutput)
+{
+	// Keep senders out while the ring is being emptied.
+	unsigned int noWriters = 0;
+	if (!source->writerCount.compare_exchange_strong(noWriters, VuoAudio_sourceReleasing, std::memory_order_acq_rel))
+		return;
+
+	// The next source to claim the slot starts with an empty ring, so it never plays this source's leftover buffers.
+	pendingOutput->clear();
+	for (unsigned int channel = 0; channel < ai->outputDevice.channelCount; ++channel)
+		source->channelIsPlaying[channel] = false;
+	source->idleBufferCount = 0;
+
+	// Clear the ID before letting senders back in, so a sender for the old ID sees that the slot is no longer its own.
+	source->id.store(NULL, std::memory_order_release);
+	source->writerCount.store(0, std::memory_order_release);
+}
+
+/**
+ * Mixes the next buffer from `source` into `outputBuffer`.
+ *
+ * Runs on the audio thread.
+ */
+static void VuoAudio_mixSource(VuoAudio_internal ai, VuoAudioOutputSource *source, VuoAudioRing *pendingOutput, double *outputBuffer, unsigned int nBufferFrames)
+{
+	unsigned int outputChannelCount = ai->outputDevice.channelCount;
+	VuoAudioRingFrame *frame = pendingOutput->front();
+
+	if (!frame)	// No pending buffers for this source.
+	{
+		bool wasPlaying = false;
+		for (unsigned int channel = 0; channel < outputChannelCount; ++channel)
 		{
-			VuoAudioSamples samples = VuoAudioSamples_alloc(nBufferFrames);
-			samples.samplesPerSecond = samplesPerSecond;
-			memcpy(samples.samples, (VuoReal *)inputBuffer + i*nBufferFrames, sizeof(VuoReal)*nBufferFrames);
-			VuoListAppendValue_VuoAudioSamples(channels, samples);
+			if (!source->channelIsPlaying[channel])
+				continue;
+
+			// Since this channel was previously playing audio, smoothly fade the last amplitude to zero...
+			VuoReal lastOutputSample = source->lastOutputSample[channel];
+			for (VuoInteger i = 0; i < nBufferFrames; ++i)
+				outputBuffer[nBufferFrames*channel + i] += VuoReal_lerp(lastOutputSample, 0, (float)i/nBufferFrames);
+
+			// ...and indicate that we already faded out.
+			source->channelIsPlaying[channel] = false;
+			wasPlaying = true;
 		}
 
-		ai->inputTriggers.fire(channels);
-		VuoRelease(channels);
+		if (wasPlaying)
+			ai->outputUnderrunCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	else	// Have pending buffers for this source.
+	{
+		// If this is the first sample buffer ever, or the first after a dropout,
+		// make sure the queue is primed with a few buffers before we start draining it.
+		bool primed = true;
+		for (unsigned int channel = 0; channel < outputChannelCount; ++channel)
+			if (frame->channelHasSamples[channel] && !source->channelIsPlaying[channel])
+			{
+				primed = pendingOutput->size() >= VuoAudio_queueSize;
+				break;
+			}
+
+		if (primed)
+		{
+			for (unsigned int channel = 0; channel < outputChannelCount; ++channel)
+			{
+				if (!frame->channelHasSamples[channel])
+					continue;
+
+				double *samples = frame->samples + channel * ai->frameCount;
+				if (!source->channelIsPlaying[channel])
+				{
+					// Smoothly fade from zero to the sample buffer.
+					for (VuoInteger i = 0; i < nBufferFrames; ++i)
+						outputBuffer[nBufferFrames*channel + i] += (float)i/nBufferFrames * samples[i];
+				}
+				else
+				{
+					// We were previously playing audio, so just copy the samples intact.
+					for (VuoInteger i = 0; i < nBufferFrames; ++i)
+						/// @todo Should we clamp here (or after all buffers for this channel have been summed), or does CoreAudio handle that for us?
+						outputBuffer[nBufferFrames*channel + i] += samples[i];
+				}
+
+				source->lastOutputSample[channel] = samples[nBufferFrames - 1];
+				source->channelIsPlaying[channel] = true;
+			}
+
+			pendingOutput->pop();
+			source->idleBufferCount = 0;
+			return;
+		}
 	}
 
+	// If this source has stopped sending, make its slot available to other sources.
+	if (++source->idleBufferCount >= VuoAudio_idleBuffersBeforeReleasingSource)
+		VuoAudio_releaseSource(ai, source, pendingOutput);
+}
+
+/**
+ * RtAudio calls this function when a new sample buffer is ready or needed.
+ *
+ * This runs on the audio device's real-time thread, so it mustn't allocate memory, take locks, or log.
+ * It just copies samples into and out of preallocated rings,
+ * and leaves everything else to @ref VuoAudio_deliver.
+ */
+int VuoAudio_receivedEvent(void *outputBuffer, void *inputBuffer, unsigned int nBufferFrames, double streamTime, RtAudioStreamStatus status, void *userData)
+{
+	VuoAudio_internal ai = (VuoAudio_internal)userData;
+
+	if (status & RTAUDIO_INPUT_OVERFLOW)
+		ai->deviceInputOverflowCount.fetch_add(1, std::memory_order_relaxed);
+	if (status & RTAUDIO_OUTPUT_UNDERFLOW)
+	{
+		ai->deviceOutputUnderflowCount.fetch_add(1, std::memory_order_relaxed);
+		ai->outputUnderrunCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// RtAudio shouldn't change the buffer size after opening the stream, but just in case, don't overrun the rings.
+	nBufferFrames = MIN(nBufferFrames, ai->frameCount);
+
+	// Ask the delivery queue to fire triggers requesting audio output buffers.
+	// (If the ring is full, the delivery queue is already far behind, so another request wouldn't help.)
+	VuoAudioRingFrame *request = ai->outputRequests->beginWrite();
+	if (request)
+	{
+		request->streamTime = streamTime;
+		ai->outputRequests->endWrite();
+	}
+
+	// Hand the input buffer to the delivery queue.
+	// When creating the stream, we requested that inputBuffer be non-interleaved, so the samples should appear consecutively.
+	if (inputBuffer && ai->receivedInput)
+	{
+		VuoAudioRingFrame *frame = ai->receivedInput->beginWrite();
+		if (frame)
+		{
+			for (VuoInteger i = 0; i < ai->inputDevice.channelCount; ++i)
+				memcpy(frame->samples + i * ai->frameCount, (VuoReal *)inputBuffer + i * nBufferFrames, sizeof(VuoReal) * nBufferFrames);
+			frame->streamTime = streamTime;
+			ai->receivedInput->endWrite();
+		}
+		else
+			ai->inputOverrunCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	dispatch_source_merge_data(ai->deliverySource, 1);
+
+	if (!outputBuffer)
+		return 0;
+
 	// Zero the final output buffer.
 	double *outputBufferDouble = (double *)outputBuffer;
-	unsigned int outputChannelCount = ai->outputDevice.channelCount;
-	if (outputBuffer)
-		memset(outputBufferDouble, 0, nBufferFrames*sizeof(VuoReal)*outputChannelCount);
-
-	// Process the pending output buffers.
-	dispatch_sync(ai->pendingOutputQueue, ^{
-					  if (!outputBuffer)
-					  {
-						  // If there are any pending buffers, squander them.
-						  bool pendingOutput = false;
-						  for (pendingOutputType::iterator it = ai->pendingOutput.begin(); it != ai->pendingOutput.end(); ++it)
-							  while (!it->second.empty())
-							  {
-								  VuoRelease(it->second.front());
-								  it->second.pop();
-								  pendingOutput = true;
-							  }
-
-						  if (pendingOutput)
-							  VUserLog("This audio device (%s) doesn't support output.", ai->outputDevice.name);
-						  return;
-					  }
-
-					  // Mix the next buffer from each source into a single output buffer.
-					  /// @todo handle differing sample rates
-					  for (pendingOutputType::iterator it = ai->pendingOutput.begin(); it != ai->pendingOutput.end(); ++it)
-					  {
-						  void *id = it->first;
-						  if (it->second.empty())	// No pending buffers for this source.
-						  {
-							  if (ai->lastOutputSample.find(id) == ai->lastOutputSample.end())
-								  continue;
-
-							  for (unsigned int channel = 0; channel < outputChannelCount; ++channel)
-							  {
-								  if (ai->lastOutputSample[id].find(channel) == ai->lastOutputSample[id].end())
-									  continue;
-
-								  // Since this channel was previously playing audio, smoothly fade the last amplitude to zero...
-								  VuoReal lastOutputSample = ai->lastOutputSample[id][channel];
-								  for (VuoInteger i=0; i<nBufferFrames; ++i)
-									  outputBufferDouble[nBufferFrames*(channel) + i] = VuoReal_lerp(lastOutputSample, 0, (float)i/nBufferFrames);
-
-								  // ...and indicate that we already faded out.
-								  ai->lastOutputSample[id].erase(ai->lastOutputSample[id].find(channel));
-							  }
-						  }
-						  else	// Have pending buffers for this source.
-						  {
-							  VuoList_VuoAudioSamples channels = it->second.front();
-
-							  for (unsigned int channel = 0; channel < outputChannelCount; ++channel)
-							  {
-								  VuoAudioSamples as = VuoListGetValue_VuoAudioSamples(channels, channel+1);
-								  if (!as.samples || as.sampleCount == 0)
-									  continue;
-
-								  if (ai->lastOutputSample[id].find(channel) == ai->lastOutputSample[id].end())
-								  {
-									  // This is the first sample buffer ever, or the first after a dropout.
-									  // Make sure the queue is primed with a few buffers before we start draining it.
-									  if (it->second.size() < VuoAudio_queueSize)
-										  goto skipPop;
-
-									  // Smoothly fade from zero to the sample buffer.
-									  for (VuoInteger i=0; i<nBufferFrames; ++i)
-										  outputBufferDouble[nBufferFrames*channel + i] = (float)i/nBufferFrames * as.samples[i];
-								  }
-								  else
-								  {
-									  // We were previously playing audio, so just copy the samples intact.
-									  for (VuoInteger i=0; i<nBufferFrames; ++i)
-										  /// @todo Should we clamp here (or after all buffers for this channel have been summed), or does CoreAudio handle that for us?
-										  outputBufferDouble[nBufferFrames*(channel) + i] += as.samples[i];
-								  }
-
-								  ai->lastOutputSample[id][channel] = as.samples[as.sampleCount-1];
-							  }
-
-							  it->second.pop();
-							  VuoRelease(channels);
-
-							  skipPop:;
-						  }
-					  }
-				  });
+	memset(outputBufferDouble, 0, nBufferFrames*sizeof(VuoReal)*ai->outputDevice.channelCount);
+
+	// Mix the next buffer from each source into a single output buffer.
+	/// @todo handle differing sample rates
+	for (unsigned int s = 0; s < VuoAudio_maxOutputSources; ++s)
+	{
+		VuoAudioOutputSource *source = &ai->outputSources[s];
+		if (!source->id.load(std::memory_order_acquire))
+			continue;
+
+		// Until the slot's first source publishes the ring, there's nothing to play.
+		VuoAudioRing *pendingOutput = source->pendingOutput.load(std::memory_order_acquire);
+		if (!pendingOutput)
+			continue;
+
+		VuoAudio_mixSource(ai, source, pendingOutput, outputBufferDouble, nBufferFrames);
+	}
+
 	return 0;
 }
 
@@ -367,6 +615,90 @@ void VuoAudio_rtAudioError(RtAudioError::Type type, const std::string &errorText
 		errorText.c_str());
 }
 
+/**
+ * Releases the rings and delivery queue.  Call only after the audio stream has stopped.
+ */
+static void VuoAudio_freeBuffers(VuoAudio_internal ai)
+{
+	if (ai->deliverySource)
+	{
+		// Wait for any in-progress delivery to finish.
+		dispatch_source_cancel(ai->deliverySource);
+		dispatch_sync(ai->deliveryQueue, ^{});
+		dispatch_release(ai->deliverySource);
+		dispatch_release(ai->deliveryQueue);
+	}
+
+	delete ai->receivedInput;
+	delete ai->outputRequests;
+
+	for (unsigned int s = 0; s < VuoAudio_maxOutputSources; ++s)
+	{
+		delete ai->outputSources[s].pendingOutput.load();
+		free(ai->outputSources[s].lastOutputSample);
+		free(ai->outputSources[s].channelIsPlaying);
+	}
+}
+
+/**
+ * Creates an instance with no stream and no buffers.
+ */
+static VuoAudio_internal VuoAudio_allocate(VuoInteger deviceId)
+{
+	VuoAudio_internal ai = new _VuoAudio_internal;
+	ai->rta = NULL;
+	ai->inputDevice.id = deviceId;
+	ai->outputDevice.id = deviceId;
+	ai->frameCount = 0;
+	ai->receivedInput = NULL;
+	ai->outputRequests = NULL;
+	ai->deliveryQueue = NULL;
+	ai->deliverySource = NULL;
+	for (unsigned int s = 0; s < VuoAudio_maxOutputSources; ++s)
+	{
+		ai->outputSources[s].id = NULL;
+		ai->outputSources[s].writerCount = 0;
+		ai->outputSources[s].pendingOutput = NULL;
+		ai->outputSources[s].lastOutputSample = NULL;
+		ai->outputSources[s].channelIsPlaying = NULL;
+		ai->outputSources[s].idleBufferCount = 0;
+	}
+	ai->inputOverrunCount = 0;
+	ai->outputUnderrunCount = 0;
+	ai->outputOverrunCount = 0;
+	ai->deviceInputOverflowCount = 0;
+	ai->deviceOutputUnderflowCount = 0;
+	ai->loggedDeviceInputOverflowCount = 0;
+	ai->loggedDeviceOutputUnderflowCount = 0;
+	ai->loggedOutputUnsupported = false;
+
+	return ai;
+}
+
+/**
+ * Allocates the rings and delivery queue, for buffers of `bufferFrames` samples per channel.
+ */
+static void VuoAudio_allocateBuffers(VuoAudio_internal ai, unsigned int bufferFrames, VuoReal samplesPerSecond)
+{
+	ai->frameCount = bufferFrames;
+	ai->samplesPerSecond = samplesPerSecond;
+	if (ai->inputDevice.channelCount)
+		ai->receivedInput = new VuoAudioRing(VuoAudio_ringCapacity, ai->inputDevice.channelCount, bufferFrames);
+	ai->outputRequests = new VuoAudioRing(VuoAudio_ringCapacity, 0, 0);
+	for (unsigned int s = 0; s < VuoAudio_maxOutputSources; ++s)
+	{
+		ai->outputSources[s].lastOutputSample = (double *)calloc(ai->outputDevice.channelCount, sizeof(double));
+		ai->outputSources[s].channelIsPlaying = (bool *)calloc(ai->outputDevice.channelCount, sizeof(bool));
+	}
+
+	ai->deliveryQueue = dispatch_queue_create("VuoAudio delivery", VuoEventLoop_getDispatchInteractiveAttribute());
+	ai->deliverySource = dispatch_source_create(DISPATCH_SOURCE_TYPE_DATA_ADD, 0, 0, ai->deliveryQueue);
+	dispatch_source_set_event_handler(ai->deliverySource, ^{
+		VuoAudio_deliver(ai);
+	});
+	dispatch_resume(ai->deliverySource);
+}
+
 /// @{
 VUOKEYEDPOOL(unsigned int, VuoAudio_internal);
 static void VuoAudio_destroy(VuoAudio_internal ai);
@@ -389,11 +721,7 @@ VuoAudio_internal VuoAudio_make(unsigned int deviceId)
 				VUserLog("Error: Audio input is unavailable due to system restrictions.  Check System Settings > Privacy & Security > Microphone.");
 		}
 
-		ai = new _VuoAudio_internal;
-		ai->inputDevice.id = deviceId;
-		ai->outputDevice.id = deviceId;
-
-		ai->pendingOutputQueue = dispatch_queue_create("VuoAudio pending output", VuoEventLoop_getDispatchInteractiveAttribute());
+		ai = VuoAudio_allocate(deviceId);
 
 		// Though neither RtAudio's documentation nor Apple's documentation
 		// specify that audio must be initialized on the main thread,
@@ -432,6 +760,11 @@ VuoAudio_internal VuoAudio_make(unsigned int deviceId)
 					ai,
 					&options,
 					VuoAudio_rtAudioError);
+
+		// Now that we know the actual buffer size, allocate everything the audio thread needs,
+		// so it never has to allocate memory itself.
+		VuoAudio_allocateBuffers(ai, bufferFrames, ai->rta->getStreamSampleRate());
+
 		ai->rta->startStream();
 	}
 	catch (RtAudioError &error)
@@ -441,6 +774,9 @@ VuoAudio_internal VuoAudio_make(unsigned int deviceId)
 
 		if (ai)
 		{
+			if (ai->rta && ai->rta->isStreamOpen())
+				ai->rta->closeStream();
+			VuoAudio_freeBuffers(ai);
 			delete ai->rta;
 			delete ai;
 			ai = NULL;
@@ -456,7 +792,7 @@ static void VuoAudio_destroy(VuoAudio_internal ai)
 {
 	try
 	{
-		if (ai->rta->isStreamOpen())
+		if (ai->rta && ai->rta->isStreamOpen())
 		{
 			ai->rta->stopStream();
 			ai->rta->closeStream();
@@ -467,16 +803,8 @@ static void VuoAudio_destroy(VuoAudio_internal ai)
 		VUserLog("Failed to close the audio device (%s): %s", ai->inputDevice.name, error.what());
 	}
 
-	// Now that the audio stream is stopped (and the last callback has returned), it's safe to delete the queue.
-	dispatch_release(ai->pendingOutputQueue);
-
-	// Release any leftover buffers.
-	for (pendingOutputType::iterator it = ai->pendingOutput.begin(); it != ai->pendingOutput.end(); ++it)
-		while (!it->second.empty())
-		{
-			VuoRelease(it->second.front());
-			it->second.pop();
-		}
+	// Now that the audio stream is stopped (and the last callback has returned), it's safe to release the buffers.
+	VuoAudio_freeBuffers(ai);
 
 	delete ai->rta;
 	VuoRelease(ai->inputDevice.name);
@@ -486,6 +814,42 @@ static void VuoAudio_destroy(VuoAudio_internal ai)
 VUOKEYEDPOOL_DEFINE(unsigned int, VuoAudio_internal, VuoAudio_make);
 /// @}
 
+/**
+ * @private function for TestVuoAudio.
+ *
+ * Creates an instance (usable as both a @ref VuoAudioIn and a @ref VuoAudioOut) that isn't connected to an audio device.
+ * Call @ref VuoAudio_processBuffers to play the part of the device.
+ */
+void *VuoAudio_makeWithoutDevice(unsigned int inputChannelCount, unsigned int outputChannelCount, unsigned int bufferFrames)
+{
+	VuoAudio_internal ai = VuoAudio_allocate(-1);
+	ai->inputDevice.name = VuoText_make("(no device)");
+	VuoRetain(ai->inputDevice.name);
+	ai->inputDevice.channelCount = inputChannelCount;
+	ai->outputDevice.name = VuoText_make("(no device)");
+	VuoRetain(ai->outputDevice.name);
+	ai->outputDevice.channelCount = outputChannelCount;
+
+	VuoAudio_allocateBuffers(ai, bufferFrames, VuoAudioSamples_sampleRate);
+
+	VuoRegister(ai, (DeallocateFunctionType)VuoAudio_destroy);
+	return ai;
+}
+
+/**
+ * @private function for TestVuoAudio.
+ *
+ * Does what the audio device's callback would do: hands `inputBuffer` (non-interleaved; may be NULL) to the input triggers,
+ * and mixes the sources' pending output into `outputBuffer` (non-interleaved; may be NULL).
+ *
+ * Call this from only one thread at a time, as the audio device would.
+ */
+void VuoAudio_processBuffers(void *audio, double *outputBuffer, double *inputBuffer, double streamTime)
+{
+	VuoAudio_internal ai = (VuoAudio_internal)audio;
+	VuoAudio_receivedEvent(outputBuffer, inputBuffer, ai->frameCount, streamTime, 0, ai);
+}
+
 /**
  * @copydoc VuoKeyedPool<std::string,VuoAudio_internal>::useSharedInstance
  */
@@ -606,6 +970,69 @@ void VuoAudioOut_removeTrigger
 	aii->outputTriggers.removeTrigger(requestedChannels);
 }
 
+/**
+ * If `source` belongs to `id` and isn't being released, registers the caller as writing to it and returns true.
+ * Otherwise returns false.
+ */
+static bool VuoAudio_beginSending(VuoAudioOutputSource *source, void *id)
+{
+	unsigned int writerCount = source->writerCount.load(std::memory_order_acquire);
+	do
+	{
+		if (writerCount == VuoAudio_sourceReleasing)
+			return false;
+	} while (!source->writerCount.compare_exchange_weak(writerCount, writerCount + 1, std::memory_order_acq_rel));
+
+	// The audio thread may have released the slot (and another source may have claimed it) since the caller checked its ID.
+	if (source->id.load(std::memory_order_acquire) != id)
+	{
+		source->writerCount.fetch_sub(1, std::memory_order_release);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Indicates that the caller has finished writing to `source`.
+ */
+static void VuoAudio_endSending(VuoAudioOutputSource *source)
+{
+	source->writerCount.fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * Returns the output slot that `id` is using, or claims an available slot for it,
+ * after calling @ref VuoAudio_beginSending on the slot.
+ * Returns NULL if all slots are in use.
+ */
+static VuoAudioOutputSource *VuoAudio_getOutputSource(VuoAudio_internal ai, void *id)
+{
+	for (unsigned int s = 0; s < VuoAudio_maxOutputSources; ++s)
+	{
+		VuoAudioOutputSource *source = &ai->outputSources[s];
+		if (source->id.load(std::memory_order_acquire) == id && VuoAudio_beginSending(source, id))
+			return source;
+	}
+
+	for (unsigned int s = 0; s < VuoAudio_maxOutputSources; ++s)
+	{
+		VuoAudioOutputSource *source = &ai->outputSources[s];
+		void *available = NULL;
+		if (source->id.compare_exchange_strong(available, id))
+		{
+			// Until the ring is published, the audio thread ignores this slot.
+			if (!source->pendingOutput.load(std::memory_order_acquire))
+				source->pendingOutput.store(new VuoAudioRing(VuoAudio_ringCapacity, ai->outputDevice.channelCount, ai->frameCount), std::memory_order_release);
+
+			if (VuoAudio_beginSending(source, id))
+				return source;
+		}
+	}
+
+	return NULL;
+}
+
 /**
  * Enqueues @c channels for eventual playback.
  *
@@ -615,17 +1042,98 @@ void VuoAudioOut_removeTrigger
  * each is buffered independently — each unique @c id gets its own queue,
  * and at output time a single buffer from each source's queue is mixed
  * to form the final output stream.
+ *
+ * The samples are copied into a preallocated buffer, so the caller retains ownership of @c channels.
+ * If the source's queue is full, the buffer is dropped and counted as an overrun (see @ref VuoAudioOut_getStatistics).
+ *
+ * Calls with the same @c id must not be made concurrently.
  */
 void VuoAudioOut_sendChannels(VuoAudioOut ao, VuoList_VuoAudioSamples channels, void *id)
 {
 	if (!ao)
 		return;
 
-	VuoRetain(channels);
 	VuoAudio_internal aii = (VuoAudio_internal)ao;
-	dispatch_async(aii->pendingOutputQueue, ^{
-					  aii->pendingOutput[id].push(channels);
-				  });
+	unsigned int outputChannelCount = aii->outputDevice.channelCount;
+	if (!outputChannelCount)
+	{
+		if (!aii->loggedOutputUnsupported.exchange(true))
+			VUserLog("This audio device (%s) doesn't support output.", aii->outputDevice.name);
+		return;
+	}
+
+	VuoAudioOutputSource *source = VuoAudio_getOutputSource(aii, id);
+	if (!source)
+	{
+		aii->outputOverrunCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	VuoAudioRing *pendingOutput = source->pendingOutput.load(std::memory_order_acquire);
+	VuoAudioRingFrame *frame = pendingOutput->beginWrite();
+	if (!frame)
+	{
+		VuoAudio_endSending(source);
+		aii->outputOverrunCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	unsigned long channelCount = VuoListGetCount_VuoAudioSamples(channels);
+	VuoAudioSamples *channelData = VuoListGetData_VuoAudioSamples(channels);
+	for (unsigned int channel = 0; channel < outputChannelCount; ++channel)
+	{
+		double *samples = frame->samples + channel * aii->frameCount;
+		VuoInteger sampleCount = 0;
+		if (channel < channelCount && channelData[channel].samples)
+		{
+			sampleCount = MIN(channelData[channel].sampleCount, aii->frameCount);
+			memcpy(samples, channelData[channel].samples, sizeof(double) * sampleCount);
+		}
+		memset(samples + sampleCount, 0, sizeof(double) * (aii->frameCount - sampleCount));
+		frame->channelHasSamples[channel] = sampleCount > 0;
+	}
+
+	pendingOutput->endWrite();
+	VuoAudio_endSending(source);
+}
+
+/**
+ * Outputs the number of input buffers that were dropped
+ * because the device or the composition couldn't keep up.
+ *
+ * @threadAny
+ */
+void VuoAudioIn_getStatistics(VuoAudioIn ai, VuoInteger *overrunCount)
+{
+	if (!ai)
+	{
+		*overrunCount = 0;
+		return;
+	}
+
+	VuoAudio_internal aii = (VuoAudio_internal)ai;
+	*overrunCount = aii->inputOverrunCount.load(std::memory_order_relaxed)
+				  + aii->deviceInputOverflowCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * Outputs the number of times the audio device ran out of samples to play (`underrunCount`),
+ * and the number of buffers passed to @ref VuoAudioOut_sendChannels that were dropped
+ * because they were sent faster than the device was playing them (`overrunCount`).
+ *
+ * @threadAny
+ */
+void VuoAudioOut_getStatistics(VuoAudioOut ao, VuoInteger *underrunCount, VuoInteger *overrunCount)
+{
+	if (!ao)
+	{
+		*underrunCount = *overrunCount = 0;
+		return;
+	}
+
+	VuoAudio_internal aii = (VuoAudio_internal)ao;
+	*underrunCount = aii->outputUnderrunCount.load(std::memory_order_relaxed);
+	*overrunCount = aii->outputOverrunCount.load(std::memory_order_relaxed);
 }
 
 /// Helper for VuoAudioInputDevice_realize.
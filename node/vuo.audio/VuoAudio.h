@@ -50,6 +50,7 @@ void VuoAudioOut_removeTrigger
 		VuoAudioOut ao,
 		VuoOutputTrigger(requestedChannels, VuoReal)
 );
+void VuoAudioOut_getStatistics(VuoAudioOut ao, VuoInteger *underrunCount, VuoInteger *overrunCount);
 
 
 /**
@@ -70,6 +71,10 @@ void VuoAudioIn_removeTrigger
 		VuoAudioIn ai,
 		VuoOutputTrigger(receivedChannels, VuoList_VuoAudioSamples)
 );
+void VuoAudioIn_getStatistics(VuoAudioIn ai, VuoInteger *overrunCount);
+
+void *VuoAudio_makeWithoutDevice(unsigned int inputChannelCount, unsigned int outputChannelCount, unsigned int bufferFrames);
+void VuoAudio_processBuffers(void *audio, double *outputBuffer, double *inputBuffer, double streamTime);
 
 #ifdef __cplusplus
 }
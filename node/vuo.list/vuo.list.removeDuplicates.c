@@ -18,7 +18,7 @@ VuoModuleMetadata({
 	"genericTypes" : {
 		"VuoGenericType1" : {
 			"compatibleTypes" : [
-				/* Sync with vuo.event.changed2 */
+				/* Sync with vuo.event.changed2, vuo.list.union, vuo.list.intersection, and vuo.list.difference */
 				"VuoBoolean", "VuoColor", "VuoImage", "VuoInteger",
 				"VuoPoint2d", "VuoPoint3d", "VuoPoint4d",
 				"VuoReal", "VuoScreen", "VuoText",
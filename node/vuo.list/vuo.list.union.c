@@ -0,0 +1,60 @@
+/**
+ * @file
+ * vuo.list.union node implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the MIT License.
+ * For more information, see https://vuo.org/license.
+ */
+
+VuoModuleMetadata({
+	"title" : "Combine Unique Items",
+	"keywords" : [
+		"combine",
+		"merge",
+		"join",
+		"or",
+		"set",
+		"distinct",
+		"deduplicate",
+	],
+	"version" : "1.0.0",
+	"genericTypes" : {
+		"VuoGenericType1" : {
+			"compatibleTypes" : [
+				/* Sync with vuo.list.removeDuplicates */
+				"VuoBoolean", "VuoColor", "VuoImage", "VuoInteger",
+				"VuoPoint2d", "VuoPoint3d", "VuoPoint4d",
+				"VuoReal", "VuoScreen", "VuoText",
+				"VuoArtNetInputDevice", "VuoArtNetOutputDevice",
+				"VuoAudioInputDevice", "VuoAudioOutputDevice", "VuoAudioFrame", "VuoData",
+				"VuoCoordinateUnit", "VuoDistribution3d", "VuoDragEvent",
+				"VuoHidControl", "VuoHidDevice",
+				"VuoImageFormat",
+				"VuoFont", "VuoMidiController", "VuoMidiInputDevice",
+				"VuoGridType",
+				"VuoMidiNote", "VuoMidiOutputDevice", "VuoMidiPitchBend",
+				"VuoMultisample", "VuoBaudRate", "VuoParity",
+				"VuoOscInputDevice", "VuoOscOutputDevice",
+				"VuoRange",
+				"VuoRectangle",
+				"VuoRelativeTime", "VuoRoundingMethod",
+				"VuoSerialDevice", "VuoVertexAttribute", "VuoSyphonServerDescription",
+				"VuoTempoRange", "VuoNumberFormat", "VuoMovieFormat",
+				"VuoVideoFrame", "VuoVideoInputDevice",
+				"VuoTime", "VuoTimeUnit", "VuoTimeFormat", "VuoWeekday",
+				"VuoHorizontalAlignment", "VuoVerticalAlignment", "VuoAnchor",
+			],
+		},
+	},
+});
+
+void nodeEvent
+(
+	VuoInputData(VuoList_VuoGenericType1) list1,
+	VuoInputData(VuoList_VuoGenericType1) list2,
+	VuoOutputData(VuoList_VuoGenericType1) unionList
+)
+{
+	*unionList = VuoListUnion_VuoGenericType1(list1, list2);
+}
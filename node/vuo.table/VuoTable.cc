@@ -7,13 +7,24 @@
  * For more information, see https://vuo.org/license.
  */
 
+#include <atomic>
+#include <cmath>
+#include <dispatch/dispatch.h>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <xlocale.h>
 using namespace std;
 
 extern "C"
 {
 #include "VuoTable.h"
+#include "VuoReal.h"
 #include "VuoTime.h"
 
 #include <csv.h>
@@ -41,13 +52,367 @@ VuoModuleMetadata({
 }
 
 /**
- * Deallocates a `vector< vector<VuoText> > *`.
+ * Returns a locale in which numbers are formatted the same as in JSON.
+ */
+static locale_t VuoTable_getCLocale(void)
+{
+	static locale_t locale = newlocale(LC_NUMERIC_MASK, "C", NULL);
+	return locale;
+}
+
+/**
+ * If @a text (@a byteCount bytes, not necessarily null-terminated) is a plain JSON number, outputs its value and returns true.
+ *
+ * The output value is the same as `VuoMakeRetainedFromString(text, VuoReal)`, but is calculated without creating a JSON object.
+ * Integers with leading zeros or more than 18 digits are rejected, so that the JSON parser's handling of them is used instead.
+ */
+static bool VuoTable_parsePlainNumber(const char *text, size_t byteCount, double &value)
+{
+	const size_t maxByteCount = 63;
+	if (byteCount == 0 || byteCount > maxByteCount)
+		return false;
+
+	size_t i = 0;
+	if (text[i] == '-')
+		++i;
+
+	size_t integerStart = i;
+	while (i < byteCount && isdigit(text[i]))
+		++i;
+	size_t integerDigits = i - integerStart;
+	if (integerDigits == 0 || (integerDigits > 1 && text[integerStart] == '0'))
+		return false;
+
+	bool isInteger = true;
+	if (i < byteCount && text[i] == '.')
+	{
+		size_t fractionStart = ++i;
+		while (i < byteCount && isdigit(text[i]))
+			++i;
+		if (i == fractionStart)
+			return false;
+		isInteger = false;
+	}
+
+	if (i < byteCount && (text[i] == 'e' || text[i] == 'E'))
+	{
+		++i;
+		if (i < byteCount && (text[i] == '+' || text[i] == '-'))
+			++i;
+		size_t exponentStart = i;
+		while (i < byteCount && isdigit(text[i]))
+			++i;
+		if (i == exponentStart)
+			return false;
+		isInteger = false;
+	}
+
+	if (i != byteCount || (isInteger && integerDigits > 18))
+		return false;
+
+	char buffer[maxByteCount + 1];
+	memcpy(buffer, text, byteCount);
+	buffer[byteCount] = 0;
+
+	if (isInteger)
+		value = strtoll(buffer, NULL, 10);
+	else
+		value = strtod_l(buffer, NULL, VuoTable_getCLocale());
+	return true;
+}
+
+/**
+ * Marks a null item in @ref VuoTableColumn::offsets.
+ */
+static const size_t VuoTable_nullItem = SIZE_MAX;
+
+/**
+ * One column of a table's data.
+ *
+ * The text of all the column's items is stored back to back in a single arena,
+ * rather than as separately allocated and registered VuoText values.
+ * If the column contains only numbers (optionally with a header in the first row), the numbers are also
+ * parsed once when the column is built, so that sorting doesn't need to parse the text again.
+ *
+ * A column isn't modified after it's been added to a table, so tables derived from one another share unchanged columns.
+ * Rows beyond the end of the column are treated as null items.
+ */
+class VuoTableColumn
+{
+public:
+	VuoTableColumn(void)
+	{
+		isNumeric = true;
+	}
+
+	~VuoTableColumn(void)
+	{
+		if (items)
+			for (size_t i = 0; i < offsets.size(); ++i)
+				VuoRelease(items[i].load());
+	}
+
+	/**
+	 * Returns the number of items in the column.
+	 */
+	size_t getRowCount(void) const
+	{
+		return offsets.size();
+	}
+
+	/**
+	 * Returns the text of the item at @a row (indexed from 0), or NULL if the item is empty or beyond the end of the column.
+	 *
+	 * The returned pointer is into the column's arena — it isn't registered with VuoHeap.
+	 */
+	const char *getText(size_t row) const
+	{
+		if (row >= offsets.size() || offsets[row] == VuoTable_nullItem)
+			return NULL;
+
+		return arena.data() + offsets[row];
+	}
+
+	/**
+	 * Returns the item at @a row (indexed from 0) as a VuoText, or NULL if the item is empty or beyond the end of the column.
+	 *
+	 * The VuoText is created the first time it's requested, and retained by the column until the column is destroyed.
+	 */
+	VuoText getVuoText(size_t row) const
+	{
+		const char *text = getText(row);
+		if (! text)
+			return NULL;
+
+		call_once(itemsCreated, [this]{
+			items.reset(new atomic<VuoText>[offsets.size()]());
+		});
+
+		VuoText item = items[row].load();
+		if (item)
+			return item;
+
+		VuoText newItem = VuoText_make(text);
+		VuoRetain(newItem);
+		if (items[row].compare_exchange_strong(item, newItem))
+			return newItem;
+
+		// Another thread got there first.
+		VuoRelease(newItem);
+		return item;
+	}
+
+	/**
+	 * Returns the numeric value of the item at @a row (indexed from 0), as used by @ref VuoTextSort_Number.
+	 */
+	double getNumber(size_t row) const
+	{
+		if (row < numbers.size() && ! isnan(numbers[row]))
+			return numbers[row];
+
+		const char *text = getText(row);
+		return VuoMakeRetainedFromString(text, VuoReal);
+	}
+
+	/**
+	 * Adds an item with @a byteCount bytes of @a text (not necessarily null-terminated) to the end of the column.
+	 */
+	void appendText(const char *text, size_t byteCount)
+	{
+		offsets.push_back(arena.size());
+		arena.insert(arena.end(), text, text + byteCount);
+		arena.push_back(0);
+
+		if (isNumeric)
+		{
+			double value;
+			if (! VuoTable_parsePlainNumber(text, byteCount, value))
+				value = NAN;
+			appendNumber(value);
+		}
+	}
+
+	/**
+	 * Adds @a text (which may be NULL) to the end of the column.
+	 */
+	void append(const char *text)
+	{
+		if (text)
+			appendText(text, strlen(text));
+		else
+			appendNull();
+	}
+
+	/**
+	 * Adds an empty item to the end of the column.
+	 */
+	void appendNull(void)
+	{
+		offsets.push_back(VuoTable_nullItem);
+
+		// Same as `VuoMakeRetainedFromString(NULL, VuoReal)`.
+		if (isNumeric)
+			appendNumber(0);
+	}
+
+	/**
+	 * Adds a copy of the item at @a sourceRow in @a source to the end of the column,
+	 * reusing its numeric value if it has already been parsed.
+	 */
+	void appendItem(const VuoTableColumn *source, size_t sourceRow)
+	{
+		const char *text = source ? source->getText(sourceRow) : NULL;
+		if (! text)
+		{
+			appendNull();
+			return;
+		}
+
+		if (! isNumeric || sourceRow >= source->numbers.size() || isnan(source->numbers[sourceRow]))
+		{
+			appendText(text, strlen(text));
+			return;
+		}
+
+		size_t byteCount = strlen(text);
+		offsets.push_back(arena.size());
+		arena.insert(arena.end(), text, text + byteCount + 1);
+		appendNumber(source->numbers[sourceRow]);
+	}
+
+	/**
+	 * Adds copies of the @a count items starting at @a firstRow in @a source to the end of the column.
+	 */
+	void appendItems(const VuoTableColumn *source, size_t firstRow, size_t count)
+	{
+		for (size_t i = firstRow; i < firstRow + count; ++i)
+			appendItem(source, i);
+	}
+
+	/**
+	 * Adds all of @a source's items to the end of the column.
+	 */
+	void appendColumn(const VuoTableColumn &source)
+	{
+		size_t arenaStart = arena.size();
+		arena.insert(arena.end(), source.arena.begin(), source.arena.end());
+
+		offsets.reserve(offsets.size() + source.offsets.size());
+		for (size_t offset : source.offsets)
+			offsets.push_back(offset == VuoTable_nullItem ? VuoTable_nullItem : arenaStart + offset);
+
+		if (isNumeric && ! source.isNumeric)
+		{
+			isNumeric = false;
+			vector<double>().swap(numbers);
+		}
+		for (size_t i = 0; isNumeric && i < source.numbers.size(); ++i)
+			appendNumber(source.numbers[i]);
+	}
+
+	/**
+	 * Adds empty items to the end of the column until it has @a rowCount items.
+	 */
+	void padToRowCount(size_t rowCount)
+	{
+		while (offsets.size() < rowCount)
+			appendNull();
+	}
+
+private:
+	vector<char> arena;  ///< The text of each non-empty item, null-terminated, back to back.
+	vector<size_t> offsets;  ///< For each row, the position in @ref arena where the item's text starts, or @ref VuoTable_nullItem.
+
+	/**
+	 * If @ref isNumeric, the numeric value of each item, or NAN if the item isn't a plain number (only allowed in the first row).
+	 */
+	vector<double> numbers;
+	bool isNumeric;  ///< True if each item after the first row is either empty or a plain number.
+
+	mutable once_flag itemsCreated;  ///< Guards the creation of @ref items.
+	mutable unique_ptr<atomic<VuoText>[]> items;  ///< The VuoText for each item that has been returned by @ref getVuoText, or NULL.
+
+	/**
+	 * Records the numeric value of the item just added, or stops tracking numeric values if the column isn't numeric.
+	 */
+	void appendNumber(double value)
+	{
+		if (isnan(value) && ! numbers.empty())
+		{
+			isNumeric = false;
+			vector<double>().swap(numbers);
+			return;
+		}
+
+		numbers.push_back(value);
+	}
+};
+
+/**
+ * A table's data: the columns, including headers.
+ */
+typedef vector< shared_ptr<const VuoTableColumn> > VuoTableColumns;
+
+/**
+ * Deallocates a `VuoTableColumns *`.
  */
 static void deleteData(void *data)
 {
-	delete (vector< vector<VuoText> > *)data;
+	delete (VuoTableColumns *)data;
+}
+
+/**
+ * Returns a table that takes ownership of @a columns.
+ */
+static VuoTable VuoTable_makeFromColumns(VuoTableColumns *columns, size_t rowCount)
+{
+	VuoTable table = { columns, rowCount, columns->size() };
+	VuoRegister(table.data, deleteData);
+	return table;
+}
+
+/**
+ * Returns a copy of @a table's list of columns (sharing the columns themselves), with exactly `table.columnCount` columns.
+ */
+static VuoTableColumns *VuoTable_copyColumns(VuoTable table)
+{
+	VuoTableColumns *columns = new VuoTableColumns(*(VuoTableColumns *)table.data);
+	if (columns->size() < table.columnCount)
+		columns->resize(table.columnCount, make_shared<VuoTableColumn>());
+	return columns;
+}
+
+/**
+ * Returns @a table's column at @a columnIndex (indexed from 0), or NULL if there's no such column.
+ */
+static const VuoTableColumn *VuoTable_getColumnData(VuoTable table, size_t columnIndex)
+{
+	VuoTableColumns *columns = (VuoTableColumns *)table.data;
+	if (columnIndex >= columns->size())
+		return NULL;
+
+	return (*columns)[columnIndex].get();
+}
+
+/**
+ * Returns the text of the item at @a rowIndex and @a columnIndex (both indexed from 0), or NULL if the item is empty.
+ *
+ * The returned pointer is into the column's arena — it isn't registered with VuoHeap.
+ */
+static const char *VuoTable_getText(VuoTable table, size_t rowIndex, size_t columnIndex)
+{
+	const VuoTableColumn *column = VuoTable_getColumnData(table, columnIndex);
+	return column ? column->getText(rowIndex) : NULL;
 }
 
+/**
+ * Returns the item at @a rowIndex and @a columnIndex (both indexed from 0), or NULL if the item is empty.
+ */
+static VuoText VuoTable_getVuoText(VuoTable table, size_t rowIndex, size_t columnIndex)
+{
+	const VuoTableColumn *column = VuoTable_getColumnData(table, columnIndex);
+	return column ? column->getVuoText(rowIndex) : NULL;
+}
 
 /**
  * Decodes the JSON object @a js to create a new value.
@@ -62,7 +427,7 @@ VuoTable VuoTable_makeFromJson(struct json_object *js)
 		table.data = (void *)json_object_get_int64(o);
 		if (! table.data)
 		{
-			table.data = new vector< vector<VuoText> >;
+			table.data = new VuoTableColumns;
 			VuoRegister(table.data, deleteData);
 		}
 
@@ -129,8 +494,6 @@ struct json_object * VuoTable_getInterprocessJson(const VuoTable value)
  */
 char * VuoTable_getSummary(const VuoTable value)
 {
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)value.data;
-
 	const size_t maxTableRows = 4;     // not counting ellipsis
 	const size_t maxTableColumns = 4;  //
 
@@ -143,9 +506,9 @@ char * VuoTable_getSummary(const VuoTable value)
 
 		for (size_t j = 0; j < value.columnCount && j < maxTableColumns; ++j)
 		{
-			const char *dataValue = "";
-			if (i < (*data).size() && j < (*data)[i].size() && (*data)[i][j])
-				dataValue = (*data)[i][j];
+			const char *dataValue = VuoTable_getText(value, i, j);
+			if (! dataValue)
+				dataValue = "";
 			oss << "<td>" << dataValue << "</td>";
 		}
 
@@ -175,9 +538,7 @@ char * VuoTable_getSummary(const VuoTable value)
  */
 VuoTable VuoTable_makeEmpty(void)
 {
-	VuoTable table = { new vector< vector<VuoText> >, 0, 0 };
-	VuoRegister(table.data, deleteData);
-	return table;
+	return VuoTable_makeFromColumns(new VuoTableColumns, 0);
 }
 
 
@@ -191,41 +552,82 @@ public:
 	/**
 	 * Parsing state.
 	 */
-	vector< vector<VuoText> > *tableData;
+	vector< shared_ptr<VuoTableColumn> > columns;
+	size_t rowCount;
+	size_t columnIndex;
+	size_t recordCount;
 	bool atFirstColumn;
+	bool skippingRecord;
 	///@}
 
-	bool taken;  ///< If true, this class has surrendered ownership of data.
+	///@{
+	/**
+	 * The range of records (indexed from 0, inclusive) to keep. Items in other records are skipped.
+	 */
+	size_t firstRecord;
+	size_t lastRecord;
+	///@}
 
 	ParserContext(void)
 	{
-		tableData = new vector< vector<VuoText> >;
+		rowCount = 0;
+		columnIndex = 0;
+		recordCount = 0;
 		atFirstColumn = true;
-		taken = false;
+		skippingRecord = false;
+		firstRecord = 0;
+		lastRecord = SIZE_MAX;
 	}
 
-	~ParserContext(void)
+	/**
+	 * Returns true if all records in the requested range have been parsed.
+	 */
+	bool isDone(void) const
 	{
-		if (! taken)
-			delete tableData;
+		if (lastRecord == SIZE_MAX)
+			return false;
+
+		return recordCount > lastRecord + 1 || (recordCount == lastRecord + 1 && atFirstColumn);
 	}
 };
 
 /**
  * Helper for VuoTable_makeFromText(). Callback for when the parser has gotten a single item of table data.
+ *
+ * Appends the item directly to its column's arena, rather than creating a VuoText for it.
  */
 static void parserGotItem(void *item, size_t numBytes, void *userData)
 {
-	VuoText itemText = VuoText_makeFromData((unsigned char *)item, numBytes);
 	ParserContext *ctx = (ParserContext *)userData;
 
 	if (ctx->atFirstColumn)
 	{
-		ctx->tableData->push_back( vector<VuoText>() );
+		size_t record = ctx->recordCount++;
+		ctx->skippingRecord = (record < ctx->firstRecord || record > ctx->lastRecord);
+		if (! ctx->skippingRecord)
+			++ctx->rowCount;
+		ctx->columnIndex = 0;
 		ctx->atFirstColumn = false;
 	}
 
-	ctx->tableData->back().push_back(itemText);
+	if (ctx->skippingRecord)
+		return;
+
+	if (ctx->columnIndex == ctx->columns.size())
+		ctx->columns.push_back(make_shared<VuoTableColumn>());
+
+	// Fill in any previous rows that were too short to reach this column.
+	VuoTableColumn *column = ctx->columns[ctx->columnIndex].get();
+	column->padToRowCount(ctx->rowCount - 1);
+
+	// Same conversion as VuoText_makeFromData().
+	const char *text = (const char *)item;
+	if (numBytes && VuoText_isValidUtf8((const unsigned char *)text, numBytes))
+		column->appendText(text, strnlen(text, numBytes));
+	else
+		column->appendNull();
+
+	++ctx->columnIndex;
 }
 
 /**
@@ -359,9 +761,13 @@ static char VuoTable_guessSeparator(VuoText &text, size_t &numBytes, VuoTableFor
 }
 
 /**
- * Returns a table parsed from @a text, a CSV- or TSV-formatted string.
+ * Helper for VuoTable_makeFromText(). Parses @a numBytes of @a text into @a ctx.
+ *
+ * The text is fed to the parser in blocks, so that parsing can stop early once @a ctx has all the records it needs.
+ *
+ * Returns false (and logs the error) if the text couldn't be parsed.
  */
-VuoTable VuoTable_makeFromText(VuoText text, VuoTableFormat format)
+static bool VuoTable_parse(const char *text, size_t numBytes, char separator, ParserContext &ctx)
 {
 	struct csv_parser parser;
 	unsigned char options = CSV_APPEND_NULL;
@@ -370,21 +776,22 @@ VuoTable VuoTable_makeFromText(VuoText text, VuoTableFormat format)
 	if (ret)
 	{
 		VUserLog("Error: Couldn't initialize CSV/TSV parser.");
-		return VuoTable_makeEmpty();
+		return false;
 	}
 
-	size_t numBytes = VuoText_byteCount(text);
-
-	csv_set_delim(&parser, VuoTable_guessSeparator(text, numBytes, format));
+	csv_set_delim(&parser, separator);
 
-	ParserContext ctx;
-
-	size_t numBytesParsed = csv_parse(&parser, text, numBytes, parserGotItem, parserGotLine, &ctx);
-	if (numBytesParsed != numBytes)
+	const size_t blockBytes = 1024 * 1024;
+	for (size_t offset = 0; offset < numBytes && ! ctx.isDone(); offset += blockBytes)
 	{
-		VUserLog("Error: Couldn't parse CSV/TSV text: %s", csv_strerror(csv_error(&parser)));
-		csv_free(&parser);
-		return VuoTable_makeEmpty();
+		size_t numBytesToParse = MIN(blockBytes, numBytes - offset);
+		size_t numBytesParsed = csv_parse(&parser, text + offset, numBytesToParse, parserGotItem, parserGotLine, &ctx);
+		if (numBytesParsed != numBytesToParse)
+		{
+			VUserLog("Error: Couldn't parse CSV/TSV text: %s", csv_strerror(csv_error(&parser)));
+			csv_free(&parser);
+			return false;
+		}
 	}
 
 	ret = csv_fini(&parser, parserGotItem, parserGotLine, &ctx);
@@ -392,20 +799,188 @@ VuoTable VuoTable_makeFromText(VuoText text, VuoTableFormat format)
 	{
 		VUserLog("Error: Couldn't parse CSV/TSV text (or finalize parser): %s", csv_strerror(csv_error(&parser)));
 		csv_free(&parser);
-		return VuoTable_makeEmpty();
+		return false;
 	}
 
 	csv_free(&parser);
-	ctx.taken = true;
+	return true;
+}
 
-	size_t rowCount = ctx.tableData->size();
-	size_t columnCount = 0;
-	for (vector< vector<VuoText> >::iterator i = ctx.tableData->begin(); i != ctx.tableData->end(); ++i)
-		columnCount = MAX((*i).size(), columnCount);
+/**
+ * Helper for VuoTable_makeFromData(). Returns the positions in @a text at which to split it into roughly @a chunkCount chunks
+ * for parsing in parallel, including 0 and @a numBytes.
+ *
+ * Each position is at the start of a record — not within a quoted item that contains a line break —
+ * following the same quoting rules as libcsv.
+ */
+static vector<size_t> VuoTable_findChunkBoundaries(const char *text, size_t numBytes, char separator, size_t chunkCount)
+{
+	vector<size_t> boundaries(1, 0);
+	size_t chunkBytes = numBytes / chunkCount + 1;
+	size_t nextBoundary = chunkBytes;
 
-	VuoTable table = { (void *)ctx.tableData, rowCount, columnCount };
-	VuoRegister(table.data, deleteData);
-	return table;
+	enum { FieldStart, Unquoted, Quoted, QuoteInQuoted } state = FieldStart;
+	for (size_t i = 0; i < numBytes; ++i)
+	{
+		char c = text[i];
+		bool isLineEnd = (c == '\n' || c == '\r');
+
+		switch (state)
+		{
+			case FieldStart:
+				if (c == '"')
+					state = Quoted;
+				else if (c != separator && ! isLineEnd && c != ' ' && c != '\t')
+					state = Unquoted;
+				break;
+
+			case Unquoted:
+				if (c == separator || isLineEnd)
+					state = FieldStart;
+				break;
+
+			case Quoted:
+				if (c == '"')
+					state = QuoteInQuoted;
+				isLineEnd = false;
+				break;
+
+			case QuoteInQuoted:
+				// libcsv allows whitespace between the closing quote and the separator,
+				// and treats any other character following a quote as part of the quoted item.
+				if (c == separator || isLineEnd)
+					state = FieldStart;
+				else if (c != ' ' && c != '\t')
+					state = Quoted;
+				break;
+		}
+
+		if (isLineEnd && state == FieldStart && i + 1 >= nextBoundary && i + 1 < numBytes)
+		{
+			boundaries.push_back(i + 1);
+			nextBoundary = i + 1 + chunkBytes;
+		}
+	}
+
+	boundaries.push_back(numBytes);
+	return boundaries;
+}
+
+/**
+ * Returns a table parsed from @a text, a CSV- or TSV-formatted string.
+ */
+VuoTable VuoTable_makeFromText(VuoText text, VuoTableFormat format)
+{
+	return VuoTable_makeFromData(text, VuoText_byteCount(text), format, 1, VuoTable_NoLastRow);
+}
+
+/**
+ * Returns a table parsed from the first @a numBytes of @a data, CSV- or TSV-formatted text.
+ *
+ * Only rows @a firstRow through @a lastRow (indexed from 1, inclusive) are included in the table.
+ * Parsing stops after @a lastRow, so the rest of @a data isn't read.
+ * To include all rows, pass 1 and @ref VuoTable_NoLastRow.
+ *
+ * When parsing all rows of a large text, the text is split into chunks at record boundaries, and the chunks are parsed in parallel.
+ */
+VuoTable VuoTable_makeFromData(const void *data, size_t numBytes, VuoTableFormat format, VuoInteger firstRow, VuoInteger lastRow)
+{
+	if (! data || numBytes == 0 || lastRow < 1 || lastRow < firstRow)
+		return VuoTable_makeEmpty();
+
+	VuoText text = (VuoText)data;
+	char separator = VuoTable_guessSeparator(text, numBytes, format);
+
+	size_t firstRecord = MAX(firstRow, 1) - 1;
+	size_t lastRecord = (lastRow == VuoTable_NoLastRow ? SIZE_MAX : lastRow - 1);
+
+	// Parsing a range of rows has to proceed from the beginning, since records can't be counted without parsing.
+	const size_t minChunkBytes = 4 * 1024 * 1024;
+	size_t chunkCount = 1;
+	if (firstRecord == 0 && lastRecord == SIZE_MAX)
+		chunkCount = MAX(1, MIN(numBytes / minChunkBytes, (size_t)sysconf(_SC_NPROCESSORS_ONLN)));
+
+	vector<size_t> boundaries = (chunkCount > 1
+								 ? VuoTable_findChunkBoundaries(text, numBytes, separator, chunkCount)
+								 : vector<size_t>({0, numBytes}));
+	chunkCount = boundaries.size() - 1;
+
+	vector<ParserContext> contexts(chunkCount);
+	contexts[0].firstRecord = firstRecord;
+	contexts[0].lastRecord = lastRecord;
+
+	__block bool succeeded = true;
+	ParserContext *contextsData = contexts.data();
+	size_t *boundariesData = boundaries.data();
+	dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i){
+		if (! VuoTable_parse(text + boundariesData[i], boundariesData[i+1] - boundariesData[i], separator, contextsData[i]))
+			succeeded = false;
+	});
+	if (! succeeded)
+		return VuoTable_makeEmpty();
+
+	if (chunkCount == 1)
+		return VuoTable_makeFromColumns(new VuoTableColumns(contexts[0].columns.begin(), contexts[0].columns.end()), contexts[0].rowCount);
+
+	// Concatenate the chunks' columns, freeing each chunk as soon as it's been copied.
+	vector< shared_ptr<VuoTableColumn> > columns;
+	size_t rowCount = 0;
+	for (ParserContext &ctx : contexts)
+	{
+		for (size_t j = 0; j < ctx.columns.size(); ++j)
+		{
+			if (j == columns.size())
+				columns.push_back(make_shared<VuoTableColumn>());
+
+			columns[j]->padToRowCount(rowCount);
+			columns[j]->appendColumn(*ctx.columns[j]);
+			ctx.columns[j].reset();
+		}
+		rowCount += ctx.rowCount;
+	}
+
+	return VuoTable_makeFromColumns(new VuoTableColumns(columns.begin(), columns.end()), rowCount);
+}
+
+/**
+ * Returns a table parsed from the CSV- or TSV-formatted file at @a path (a POSIX path).
+ *
+ * The file is memory-mapped rather than read into a buffer, so the only memory that stays in use
+ * is the table itself. See @ref VuoTable_makeFromData for the meaning of @a firstRow and @a lastRow.
+ */
+VuoTable VuoTable_makeFromFile(const char *path, VuoTableFormat format, VuoInteger firstRow, VuoInteger lastRow)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		VUserLog("Error: Couldn't open \"%s\": %s", path, strerror(errno));
+		return VuoTable_makeEmpty();
+	}
+	VuoDefer(^{ close(fd); });
+
+	struct stat s;
+	if (fstat(fd, &s) != 0)
+	{
+		VUserLog("Error: Couldn't get the size of \"%s\": %s", path, strerror(errno));
+		return VuoTable_makeEmpty();
+	}
+
+	size_t numBytes = s.st_size;
+	if (numBytes == 0)
+		return VuoTable_makeEmpty();
+
+	void *data = mmap(NULL, numBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED)
+	{
+		VUserLog("Error: Couldn't map \"%s\" into memory: %s", path, strerror(errno));
+		return VuoTable_makeEmpty();
+	}
+	VuoDefer(^{ munmap(data, numBytes); });
+
+	// Each page is only read once, so let the kernel read ahead and drop pages that have been parsed.
+	madvise(data, numBytes, MADV_SEQUENTIAL);
+
+	return VuoTable_makeFromData(data, numBytes, format, firstRow, lastRow);
 }
 
 
@@ -414,30 +989,22 @@ VuoTable VuoTable_makeFromText(VuoText text, VuoTableFormat format)
  */
 VuoText VuoTable_serialize(VuoTable table, VuoTableFormat format)
 {
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)table.data;
-
 	// Calculate the sizes of the strings to be written.
 
-	vector< vector<size_t> > srcBytesForData( (*data).size() );
-	vector< vector<size_t> > dstBytesForData( (*data).size() );
+	size_t itemCount = table.rowCount * table.columnCount;
+	vector<size_t> srcBytesForData(itemCount);
+	vector<size_t> dstBytesForData(itemCount);
 	size_t dstBytesTotal = 0;
 
 	for (size_t i = 0; i < table.rowCount; ++i)
 	{
-		if (i < (*data).size())
-		{
-			srcBytesForData[i].resize( (*data)[i].size() );
-			dstBytesForData[i].resize( (*data)[i].size() );
-		}
-
 		for (size_t j = 0; j < table.columnCount; ++j)
 		{
-			if (i < (*data).size() && j < (*data)[i].size())
-			{
-				srcBytesForData[i][j] = VuoText_byteCount( (*data)[i][j] );
-				dstBytesForData[i][j] = csv_write(NULL, 0, (*data)[i][j], srcBytesForData[i][j]);
-				dstBytesTotal += dstBytesForData[i][j];
-			}
+			size_t k = i * table.columnCount + j;
+			const char *item = VuoTable_getText(table, i, j);
+			srcBytesForData[k] = item ? strlen(item) : 0;
+			dstBytesForData[k] = csv_write(NULL, 0, item, srcBytesForData[k]);
+			dstBytesTotal += dstBytesForData[k];
 
 			++dstBytesTotal;  // delimiter or newline
 		}
@@ -448,18 +1015,16 @@ VuoText VuoTable_serialize(VuoTable table, VuoTableFormat format)
 	char delimiter = (format == VuoTableFormat_Tsv ? CSV_TAB : CSV_COMMA);
 	char newline = '\n';
 
-	char *dst = (char *)malloc(dstBytesTotal);
+	char *dst = (char *)malloc(dstBytesTotal + 1);
 	char *dstPtr = dst;
 
 	for (size_t i = 0; i < table.rowCount; ++i)
 	{
 		for (size_t j = 0; j < table.columnCount; ++j)
 		{
-			if (i < (*data).size() && j < (*data)[i].size())
-			{
-				size_t numBytesWritten = csv_write(dstPtr, dstBytesForData[i][j], (*data)[i][j], srcBytesForData[i][j]);
-				dstPtr += numBytesWritten;
-			}
+			size_t k = i * table.columnCount + j;
+			size_t numBytesWritten = csv_write(dstPtr, dstBytesForData[k], VuoTable_getText(table, i, j), srcBytesForData[k]);
+			dstPtr += numBytesWritten;
 
 			*dstPtr = (j+1 < table.columnCount ? delimiter : newline);
 			++dstPtr;
@@ -483,21 +1048,14 @@ static VuoInteger getIndexForHeader(VuoTable table, VuoText header, bool isColum
 	if (VuoText_isEmpty(header))
 		return 0;
 
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)table.data;
-
 	VuoTextComparison containsCaseInsensitive = {VuoTextComparison_Contains, false};
 
-	if (isColumnHeader)
-	{
-		for (size_t i = 0; i < table.columnCount; ++i)
-			if (! (*data).empty() && i < (*data)[0].size() && VuoText_compare((*data)[0][i], containsCaseInsensitive, header))
-				return i+1;
-	}
-	else
+	size_t count = (isColumnHeader ? table.columnCount : table.rowCount);
+	for (size_t i = 0; i < count; ++i)
 	{
-		for (size_t i = 0; i < table.rowCount; ++i)
-			if (i < (*data).size() && ! (*data)[i].empty() && VuoText_compare((*data)[i][0], containsCaseInsensitive, header))
-				return i+1;
+		const char *item = (isColumnHeader ? VuoTable_getText(table, 0, i) : VuoTable_getText(table, i, 0));
+		if (item && VuoText_compare(item, containsCaseInsensitive, header))
+			return i+1;
 	}
 
 	return 0;
@@ -515,39 +1073,17 @@ static VuoInteger getClampedIndex(VuoTable table, VuoInteger index, bool isColum
 
 /**
  * Helper for `VuoTable_sort_VuoInteger()`.
+ *
+ * Sorts @a rows (indexed from 0) by the value of @a keys for each row.
  */
-struct ColumnSort
+template<typename T, typename LessThan>
+static void sortRows(vector<size_t> &rows, const vector<T> &keys, VuoSortOrder sortOrder, LessThan isLessThan)
 {
-	///@{
-	/**
-	 * Sort parameters used by `operator()`.
-	 */
-	VuoTextSort sortType;
-	VuoSortOrder sortOrder;
-	///@}
-
-	/**
-	 * Returns true if the text in @a first comes before the text in @a second in sorted order.
-	 */
-	bool operator() (pair<size_t, VuoText> first, pair<size_t, VuoText> second)
-	{
-		if (sortOrder == VuoSortOrder_Descending)
-			swap(first, second);
-
-		if (sortType == VuoTextSort_TextCaseSensitive)
-			return VuoText_isLessThan(first.second, second.second);
-		else if (sortType == VuoTextSort_Number)
-			return VuoText_isLessThanNumeric(first.second, second.second);
-		else if (sortType == VuoTextSort_Date)
-		{
-			VuoTime firstTime = VuoTime_makeFromUnknownFormat(first.second);
-			VuoTime secondTime = VuoTime_makeFromUnknownFormat(second.second);
-			return VuoTime_isLessThan(firstTime, secondTime);
-		}
-		else
-			return VuoText_isLessThanCaseInsensitive(first.second, second.second);
-	}
-};
+	if (sortOrder == VuoSortOrder_Descending)
+		stable_sort(rows.begin(), rows.end(), [&](size_t first, size_t second){ return isLessThan(keys[second], keys[first]); });
+	else
+		stable_sort(rows.begin(), rows.end(), [&](size_t first, size_t second){ return isLessThan(keys[first], keys[second]); });
+}
 
 /**
  * Sorts the table's rows based on the values in the given column.
@@ -564,37 +1100,57 @@ VuoTable VuoTable_sort_VuoInteger(VuoTable table, VuoInteger columnIndex, VuoTex
 	columnIndex = getClampedIndex(table, columnIndex, true);  // indexed from 1
 	size_t firstDataRow = (firstRowIsHeader ? 1 : 0);  // indexed from 0
 
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)table.data;
+	const VuoTableColumn *keyColumn = VuoTable_getColumnData(table, columnIndex-1);
 
-	vector< pair<size_t, VuoText> > keyColumn;
+	vector<size_t> rows;
 	for (size_t i = firstDataRow; i < table.rowCount; ++i)
+		rows.push_back(i);
+
+	// Convert each item in the key column once, rather than once per comparison.
+	if (sortType == VuoTextSort_Number)
 	{
-		if (i < (*data).size() && columnIndex-1 < (*data)[i].size())
-			keyColumn.push_back( make_pair(i, (*data)[i][columnIndex-1]) );
-		else
-			keyColumn.push_back( make_pair(i, "") );
+		vector<double> keys(table.rowCount, 0);
+		if (keyColumn)
+			for (size_t i = firstDataRow; i < table.rowCount; ++i)
+				keys[i] = keyColumn->getNumber(i);
+
+		sortRows(rows, keys, sortOrder, [](double first, double second){ return first < second; });
 	}
+	else if (sortType == VuoTextSort_Date)
+	{
+		vector<VuoTime> keys(table.rowCount);
+		for (size_t i = firstDataRow; i < table.rowCount; ++i)
+			keys[i] = VuoTime_makeFromUnknownFormat(keyColumn ? keyColumn->getText(i) : NULL);
 
-	ColumnSort columnSort;
-	columnSort.sortType = sortType;
-	columnSort.sortOrder = sortOrder;
-	stable_sort(keyColumn.begin(), keyColumn.end(), columnSort);
+		sortRows(rows, keys, sortOrder, VuoTime_isLessThan);
+	}
+	else
+	{
+		vector<const char *> keys(table.rowCount);
+		if (keyColumn)
+			for (size_t i = firstDataRow; i < table.rowCount; ++i)
+				keys[i] = keyColumn->getText(i);
 
-	if (firstRowIsHeader)
-		keyColumn.insert(keyColumn.begin(), make_pair(0, "") );
+		if (sortType == VuoTextSort_TextCaseSensitive)
+			sortRows(rows, keys, sortOrder, VuoText_isLessThan);
+		else
+			sortRows(rows, keys, sortOrder, VuoText_isLessThanCaseInsensitive);
+	}
 
-	vector< vector<VuoText> > *sortedData = new vector< vector<VuoText> >(table.rowCount);
-	for (size_t i = 0; i < table.rowCount; ++i)
-		(*sortedData)[i].resize(table.columnCount);
+	if (firstRowIsHeader && table.rowCount > 0)
+		rows.insert(rows.begin(), 0);
 
-	for (size_t i = 0; i < table.rowCount; ++i)
-		for (size_t j = 0; j < table.columnCount; ++j)
-			if (i < (*data).size() && j < (*data)[i].size())
-				(*sortedData)[i][j] = (*data)[ keyColumn[i].first ][j];
+	VuoTableColumns *sortedColumns = new VuoTableColumns;
+	for (size_t j = 0; j < table.columnCount; ++j)
+	{
+		const VuoTableColumn *column = VuoTable_getColumnData(table, j);
+		shared_ptr<VuoTableColumn> sortedColumn = make_shared<VuoTableColumn>();
+		for (size_t i = 0; i < rows.size(); ++i)
+			sortedColumn->appendItem(column, rows[i]);
+		sortedColumns->push_back(sortedColumn);
+	}
 
-	VuoTable sortedTable = { sortedData, table.rowCount, table.columnCount };
-	VuoRegister(sortedData, deleteData);
-	return sortedTable;
+	return VuoTable_makeFromColumns(sortedColumns, table.rowCount);
 }
 
 /**
@@ -618,20 +1174,16 @@ VuoTable VuoTable_sort_VuoText(VuoTable table, VuoText columnHeader, VuoTextSort
  */
 VuoTable VuoTable_transpose(VuoTable table)
 {
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)table.data;
-
-	vector< vector<VuoText> > *transposedData = new vector< vector<VuoText> >(table.columnCount);
-	for (size_t i = 0; i < table.columnCount; ++i)
-		(*transposedData)[i].resize(table.rowCount);
-
+	VuoTableColumns *transposedColumns = new VuoTableColumns;
 	for (size_t i = 0; i < table.rowCount; ++i)
+	{
+		shared_ptr<VuoTableColumn> transposedColumn = make_shared<VuoTableColumn>();
 		for (size_t j = 0; j < table.columnCount; ++j)
-			if (i < (*data).size() && j < (*data)[i].size())
-				(*transposedData)[j][i] = (*data)[i][j];
+			transposedColumn->appendItem(VuoTable_getColumnData(table, j), i);
+		transposedColumns->push_back(transposedColumn);
+	}
 
-	VuoTable transposedTable = { transposedData, table.columnCount, table.rowCount };
-	VuoRegister(transposedData, deleteData);
-	return transposedTable;
+	return VuoTable_makeFromColumns(transposedColumns, table.columnCount);
 }
 
 
@@ -644,8 +1196,6 @@ VuoList_VuoText VuoTable_getRow_VuoInteger(VuoTable table, VuoInteger rowIndex,
 	if (table.rowCount == 0)
 		return VuoListCreate_VuoText();
 
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)table.data;
-
 	rowIndex = getClampedIndex(table, rowIndex, false);
 
 	size_t startIndex = (includeHeader ? 0 : 1);
@@ -653,8 +1203,11 @@ VuoList_VuoText VuoTable_getRow_VuoInteger(VuoTable table, VuoInteger rowIndex,
 
 	VuoList_VuoText row = VuoListCreateWithCount_VuoText(count, NULL);
 	for (size_t i = startIndex; i < table.columnCount; ++i)
-		if (rowIndex-1 < (*data).size() && i < (*data)[rowIndex-1].size())
-			VuoListSetValue_VuoText(row, (*data)[rowIndex-1][i], i+1-startIndex, false);
+	{
+		VuoText item = VuoTable_getVuoText(table, rowIndex-1, i);
+		if (item)
+			VuoListSetValue_VuoText(row, item, i+1-startIndex, false);
+	}
 
 	return row;
 }
@@ -681,19 +1234,22 @@ VuoList_VuoText VuoTable_getColumn_VuoInteger(VuoTable table, VuoInteger columnI
 	if (table.rowCount == 0)
 		return VuoListCreate_VuoText();
 
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)table.data;
-
 	columnIndex = getClampedIndex(table, columnIndex, true);
+	const VuoTableColumn *column = VuoTable_getColumnData(table, columnIndex-1);
 
 	size_t startIndex = (includeHeader ? 0 : 1);
 	size_t count = table.rowCount - startIndex;
 
-	VuoList_VuoText column = VuoListCreateWithCount_VuoText(count, NULL);
-	for (size_t i = startIndex; i < table.rowCount; ++i)
-		if (i < (*data).size() && columnIndex-1 < (*data)[i].size())
-			VuoListSetValue_VuoText(column, (*data)[i][columnIndex-1], i+1-startIndex, false);
+	VuoList_VuoText columnList = VuoListCreateWithCount_VuoText(count, NULL);
+	if (column)
+		for (size_t i = startIndex; i < table.rowCount; ++i)
+		{
+			VuoText item = column->getVuoText(i);
+			if (item)
+				VuoListSetValue_VuoText(columnList, item, i+1-startIndex, false);
+		}
 
-	return column;
+	return columnList;
 }
 
 /**
@@ -714,14 +1270,13 @@ VuoList_VuoText VuoTable_getColumn_VuoText(VuoTable table, VuoText columnHeader,
  */
 VuoText VuoTable_getItem_VuoInteger_VuoInteger(VuoTable table, VuoInteger rowIndex, VuoInteger columnIndex)
 {
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)table.data;
-	if ((*data).empty())
+	if (table.rowCount == 0)
 		return NULL;
 
 	rowIndex = getClampedIndex(table, rowIndex, false);
 	columnIndex = getClampedIndex(table, columnIndex, true);
 
-	return (*data)[rowIndex-1][columnIndex-1];
+	return VuoTable_getVuoText(table, rowIndex-1, columnIndex-1);
 }
 
 /**
@@ -761,37 +1316,40 @@ VuoText VuoTable_getItem_VuoText_VuoText(VuoTable table, VuoText rowHeader, VuoT
 	return VuoTable_getItem_VuoInteger_VuoInteger(table, rowIndex, columnIndex);
 }
 
+
 /**
  * Returns a table in which @a values has been added as a new row, either before the first or after the last row.
  */
 VuoTable VuoTable_addRow(VuoTable table, VuoListPosition position, VuoList_VuoText values)
 {
-	vector< vector<VuoText> > *origData = (vector< vector<VuoText> > *)table.data;
-	vector< vector<VuoText> > *data = new vector< vector<VuoText> >(*origData);
-
-	vector< vector<VuoText> >::iterator rowIter;
-	size_t rowIndex;
-	if (position == VuoListPosition_Beginning)
-	{
-		rowIter = (*data).begin();
-		rowIndex = 0;
-	}
-	else
-	{
-		rowIter = (*data).end();
-		rowIndex = table.rowCount;
-	}
+	VuoTableColumns *origColumns = (VuoTableColumns *)table.data;
 
 	unsigned long count = VuoListGetCount_VuoText(values);
 	VuoText *rowArray = VuoListGetData_VuoText(values);
 
-	(*data).insert(rowIter, vector<VuoText>(count));
-	for (unsigned long i = 0; i < count; ++i)
-		(*data)[rowIndex][i] = rowArray[i];
+	VuoTableColumns *columns = new VuoTableColumns;
+	for (size_t j = 0; j < MAX(table.columnCount, count); ++j)
+	{
+		const VuoTableColumn *column = VuoTable_getColumnData(table, j);
+		VuoText value = (j < count ? rowArray[j] : NULL);
+
+		// Rows beyond the end of a column are empty, so appending an empty item doesn't require a new column.
+		if (column && ! value && position == VuoListPosition_End)
+		{
+			columns->push_back((*origColumns)[j]);
+			continue;
+		}
+
+		shared_ptr<VuoTableColumn> newColumn = make_shared<VuoTableColumn>();
+		if (position == VuoListPosition_Beginning)
+			newColumn->append(value);
+		newColumn->appendItems(column, 0, table.rowCount);
+		if (position != VuoListPosition_Beginning)
+			newColumn->append(value);
+		columns->push_back(newColumn);
+	}
 
-	VuoTable newTable = { data, table.rowCount + 1, MAX(table.columnCount, count) };
-	VuoRegister(newTable.data, deleteData);
-	return newTable;
+	return VuoTable_makeFromColumns(columns, table.rowCount + 1);
 }
 
 /**
@@ -799,27 +1357,19 @@ VuoTable VuoTable_addRow(VuoTable table, VuoListPosition position, VuoList_VuoTe
  */
 VuoTable VuoTable_addColumn(VuoTable table, VuoListPosition position, VuoList_VuoText values)
 {
-	vector< vector<VuoText> > *origData = (vector< vector<VuoText> > *)table.data;
-	vector< vector<VuoText> > *data = new vector< vector<VuoText> >(*origData);
+	VuoTableColumns *columns = VuoTable_copyColumns(table);
 
 	unsigned long count = VuoListGetCount_VuoText(values);
 	VuoText *columnArray = VuoListGetData_VuoText(values);
 
-	if ((*data).size() < count)
-		(*data).resize(count);
-
+	shared_ptr<VuoTableColumn> newColumn = make_shared<VuoTableColumn>();
 	for (size_t i = 0; i < count; ++i)
-	{
-		if (position == VuoListPosition_End && (*data)[i].size() < table.columnCount)
-			(*data)[i].resize(table.columnCount);
+		newColumn->append(columnArray[i]);
 
-		vector<VuoText>::iterator columnIter = (position == VuoListPosition_Beginning ? (*data)[i].begin() : (*data)[i].end());
-		(*data)[i].insert(columnIter, columnArray[i]);
-	}
+	VuoTableColumns::iterator columnIter = (position == VuoListPosition_Beginning ? columns->begin() : columns->end());
+	columns->insert(columnIter, newColumn);
 
-	VuoTable newTable = { data, MAX(table.rowCount, count), table.columnCount + 1 };
-	VuoRegister(newTable.data, deleteData);
-	return newTable;
+	return VuoTable_makeFromColumns(columns, MAX(table.rowCount, count));
 }
 
 /**
@@ -832,25 +1382,30 @@ VuoTable VuoTable_changeRow_VuoInteger(VuoTable table, VuoInteger rowIndex, VuoL
 
 	rowIndex = getClampedIndex(table, rowIndex, false);
 
-	vector< vector<VuoText> > *origData = (vector< vector<VuoText> > *)table.data;
-	vector< vector<VuoText> > *data = new vector< vector<VuoText> >(*origData);
-
 	unsigned long newValuesCount = VuoListGetCount_VuoText(newValues);
 	VuoText *rowArray = VuoListGetData_VuoText(newValues);
 
 	size_t firstDataIndex = (preserveHeader ? 1 : 0);
 
-	(*data)[rowIndex-1].resize(newValuesCount+firstDataIndex);
-
-	if (preserveHeader && ! (*origData)[rowIndex-1].empty())
-		(*data)[rowIndex-1][0] = (*origData)[rowIndex-1][0];
-
-	for (size_t i = 0; i < newValuesCount; ++i)
-		(*data)[rowIndex-1][i+firstDataIndex] = rowArray[i];
+	VuoTableColumns *columns = new VuoTableColumns;
+	for (size_t j = 0; j < MAX(table.columnCount, newValuesCount+firstDataIndex); ++j)
+	{
+		const VuoTableColumn *column = VuoTable_getColumnData(table, j);
+
+		const char *value = NULL;
+		if (j < firstDataIndex)
+			value = VuoTable_getText(table, rowIndex-1, j);
+		else if (j-firstDataIndex < newValuesCount)
+			value = rowArray[j-firstDataIndex];
+
+		shared_ptr<VuoTableColumn> newColumn = make_shared<VuoTableColumn>();
+		newColumn->appendItems(column, 0, rowIndex-1);
+		newColumn->append(value);
+		newColumn->appendItems(column, rowIndex, table.rowCount-rowIndex);
+		columns->push_back(newColumn);
+	}
 
-	VuoTable newTable = { data, table.rowCount, MAX(table.columnCount, newValuesCount+firstDataIndex) };
-	VuoRegister(newTable.data, deleteData);
-	return newTable;
+	return VuoTable_makeFromColumns(columns, table.rowCount);
 }
 
 /**
@@ -875,30 +1430,21 @@ VuoTable VuoTable_changeColumn_VuoInteger(VuoTable table, VuoInteger columnIndex
 
 	columnIndex = getClampedIndex(table, columnIndex, true);
 
-	vector< vector<VuoText> > *origData = (vector< vector<VuoText> > *)table.data;
-	vector< vector<VuoText> > *data = new vector< vector<VuoText> >(*origData);
-
 	unsigned long newValuesCount = VuoListGetCount_VuoText(newValues);
 	VuoText *columnArray = VuoListGetData_VuoText(newValues);
 
 	size_t firstDataIndex = (preserveHeader ? 1 : 0);
 
-	if ((*data).size() < newValuesCount+firstDataIndex)
-		(*data).resize(newValuesCount+firstDataIndex);
-
-	for (size_t i = 0; i < newValuesCount+firstDataIndex; ++i)
-		if ((*data)[i].size() < columnIndex)
-			(*data)[i].resize(columnIndex);
-
-	if (preserveHeader && (*origData)[0].size() > columnIndex-1)
-		(*data)[0][columnIndex-1] = (*origData)[0][columnIndex-1];
+	shared_ptr<VuoTableColumn> newColumn = make_shared<VuoTableColumn>();
+	if (preserveHeader)
+		newColumn->appendItem(VuoTable_getColumnData(table, columnIndex-1), 0);
+	for (size_t i = 0; i < newValuesCount; ++i)
+		newColumn->append(columnArray[i]);
 
-	for (size_t i = 0; i < MAX(table.rowCount-firstDataIndex, newValuesCount); ++i)
-		(*data)[i+firstDataIndex][columnIndex-1] = (i < newValuesCount ? columnArray[i] : NULL);
+	VuoTableColumns *columns = VuoTable_copyColumns(table);
+	(*columns)[columnIndex-1] = newColumn;
 
-	VuoTable newTable = { data, MAX(table.rowCount, newValuesCount+firstDataIndex), table.columnCount };
-	VuoRegister(newTable.data, deleteData);
-	return newTable;
+	return VuoTable_makeFromColumns(columns, MAX(table.rowCount, newValuesCount+firstDataIndex));
 }
 
 /**
@@ -918,20 +1464,22 @@ VuoTable VuoTable_changeColumn_VuoText(VuoTable table, VuoText columnHeader, Vuo
  */
 VuoTable VuoTable_changeItem_VuoInteger_VuoInteger(VuoTable table, VuoInteger rowIndex, VuoInteger columnIndex, VuoText newValue)
 {
-	vector< vector<VuoText> > *origData = (vector< vector<VuoText> > *)table.data;
-	if ((*origData).empty())
+	if (table.rowCount == 0 || table.columnCount == 0)
 		return table;
 
 	rowIndex = getClampedIndex(table, rowIndex, false);
 	columnIndex = getClampedIndex(table, columnIndex, true);
 
-	vector< vector<VuoText> > *data = new vector< vector<VuoText> >(*origData);
-	(*data)[rowIndex-1][columnIndex-1] = newValue;
+	const VuoTableColumn *column = VuoTable_getColumnData(table, columnIndex-1);
+	shared_ptr<VuoTableColumn> newColumn = make_shared<VuoTableColumn>();
+	newColumn->appendItems(column, 0, rowIndex-1);
+	newColumn->append(newValue);
+	newColumn->appendItems(column, rowIndex, table.rowCount-rowIndex);
 
-	VuoTable newTable = { data, table.rowCount, table.columnCount };
-	VuoRegister(newTable.data, deleteData);
-	return newTable;
+	VuoTableColumns *columns = VuoTable_copyColumns(table);
+	(*columns)[columnIndex-1] = newColumn;
 
+	return VuoTable_makeFromColumns(columns, table.rowCount);
 }
 
 /**
@@ -971,6 +1519,7 @@ VuoTable VuoTable_changeItem_VuoText_VuoText(VuoTable table, VuoText rowHeader,
 	return VuoTable_changeItem_VuoInteger_VuoInteger(table, rowIndex, columnIndex, newValue);
 }
 
+
 /**
  * Returns a table in which the first or last row has been removed.
  */
@@ -979,15 +1528,19 @@ VuoTable VuoTable_removeRow(VuoTable table, VuoListPosition position)
 	if (table.rowCount == 0)
 		return table;
 
-	vector< vector<VuoText> > *origData = (vector< vector<VuoText> > *)table.data;
-	vector< vector<VuoText> > *data = new vector< vector<VuoText> >(*origData);
+	VuoTableColumns *columns = VuoTable_copyColumns(table);
+	for (VuoTableColumns::iterator i = columns->begin(); i != columns->end(); ++i)
+	{
+		// A column that doesn't reach the last row doesn't change when the last row is removed.
+		if (position == VuoListPosition_End && (*i)->getRowCount() < table.rowCount)
+			continue;
 
-	vector< vector<VuoText> >::iterator rowIter = (position == VuoListPosition_Beginning ? (*data).begin() : (*data).end() - 1);
-	(*data).erase(rowIter);
+		shared_ptr<VuoTableColumn> newColumn = make_shared<VuoTableColumn>();
+		newColumn->appendItems(i->get(), position == VuoListPosition_Beginning ? 1 : 0, table.rowCount - 1);
+		*i = newColumn;
+	}
 
-	VuoTable newTable = { data, table.rowCount - 1, table.columnCount };
-	VuoRegister(newTable.data, deleteData);
-	return newTable;
+	return VuoTable_makeFromColumns(columns, table.rowCount - 1);
 }
 
 /**
@@ -998,21 +1551,12 @@ VuoTable VuoTable_removeColumn(VuoTable table, VuoListPosition position)
 	if (table.columnCount == 0)
 		return table;
 
-	vector< vector<VuoText> > *origData = (vector< vector<VuoText> > *)table.data;
-	vector< vector<VuoText> > *data = new vector< vector<VuoText> >(*origData);
-
-	for (size_t i = 0; i < table.rowCount; ++i)
-	{
-		if (position == VuoListPosition_End && (*data)[i].size() < table.columnCount)
-			continue;
+	VuoTableColumns *columns = VuoTable_copyColumns(table);
 
-		vector<VuoText>::iterator columnIter = (position == VuoListPosition_Beginning ? (*data)[i].begin() : (*data)[i].end() - 1);
-		(*data)[i].erase(columnIter);
-	}
+	VuoTableColumns::iterator columnIter = (position == VuoListPosition_Beginning ? columns->begin() : columns->end() - 1);
+	columns->erase(columnIter);
 
-	VuoTable newTable = { data, table.rowCount, table.columnCount - 1 };
-	VuoRegister(newTable.data, deleteData);
-	return newTable;
+	return VuoTable_makeFromColumns(columns, table.rowCount);
 }
 
 /**
@@ -1025,23 +1569,26 @@ VuoList_VuoText VuoTable_findFirstMatchingRow_VuoInteger(VuoTable table, VuoInte
 	if (table.rowCount == 0)
 		return nullptr;
 
-	auto rows = static_cast<vector<vector<VuoText>>*>(table.data);
-
 	columnIndex = getClampedIndex(table, columnIndex, true);
+	const VuoTableColumn *column = VuoTable_getColumnData(table, columnIndex - 1);
 
-	auto foundRow = find_if(rows->begin(), rows->end(), [columnIndex, valueComparison, valueToFind](vector<VuoText> row) {
-		return VuoText_compare(row[columnIndex - 1], valueComparison, valueToFind);
-	});
+	size_t foundRow = 0;
+	while (foundRow < table.rowCount && ! VuoText_compare(column ? column->getText(foundRow) : NULL, valueComparison, valueToFind))
+		++foundRow;
 
-	if (foundRow == rows->end())
+	if (foundRow == table.rowCount)
 		return nullptr;
 
 	size_t startIndex = (includeHeader ? 0 : 1);
-	size_t count = foundRow->size() - startIndex;
+	size_t count = table.columnCount - startIndex;
 
 	VuoList_VuoText outputRow = VuoListCreateWithCount_VuoText(count, NULL);
 	for (size_t i = startIndex; i < table.columnCount; ++i)
-		VuoListSetValue_VuoText(outputRow, (*foundRow)[i], i + 1 - startIndex, false);
+	{
+		VuoText item = VuoTable_getVuoText(table, foundRow, i);
+		if (item)
+			VuoListSetValue_VuoText(outputRow, item, i + 1 - startIndex, false);
+	}
 
 	return outputRow;
 }
@@ -1061,27 +1608,22 @@ VuoList_VuoText VuoTable_findFirstMatchingRow_VuoText(VuoTable table, VuoText co
 }
 
 /**
- * Replaces the auto-generated function in order to retain the items within vectors.
+ * Replaces the auto-generated function.
+ *
+ * The items are stored in the columns' arenas rather than as separate heap-registered values,
+ * so only the list of columns needs to be retained.
  */
 void VuoTable_retain(VuoTable table)
 {
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)table.data;
-	for (vector< vector<VuoText> >::iterator i = data->begin(); i != data->end(); ++i)
-		for (vector<VuoText>::iterator j = i->begin(); j != i->end(); ++j)
-			VuoRetain(*j);
-
 	VuoRetain(table.data);
 }
 
 /**
- * Replaces the auto-generated function in order to release the items within vectors.
+ * Replaces the auto-generated function.
+ *
+ * The columns are destroyed when the last table that shares them is deallocated.
  */
 void VuoTable_release(VuoTable table)
 {
-	vector< vector<VuoText> > *data = (vector< vector<VuoText> > *)table.data;
-	for (vector< vector<VuoText> >::iterator i = data->begin(); i != data->end(); ++i)
-		for (vector<VuoText>::iterator j = i->begin(); j != i->end(); ++j)
-			VuoRelease(*j);
-
 	VuoRelease(table.data);
 }
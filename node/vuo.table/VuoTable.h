@@ -34,13 +34,15 @@ extern "C" {
  */
 typedef struct
 {
-	void *data;  ///< The data items (a `vector< vector<VuoText> >` with outer vectors as rows and inner vectors as columns), including headers.
-	size_t rowCount;  ///< The number of rows. Same as `(*data).size()`.
-	size_t columnCount;  ///< The number of columns. The maximum of `(*data)[i].size()`.
+	void *data;  ///< The data items (a `vector< shared_ptr<const VuoTableColumn> >`, each column storing its items' text contiguously), including headers.
+	size_t rowCount;  ///< The number of rows. The maximum of each column's item count.
+	size_t columnCount;  ///< The number of columns. Same as `(*data).size()`.
 } VuoTable;
 
 #define VuoTable_OVERRIDES_INTERPROCESS_SERIALIZATION  ///< This type implements `_getInterprocessJson()`.
 
+#define VuoTable_NoLastRow INT64_MAX  ///< Pass as the last row to @ref VuoTable_makeFromData to include all rows through the end of the text.
+
 VuoTable VuoTable_makeFromJson(struct json_object *js);
 struct json_object * VuoTable_getJson(const VuoTable value);
 struct json_object * VuoTable_getInterprocessJson(const VuoTable value);
@@ -48,6 +50,8 @@ char * VuoTable_getSummary(const VuoTable value);
 
 VuoTable VuoTable_makeEmpty(void);
 VuoTable VuoTable_makeFromText(VuoText text, VuoTableFormat format);
+VuoTable VuoTable_makeFromData(const void *data, size_t numBytes, VuoTableFormat format, VuoInteger firstRow, VuoInteger lastRow);
+VuoTable VuoTable_makeFromFile(const char *path, VuoTableFormat format, VuoInteger firstRow, VuoInteger lastRow);
 VuoText VuoTable_serialize(VuoTable table, VuoTableFormat format);
 VuoTable VuoTable_sort_VuoInteger(VuoTable table, VuoInteger columnIndex, VuoTextSort sortType, VuoSortOrder sortOrder, bool firstRowIsHeader);
 VuoTable VuoTable_sort_VuoText(VuoTable table, VuoText columnHeader, VuoTextSort sortType, VuoSortOrder sortOrder, bool firstRowIsHeader);
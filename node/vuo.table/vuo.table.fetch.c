@@ -7,7 +7,9 @@
  * For more information, see https://vuo.org/license.
  */
 
+#include "VuoIntegerRange.h"
 #include "VuoTable.h"
+#include "VuoUrl.h"
 #include "VuoUrlFetch.h"
 
 VuoModuleMetadata({
@@ -18,7 +20,7 @@ VuoModuleMetadata({
 						"csv", "tsv", "comma", "tab", "separated",
 						"parse", "convert", "read"
 					  ],
-					  "version" : "1.1.0",
+					  "version" : "1.2.0",
 					  "dependencies" : [
 						  "VuoUrlFetch",
 					  ],
@@ -31,18 +33,29 @@ void nodeEvent
 (
 		VuoInputData(VuoText, {"name":"URL"}) url,
 		VuoInputData(VuoTableFormat, {"default":"csv"}) format,
+		VuoInputData(VuoIntegerRange, {"default":{"minimum":1}}) rows,
 		VuoOutputData(VuoTable) table
 )
 {
+	VuoIntegerRange orderedRows = VuoIntegerRange_getOrderedRange(rows);
+
+	// Map local files into memory rather than copying them into a buffer, so only the table stays in memory.
+	VuoUrl resolvedUrl = VuoUrl_normalize(url, VuoUrlNormalize_default);
+	VuoLocal(resolvedUrl);
+	VuoText posixPath = VuoUrl_getPosixPath(resolvedUrl);
+	VuoLocal(posixPath);
+	if (posixPath)
+	{
+		*table = VuoTable_makeFromFile(posixPath, format, orderedRows.minimum, orderedRows.maximum);
+		return;
+	}
+
 	void *data;
 	unsigned int dataLength;
 	if (VuoUrl_fetch(url, &data, &dataLength))
 	{
-		// Include the NULL terminating byte allocated and initialized by VuoUrl_fetch().
-		VuoText text = VuoText_makeFromData(data, dataLength + 1);
+		*table = VuoTable_makeFromData(data, dataLength, format, orderedRows.minimum, orderedRows.maximum);
 		free(data);
-
-		*table = VuoTable_makeFromText(text, format);
 	}
 	else
 		*table = VuoTable_makeEmpty();
@@ -257,6 +257,23 @@ void VuoRunner::setRuntimeChecking(bool runtimeCheckingEnabled)
 	isRuntimeCheckingEnabled = runtimeCheckingEnabled && VuoFileUtilities::fileExists(mainThreadChecker);
 }
 
+/**
+ * When enabled, the composition hands out threads to its triggers and chains using per-CPU work-stealing deques,
+ * instead of a single dispatcher thread. This may reduce scheduling overhead when many triggers fire concurrently.
+ */
+void VuoRunner::setWorkStealingScheduler(bool workStealingSchedulerEnabled)
+{
+	VuoRunnerTraceScope();
+
+	if (!stopped)
+	{
+		VUserLog("Error: Only call VuoRunner::setWorkStealingScheduler() prior to starting the composition.");
+		return;
+	}
+
+	isWorkStealingSchedulerEnabled = workStealingSchedulerEnabled;
+}
+
 /**
  * Private constructor, used by factory methods.
  */
@@ -268,6 +285,7 @@ VuoRunner::VuoRunner(void)
 	shouldContinueIfRunnerDies = false;
 	shouldDeleteBinariesWhenFinished = false;
 	isRuntimeCheckingEnabled         = false;
+	isWorkStealingSchedulerEnabled   = false;
 	paused = true;
 	stopped = true;
 	lostContact = false;
@@ -632,7 +650,7 @@ void VuoRunner::startInternal(void)
 			ZMQTelemetryURL = "inproc://" + VuoFileUtilities::makeTmpFile("vuo-telemetry", "");
 
 			vuoInitInProcess(ZMQContext, ZMQControlURL.c_str(), ZMQTelemetryURL.c_str(), true, getpid(), -1, false,
-							 sourceDir.c_str(), dylibHandle, NULL, false);
+							 sourceDir.c_str(), dylibHandle, NULL, false, isWorkStealingSchedulerEnabled);
 		}
 		catch (VuoException &e)
 		{
@@ -695,6 +713,9 @@ void VuoRunner::startInternal(void)
 		if (shouldContinueIfRunnerDies)
 			args.push_back("--vuo-continue-if-runner-dies");
 
+		if (isWorkStealingSchedulerEnabled)
+			args.push_back("--vuo-work-stealing-scheduler");
+
 		if (isUsingCompositionLoader())
 		{
 			ZMQLoaderControlURL = "ipc://" + VuoFileUtilities::makeTmpFile("v", "");
@@ -956,6 +977,9 @@ void VuoRunner::setUpConnections(void)
 
 	vuoControlRequestSend(VuoControlRequestSlowHeartbeat,NULL,0);
 	vuoControlReplyReceive(VuoControlReplyHeartbeatSlowed);
+
+	vuoControlRequestSend(VuoControlRequestTelemetryBatchingEnable,NULL,0);
+	vuoControlReplyReceive(VuoControlReplyTelemetryBatchingEnabled);
 }
 
 /**
@@ -2434,6 +2458,91 @@ VuoRunner::Port * VuoRunner::getPublishedOutputPortWithName(string name)
 	return NULL;
 }
 
+/**
+ * Receives the rest of a @ref VuoTelemetryBatch message, and forwards each record to VuoRunnerDelegate.
+ *
+ * Called by listen() after it has received the message type.
+ */
+void VuoRunner::receiveTelemetryBatch(void)
+{
+	zmq_msg_t stringsMessage;
+	zmq_msg_t recordsMessage;
+	zmq_msg_init(&stringsMessage);
+	zmq_msg_init(&recordsMessage);
+
+	if (! VuoTelemetry_hasMoreToReceive(ZMQTelemetry) || zmq_msg_recv(&stringsMessage, ZMQTelemetry, 0) == -1
+			|| ! VuoTelemetry_hasMoreToReceive(ZMQTelemetry) || zmq_msg_recv(&recordsMessage, ZMQTelemetry, 0) == -1)
+	{
+		VUserLog("Error: Incomplete telemetry batch.");
+		zmq_msg_close(&stringsMessage);
+		zmq_msg_close(&recordsMessage);
+		return;
+	}
+
+	// Index the string table.
+	vector<const char *> strings;
+	const char *stringsData = static_cast<const char *>(zmq_msg_data(&stringsMessage));
+	size_t stringsSize = zmq_msg_size(&stringsMessage);
+	for (size_t i = 0; i < stringsSize; )
+	{
+		const char *s = stringsData + i;
+		size_t length = strnlen(s, stringsSize - i);
+		if (i + length == stringsSize)
+			break;  // Not null-terminated.
+		strings.push_back(s);
+		i += length + 1;
+	}
+
+	const VuoTelemetryRecord *records = static_cast<const VuoTelemetryRecord *>(zmq_msg_data(&recordsMessage));
+	size_t recordCount = zmq_msg_size(&recordsMessage) / sizeof(VuoTelemetryRecord);
+	const char * const *stringTable = strings.data();
+	size_t stringCount = strings.size();
+
+	dispatch_sync(delegateQueue, ^{
+		if (! delegate)
+			return;
+
+		for (size_t i = 0; i < recordCount; ++i)
+		{
+			const VuoTelemetryRecord &record = records[i];
+			if (record.compositionIdentifier >= stringCount || record.identifier >= stringCount
+					|| (record.portDataSummary != VuoTelemetryRecord_noSummary && record.portDataSummary >= stringCount))
+			{
+				VUserLog("Error: Telemetry batch refers to a nonexistent string.");
+				continue;
+			}
+
+			string compositionIdentifier = stringTable[record.compositionIdentifier];
+			string identifier = stringTable[record.identifier];
+			string portDataSummary = record.portDataSummary == VuoTelemetryRecord_noSummary ? "" : stringTable[record.portDataSummary];
+			bool event = record.flags & VuoTelemetryRecordFlagEvent;
+			bool data = record.flags & VuoTelemetryRecordFlagData;
+
+			switch (record.type)
+			{
+				case VuoTelemetryNodeExecutionStarted:
+					delegate->receivedTelemetryNodeExecutionStarted(compositionIdentifier, identifier);
+					break;
+				case VuoTelemetryNodeExecutionFinished:
+					delegate->receivedTelemetryNodeExecutionFinished(compositionIdentifier, identifier);
+					break;
+				case VuoTelemetryInputPortsUpdated:
+					delegate->receivedTelemetryInputPortUpdated(compositionIdentifier, identifier, event, data, portDataSummary);
+					break;
+				case VuoTelemetryOutputPortsUpdated:
+					delegate->receivedTelemetryOutputPortUpdated(compositionIdentifier, identifier, event, data, portDataSummary);
+					break;
+				default:
+					VUserLog("Error: Unknown telemetry record type: %d", record.type);
+					break;
+			}
+		}
+	});
+
+	zmq_msg_close(&stringsMessage);
+	zmq_msg_close(&recordsMessage);
+}
+
 /**
  * Listens for telemetry data from the composition until the composition stops.
  *
@@ -2519,6 +2628,10 @@ void VuoRunner::listen()
 		zmq_setsockopt(ZMQTelemetry, ZMQ_SUBSCRIBE, &type, sizeof type);
 		type = VuoTelemetryStopRequested;
 		zmq_setsockopt(ZMQTelemetry, ZMQ_SUBSCRIBE, &type, sizeof type);
+		type = VuoTelemetryNodeSynchronizationStats;
+		zmq_setsockopt(ZMQTelemetry, ZMQ_SUBSCRIBE, &type, sizeof type);
+		type = VuoTelemetryBatch;
+		zmq_setsockopt(ZMQTelemetry, ZMQ_SUBSCRIBE, &type, sizeof type);
 	}
 
 	{
@@ -2743,6 +2856,22 @@ void VuoRunner::listen()
 								   });
 					break;
 				}
+				case VuoTelemetryNodeSynchronizationStats:
+				{
+					unsigned long uncontendedClaims = vuoReceiveUnsignedInt64(ZMQTelemetry, NULL);
+					unsigned long spinningClaims = vuoReceiveUnsignedInt64(ZMQTelemetry, NULL);
+					unsigned long parkedClaims = vuoReceiveUnsignedInt64(ZMQTelemetry, NULL);
+					dispatch_sync(delegateQueue, ^{
+									  if (delegate)
+										  delegate->receivedTelemetryNodeSynchronizationStats(uncontendedClaims, spinningClaims, parkedClaims);
+								  });
+					break;
+				}
+				case VuoTelemetryBatch:
+				{
+					receiveTelemetryBatch();
+					break;
+				}
 				default:
 					VUserLog("Error: Unknown telemetry message type: %d", type);
 					break;
@@ -98,6 +98,7 @@ public:
 	static VuoRunner * newCurrentProcessRunnerFromDynamicLibrary(string dylibPath, string sourceDir, bool deleteDylibWhenFinished = false);
 	~VuoRunner(void);
 	void setRuntimeChecking(bool runtimeCheckingEnabled);
+	void setWorkStealingScheduler(bool workStealingSchedulerEnabled);
 	void start(void);
 	void startPaused(void);
 	void runOnMainThread(void);
@@ -167,6 +168,7 @@ private:
 	bool shouldDeleteBinariesWhenFinished;  ///< True if the composition binary file(s) should be deleted when the runner is finished using them.
 	string sourceDir;  ///< The directory containing the composition's .vuo source file.
 	bool isRuntimeCheckingEnabled;
+	bool isWorkStealingSchedulerEnabled;  ///< True if the composition should schedule workers with VuoThreadManager::Scheduler_WorkStealing.
 	bool paused;  ///< True if the composition is in a paused state.
 	bool stopped;	///< True if the composition is in a stopped state (either never started or started then stopped).
 	bool lostContact;   ///< True if the runner stopped receiving communication from the composition.
@@ -209,6 +211,7 @@ private:
 	VuoRunner(void);
 	void startInternal(void);
 	void listen();
+	void receiveTelemetryBatch(void);
 	void setUpConnections(void);
 	void cleanUpConnections(void);
 	void vuoControlRequestSend(enum VuoControlRequest request, zmq_msg_t *messages, unsigned int messageCount);
@@ -327,6 +330,18 @@ public:
 	 */
 	virtual void lostContactWithComposition(void) = 0;
 
+	/**
+	 * This delegate method is invoked along with a heartbeat when the composition's node-claim counts have changed.
+	 * The counts are cumulative since the composition started.
+	 *
+	 * Claims that had to spin or block indicate that events from different triggers are contending for the same nodes.
+	 *
+	 * @param uncontendedClaims The number of times an event claimed a node that no other event was using.
+	 * @param spinningClaims The number of times an event claimed a node after briefly waiting for another event to finish with it.
+	 * @param parkedClaims The number of times an event had to block until another event finished with a node.
+	 */
+	virtual void receivedTelemetryNodeSynchronizationStats(unsigned long uncontendedClaims, unsigned long spinningClaims, unsigned long parkedClaims) { }
+
 	virtual ~VuoRunnerDelegate() = 0;  // Fixes "virtual functions but non-virtual destructor" warning
 };
 
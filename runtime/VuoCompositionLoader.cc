@@ -43,6 +43,7 @@ vector<string> resourceDylibsToLoad;  ///< Paths of the resources to be loaded (
 pid_t runnerPid = 0;  ///< Process ID of the runner that started the composition.
 int runnerPipe = -1;  ///< The file descriptor for the composition's end of the pipe used to detect if the runner's process ends.
 bool continueIfRunnerDies = false;  ///< If true, the composition continues running if the runner's process ends.
+bool useWorkStealingScheduler = false;  ///< If true, the composition uses VuoThreadManager::Scheduler_WorkStealing.
 
 bool replaceComposition(const char *dylibPath, char *compositionDiff);
 void stopComposition(void);
@@ -121,6 +122,7 @@ int main(int argc, char **argv)
 			{"vuo-runner-pipe", required_argument, NULL, 0},
 			{"vuo-continue-if-runner-dies", no_argument, NULL, 0},
 			{"vuo-runner-pid", required_argument, NULL, 0},
+			{"vuo-work-stealing-scheduler", no_argument, NULL, 0},
 			{NULL, no_argument, NULL, 0}
 		};
 		int optionIndex=-1;
@@ -152,6 +154,9 @@ int main(int argc, char **argv)
 				case 5:  // --vuo-runner-pid
 					runnerPid = atoi(optarg);
 					break;
+				case 6:  // --vuo-work-stealing-scheduler
+					useWorkStealingScheduler = true;
+					break;
 			}
 		}
 	}
@@ -429,7 +434,7 @@ bool replaceComposition(const char *dylibPath, char *compositionDiff)
 		}
 
 		vuoInitInProcess(ZMQControlContext, controlURL, telemetryURL, true, runnerPid, runnerPipe, continueIfRunnerDies,
-						 "", dylibHandle, runtimePersistentState, false);
+						 "", dylibHandle, runtimePersistentState, false, useWorkStealingScheduler);
 	}
 
 	isReplacing = false;
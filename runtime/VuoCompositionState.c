@@ -18,6 +18,7 @@ struct VuoCompositionState * vuoCreateCompositionState(void *runtimeState, const
 	struct VuoCompositionState *compositionState = (struct VuoCompositionState *)malloc(sizeof(struct VuoCompositionState));
 	compositionState->runtimeState = runtimeState;
 	compositionState->compositionIdentifier = compositionIdentifier;
+	compositionState->nodeContexts = NULL;
 	return compositionState;
 }
 
@@ -37,6 +38,16 @@ const char * vuoGetCompositionStateCompositionIdentifier(struct VuoCompositionSt
 	return compositionState->compositionIdentifier;
 }
 
+/**
+ * Sets the composition state's `compositionIdentifier` field, and discards the node contexts looked up for the previous identifier.
+ * The composition state does not take ownership of @a compositionIdentifier.
+ */
+void vuoSetCompositionStateCompositionIdentifier(struct VuoCompositionState *compositionState, const char *compositionIdentifier)
+{
+	compositionState->compositionIdentifier = compositionIdentifier;
+	compositionState->nodeContexts = NULL;
+}
+
 /**
  * Frees the composition state (but not its fields).
  */
@@ -104,5 +115,6 @@ void * vuoCopyCompositionStateFromThreadLocalStorage(void)
 	struct VuoCompositionState *compositionStateCopy = (struct VuoCompositionState *)malloc(sizeof(struct VuoCompositionState));
 	compositionStateCopy->runtimeState = ((struct VuoCompositionState *)compositionState)->runtimeState;
 	compositionStateCopy->compositionIdentifier = NULL;
+	compositionStateCopy->nodeContexts = NULL;
 	return compositionStateCopy;
 }
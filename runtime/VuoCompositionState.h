@@ -29,11 +29,13 @@ struct VuoCompositionState
 {
 	void *runtimeState;  ///< The VuoRuntimeState of the top-level composition.
 	const char *compositionIdentifier;  ///< The identifier of this (sub)composition, unique among the top-level composition and its subcompositions.
+	void *nodeContexts;  ///< This (sub)composition's node contexts, indexed by node index. Set when created for a subcomposition node by vuoCreateSubcompositionState(); otherwise looked up from VuoNodeRegistry on first use.
 };
 
 struct VuoCompositionState * vuoCreateCompositionState(void *runtimeState, const char *compositionIdentifier);
 void * vuoGetCompositionStateRuntimeState(struct VuoCompositionState *compositionState);
 const char * vuoGetCompositionStateCompositionIdentifier(struct VuoCompositionState *compositionState);
+void vuoSetCompositionStateCompositionIdentifier(struct VuoCompositionState *compositionState, const char *compositionIdentifier);
 void vuoFreeCompositionState(struct VuoCompositionState *compositionState);
 
 extern pthread_key_t vuoCompositionStateKey;
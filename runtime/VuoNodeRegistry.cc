@@ -13,6 +13,7 @@
 #include <sstream>
 #include "VuoCompositionDiff.hh"
 #include "VuoException.hh"
+#include "VuoRuntimeCommunicator.hh"
 #include "VuoRuntimePersistentState.hh"
 #include "VuoRuntimeState.hh"
 #include "VuoRuntimeUtilities.hh"
@@ -27,6 +28,15 @@ VuoNodeRegistry::VuoNodeRegistry(VuoRuntimePersistentState *persistentState)
 {
 	this->persistentState = persistentState;
 	vuoTopLevelCompositionIdentifier = NULL;
+	nodeContextTables = NULL;
+}
+
+/**
+ * Destructor.
+ */
+VuoNodeRegistry::~VuoNodeRegistry(void)
+{
+	unpublishNodeContextTables();
 }
 
 /**
@@ -188,6 +198,41 @@ const VuoNodeRegistry::NodeMetadata * VuoNodeRegistry::getNodeMetadataForPort(co
 	return NULL;
 }
 
+/**
+ * Looks up the node index (as in @ref getNodeIdentifierForIndex) and port context index (as in `NodeContext.portContexts`)
+ * for the port with the given identifier.
+ *
+ * Returns false, without logging, if the port isn't in the node metadata — for example, if the composition hasn't started yet.
+ */
+bool VuoNodeRegistry::getIndexesForPort(const string &compositionIdentifier, const string &portIdentifier, unsigned long &nodeIndex, unsigned long &portIndex)
+{
+	string nodeIdentifier, portName;
+	splitPortIdentifier(portIdentifier, nodeIdentifier, portName);
+
+	map<string, vector<NodeMetadata> >::iterator iter1 = nodeMetadatas.find(compositionIdentifier);
+	if (iter1 == nodeMetadatas.end())
+		return false;
+
+	for (unsigned long i = 0; i < iter1->second.size(); ++i)
+	{
+		if (iter1->second[i].identifier != nodeIdentifier)
+			continue;
+
+		const vector<PortMetadata> &portMetadatas = iter1->second[i].portMetadatas;
+		for (unsigned long j = 0; j < portMetadatas.size(); ++j)
+		{
+			if (portMetadatas[j].identifier == portIdentifier)
+			{
+				nodeIndex = i;
+				portIndex = j;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 /**
  * Looks up the composition identifier that corresponds to the given hash.
  */
@@ -201,6 +246,160 @@ string VuoNodeRegistry::getCompositionIdentifierForHash(unsigned long compositio
 	return "";
 }
 
+/**
+ * Destroys the tables.
+ */
+VuoNodeRegistry::NodeContextTables::~NodeContextTables(void)
+{
+	for (NodeContextTable *table : tables)
+		delete table;
+}
+
+/**
+ * Builds a @ref NodeContextTable for the top-level composition and each subcomposition instance from the node contexts
+ * registered so far, and publishes them in @ref nodeContextTables.
+ *
+ * Call only after the node contexts have been initialized, and before any events can be executing.
+ */
+void VuoNodeRegistry::publishNodeContextTables(void)
+{
+	NodeContextTables *tables = new NodeContextTables;
+	tables->topLevelTable = NULL;
+
+	for (auto &i : nodeMetadatas)
+	{
+		NodeContextTable *table = new NodeContextTable;
+		table->compositionIndex = tables->tables.size();
+		table->nodeContexts.resize(i.second.size(), NULL);
+		table->subcompositionTables.resize(i.second.size(), NULL);
+
+		auto contextsIter = nodeContextForIndex.find(VuoRuntimeUtilities::hash(i.first.c_str()));
+		if (contextsIter != nodeContextForIndex.end())
+			for (auto &j : contextsIter->second)
+				if (j.first < table->nodeContexts.size())
+					table->nodeContexts[j.first] = j.second;
+
+		tables->tables.push_back(table);
+		tables->tableForComposition[i.first] = table;
+	}
+
+	for (auto &i : nodeMetadatas)
+	{
+		NodeContextTable *table = tables->tableForComposition[i.first];
+		for (size_t nodeIndex = 0; nodeIndex < i.second.size(); ++nodeIndex)
+		{
+			auto subcompositionIter = tables->tableForComposition.find(buildCompositionIdentifier(i.first, i.second[nodeIndex].identifier));
+			if (subcompositionIter != tables->tableForComposition.end())
+				table->subcompositionTables[nodeIndex] = subcompositionIter->second;
+		}
+	}
+
+	if (vuoTopLevelCompositionIdentifier)
+	{
+		auto topLevelIter = tables->tableForComposition.find(vuoTopLevelCompositionIdentifier);
+		if (topLevelIter != tables->tableForComposition.end())
+			tables->topLevelTable = topLevelIter->second;
+	}
+
+	delete nodeContextTables.exchange(tables);
+}
+
+/**
+ * Withdraws and destroys the tables published by @ref publishNodeContextTables.
+ *
+ * Call only when no events can be executing, since composition states created during an event may refer to the tables.
+ */
+void VuoNodeRegistry::unpublishNodeContextTables(void)
+{
+	delete nodeContextTables.exchange(NULL);
+}
+
+/**
+ * Returns the node-context table for the (sub)composition that @a compositionState refers to,
+ * or null if the tables haven't been published (while the node contexts are being initialized or finalized).
+ *
+ * If @a compositionState was created by @ref createSubcompositionState, it already refers to its table.
+ * Otherwise, the table is looked up by composition identifier, and @a compositionState is made to refer to it.
+ */
+const VuoNodeRegistry::NodeContextTable * VuoNodeRegistry::getNodeContextTable(VuoCompositionState *compositionState)
+{
+	const NodeContextTable *table = static_cast<const NodeContextTable *>(compositionState->nodeContexts);
+	if (table)
+		return table;
+
+	const NodeContextTables *tables = nodeContextTables.load(std::memory_order_acquire);
+	if (! tables || ! compositionState->compositionIdentifier)
+		return NULL;
+
+	if (tables->topLevelTable && (compositionState->compositionIdentifier == vuoTopLevelCompositionIdentifier
+								  || strcmp(compositionState->compositionIdentifier, vuoTopLevelCompositionIdentifier) == 0))
+		table = tables->topLevelTable;
+	else
+	{
+		auto iter = tables->tableForComposition.find(compositionState->compositionIdentifier);
+		if (iter == tables->tableForComposition.end())
+			return NULL;
+
+		table = iter->second;
+	}
+
+	compositionState->nodeContexts = const_cast<NodeContextTable *>(table);
+	return table;
+}
+
+/**
+ * Creates a composition state for the subcomposition instance of the node at @a nodeIndex in the (sub)composition
+ * that @a compositionState refers to. The new composition state refers to the subcomposition's node-context table,
+ * found by index in the parent's, so node context lookups through it don't need to look up @a subcompositionIdentifier.
+ *
+ * The composition state does not take ownership of @a subcompositionIdentifier.
+ */
+VuoCompositionState * VuoNodeRegistry::createSubcompositionState(VuoCompositionState *compositionState, unsigned long nodeIndex, const char *subcompositionIdentifier)
+{
+	VuoCompositionState *subcompositionState = vuoCreateCompositionState(compositionState->runtimeState, subcompositionIdentifier);
+
+	const NodeContextTable *table = getNodeContextTable(compositionState);
+	if (table && nodeIndex < table->subcompositionTables.size())
+		subcompositionState->nodeContexts = table->subcompositionTables[nodeIndex];
+
+	return subcompositionState;
+}
+
+/**
+ * Outputs the index of the (sub)composition that @a compositionState refers to among the top-level composition
+ * and its subcomposition instances — a small integer that can be used to index per-composition arrays.
+ *
+ * Returns false if the node contexts haven't been initialized (or are being finalized), or the composition isn't found.
+ * The indexes are reassigned each time the node contexts are initialized.
+ */
+bool VuoNodeRegistry::getCompositionIndex(VuoCompositionState *compositionState, unsigned long &compositionIndex)
+{
+	const NodeContextTable *table = getNodeContextTable(compositionState);
+	if (! table)
+		return false;
+
+	compositionIndex = table->compositionIndex;
+	return true;
+}
+
+/**
+ * Outputs the index of the (sub)composition with the given identifier, as in
+ * @ref getCompositionIndex(VuoCompositionState *, unsigned long &).
+ */
+bool VuoNodeRegistry::getCompositionIndex(const string &compositionIdentifier, unsigned long &compositionIndex)
+{
+	const NodeContextTables *tables = nodeContextTables.load(std::memory_order_acquire);
+	if (! tables)
+		return false;
+
+	auto iter = tables->tableForComposition.find(compositionIdentifier);
+	if (iter == tables->tableForComposition.end())
+		return false;
+
+	compositionIndex = iter->second->compositionIndex;
+	return true;
+}
+
 /**
  * Registers a node context.
  */
@@ -333,6 +532,22 @@ NodeContext * VuoNodeRegistry::getNodeContext(const char *compositionIdentifier,
 	return NULL;
 }
 
+/**
+ * Returns the node context registered for the node index in the (sub)composition that @a compositionState refers to,
+ * or null if none is found.
+ *
+ * Once the node contexts have been initialized, this is a bounds check and an array access
+ * in the (sub)composition's node-context table (see @ref getNodeContextTable).
+ */
+NodeContext * VuoNodeRegistry::getNodeContext(VuoCompositionState *compositionState, unsigned long nodeIndex)
+{
+	const NodeContextTable *table = getNodeContextTable(compositionState);
+	if (table && nodeIndex < table->nodeContexts.size() && table->nodeContexts[nodeIndex])
+		return table->nodeContexts[nodeIndex];
+
+	return getNodeContext(compositionState->compositionIdentifier, nodeIndex);
+}
+
 /**
  * Returns the node context registered for the composition (top-level or subcomposition), or null if none is found.
  */
@@ -390,6 +605,21 @@ unsigned long VuoNodeRegistry::getNodeIndexForPort(const char *compositionIdenti
 	return 0;
 }
 
+/**
+ * Returns the port's index in `NodeContext.portContexts`, given the port's identifier,
+ * or `ULONG_MAX` if the port isn't found.
+ */
+unsigned long VuoNodeRegistry::getPortIndexForPort(const char *compositionIdentifier, const char *portIdentifier)
+{
+	unsigned long nodeIndex;
+	unsigned long portIndex;
+	if (getIndexesForPort(compositionIdentifier, portIdentifier, nodeIndex, portIndex))
+		return portIndex;
+
+	VUserLog("Couldn't find port index for port %s", buildCompositionIdentifier(compositionIdentifier, portIdentifier).c_str());
+	return ULONG_MAX;
+}
+
 /**
  * Returns the numerical index for a port's type, given the port's identifier.
  */
@@ -617,6 +847,10 @@ void VuoNodeRegistry::initContextForTopLevelComposition(VuoCompositionState *com
 	}
 
 	initContextsForCompositionContents(compositionState);
+
+	publishNodeContextTables();
+
+	persistentState->communicator->updateTelemetrySubscriptionIndexes();
 }
 
 /**
@@ -748,6 +982,8 @@ void VuoNodeRegistry::finiContextForTopLevelComposition(VuoCompositionState *com
 {
 	const char *compositionIdentifier = compositionState->compositionIdentifier;
 
+	unpublishNodeContextTables();
+
 	if (persistentState->compositionDiff->isCompositionStartingOrStopping())
 	{
 		// Unregister and destroy the node context for the top-level composition.
@@ -1006,8 +1242,16 @@ void vuoAddPortMetadata(VuoCompositionState *compositionState, const char *portI
 NodeContext * vuoGetNodeContext(VuoCompositionState *compositionState, unsigned long nodeIndex)
 {
 	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
-	const char *compositionIdentifier = compositionState->compositionIdentifier;
-	return runtimeState->persistentState->nodeRegistry->getNodeContext(compositionIdentifier, nodeIndex);
+	return runtimeState->persistentState->nodeRegistry->getNodeContext(compositionState, nodeIndex);
+}
+
+/**
+ * C wrapper for VuoNodeRegistry::createSubcompositionState().
+ */
+VuoCompositionState * vuoCreateSubcompositionState(VuoCompositionState *compositionState, unsigned long nodeIndex, const char *subcompositionIdentifier)
+{
+	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
+	return runtimeState->persistentState->nodeRegistry->createSubcompositionState(compositionState, nodeIndex, subcompositionIdentifier);
 }
 
 /**
@@ -1050,6 +1294,16 @@ unsigned long vuoGetTypeIndexForPort(VuoCompositionState *compositionState, cons
 	return runtimeState->persistentState->nodeRegistry->getTypeIndexForPort(compositionIdentifier, portIdentifier);
 }
 
+/**
+ * C wrapper for VuoNodeRegistry::getPortIndexForPort().
+ */
+unsigned long vuoGetPortIndexForPort(VuoCompositionState *compositionState, const char *portIdentifier)
+{
+	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
+	const char *compositionIdentifier = compositionState->compositionIdentifier;
+	return runtimeState->persistentState->nodeRegistry->getPortIndexForPort(compositionIdentifier, portIdentifier);
+}
+
 /**
  * C wrapper for VuoNodeRegistry::initContextForTopLevelComposition().
  *
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <atomic>
+
 class VuoRuntimePersistentState;
 #include "VuoCompositionState.h"
 #include "VuoCompositionDiff.hh"
@@ -46,10 +48,36 @@ private:
 		void (*compositionReleasePortData)(void *, unsigned long);
 	};
 
+	/**
+	 * The node contexts of one (sub)composition instance, indexed by node index.
+	 * Referenced by `VuoCompositionState::nodeContexts` so that looking up a node context
+	 * (on every node lock and unlock) doesn't need to hash the composition identifier or search a map.
+	 */
+	struct NodeContextTable
+	{
+		unsigned long compositionIndex;  ///< This table's index in @ref NodeContextTables::tables.
+		vector<NodeContext *> nodeContexts;  ///< Null for indices without a registered node context.
+		vector<NodeContextTable *> subcompositionTables;  ///< For each subcomposition node, the table for the subcomposition instance. Null for other nodes.
+	};
+
+	/**
+	 * The node-context tables for the top-level composition and each subcomposition instance.
+	 * Built once the node contexts have been initialized, and not modified after it's published in @ref nodeContextTables.
+	 */
+	struct NodeContextTables
+	{
+		vector<NodeContextTable *> tables;  ///< Each table, indexed by @ref NodeContextTable::compositionIndex.
+		map<string, NodeContextTable *> tableForComposition;  ///< Each table, indexed by composition identifier.
+		NodeContextTable *topLevelTable;  ///< The top-level composition's table.
+
+		~NodeContextTables(void);
+	};
+
 	map<string, vector<NodeMetadata> > nodeMetadatas;  ///< The metadata for each node, by composition identifier and node index. A node's index can change across a live-coding reload. This does not contain metadata for the top-level composition.
 
 	map<unsigned long, map<unsigned long, NodeContext *> > nodeContextForIndex;  ///< A registry of all NodeContext values in the running composition, indexed by hashed composition identifier and node index.
 	map<unsigned long, string> compositionIdentifierForHash;  ///< The composition identifier for each hash registered in `nodeContextForIndex`.
+	std::atomic<NodeContextTables *> nodeContextTables;  ///< The same node contexts as @ref nodeContextForIndex (except the top-level composition's), in flat arrays by node index. Null while the node contexts are being initialized or finalized.
 	map<string, map<string, void *> > dataForPort;  ///< The `data` field in the port's context, indexed by composition and port identifier.
 	map<string, map<string, unsigned long> > nodeIndexForPort;  ///< The index for a node, indexed by composition and port identifier.
 	map<string, map<string, unsigned long> > typeIndexForPort;  ///< The index for the port's type, indexed by composition and port identifier.
@@ -73,6 +101,9 @@ private:
 	unsigned long getNodeIndexForIdentifier(const string &compositionIdentifier, const string &nodeIdentifier);
 	const NodeMetadata * getNodeMetadataForPort(const string &compositionIdentifier, const string &portIdentifier);
 	string getCompositionIdentifierForHash(unsigned long compositionIdentifierHash);
+	const NodeContextTable * getNodeContextTable(VuoCompositionState *compositionState);
+	void publishNodeContextTables(void);
+	void unpublishNodeContextTables(void);
 	void addNodeContext(const char *compositionIdentifier, unsigned long nodeIndex, struct NodeContext *nodeContext);
 	void removeNodeContext(const char *compositionIdentifier, unsigned long nodeIndex);
 	void relocateNodeContext(const char *compositionIdentifier, unsigned long nodeIndex);
@@ -103,6 +134,7 @@ private:
 
 public:
 	VuoNodeRegistry(VuoRuntimePersistentState *persistentState);
+	~VuoNodeRegistry(void);
 	void updateCompositionSymbols(void *compositionBinaryHandle);
 
 	const char * defaultToTopLevelCompositionIdentifier(const char *compositionIdentifier);
@@ -116,10 +148,16 @@ public:
 	void addPortMetadata(const char *compositionIdentifier, const char *portIdentifier, const char *portName,
 						 unsigned long typeIndex, const char *initialValue);
 	NodeContext * getNodeContext(const char *compositionIdentifier, unsigned long nodeIndex);
+	NodeContext * getNodeContext(VuoCompositionState *compositionState, unsigned long nodeIndex);
+	VuoCompositionState * createSubcompositionState(VuoCompositionState *compositionState, unsigned long nodeIndex, const char *subcompositionIdentifier);
+	bool getCompositionIndex(VuoCompositionState *compositionState, unsigned long &compositionIndex);
+	bool getCompositionIndex(const string &compositionIdentifier, unsigned long &compositionIndex);
 	NodeContext * getCompositionContext(const char *compositionIdentifier);
 	void * getDataForPort(const char *compositionIdentifier, const char *portIdentifier);
 	unsigned long getNodeIndexForPort(const char *compositionIdentifier, const char *portIdentifier);
 	unsigned long getTypeIndexForPort(const char *compositionIdentifier, const char *portIdentifier);
+	unsigned long getPortIndexForPort(const char *compositionIdentifier, const char *portIdentifier);
+	bool getIndexesForPort(const string &compositionIdentifier, const string &portIdentifier, unsigned long &nodeIndex, unsigned long &portIndex);
 
 	void initContextForTopLevelComposition(VuoCompositionState *compositionState, bool hasInstanceData, unsigned long publishedOutputPortCount);
 	void finiContextForTopLevelComposition(VuoCompositionState *compositionState);
@@ -141,10 +179,12 @@ void vuoAddNodeMetadata(VuoCompositionState *compositionState, const char *nodeI
 void vuoAddPortMetadata(VuoCompositionState *compositionState, const char *portIdentifier, const char *portName,
 						unsigned long typeIndex, const char *initialValue);
 NodeContext * vuoGetNodeContext(VuoCompositionState *compositionState, unsigned long nodeIndex);
+VuoCompositionState * vuoCreateSubcompositionState(VuoCompositionState *compositionState, unsigned long nodeIndex, const char *subcompositionIdentifier);
 NodeContext * vuoGetCompositionContext(VuoCompositionState *compositionState);
 void * vuoGetDataForPort(VuoCompositionState *compositionState, const char *portIdentifier);
 unsigned long vuoGetNodeIndexForPort(VuoCompositionState *compositionState, const char *portIdentifier);
 unsigned long vuoGetTypeIndexForPort(VuoCompositionState *compositionState, const char *portIdentifier);
+unsigned long vuoGetPortIndexForPort(VuoCompositionState *compositionState, const char *portIdentifier);
 void vuoInitContextForTopLevelComposition(VuoCompositionState *compositionState, bool hasInstanceData, unsigned long publishedOutputPortCount);
 void vuoFiniContextForTopLevelComposition(VuoCompositionState *compositionState);
 }
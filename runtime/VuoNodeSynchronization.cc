@@ -13,14 +13,119 @@
 #include "VuoRuntimeState.hh"
 #include "VuoRuntimePersistentState.hh"
 
+/**
+ * The number of times to re-check a claimed node before blocking on its condition variable.
+ *
+ * Most nodes execute quickly, so a brief spin usually avoids a trip into the kernel.
+ */
+static const int VuoNodeSynchronization_spinCount = 100;
+
+/**
+ * Hints to the CPU that the current thread is busy-waiting.
+ */
+static inline void VuoNodeSynchronization_pause(void)
+{
+#if defined(__x86_64__)
+	__builtin_ia32_pause();
+#elif defined(__arm64__) || defined(__aarch64__)
+	__asm__ volatile("yield");
+#endif
+}
+
+/**
+ * Attempts to claim the node for @a eventId without waiting.
+ *
+ * Returns true if @a eventId now has (or already had) the claim.
+ */
+bool VuoNodeSynchronization::tryClaim(NodeContext *nodeContext, unsigned long eventId)
+{
+	unsigned long expected = 0;
+	if (__atomic_compare_exchange_n(&nodeContext->claimingEventId, &expected, eventId, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+		return true;
+
+	return expected == eventId;
+}
+
+/**
+ * Waits until @a eventId has claimed the node, first spinning briefly, then blocking on the node's condition variable.
+ *
+ * Call this after tryClaim() has failed.
+ */
+void VuoNodeSynchronization::claim(NodeContext *nodeContext, unsigned long eventId)
+{
+	for (int i = 0; i < VuoNodeSynchronization_spinCount; ++i)
+	{
+		VuoNodeSynchronization_pause();
+
+		unsigned long current = __atomic_load_n(&nodeContext->claimingEventId, __ATOMIC_RELAXED);
+		if ((current == 0 || current == eventId) && tryClaim(nodeContext, eventId))
+		{
+			claimStats.spinning.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+
+	// Register as a waiter before re-checking the claim, so that release() either sees the waiter
+	// (and notifies it) or this thread sees the released claim — never neither.
+	std::unique_lock<std::mutex> lock(* static_cast<std::mutex *>(nodeContext->nodeMutex));
+	__atomic_add_fetch(&nodeContext->claimWaiterCount, 1, __ATOMIC_SEQ_CST);
+	static_cast<std::condition_variable *>(nodeContext->nodeConditionVariable)->wait(lock, [nodeContext, eventId]()
+	{
+		return tryClaim(nodeContext, eventId);
+	});
+	__atomic_sub_fetch(&nodeContext->claimWaiterCount, 1, __ATOMIC_SEQ_CST);
+
+	claimStats.parked.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Relinquishes the claim on the node, waking all waiting threads if there are any.
+ *
+ * All waiters are woken (rather than just one) because each waiter's condition depends on its own event ID.
+ * A waiter for the same event as whichever thread takes the claim next can proceed too, so it mustn't be left parked.
+ *
+ * Returns the ID of the event that had the claim.
+ */
+unsigned long VuoNodeSynchronization::release(NodeContext *nodeContext)
+{
+	unsigned long eventId = __atomic_exchange_n(&nodeContext->claimingEventId, 0, __ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&nodeContext->claimWaiterCount, __ATOMIC_SEQ_CST) > 0)
+	{
+		// Lock the mutex so the notification can't slip in between a waiter's check and its wait.
+		std::lock_guard<std::mutex> lock(* static_cast<std::mutex *>(nodeContext->nodeMutex));
+		static_cast<std::condition_variable *>(nodeContext->nodeConditionVariable)->notify_all();
+	}
+
+	return eventId;
+}
+
 /**
  * Waits until @a eventId has claimed exclusive access to all of the given nodes.
  * The nodes should be passed in the same order as VuoCompilerBitcodeGenerator::orderedNodes.
+ *
+ * Uncontended nodes are claimed in a single pass. If a node is contended, this waits for it
+ * before moving on, so nodes are always claimed in order (which prevents deadlock).
  */
 void VuoNodeSynchronization::lockNodes(VuoCompositionState *compositionState, unsigned long *nodeIndices, unsigned long nodeCount, unsigned long eventId)
 {
+	unsigned long uncontendedCount = 0;
+
 	for (unsigned long i = 0; i < nodeCount; ++i)
-		lockNode(compositionState, nodeIndices[i], eventId);
+	{
+		recordWaiting(compositionState, eventId, nodeIndices[i]);
+
+		NodeContext *nodeContext = vuoGetNodeContext(compositionState, nodeIndices[i]);
+		if (tryClaim(nodeContext, eventId))
+			++uncontendedCount;
+		else
+			claim(nodeContext, eventId);
+
+		recordLocked(compositionState, eventId, nodeIndices[i]);
+	}
+
+	if (uncontendedCount > 0)
+		claimStats.uncontended.fetch_add(uncontendedCount, std::memory_order_relaxed);
 }
 
 /**
@@ -30,18 +135,11 @@ void VuoNodeSynchronization::lockNode(VuoCompositionState *compositionState, uns
 {
 	recordWaiting(compositionState, eventId, nodeIndex);
 
-	{
-		NodeContext *nodeContext = vuoGetNodeContext(compositionState, nodeIndex);
-
-		std::unique_lock<std::mutex> lock(* static_cast<std::mutex *>(nodeContext->nodeMutex));
-		static_cast<std::condition_variable *>(nodeContext->nodeConditionVariable)->wait(lock, [nodeContext, eventId]()
-		{
-			if (nodeContext->claimingEventId == 0)
-				nodeContext->claimingEventId = eventId;
-
-			return nodeContext->claimingEventId == eventId;
-		});
-	}
+	NodeContext *nodeContext = vuoGetNodeContext(compositionState, nodeIndex);
+	if (tryClaim(nodeContext, eventId))
+		claimStats.uncontended.fetch_add(1, std::memory_order_relaxed);
+	else
+		claim(nodeContext, eventId);
 
 	recordLocked(compositionState, eventId, nodeIndex);
 }
@@ -60,22 +158,23 @@ void VuoNodeSynchronization::unlockNodes(VuoCompositionState *compositionState,
  */
 void VuoNodeSynchronization::unlockNode(VuoCompositionState *compositionState, unsigned long nodeIndex)
 {
-	unsigned long eventId = 0;
-
-	{
-		NodeContext *nodeContext = vuoGetNodeContext(compositionState, nodeIndex);
-
-		std::unique_lock<std::mutex> lock(* static_cast<std::mutex *>(nodeContext->nodeMutex));
-
-		eventId = nodeContext->claimingEventId;
-		nodeContext->claimingEventId = 0;
-
-		static_cast<std::condition_variable *>(nodeContext->nodeConditionVariable)->notify_all();
-	}
+	NodeContext *nodeContext = vuoGetNodeContext(compositionState, nodeIndex);
+	unsigned long eventId = release(nodeContext);
 
 	recordUnlocked(compositionState, eventId, nodeIndex);
 }
 
+/**
+ * Outputs the number of node claims obtained on the first try, after spinning, and after blocking,
+ * since the composition started.
+ */
+void VuoNodeSynchronization::getClaimStats(unsigned long &uncontendedClaims, unsigned long &spinningClaims, unsigned long &parkedClaims)
+{
+	uncontendedClaims = claimStats.uncontended.load(std::memory_order_relaxed);
+	spinningClaims = claimStats.spinning.load(std::memory_order_relaxed);
+	parkedClaims = claimStats.parked.load(std::memory_order_relaxed);
+}
+
 /**
  * If debugging is enabled, records the node's change in status.
  */
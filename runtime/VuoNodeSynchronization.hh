@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include "VuoCompositionState.h"
 #include "VuoRuntimeContext.hh"
@@ -23,8 +24,13 @@ public:
 	void lockNode(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long eventId);
 	void unlockNodes(VuoCompositionState *compositionState, unsigned long *nodeIndices, unsigned long nodeCount);
 	void unlockNode(VuoCompositionState *compositionState, unsigned long nodeIndex);
+	void getClaimStats(unsigned long &uncontendedClaims, unsigned long &spinningClaims, unsigned long &parkedClaims);
 
 private:
+	static bool tryClaim(NodeContext *nodeContext, unsigned long eventId);
+	void claim(NodeContext *nodeContext, unsigned long eventId);
+	unsigned long release(NodeContext *nodeContext);
+
 	void recordWaiting(VuoCompositionState *compositionState, unsigned long eventId, unsigned long nodeIndex);
 	void recordLocked(VuoCompositionState *compositionState, unsigned long eventId, unsigned long nodeIndex);
 	void recordUnlocked(VuoCompositionState *compositionState, unsigned long eventId, unsigned long nodeIndex);
@@ -38,6 +44,17 @@ private:
 	map<string, map<unsigned long, vector<unsigned long>>> statusWaiting;
 	std::mutex statusMutex;
 	/// @}
+
+	/**
+	 * Counts of how node claims were obtained, for telemetry.
+	 * Kept on their own cache line so that updating them doesn't interfere with the debugging status.
+	 */
+	struct alignas(64) ClaimStats
+	{
+		std::atomic<unsigned long> uncontended{0};  ///< Claims obtained on the first try.
+		std::atomic<unsigned long> spinning{0};  ///< Claims obtained after spinning briefly.
+		std::atomic<unsigned long> parked{0};  ///< Claims obtained after blocking on the node's condition variable.
+	} claimStats;  ///< Counts of how node claims were obtained.
 };
 
 extern "C"
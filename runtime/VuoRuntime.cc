@@ -41,6 +41,7 @@ void vuoInit(int argc, char **argv)
 	bool continueIfRunnerDies = false;
 	bool doPrintHelp = false;
 	bool doPrintLicenses = false;
+	bool useWorkStealingScheduler = false;
 
 	// parse commandline arguments
 	{
@@ -70,6 +71,7 @@ void vuoInit(int argc, char **argv)
 			{"vuo-continue-if-runner-dies", no_argument, NULL, 0},
 			{"vuo-licenses", no_argument, NULL, 0},
 			{"vuo-runner-pid", required_argument, NULL, 0},
+			{"vuo-work-stealing-scheduler", no_argument, NULL, 0},
 			{NULL, no_argument, NULL, 0}
 		};
 		int optionIndex=-1;
@@ -111,6 +113,9 @@ void vuoInit(int argc, char **argv)
 				case 8:  // --vuo-runner-pid
 					runnerPid = atoi(optarg);
 					break;
+				case 9:  // --vuo-work-stealing-scheduler
+					useWorkStealingScheduler = true;
+					break;
 				default:
 					VUserLog("Error: Unknown option %d.", optionIndex);
 					break;
@@ -203,7 +208,7 @@ void vuoInit(int argc, char **argv)
 	}
 
 	vuoInitInProcess(NULL, controlURL, telemetryURL, isPaused, runnerPid, runnerPipe, continueIfRunnerDies, "",
-					 executableHandle, NULL, doAppInit);
+					 executableHandle, NULL, doAppInit, useWorkStealingScheduler);
 
 	dlclose(executableHandle);
 
@@ -228,10 +233,13 @@ void vuoInit(int argc, char **argv)
  * @param previousRuntimeState If the composition is restarting for a live-coding reload, pass the value returned by the previous
  *     call to @ref vuoFini(). Otherwise, pass null.
  * @param doAppInit Should we call VuoApp_init()?
+ * @param useWorkStealingScheduler If true, the composition's trigger and chain workers are scheduled with
+ *     VuoThreadManager::Scheduler_WorkStealing instead of VuoThreadManager::Scheduler_Dispatcher.
  */
 void vuoInitInProcess(void *ZMQContext, const char *controlURL, const char *telemetryURL, bool isPaused, pid_t runnerPid,
 					  int runnerPipe, bool continueIfRunnerDies, const char *workingDirectory,
-					  void *compositionBinaryHandle, void *previousRuntimeState, bool doAppInit)
+					  void *compositionBinaryHandle, void *previousRuntimeState, bool doAppInit,
+					  bool useWorkStealingScheduler)
 {
 	runtimeState = (VuoRuntimeState *)previousRuntimeState;
 	if (! runtimeState)
@@ -245,7 +253,7 @@ void vuoInitInProcess(void *ZMQContext, const char *controlURL, const char *tele
 
 	vuoRuntimeState = (void *)runtimeState;
 
-	VuoCompositionState *compositionState = new VuoCompositionState;
+	VuoCompositionState *compositionState = new VuoCompositionState();
 	compositionState->runtimeState = runtimeState;
 	compositionState->compositionIdentifier = "";
 	vuoAddCompositionStateToThreadLocalStorage(compositionState);
@@ -253,7 +261,7 @@ void vuoInitInProcess(void *ZMQContext, const char *controlURL, const char *tele
 	try
 	{
 		runtimeState->init(ZMQContext, controlURL, telemetryURL, isPaused, runnerPid, runnerPipe, continueIfRunnerDies,
-						   workingDirectory, compositionBinaryHandle);
+						   workingDirectory, compositionBinaryHandle, useWorkStealingScheduler);
 	}
 	catch (VuoException &e)
 	{
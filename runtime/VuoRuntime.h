@@ -21,11 +21,13 @@ void vuoInit(int argc, char **argv);
  */
 typedef void (VuoInitInProcessType)(void *ZMQContext, const char *controlURL, const char *telemetryURL, bool isPaused, pid_t runnerPid,
 									int runnerPipe, bool continueIfRunnerDies, const char *workingDirectory,
-									void *compositionBinaryHandle, void *runtimePersistentState, bool doAppInit);
+									void *compositionBinaryHandle, void *runtimePersistentState, bool doAppInit,
+									bool useWorkStealingScheduler);
 
 void vuoInitInProcess(void *ZMQContext, const char *controlURL, const char *telemetryURL, bool isPaused, pid_t runnerPid,
 					  int runnerPipe, bool continueIfRunnerDies, const char *workingDirectory,
-					  void *compositionBinaryHandle, void *previousRuntimeState, bool doAppInit);
+					  void *compositionBinaryHandle, void *previousRuntimeState, bool doAppInit,
+					  bool useWorkStealingScheduler);
 
 /**
  * Type for @ref vuoFini.
@@ -9,15 +9,245 @@
 
 #include "VuoRuntimeCommunicator.hh"
 
+#include <algorithm>
 #include <dlfcn.h>
+#include <pthread.h>
 #include <sstream>
 #include "VuoEventLoop.h"
 #include "VuoException.hh"
 #include "VuoHeap.h"
 #include "VuoNodeRegistry.hh"
+#include "VuoNodeSynchronization.hh"
+#include "VuoReaderPhases.hh"
 #include "VuoRuntimePersistentState.hh"
 #include "VuoRuntimeState.hh"
 
+/**
+ * Telemetry records appended by a single thread, waiting to be sent in the next @ref VuoTelemetryBatch.
+ */
+struct VuoTelemetryThreadBuffer
+{
+	pthread_t thread;		///< The thread that appends to this buffer.
+	std::atomic<int> referenceCount;	///< One reference held by the @ref VuoRuntimeCommunicator, plus one while the thread may still append.
+	std::mutex mutex;		///< Synchronizes access to @ref pending.  Only contended while a batch is being gathered.
+	vector<char> pending;	///< Records appended since the last batch, each a @ref VuoTelemetryPendingRecord followed by its strings.
+	vector<char> sending;	///< Records being gathered into the current batch.  Use only on the telemetry queue.
+};
+
+/**
+ * Gives up a reference to @a buffer, deleting it if that was the last reference.
+ */
+static void VuoTelemetryThreadBuffer_release(VuoTelemetryThreadBuffer *buffer)
+{
+	if (buffer->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		delete buffer;
+}
+
+/**
+ * The @ref VuoTelemetryThreadBuffer that the current thread is appending to. When the thread exits,
+ * its reference to the buffer is released, so the buffer can be deleted once its records have been sent.
+ */
+static pthread_key_t VuoRuntimeCommunicator_telemetryBufferKey;
+
+/**
+ * Called when a thread that has appended telemetry records exits.
+ */
+static void VuoRuntimeCommunicator_telemetryBufferThreadExited(void *buffer)
+{
+	VuoTelemetryThreadBuffer_release(static_cast<VuoTelemetryThreadBuffer *>(buffer));
+}
+
+/**
+ * Creates @ref VuoRuntimeCommunicator_telemetryBufferKey.
+ */
+static void VuoRuntimeCommunicator_createTelemetryBufferKey(void)
+{
+	pthread_key_create(&VuoRuntimeCommunicator_telemetryBufferKey, VuoRuntimeCommunicator_telemetryBufferThreadExited);
+}
+
+/**
+ * The fixed-size part of a record in a @ref VuoTelemetryThreadBuffer.
+ * It's followed by the null-terminated composition identifier, node or port identifier, and (optionally) port data summary.
+ */
+typedef struct
+{
+	unsigned long sequence;	///< The order in which the record was appended, across all threads.
+	uint32_t size;			///< The size of this record, including its strings.
+	uint8_t type;			///< The @ref VuoTelemetry type.
+	uint8_t flags;			///< A combination of @ref VuoTelemetryRecordFlag values.
+	bool hasPortDataSummary;	///< Whether the port data summary string is present.
+} VuoTelemetryPendingRecord;
+
+/**
+ * One (sub)composition's telemetry subscriptions, compiled from @ref VuoRuntimeCommunicator's subscription sets.
+ */
+struct VuoTelemetryCompositionSubscriptions
+{
+	bool isSendingAllTelemetry;  ///< True if all telemetry should be sent.
+	bool isSendingEventTelemetry;  ///< True if all telemetry about events (not including data) should be sent.
+	vector< vector<uint64_t> > portBitsForNode;  ///< The ports for which data-and-event telemetry should be sent, as bit `portIndex` of `portBitsForNode[nodeIndex]`.
+
+	/**
+	 * Returns true if data-and-event telemetry should be sent for the port at the given node index and port context index.
+	 */
+	bool isSendingPortDataTelemetry(unsigned long nodeIndex, unsigned long portIndex) const
+	{
+		if (nodeIndex >= portBitsForNode.size())
+			return false;
+
+		const vector<uint64_t> &portBits = portBitsForNode[nodeIndex];
+		unsigned long word = portIndex / 64;
+		return word < portBits.size() && (portBits[word] & (1ULL << (portIndex % 64)));
+	}
+};
+
+/**
+ * The telemetry subscriptions of the top-level composition and all subcomposition instances at one point in time.
+ *
+ * A snapshot is never modified after it's published; each (un)subscribe publishes a new one,
+ * so the snapshot can be read while sending telemetry without locking.
+ */
+struct VuoTelemetrySubscriptionSnapshot
+{
+	vector<VuoTelemetryCompositionSubscriptions *> compositions;  ///< Indexed by VuoNodeRegistry::getCompositionIndex(). Null for compositions without subscriptions. Owned by the snapshot.
+
+	~VuoTelemetrySubscriptionSnapshot(void)
+	{
+		for (VuoTelemetryCompositionSubscriptions *composition : compositions)
+			delete composition;
+	}
+};
+
+/**
+ * The number of @ref VuoTelemetrySubscriptions::readerCounts. All but the last are each used by a single thread at a time;
+ * threads beyond that share the last.
+ */
+static const unsigned int VuoTelemetrySubscriptions_readerCountsCount = 64;
+
+/**
+ * The current @ref VuoTelemetrySubscriptionSnapshot for the composition.
+ *
+ * Threads sending telemetry read the snapshot via @ref VuoTelemetrySubscriptionReader, which counts each of them
+ * in its own element of @ref readerCounts. When a snapshot is replaced, the writer waits (via @ref readerPhases)
+ * until every reader that might have loaded it has finished, then deletes it.
+ */
+struct VuoTelemetrySubscriptions
+{
+	std::atomic<VuoTelemetrySubscriptionSnapshot *> snapshot;  ///< Null if nothing in the composition is subscribed to telemetry.
+	VuoReaderPhases readerPhases;  ///< Lets the writer wait for readers.
+	VuoReaderPhases::Counts readerCounts[VuoTelemetrySubscriptions_readerCountsCount];  ///< Indexed by @ref VuoTelemetrySubscriptions_getReaderCountsIndex.
+};
+
+static std::atomic<uint64_t> VuoTelemetrySubscriptions_claimedReaderCounts(0);  ///< Bit `i` is set if a thread is using element `i` of @ref VuoTelemetrySubscriptions::readerCounts.
+
+/**
+ * Claims an element of @ref VuoTelemetrySubscriptions::readerCounts for the current thread, and releases it when the thread exits.
+ */
+class VuoTelemetrySubscriptionsReaderCountsClaim
+{
+public:
+	unsigned int index;  ///< The claimed element.
+
+	/**
+	 * Claims the lowest unclaimed element, or the shared last element if all others are claimed.
+	 */
+	VuoTelemetrySubscriptionsReaderCountsClaim(void)
+	{
+		const uint64_t sharedBit = 1ULL << (VuoTelemetrySubscriptions_readerCountsCount - 1);
+		uint64_t claimed = VuoTelemetrySubscriptions_claimedReaderCounts.load();
+		do
+		{
+			uint64_t unclaimed = ~claimed & ~sharedBit;
+			if (! unclaimed)
+			{
+				index = VuoTelemetrySubscriptions_readerCountsCount - 1;
+				return;
+			}
+
+			index = __builtin_ctzll(unclaimed);
+		} while (! VuoTelemetrySubscriptions_claimedReaderCounts.compare_exchange_weak(claimed, claimed | (1ULL << index)));
+	}
+
+	/**
+	 * Releases the element.
+	 */
+	~VuoTelemetrySubscriptionsReaderCountsClaim(void)
+	{
+		if (index != VuoTelemetrySubscriptions_readerCountsCount - 1)
+			VuoTelemetrySubscriptions_claimedReaderCounts.fetch_and(~(1ULL << index));
+	}
+};
+
+/**
+ * Returns the element of @ref VuoTelemetrySubscriptions::readerCounts that the current thread should use.
+ */
+static unsigned int VuoTelemetrySubscriptions_getReaderCountsIndex(void)
+{
+	static thread_local VuoTelemetrySubscriptionsReaderCountsClaim claim;
+	return claim.index;
+}
+
+/**
+ * Loads the current snapshot of a @ref VuoTelemetrySubscriptions, and keeps it from being deleted while this is in scope.
+ *
+ * Keep the scope short — replacing the snapshot waits for it.
+ */
+class VuoTelemetrySubscriptionReader
+{
+public:
+	const VuoTelemetryCompositionSubscriptions *composition;  ///< Null if nothing in the (sub)composition is subscribed to telemetry.
+
+	/**
+	 * Starts reading the subscriptions for the (sub)composition that @a compositionState refers to.
+	 *
+	 * If nothing in the composition is subscribed to telemetry, this is just a load of the snapshot pointer.
+	 */
+	VuoTelemetrySubscriptionReader(VuoTelemetrySubscriptions *subscriptions, VuoNodeRegistry *nodeRegistry, VuoCompositionState *compositionState)
+	{
+		this->subscriptions = subscriptions;
+		composition = NULL;
+		counts = NULL;
+
+		if (! subscriptions->snapshot.load(std::memory_order_relaxed))
+			return;
+
+		unsigned long compositionIndex;
+		if (! nodeRegistry->getCompositionIndex(compositionState, compositionIndex))
+			return;
+
+		unsigned int countsIndex = VuoTelemetrySubscriptions_getReaderCountsIndex();
+		counts = &subscriptions->readerCounts[countsIndex];
+		isShared = (countsIndex == VuoTelemetrySubscriptions_readerCountsCount - 1);
+		phase = isShared ? subscriptions->readerPhases.beginReading(*counts) : subscriptions->readerPhases.beginReadingOnThread(*counts);
+
+		VuoTelemetrySubscriptionSnapshot *snapshot = subscriptions->snapshot.load();
+		if (snapshot && compositionIndex < snapshot->compositions.size())
+			composition = snapshot->compositions[compositionIndex];
+	}
+
+	/**
+	 * Finishes reading.
+	 */
+	~VuoTelemetrySubscriptionReader(void)
+	{
+		if (! counts)
+			return;
+
+		if (isShared)
+			subscriptions->readerPhases.endReading(*counts, phase);
+		else
+			subscriptions->readerPhases.endReadingOnThread(*counts, phase);
+	}
+
+private:
+	VuoTelemetrySubscriptions *subscriptions;  ///< The subscriptions being read.
+	VuoReaderPhases::Counts *counts;  ///< The counts in which this reader counted itself, or null if it didn't need to.
+	bool isShared;  ///< True if @ref counts may be used by other threads at the same time.
+	unsigned int phase;  ///< The phase in which this reader counted itself.
+};
+
+static std::atomic<unsigned long> VuoRuntimeCommunicator_nextTelemetryBufferGeneration(1);  ///< See @ref VuoRuntimeCommunicator::telemetryBufferGeneration.
+
 /**
  * Constructor. Does not take ownership of @a persistentState.
  */
@@ -42,6 +272,15 @@ VuoRuntimeCommunicator::VuoRuntimeCommunicator(VuoRuntimePersistentState *persis
 
 	runnerPipe = -1;
 
+	isBatchingTelemetry = false;
+	telemetryBatchTimer = NULL;
+	telemetryBufferGeneration = VuoRuntimeCommunicator_nextTelemetryBufferGeneration++;
+	telemetrySequence = 0;
+	telemetrySubscriptions = new VuoTelemetrySubscriptions;
+	telemetrySubscriptions->snapshot = NULL;
+
+	sentClaimStats[0] = sentClaimStats[1] = sentClaimStats[2] = 0;
+
 	vuoInstanceInit = NULL;
 	vuoInstanceTriggerStart = NULL;
 	vuoInstanceTriggerStop = NULL;
@@ -69,6 +308,13 @@ VuoRuntimeCommunicator::~VuoRuntimeCommunicator(void)
 	dispatch_release(telemetryQueue);
 	dispatch_release(controlCanceled);
 	dispatch_release(telemetryCanceled);
+
+	// Any buffers still in use by threads are deleted when those threads exit.
+	for (VuoTelemetryThreadBuffer *buffer : telemetryBuffers)
+		VuoTelemetryThreadBuffer_release(buffer);
+
+	delete telemetrySubscriptions->snapshot.load();
+	delete telemetrySubscriptions;
 }
 
 /**
@@ -310,19 +556,252 @@ void VuoRuntimeCommunicator::sendTelemetry(enum VuoTelemetry type, zmq_msg_t *me
 
 	dispatch_sync(telemetryQueue, ^{
 		vuoMemoryBarrier();
+
+		// Send any batched telemetry first, so that it isn't reordered relative to this message.
+		if (isBatchingTelemetry)
+			sendTelemetryBatch();
+
 		vuoSend("VuoTelemetry",zmqTelemetry,type,messages,messageCount,true,NULL);
 	});
 }
 
+/**
+ * Starts sending node execution and port update telemetry in batches (@ref VuoTelemetryBatch), about once per frame,
+ * instead of sending a separate message for each.
+ *
+ * @threadQueue{VuoControlQueue}
+ */
+void VuoRuntimeCommunicator::enableTelemetryBatching(void)
+{
+	if (! zmqTelemetry || isBatchingTelemetry)
+		return;
+
+	telemetryBatchTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, telemetryQueue);
+	dispatch_source_set_timer(telemetryBatchTimer, dispatch_walltime(NULL, 0), NSEC_PER_SEC/60, NSEC_PER_SEC/600);
+	dispatch_source_set_event_handler(telemetryBatchTimer, ^{
+		vuoMemoryBarrier();
+		sendTelemetryBatch();
+	});
+	dispatch_resume(telemetryBatchTimer);
+
+	isBatchingTelemetry = true;
+}
+
+/**
+ * Returns the buffer to which the current thread should append telemetry records, creating it if needed.
+ *
+ * @threadAny
+ */
+VuoTelemetryThreadBuffer * VuoRuntimeCommunicator::getTelemetryBufferForCurrentThread(void)
+{
+	static thread_local unsigned long bufferGeneration = 0;
+
+	if (bufferGeneration != telemetryBufferGeneration)
+	{
+		// This thread hasn't used this instance's buffers recently.
+		static pthread_once_t createKeyOnce = PTHREAD_ONCE_INIT;
+		pthread_once(&createKeyOnce, VuoRuntimeCommunicator_createTelemetryBufferKey);
+
+		pthread_t thread = pthread_self();
+		VuoTelemetryThreadBuffer *buffer;
+		{
+			std::lock_guard<std::mutex> guard(telemetryBuffersMutex);
+
+			auto existing = std::find_if(telemetryBuffers.begin(), telemetryBuffers.end(), [thread](VuoTelemetryThreadBuffer *b){
+				return pthread_equal(b->thread, thread);
+			});
+			if (existing != telemetryBuffers.end())
+			{
+				buffer = *existing;
+				buffer->referenceCount.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				buffer = new VuoTelemetryThreadBuffer;
+				buffer->thread = thread;
+				buffer->referenceCount = 2;
+				telemetryBuffers.push_back(buffer);
+			}
+		}
+
+		// Let go of the buffer that this thread was using for another instance, if any.
+		VuoTelemetryThreadBuffer *previous = static_cast<VuoTelemetryThreadBuffer *>(pthread_getspecific(VuoRuntimeCommunicator_telemetryBufferKey));
+		pthread_setspecific(VuoRuntimeCommunicator_telemetryBufferKey, buffer);
+		if (previous)
+			VuoTelemetryThreadBuffer_release(previous);
+
+		bufferGeneration = telemetryBufferGeneration;
+	}
+
+	return static_cast<VuoTelemetryThreadBuffer *>(pthread_getspecific(VuoRuntimeCommunicator_telemetryBufferKey));
+}
+
+/**
+ * Adds a record to the current thread's buffer, to be sent in the next @ref VuoTelemetryBatch.
+ *
+ * @threadAny
+ */
+void VuoRuntimeCommunicator::appendTelemetryRecord(enum VuoTelemetry type, const char *compositionIdentifier, const char *identifier, uint8_t flags, const char *portDataSummary)
+{
+	size_t compositionIdentifierSize = strlen(compositionIdentifier) + 1;
+	size_t identifierSize = strlen(identifier) + 1;
+	size_t portDataSummarySize = portDataSummary ? strlen(portDataSummary) + 1 : 0;
+
+	VuoTelemetryPendingRecord header;
+	header.size = (uint32_t)(sizeof header + compositionIdentifierSize + identifierSize + portDataSummarySize);
+	header.type = type;
+	header.flags = flags;
+	header.hasPortDataSummary = portDataSummary != NULL;
+
+	VuoTelemetryThreadBuffer *buffer = getTelemetryBufferForCurrentThread();
+	std::lock_guard<std::mutex> guard(buffer->mutex);
+
+	// Number the record while holding the lock, so that sendTelemetryBatch() (which holds all buffers' locks at once)
+	// either gathers it or only gathers records with lower numbers.
+	header.sequence = telemetrySequence.fetch_add(1, std::memory_order_relaxed);
+
+	size_t offset = buffer->pending.size();
+	buffer->pending.resize(offset + header.size);
+	char *record = &buffer->pending[offset];
+	memcpy(record, &header, sizeof header);
+	record += sizeof header;
+	memcpy(record, compositionIdentifier, compositionIdentifierSize);
+	record += compositionIdentifierSize;
+	memcpy(record, identifier, identifierSize);
+	record += identifierSize;
+	if (portDataSummary)
+		memcpy(record, portDataSummary, portDataSummarySize);
+}
+
+/**
+ * Gathers the records that all threads have appended since the last batch,
+ * and sends them in a single @ref VuoTelemetryBatch message.
+ *
+ * @threadQueue{VuoTelemetryQueue}
+ */
+void VuoRuntimeCommunicator::sendTelemetryBatch(void)
+{
+	vector<VuoTelemetryThreadBuffer *> buffersGathered;
+	vector<VuoTelemetryThreadBuffer *> buffersAbandoned;
+	{
+		std::lock_guard<std::mutex> buffersGuard(telemetryBuffersMutex);
+
+		// Hold all buffers' locks at once, so that no thread can append a record numbered lower than
+		// one in this batch after the batch has been gathered. (Appending only takes one buffer's lock.)
+		vector< std::unique_lock<std::mutex> > guards;
+		guards.reserve(telemetryBuffers.size());
+		for (VuoTelemetryThreadBuffer *buffer : telemetryBuffers)
+			guards.emplace_back(buffer->mutex);
+
+		for (auto i = telemetryBuffers.begin(); i != telemetryBuffers.end(); )
+		{
+			VuoTelemetryThreadBuffer *buffer = *i;
+			if (! buffer->pending.empty())
+			{
+				// Swap rather than copy, so both vectors keep their capacity for reuse.
+				buffer->pending.swap(buffer->sending);
+				buffersGathered.push_back(buffer);
+			}
+
+			// If the buffer's thread has exited (or moved on to another instance), it won't append any more records,
+			// so the buffer can be deleted once this batch has been sent.
+			if (buffer->referenceCount.load(std::memory_order_acquire) == 1)
+			{
+				buffersAbandoned.push_back(buffer);
+				i = telemetryBuffers.erase(i);
+			}
+			else
+				++i;
+		}
+	}
+
+	if (buffersGathered.empty())
+	{
+		for (VuoTelemetryThreadBuffer *buffer : buffersAbandoned)
+			VuoTelemetryThreadBuffer_release(buffer);
+		return;
+	}
+
+	// Restore the order in which the records were appended.
+	vector< pair<unsigned long, const char *> > pendingRecords;
+	for (VuoTelemetryThreadBuffer *buffer : buffersGathered)
+		for (size_t offset = 0; offset < buffer->sending.size(); )
+		{
+			VuoTelemetryPendingRecord header;
+			memcpy(&header, &buffer->sending[offset], sizeof header);
+			pendingRecords.push_back(make_pair(header.sequence, &buffer->sending[offset]));
+			offset += header.size;
+		}
+	std::sort(pendingRecords.begin(), pendingRecords.end());
+
+	// Send each distinct string once, and refer to it by index.
+	vector<char> strings;
+	map<string, uint32_t> stringIndices;
+	auto intern = [&strings, &stringIndices](const char *s) -> uint32_t {
+		auto i = stringIndices.find(s);
+		if (i != stringIndices.end())
+			return i->second;
+
+		uint32_t index = (uint32_t)stringIndices.size();
+		stringIndices[s] = index;
+		strings.insert(strings.end(), s, s + strlen(s) + 1);
+		return index;
+	};
+
+	vector<VuoTelemetryRecord> records;
+	records.reserve(pendingRecords.size());
+	for (auto &pendingRecord : pendingRecords)
+	{
+		VuoTelemetryPendingRecord header;
+		memcpy(&header, pendingRecord.second, sizeof header);
+		const char *compositionIdentifier = pendingRecord.second + sizeof header;
+		const char *identifier = compositionIdentifier + strlen(compositionIdentifier) + 1;
+
+		VuoTelemetryRecord record;
+		record.type = header.type;
+		record.flags = header.flags;
+		record.reserved = 0;
+		record.compositionIdentifier = intern(compositionIdentifier);
+		record.identifier = intern(identifier);
+		record.portDataSummary = header.hasPortDataSummary ? intern(identifier + strlen(identifier) + 1) : VuoTelemetryRecord_noSummary;
+		records.push_back(record);
+	}
+
+	for (VuoTelemetryThreadBuffer *buffer : buffersGathered)
+		buffer->sending.clear();
+	for (VuoTelemetryThreadBuffer *buffer : buffersAbandoned)
+		VuoTelemetryThreadBuffer_release(buffer);
+
+	zmq_msg_t messages[2];
+	zmq_msg_init_size(&messages[0], strings.size());
+	memcpy(zmq_msg_data(&messages[0]), strings.data(), strings.size());
+	zmq_msg_init_size(&messages[1], records.size() * sizeof(VuoTelemetryRecord));
+	memcpy(zmq_msg_data(&messages[1]), records.data(), records.size() * sizeof(VuoTelemetryRecord));
+
+	vuoSend("VuoTelemetry", zmqTelemetry, VuoTelemetryBatch, messages, 2, true, NULL);
+}
+
 /**
  * Constructs and sends a message on the telemetry socket, indicating that a node has started execution.
  *
  * @version200Changed{Added `compositionIdentifier` argument.}
  */
-void VuoRuntimeCommunicator::sendNodeExecutionStarted(const char *compositionIdentifier, const char *nodeIdentifier)
+void VuoRuntimeCommunicator::sendNodeExecutionStarted(VuoCompositionState *compositionState, const char *nodeIdentifier)
 {
-	if (! (isSubscribedToAllTelemetry(compositionIdentifier) || isSubscribedToEventTelemetry(compositionIdentifier)))
+	{
+		VuoTelemetrySubscriptionReader reader(telemetrySubscriptions, persistentState->nodeRegistry, compositionState);
+		const VuoTelemetryCompositionSubscriptions *subscriptions = reader.composition;
+		if (! (subscriptions && (subscriptions->isSendingAllTelemetry || subscriptions->isSendingEventTelemetry)))
+			return;
+	}
+
+	const char *compositionIdentifier = compositionState->compositionIdentifier;
+
+	if (isBatchingTelemetry)
+	{
+		appendTelemetryRecord(VuoTelemetryNodeExecutionStarted, compositionIdentifier, nodeIdentifier, 0, NULL);
 		return;
+	}
 
 	zmq_msg_t messages[2];
 	vuoInitMessageWithString(&messages[0], compositionIdentifier);
@@ -336,10 +815,22 @@ void VuoRuntimeCommunicator::sendNodeExecutionStarted(const char *compositionIde
  *
  * @version200Changed{Added `compositionIdentifier` argument.}
  */
-void VuoRuntimeCommunicator::sendNodeExecutionFinished(const char *compositionIdentifier, const char *nodeIdentifier)
+void VuoRuntimeCommunicator::sendNodeExecutionFinished(VuoCompositionState *compositionState, const char *nodeIdentifier)
 {
-	if (! (isSubscribedToAllTelemetry(compositionIdentifier) || isSubscribedToEventTelemetry(compositionIdentifier)))
+	{
+		VuoTelemetrySubscriptionReader reader(telemetrySubscriptions, persistentState->nodeRegistry, compositionState);
+		const VuoTelemetryCompositionSubscriptions *subscriptions = reader.composition;
+		if (! (subscriptions && (subscriptions->isSendingAllTelemetry || subscriptions->isSendingEventTelemetry)))
+			return;
+	}
+
+	const char *compositionIdentifier = compositionState->compositionIdentifier;
+
+	if (isBatchingTelemetry)
+	{
+		appendTelemetryRecord(VuoTelemetryNodeExecutionFinished, compositionIdentifier, nodeIdentifier, 0, NULL);
 		return;
+	}
 
 	zmq_msg_t messages[2];
 	vuoInitMessageWithString(&messages[0], compositionIdentifier);
@@ -351,14 +842,36 @@ void VuoRuntimeCommunicator::sendNodeExecutionFinished(const char *compositionId
 /**
  * Constructs and sends a message on the telemetry socket, indicating that an input port has received an event and/or data.
  *
+ * @a nodeIndex and @a portIndex locate the port (as in @ref shouldSendPortDataTelemetry(VuoCompositionState *, unsigned long, unsigned long))
+ * for checking its subscriptions; @a portIdentifier identifies it in the message.
+ *
  * @version200Changed{Added `compositionIdentifier` argument.}
  */
-void VuoRuntimeCommunicator::sendInputPortsUpdated(const char *compositionIdentifier, const char *portIdentifier, bool receivedEvent, bool receivedData, const char *portDataSummary)
+void VuoRuntimeCommunicator::sendInputPortsUpdated(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier, bool receivedEvent, bool receivedData, const char *portDataSummary)
 {
-	bool isSendingAllTelemetry = isSubscribedToAllTelemetry(compositionIdentifier);
-	bool isSendingPortTelemetry = isSubscribedToPortDataTelemetry(compositionIdentifier, portIdentifier);
-	if (! (isSendingAllTelemetry || isSubscribedToEventTelemetry(compositionIdentifier) || isSendingPortTelemetry))
+	bool isSendingAllTelemetry;
+	bool isSendingPortTelemetry;
+	{
+		VuoTelemetrySubscriptionReader reader(telemetrySubscriptions, persistentState->nodeRegistry, compositionState);
+		const VuoTelemetryCompositionSubscriptions *subscriptions = reader.composition;
+		if (! subscriptions)
+			return;
+
+		isSendingAllTelemetry = subscriptions->isSendingAllTelemetry;
+		isSendingPortTelemetry = subscriptions->isSendingPortDataTelemetry(nodeIndex, portIndex);
+		if (! (isSendingAllTelemetry || subscriptions->isSendingEventTelemetry || isSendingPortTelemetry))
+			return;
+	}
+
+	const char *compositionIdentifier = compositionState->compositionIdentifier;
+
+	if (isBatchingTelemetry)
+	{
+		uint8_t flags = (receivedEvent ? VuoTelemetryRecordFlagEvent : 0) | (receivedData ? VuoTelemetryRecordFlagData : 0);
+		appendTelemetryRecord(VuoTelemetryInputPortsUpdated, compositionIdentifier, portIdentifier, flags,
+							  (portDataSummary && (isSendingAllTelemetry || isSendingPortTelemetry)) ? portDataSummary : NULL);
 		return;
+	}
 
 	zmq_msg_t messages[5];
 	vuoInitMessageWithString(&messages[0], compositionIdentifier);
@@ -373,14 +886,35 @@ void VuoRuntimeCommunicator::sendInputPortsUpdated(const char *compositionIdenti
 /**
  * Constructs and sends a message on the telemetry socket, indicating that an output port has transmitted/fired an event and/or data.
  *
+ * @a nodeIndex and @a portIndex locate the port, as in @ref sendInputPortsUpdated.
+ *
  * @version200Changed{Added `compositionIdentifier`, `sentEvent` arguments.}
  */
-void VuoRuntimeCommunicator::sendOutputPortsUpdated(const char *compositionIdentifier, const char *portIdentifier, bool sentEvent, bool sentData, const char *portDataSummary)
+void VuoRuntimeCommunicator::sendOutputPortsUpdated(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier, bool sentEvent, bool sentData, const char *portDataSummary)
 {
-	bool isSendingAllTelemetry = isSubscribedToAllTelemetry(compositionIdentifier);
-	bool isSendingPortTelemetry = isSubscribedToPortDataTelemetry(compositionIdentifier, portIdentifier);
-	if (! (isSendingAllTelemetry || isSubscribedToEventTelemetry(compositionIdentifier) || isSendingPortTelemetry))
+	bool isSendingAllTelemetry;
+	bool isSendingPortTelemetry;
+	{
+		VuoTelemetrySubscriptionReader reader(telemetrySubscriptions, persistentState->nodeRegistry, compositionState);
+		const VuoTelemetryCompositionSubscriptions *subscriptions = reader.composition;
+		if (! subscriptions)
+			return;
+
+		isSendingAllTelemetry = subscriptions->isSendingAllTelemetry;
+		isSendingPortTelemetry = subscriptions->isSendingPortDataTelemetry(nodeIndex, portIndex);
+		if (! (isSendingAllTelemetry || subscriptions->isSendingEventTelemetry || isSendingPortTelemetry))
+			return;
+	}
+
+	const char *compositionIdentifier = compositionState->compositionIdentifier;
+
+	if (isBatchingTelemetry)
+	{
+		uint8_t flags = (sentEvent ? VuoTelemetryRecordFlagEvent : 0) | (sentData ? VuoTelemetryRecordFlagData : 0);
+		appendTelemetryRecord(VuoTelemetryOutputPortsUpdated, compositionIdentifier, portIdentifier, flags,
+							  (portDataSummary && (isSendingAllTelemetry || isSendingPortTelemetry)) ? portDataSummary : NULL);
 		return;
+	}
 
 	zmq_msg_t messages[5];
 	vuoInitMessageWithString(&messages[0], compositionIdentifier);
@@ -421,16 +955,22 @@ void VuoRuntimeCommunicator::sendEventFinished(unsigned long eventId, NodeContex
 /**
  * Constructs and sends a message on the telemetry socket, indicating that a trigger port has dropped an event.
  *
+ * @a nodeIndex and @a portIndex locate the port, as in @ref sendInputPortsUpdated.
+ *
  * @version200Changed{Added `compositionIdentifier` argument.}
  */
-void VuoRuntimeCommunicator::sendEventDropped(const char *compositionIdentifier, const char *portIdentifier)
+void VuoRuntimeCommunicator::sendEventDropped(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier)
 {
-	bool isSendingPortTelemetry = isSubscribedToPortDataTelemetry(compositionIdentifier, portIdentifier);
-	if (! (isSubscribedToAllTelemetry(compositionIdentifier) || isSubscribedToEventTelemetry(compositionIdentifier) || isSendingPortTelemetry))
-		return;
+	{
+		VuoTelemetrySubscriptionReader reader(telemetrySubscriptions, persistentState->nodeRegistry, compositionState);
+		const VuoTelemetryCompositionSubscriptions *subscriptions = reader.composition;
+		if (! (subscriptions && (subscriptions->isSendingAllTelemetry || subscriptions->isSendingEventTelemetry ||
+								 subscriptions->isSendingPortDataTelemetry(nodeIndex, portIndex))))
+			return;
+	}
 
 	zmq_msg_t messages[2];
-	vuoInitMessageWithString(&messages[0], compositionIdentifier);
+	vuoInitMessageWithString(&messages[0], compositionState->compositionIdentifier);
 	vuoInitMessageWithString(&messages[1], portIdentifier);
 
 	sendTelemetry(VuoTelemetryEventDropped, messages, 2);
@@ -474,7 +1014,9 @@ void VuoRuntimeCommunicator::sendCompositionStoppingAndCloseControl(void)
  */
 void VuoRuntimeCommunicator::subscribeToPortDataTelemetry(const char *compositionIdentifier, const char *portIdentifer)
 {
+	std::lock_guard<std::mutex> lock(telemetrySubscriptionsMutex);
 	portsSendingDataTelemetry[compositionIdentifier].insert(portIdentifer);
+	updateTelemetrySubscriptions();
 }
 
 /**
@@ -482,6 +1024,7 @@ void VuoRuntimeCommunicator::subscribeToPortDataTelemetry(const char *compositio
  */
 void VuoRuntimeCommunicator::unsubscribeFromPortDataTelemetry(const char *compositionIdentifier, const char *portIdentifer)
 {
+	std::lock_guard<std::mutex> lock(telemetrySubscriptionsMutex);
 	map<string, set<string> >::iterator iter1 = portsSendingDataTelemetry.find(compositionIdentifier);
 	if (iter1 != portsSendingDataTelemetry.end())
 	{
@@ -493,18 +1036,7 @@ void VuoRuntimeCommunicator::unsubscribeFromPortDataTelemetry(const char *compos
 				portsSendingDataTelemetry.erase(iter1);
 		}
 	}
-}
-
-/**
- * Returns true if this port is subscribed to telemetry.
- */
-bool VuoRuntimeCommunicator::isSubscribedToPortDataTelemetry(const char *compositionIdentifier, const char *portIdentifer)
-{
-	map<string, set<string> >::iterator iter = portsSendingDataTelemetry.find(compositionIdentifier);
-	if (iter != portsSendingDataTelemetry.end())
-		return (iter->second.find(portIdentifer) != iter->second.end());
-
-	return false;
+	updateTelemetrySubscriptions();
 }
 
 /**
@@ -512,7 +1044,9 @@ bool VuoRuntimeCommunicator::isSubscribedToPortDataTelemetry(const char *composi
  */
 void VuoRuntimeCommunicator::subscribeToEventTelemetry(const char *compositionIdentifier)
 {
+	std::lock_guard<std::mutex> lock(telemetrySubscriptionsMutex);
 	compositionsSendingEventTelemetry.insert(compositionIdentifier);
+	updateTelemetrySubscriptions();
 }
 
 /**
@@ -520,18 +1054,9 @@ void VuoRuntimeCommunicator::subscribeToEventTelemetry(const char *compositionId
  */
 void VuoRuntimeCommunicator::unsubscribeFromEventTelemetry(const char *compositionIdentifier)
 {
-	set<string>::iterator iter = compositionsSendingEventTelemetry.find(compositionIdentifier);
-	if (iter != compositionsSendingEventTelemetry.end())
-		compositionsSendingEventTelemetry.erase(iter);
-}
-
-/**
- * Returns true if the (sub)composition instance is subscribed to event telemetry.
- */
-bool VuoRuntimeCommunicator::isSubscribedToEventTelemetry(const char *compositionIdentifier)
-{
-	set<string>::iterator iter = compositionsSendingEventTelemetry.find(compositionIdentifier);
-	return (iter != compositionsSendingEventTelemetry.end());
+	std::lock_guard<std::mutex> lock(telemetrySubscriptionsMutex);
+	compositionsSendingEventTelemetry.erase(compositionIdentifier);
+	updateTelemetrySubscriptions();
 }
 
 /**
@@ -539,7 +1064,9 @@ bool VuoRuntimeCommunicator::isSubscribedToEventTelemetry(const char *compositio
  */
 void VuoRuntimeCommunicator::subscribeToAllTelemetry(const char *compositionIdentifier)
 {
+	std::lock_guard<std::mutex> lock(telemetrySubscriptionsMutex);
 	compositionsSendingAllTelemetry.insert(compositionIdentifier);
+	updateTelemetrySubscriptions();
 }
 
 /**
@@ -547,28 +1074,108 @@ void VuoRuntimeCommunicator::subscribeToAllTelemetry(const char *compositionIden
  */
 void VuoRuntimeCommunicator::unsubscribeFromAllTelemetry(const char *compositionIdentifier)
 {
-	set<string>::iterator iter = compositionsSendingAllTelemetry.find(compositionIdentifier);
-	if (iter != compositionsSendingAllTelemetry.end())
-		compositionsSendingAllTelemetry.erase(iter);
+	std::lock_guard<std::mutex> lock(telemetrySubscriptionsMutex);
+	compositionsSendingAllTelemetry.erase(compositionIdentifier);
+	updateTelemetrySubscriptions();
+}
+
+/**
+ * Compiles the subscription sets for all (sub)compositions into a new @ref VuoTelemetrySubscriptionSnapshot
+ * and publishes it, resolving each (sub)composition identifier and subscribed port identifier to the indexes
+ * that the generated code passes when sending telemetry.
+ *
+ * Call only while holding @ref telemetrySubscriptionsMutex.
+ */
+void VuoRuntimeCommunicator::updateTelemetrySubscriptions(void)
+{
+	set<string> compositionIdentifiers(compositionsSendingAllTelemetry.begin(), compositionsSendingAllTelemetry.end());
+	compositionIdentifiers.insert(compositionsSendingEventTelemetry.begin(), compositionsSendingEventTelemetry.end());
+	for (auto &i : portsSendingDataTelemetry)
+		compositionIdentifiers.insert(i.first);
+
+	VuoTelemetrySubscriptionSnapshot *snapshot = NULL;
+	for (const string &compositionIdentifier : compositionIdentifiers)
+	{
+		unsigned long compositionIndex;
+		if (! persistentState->nodeRegistry->getCompositionIndex(compositionIdentifier, compositionIndex))
+			continue;
+
+		VuoTelemetryCompositionSubscriptions *composition = new VuoTelemetryCompositionSubscriptions;
+		composition->isSendingAllTelemetry = compositionsSendingAllTelemetry.find(compositionIdentifier) != compositionsSendingAllTelemetry.end();
+		composition->isSendingEventTelemetry = compositionsSendingEventTelemetry.find(compositionIdentifier) != compositionsSendingEventTelemetry.end();
+
+		map<string, set<string> >::iterator portsIter = portsSendingDataTelemetry.find(compositionIdentifier);
+		if (portsIter != portsSendingDataTelemetry.end())
+		{
+			for (const string &portIdentifier : portsIter->second)
+			{
+				unsigned long nodeIndex;
+				unsigned long portIndex;
+				if (! persistentState->nodeRegistry->getIndexesForPort(compositionIdentifier, portIdentifier, nodeIndex, portIndex))
+					continue;
+
+				if (nodeIndex >= composition->portBitsForNode.size())
+					composition->portBitsForNode.resize(nodeIndex + 1);
+
+				vector<uint64_t> &portBits = composition->portBitsForNode[nodeIndex];
+				if (portIndex / 64 >= portBits.size())
+					portBits.resize(portIndex / 64 + 1, 0);
+
+				portBits[portIndex / 64] |= 1ULL << (portIndex % 64);
+			}
+		}
+
+		if (! snapshot)
+			snapshot = new VuoTelemetrySubscriptionSnapshot;
+		if (compositionIndex >= snapshot->compositions.size())
+			snapshot->compositions.resize(compositionIndex + 1, NULL);
+		snapshot->compositions[compositionIndex] = composition;
+	}
+
+	VuoTelemetrySubscriptionSnapshot *previousSnapshot = telemetrySubscriptions->snapshot.exchange(snapshot);
+	if (previousSnapshot)
+	{
+		telemetrySubscriptions->readerPhases.waitForReaders(telemetrySubscriptions->readerCounts, VuoTelemetrySubscriptions_readerCountsCount);
+		delete previousSnapshot;
+	}
 }
 
 /**
- * Returns true if the (sub)composition instance is subscribed to all telemetry.
+ * Recompiles the subscriptions, since the composition, node, and port indexes may have changed.
+ * Should be called each time the node registry's node contexts are initialized (when the composition starts
+ * and after a live-coding reload).
  */
-bool VuoRuntimeCommunicator::isSubscribedToAllTelemetry(const char *compositionIdentifier)
+void VuoRuntimeCommunicator::updateTelemetrySubscriptionIndexes(void)
 {
-	set<string>::iterator iter = compositionsSendingAllTelemetry.find(compositionIdentifier);
-	return (iter != compositionsSendingAllTelemetry.end());
+	std::lock_guard<std::mutex> lock(telemetrySubscriptionsMutex);
+	updateTelemetrySubscriptions();
 }
 
 /**
  * Returns true if telemetry containing the port data summary should be sent for this port.
  *
+ * This is for callers that don't know the port's indexes. It looks them up, then calls
+ * @ref shouldSendPortDataTelemetry(VuoCompositionState *, unsigned long, unsigned long), as generated code does directly.
+ *
  * @version200Changed{Added `compositionIdentifier` argument.}
  */
-bool VuoRuntimeCommunicator::shouldSendPortDataTelemetry(const char *compositionIdentifier, const char *portIdentifier)
+bool VuoRuntimeCommunicator::shouldSendPortDataTelemetry(VuoCompositionState *compositionState, const char *portIdentifier)
 {
-	return (isSubscribedToAllTelemetry(compositionIdentifier) || isSubscribedToPortDataTelemetry(compositionIdentifier, portIdentifier));
+	unsigned long nodeIndex = ULONG_MAX;
+	unsigned long portIndex = ULONG_MAX;
+	persistentState->nodeRegistry->getIndexesForPort(compositionState->compositionIdentifier, portIdentifier, nodeIndex, portIndex);
+	return shouldSendPortDataTelemetry(compositionState, nodeIndex, portIndex);
+}
+
+/**
+ * Returns true if telemetry containing the port data summary should be sent for the port
+ * at @a portIndex in `NodeContext.portContexts` of the node at @a nodeIndex.
+ */
+bool VuoRuntimeCommunicator::shouldSendPortDataTelemetry(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex)
+{
+	VuoTelemetrySubscriptionReader reader(telemetrySubscriptions, persistentState->nodeRegistry, compositionState);
+	const VuoTelemetryCompositionSubscriptions *subscriptions = reader.composition;
+	return subscriptions && (subscriptions->isSendingAllTelemetry || subscriptions->isSendingPortDataTelemetry(nodeIndex, portIndex));
 }
 
 /**
@@ -652,6 +1259,26 @@ void VuoRuntimeCommunicator::sendHeartbeat(bool blocking)
 		sendTelemetry(VuoTelemetryHeartbeat, nullptr, 0);
 }
 
+/**
+ * Sends the counts of node claims, if they've changed since they were last sent.
+ */
+void VuoRuntimeCommunicator::sendNodeSynchronizationStats(void)
+{
+	unsigned long claimStats[3];
+	persistentState->nodeSynchronization->getClaimStats(claimStats[0], claimStats[1], claimStats[2]);
+	if (claimStats[0] == sentClaimStats[0] && claimStats[1] == sentClaimStats[1] && claimStats[2] == sentClaimStats[2])
+		return;
+
+	zmq_msg_t messages[3];
+	for (int i = 0; i < 3; ++i)
+	{
+		vuoInitMessageWithUnsignedInt64(&messages[i], claimStats[i]);
+		sentClaimStats[i] = claimStats[i];
+	}
+
+	sendTelemetry(VuoTelemetryNodeSynchronizationStats, messages, 3);
+}
+
 /**
  * Starts a timer to periodically send heartbeat telemetry to the runner.
  */
@@ -666,6 +1293,7 @@ void VuoRuntimeCommunicator::startSendingHeartbeat(void)
 
 	dispatch_source_set_event_handler(telemetryTimer, ^{
 		sendHeartbeat();
+		sendNodeSynchronizationStats();
 	});
 
 	dispatch_source_set_cancel_handler(telemetryTimer, ^{
@@ -685,7 +1313,16 @@ void VuoRuntimeCommunicator::stopSendingAndCleanUpHeartbeat(void)
 
 	dispatch_source_cancel(telemetryTimer);
 	dispatch_semaphore_wait(telemetryCanceled, DISPATCH_TIME_FOREVER);
+
+	bool wasBatchingTelemetry = isBatchingTelemetry;
+	isBatchingTelemetry = false;
+	if (telemetryBatchTimer)
+		dispatch_source_cancel(telemetryBatchTimer);
+
 	dispatch_sync(telemetryQueue, ^{
+					  if (wasBatchingTelemetry)
+						  sendTelemetryBatch();
+
 					  // zmq_close calls POSIX close(), whose documentation says "queued data are discarded".
 					  // Since telemetry uses non-blocking sends, issue one final _blocking_ send
 					  // to ensure that the queue is drained before we close.
@@ -697,6 +1334,12 @@ void VuoRuntimeCommunicator::stopSendingAndCleanUpHeartbeat(void)
 
 	dispatch_release(telemetryTimer);
 	telemetryTimer = NULL;
+
+	if (telemetryBatchTimer)
+	{
+		dispatch_release(telemetryBatchTimer);
+		telemetryBatchTimer = NULL;
+	}
 }
 
 /**
@@ -768,7 +1411,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 				char *compositionIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 				char *portIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				char *valueAsString = persistentState->nodeRegistry->getPortValue(&compositionState, portIdentifier, shouldUseInterprocessSerialization);
 
 				zmq_msg_t messages[1];
@@ -788,7 +1431,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 				char *compositionIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 				char *portIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				char *summary = persistentState->nodeRegistry->getPortSummary(&compositionState, portIdentifier);
 
 				zmq_msg_t messages[1];
@@ -807,7 +1450,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 				char *compositionIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 				char *portIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				persistentState->nodeRegistry->fireTriggerPortEvent(&compositionState, portIdentifier);
 
 				sendControlReply(VuoControlReplyTriggerPortFiredEvent,NULL,0);
@@ -822,7 +1465,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 				char *portIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 				char *valueAsString = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				persistentState->nodeRegistry->setPortValue(&compositionState, portIdentifier, valueAsString);
 
 				sendControlReply(VuoControlReplyInputPortValueModified,NULL,0);
@@ -987,7 +1630,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 				char *compositionIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 				char *portIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				subscribeToPortDataTelemetry(compositionState.compositionIdentifier, portIdentifier);
 
 				char *summary = persistentState->nodeRegistry->getPortSummary(&compositionState, portIdentifier);
@@ -1009,7 +1652,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 				char *compositionIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 				char *portIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				unsubscribeFromPortDataTelemetry(compositionState.compositionIdentifier, portIdentifier);
 
 				sendControlReply(control == VuoControlRequestInputPortTelemetryUnsubscribe ?
@@ -1024,7 +1667,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 			{
 				char *compositionIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				subscribeToEventTelemetry(compositionState.compositionIdentifier);
 
 				sendControlReply(VuoControlReplyEventTelemetrySubscribed,NULL,0);
@@ -1036,7 +1679,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 			{
 				char *compositionIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				unsubscribeFromEventTelemetry(compositionState.compositionIdentifier);
 
 				sendControlReply(VuoControlReplyEventTelemetryUnsubscribed,NULL,0);
@@ -1048,7 +1691,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 			{
 				char *compositionIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				subscribeToAllTelemetry(compositionState.compositionIdentifier);
 
 				sendControlReply(VuoControlReplyAllTelemetrySubscribed,NULL,0);
@@ -1060,7 +1703,7 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 			{
 				char *compositionIdentifier = vuoReceiveAndCopyString(zmqControl, NULL);
 
-				compositionState.compositionIdentifier = persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier);
+				vuoSetCompositionStateCompositionIdentifier(&compositionState, persistentState->nodeRegistry->defaultToTopLevelCompositionIdentifier(compositionIdentifier));
 				unsubscribeFromAllTelemetry(compositionState.compositionIdentifier);
 
 				sendControlReply(VuoControlReplyAllTelemetryUnsubscribed,NULL,0);
@@ -1068,6 +1711,13 @@ void VuoRuntimeCommunicator::startListeningForControl(void)
 				free(compositionIdentifier);
 				break;
 			}
+			case VuoControlRequestTelemetryBatchingEnable:
+			{
+				enableTelemetryBatching();
+
+				sendControlReply(VuoControlReplyTelemetryBatchingEnabled,NULL,0);
+				break;
+			}
 		}
 	});
 
@@ -1172,7 +1822,7 @@ extern "C"
 void vuoSendNodeExecutionStarted(VuoCompositionState *compositionState, const char *nodeIdentifier)
 {
 	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
-	return runtimeState->persistentState->communicator->sendNodeExecutionStarted(compositionState->compositionIdentifier, nodeIdentifier);
+	return runtimeState->persistentState->communicator->sendNodeExecutionStarted(compositionState, nodeIdentifier);
 }
 
 /**
@@ -1181,16 +1831,16 @@ void vuoSendNodeExecutionStarted(VuoCompositionState *compositionState, const ch
 void vuoSendNodeExecutionFinished(VuoCompositionState *compositionState, const char *nodeIdentifier)
 {
 	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
-	return runtimeState->persistentState->communicator->sendNodeExecutionFinished(compositionState->compositionIdentifier, nodeIdentifier);
+	return runtimeState->persistentState->communicator->sendNodeExecutionFinished(compositionState, nodeIdentifier);
 }
 
 /**
  * C wrapper for VuoRuntimeCommunicator::sendInputPortsUpdated().
  */
-void vuoSendInputPortsUpdated(VuoCompositionState *compositionState, const char *portIdentifier, bool receivedEvent, bool receivedData, const char *portDataSummary)
+void vuoSendInputPortsUpdated(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier, bool receivedEvent, bool receivedData, const char *portDataSummary)
 {
 	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
-	return runtimeState->persistentState->communicator->sendInputPortsUpdated(compositionState->compositionIdentifier, portIdentifier, receivedEvent, receivedData, portDataSummary);
+	return runtimeState->persistentState->communicator->sendInputPortsUpdated(compositionState, nodeIndex, portIndex, portIdentifier, receivedEvent, receivedData, portDataSummary);
 }
 
 /**
@@ -1198,10 +1848,10 @@ void vuoSendInputPortsUpdated(VuoCompositionState *compositionState, const char
  *
  * @version200Changed{Added `sentEvent` argument.}
  */
-void vuoSendOutputPortsUpdated(VuoCompositionState *compositionState, const char *portIdentifier, bool sentEvent, bool sentData, const char *portDataSummary)
+void vuoSendOutputPortsUpdated(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier, bool sentEvent, bool sentData, const char *portDataSummary)
 {
 	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
-	return runtimeState->persistentState->communicator->sendOutputPortsUpdated(compositionState->compositionIdentifier, portIdentifier, sentEvent, sentData, portDataSummary);
+	return runtimeState->persistentState->communicator->sendOutputPortsUpdated(compositionState, nodeIndex, portIndex, portIdentifier, sentEvent, sentData, portDataSummary);
 }
 
 /**
@@ -1228,10 +1878,10 @@ void vuoSendEventFinished(VuoCompositionState *compositionState, unsigned long e
 /**
  * C wrapper for VuoRuntimeCommunicator::sendEventDropped().
  */
-void vuoSendEventDropped(VuoCompositionState *compositionState, const char *portIdentifier)
+void vuoSendEventDropped(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier)
 {
 	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
-	return runtimeState->persistentState->communicator->sendEventDropped(compositionState->compositionIdentifier, portIdentifier);
+	return runtimeState->persistentState->communicator->sendEventDropped(compositionState, nodeIndex, portIndex, portIdentifier);
 }
 
 /**
@@ -1249,7 +1899,16 @@ void vuoSendError(VuoCompositionState *compositionState, const char *message)
 bool vuoShouldSendPortDataTelemetry(VuoCompositionState *compositionState, const char *portIdentifier)
 {
 	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
-	return runtimeState->persistentState->communicator->shouldSendPortDataTelemetry(compositionState->compositionIdentifier, portIdentifier);
+	return runtimeState->persistentState->communicator->shouldSendPortDataTelemetry(compositionState, portIdentifier);
+}
+
+/**
+ * C wrapper for VuoRuntimeCommunicator::shouldSendPortDataTelemetry(VuoCompositionState *, unsigned long, unsigned long).
+ */
+bool vuoShouldSendPortDataTelemetryForIndexes(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex)
+{
+	VuoRuntimeState *runtimeState = (VuoRuntimeState *)compositionState->runtimeState;
+	return runtimeState->persistentState->communicator->shouldSendPortDataTelemetry(compositionState, nodeIndex, portIndex);
 }
 
 /**
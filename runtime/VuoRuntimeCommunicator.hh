@@ -11,9 +11,13 @@
 
 #include "VuoCompositionState.h"
 #include "VuoTelemetry.hh"
+#include <atomic>
+#include <mutex>
 
 class VuoRuntimePersistentState;
 struct NodeContext;
+struct VuoTelemetryThreadBuffer;
+struct VuoTelemetrySubscriptions;
 
 /**
  * Manages communication between the runtime and the runner.
@@ -41,27 +45,43 @@ private:
 	set<string> compositionsSendingAllTelemetry;  ///< Composition identifiers from which all telemetry should be sent.
 	set<string> compositionsSendingEventTelemetry;  ///< Composition identifiers for which all telemetry about events (not including data) should be sent.
 	map<string, set<string> > portsSendingDataTelemetry;  ///< Composition and port identifiers for which data-and-event telemetry should be sent.
+	std::mutex telemetrySubscriptionsMutex;  ///< Synchronizes access to the subscription sets above, and serializes updates to @ref telemetrySubscriptions.
+	VuoTelemetrySubscriptions *telemetrySubscriptions;  ///< The subscription sets compiled for all (sub)compositions, for checking while sending telemetry without locking.
+
+	std::atomic<bool> isBatchingTelemetry;  ///< True if the runner has requested @ref VuoTelemetryBatch messages.
+	dispatch_source_t telemetryBatchTimer;  ///< Timer for sending @ref VuoTelemetryBatch messages. Runs on @ref telemetryQueue.
+	unsigned long telemetryBufferGeneration;  ///< Distinguishes this instance's per-thread buffers from those of earlier instances.
+	std::mutex telemetryBuffersMutex;  ///< Synchronizes access to @ref telemetryBuffers.
+	vector<VuoTelemetryThreadBuffer *> telemetryBuffers;  ///< Each thread's telemetry records, waiting to be batched.
+	std::atomic<unsigned long> telemetrySequence;  ///< Used to restore the order of records appended on different threads.
 
 	VuoRuntimePersistentState *persistentState;  ///< Reference to the parent VuoRuntimePersistentState.
 
 	void sendControlReply(enum VuoControlReply reply, zmq_msg_t *messages, unsigned int messageCount);
 	void sendTelemetry(enum VuoTelemetry type, zmq_msg_t *messages, unsigned int messageCount);
 
+	void enableTelemetryBatching(void);
+	VuoTelemetryThreadBuffer * getTelemetryBufferForCurrentThread(void);
+	void appendTelemetryRecord(enum VuoTelemetry type, const char *compositionIdentifier, const char *identifier, uint8_t flags, const char *portDataSummary);
+	void sendTelemetryBatch(void);
+
 	static char * mergeEnumDetails(string type, const char *details);
 
 	void subscribeToPortDataTelemetry(const char *compositionIdentifier, const char *portIdentifer);
 	void unsubscribeFromPortDataTelemetry(const char *compositionIdentifier, const char *portIdentifer);
-	bool isSubscribedToPortDataTelemetry(const char *compositionIdentifier, const char *portIdentifer);
 
 	void subscribeToEventTelemetry(const char *compositionIdentifier);
 	void unsubscribeFromEventTelemetry(const char *compositionIdentifier);
-	bool isSubscribedToEventTelemetry(const char *compositionIdentifier);
 
 	void subscribeToAllTelemetry(const char *compositionIdentifier);
 	void unsubscribeFromAllTelemetry(const char *compositionIdentifier);
-	bool isSubscribedToAllTelemetry(const char *compositionIdentifier);
+
+	void updateTelemetrySubscriptions(void);
 
 	void sendHeartbeat(bool blocking = false);
+	void sendNodeSynchronizationStats(void);
+
+	unsigned long sentClaimStats[3];  ///< The node claim counts most recently sent by @ref sendNodeSynchronizationStats. Use only on the heartbeat timer.
 
 	/// @{
 	/**
@@ -119,30 +139,33 @@ public:
 	void cleanUpControl(void);
 	void startListeningForRunnerExit(void);
 
-	void sendNodeExecutionStarted(const char *compositionIdentifier, const char *nodeIdentifier);
-	void sendNodeExecutionFinished(const char *compositionIdentifier, const char *nodeIdentifier);
-	void sendInputPortsUpdated(const char *compositionIdentifier, const char *portIdentifier, bool receivedEvent, bool receivedData, const char *portDataSummary);
-	void sendOutputPortsUpdated(const char *compositionIdentifier, const char *portIdentifier, bool sentEvent, bool sentData, const char *portDataSummary);
+	void sendNodeExecutionStarted(VuoCompositionState *compositionState, const char *nodeIdentifier);
+	void sendNodeExecutionFinished(VuoCompositionState *compositionState, const char *nodeIdentifier);
+	void sendInputPortsUpdated(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier, bool receivedEvent, bool receivedData, const char *portDataSummary);
+	void sendOutputPortsUpdated(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier, bool sentEvent, bool sentData, const char *portDataSummary);
 	void sendPublishedOutputPortsUpdated(const char *portIdentifier, bool sentData, const char *portDataSummary);
 	void sendEventFinished(unsigned long eventId, NodeContext *compositionContext);
-	void sendEventDropped(const char *compositionIdentifier, const char *portIdentifier);
+	void sendEventDropped(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier);
 	void sendError(const char *message);
 	void sendStopRequested(void);
 	void sendCompositionStoppingAndCloseControl(void);
 
-	bool shouldSendPortDataTelemetry(const char *compositionIdentifier, const char *portIdentifier);
+	bool shouldSendPortDataTelemetry(VuoCompositionState *compositionState, const char *portIdentifier);
+	bool shouldSendPortDataTelemetry(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex);
+	void updateTelemetrySubscriptionIndexes(void);
 };
 
 extern "C"
 {
 void vuoSendNodeExecutionStarted(VuoCompositionState *compositionState, const char *nodeIdentifier);
 void vuoSendNodeExecutionFinished(VuoCompositionState *compositionState, const char *nodeIdentifier);
-void vuoSendInputPortsUpdated(VuoCompositionState *compositionState, const char *portIdentifier, bool receivedEvent, bool receivedData, const char *portDataSummary);
-void vuoSendOutputPortsUpdated(VuoCompositionState *compositionState, const char *portIdentifier, bool sentEvent, bool sentData, const char *portDataSummary);
+void vuoSendInputPortsUpdated(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier, bool receivedEvent, bool receivedData, const char *portDataSummary);
+void vuoSendOutputPortsUpdated(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier, bool sentEvent, bool sentData, const char *portDataSummary);
 void vuoSendPublishedOutputPortsUpdated(VuoCompositionState *compositionState, const char *portIdentifier, bool sentData, const char *portDataSummary);
 void vuoSendEventFinished(VuoCompositionState *compositionState, unsigned long eventId);
-void vuoSendEventDropped(VuoCompositionState *compositionState, const char *portIdentifier);
+void vuoSendEventDropped(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex, const char *portIdentifier);
 bool vuoShouldSendPortDataTelemetry(VuoCompositionState *compositionState, const char *portIdentifier);
+bool vuoShouldSendPortDataTelemetryForIndexes(VuoCompositionState *compositionState, unsigned long nodeIndex, unsigned long portIndex);
 char * vuoGetInputPortString(VuoCompositionState *compositionState, const char *portIdentifier, bool shouldUseInterprocessSerialization);
 char * vuoGetOutputPortString(VuoCompositionState *compositionState, const char *portIdentifier, bool shouldUseInterprocessSerialization);
 }
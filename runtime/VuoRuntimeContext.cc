@@ -49,6 +49,7 @@ struct NodeContext * vuoCreateNodeContext(bool hasInstanceData, bool isCompositi
 	nodeContext->nodeMutex = new std::mutex();
 	nodeContext->nodeConditionVariable = new std::condition_variable();
 	nodeContext->claimingEventId = 0;
+	nodeContext->claimWaiterCount = 0;
 
 	if (isComposition)
 	{
@@ -214,7 +215,7 @@ void vuoSetNodeContextInstanceData(struct NodeContext *nodeContext, void *instan
  */
 void vuoSetNodeContextClaimingEventId(struct NodeContext *nodeContext, unsigned long claimingEventId)
 {
-	nodeContext->claimingEventId = claimingEventId;
+	__atomic_store_n(&nodeContext->claimingEventId, claimingEventId, __ATOMIC_SEQ_CST);
 }
 
 /**
@@ -246,7 +247,7 @@ void * vuoGetNodeContextInstanceData(struct NodeContext *nodeContext)
  */
 unsigned long vuoGetNodeContextClaimingEventId(struct NodeContext *nodeContext)
 {
-	return nodeContext->claimingEventId;
+	return __atomic_load_n(&nodeContext->claimingEventId, __ATOMIC_ACQUIRE);
 }
 
 /**
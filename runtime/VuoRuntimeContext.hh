@@ -44,9 +44,10 @@ struct NodeContext
 	struct PortContext **portContexts;  ///< An array of contexts for input and output ports, or null if this node is a subcomposition.
 	unsigned long portContextCount;  ///< The number of elements in `portContexts`.
 	void *instanceData;  ///< A pointer to the node's instance data, or null if this node is stateless.
-	void *nodeMutex;  ///< A `std::mutex` that synchronizes access to @ref claimingEventId.
+	void *nodeMutex;  ///< A `std::mutex` that lets threads wait to claim the node (see VuoNodeSynchronization).
 	void *nodeConditionVariable;  ///< A `std::condition_variable` that notifies threads waiting on @ref nodeMutex.
-	unsigned long claimingEventId;  ///< The ID of the event that currently has exclusive claim on the node.
+	unsigned long claimingEventId;  ///< The ID of the event that currently has exclusive claim on the node. Accessed atomically.
+	unsigned long claimWaiterCount;  ///< The number of threads blocked on @ref nodeConditionVariable waiting to claim the node. Accessed atomically.
 	dispatch_group_t executingGroup;  ///< A dispatch group used by the subcomposition's event function to wait for nodes to finish executing.
 	void *executingEventIds;  ///< A `vector<unsigned long>` containing the ID of the event that most recently came in through the composition's published inputs and any events spun off from it.
 	bool *outputEvents;  ///< An array used by the subcomposition's event function to track events to published output ports, or null if this is not a subcomposition.
@@ -42,11 +42,13 @@ VuoRuntimeState::~VuoRuntimeState(void)
  * Initializes a runtime state instance, updates its references to symbols defined in the composition binary,
  * and opens a connection between it and the runner.
  *
+ * If @a useWorkStealingScheduler is true, the composition's workers are scheduled with VuoThreadManager::Scheduler_WorkStealing.
+ *
  * @throw VuoException One of the symbols was not found in the composition binary.
  */
 void VuoRuntimeState::init(void *zmqContext, const char *controlUrl, const char *telemetryUrl, bool isPaused,
 						   pid_t runnerPid, int runnerPipe, bool continueIfRunnerDies, const char *workingDirectory,
-						   void *compositionBinaryHandle)
+						   void *compositionBinaryHandle, bool useWorkStealingScheduler)
 {
 	if (! persistentState)
 	{
@@ -54,6 +56,9 @@ void VuoRuntimeState::init(void *zmqContext, const char *controlUrl, const char
 		persistentState->runtimeState = this;
 	}
 
+	persistentState->threadManager->setScheduler(useWorkStealingScheduler ? VuoThreadManager::Scheduler_WorkStealing
+																		  : VuoThreadManager::Scheduler_Dispatcher);
+
 	this->_isPaused = isPaused;
 	hasBeenUnpaused = false;
 	_isStopped = false;
@@ -64,7 +64,8 @@ public:
 	VuoRuntimeState(void);
 	~VuoRuntimeState(void);
 	void init(void *zmqContext, const char *controlUrl, const char *telemetryUrl, bool isPaused,
-			  pid_t runnerPid, int runnerPipe, bool continueIfRunnerDies, const char *workingDirectory, void *compositionBinaryHandle);
+			  pid_t runnerPid, int runnerPipe, bool continueIfRunnerDies, const char *workingDirectory, void *compositionBinaryHandle,
+			  bool useWorkStealingScheduler);
 	void fini(void);
 	void updateCompositionSymbols(void *compositionBinaryHandle);
 	bool isPaused(void);
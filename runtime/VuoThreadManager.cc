@@ -14,6 +14,12 @@
 #include "VuoRuntimeUtilities.hh"
 #include "VuoEventLoop.h"
 #include "VuoException.hh"
+#include <unistd.h>
+
+/**
+ * The number of shards in VuoThreadManager::eventThreadPools. Must be a power of 2.
+ */
+static const unsigned long VuoThreadManager_eventThreadPoolsShardCount = 64;
 
 /**
  * Constructs a trigger worker.
@@ -34,6 +40,7 @@ VuoThreadManager::Worker::Worker(dispatch_queue_t queue, void *context, void (*f
 	this->chainCount = chainCount;
 	this->upstreamChainIndices = NULL;
 	this->upstreamChainIndicesCount = 0;
+	this->triggerTicket = 0;
 }
 
 /**
@@ -56,6 +63,7 @@ VuoThreadManager::Worker::Worker(dispatch_queue_t queue, void *context, void (*f
 	this->chainCount = -1;
 	this->upstreamChainIndices = upstreamChainIndices;
 	this->upstreamChainIndicesCount = upstreamChainIndicesCount;
+	this->triggerTicket = 0;
 }
 
 /**
@@ -232,6 +240,19 @@ VuoThreadManager::VuoThreadManager(void)
 	threadPoolSync = dispatch_queue_create("org.vuo.runtime.threadPool", VuoEventLoop_getDispatchInteractiveAttribute());
 	workersUpdated = dispatch_semaphore_create(0);
 	completed = dispatch_semaphore_create(0);
+
+	scheduler = Scheduler_Dispatcher;
+	workerDequeCount = max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+	workerDeques = new WorkerDeque[workerDequeCount];
+	eventThreadPools = new EventThreadPools[VuoThreadManager_eventThreadPoolsShardCount];
+	mainThreadsAvailable = mainThreadPool.totalThreads;
+	nextTriggerTicket = 0;
+	servingTriggerTicket = 0;
+	schedulingGeneration = 0;
+	waitingWorkerCount = 0;
+	schedulingWorkerCount = 0;
+	mayMoreWorkersBeEnqueued = true;
+	mayMoreWorkersBeDequeued = false;
 }
 
 /**
@@ -242,6 +263,18 @@ VuoThreadManager::~VuoThreadManager(void)
 	dispatch_release(workersWaitingSync);
 	dispatch_release(threadPoolSync);
 	dispatch_release(workersUpdated);
+	delete[] workerDeques;
+	delete[] eventThreadPools;
+}
+
+/**
+ * Sets the strategy for deciding when waiting workers get threads. The default is @ref Scheduler_Dispatcher.
+ *
+ * Only call this while scheduling workers is disabled (before enableSchedulingWorkers()).
+ */
+void VuoThreadManager::setScheduler(Scheduler scheduler)
+{
+	this->scheduler = scheduler;
 }
 
 /**
@@ -252,6 +285,10 @@ void VuoThreadManager::enableSchedulingWorkers(void)
 	mayMoreWorkersBeEnqueued = true;
 	mayMoreWorkersBeDequeued = true;
 
+	// With the work-stealing scheduler, workers are dispatched by the threads that schedule them or return threads.
+	if (scheduler == Scheduler_WorkStealing)
+		return;
+
 	dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
 	dispatch_async(queue, ^{
 					   while (mayMoreWorkersBeDequeued)
@@ -272,9 +309,22 @@ void VuoThreadManager::enableSchedulingWorkers(void)
 
 /**
  * Finishes dequeuing workers that have been scheduled.
+ *
+ * Workers scheduled after this function is called are never dispatched.
  */
 void VuoThreadManager::disableSchedulingWorkers(void)
 {
+	if (scheduler == Scheduler_WorkStealing)
+	{
+		// Any call to scheduleWorkerWithoutDispatcher() that starts after this will discard its worker.
+		// Wait for the calls already in progress, and for the workers they (or earlier calls) left waiting.
+		mayMoreWorkersBeEnqueued = false;
+
+		std::unique_lock<std::mutex> lock(waitingWorkersMutex);
+		waitingWorkersDrained.wait(lock, [this](){ return schedulingWorkerCount.load() == 0 && waitingWorkerCount.load() == 0; });
+		return;
+	}
+
 	dispatch_sync(workersWaitingSync, ^{
 					  mayMoreWorkersBeEnqueued = false;
 				  });
@@ -410,6 +460,280 @@ vector<VuoThreadManager::Worker *> VuoThreadManager::dequeueWorkers(void)
 	return workersDequeued;
 }
 
+/**
+ * Returns the thread pools for the shard of events that includes @a eventId.
+ */
+VuoThreadManager::EventThreadPools & VuoThreadManager::getEventThreadPools(unsigned long eventId)
+{
+	// Event IDs are sequential, so the low bits spread consecutive events across shards.
+	return eventThreadPools[eventId & (VuoThreadManager_eventThreadPoolsShardCount - 1)];
+}
+
+/**
+ * Returns the deque of waiting workers owned by the current thread, and outputs its index in @ref workerDeques.
+ *
+ * Threads are assigned to deques round-robin the first time they call this function.
+ */
+VuoThreadManager::WorkerDeque & VuoThreadManager::getCurrentThreadWorkerDeque(size_t &index)
+{
+	static std::atomic<size_t> nextThreadIndex(0);
+	static thread_local size_t threadIndex = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+
+	index = threadIndex % workerDequeCount;
+	return workerDeques[index];
+}
+
+/**
+ * Same as ThreadPool::tryClaimThreads() for the main thread pool, but lock-free.
+ */
+bool VuoThreadManager::tryClaimMainThreads(int minThreadsNeeded, int maxThreadsNeeded, int &threadsClaimed)
+{
+	int available = mainThreadsAvailable.load();
+	do
+	{
+		if (minThreadsNeeded > available)
+		{
+			threadsClaimed = 0;
+			return false;
+		}
+
+		threadsClaimed = min(available, maxThreadsNeeded);
+	} while (! mainThreadsAvailable.compare_exchange_weak(available, available - threadsClaimed));
+
+	return true;
+}
+
+/**
+ * Puts the threads claimed for the event back into the main thread pool.
+ * Assumes the caller has locked @a pools.
+ *
+ * @throw VuoException The event is not currently using the main thread pool.
+ */
+void VuoThreadManager::returnMainThreads(EventThreadPools &pools, unsigned long eventId)
+{
+	map<unsigned long, int>::iterator iter = pools.mainThreadsClaimed.find(eventId);
+	if (iter == pools.mainThreadsClaimed.end())
+		throw VuoException("Couldn't find worker in thread pool to return its threads.");
+
+	mainThreadsAvailable.fetch_add(iter->second);
+	pools.mainThreadsClaimed.erase(iter);
+}
+
+/**
+ * For @ref Scheduler_WorkStealing: if the worker is eligible to get threads (according to the same rules as dequeueWorkers()),
+ * claims the threads, dispatches the worker, deletes it, and returns true. Otherwise, returns false.
+ */
+bool VuoThreadManager::tryDispatchWorker(Worker *w)
+{
+	EventThreadPools &pools = getEventThreadPools(w->eventId);
+	bool gotThreads = false;
+
+	if (w->isTrigger)
+	{
+		if (w->minThreadsNeeded >= 0 && w->maxThreadsNeeded >= 0)
+		{
+			// Trigger worker for new event
+
+			int threadsClaimed;
+			if (w->triggerTicket == servingTriggerTicket.load() &&
+					tryClaimMainThreads(w->minThreadsNeeded, w->maxThreadsNeeded, threadsClaimed))
+			{
+				{
+					std::lock_guard<std::mutex> lock(pools.mutex);
+					pools.mainThreadsClaimed[w->eventId] = threadsClaimed;
+					ThreadPool &triggerThreadPool = pools.triggerThreadPools[w->eventId][w->compositionHash];
+					triggerThreadPool.setTotalThreads(threadsClaimed);
+					triggerThreadPool.totalWorkers = w->chainCount;
+				}
+
+				// Let the next trigger worker in line get threads.
+				servingTriggerTicket.fetch_add(1);
+				schedulingGeneration.fetch_add(1);
+				gotThreads = true;
+			}
+		}
+		else
+		{
+			// Trigger worker for published input trigger of a subcomposition node
+
+			std::lock_guard<std::mutex> lock(pools.mutex);
+			pools.triggerThreadPools[w->eventId][w->compositionHash].totalWorkers = w->chainCount;
+			gotThreads = true;
+		}
+	}
+	else
+	{
+		// Chain worker
+
+		std::lock_guard<std::mutex> lock(pools.mutex);
+		ThreadPool &triggerThreadPool = pools.triggerThreadPools[w->eventId][w->compositionHash];
+
+		bool haveAllUpstreamChainsCompleted = true;
+		for (int i = 0; i < w->upstreamChainIndicesCount; ++i)
+		{
+			if (triggerThreadPool.workersCompleted.find(w->upstreamChainIndices[i]) == triggerThreadPool.workersCompleted.end())
+			{
+				haveAllUpstreamChainsCompleted = false;
+				break;
+			}
+		}
+
+		if (haveAllUpstreamChainsCompleted)
+		{
+			int threadsClaimed;
+			gotThreads = triggerThreadPool.tryClaimThreads(w->minThreadsNeeded, w->maxThreadsNeeded, w->chainIndex, threadsClaimed);
+			if (gotThreads)
+			{
+				free(w->upstreamChainIndices);
+				w->upstreamChainIndices = NULL;
+			}
+		}
+	}
+
+	if (gotThreads)
+	{
+		dispatch_async_f(w->queue, w->context, w->function);
+		delete w;
+	}
+
+	return gotThreads;
+}
+
+/**
+ * For @ref Scheduler_WorkStealing: dispatches the worker immediately if it's eligible to get threads,
+ * otherwise adds it to the current thread's deque of waiting workers.
+ *
+ * If disableSchedulingWorkers() has been called, discards the worker instead.
+ */
+void VuoThreadManager::scheduleWorkerWithoutDispatcher(Worker *worker)
+{
+	// Announce this call before checking whether scheduling is disabled, so that disableSchedulingWorkers()
+	// either waits for this call to finish or this call sees that scheduling is disabled.
+	schedulingWorkerCount.fetch_add(1);
+	if (! mayMoreWorkersBeEnqueued)
+	{
+		free(worker->upstreamChainIndices);
+		delete worker;
+		finishSchedulingWorker();
+		return;
+	}
+
+	// Only take a ticket once the worker is sure to be dispatched, so a discarded worker doesn't hold up the ones after it.
+	if (worker->isTrigger && worker->minThreadsNeeded >= 0 && worker->maxThreadsNeeded >= 0)
+		worker->triggerTicket = nextTriggerTicket.fetch_add(1);
+
+	unsigned long generation = schedulingGeneration.load();
+
+	if (! tryDispatchWorker(worker))
+	{
+		waitingWorkerCount.fetch_add(1);
+
+		size_t index;
+		WorkerDeque &workerDeque = getCurrentThreadWorkerDeque(index);
+		std::lock_guard<std::mutex> lock(workerDeque.mutex);
+		workerDeque.workers.push_back(worker);
+	}
+
+	// If threads were returned while this worker was being examined (before it was visible in the deque),
+	// or if this worker was a trigger that let the next one in line proceed, check the waiting workers.
+	if (schedulingGeneration.load() != generation && waitingWorkerCount.load() > 0)
+		dispatchWaitingWorkers();
+
+	finishSchedulingWorker();
+}
+
+/**
+ * For @ref Scheduler_WorkStealing: marks a call to scheduleWorkerWithoutDispatcher() as finished,
+ * and notifies disableSchedulingWorkers() if it's waiting for the last one.
+ */
+void VuoThreadManager::finishSchedulingWorker(void)
+{
+	if (schedulingWorkerCount.fetch_sub(1) == 1 && ! mayMoreWorkersBeEnqueued)
+	{
+		std::lock_guard<std::mutex> lock(waitingWorkersMutex);
+		waitingWorkersDrained.notify_all();
+	}
+}
+
+/**
+ * For @ref Scheduler_WorkStealing: dispatches all waiting workers that are eligible to get threads.
+ *
+ * Pops workers from the back of the current thread's deque, then steals from the front of the other deques.
+ * Workers that still aren't eligible are pushed onto the current thread's deque. This repeats if, meanwhile,
+ * another thread may have made any of those workers eligible.
+ */
+void VuoThreadManager::dispatchWaitingWorkers(void)
+{
+	size_t homeIndex;
+	getCurrentThreadWorkerDeque(homeIndex);
+
+	vector<Worker *> stillWaiting;
+	unsigned long generation;
+	do
+	{
+		generation = schedulingGeneration.load();
+		unsigned long dispatchedCount = 0;
+
+		for (size_t i = 0; i < workerDequeCount; ++i)
+		{
+			bool isOwnDeque = (i == 0);
+			WorkerDeque &workerDeque = workerDeques[(homeIndex + i) % workerDequeCount];
+
+			while (true)
+			{
+				Worker *w;
+				{
+					std::lock_guard<std::mutex> lock(workerDeque.mutex);
+					if (workerDeque.workers.empty())
+						break;
+
+					if (isOwnDeque)
+					{
+						w = workerDeque.workers.back();
+						workerDeque.workers.pop_back();
+					}
+					else
+					{
+						w = workerDeque.workers.front();
+						workerDeque.workers.pop_front();
+					}
+				}
+
+				if (tryDispatchWorker(w))
+					++dispatchedCount;
+				else
+					stillWaiting.push_back(w);
+			}
+		}
+
+		if (! stillWaiting.empty())
+		{
+			WorkerDeque &workerDeque = workerDeques[homeIndex];
+			std::lock_guard<std::mutex> lock(workerDeque.mutex);
+			workerDeque.workers.insert(workerDeque.workers.end(), stillWaiting.begin(), stillWaiting.end());
+			stillWaiting.clear();
+		}
+
+		if (dispatchedCount > 0 && waitingWorkerCount.fetch_sub(dispatchedCount) == dispatchedCount)
+		{
+			std::lock_guard<std::mutex> lock(waitingWorkersMutex);
+			waitingWorkersDrained.notify_all();
+		}
+	} while (schedulingGeneration.load() != generation && waitingWorkerCount.load() > 0);
+}
+
+/**
+ * For @ref Scheduler_WorkStealing: call this after returning threads or completing a chain,
+ * to dispatch any waiting workers that have become eligible as a result.
+ */
+void VuoThreadManager::dispatchWorkersMadeEligible(void)
+{
+	schedulingGeneration.fetch_add(1);
+
+	if (waitingWorkerCount.load() > 0)
+		dispatchWaitingWorkers();
+}
+
 /**
  * Schedules a trigger worker function to be called when enough threads are available from the thread pool.
  *
@@ -432,6 +756,12 @@ void VuoThreadManager::scheduleTriggerWorker(dispatch_queue_t queue, void *conte
 	unsigned long compositionHash = VuoRuntimeUtilities::hash(compositionIdentifier);
 	Worker *worker = new Worker(queue, context, function, adjustedMinThreadsNeeded, maxThreadsNeeded, eventId, compositionHash, chainCount);
 
+	if (scheduler == Scheduler_WorkStealing)
+	{
+		scheduleWorkerWithoutDispatcher(worker);
+		return;
+	}
+
 	dispatch_sync(workersWaitingSync, ^{
 					   workersWaitingForThreads.enqueue(worker);
 				   });
@@ -451,6 +781,12 @@ void VuoThreadManager::scheduleChainWorker(dispatch_queue_t queue, void *context
 	unsigned long compositionHash = VuoRuntimeUtilities::hash(compositionIdentifier);
 	Worker *worker = new Worker(queue, context, function, minThreadsNeeded, maxThreadsNeeded, eventId, compositionHash, chainIndex, upstreamChainIndices, upstreamChainIndicesCount);
 
+	if (scheduler == Scheduler_WorkStealing)
+	{
+		scheduleWorkerWithoutDispatcher(worker);
+		return;
+	}
+
 	dispatch_sync(workersWaitingSync, ^{
 					  workersWaitingForThreads.enqueue(worker);
 				  });
@@ -468,6 +804,18 @@ void VuoThreadManager::grantThreadsToChain(int minThreadsNeeded, int maxThreadsN
 {
 	unsigned long compositionHash = VuoRuntimeUtilities::hash(compositionIdentifier);
 
+	if (scheduler == Scheduler_WorkStealing)
+	{
+		EventThreadPools &pools = getEventThreadPools(eventId);
+		std::lock_guard<std::mutex> lock(pools.mutex);
+		ThreadPool &triggerThreadPool = pools.triggerThreadPools[eventId][compositionHash];
+		int threadsClaimed;
+		bool gotThreads = triggerThreadPool.tryClaimThreads(minThreadsNeeded, maxThreadsNeeded, chainIndex, threadsClaimed);
+		if (! gotThreads)
+			throw VuoException("Not enough threads available in the thread pool to execute the chain.");
+		return;
+	}
+
 	dispatch_sync(threadPoolSync, ^{
 					  ThreadPool &triggerThreadPool = triggerThreadPools[eventId][compositionHash];
 					  int threadsClaimed;
@@ -491,6 +839,16 @@ void VuoThreadManager::grantThreadsToSubcomposition(unsigned long eventId, const
 	unsigned long compositionHash = VuoRuntimeUtilities::hash(compositionIdentifier);
 	unsigned long subcompositionHash = VuoRuntimeUtilities::hash(subcompositionIdentifier);
 
+	if (scheduler == Scheduler_WorkStealing)
+	{
+		EventThreadPools &pools = getEventThreadPools(eventId);
+		std::lock_guard<std::mutex> lock(pools.mutex);
+		map<unsigned long, ThreadPool> &eventThreadPools = pools.triggerThreadPools[eventId];
+		int threadsClaimedForChain = eventThreadPools[compositionHash].getThreadsClaimed(chainIndex);
+		eventThreadPools[subcompositionHash].setTotalThreads(threadsClaimedForChain);
+		return;
+	}
+
 	dispatch_sync(threadPoolSync, ^{
 					  map<unsigned long, ThreadPool> &eventThreadPools = triggerThreadPools[eventId];
 					  int threadsClaimedForChain = eventThreadPools[compositionHash].getThreadsClaimed(chainIndex);
@@ -503,6 +861,19 @@ void VuoThreadManager::grantThreadsToSubcomposition(unsigned long eventId, const
  */
 void VuoThreadManager::returnThreadsForTriggerWorker(unsigned long eventId)
 {
+	if (scheduler == Scheduler_WorkStealing)
+	{
+		EventThreadPools &pools = getEventThreadPools(eventId);
+		{
+			std::lock_guard<std::mutex> lock(pools.mutex);
+			pools.triggerThreadPools.erase(eventId);
+			returnMainThreads(pools, eventId);
+		}
+
+		dispatchWorkersMadeEligible();
+		return;
+	}
+
 	dispatch_sync(threadPoolSync, ^{
 					   triggerThreadPools.erase(eventId);
 					   mainThreadPool.returnThreads(eventId);
@@ -518,6 +889,30 @@ void VuoThreadManager::returnThreadsForChainWorker(unsigned long eventId, const
 {
 	unsigned long compositionHash = VuoRuntimeUtilities::hash(compositionIdentifier);
 
+	if (scheduler == Scheduler_WorkStealing)
+	{
+		EventThreadPools &pools = getEventThreadPools(eventId);
+		{
+			std::lock_guard<std::mutex> lock(pools.mutex);
+			ThreadPool &triggerThreadPool = pools.triggerThreadPools[eventId][compositionHash];
+			triggerThreadPool.returnThreads(chainIndex);
+
+			if (triggerThreadPool.workersCompleted.size() == triggerThreadPool.totalWorkers)
+			{
+				map<unsigned long, ThreadPool> &eventThreadPools = pools.triggerThreadPools[eventId];
+				eventThreadPools.erase(compositionHash);
+				if (eventThreadPools.empty())
+				{
+					pools.triggerThreadPools.erase(eventId);
+					returnMainThreads(pools, eventId);
+				}
+			}
+		}
+
+		dispatchWorkersMadeEligible();
+		return;
+	}
+
 	dispatch_sync(threadPoolSync, ^{
 					  ThreadPool &triggerThreadPool = triggerThreadPools[eventId][compositionHash];
 					  triggerThreadPool.returnThreads(chainIndex);
@@ -10,7 +10,11 @@
 #pragma once
 
 #include <dispatch/dispatch.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <set>
 #include <vector>
 using namespace std;
@@ -25,9 +29,35 @@ using namespace std;
  * thread from the thread manager. The thread manager, which manages several thread pools, schedules
  * the block of code when a thread becomes available. When the block of code completes, the composition
  * informs the thread manager, and the thread manager returns the threads to their thread pool.
+ *
+ * Two schedulers are available (see @ref Scheduler). Both hand out threads according to the same rules,
+ * so both avoid deadlock in the same way: a trigger worker for a new event only gets threads once every
+ * earlier trigger worker has gotten them, and only if at least `minThreadsNeeded` are available; a chain
+ * worker only gets threads once all of its upstream chains have completed, and only if at least its
+ * `minThreadsNeeded` are available from the threads claimed for its event.
  */
 class VuoThreadManager
 {
+public:
+	/**
+	 * Strategies for deciding when waiting workers get threads.
+	 */
+	enum Scheduler
+	{
+		/**
+		 * Workers wait in a single shared queue, which a dedicated thread scans whenever threads may have become available.
+		 */
+		Scheduler_Dispatcher,
+
+		/**
+		 * Workers get threads directly on the thread that schedules them, if possible.
+		 * Otherwise they wait in per-CPU deques, from which any thread that returns threads pops (or steals) workers
+		 * that have become eligible. Thread accounting for the main thread pool uses atomics,
+		 * and each event's thread pools are locked separately from other events'.
+		 */
+		Scheduler_WorkStealing
+	};
+
 private:
 	/**
 	 * A worker waiting for access to a thread pool.
@@ -53,6 +83,8 @@ private:
 		unsigned long *upstreamChainIndices;  ///< For chain workers: the indices of the chains immediately upstream.
 		int upstreamChainIndicesCount;  ///< For chain workers: the number of items in upstreamChainIndices.
 
+		unsigned long triggerTicket;  ///< For trigger workers for new events, when using @ref Scheduler_WorkStealing: the worker's position in the order that triggers get threads.
+
 		Worker(dispatch_queue_t queue, void *context, void (*function)(void *), int minThreadsNeeded, int maxThreadsNeeded,
 			   unsigned long eventId, unsigned long compositionHash, int chainCount);
 		Worker(dispatch_queue_t queue, void *context, void (*function)(void *), int minThreadsNeeded, int maxThreadsNeeded,
@@ -121,7 +153,7 @@ private:
 	dispatch_queue_t threadPoolSync;  ///< Synchronizes access to mainThreadPool and triggerThreadPools.
 	dispatch_semaphore_t workersUpdated;  ///< Notifies dequeueWorker() when there may be a new worker available to dequeue.
 	dispatch_semaphore_t completed;  ///< Notifies the destructor when the dequeueWorker() loop has completed.
-	bool mayMoreWorkersBeEnqueued;  ///< Becomes true when the composition is stopping, indicating that dequeueWorker() is now flushing out the remaining workers and shouldn't expect new events.
+	std::atomic<bool> mayMoreWorkersBeEnqueued;  ///< Becomes false when the composition is stopping, indicating that dequeueWorker() is now flushing out the remaining workers and shouldn't expect new events. For @ref Scheduler_WorkStealing, workers scheduled after this becomes false are discarded.
 	bool mayMoreWorkersBeDequeued;  ///< Becomes true when dequeueWorker() has finished flushing out the remaining workers.
 
 	vector<Worker *> workersDequeued;  ///< Temporary storage in dequeueWorkers(), made persistent to avoid the cost of reallocating with every call.
@@ -129,9 +161,55 @@ private:
 
 	vector<Worker *> dequeueWorkers(void);
 
+	/**
+	 * A deque of workers waiting for threads, used by @ref Scheduler_WorkStealing.
+	 *
+	 * The thread that owns the deque pushes and pops at the back. Other threads steal from the front.
+	 */
+	struct alignas(64) WorkerDeque
+	{
+		std::mutex mutex;  ///< Synchronizes access to @ref workers.
+		deque<Worker *> workers;  ///< The waiting workers.
+	};
+
+	/**
+	 * The thread pools for a subset of events, used by @ref Scheduler_WorkStealing.
+	 */
+	struct alignas(64) EventThreadPools
+	{
+		std::mutex mutex;  ///< Synchronizes access to the other members.
+		map<unsigned long, int> mainThreadsClaimed;  ///< For each event ID, the number of threads claimed from the main thread pool.
+		map<unsigned long, map<unsigned long, ThreadPool> > triggerThreadPools;  ///< Same as VuoThreadManager::triggerThreadPools, for this subset of events.
+	};
+
+	Scheduler scheduler;  ///< The strategy for deciding when waiting workers get threads.
+
+	WorkerDeque *workerDeques;  ///< For @ref Scheduler_WorkStealing: one deque of waiting workers per CPU.
+	size_t workerDequeCount;  ///< The number of items in @ref workerDeques.
+	EventThreadPools *eventThreadPools;  ///< For @ref Scheduler_WorkStealing: the events' thread pools, sharded by event ID.
+	std::atomic<int> mainThreadsAvailable;  ///< For @ref Scheduler_WorkStealing: the number of threads available in the main thread pool.
+	std::atomic<unsigned long> nextTriggerTicket;  ///< For @ref Scheduler_WorkStealing: the ticket to give the next trigger worker for a new event.
+	std::atomic<unsigned long> servingTriggerTicket;  ///< For @ref Scheduler_WorkStealing: the ticket of the trigger worker that's next in line for threads.
+	std::atomic<unsigned long> schedulingGeneration;  ///< For @ref Scheduler_WorkStealing: incremented whenever a waiting worker may have become eligible for threads.
+	std::atomic<unsigned long> waitingWorkerCount;  ///< For @ref Scheduler_WorkStealing: the number of workers in @ref workerDeques (or being examined by dispatchWaitingWorkers()).
+	std::atomic<unsigned long> schedulingWorkerCount;  ///< For @ref Scheduler_WorkStealing: the number of calls to scheduleWorkerWithoutDispatcher() in progress.
+	std::mutex waitingWorkersMutex;  ///< For @ref Scheduler_WorkStealing: used with @ref waitingWorkersDrained.
+	std::condition_variable waitingWorkersDrained;  ///< For @ref Scheduler_WorkStealing: notifies disableSchedulingWorkers() when @ref waitingWorkerCount or @ref schedulingWorkerCount has reached 0.
+
+	EventThreadPools & getEventThreadPools(unsigned long eventId);
+	WorkerDeque & getCurrentThreadWorkerDeque(size_t &index);
+	bool tryClaimMainThreads(int minThreadsNeeded, int maxThreadsNeeded, int &threadsClaimed);
+	void returnMainThreads(EventThreadPools &pools, unsigned long eventId);
+	bool tryDispatchWorker(Worker *worker);
+	void scheduleWorkerWithoutDispatcher(Worker *worker);
+	void finishSchedulingWorker(void);
+	void dispatchWaitingWorkers(void);
+	void dispatchWorkersMadeEligible(void);
+
 public:
 	VuoThreadManager(void);
 	~VuoThreadManager(void);
+	void setScheduler(Scheduler scheduler);
 	void enableSchedulingWorkers(void);
 	void disableSchedulingWorkers(void);
 	void scheduleTriggerWorker(dispatch_queue_t queue, void *context, void (*function)(void *),
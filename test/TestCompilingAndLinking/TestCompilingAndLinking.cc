@@ -253,6 +253,72 @@ private slots:
 		VuoCompiler::reset();
 	}
 
+	void testLinkingThroughObjectCodeCache()
+	{
+		string compositionPath = getCompositionPath("Recur_Count_Write.vuo");
+		compiler = initCompiler(compositionPath);
+
+		string dir, file, extension;
+		VuoFileUtilities::splitPath(compositionPath, dir, file, extension);
+		string bcPath = VuoFileUtilities::makeTmpFile(file, "bc");
+		string exePath = VuoFileUtilities::makeTmpFile(file, "");
+
+		// Start with an empty cache, so the first link has to generate object code for every module.
+		VuoObjectCodeCache *cache = VuoObjectCodeCache::getSharedCache();
+		string cacheDirectoryPath = VuoFileUtilities::getCachePath() + "/ObjectCode";
+		for (VuoFileUtilities::File *objectFile : VuoFileUtilities::findFilesInDirectory(cacheDirectoryPath, {"o"}))
+		{
+			VuoFileUtilities::deleteFile(objectFile->path());
+			delete objectFile;
+		}
+
+		unsigned long previousHitCount, previousLookupCount;
+		cache->getStatistics(previousHitCount, previousLookupCount);
+
+		for (int i = 0; i < 2; ++i)
+		{
+			remove(bcPath.c_str());
+			remove(exePath.c_str());
+
+			VuoCompilerIssues issues;
+			compiler->compileComposition(compositionPath, bcPath, true, &issues);
+			compiler->linkCompositionToCreateExecutable(bcPath, exePath, VuoCompiler::Optimization_NoModuleCaches);
+			QVERIFY2(access(exePath.c_str(), X_OK) == 0, qPrintable(QString("Failed to link on iteration %1").arg(i)));
+
+			unsigned long hitCount, lookupCount;
+			cache->getStatistics(hitCount, lookupCount);
+			unsigned long linkHitCount = hitCount - previousHitCount;
+			unsigned long linkLookupCount = lookupCount - previousLookupCount;
+			QString reused = QString("reused %1 of %2 object files").arg(linkHitCount).arg(linkLookupCount);
+			QVERIFY2(linkLookupCount > 0, qPrintable(reused));
+
+			if (i == 0)
+			{
+				// Cold cache: every object file was generated, and added to the cache.
+				QVERIFY2(linkHitCount == 0, qPrintable(reused));
+				set<VuoFileUtilities::File *> objectFiles = VuoFileUtilities::findFilesInDirectory(cacheDirectoryPath, {"o"});
+				QVERIFY2(objectFiles.size() > 0, cacheDirectoryPath.c_str());
+				for (VuoFileUtilities::File *objectFile : objectFiles)
+					delete objectFile;
+			}
+			else
+			{
+				// The node classes haven't changed, so this link should reuse the object code generated for them by the first.
+				QVERIFY2(linkHitCount > 0, qPrintable(reused));
+			}
+
+			previousHitCount = hitCount;
+			previousLookupCount = lookupCount;
+		}
+
+		remove(bcPath.c_str());
+		remove(exePath.c_str());
+
+		delete compiler;
+		compiler = nullptr;
+		VuoCompiler::reset();
+	}
+
 	void testCompilingAndLinkingWithGenericNodes_data()
 	{
 		QTest::addColumn< QString >("compositionName");
@@ -703,7 +769,7 @@ private slots:
 		QBENCHMARK {
 			// Force the VuoCompilerGraph to be regenerated. Because of the way that QBENCHMARK repeats the test,
 			// it would sometimes use the cache and sometimes regenerate, making the results difficult to interpret.
-			composition.graphHash = 0;
+			composition.invalidateCachedGraph();
 
 			VuoCompilerIssues *issues = new VuoCompilerIssues();
 			composition.checkForEventFlowIssues(issues);
@@ -352,6 +352,87 @@ private slots:
 		}
 	}
 
+	/**
+	 * Compiles each of the largest compositions (by file size), separately measuring the time spent
+	 * analyzing the composition's graph and the time spent generating LLVM bitcode for it.
+	 */
+	void testCompilingPerformance_data()
+	{
+		QTest::addColumn< string >("compositionPath");
+		QTest::addColumn< bool >("isGraphAnalysis");
+
+		const int compositionCount = 5;
+		QDir compositionDir = getCompositionDir();
+		QStringList compositionFileNames = compositionDir.entryList(QStringList("*.vuo"), QDir::Files, QDir::Size);
+		for (int i = 0; i < compositionFileNames.size() && i < compositionCount; ++i)
+		{
+			string compositionPath = getCompositionPath(compositionFileNames[i].toStdString());
+
+			string dir, name, extension;
+			VuoFileUtilities::splitPath(compositionPath, dir, name, extension);
+
+			if (singleTestDatum.isEmpty() || singleTestDatum.startsWith(QString::fromStdString(name)))
+			{
+				QTest::newRow((name + " graph analysis").c_str()) << compositionPath << true;
+				QTest::newRow((name + " codegen").c_str()) << compositionPath << false;
+			}
+		}
+	}
+	void testCompilingPerformance()
+	{
+		QFETCH(string, compositionPath);
+		QFETCH(bool, isGraphAnalysis);
+		printf("\t%s\n", QTest::currentDataTag()); fflush(stdout);
+
+		VuoCompiler *compiler = initCompiler(compositionPath);
+		VuoDefer(^{ delete compiler; });
+
+		string compositionString = VuoFileUtilities::readFileToString(compositionPath);
+		VuoCompilerComposition *composition = VuoCompilerComposition::newCompositionFromGraphvizDeclaration(compositionString, compiler);
+		VuoDefer(^{ delete composition; });
+
+		string compiledCompositionPath = VuoFileUtilities::makeTmpFile("TestCompositions", "bc");
+		VuoDefer(^{ remove(compiledCompositionPath.c_str()); });
+
+		// Compile once before timing, so that the modules are loaded and (for codegen) the graph and its queries are cached.
+		{
+			VuoCompilerIssues issues;
+			compiler->compileComposition(composition, compiledCompositionPath, true, &issues);
+			QVERIFY2(! issues.hasErrors(), issues.getLongDescription(false).c_str());
+		}
+
+		if (isGraphAnalysis)
+		{
+			QBENCHMARK {
+				composition->invalidateCachedGraph();
+				VuoCompilerGraph *graph = composition->getCachedGraph(compiler);
+
+				// Make the queries that code generation makes for each trigger.
+				graph->getChains();
+				for (VuoCompilerTriggerPort *trigger : graph->getTriggerPorts())
+				{
+					int minThreadsNeeded, maxThreadsNeeded;
+					graph->getWorkerThreadsNeeded(trigger, minThreadsNeeded, maxThreadsNeeded);
+					graph->hasScatterPartiallyOverlappedByAnotherTrigger(trigger);
+
+					for (VuoCompilerNode *node : graph->getNodesDownstream(trigger))
+					{
+						graph->hasScatterPartiallyOverlappedByAnotherTrigger(node, trigger);
+						for (VuoCompilerNode *downstreamNode : graph->getNodesImmediatelyDownstream(node, trigger))
+							graph->mayTransmit(node, downstreamNode, trigger);
+					}
+				}
+			}
+		}
+		else
+		{
+			QBENCHMARK {
+				VuoCompilerIssues issues;
+				compiler->compileComposition(composition, compiledCompositionPath, true, &issues);
+			}
+		}
+	}
+
 };
 
 int main(int argc, char *argv[])
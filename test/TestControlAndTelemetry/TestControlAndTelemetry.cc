@@ -10,6 +10,7 @@
 #include "TestCompositionExecution.hh"
 
 #include <Vuo/Vuo.h>
+#include <atomic>
 #include <sstream>
 #include <mach-o/dyld.h>
 
@@ -2114,6 +2115,95 @@ private:
 		}
 	};
 
+	class TestBatchedTelemetryRunnerDelegate : public TestRunnerDelegate
+	{
+	public:
+		string countPortIdentifier;
+		std::atomic<int> nodeExecutionsStarted;
+		std::atomic<int> nodeExecutionsFinished;
+		std::atomic<int> countUpdates;
+		string lastCountSummary;
+		bool finishedBeforeStarted;
+
+		TestBatchedTelemetryRunnerDelegate()
+		{
+			countPortIdentifier = VuoStringUtilities::buildPortIdentifier("Count3", "count");
+			nodeExecutionsStarted = 0;
+			nodeExecutionsFinished = 0;
+			countUpdates = 0;
+			finishedBeforeStarted = false;
+		}
+
+		void receivedTelemetryNodeExecutionStarted(string compositionIdentifier, string nodeIdentifier)
+		{
+			if (nodeIdentifier == "Count3")
+				++nodeExecutionsStarted;
+		}
+
+		void receivedTelemetryNodeExecutionFinished(string compositionIdentifier, string nodeIdentifier)
+		{
+			if (nodeIdentifier == "Count3" && ++nodeExecutionsFinished > nodeExecutionsStarted)
+				finishedBeforeStarted = true;
+		}
+
+		void receivedTelemetryOutputPortUpdated(string compositionIdentifier, string portIdentifier, bool sentEvent, bool sentData, string dataSummary)
+		{
+			if (portIdentifier == countPortIdentifier)
+			{
+				++countUpdates;
+				lastCountSummary = dataSummary;
+			}
+		}
+	};
+
+	class TestPortDataTelemetryRunnerDelegate : public TestRunnerDelegate
+	{
+	public:
+		string incrementPortIdentifier;
+		string countPortIdentifier;
+		std::atomic<int> incrementUpdates;
+		std::atomic<int> countUpdates;
+		std::atomic<int> otherUpdates;
+		string lastIncrementSummary;
+		string lastCountSummary;
+
+		TestPortDataTelemetryRunnerDelegate()
+		{
+			incrementPortIdentifier = VuoStringUtilities::buildPortIdentifier("Count3", "increment");
+			countPortIdentifier = VuoStringUtilities::buildPortIdentifier("Count3", "count");
+			incrementUpdates = 0;
+			countUpdates = 0;
+			otherUpdates = 0;
+		}
+
+		void receivedTelemetryNodeExecutionStarted(string compositionIdentifier, string nodeIdentifier)
+		{
+			++otherUpdates;
+		}
+
+		void receivedTelemetryInputPortUpdated(string compositionIdentifier, string portIdentifier, bool receivedEvent, bool receivedData, string dataSummary)
+		{
+			if (portIdentifier == incrementPortIdentifier)
+			{
+				++incrementUpdates;
+				lastIncrementSummary = dataSummary;
+			}
+			else
+				++otherUpdates;
+		}
+
+		void receivedTelemetryOutputPortUpdated(string compositionIdentifier, string portIdentifier, bool sentEvent, bool sentData, string dataSummary)
+		{
+			if (portIdentifier == countPortIdentifier)
+			{
+				++countUpdates;
+				lastCountSummary = dataSummary;
+			}
+			else
+				++otherUpdates;
+		}
+	};
+
 private slots:
 
 	void testNoTelemetryForInternalUsePorts()
@@ -2122,6 +2212,93 @@ private slots:
 		delegate.runComposition();
 	}
 
+	void testBatchedTelemetry()
+	{
+		string compositionPath = getCompositionPath("PublishedCount.vuo");
+		VuoRunner *runner = createRunnerInNewProcess(compositionPath);
+		TestBatchedTelemetryRunnerDelegate delegate;
+		runner->setDelegate(&delegate);
+
+		runner->start();
+		runner->subscribeToAllTelemetry("");
+
+		// Each event's batched telemetry should arrive before the event is reported finished.
+		VuoRunner::Port *incrementPort = runner->getPublishedInputPortWithName("Increment");
+		const int eventCount = 20;
+		for (int i = 1; i <= eventCount; ++i)
+		{
+			map<VuoRunner::Port *, json_object *> values;
+			values[incrementPort] = json_object_new_int(1);
+			runner->setPublishedInputPortValues(values);
+			json_object_put(values[incrementPort]);
+
+			runner->firePublishedInputPortEvent(incrementPort);
+			runner->waitForFiredPublishedInputPortEvent();
+
+			QCOMPARE(delegate.nodeExecutionsStarted.load(), i);
+			QCOMPARE(delegate.nodeExecutionsFinished.load(), i);
+			QCOMPARE(delegate.countUpdates.load(), i);
+		}
+
+		runner->stop();
+		delete runner;
+
+		QVERIFY(! delegate.finishedBeforeStarted);
+		QVERIFY(! delegate.lastCountSummary.empty());
+	}
+
+	void testPortDataTelemetry()
+	{
+		string compositionPath = getCompositionPath("PublishedCount.vuo");
+		VuoRunner *runner = createRunnerInNewProcess(compositionPath);
+		TestPortDataTelemetryRunnerDelegate delegate;
+		runner->setDelegate(&delegate);
+
+		runner->start();
+
+		VuoRunner::Port *incrementPort = runner->getPublishedInputPortWithName("Increment");
+		auto fireIncrement = [&](int increment)
+		{
+			map<VuoRunner::Port *, json_object *> values;
+			values[incrementPort] = json_object_new_int(increment);
+			runner->setPublishedInputPortValues(values);
+			json_object_put(values[incrementPort]);
+
+			runner->firePublishedInputPortEvent(incrementPort);
+			runner->waitForFiredPublishedInputPortEvent();
+		};
+
+		// With nothing subscribed, no telemetry should be sent.
+		fireIncrement(1);
+		QCOMPARE(delegate.countUpdates.load(), 0);
+		QCOMPARE(delegate.incrementUpdates.load(), 0);
+
+		// Only the subscribed port should send telemetry, and it should include the port's data.
+		runner->subscribeToOutputPortTelemetry("", delegate.countPortIdentifier);
+		fireIncrement(1);
+		QCOMPARE(delegate.countUpdates.load(), 1);
+		QVERIFY(! delegate.lastCountSummary.empty());
+		QCOMPARE(delegate.incrementUpdates.load(), 0);
+
+		// Switching the subscription to another port should take effect for the next event.
+		runner->unsubscribeFromOutputPortTelemetry("", delegate.countPortIdentifier);
+		runner->subscribeToInputPortTelemetry("", delegate.incrementPortIdentifier);
+		fireIncrement(5);
+		QCOMPARE(delegate.countUpdates.load(), 1);
+		QCOMPARE(delegate.incrementUpdates.load(), 1);
+		QCOMPARE(QString::fromStdString(delegate.lastIncrementSummary), QString("5"));
+
+		runner->unsubscribeFromInputPortTelemetry("", delegate.incrementPortIdentifier);
+		fireIncrement(1);
+		QCOMPARE(delegate.countUpdates.load(), 1);
+		QCOMPARE(delegate.incrementUpdates.load(), 1);
+
+		runner->stop();
+		delete runner;
+
+		QCOMPARE(delegate.otherUpdates.load(), 0);
+	}
+
 	void testEventlessTransmission()
 	{
 		string compositionPath = TestCompositionExecution::getCompositionPath("CutList.vuo");
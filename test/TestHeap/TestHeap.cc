@@ -39,6 +39,77 @@ private slots:
 		VuoRelease(p);
 	}
 
+	void testRefCounted()
+	{
+		static int deallocated;
+		deallocated = 0;
+
+		int *p = (int *)VuoHeap_allocRefCounted(sizeof(int), [](void *){ ++deallocated; });
+		QVERIFY(p);
+		QCOMPARE(*p, 0);
+
+		QCOMPARE(VuoRetain(p), 1);
+		QCOMPARE(VuoRetain(p), 2);
+		QCOMPARE(VuoRelease(p), 1);
+		QCOMPARE(deallocated, 0);
+		QCOMPARE(VuoRelease(p), 0);
+		QCOMPARE(deallocated, 1);
+	}
+
+	void testRefCountedUnpooled()
+	{
+		static int deallocated;
+		deallocated = 0;
+
+		// Too large for the pool.
+		char *p = (char *)VuoHeap_allocRefCounted(64 * 1024, [](void *){ ++deallocated; });
+		QVERIFY(p);
+		QCOMPARE(p[64 * 1024 - 1], 0);
+
+		QCOMPARE(VuoRetain(p), 1);
+		QCOMPARE(VuoRetain(p), 2);
+		QCOMPARE(VuoRelease(p), 1);
+		QCOMPARE(deallocated, 0);
+		QCOMPARE(VuoRelease(p), 0);
+		QCOMPARE(deallocated, 1);
+	}
+
+	void testNotRefCounted()
+	{
+		// Pointers that weren't allocated by VuoHeap_allocRefCounted() should be found in the reference-counting table
+		// (without reading the memory in front of them, which ASan would report).
+		void *m = malloc(16);
+		VuoRegister(m, free);
+		QCOMPARE(VuoRetain(m), 1);
+		QCOMPARE(VuoRelease(m), 0);
+
+		alignas(16) static char staticBuffer[64];
+		VuoRegisterSingleton(staticBuffer);
+		QCOMPARE(VuoRetain(staticBuffer), -1);
+		QCOMPARE(VuoRelease(staticBuffer), -1);
+
+		// An interior pointer at the same offset within a block as a pooled value's payload.
+		char *refCounted = (char *)VuoHeap_allocRefCounted(256, NULL);
+		VuoRetain(refCounted);
+		char *interior = refCounted + 64;
+		VuoRegisterSingleton(interior);
+		QCOMPARE(VuoRetain(interior), -1);
+		QCOMPARE(VuoRetain(refCounted), 2);
+		QCOMPARE(VuoRelease(refCounted), 1);
+		QCOMPARE(VuoRelease(refCounted), 0);
+	}
+
+	void testRefCountedRetainReleasePerformance()
+	{
+		void *p = VuoHeap_allocRefCounted(1, NULL);
+		VuoRetain(p);
+		QBENCHMARK {
+			VuoRetain(p);
+			VuoRelease(p);
+		}
+		VuoRelease(p);
+	}
+
 	// https://b33p.net/kosada/node/12778
 	void testRetainReleaseThreadedPerformance_data()
 	{
@@ -48,6 +119,9 @@ private slots:
 		QTest::newRow("2") << 2;
 		QTest::newRow("4") << 4;
 		QTest::newRow("8") << 8;
+		QTest::newRow("16") << 16;
+		QTest::newRow("32") << 32;
+		QTest::newRow("64") << 64;
 	}
 	void testRetainReleaseThreadedPerformance()
 	{
@@ -76,6 +150,45 @@ private slots:
 		}
 	}
 
+	void testRetainReleaseThreadedDistinctPointersPerformance_data()
+	{
+		testRetainReleaseThreadedPerformance_data();
+	}
+	void testRetainReleaseThreadedDistinctPointersPerformance()
+	{
+		QFETCH(int, threads);
+		QBENCHMARK {
+			dispatch_semaphore_t done = dispatch_semaphore_create(0);
+
+			// Each thread works on its own pointers, as trigger threads typically do.
+			for (int i = 0; i < threads; ++i)
+				dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+					const int pointerCount = 16;
+					void *pointers[pointerCount];
+					for (int j = 0; j < pointerCount; ++j)
+					{
+						pointers[j] = malloc(16);
+						VuoRegister(pointers[j], free);
+						VuoRetain(pointers[j]);
+					}
+
+					for (long i = 0; i < 1000000/threads; ++i)
+					{
+						VuoRetain(pointers[i % pointerCount]);
+						VuoRelease(pointers[i % pointerCount]);
+					}
+
+					for (int j = 0; j < pointerCount; ++j)
+						VuoRelease(pointers[j]);
+
+					dispatch_semaphore_signal(done);
+				});
+
+			for (int i = 0; i < threads; ++i)
+				dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER);
+		}
+	}
+
 	void testIsPointerReadable_data()
 	{
 		QTest::addColumn<void *>("pointer");
@@ -1138,6 +1138,48 @@ private slots:
 		deleteAllModuleCacheLockInfo();
 	}
 
+	void testModuleCompilationPerformance_data()
+	{
+		QTest::addColumn<bool>("shouldCompileInParallel");
+
+		QTest::newRow("built-in modules, one at a time") << false;
+		QTest::newRow("built-in modules, in parallel") << true;
+	}
+	void testModuleCompilationPerformance()
+	{
+		QFETCH(bool, shouldCompileInParallel);
+
+		// Rebuild the built-in modules from scratch in a copy of Vuo.framework, so the original's cache isn't disturbed.
+		string frameworkCopyDir = VuoFileUtilities::makeTmpDir("TestModuleCaches-testModuleCompilationPerformance");
+		string frameworkCopyPath = frameworkCopyDir + "/Vuo.framework";
+		VuoFileUtilities::copyDirectory(VuoFileUtilities::getVuoFrameworkPath(), frameworkCopyPath);
+		string builtInCachePath = frameworkCopyPath + "/Modules/" + VuoModuleCache::builtInCacheDirName;
+		VuoFileUtilities::deleteDir(builtInCachePath);
+
+		VuoCompiler::reset();
+		deleteAllModuleCacheLockInfo();
+
+		QBENCHMARK_ONCE {
+			VuoCompiler::generateBuiltInModuleCache(frameworkCopyPath, VuoCompiler::getProcessTarget(), true, shouldCompileInParallel);
+		}
+
+		size_t compiledModuleCount = 0;
+		auto cachedFiles = VuoFileUtilities::findAllFilesInDirectory(builtInCachePath, set<string>(), true);
+		for (VuoFileUtilities::File *file : cachedFiles)
+		{
+			string dir, name, extension;
+			VuoFileUtilities::splitPath(file->getRelativePath(), dir, name, extension);
+			if (extension == "bc")
+				++compiledModuleCount;
+			delete file;
+		}
+		QVERIFY2(compiledModuleCount > 0, builtInCachePath.c_str());
+
+		VuoCompiler::reset();
+		deleteAllModuleCacheLockInfo();
+		VuoFileUtilities::deleteDir(frameworkCopyDir);
+	}
+
 	void testModuleCacheCheckingPerformance_data()
 	{
 		QTest::addColumn< InstalledModulesChange >("baselineSetup");
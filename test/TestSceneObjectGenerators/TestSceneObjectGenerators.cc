@@ -10,6 +10,11 @@
 #include "TestCompositionExecution.hh"
 #include <Vuo/Vuo.h>
 
+extern "C" {
+#include "VuoMeshParametric.h"
+#include "VuoPointsParametric.h"
+}
+
 // Be able to use these types in QTest::addColumn()
 Q_DECLARE_METATYPE(VuoCompilerNodeClass *);
 Q_DECLARE_METATYPE(string);
@@ -122,6 +127,114 @@ private slots:
 		runner->stop();
 		delete runner;
 	}
+
+	void testParametricMeshNormals_data()
+	{
+		QTest::addColumn<int>("subdivisions");
+		QTest::addColumn<bool>("closeU");
+		QTest::addColumn<bool>("closeV");
+
+		// Below and above the size at which generation is divided among threads.
+		QTest::newRow("small, open")         << 16  << false << false;
+		QTest::newRow("small, closed in U")  << 16  << true  << false;
+		QTest::newRow("small, closed in UV") << 16  << true  << true;
+		QTest::newRow("large, open")         << 256 << false << false;
+		QTest::newRow("large, closed in U")  << 256 << true  << false;
+		QTest::newRow("large, closed in UV") << 256 << true  << true;
+	}
+	void testParametricMeshNormals()
+	{
+		QFETCH(int, subdivisions);
+		QFETCH(bool, closeU);
+		QFETCH(bool, closeV);
+
+		// An open flat plane should have the same normal everywhere.
+		if (!closeU && !closeV)
+		{
+			VuoMesh m = VuoMeshParametric_generate(0, "u", "v", "0", subdivisions, subdivisions, closeU, 0, 1, closeV, 0, 1, nullptr);
+			QVERIFY(m);
+			VuoLocal(m);
+
+			unsigned int vertexCount;
+			float *normals;
+			VuoMesh_getCPUBuffers(m, &vertexCount, nullptr, &normals, nullptr, nullptr, nullptr, nullptr);
+			QCOMPARE(vertexCount, (unsigned int)(subdivisions * subdivisions));
+			for (unsigned int i = 0; i < vertexCount; ++i)
+				QVERIFY2(VuoPoint3d_areEqual(VuoPoint3d_makeFromArray(&normals[i * 3]), VuoPoint3d_make(0, 0, 1)),
+						 qPrintable(QString("vertex %1: %2").arg(i).arg(VuoPoint3d_getSummary(VuoPoint3d_makeFromArray(&normals[i * 3])))));
+		}
+
+		// Generating a curved surface multiple times should produce exactly the same mesh,
+		// regardless of how the work is divided among threads.
+		{
+			const char *xExp = "sin(u*360) * (1 + perlin2d(u*4, v*4) / 4)";
+			const char *yExp = "cos(u*360) * (1 + perlin2d(u*4, v*4) / 4)";
+			const char *zExp = "sin(v*360)";
+			VuoMesh a = VuoMeshParametric_generate(0, xExp, yExp, zExp, subdivisions, subdivisions, closeU, 0, 1, closeV, 0, 1, nullptr);
+			VuoMesh b = VuoMeshParametric_generate(0, xExp, yExp, zExp, subdivisions, subdivisions, closeU, 0, 1, closeV, 0, 1, nullptr);
+			QVERIFY(a);
+			QVERIFY(b);
+			VuoLocal(a);
+			VuoLocal(b);
+
+			unsigned int vertexCountA, vertexCountB, elementCountA, elementCountB;
+			float *positionsA, *positionsB, *normalsA, *normalsB;
+			unsigned int *elementsA, *elementsB;
+			VuoMesh_getCPUBuffers(a, &vertexCountA, &positionsA, &normalsA, nullptr, nullptr, &elementCountA, &elementsA);
+			VuoMesh_getCPUBuffers(b, &vertexCountB, &positionsB, &normalsB, nullptr, nullptr, &elementCountB, &elementsB);
+			QCOMPARE(vertexCountA, vertexCountB);
+			QCOMPARE(elementCountA, elementCountB);
+			QVERIFY(memcmp(positionsA, positionsB, sizeof(float) * 3 * vertexCountA) == 0);
+			QVERIFY(memcmp(normalsA, normalsB, sizeof(float) * 3 * vertexCountA) == 0);
+			QVERIFY(memcmp(elementsA, elementsB, sizeof(unsigned int) * elementCountA) == 0);
+		}
+	}
+
+	void testParametricMeshPerformance_data()
+	{
+		QTest::addColumn<int>("subdivisions");
+
+		QTest::newRow("32x32") << 32;
+		QTest::newRow("128x128") << 128;
+		QTest::newRow("512x512") << 512;
+		QTest::newRow("1024x1024") << 1024;
+	}
+	void testParametricMeshPerformance()
+	{
+		QFETCH(int, subdivisions);
+
+		const char *xExp = "sin((u-.5)*360) * cos((v-.5)*180) / 2.";
+		const char *yExp = "sin((v-.5)*180) / 2.";
+		const char *zExp = "cos((u-.5)*360) * cos((v-.5)*180) / 2. + perlin2d(u, time) / 10";
+
+		double time = 0;
+		QBENCHMARK {
+			VuoMesh m = VuoMeshParametric_generate(time, xExp, yExp, zExp, subdivisions, subdivisions, true, 0, 1, false, 0, 1, nullptr);
+			VuoRetain(m);
+			VuoRelease(m);
+			time += 1./60;
+		}
+	}
+
+	void testParametricPointsPerformance_data()
+	{
+		QTest::addColumn<int>("subdivisions");
+
+		QTest::newRow("32x32") << 32;
+		QTest::newRow("512x512") << 512;
+	}
+	void testParametricPointsPerformance()
+	{
+		QFETCH(int, subdivisions);
+
+		double time = 0;
+		QBENCHMARK {
+			VuoList_VuoPoint3d points = VuoPointsParametric2d_generate(time, "u", "v", "simplex3d(u*8, v*8, time)", subdivisions, subdivisions, 0, 1, 0, 1);
+			VuoRetain(points);
+			VuoRelease(points);
+			time += 1./60;
+		}
+	}
 };
 
 int main(int argc, char *argv[])
@@ -0,0 +1,355 @@
+/**
+ * @file
+ * TestVuoAudio interface and implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+#include <Vuo/Vuo.h>
+
+#include "VuoAudio.h"
+
+/// The number of samples per channel per buffer passed between the test and the simulated device.
+static const unsigned int frameCount = 16;
+
+/// The number of buffers a source must send before it starts playing (`VuoAudio_queueSize`).
+static const unsigned int queueSize = 8;
+
+/// The number of buffers each source's ring holds (`VuoAudio_ringCapacity`).
+static const unsigned int ringCapacity = 4 * queueSize;
+
+/// The number of sources that can send to a device at once (`VuoAudio_maxOutputSources`).
+static const unsigned int maxOutputSources = 32;
+
+/// The number of consecutive idle callbacks after which a source's slot is released (`VuoAudio_idleBuffersBeforeReleasingSource`).
+static const unsigned int idleBuffersBeforeReleasingSource = 2 * VuoAudioSamples_sampleRate / VuoAudioSamples_bufferSize;
+
+/**
+ * Returns a list of `channelCount` channels, each containing `frameCount` copies of `value`.
+ */
+static VuoList_VuoAudioSamples makeChannels(unsigned int channelCount, double value)
+{
+	VuoList_VuoAudioSamples channels = VuoListCreate_VuoAudioSamples();
+	for (unsigned int channel = 0; channel < channelCount; ++channel)
+	{
+		VuoAudioSamples samples = VuoAudioSamples_alloc(frameCount);
+		for (unsigned int i = 0; i < frameCount; ++i)
+			samples.samples[i] = value;
+		VuoListAppendValue_VuoAudioSamples(channels, samples);
+	}
+	return channels;
+}
+
+/**
+ * Sends `count` buffers of `value` on each of `channelCount` channels from the source identified by `id`.
+ */
+static void send(VuoAudioOut ao, void *id, unsigned int count, unsigned int channelCount, double value)
+{
+	VuoList_VuoAudioSamples channels = makeChannels(channelCount, value);
+	VuoLocal(channels);
+	for (unsigned int i = 0; i < count; ++i)
+		VuoAudioOut_sendChannels(ao, channels, id);
+}
+
+static dispatch_semaphore_t receivedInput;	///< Signaled by @ref receivedChannels.
+static dispatch_semaphore_t allowInput;		///< If non-null, @ref receivedChannels waits on this the first time it's called.
+static std::atomic<int> receivedInputCount;	///< The number of times @ref receivedChannels has been called.
+static QList<QList<double>> lastInput;		///< The samples most recently passed to @ref receivedChannels.
+
+/**
+ * An input trigger that records what it receives.
+ */
+static void receivedChannels(VuoList_VuoAudioSamples channels)
+{
+	QList<QList<double>> input;
+	unsigned long channelCount = VuoListGetCount_VuoAudioSamples(channels);
+	for (unsigned long channel = 1; channel <= channelCount; ++channel)
+	{
+		VuoAudioSamples samples = VuoListGetValue_VuoAudioSamples(channels, channel);
+		QList<double> channelSamples;
+		for (VuoInteger i = 0; i < samples.sampleCount; ++i)
+			channelSamples.append(samples.samples[i]);
+		input.append(channelSamples);
+	}
+	lastInput = input;
+
+	bool isFirst = (receivedInputCount++ == 0);
+	dispatch_semaphore_signal(receivedInput);
+
+	if (isFirst && allowInput)
+		dispatch_semaphore_wait(allowInput, DISPATCH_TIME_FOREVER);
+}
+
+/**
+ * Tests the audio device instance's handling of audio input and output,
+ * with the test playing the part of the device.
+ */
+class TestVuoAudio : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void init()
+	{
+		receivedInput = dispatch_semaphore_create(0);
+		allowInput = NULL;
+		receivedInputCount = 0;
+		lastInput.clear();
+	}
+
+	void cleanup()
+	{
+		dispatch_release(receivedInput);
+		if (allowInput)
+			dispatch_release(allowInput);
+	}
+
+	void testOutputPriming()
+	{
+		VuoAudioOut ao = VuoAudio_makeWithoutDevice(0, 2, frameCount);
+		VuoRetain(ao);
+		int source;
+		double output[2 * frameCount];
+
+		// Until a source has sent enough buffers, it shouldn't start playing.
+		send(ao, &source, queueSize - 1, 2, 1);
+		VuoAudio_processBuffers(ao, output, NULL, 0);
+		for (unsigned int i = 0; i < 2 * frameCount; ++i)
+			QCOMPARE(output[i], 0.);
+
+		// The first buffer should fade in.
+		send(ao, &source, 1, 2, 1);
+		VuoAudio_processBuffers(ao, output, NULL, 0);
+		for (unsigned int channel = 0; channel < 2; ++channel)
+			for (unsigned int i = 0; i < frameCount; ++i)
+				QCOMPARE(output[channel * frameCount + i], (float)i/frameCount * 1.);
+
+		// Subsequent buffers should play intact.
+		for (unsigned int buffer = 1; buffer < queueSize; ++buffer)
+		{
+			VuoAudio_processBuffers(ao, output, NULL, 0);
+			for (unsigned int i = 0; i < 2 * frameCount; ++i)
+				QCOMPARE(output[i], 1.);
+		}
+
+		VuoInteger underrunCount, overrunCount;
+		VuoAudioOut_getStatistics(ao, &underrunCount, &overrunCount);
+		QCOMPARE(underrunCount, 0LL);
+		QCOMPARE(overrunCount, 0LL);
+
+		// When the source runs out, it should fade out, and count as an underrun.
+		VuoAudio_processBuffers(ao, output, NULL, 0);
+		for (unsigned int channel = 0; channel < 2; ++channel)
+			for (unsigned int i = 0; i < frameCount; ++i)
+				QCOMPARE(output[channel * frameCount + i], VuoReal_lerp(1, 0, (float)i/frameCount));
+
+		VuoAudio_processBuffers(ao, output, NULL, 0);
+		for (unsigned int i = 0; i < 2 * frameCount; ++i)
+			QCOMPARE(output[i], 0.);
+
+		VuoAudioOut_getStatistics(ao, &underrunCount, &overrunCount);
+		QCOMPARE(underrunCount, 1LL);
+		QCOMPARE(overrunCount, 0LL);
+
+		VuoRelease(ao);
+	}
+
+	void testOutputMixing()
+	{
+		VuoAudioOut ao = VuoAudio_makeWithoutDevice(0, 2, frameCount);
+		VuoRetain(ao);
+		int sourceA, sourceB;
+		double output[2 * frameCount];
+
+		// Source A sends to both channels; source B sends only to the first channel.
+		send(ao, &sourceA, queueSize, 2, 1);
+		send(ao, &sourceB, queueSize, 1, .5);
+
+		VuoAudio_processBuffers(ao, output, NULL, 0);
+		for (unsigned int i = 0; i < frameCount; ++i)
+		{
+			QCOMPARE(output[i], (float)i/frameCount * 1. + (float)i/frameCount * .5);
+			QCOMPARE(output[frameCount + i], (float)i/frameCount * 1.);
+		}
+
+		VuoAudio_processBuffers(ao, output, NULL, 0);
+		for (unsigned int i = 0; i < frameCount; ++i)
+		{
+			QCOMPARE(output[i], 1.5);
+			QCOMPARE(output[frameCount + i], 1.);
+		}
+
+		// When one source drops out, it should fade out without affecting the other source.
+		for (unsigned int buffer = 2; buffer < queueSize; ++buffer)
+			VuoAudio_processBuffers(ao, output, NULL, 0);
+		send(ao, &sourceA, 1, 2, 1);
+		VuoAudio_processBuffers(ao, output, NULL, 0);
+		for (unsigned int i = 0; i < frameCount; ++i)
+		{
+			QCOMPARE(output[i], 1. + VuoReal_lerp(.5, 0, (float)i/frameCount));
+			QCOMPARE(output[frameCount + i], 1.);
+		}
+
+		VuoInteger underrunCount, overrunCount;
+		VuoAudioOut_getStatistics(ao, &underrunCount, &overrunCount);
+		QCOMPARE(underrunCount, 1LL);
+		QCOMPARE(overrunCount, 0LL);
+
+		VuoRelease(ao);
+	}
+
+	void testOutputOverrun()
+	{
+		VuoAudioOut ao = VuoAudio_makeWithoutDevice(0, 2, frameCount);
+		VuoRetain(ao);
+		int source;
+
+		// Buffers beyond the ring's capacity should be dropped.
+		send(ao, &source, ringCapacity + 5, 2, 1);
+
+		VuoInteger underrunCount, overrunCount;
+		VuoAudioOut_getStatistics(ao, &underrunCount, &overrunCount);
+		QCOMPARE(underrunCount, 0LL);
+		QCOMPARE(overrunCount, 5LL);
+
+		// After the device plays some, there should be room for more.
+		double output[2 * frameCount];
+		VuoAudio_processBuffers(ao, output, NULL, 0);
+		send(ao, &source, 1, 2, 1);
+		VuoAudioOut_getStatistics(ao, &underrunCount, &overrunCount);
+		QCOMPARE(overrunCount, 5LL);
+
+		VuoRelease(ao);
+	}
+
+	void testOutputSlotReuse()
+	{
+		VuoAudioOut ao = VuoAudio_makeWithoutDevice(0, 2, frameCount);
+		VuoRetain(ao);
+		int sourceA, sourceB;
+		double output[2 * frameCount];
+
+		// Source A sends too few buffers to start playing, then stops sending.
+		send(ao, &sourceA, 3, 2, 1);
+
+		// Once A has been idle long enough, its slot is released…
+		for (unsigned int buffer = 0; buffer < idleBuffersBeforeReleasingSource; ++buffer)
+		{
+			VuoAudio_processBuffers(ao, output, NULL, 0);
+			for (unsigned int i = 0; i < 2 * frameCount; ++i)
+				QCOMPARE(output[i], 0.);
+		}
+
+		// …and immediately claimed by source B, which should only hear its own buffers, not A's leftovers.
+		send(ao, &sourceB, queueSize, 2, .25);
+		for (unsigned int buffer = 0; buffer < queueSize; ++buffer)
+		{
+			VuoAudio_processBuffers(ao, output, NULL, 0);
+			for (unsigned int channel = 0; channel < 2; ++channel)
+				for (unsigned int i = 0; i < frameCount; ++i)
+					QCOMPARE(output[channel * frameCount + i], buffer == 0 ? (float)i/frameCount * .25 : .25);
+		}
+
+		VuoRelease(ao);
+	}
+
+	void testOutputConcurrentSenders()
+	{
+		VuoAudioOut ao = VuoAudio_makeWithoutDevice(0, 2, frameCount);
+		VuoRetain(ao);
+
+		// Several threads repeatedly send bursts of buffers, each burst as a new source,
+		// while the device plays them and releases the slots of sources that have gone idle.
+		const int senderCount = 4;
+		const int burstsPerSender = 50;
+		dispatch_group_t senders = dispatch_group_create();
+		dispatch_queue_t senderQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+		for (int sender = 0; sender < senderCount; ++sender)
+			dispatch_group_async(senders, senderQueue, ^{
+				for (int burst = 0; burst < burstsPerSender; ++burst)
+				{
+					void *id = (void *)(uintptr_t)(1 + sender * burstsPerSender + burst);
+					send(ao, id, queueSize + burst % queueSize, 2, 1);
+					usleep(100);
+				}
+			});
+
+		// No source sends more than 1.0, so the mix can't exceed the number of slots.
+		double output[2 * frameCount];
+		do
+		{
+			VuoAudio_processBuffers(ao, output, NULL, 0);
+			for (unsigned int i = 0; i < 2 * frameCount; ++i)
+				QVERIFY2(output[i] >= 0 && output[i] <= maxOutputSources, qPrintable(QString::number(output[i])));
+		} while (dispatch_group_wait(senders, DISPATCH_TIME_NOW));
+		dispatch_release(senders);
+
+		VuoRelease(ao);
+	}
+
+	void testInput()
+	{
+		VuoAudioIn ai = VuoAudio_makeWithoutDevice(2, 0, frameCount);
+		VuoRetain(ai);
+		VuoAudioIn_addTrigger(ai, receivedChannels);
+
+		double input[2 * frameCount];
+		for (unsigned int i = 0; i < frameCount; ++i)
+		{
+			input[i] = i;
+			input[frameCount + i] = -(double)i;
+		}
+		VuoAudio_processBuffers(ai, NULL, input, 0);
+
+		QCOMPARE(dispatch_semaphore_wait(receivedInput, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), 0L);
+		QCOMPARE(lastInput.size(), 2);
+		for (unsigned int i = 0; i < frameCount; ++i)
+		{
+			QCOMPARE(lastInput[0][i], (double)i);
+			QCOMPARE(lastInput[1][i], -(double)i);
+		}
+
+		VuoInteger overrunCount;
+		VuoAudioIn_getStatistics(ai, &overrunCount);
+		QCOMPARE(overrunCount, 0LL);
+
+		VuoAudioIn_removeTrigger(ai, receivedChannels);
+		VuoRelease(ai);
+	}
+
+	void testInputOverrun()
+	{
+		VuoAudioIn ai = VuoAudio_makeWithoutDevice(2, 0, frameCount);
+		VuoRetain(ai);
+		allowInput = dispatch_semaphore_create(0);
+		VuoAudioIn_addTrigger(ai, receivedChannels);
+
+		// Block delivery in the first trigger call…
+		double input[2 * frameCount] = {0};
+		VuoAudio_processBuffers(ai, NULL, input, 0);
+		QCOMPARE(dispatch_semaphore_wait(receivedInput, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), 0L);
+
+		// …so the device fills the ring, and further buffers are dropped.
+		for (unsigned int buffer = 0; buffer < ringCapacity + 5; ++buffer)
+			VuoAudio_processBuffers(ai, NULL, input, 0);
+
+		VuoInteger overrunCount;
+		VuoAudioIn_getStatistics(ai, &overrunCount);
+		QCOMPARE(overrunCount, 5LL);
+
+		// Once delivery resumes, the buffers that fit in the ring should still be delivered.
+		dispatch_semaphore_signal(allowInput);
+		for (unsigned int buffer = 0; buffer < ringCapacity; ++buffer)
+			QCOMPARE(dispatch_semaphore_wait(receivedInput, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)), 0L);
+		QCOMPARE(receivedInputCount.load(), (int)ringCapacity + 1);
+
+		VuoAudioIn_removeTrigger(ai, receivedChannels);
+		VuoRelease(ai);
+	}
+};
+
+QTEST_APPLESS_MAIN(TestVuoAudio)
+#include "TestVuoAudio.moc"
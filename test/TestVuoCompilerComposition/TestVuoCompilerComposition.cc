@@ -34,6 +34,65 @@ public:
 		cleanupCompiler();
 	}
 
+private:
+	/**
+	 * Returns a description of the analysis that @a graph has done for each trigger,
+	 * identifying triggers and nodes by name so that graphs with different published nodes can be compared.
+	 */
+	string summarizeGraph(VuoCompilerGraph *graph)
+	{
+		map<VuoCompilerTriggerPort *, vector<VuoCompilerChain *> > chains = graph->getChains();
+
+		map<string, string> summaryForTrigger;
+		for (VuoCompilerTriggerPort *trigger : graph->getTriggerPorts())
+		{
+			// Nodes and chains that aren't ordered relative to each other may be listed in either order,
+			// depending on where the published nodes were allocated, so sort them.
+
+			set<string> downstreamNodes;
+			for (VuoCompilerNode *node : graph->getNodesDownstream(trigger))
+				downstreamNodes.insert(node->getIdentifier() + (graph->isRepeatedInFeedbackLoop(node, trigger) ? "*" : ""));
+
+			set<string> chainsForTrigger;
+			for (VuoCompilerChain *chain : chains[trigger])
+			{
+				ostringstream chainSummary;
+				chainSummary << "[";
+				for (VuoCompilerNode *node : chain->getNodes())
+					chainSummary << " " << node->getIdentifier();
+				chainSummary << " ]" << (chain->isLastNodeInLoop() ? "*" : "");
+				chainsForTrigger.insert(chainSummary.str());
+			}
+
+			ostringstream summary;
+			for (string node : downstreamNodes)
+				summary << " " << node;
+			summary << " |";
+			for (string chain : chainsForTrigger)
+				summary << " " << chain;
+
+			string triggerIdentifier = graph->getNodeForTriggerPort(trigger)->getIdentifier() + ":" + trigger->getBase()->getClass()->getName();
+			summaryForTrigger[triggerIdentifier] = summary.str();
+		}
+
+		ostringstream summary;
+		for (auto i : summaryForTrigger)
+			summary << i.first << ":" << i.second << "\n";
+		return summary.str();
+	}
+
+	/**
+	 * Checks that @a graph, which has been updated after modifying @a composition, matches a graph newly constructed from @a composition.
+	 */
+	void compareGraphs(VuoCompilerGraph *graph, VuoCompilerComposition *composition, string description)
+	{
+		VuoCompilerGraph freshGraph(composition, compiler);
+
+		string actual = summarizeGraph(graph);
+		string expected = summarizeGraph(&freshGraph);
+		QVERIFY2(actual == expected, (description + "\n" + actual + "---\n" + expected).c_str());
+	}
+
 private slots:
 	void testDiff_data()
 	{
@@ -603,6 +662,122 @@ private slots:
 		QCOMPARE((hash1 == hash2), hashesEqual);
 	}
 
+	void testUpdateGraph_data()
+	{
+		QTest::addColumn<QString>("compositionFile");
+
+		QTest::newRow("Published ports and a feedback loop") << "GraphHashTest.vuo";
+		QTest::newRow("Nested feedback loops") << "NestedLoopsBothTriggered.vuo";
+		QTest::newRow("Infinite feedback loop") << "Recur_Count_infiniteLoop.vuo";
+		QTest::newRow("Two triggers") << "TwoUpstream-OneCloser.vuo";
+	}
+	void testUpdateGraph()
+	{
+		QFETCH(QString, compositionFile);
+
+		string compositionPath = getCompositionPath(compositionFile.toStdString());
+		VuoCompilerGraphvizParser *parser = VuoCompilerGraphvizParser::newParserFromCompositionFile(compositionPath, compiler);
+		VuoCompilerComposition composition(new VuoComposition(), parser);
+		delete parser;
+
+		VuoCompilerGraph graph(&composition, compiler);
+
+		// VuoComposition::removeCable() disconnects the cable, so remember its endpoints in order to reconnect it when re-adding it.
+		typedef pair< pair<VuoNode *, VuoPort *>, pair<VuoNode *, VuoPort *> > Endpoints;
+		auto removeCable = [&composition](VuoCable *cable)
+		{
+			Endpoints endpoints = make_pair(make_pair(cable->getFromNode(), cable->getFromPort()),
+											make_pair(cable->getToNode(), cable->getToPort()));
+			composition.getBase()->removeCable(cable);
+			return endpoints;
+		};
+		auto addCable = [&composition](VuoCable *cable, const Endpoints &endpoints)
+		{
+			composition.getBase()->addCable(cable);
+			cable->setFrom(endpoints.first.first, endpoints.first.second);
+			cable->setTo(endpoints.second.first, endpoints.second.second);
+		};
+
+		// Remove each cable, then put it back.
+		set<VuoCable *> cables = composition.getBase()->getCables();
+		for (VuoCable *cable : cables)
+		{
+			string description = cable->getCompiler()->getGraphvizDeclaration();
+
+			Endpoints endpoints = removeCable(cable);
+			QVERIFY2(graph.update(&composition), description.c_str());
+			compareGraphs(&graph, &composition, "removed " + description);
+
+			addCable(cable, endpoints);
+			QCOMPARE(QString::fromStdString(cable->getCompiler()->getGraphvizDeclaration()), QString::fromStdString(description));
+			QVERIFY2(graph.update(&composition), description.c_str());
+			compareGraphs(&graph, &composition, "re-added " + description);
+		}
+
+		// Reconnect each cable to its downstream node's refresh port, then put it back.
+		for (VuoCable *cable : cables)
+		{
+			if (cable->isPublished())
+				continue;
+
+			VuoNode *toNode = cable->getToNode();
+			VuoPort *toPort = cable->getToPort();
+			VuoPort *refreshPort = toNode->hasCompiler() ? toNode->getRefreshPort() : NULL;
+			if (! refreshPort || refreshPort == toPort)
+				continue;
+
+			string description = cable->getCompiler()->getGraphvizDeclaration();
+
+			cable->setTo(toNode, refreshPort);
+			QVERIFY2(graph.update(&composition), description.c_str());
+			compareGraphs(&graph, &composition, "reconnected " + description);
+
+			cable->setTo(toNode, toPort);
+			QVERIFY2(graph.update(&composition), description.c_str());
+			compareGraphs(&graph, &composition, "restored " + description);
+		}
+
+		// Remove each node along with its cables, then put them back.
+		set<VuoNode *> nodes = composition.getBase()->getNodes();
+		for (VuoNode *node : nodes)
+		{
+			string description = node->getTitle();
+
+			set<VuoCable *> connectedCables;
+			for (VuoCable *cable : composition.getBase()->getCables())
+				if (cable->getFromNode() == node || cable->getToNode() == node)
+					connectedCables.insert(cable);
+
+			map<VuoCable *, Endpoints> endpointsForCable;
+			for (VuoCable *cable : connectedCables)
+				endpointsForCable[cable] = removeCable(cable);
+			composition.getBase()->removeNode(node);
+			QVERIFY2(graph.update(&composition), description.c_str());
+			compareGraphs(&graph, &composition, "removed " + description);
+
+			composition.getBase()->addNode(node);
+			for (VuoCable *cable : connectedCables)
+				addCable(cable, endpointsForCable[cable]);
+			QVERIFY2(graph.update(&composition), description.c_str());
+			compareGraphs(&graph, &composition, "re-added " + description);
+		}
+
+		// All cables should be connected as they were to begin with.
+		QVERIFY(composition.getBase()->getCables() == cables);
+		for (VuoCable *cable : cables)
+			QVERIFY(cable->getFromPort() && cable->getToPort());
+
+		// The cached graph should be updated rather than replaced.
+		VuoCompilerGraph *cachedGraph = composition.getCachedGraph(compiler);
+		VuoCable *cable = *cables.begin();
+		Endpoints endpoints = removeCable(cable);
+		QCOMPARE(composition.getCachedGraph(compiler), cachedGraph);
+		compareGraphs(cachedGraph, &composition, "cached graph, removed cable");
+		addCable(cable, endpoints);
+		QCOMPARE(composition.getCachedGraph(compiler), cachedGraph);
+		compareGraphs(cachedGraph, &composition, "cached graph, re-added cable");
+	}
+
 	void testMissingNodeClasses_data()
 	{
 		QTest::addColumn<QString>("compositionFile");
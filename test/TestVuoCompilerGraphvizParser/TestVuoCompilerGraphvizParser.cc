@@ -10,8 +10,20 @@
 #include <libgen.h>
 #include <fcntl.h>
 #include <fstream>
+#include <graphviz/gvc.h>
 #include "TestVuoCompiler.hh"
 
+extern gvplugin_library_t gvplugin_dot_layout_LTX_library; ///< Reference to the statically-built Graphviz Dot library.
+extern gvplugin_library_t gvplugin_core_LTX_library; ///< Reference to the statically-built Graphviz core library.
+
+/// Graphviz plugins, for comparing VuoCompilerGraphvizReader's record labels with Graphviz's.
+static lt_symlist_t TestVuoCompilerGraphvizParser_graphvizPlugins[] =
+{
+	{ "gvplugin_dot_layout_LTX_library", &gvplugin_dot_layout_LTX_library},
+	{ "gvplugin_core_LTX_library", &gvplugin_core_LTX_library},
+	{ 0, 0}
+};
+
 class TestVuoCompilerGraphvizParser;
 typedef Module * (TestVuoCompilerGraphvizParser::*moduleFunction_t)(void);  ///< A function that creates a @c Module.
 
@@ -466,6 +478,243 @@ private slots:
 		}
 	}
 
+	void testParsingEscapedTitles_data()
+	{
+		QTest::addColumn< QString >("title");
+
+		QTest::newRow("plain") << "Add";
+		QTest::newRow("record separators") << "a|b {c}";
+		QTest::newRow("angle brackets") << "<x>";
+		QTest::newRow("quotes and backslashes") << "say \"hi\" \\ bye";
+		QTest::newRow("double spaces") << "a  b";
+		QTest::newRow("non-ASCII") << "流 🙏🏽";
+	}
+	void testParsingEscapedTitles()
+	{
+		QFETCH(QString, title);
+
+		string composition = "digraph G\n{\n"
+							 "Add [type=\"vuo.math.add.VuoInteger\" label=\"" + VuoStringUtilities::transcodeToGraphvizIdentifier(title.toStdString()) +
+							 "|<refresh>refresh\\l|<values>values\\l|<sum>sum\\r\" pos=\"10,20\"];\n"
+							 "}\n";
+
+		VuoCompilerGraphvizParser *parser = VuoCompilerGraphvizParser::newParserFromCompositionString(composition, compiler);
+		QCOMPARE(parser->getNodes().size(), (size_t)1);
+		QCOMPARE(QString::fromStdString(parser->getNodes()[0]->getTitle()), title);
+		delete parser;
+	}
+
+	void testParsingConcurrently()
+	{
+		QStringList compositionPaths = getExampleCompositionPaths("../../example") + getExampleCompositionPaths("../../node");
+		QVERIFY(! compositionPaths.empty());
+
+		// Summarizes each composition's nodes and cables in the order the parser returns them.
+		auto summarize = [](VuoCompilerGraphvizParser *parser)
+		{
+			string summary;
+			for (VuoNode *node : parser->getNodes())
+				summary += node->getNodeClass()->getClassName() + " " + node->getTitle() + "\n";
+			for (VuoCable *cable : parser->getCables())
+				summary += cable->getFromPort()->getClass()->getName() + " -> " + cable->getToPort()->getClass()->getName() + "\n";
+			return summary;
+		};
+
+		vector<string> compositions;
+		vector<string> expectedSummaries;
+		for (QString path : compositionPaths)
+		{
+			compositions.push_back(VuoFileUtilities::readFileToString(path.toStdString()));
+			VuoCompilerGraphvizParser *parser = VuoCompilerGraphvizParser::newParserFromCompositionString(compositions.back(), compiler);
+			expectedSummaries.push_back(summarize(parser));
+			delete parser;
+		}
+
+		vector<string> *actualSummaries = new vector<string>(compositions.size());
+		vector<string> *compositionsPtr = &compositions;
+		VuoCompiler *c = compiler;
+		dispatch_apply(compositions.size(), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i){
+			VuoCompilerGraphvizParser *parser = VuoCompilerGraphvizParser::newParserFromCompositionString(compositionsPtr->at(i), c);
+			actualSummaries->at(i) = summarize(parser);
+			delete parser;
+		});
+
+		for (size_t i = 0; i < compositions.size(); ++i)
+			QVERIFY2(actualSummaries->at(i) == expectedSummaries[i], compositionPaths[i].toUtf8().constData());
+
+		delete actualSummaries;
+	}
+
+	void testReaderMatchesGraphviz_data()
+	{
+		QTest::addColumn< QString >("compositionPath");
+
+		for (QString path : getExampleCompositionPaths("../../example") + getExampleCompositionPaths("../../node"))
+			QTest::newRow(path.toUtf8().constData()) << path;
+	}
+	void testReaderMatchesGraphviz()
+	{
+		QFETCH(QString, compositionPath);
+
+		string composition = VuoFileUtilities::readFileToString(compositionPath.toStdString());
+		VuoCompilerGraphvizReader reader(composition);
+
+		Agraph_t *graph = agmemread((char *)composition.c_str());
+		QVERIFY(graph);
+
+		QCOMPARE(QString::fromStdString(reader.getGraphName()), QString::fromUtf8(agnameof(graph)));
+
+		auto attributeString = [](const char *value)
+		{
+			return value ? QString::fromUtf8(value) : QString("(undeclared)");
+		};
+
+		// Nodes should be in the order agfstnode()/agnxtnode() visit them,
+		// with the same value (explicit or declared default) for each attribute Graphviz knows of.
+		vector<Agnode_t *> graphvizNodes;
+		for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+			graphvizNodes.push_back(n);
+
+		const vector<VuoCompilerGraphvizReader::Node *> &readerNodes = reader.getNodes();
+		QCOMPARE(readerNodes.size(), graphvizNodes.size());
+
+		for (size_t i = 0; i < graphvizNodes.size(); ++i)
+		{
+			QCOMPARE(QString::fromStdString(readerNodes[i]->getName()), QString::fromUtf8(agnameof(graphvizNodes[i])));
+
+			for (Agsym_t *sym = agnxtattr(graph, AGNODE, NULL); sym; sym = agnxtattr(graph, AGNODE, sym))
+			{
+				QString actual = attributeString(readerNodes[i]->getAttribute(sym->name));
+				QString expected = attributeString(agxget(graphvizNodes[i], sym));
+				QVERIFY2(actual == expected, QString("node %1, attribute %2: %3 != %4")
+						 .arg(agnameof(graphvizNodes[i]), sym->name, actual, expected).toUtf8().constData());
+			}
+		}
+
+		// Edges should be in the order the parser used to visit them with agfstedge()/agnxtedge(),
+		// skipping edges already visited from an earlier node.
+		vector<Agedge_t *> graphvizEdges;
+		set<Agnode_t *> nodesSeen;
+		for (Agnode_t *n = agfstnode(graph); n; n = agnxtnode(graph, n))
+		{
+			for (Agedge_t *e = agfstedge(graph, n); e; e = agnxtedge(graph, e, n))
+				if (nodesSeen.find(agtail(e)) == nodesSeen.end() && nodesSeen.find(aghead(e)) == nodesSeen.end())
+					graphvizEdges.push_back(e);
+
+			nodesSeen.insert(n);
+		}
+
+		const vector<VuoCompilerGraphvizReader::Edge *> &readerEdges = reader.getEdges();
+		QCOMPARE(readerEdges.size(), graphvizEdges.size());
+
+		for (size_t i = 0; i < graphvizEdges.size(); ++i)
+		{
+			QCOMPARE(QString::fromStdString(readerEdges[i]->getTail()->getName()), QString::fromUtf8(agnameof(agtail(graphvizEdges[i]))));
+			QCOMPARE(QString::fromStdString(readerEdges[i]->getHead()->getName()), QString::fromUtf8(agnameof(aghead(graphvizEdges[i]))));
+
+			for (Agsym_t *sym = agnxtattr(graph, AGEDGE, NULL); sym; sym = agnxtattr(graph, AGEDGE, sym))
+			{
+				QString actual = attributeString(readerEdges[i]->getAttribute(sym->name));
+				QString expected = attributeString(agxget(graphvizEdges[i], sym));
+				QVERIFY2(actual == expected, QString("edge %1, attribute %2: %3 != %4")
+						 .arg(i).arg(sym->name, actual, expected).toUtf8().constData());
+			}
+		}
+
+		// Lay out the graph, like the parser used to, so that Graphviz splits each node's label into record fields
+		// and resolves each edge's ports.
+		agattr(graph, AGNODE, (char *)"shape", (char *)"Mrecord");
+		GVC_t *context = gvContextPlugins(TestVuoCompilerGraphvizParser_graphvizPlugins, false);
+		QCOMPARE(gvLayout(context, graph, "dot"), 0);
+
+		for (size_t i = 0; i < graphvizNodes.size(); ++i)
+		{
+			field_t *info = (field_t *)ND_shape_info(graphvizNodes[i]);
+			const vector<VuoCompilerGraphvizReader::Field> &fields = readerNodes[i]->getFields();
+			QCOMPARE((int)fields.size(), info->n_flds);
+
+			for (int j = 0; j < info->n_flds; ++j)
+			{
+				field_t *field = info->fld[j];
+				QCOMPARE(fields[j].hasId, field->id != NULL);
+				if (field->id)
+					QCOMPARE(QString::fromStdString(fields[j].id), QString::fromUtf8(field->id));
+				QCOMPARE(QString::fromStdString(fields[j].text), QString::fromUtf8(field->lp ? field->lp->text : ""));
+			}
+		}
+
+		for (size_t i = 0; i < graphvizEdges.size(); ++i)
+		{
+			const char *tailPort = ED_tail_port(graphvizEdges[i]).name;
+			const char *headPort = ED_head_port(graphvizEdges[i]).name;
+			QCOMPARE(QString::fromStdString(readerEdges[i]->getTailPort()), QString::fromUtf8(tailPort ? tailPort : ""));
+			QCOMPARE(QString::fromStdString(readerEdges[i]->getHeadPort()), QString::fromUtf8(headPort ? headPort : ""));
+		}
+
+		gvFreeLayout(context, graph);
+		agclose(graph);
+		gvFreeContext(context);
+	}
+
+	void testParsingPerformance_data()
+	{
+		QTest::addColumn< QStringList >("compositionPaths");
+		QTest::addColumn< bool >("isConcurrent");
+
+		QStringList examples = getExampleCompositionPaths("../../example");
+		QStringList nodeSetExamples = getExampleCompositionPaths("../../node");
+
+		QTest::newRow("example, serial") << examples << false;
+		QTest::newRow("node set examples, serial") << nodeSetExamples << false;
+		QTest::newRow("node set examples, concurrent") << nodeSetExamples << true;
+	}
+	void testParsingPerformance()
+	{
+		QFETCH(QStringList, compositionPaths);
+		QFETCH(bool, isConcurrent);
+
+		vector<string> *compositions = new vector<string>;
+		for (QString path : compositionPaths)
+			compositions->push_back(VuoFileUtilities::readFileToString(path.toStdString()));
+
+		// Load the node classes up front, so the benchmark measures just the parsing.
+		for (const string &composition : *compositions)
+			delete VuoCompilerGraphvizParser::newParserFromCompositionString(composition, compiler);
+
+		VuoCompiler *c = compiler;
+		QBENCHMARK {
+			if (isConcurrent)
+				dispatch_apply(compositions->size(), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i){
+					delete VuoCompilerGraphvizParser::newParserFromCompositionString(compositions->at(i), c);
+				});
+			else
+				for (const string &composition : *compositions)
+					delete VuoCompilerGraphvizParser::newParserFromCompositionString(composition, c);
+		}
+
+		delete compositions;
+	}
+
+private:
+	/**
+	 * Returns the paths of the .vuo files in `dir` and its subdirectories whose parent folder is named `examples`
+	 * (or, for the top-level `example` folder, all .vuo files).
+	 */
+	QStringList getExampleCompositionPaths(QString dir)
+	{
+		bool isNodeSetFolder = QDir(dir).dirName() == "node";
+
+		QStringList paths;
+		QDirIterator it(dir, QStringList("*.vuo"), QDir::Files, QDirIterator::Subdirectories);
+		while (it.hasNext())
+		{
+			QString path = it.next();
+			if (! isNodeSetFolder || QFileInfo(path).dir().dirName() == "examples")
+				paths.append(path);
+		}
+		paths.sort();
+		return paths;
+	}
 };
 
 QTEST_APPLESS_MAIN(TestVuoCompilerGraphvizParser)
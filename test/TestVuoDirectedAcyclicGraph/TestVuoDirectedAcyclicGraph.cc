@@ -457,6 +457,58 @@ private slots:
 			delete graph;
 	}
 
+	void testPerformance_data()
+	{
+		QTest::addColumn<bool>("isUpstream");
+		QTest::addColumn<bool>("isModifying");
+
+		QTest::newRow("downstream") << false << false;
+		QTest::newRow("upstream") << true << false;
+		QTest::newRow("upstream, adding and removing edges") << true << true;
+	}
+	void testPerformance()
+	{
+		QFETCH(bool, isUpstream);
+		QFETCH(bool, isModifying);
+
+		// Like the dependency graph for a large set of installed modules:
+		// each module depends on a few modules with higher indices (which tend to be nearby, as within a node set).
+		const int moduleCount = 10000;
+		const int dependencyCount = 5;
+		const int dependencyRange = 200;
+
+		srand(1);
+		VuoDirectedAcyclicGraph graph;
+		vector<Vertex *> vertices;
+		for (int i = 0; i < moduleCount; ++i)
+		{
+			Vertex *vertex = new Vertex(QString("module%1").arg(i));
+			vertices.push_back(vertex);
+			graph.addVertex(vertex);
+		}
+		for (int i = 0; i < moduleCount - 1; ++i)
+			for (int j = 0; j < dependencyCount; ++j)
+				graph.addEdge(vertices[i], vertices[i + 1 + rand() % std::min(moduleCount - i - 1, dependencyRange)]);
+
+		QBENCHMARK {
+			size_t reachableCount = 0;
+			for (int i = 0; i < moduleCount; i += 10)
+			{
+				if (isModifying)
+				{
+					graph.addEdge(vertices[i], vertices[moduleCount - 1]);
+					graph.removeEdge(vertices[i], vertices[moduleCount - 1]);
+				}
+
+				vector<VuoDirectedAcyclicGraph::Vertex *> reachable = isUpstream ?
+																		  graph.getUpstreamVertices(vertices[i]) :
+																		  graph.getDownstreamVertices(vertices[i]);
+				reachableCount += reachable.size();
+			}
+			QVERIFY(reachableCount > 0);
+		}
+	}
+
 };
 
 QTEST_APPLESS_MAIN(TestVuoDirectedAcyclicGraph)
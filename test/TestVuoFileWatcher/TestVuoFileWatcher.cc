@@ -0,0 +1,219 @@
+/**
+ * @file
+ * TestVuoFileWatcher interface and implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+#include <Vuo/Vuo.h>
+
+#include <list>
+#include <mutex>
+#include <unistd.h>
+#include "VuoFileWatcher.hh"
+
+/// How long the watcher waits for further changes before notifying the delegate.
+static const double coalescingWindowSeconds = 0.5;
+
+/// How long to wait between changes that should be delivered by FSEvents separately but coalesced into the same notification.
+/// Longer than the FSEvents stream's latency, and shorter than @ref coalescingWindowSeconds.
+static const useconds_t stepMicroseconds = 150000;
+
+/**
+ * Records each notification from a @ref VuoFileWatcher.
+ */
+class TestVuoFileWatcherDelegate : public VuoFileWatcherDelegate
+{
+public:
+	/// The paths passed to one call to @ref filesChanged, relative to the folder being watched ("." for the folder itself).
+	struct Batch
+	{
+		QStringList added;  ///< The paths added.
+		QStringList modified;  ///< The paths modified.
+		QStringList removed;  ///< The paths removed.
+	};
+
+	TestVuoFileWatcherDelegate(void)
+	{
+		received = dispatch_semaphore_create(0);
+	}
+
+	~TestVuoFileWatcherDelegate(void)
+	{
+		dispatch_release(received);
+	}
+
+	void filesChanged(const string &fileBeingWatched, const set<string> &pathsAdded, const set<string> &pathsModified, const set<string> &pathsRemoved)
+	{
+		Batch batch;
+		batch.added = relativePaths(fileBeingWatched, pathsAdded);
+		batch.modified = relativePaths(fileBeingWatched, pathsModified);
+		batch.removed = relativePaths(fileBeingWatched, pathsRemoved);
+
+		{
+			std::lock_guard<std::mutex> lock(batchesMutex);
+			batches.push_back(batch);
+		}
+		dispatch_semaphore_signal(received);
+	}
+
+	/**
+	 * Waits for the next notification. Returns false if none arrives within `seconds`.
+	 */
+	bool waitForBatch(Batch &batch, double seconds = 5)
+	{
+		if (dispatch_semaphore_wait(received, dispatch_time(DISPATCH_TIME_NOW, seconds * NSEC_PER_SEC)))
+			return false;
+
+		std::lock_guard<std::mutex> lock(batchesMutex);
+		batch = batches.front();
+		batches.pop_front();
+		return true;
+	}
+
+private:
+	/**
+	 * Returns `paths` relative to `fileBeingWatched`, sorted.
+	 */
+	static QStringList relativePaths(const string &fileBeingWatched, const set<string> &paths)
+	{
+		QStringList relative;
+		for (const string &path : paths)
+			relative.append(path == fileBeingWatched ? "." : QString::fromStdString(path.substr(fileBeingWatched.length() + 1)));
+		relative.sort();
+		return relative;
+	}
+
+	dispatch_semaphore_t received;  ///< Signaled for each notification.
+	std::mutex batchesMutex;  ///< Synchronizes access to @ref batches.
+	std::list<Batch> batches;  ///< Notifications not yet returned by @ref waitForBatch.
+};
+
+/**
+ * Tests for the VuoFileWatcher class.
+ */
+class TestVuoFileWatcher : public QObject
+{
+	Q_OBJECT
+
+	string folder;  ///< A temporary folder, created for each test.
+
+	/**
+	 * Writes `contents` to the file `name` in @ref folder, replacing the file's contents if it exists.
+	 */
+	void writeFile(const string &name, const string &contents)
+	{
+		VuoFileUtilities::writeStringToFile(contents, folder + "/" + name);
+	}
+
+	/**
+	 * Deletes the file `name` in @ref folder.
+	 */
+	void deleteFile(const string &name)
+	{
+		VuoFileUtilities::deleteFile(folder + "/" + name);
+	}
+
+private slots:
+
+	void init()
+	{
+		folder = VuoFileUtilities::makeTmpDir("TestVuoFileWatcher");
+	}
+
+	void cleanup()
+	{
+		VuoFileUtilities::deleteDir(folder);
+	}
+
+	void testAddModifyRemove()
+	{
+		writeFile("edited.txt", "1");
+		writeFile("deleted.txt", "1");
+
+		// Let FSEvents finish with the files created above, so their creation isn't combined with later events.
+		sleep(1);
+
+		TestVuoFileWatcherDelegate delegate;
+		VuoFileWatcher watcher(&delegate, folder, true, coalescingWindowSeconds);
+
+		writeFile("added.txt", "1");
+		usleep(stepMicroseconds);
+		writeFile("edited.txt", "2");
+		usleep(stepMicroseconds);
+		deleteFile("deleted.txt");
+
+		TestVuoFileWatcherDelegate::Batch batch;
+		QVERIFY(delegate.waitForBatch(batch));
+		QCOMPARE(batch.added, QStringList() << "added.txt");
+		QCOMPARE(batch.modified, QStringList() << "edited.txt");
+		QCOMPARE(batch.removed, QStringList() << "deleted.txt");
+
+		// Each change restarts the wait, so all of them should have been in one notification.
+		QVERIFY(! delegate.waitForBatch(batch, coalescingWindowSeconds * 2));
+	}
+
+	void testAddedThenRemoved()
+	{
+		TestVuoFileWatcherDelegate delegate;
+		VuoFileWatcher watcher(&delegate, folder, true, coalescingWindowSeconds);
+
+		writeFile("transient.txt", "1");
+		usleep(stepMicroseconds);
+		deleteFile("transient.txt");
+		usleep(stepMicroseconds);
+		writeFile("added.txt", "1");
+
+		// A file that's added then removed within the window isn't reported at all.
+		TestVuoFileWatcherDelegate::Batch batch;
+		QVERIFY(delegate.waitForBatch(batch));
+		QCOMPARE(batch.added, QStringList() << "added.txt");
+		QCOMPARE(batch.modified, QStringList());
+		QCOMPARE(batch.removed, QStringList());
+	}
+
+	void testReplaced()
+	{
+		writeFile("replaced.txt", "1");
+		sleep(1);
+
+		TestVuoFileWatcherDelegate delegate;
+		VuoFileWatcher watcher(&delegate, folder, true, coalescingWindowSeconds);
+
+		deleteFile("replaced.txt");
+		usleep(stepMicroseconds);
+		writeFile("replaced.txt", "2");
+		usleep(stepMicroseconds);
+		writeFile("replaced.txt", "3");
+
+		// A file that's removed, added, then modified within the window is reported as modified.
+		TestVuoFileWatcherDelegate::Batch batch;
+		QVERIFY(delegate.waitForBatch(batch));
+		QCOMPARE(batch.added, QStringList());
+		QCOMPARE(batch.modified, QStringList() << "replaced.txt");
+		QCOMPARE(batch.removed, QStringList());
+	}
+
+	void testDroppedEvents()
+	{
+		TestVuoFileWatcherDelegate delegate;
+		VuoFileWatcher watcher(&delegate, folder, true, coalescingWindowSeconds);
+
+		writeFile("added.txt", "1");
+		usleep(stepMicroseconds);
+		watcher.simulateDroppedEvents();
+
+		// If FSEvents dropped events, the folder itself is reported as modified, meaning anything in it may have changed,
+		// along with the changes that were reported individually.
+		TestVuoFileWatcherDelegate::Batch batch;
+		QVERIFY(delegate.waitForBatch(batch));
+		QCOMPARE(batch.added, QStringList() << "added.txt");
+		QCOMPARE(batch.modified, QStringList() << ".");
+		QCOMPARE(batch.removed, QStringList());
+	}
+};
+
+QTEST_APPLESS_MAIN(TestVuoFileWatcher)
+#include "TestVuoFileWatcher.moc"
@@ -0,0 +1,140 @@
+/**
+ * @file
+ * TestVuoKeyedPool interface and implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+#include <Vuo/Vuo.h>
+
+#include "VuoPool.hh"
+
+/**
+ * An object shared through the pool.
+ */
+struct TestVuoKeyedPoolInstance
+{
+	int key;					///< The key it was allocated for.
+	std::atomic<bool> isAlive;	///< Set to false when its last reference is released.
+};
+
+static std::atomic<int> allocatedCount;		///< The number of instances allocated.
+static std::atomic<int> deallocatedCount;	///< The number of instances whose last reference was released.
+
+/**
+ * Marks the instance as no longer alive. Doesn't free it, so the test can detect later uses.
+ */
+static void TestVuoKeyedPoolInstance_free(void *instance)
+{
+	static_cast<TestVuoKeyedPoolInstance *>(instance)->isAlive = false;
+	++deallocatedCount;
+}
+
+/**
+ * Allocates an instance for the pool.
+ */
+static TestVuoKeyedPoolInstance * TestVuoKeyedPoolInstance_make(int key)
+{
+	TestVuoKeyedPoolInstance *instance = new TestVuoKeyedPoolInstance;
+	instance->key = key;
+	instance->isAlive = true;
+	VuoRegister(instance, TestVuoKeyedPoolInstance_free);
+	++allocatedCount;
+	return instance;
+}
+
+/**
+ * Tests for the VuoKeyedPool class.
+ */
+class TestVuoKeyedPool : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void testUseAndDisuse()
+	{
+		VuoKeyedPool<int, TestVuoKeyedPoolInstance *> pool("TestVuoKeyedPoolInstance", TestVuoKeyedPoolInstance_make);
+		allocatedCount = 0;
+		deallocatedCount = 0;
+
+		TestVuoKeyedPoolInstance *a1 = pool.useSharedInstance(1);
+		TestVuoKeyedPoolInstance *a2 = pool.useSharedInstance(1);
+		TestVuoKeyedPoolInstance *b = pool.useSharedInstance(2);
+		QCOMPARE(a1, a2);
+		QVERIFY(a1 != b);
+		QCOMPARE(a1->key, 1);
+		QCOMPARE(b->key, 2);
+		QCOMPARE(pool.size(), 2U);
+		QCOMPARE(allocatedCount.load(), 2);
+
+		pool.disuseSharedInstance(a1);
+		QCOMPARE(pool.size(), 2U);
+		QVERIFY(a2->isAlive);
+
+		pool.disuseSharedInstance(a2);
+		pool.disuseSharedInstance(b);
+		QCOMPARE(pool.size(), 0U);
+		QCOMPARE(deallocatedCount.load(), 2);
+
+		// Once removed, the key gets a new instance.
+		TestVuoKeyedPoolInstance *a3 = pool.useSharedInstance(1);
+		QVERIFY(a3->isAlive);
+		QCOMPARE(allocatedCount.load(), 3);
+		pool.disuseSharedInstance(a3);
+		QCOMPARE(deallocatedCount.load(), 3);
+	}
+
+	/**
+	 * Several threads repeatedly use and disuse a few keys, so that lookups race with the last user disusing
+	 * an instance (and with its entry being removed or revived on the pool's queue).
+	 * No caller should ever get an instance that has been (or is about to be) deallocated.
+	 */
+	void testUseWhileRemoving()
+	{
+		VuoKeyedPool<int, TestVuoKeyedPoolInstance *> *pool = new VuoKeyedPool<int, TestVuoKeyedPoolInstance *>("TestVuoKeyedPoolInstance", TestVuoKeyedPoolInstance_make);
+		allocatedCount = 0;
+		deallocatedCount = 0;
+
+		static std::atomic<int> deadUseCount;
+		static std::atomic<int> wrongKeyCount;
+		deadUseCount = 0;
+		wrongKeyCount = 0;
+
+		const int keyCount = 3;
+		dispatch_apply(8, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t thread){
+			for (int i = 0; i < 20000; ++i)
+			{
+				int key = (thread + i) % keyCount;
+				TestVuoKeyedPoolInstance *instance = pool->useSharedInstance(key);
+
+				if (! instance->isAlive)
+					++deadUseCount;
+				if (instance->key != key)
+					++wrongKeyCount;
+
+				// Let other threads see this instance in use before disusing it.
+				if (i % 7 == 0)
+					sched_yield();
+
+				if (! instance->isAlive)
+					++deadUseCount;
+
+				pool->disuseSharedInstance(instance);
+			}
+		});
+
+		QCOMPARE(deadUseCount.load(), 0);
+		QCOMPARE(wrongKeyCount.load(), 0);
+		QCOMPARE(pool->size(), 0U);
+		QVERIFY(allocatedCount > 0);
+		QCOMPARE(deallocatedCount.load(), allocatedCount.load());
+
+		delete pool;
+	}
+};
+
+QTEST_APPLESS_MAIN(TestVuoKeyedPool)
+#include "TestVuoKeyedPool.moc"
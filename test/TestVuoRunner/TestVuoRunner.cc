@@ -496,6 +496,138 @@ private slots:
 
 		delete runner;
 	}
+
+	/**
+	 * Returns a composition that passes a published input event through a chain of `nodeCount` nodes to a published output.
+	 */
+	static string makeEventChainComposition(int nodeCount)
+	{
+		ostringstream composition;
+		composition << "digraph G\n{\n";
+		for (int i = 0; i < nodeCount; ++i)
+			composition << "Subtract" << i << " [type=\"vuo.math.subtract.VuoInteger\" version=\"1.2.0\" label=\"Subtract|<refresh>refresh\\l|<a>a\\l|<b>b\\l|<difference>difference\\r\" pos=\"" << 100 * i << ",0\" _b=\"1\"];\n";
+		composition << "PublishedInputs [type=\"vuo.in\" label=\"PublishedInputs|<Value>Value\\r\" _Value_type=\"VuoInteger\" _Value=\"0\"];\n";
+		composition << "PublishedOutputs [type=\"vuo.out\" label=\"PublishedOutputs|<Result>Result\\l\" _Result_type=\"VuoInteger\"];\n";
+
+		composition << "PublishedInputs:Value -> Subtract0:a;\n";
+		for (int i = 1; i < nodeCount; ++i)
+			composition << "Subtract" << i - 1 << ":difference -> Subtract" << i << ":a;\n";
+		composition << "Subtract" << nodeCount - 1 << ":difference -> PublishedOutputs:Result;\n";
+		composition << "}\n";
+		return composition.str();
+	}
+
+	void testEventChainPerformance_data(void)
+	{
+		QTest::addColumn<int>("nodeCount");
+
+		QTest::newRow("1 node") << 1;
+		QTest::newRow("10 nodes") << 10;
+		QTest::newRow("100 nodes") << 100;
+		QTest::newRow("500 nodes") << 500;
+	}
+	void testEventChainPerformance(void)
+	{
+		QFETCH(int, nodeCount);
+
+		VuoCompilerIssues issues;
+		VuoRunner *runner = VuoCompiler::newCurrentProcessRunnerFromCompositionString(makeEventChainComposition(nodeCount), ".", &issues);
+		QVERIFY(runner);
+
+		runner->start();
+
+		VuoRunner::Port *inputPort = runner->getPublishedInputPortWithName("Value");
+		QVERIFY(inputPort);
+		VuoRunner::Port *outputPort = runner->getPublishedOutputPortWithName("Result");
+		QVERIFY(outputPort);
+
+		// Each iteration fires one event through the whole chain, so the result is the per-event cost;
+		// dividing by `nodeCount` gives the per-node overhead (locking, node-context lookup, transmission).
+		QBENCHMARK
+		{
+			runner->firePublishedInputPortEvent(inputPort);
+			runner->waitForFiredPublishedInputPortEvent();
+		}
+
+		json_object *outputValue = runner->getPublishedOutputPortValue(outputPort);
+		QCOMPARE(VuoInteger_makeFromJson(outputValue), (VuoInteger)-nodeCount);
+		json_object_put(outputValue);
+
+		runner->stop();
+
+		delete runner;
+	}
+
+	/**
+	 * Returns a composition in which the published input fans out to @a branchCount independent chains of nodes,
+	 * one of which leads to the published output. Each event thus schedules @a branchCount chain workers.
+	 */
+	static string makeEventFanOutComposition(int branchCount, int nodesPerBranch)
+	{
+		ostringstream composition;
+		composition << "digraph G\n{\n";
+		for (int b = 0; b < branchCount; ++b)
+			for (int i = 0; i < nodesPerBranch; ++i)
+				composition << "Subtract" << b << "_" << i << " [type=\"vuo.math.subtract.VuoInteger\" version=\"1.2.0\" label=\"Subtract|<refresh>refresh\\l|<a>a\\l|<b>b\\l|<difference>difference\\r\" pos=\"" << 100 * i << "," << 100 * b << "\" _b=\"1\"];\n";
+		composition << "PublishedInputs [type=\"vuo.in\" label=\"PublishedInputs|<Value>Value\\r\" _Value_type=\"VuoInteger\" _Value=\"0\"];\n";
+		composition << "PublishedOutputs [type=\"vuo.out\" label=\"PublishedOutputs|<Result>Result\\l\" _Result_type=\"VuoInteger\"];\n";
+
+		for (int b = 0; b < branchCount; ++b)
+		{
+			composition << "PublishedInputs:Value -> Subtract" << b << "_0:a;\n";
+			for (int i = 1; i < nodesPerBranch; ++i)
+				composition << "Subtract" << b << "_" << i - 1 << ":difference -> Subtract" << b << "_" << i << ":a;\n";
+		}
+		composition << "Subtract0_" << nodesPerBranch - 1 << ":difference -> PublishedOutputs:Result;\n";
+		composition << "}\n";
+		return composition.str();
+	}
+
+	void testSchedulerScalingPerformance_data(void)
+	{
+		QTest::addColumn<int>("branchCount");
+		QTest::addColumn<bool>("workStealing");
+
+		for (int branchCount : {1, 8, 32, 128})
+		{
+			QTest::newRow(QString("%1 branches, dispatcher").arg(branchCount).toUtf8().constData()) << branchCount << false;
+			QTest::newRow(QString("%1 branches, work-stealing").arg(branchCount).toUtf8().constData()) << branchCount << true;
+		}
+	}
+	void testSchedulerScalingPerformance(void)
+	{
+		QFETCH(int, branchCount);
+		QFETCH(bool, workStealing);
+
+		const int nodesPerBranch = 4;
+
+		VuoCompilerIssues issues;
+		VuoRunner *runner = VuoCompiler::newCurrentProcessRunnerFromCompositionString(makeEventFanOutComposition(branchCount, nodesPerBranch), ".", &issues);
+		QVERIFY(runner);
+
+		runner->setWorkStealingScheduler(workStealing);
+		runner->start();
+
+		VuoRunner::Port *inputPort = runner->getPublishedInputPortWithName("Value");
+		QVERIFY(inputPort);
+		VuoRunner::Port *outputPort = runner->getPublishedOutputPortWithName("Result");
+		QVERIFY(outputPort);
+
+		// Each iteration fires one event, which the thread manager must hand out to all of the branches.
+		QBENCHMARK
+		{
+			runner->firePublishedInputPortEvent(inputPort);
+			runner->waitForFiredPublishedInputPortEvent();
+		}
+
+		json_object *outputValue = runner->getPublishedOutputPortValue(outputPort);
+		QCOMPARE(VuoInteger_makeFromJson(outputValue), (VuoInteger)-nodesPerBranch);
+		json_object_put(outputValue);
+
+		runner->stop();
+
+		delete runner;
+	}
 };
 
 QTEST_APPLESS_MAIN(TestVuoRunner)
@@ -0,0 +1,104 @@
+/**
+ * @file
+ * TestVuoThreadManager interface and implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+#include <Vuo/Vuo.h>
+
+#include "VuoThreadManager.hh"
+
+Q_DECLARE_METATYPE(VuoThreadManager::Scheduler);
+
+/**
+ * The state shared between a test and the trigger workers it schedules.
+ */
+struct TestVuoThreadManagerWorker
+{
+	VuoThreadManager *threadManager;  ///< The thread manager that scheduled the worker.
+	unsigned long eventId;  ///< The event that the worker's trigger fired.
+	dispatch_semaphore_t mayFinish;  ///< If non-null, the worker waits for this before returning its threads.
+	dispatch_semaphore_t finished;  ///< Signaled when the worker has returned its threads.
+};
+
+/**
+ * A trigger worker function, which returns its threads to the thread manager once it's allowed to.
+ */
+static void TestVuoThreadManager_triggerWorker(void *context)
+{
+	TestVuoThreadManagerWorker *w = static_cast<TestVuoThreadManagerWorker *>(context);
+
+	if (w->mayFinish)
+		dispatch_semaphore_wait(w->mayFinish, DISPATCH_TIME_FOREVER);
+
+	w->threadManager->returnThreadsForTriggerWorker(w->eventId);
+	dispatch_semaphore_signal(w->finished);
+}
+
+/**
+ * Tests for the VuoThreadManager class.
+ */
+class TestVuoThreadManager : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void testSchedulingAfterDisabling_data()
+	{
+		QTest::addColumn<VuoThreadManager::Scheduler>("scheduler");
+
+		QTest::newRow("dispatcher") << VuoThreadManager::Scheduler_Dispatcher;
+		QTest::newRow("work-stealing") << VuoThreadManager::Scheduler_WorkStealing;
+	}
+	void testSchedulingAfterDisabling()
+	{
+		QFETCH(VuoThreadManager::Scheduler, scheduler);
+
+		VuoThreadManager *threadManager = new VuoThreadManager;
+		threadManager->setScheduler(scheduler);
+		threadManager->enableSchedulingWorkers();
+
+		dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+		// The first worker claims all of the threads, so the second has to wait for the first to return them.
+		TestVuoThreadManagerWorker first{threadManager, 1, dispatch_semaphore_create(0), dispatch_semaphore_create(0)};
+		TestVuoThreadManagerWorker second{threadManager, 2, nullptr, dispatch_semaphore_create(0)};
+		threadManager->scheduleTriggerWorker(queue, &first, TestVuoThreadManager_triggerWorker, INT_MAX, INT_MAX, first.eventId, "", 0);
+		threadManager->scheduleTriggerWorker(queue, &second, TestVuoThreadManager_triggerWorker, 1, 1, second.eventId, "", 0);
+
+		dispatch_semaphore_t disabled = dispatch_semaphore_create(0);
+		dispatch_async(queue, ^{
+			threadManager->disableSchedulingWorkers();
+			dispatch_semaphore_signal(disabled);
+		});
+
+		// Disabling waits for the workers that were already scheduled.
+		QVERIFY(dispatch_semaphore_wait(disabled, dispatch_time(DISPATCH_TIME_NOW, 0.1 * NSEC_PER_SEC)) != 0);
+
+		dispatch_semaphore_signal(first.mayFinish);
+		QVERIFY(dispatch_semaphore_wait(disabled, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)) == 0);
+		QVERIFY(dispatch_semaphore_wait(first.finished, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)) == 0);
+		QVERIFY(dispatch_semaphore_wait(second.finished, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)) == 0);
+
+		// Workers scheduled after disabling never run, even though threads are available.
+		TestVuoThreadManagerWorker third{threadManager, 3, nullptr, dispatch_semaphore_create(0)};
+		threadManager->scheduleTriggerWorker(queue, &third, TestVuoThreadManager_triggerWorker, 1, 1, third.eventId, "", 0);
+		QVERIFY(dispatch_semaphore_wait(third.finished, dispatch_time(DISPATCH_TIME_NOW, 0.5 * NSEC_PER_SEC)) != 0);
+
+		dispatch_release(disabled);
+		for (TestVuoThreadManagerWorker *w : {&first, &second, &third})
+		{
+			if (w->mayFinish)
+				dispatch_release(w->mayFinish);
+			dispatch_release(w->finished);
+		}
+		delete threadManager;
+	}
+};
+
+QTEST_APPLESS_MAIN(TestVuoThreadManager)
+#include "TestVuoThreadManager.moc"
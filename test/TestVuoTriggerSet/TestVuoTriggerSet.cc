@@ -0,0 +1,158 @@
+/**
+ * @file
+ * TestVuoTriggerSet interface and implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+#include <Vuo/Vuo.h>
+
+#include "VuoTriggerSet.hh"
+
+/// The number of triggers that @ref TestVuoTriggerSet::testRemoveWhileFiring adds and removes in each round.
+static const int removableTriggerCount = 6;
+
+static std::atomic<bool> isRemoved[removableTriggerCount];	///< Set once `removeTrigger()` has returned for each removable trigger.
+static std::atomic<int> callsAfterRemoval;	///< The number of times a trigger was called after `removeTrigger()` returned for it.
+static std::atomic<int> callCount;			///< The number of times any trigger was called.
+static std::atomic<bool> isFiring;			///< While true, the firing threads keep firing.
+
+/**
+ * A trigger that checks whether it has been removed.
+ */
+template<int index>
+static void removableTrigger(int)
+{
+	++callCount;
+	if (isRemoved[index])
+		++callsAfterRemoval;
+}
+
+/**
+ * A trigger that's repeatedly added and removed, so that other threads publish snapshots in between others' fires.
+ */
+static void churningTrigger(int)
+{
+	++callCount;
+}
+
+/// The removable triggers, indexed like @ref isRemoved.
+static void (*removableTriggers[removableTriggerCount])(int) = {
+	removableTrigger<0>,
+	removableTrigger<1>,
+	removableTrigger<2>,
+	removableTrigger<3>,
+	removableTrigger<4>,
+	removableTrigger<5>,
+};
+
+/**
+ * Tests for the VuoTriggerSet class.
+ */
+class TestVuoTriggerSet : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void testAddAndRemove()
+	{
+		VuoTriggerSet<int> triggers;
+		QCOMPARE(triggers.size(), 0U);
+
+		callCount = 0;
+		triggers.addTrigger(churningTrigger);
+		triggers.addTrigger(churningTrigger);
+		QCOMPARE(triggers.size(), 1U);
+
+		triggers.fire(0);
+		QCOMPARE(callCount.load(), 1);
+
+		triggers.addTrigger(removableTriggers[0], (void *)1);
+		QCOMPARE(triggers.size(), 2U);
+
+		__block int contextCallCount = 0;
+		triggers.fire(^(void (*trigger)(int), void *context){
+			QVERIFY(trigger == removableTriggers[0]);
+			QVERIFY(context == (void *)1);
+			++contextCallCount;
+		});
+		QCOMPARE(contextCallCount, 1);
+
+		triggers.removeTrigger(removableTriggers[0]);
+		triggers.removeTrigger(churningTrigger);
+		triggers.removeTrigger(churningTrigger);
+		QCOMPARE(triggers.size(), 0U);
+
+		triggers.fire(0);
+		QCOMPARE(callCount.load(), 1);
+	}
+
+	void testRemoveWhileFiring()
+	{
+		VuoTriggerSet<int> *triggers = new VuoTriggerSet<int>;
+		callsAfterRemoval = 0;
+		callCount = 0;
+		isFiring = true;
+
+		dispatch_queue_t global = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+		dispatch_group_t group = dispatch_group_create();
+
+		for (int i = 0; i < 4; ++i)
+			dispatch_group_async(group, global, ^{
+				while (isFiring)
+					triggers->fire(0);
+			});
+
+		// Publish snapshots that don't involve the removable triggers, so a fire can still be running on
+		// an older snapshot than the one removeTrigger() replaces.
+		dispatch_group_async(group, global, ^{
+			while (isFiring)
+			{
+				triggers->addTrigger(churningTrigger);
+				triggers->removeTrigger(churningTrigger);
+			}
+		});
+
+		for (int round = 0; round < 2000; ++round)
+		{
+			for (int i = 0; i < removableTriggerCount; ++i)
+			{
+				isRemoved[i] = false;
+				triggers->addTrigger(removableTriggers[i]);
+			}
+
+			for (int i = 0; i < removableTriggerCount; ++i)
+			{
+				triggers->removeTrigger(removableTriggers[i]);
+				isRemoved[i] = true;
+			}
+		}
+
+		isFiring = false;
+		dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+		dispatch_release(group);
+		delete triggers;
+
+		QVERIFY(callCount > 0);
+		QCOMPARE(callsAfterRemoval.load(), 0);
+	}
+
+	void testFirePerformance()
+	{
+		VuoTriggerSet<int> triggers;
+		for (int i = 0; i < removableTriggerCount; ++i)
+			triggers.addTrigger(removableTriggers[i]);
+		for (int i = 0; i < removableTriggerCount; ++i)
+			isRemoved[i] = false;
+
+		QBENCHMARK {
+			triggers.fire(0);
+		}
+	}
+};
+
+QTEST_APPLESS_MAIN(TestVuoTriggerSet)
+#include "TestVuoTriggerSet.moc"
@@ -0,0 +1,217 @@
+/**
+ * @file
+ * TestVuoDictionary implementation.
+ *
+ * @copyright Copyright © 2012–2023 Kosada Incorporated.
+ * This code may be modified and distributed under the terms of the GNU Lesser General Public License (LGPL) version 2 or later.
+ * For more information, see https://vuo.org/license.
+ */
+
+extern "C" {
+#include "TestVuoTypes.h"
+#include "VuoDictionary_VuoText_VuoReal.h"
+#include "VuoDictionary_VuoText_VuoText.h"
+}
+
+/**
+ * Tests the VuoDictionary types.
+ */
+class TestVuoDictionary : public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void testKeyLookup_data()
+	{
+		QTest::addColumn<int>("keyCount");
+
+		// Below and above the size at which lookups switch from scanning to the hash index.
+		QTest::newRow("empty") << 0;
+		QTest::newRow("small") << 5;
+		QTest::newRow("large") << 1000;
+	}
+	void testKeyLookup()
+	{
+		QFETCH(int, keyCount);
+
+		VuoDictionary_VuoText_VuoReal d = VuoDictionaryCreate_VuoText_VuoReal();
+		VuoDictionary_VuoText_VuoReal_retain(d);
+		for (int i = 0; i < keyCount; ++i)
+			VuoDictionarySetKeyValue_VuoText_VuoReal(d, VuoText_make(QString("key%1").arg(i).toUtf8().constData()), i);
+
+		QCOMPARE(VuoListGetCount_VuoText(d.keys), (unsigned long)keyCount);
+		for (int i = 0; i < keyCount; ++i)
+		{
+			QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, QString("key%1").arg(i).toUtf8().constData()), (VuoReal)i);
+			QCOMPARE(QString::fromUtf8(VuoListGetValue_VuoText(d.keys, i + 1)), QString("key%1").arg(i));
+		}
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "missing"), 0.);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, NULL), 0.);
+
+		// Adding keys after the index has been built should make them findable.
+		VuoDictionarySetKeyValue_VuoText_VuoReal(d, VuoText_make("added"), 42);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "added"), 42.);
+
+		VuoDictionary_VuoText_VuoReal_release(d);
+	}
+
+	void testSetExistingKey_data()
+	{
+		QTest::addColumn<int>("keyCount");
+
+		QTest::newRow("small") << 3;
+		QTest::newRow("large") << 100;
+	}
+	void testSetExistingKey()
+	{
+		QFETCH(int, keyCount);
+
+		VuoDictionary_VuoText_VuoText d = VuoDictionaryCreate_VuoText_VuoText();
+		VuoDictionary_VuoText_VuoText_retain(d);
+		for (int i = 0; i < keyCount; ++i)
+			VuoDictionarySetKeyValue_VuoText_VuoText(d, VuoText_make(QString("key%1").arg(i).toUtf8().constData()), VuoText_make("old"));
+
+		VuoDictionarySetKeyValue_VuoText_VuoText(d, VuoText_make("key1"), VuoText_make("new"));
+
+		// The value should be replaced in place, rather than a duplicate key being appended.
+		QCOMPARE(VuoListGetCount_VuoText(d.keys), (unsigned long)keyCount);
+		QCOMPARE(VuoListGetCount_VuoText(d.values), (unsigned long)keyCount);
+		QCOMPARE(QString::fromUtf8(VuoListGetValue_VuoText(d.keys, 2)), QString("key1"));
+		QCOMPARE(QString::fromUtf8(VuoDictionaryGetValueForKey_VuoText_VuoText(d, "key1")), QString("new"));
+		QCOMPARE(QString::fromUtf8(VuoDictionaryGetValueForKey_VuoText_VuoText(d, "key0")), QString("old"));
+		QCOMPARE(QString::fromUtf8(VuoDictionaryGetValueForKey_VuoText_VuoText(d, "missing")), QString(""));
+
+		VuoDictionary_VuoText_VuoText_release(d);
+	}
+
+	void testWithoutIndex()
+	{
+		// Dictionaries initialized directly from lists (without a hash index) should still be searchable.
+		VuoList_VuoText keys = VuoListCreate_VuoText();
+		VuoList_VuoReal values = VuoListCreate_VuoReal();
+		for (int i = 0; i < 20; ++i)
+		{
+			VuoListAppendValue_VuoText(keys, VuoText_make(QString("key%1").arg(i).toUtf8().constData()));
+			VuoListAppendValue_VuoReal(values, i);
+		}
+		VuoDictionary_VuoText_VuoReal d = {keys, values};
+		VuoDictionary_VuoText_VuoReal_retain(d);
+
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "key19"), 19.);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "missing"), 0.);
+
+		VuoDictionary_VuoText_VuoReal_release(d);
+	}
+
+	void testCreateWithLists()
+	{
+		const int keyCount = 20;
+		VuoList_VuoText keys = VuoListCreate_VuoText();
+		VuoList_VuoReal values = VuoListCreate_VuoReal();
+		VuoRetain(keys);
+		VuoRetain(values);
+		for (int i = 0; i < keyCount; ++i)
+		{
+			VuoListAppendValue_VuoText(keys, VuoText_make(QString("key%1").arg(i).toUtf8().constData()));
+			VuoListAppendValue_VuoReal(values, i);
+		}
+
+		VuoDictionary_VuoText_VuoReal d = VuoDictionaryCreateWithLists_VuoText_VuoReal(keys, values);
+		VuoDictionary_VuoText_VuoReal_retain(d);
+
+		// Build the index.
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "key5"), 5.);
+
+		// The dictionary has its own copies of the lists, so changing the lists it was created from shouldn't affect it.
+		VuoListSetValue_VuoText(keys, VuoText_make("changed"), 6, false);
+		VuoListRemoveValue_VuoText(keys, 7);
+		VuoListAppendValue_VuoText(keys, VuoText_make("appended"));
+		VuoListAppendValue_VuoReal(values, 99);
+		QCOMPARE(VuoListGetCount_VuoText(d.keys), (unsigned long)keyCount);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "key5"), 5.);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "key6"), 6.);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "changed"), 0.);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "appended"), 0.);
+
+		VuoDictionary_VuoText_VuoReal_release(d);
+		VuoRelease(keys);
+		VuoRelease(values);
+	}
+
+	void testReplaceKeys()
+	{
+		const int keyCount = 20;
+		VuoDictionary_VuoText_VuoReal d = VuoDictionaryCreate_VuoText_VuoReal();
+		VuoDictionary_VuoText_VuoReal_retain(d);
+		for (int i = 0; i < keyCount; ++i)
+			VuoDictionarySetKeyValue_VuoText_VuoReal(d, VuoText_make(QString("key%1").arg(i).toUtf8().constData()), i);
+
+		// Build the index.
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "key5"), 5.);
+
+		// Replacing the keys list (rather than changing the list in place) should make the index start over.
+		VuoList_VuoText keys = VuoListCreate_VuoText();
+		for (int i = 0; i < keyCount; ++i)
+			VuoListAppendValue_VuoText(keys, VuoText_make(i == 5 ? "changed" : QString("other%1").arg(i).toUtf8().constData()));
+		VuoRetain(keys);
+		VuoRelease(d.keys);
+		d.keys = keys;
+
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "key5"), 0.);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "key19"), 0.);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "changed"), 5.);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "other19"), 19.);
+
+		VuoDictionary_VuoText_VuoReal_release(d);
+	}
+
+	void testSerialization()
+	{
+		const char *json = QUOTE({"keys":["b","a","c"],"values":[2,1,3]});
+
+		VuoDictionary_VuoText_VuoReal d = VuoMakeRetainedFromString(json, VuoDictionary_VuoText_VuoReal);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "a"), 1.);
+		QCOMPARE(VuoDictionaryGetValueForKey_VuoText_VuoReal(d, "c"), 3.);
+
+		// Insertion order should be preserved.
+		QCOMPARE(QString::fromUtf8(VuoListGetValue_VuoText(d.keys, 1)), QString("b"));
+		QCOMPARE(QString::fromUtf8(VuoListGetValue_VuoText(d.keys, 2)), QString("a"));
+		QCOMPARE(QString::fromUtf8(VuoListGetValue_VuoText(d.keys, 3)), QString("c"));
+
+		VuoDictionary_VuoText_VuoReal_release(d);
+	}
+
+	void testLookupPerformance_data()
+	{
+		QTest::addColumn<int>("keyCount");
+
+		QTest::newRow("8 keys") << 8;
+		QTest::newRow("100 keys") << 100;
+		QTest::newRow("10000 keys") << 10000;
+	}
+	void testLookupPerformance()
+	{
+		QFETCH(int, keyCount);
+
+		VuoDictionary_VuoText_VuoReal d = VuoDictionaryCreate_VuoText_VuoReal();
+		VuoDictionary_VuoText_VuoReal_retain(d);
+		std::vector<std::string> keys;
+		for (int i = 0; i < keyCount; ++i)
+		{
+			keys.push_back(QString("key%1").arg(i).toStdString());
+			VuoDictionarySetKeyValue_VuoText_VuoReal(d, VuoText_make(keys.back().c_str()), i);
+		}
+
+		QBENCHMARK {
+			for (int i = 0; i < keyCount; ++i)
+				VuoDictionaryGetValueForKey_VuoText_VuoReal(d, keys[i].c_str());
+		}
+
+		VuoDictionary_VuoText_VuoReal_release(d);
+	}
+};
+
+QTEST_APPLESS_MAIN(TestVuoDictionary)
+
+#include "TestVuoDictionary.moc"
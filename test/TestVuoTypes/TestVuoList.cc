@@ -419,6 +419,83 @@ private slots:
 		});
 		QCOMPARE(total, 4321);
 	}
+
+	/**
+	 * Verifies that texts that are equal but differently encoded are treated as duplicates.
+	 */
+	void testRemoveDuplicates()
+	{
+		VuoList_VuoText l = VuoListCreate_VuoText();
+		VuoLocal(l);
+		VuoListAppendValue_VuoText(l, VuoText_make("caf\xc3\xa9"));        // precomposed é
+		VuoListAppendValue_VuoText(l, VuoText_make("A"));
+		VuoListAppendValue_VuoText(l, VuoText_make("cafe\xcc\x81"));       // e + combining acute accent
+		VuoListAppendValue_VuoText(l, VuoText_make("\xef\xbc\xa1"));       // fullwidth A
+		VuoListAppendValue_VuoText(l, VuoText_make("a"));
+
+		VuoList_VuoText unique = VuoListRemoveDuplicates_VuoText(l);
+		VuoLocal(unique);
+		QCOMPARE(VuoListGetCount_VuoText(unique), 3UL);
+		QCOMPARE(QString::fromUtf8(VuoListGetValue_VuoText(unique, 1)), QString::fromUtf8("caf\xc3\xa9"));
+		QCOMPARE(QString::fromUtf8(VuoListGetValue_VuoText(unique, 2)), QString("A"));
+		QCOMPARE(QString::fromUtf8(VuoListGetValue_VuoText(unique, 3)), QString("a"));
+	}
+
+	void testRemoveDuplicatesPerformance_data()
+	{
+		QTest::addColumn<QString>("type");
+		QTest::addColumn<int>("count");
+
+		// VuoInteger and VuoText are hashed; VuoReal falls back to comparing every pair.
+		QTest::newRow("VuoInteger, 100k items") << "VuoInteger" << 100000;
+		QTest::newRow("VuoText, 100k items")    << "VuoText"    << 100000;
+		QTest::newRow("VuoReal, 10k items")     << "VuoReal"    << 10000;
+	}
+	void testRemoveDuplicatesPerformance()
+	{
+		QFETCH(QString, type);
+		QFETCH(int, count);
+
+		// Half the items are duplicates.
+		if (type == "VuoInteger")
+		{
+			VuoList_VuoInteger l = VuoListCreateWithCount_VuoInteger(count, 0);
+			VuoLocal(l);
+			VuoInteger *values = VuoListGetData_VuoInteger(l);
+			for (int i = 0; i < count; ++i)
+				values[i] = i / 2;
+
+			QBENCHMARK {
+				VuoList_VuoInteger unique = VuoListRemoveDuplicates_VuoInteger(l);
+				VuoLocal(unique);
+			}
+		}
+		else if (type == "VuoText")
+		{
+			VuoList_VuoText l = VuoListCreate_VuoText();
+			VuoLocal(l);
+			for (int i = 0; i < count; ++i)
+				VuoListAppendValue_VuoText(l, VuoText_make(QString::number(i / 2).toUtf8().constData()));
+
+			QBENCHMARK {
+				VuoList_VuoText unique = VuoListRemoveDuplicates_VuoText(l);
+				VuoLocal(unique);
+			}
+		}
+		else if (type == "VuoReal")
+		{
+			VuoList_VuoReal l = VuoListCreateWithCount_VuoReal(count, 0);
+			VuoLocal(l);
+			VuoReal *values = VuoListGetData_VuoReal(l);
+			for (int i = 0; i < count; ++i)
+				values[i] = i / 2;
+
+			QBENCHMARK {
+				VuoList_VuoReal unique = VuoListRemoveDuplicates_VuoReal(l);
+				VuoLocal(unique);
+			}
+		}
+	}
 };
 
 QTEST_APPLESS_MAIN(TestVuoList)
@@ -9,6 +9,8 @@
 
 extern "C" {
 #include "TestVuoTypes.h"
+#include "VuoMeshParametric.h"
+#include "VuoPointsParametric.h"
 }
 
 /**
@@ -195,6 +197,86 @@ private slots:
 		VuoRelease(outputVariables);
 		VuoRelease(outputValues);
 	}
+
+	void testParametricPoints_data()
+	{
+		QTest::addColumn<QString>("xExpression");
+		QTest::addColumn<QString>("yExpression");
+		QTest::addColumn<QString>("zExpression");
+		QTest::addColumn<double>("time");
+		QTest::addColumn<QString>("expectedPoints");
+
+		QTest::newRow("u and v") << "u" << "v" << "0" << 0.
+								 << QUOTE([{"x":0,"y":0,"z":0},{"x":1,"y":0,"z":0},{"x":0,"y":1,"z":0},{"x":1,"y":1,"z":0}]);
+		QTest::newRow("uppercase i and j, and time") << "I" << "J" << "time" << 5.
+								 << QUOTE([{"x":1,"y":1,"z":5},{"x":2,"y":1,"z":5},{"x":1,"y":2,"z":5},{"x":2,"y":2,"z":5}]);
+		QTest::newRow("same expressions, different time") << "I" << "J" << "time" << 7.
+								 << QUOTE([{"x":1,"y":1,"z":7},{"x":2,"y":1,"z":7},{"x":1,"y":2,"z":7},{"x":2,"y":2,"z":7}]);
+		QTest::newRow("standard library") << "round(pi)" << "max(u,v)" << "clamp(i,0,1.5)" << 0.
+								 << QUOTE([{"x":3,"y":0,"z":1},{"x":3,"y":1,"z":1.5},{"x":3,"y":1,"z":1},{"x":3,"y":1,"z":1.5}]);
+		QTest::newRow("undefined variable") << "w" << "0" << "0" << 0.
+								 << QUOTE([{"x":0,"y":0,"z":0},{"x":0,"y":0,"z":0},{"x":0,"y":0,"z":0},{"x":0,"y":0,"z":0}]);
+		QTest::newRow("multiple results in one expression") << "1,2" << "0" << "0" << 0.
+								 << QUOTE([{"x":2,"y":0,"z":0},{"x":2,"y":0,"z":0},{"x":2,"y":0,"z":0},{"x":2,"y":0,"z":0}]);
+	}
+	void testParametricPoints()
+	{
+		QFETCH(QString, xExpression);
+		QFETCH(QString, yExpression);
+		QFETCH(QString, zExpression);
+		QFETCH(double, time);
+		QFETCH(QString, expectedPoints);
+
+		VuoList_VuoPoint3d points = VuoPointsParametric2d_generate(time,
+			xExpression.toUtf8().constData(), yExpression.toUtf8().constData(), zExpression.toUtf8().constData(),
+			2, 2, 0, 1, 0, 1);
+		VuoLocal(points);
+		VuoList_VuoPoint3d expected = VuoMakeRetainedFromString(expectedPoints.toUtf8().constData(), VuoList_VuoPoint3d);
+		VuoDefer(^{ VuoRelease(expected); });
+
+		QCOMPARE(VuoListGetCount_VuoPoint3d(points), VuoListGetCount_VuoPoint3d(expected));
+		for (unsigned long i = 1; i <= VuoListGetCount_VuoPoint3d(points); ++i)
+			QVERIFY2(VuoPoint3d_areEqual(VuoListGetValue_VuoPoint3d(points, i), VuoListGetValue_VuoPoint3d(expected, i)),
+					 qPrintable(QString("point %1: %2").arg(i).arg(VuoPoint3d_getSummary(VuoListGetValue_VuoPoint3d(points, i)))));
+	}
+
+	void testParametricMeshConstants()
+	{
+		VuoList_VuoText keys = VuoListCreate_VuoText();
+		VuoListAppendValue_VuoText(keys, VuoText_make("a"));
+		VuoListAppendValue_VuoText(keys, VuoText_make("u"));
+		VuoList_VuoReal values = VuoListCreate_VuoReal();
+		VuoListAppendValue_VuoReal(values, 2);
+		VuoListAppendValue_VuoReal(values, 10);
+		VuoLocal(keys);
+		VuoLocal(values);
+		VuoDictionary_VuoText_VuoReal constants = VuoDictionaryCreateWithLists_VuoText_VuoReal(keys, values);
+		VuoDictionary_VuoText_VuoReal_retain(constants);
+
+		// Generate twice, so the second call reuses the parsed expressions with a new constant value.
+		for (int i = 0; i < 2; ++i)
+		{
+			VuoDictionarySetKeyValue_VuoText_VuoReal(constants, "a", 2 + i);
+
+			VuoMesh m = VuoMeshParametric_generate(0, "a*v", "u", "time", 2, 2, false, 0, 1, false, 0, 1, &constants);
+			QVERIFY(m);
+			VuoLocal(m);
+
+			unsigned int vertexCount;
+			float *positions;
+			VuoMesh_getCPUBuffers(m, &vertexCount, &positions, nullptr, nullptr, nullptr, nullptr, nullptr);
+			QCOMPARE(vertexCount, 4U);
+
+			// The user-defined constant `u` should take precedence over the built-in variable.
+			for (unsigned int vertex = 0; vertex < vertexCount; ++vertex)
+				QCOMPARE(positions[vertex * 3 + 1], 10.f);
+
+			QCOMPARE(positions[1 * 3], 0.f);
+			QCOMPARE(positions[2 * 3], (float)(2 + i));
+		}
+
+		VuoDictionary_VuoText_VuoReal_release(constants);
+	}
 };
 
 QTEST_APPLESS_MAIN(TestVuoMathExpression)
@@ -176,6 +176,91 @@ private slots:
 		VuoTable_release(table);
 	}
 
+	void testMakeFromDataRowRange_data()
+	{
+		QTest::addColumn<QString>("input");
+		QTest::addColumn<int>("firstRow");
+		QTest::addColumn<qlonglong>("lastRow");
+		QTest::addColumn<QString>("output");
+
+		const char *table = QUOTE(a,b\n"c\nc",d\n\ne,f\ng,h);
+		QTest::newRow("all rows")             << table << 1 << (qlonglong)VuoTable_NoLastRow << QUOTE(a,b\nc\nc,d\ne,f\ng,h);
+		QTest::newRow("first row")            << table << 1 << 1LL                         << QUOTE(a,b);
+		QTest::newRow("middle rows")          << table << 2 << 3LL                         << QUOTE(c\nc,d\ne,f);
+		QTest::newRow("through the end")      << table << 3 << (qlonglong)VuoTable_NoLastRow << QUOTE(e,f\ng,h);
+		QTest::newRow("beyond the end")       << table << 5 << 10LL                        << "";
+		QTest::newRow("first row below 1")    << table << -5 << 1LL                        << QUOTE(a,b);
+		QTest::newRow("last before first")    << table << 3 << 2LL                         << "";
+		QTest::newRow("metadata line")        << "sep=;\na;b\nc;d" << 2 << 2LL          << QUOTE(c,d);
+	}
+	void testMakeFromDataRowRange()
+	{
+		QFETCH(QString, input);
+		QFETCH(int, firstRow);
+		QFETCH(qlonglong, lastRow);
+		QFETCH(QString, output);
+
+		QByteArray data = input.toUtf8();
+		VuoTable table = VuoTable_makeFromData(data.constData(), data.size(), VuoTableFormat_Csv, firstRow, lastRow);
+		VuoTable_retain(table);
+		VuoText actualOutputQuoted = VuoTable_serialize(table, VuoTableFormat_Csv);
+		VuoLocal(actualOutputQuoted);
+		VuoText actualOutput = VuoText_replace(actualOutputQuoted, "\"", "");
+		VuoLocal(actualOutput);
+		QCOMPARE(QString::fromUtf8(actualOutput), output);
+		VuoTable_release(table);
+	}
+
+	void testMakeFromLargeFile()
+	{
+		// Large enough to be split into chunks and parsed in parallel, with quoted line breaks and ragged rows
+		// so that splitting in the wrong place would be noticed.
+		const int rowCount = 600000;
+		string csv = "id,value,note\n";
+		for (int i = 1; i < rowCount; ++i)
+		{
+			csv += to_string(i) + "," + to_string(i * 2);
+			if (i % 3 == 0)
+				csv += ",\"line one\nline \"\"two\"\"\"";
+			csv += "\n";
+		}
+
+		QTemporaryFile file;
+		QVERIFY(file.open());
+		QCOMPARE(file.write(csv.data(), csv.size()), (qint64)csv.size());
+		file.close();
+
+		VuoTable table = VuoTable_makeFromFile(file.fileName().toUtf8().constData(), VuoTableFormat_Csv, 1, VuoTable_NoLastRow);
+		VuoTable_retain(table);
+
+		QCOMPARE(table.rowCount, (size_t)rowCount);
+		QCOMPARE(table.columnCount, (size_t)3);
+		for (int i = 1; i < rowCount; i += 4999)
+		{
+			QCOMPARE(QString::fromUtf8(VuoTable_getItem_VuoInteger_VuoInteger(table, i + 1, 1)), QString::number(i));
+			QCOMPARE(QString::fromUtf8(VuoTable_getItem_VuoInteger_VuoInteger(table, i + 1, 2)), QString::number(i * 2));
+			if (i % 3 == 0)
+				QCOMPARE(QString::fromUtf8(VuoTable_getItem_VuoInteger_VuoInteger(table, i + 1, 3)), QString("line one\nline \"two\""));
+			else
+				QVERIFY(! VuoTable_getItem_VuoInteger_VuoInteger(table, i + 1, 3));
+		}
+
+		// Numeric sorting should work across chunks.
+		VuoTable sortedTable = VuoTable_sort_VuoInteger(table, 2, VuoTextSort_Number, VuoSortOrder_Descending, true);
+		VuoTable_retain(sortedTable);
+		QCOMPARE(QString::fromUtf8(VuoTable_getItem_VuoInteger_VuoInteger(sortedTable, 2, 1)), QString::number(rowCount - 1));
+
+		// Reading a range of rows should only include those rows.
+		VuoTable rangeTable = VuoTable_makeFromFile(file.fileName().toUtf8().constData(), VuoTableFormat_Csv, 1000, 1001);
+		VuoTable_retain(rangeTable);
+		QCOMPARE(rangeTable.rowCount, (size_t)2);
+		QCOMPARE(QString::fromUtf8(VuoTable_getItem_VuoInteger_VuoInteger(rangeTable, 1, 1)), QString("999"));
+
+		VuoTable_release(table);
+		VuoTable_release(sortedTable);
+		VuoTable_release(rangeTable);
+	}
+
 	void testSortInteger_data()
 	{
 		QTest::addColumn<QString>("input");
@@ -319,6 +404,16 @@ private slots:
 				<< QUOTE(Alaska,-62.2,1/23/71\nSamoa,11.1,9/29/71\nMalaysia,7.8,4/11/78\nEngland,-26.1,1/10/82\nSouth Pole,-82.8,6/23/82\nAustralia,-23,6/29/94\nPanama,2,2/20/95\nArgentina,-32.8,6/1/07\nSouth Africa,-20.1,8/23/13\nSiberia,-67.8,2/6/33)
 				<< 3 << VuoTextSort_Date << VuoSortOrder_Ascending << false;
 		}
+		{
+			QTest::newRow("numbers in various formats") << QUOTE(n\n10\n1e1\n-2.5E-1\n3)
+														<< QUOTE(n\n-2.5E-1\n3\n10\n1e1)
+														<< 1 << VuoTextSort_Number << VuoSortOrder_Ascending << true;
+		}
+		{
+			QTest::newRow("numbers mixed with text") << QUOTE(n,x\n10,a\nabc,b\n9.5,c\n,d\n-3,e\n1e1,f)
+													 << QUOTE(n,x\n-3,e\nabc,b\n,d\n9.5,c\n10,a\n1e1,f)
+													 << 1 << VuoTextSort_Number << VuoSortOrder_Ascending << true;
+		}
 		{
 			const char *orig = QUOTE(A,,B\nC,,D);
 			QTest::newRow("null items as text") << orig << orig << 2 << VuoTextSort_Text << VuoSortOrder_Ascending << false;
@@ -917,6 +1012,48 @@ private slots:
 		QCOMPARE(QString::fromUtf8(VuoList_VuoText_getString(foundRowByColumnHeader)), expectedRow);
 	}
 
+	void testGetItemRepeatedly()
+	{
+		VuoTable table = VuoTable_makeFromText(QUOTE(a,b\nc,d), VuoTableFormat_Csv);
+		VuoTable_retain(table);
+
+		// Items should be converted to VuoText once, then reused.
+		VuoText item = VuoTable_getItem_VuoInteger_VuoInteger(table, 2, 1);
+		QCOMPARE(QString::fromUtf8(item), QString("c"));
+		QVERIFY(VuoTable_getItem_VuoInteger_VuoInteger(table, 2, 1) == item);
+
+		VuoList_VuoText column = VuoTable_getColumn_VuoInteger(table, 1, true);
+		VuoLocal(column);
+		QVERIFY(VuoListGetValue_VuoText(column, 2) == item);
+
+		VuoTable_release(table);
+	}
+
+	void testParseAndSortPerformance_data()
+	{
+		QTest::addColumn<VuoTextSort>("sortType");
+
+		QTest::newRow("text") << VuoTextSort_Text;
+		QTest::newRow("number") << VuoTextSort_Number;
+	}
+	void testParseAndSortPerformance()
+	{
+		QFETCH(VuoTextSort, sortType);
+
+		string csv = "name,value\n";
+		for (int i = 0; i < 10000; ++i)
+			csv += "item" + to_string(i) + "," + to_string((i * 7919) % 10007) + "." + to_string(i % 10) + "\n";
+
+		QBENCHMARK {
+			VuoTable table = VuoTable_makeFromText(csv.c_str(), VuoTableFormat_Csv);
+			VuoTable sortedTable = VuoTable_sort_VuoInteger(table, 2, sortType, VuoSortOrder_Ascending, true);
+			VuoTable_retain(table);
+			VuoTable_retain(sortedTable);
+			VuoTable_release(table);
+			VuoTable_release(sortedTable);
+		}
+	}
+
 };
 
 QTEST_APPLESS_MAIN(TestVuoTable)
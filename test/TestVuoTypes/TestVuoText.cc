@@ -91,6 +91,8 @@ private slots:
 		QTest::newRow("longer")				<< "0123456789"								<< 10;
 		QTest::newRow("UTF8 short")			<< QString::fromUtf8("流")					<< 1;
 		QTest::newRow("UTF8 longer")		<< QString::fromUtf8("⓪①②③④⑤⑥⑦⑧⑨")	<< 10;
+		QTest::newRow("UTF8 mixed")			<< QString::fromUtf8("a流b")					<< 3;
+		QTest::newRow("UTF8 surrogate pair")	<< QString::fromUtf8("a😀")					<< 3;
 	}
 	void testLength()
 	{
@@ -98,6 +100,32 @@ private slots:
 		QFETCH(int, length);
 
 		QCOMPARE(VuoText_length(value.toUtf8().data()), (size_t)length);
+
+		// The first call classifies the text's encoding and caches it with the text; the second uses the cached encoding.
+		VuoText t = VuoText_make(value.toUtf8().constData());
+		VuoLocal(t);
+		QCOMPARE(VuoText_length(t), (size_t)length);
+		QCOMPARE(VuoText_length(t), (size_t)length);
+	}
+
+	void testLengthPerformance_data()
+	{
+		QTest::addColumn<QString>("word");
+
+		QTest::newRow("ASCII") << "word ";
+		QTest::newRow("non-ASCII") << QString::fromUtf8("mot® ");
+	}
+	void testLengthPerformance()
+	{
+		QFETCH(QString, word);
+
+		// Small enough to be allocated from VuoHeap's pool, so its encoding can be cached.
+		VuoText t = VuoText_make(word.repeated(150).toUtf8().constData());
+		VuoLocal(t);
+
+		QBENCHMARK {
+			QCOMPARE(VuoText_length(t), (size_t)750);
+		}
 	}
 
 	void testEmpty_data()
@@ -325,6 +353,9 @@ private slots:
 		QTest::newRow("emptystring, emptystring")		<< (void *)""	<< (void *)""		<< true;
 		QTest::newRow("different strings")				<< (void *)"⓪"	<< (void *)"①"		<< false;
 		QTest::newRow("same strings, same encoding")	<< (void *)"⓪"	<< (void *)"⓪"		<< true;
+		QTest::newRow("ASCII, same")					<< (void *)"foo"	<< (void *)"foo"	<< true;
+		QTest::newRow("ASCII, prefix")					<< (void *)"foo"	<< (void *)"foobar"	<< false;
+		QTest::newRow("ASCII, different case")			<< (void *)"foo"	<< (void *)"Foo"	<< false;
 
 		{
 			// https://en.wikipedia.org/wiki/Combining_character
@@ -362,6 +393,10 @@ private slots:
 		QTest::newRow("emptystring, string")			<< (void *)""	<< (void *)"foo"	<< true;
 		QTest::newRow("string, emptystring")			<< (void *)"foo"<< (void *)""		<< false;
 
+		QTest::newRow("ASCII prefix")					<< (void *)"foo"	<< (void *)"foobar"	<< true;
+		QTest::newRow("ASCII uppercase before lowercase")	<< (void *)"Zebra"	<< (void *)"apple"	<< true;
+		QTest::newRow("ASCII vs. non-ASCII")			<< (void *)"z"		<< (void *)"①"		<< true;
+
 		// Ensure Unicode comparison works.
 		QTest::newRow("different strings 1")			<< (void *)"①"	<< (void *)"②"		<< true;
 		QTest::newRow("different strings 2")			<< (void *)"②"	<< (void *)"①"		<< false;
@@ -409,6 +444,57 @@ private slots:
 		QCOMPARE(VuoText_isLessThan((VuoText)text1, (VuoText)text2), expectedLessThan);
 	}
 
+	void testLessThanCaseInsensitive_data()
+	{
+		QTest::addColumn<QString>("text1");
+		QTest::addColumn<QString>("text2");
+		QTest::addColumn<bool>("expectedLessThan");
+
+		QTest::newRow("ASCII <")				<< "apple"	<< "Banana"	<< true;
+		QTest::newRow("ASCII >")				<< "Banana"	<< "apple"	<< false;
+		QTest::newRow("ASCII equal")			<< "Apple"	<< "aPPLE"	<< false;
+		QTest::newRow("ASCII prefix")			<< "APP"	<< "apple"	<< true;
+		QTest::newRow("non-ASCII <")			<< QString::fromUtf8("éa")	<< QString::fromUtf8("ÉB")	<< true;
+		QTest::newRow("non-ASCII equal")		<< QString::fromUtf8("É")	<< QString::fromUtf8("é")	<< false;
+	}
+	void testLessThanCaseInsensitive()
+	{
+		QFETCH(QString, text1);
+		QFETCH(QString, text2);
+		QFETCH(bool, expectedLessThan);
+
+		QCOMPARE(VuoText_isLessThanCaseInsensitive(text1.toUtf8().constData(), text2.toUtf8().constData()), expectedLessThan);
+	}
+
+	void testSortPerformance_data()
+	{
+		QTest::addColumn<QString>("prefix");
+
+		QTest::newRow("ASCII") << "item";
+		QTest::newRow("non-ASCII") << QString::fromUtf8("élément");
+	}
+	void testSortPerformance()
+	{
+		QFETCH(QString, prefix);
+
+		std::vector<VuoText> texts;
+		for (int i = 0; i < 10000; ++i)
+		{
+			// Scramble the order, and vary the lengths.
+			VuoText t = VuoText_make(QString("%1 %2").arg(prefix).arg((i * 7919) % 10000).toUtf8().constData());
+			VuoRetain(t);
+			texts.push_back(t);
+		}
+
+		QBENCHMARK {
+			std::vector<VuoText> sorted(texts);
+			std::sort(sorted.begin(), sorted.end(), VuoText_isLessThan);
+		}
+
+		for (VuoText t : texts)
+			VuoRelease(t);
+	}
+
 	void testCompare_data()
 	{
 		QTest::addColumn<void *>("text1");
@@ -553,6 +639,11 @@ private slots:
 		QTest::newRow("Found at end")			<< "⓪①②③④" << "④"		<< (size_t)5 << (size_t)5;
 		QTest::newRow("Multiple occurrences")	<< "⓪①①①④" << "①"		<< (size_t)2 << (size_t)4;
 		QTest::newRow("Multiple characters")	<< "⓪①②③④" << "①②③④"	<< (size_t)2 << (size_t)2;
+		QTest::newRow("ASCII not found")		<< "hello world" << "xyz"	<< (size_t)0 << (size_t)0;
+		QTest::newRow("ASCII overlapping")		<< "aaaa"		<< "aa"		<< (size_t)1 << (size_t)3;
+		QTest::newRow("ASCII periodic")			<< "abababcab"	<< "ababc"	<< (size_t)3 << (size_t)3;
+		QTest::newRow("ASCII in non-ASCII")		<< "⓪abc⓪abc"	<< "abc"	<< (size_t)2 << (size_t)6;
+		QTest::newRow("Width-insensitive")		<< "abcABC"		<< "ＡＢ"	<< (size_t)4 << (size_t)4;
 	}
 	void testFind()
 	{
@@ -578,6 +669,10 @@ private slots:
 		QTest::newRow("Not found")	<< "⓪①②③④" << "⑤" << "⓪" << "⓪①②③④";
 		QTest::newRow("Single")		<< "⓪①②③④" << "③" << "⑤" << "⓪①②⑤④";
 		QTest::newRow("Multiple")	<< "⓪⓪①①②" << "①" << "⑤" << "⓪⓪⑤⑤②";
+		QTest::newRow("ASCII")		<< "a-b-c" << "-" << ", " << "a, b, c";
+		QTest::newRow("ASCII overlapping")	<< "aaaaa" << "aa" << "b" << "bba";
+		QTest::newRow("ASCII with non-ASCII replacement")	<< "a-b" << "-" << "⓪" << "a⓪b";
+		QTest::newRow("ASCII to empty")	<< "a-b-" << "-" << "" << "ab";
 	}
 	void testReplace()
 	{
@@ -589,6 +684,105 @@ private slots:
 		QVERIFY(VuoText_areEqual(VuoText_replace(subject.toUtf8().data(), stringToFind.toUtf8().data(), replacement.toUtf8().data()), expectedReplacedString.toUtf8().data()));
 	}
 
+	void testFindPerformance_data()
+	{
+		QTest::addColumn<QString>("line");
+		QTest::addColumn<QString>("substring");
+
+		QTest::newRow("ASCII") << "2023-01-01 00:00:00 INFO request handled in 12 ms\n" << "ERROR";
+		QTest::newRow("non-ASCII") << "2023-01-01 00:00:00 INFO requête traitée en 12 ms\n" << "ERREUR";
+	}
+	void testFindPerformance()
+	{
+		QFETCH(QString, line);
+		QFETCH(QString, substring);
+
+		// About 1 MB of log text, with the substring only at the end.
+		QString log = line.repeated(20000) + substring;
+		VuoText logT = VuoText_make(log.toUtf8().constData());
+		VuoRetain(logT);
+		VuoText substringT = VuoText_make(substring.toUtf8().constData());
+		VuoRetain(substringT);
+
+		QBENCHMARK {
+			VuoList_VuoInteger occurrences = VuoText_findOccurrences(logT, substringT);
+			VuoLocal(occurrences);
+			QCOMPARE(VuoListGetCount_VuoInteger(occurrences), 1UL);
+		}
+
+		VuoRelease(logT);
+		VuoRelease(substringT);
+	}
+
+	void testSplit_data()
+	{
+		QTest::addColumn<QString>("text");
+		QTest::addColumn<QString>("separator");
+		QTest::addColumn<bool>("includeEmptyParts");
+		QTest::addColumn<QStringList>("expectedParts");
+
+		QTest::newRow("emptystring")				<< ""			<< ","		<< true		<< QStringList();
+		QTest::newRow("no separator")				<< "abc"		<< ","		<< true		<< (QStringList() << "abc");
+		QTest::newRow("empty parts excluded")		<< ",a,,b,"		<< ","		<< false	<< (QStringList() << "a" << "b");
+		QTest::newRow("empty parts included")		<< ",a,,b,"		<< ","		<< true		<< (QStringList() << "" << "a" << "" << "b" << "");
+		QTest::newRow("only separator")				<< ","			<< ","		<< true		<< (QStringList() << "" << "");
+		QTest::newRow("multi-character separator")	<< "a--b---c"	<< "--"		<< true		<< (QStringList() << "a" << "b" << "-c");
+		QTest::newRow("characters")					<< "abc"		<< ""		<< false	<< (QStringList() << "a" << "b" << "c");
+		QTest::newRow("UTF8 text")					<< QString::fromUtf8("流,①,é")	<< ","	<< true		<< (QStringList() << QString::fromUtf8("流") << QString::fromUtf8("①") << QString::fromUtf8("é"));
+		QTest::newRow("UTF8 separator")				<< QString::fromUtf8("a→b→")	<< QString::fromUtf8("→")	<< true	<< (QStringList() << "a" << "b" << "");
+	}
+	void testSplit()
+	{
+		QFETCH(QString, text);
+		QFETCH(QString, separator);
+		QFETCH(bool, includeEmptyParts);
+		QFETCH(QStringList, expectedParts);
+
+		size_t partsCount;
+		VuoText *parts = VuoText_split(text.toUtf8().constData(), separator.toUtf8().constData(), includeEmptyParts, &partsCount);
+		QStringList actualParts;
+		for (size_t i = 0; i < partsCount; ++i)
+		{
+			VuoRetain(parts[i]);
+			actualParts << QString::fromUtf8(parts[i]);
+			VuoRelease(parts[i]);
+		}
+		free(parts);
+
+		QCOMPARE(actualParts, expectedParts);
+	}
+
+	void testSplitPerformance_data()
+	{
+		QTest::addColumn<QString>("field");
+
+		QTest::newRow("ASCII") << "12.5";
+		QTest::newRow("non-ASCII") << QString::fromUtf8("café");
+	}
+	void testSplitPerformance()
+	{
+		QFETCH(QString, field);
+
+		// A CSV line with 100,000 fields.
+		QString line = (field + ",").repeated(100000);
+		VuoText lineT = VuoText_make(line.toUtf8().constData());
+		VuoRetain(lineT);
+
+		QBENCHMARK {
+			size_t partsCount;
+			VuoText *parts = VuoText_split(lineT, ",", false, &partsCount);
+			QCOMPARE(partsCount, 100000UL);
+			for (size_t i = 0; i < partsCount; ++i)
+			{
+				VuoRetain(parts[i]);
+				VuoRelease(parts[i]);
+			}
+			free(parts);
+		}
+
+		VuoRelease(lineT);
+	}
+
 	void testCapitalization_data()
 	{
 		QTest::addColumn<QString>("sentence");
@@ -80,6 +80,14 @@ bool VuoBoolean_areEqual(const VuoBoolean value1, const VuoBoolean value2)
 	return value1 == value2;
 }
 
+/**
+ * Returns a hash of the value.
+ */
+unsigned long VuoBoolean_hash(const VuoBoolean value)
+{
+	return value ? 1 : 0;
+}
+
 /**
  * Returns true if `a` is false and `b` is true.
  * @version200New
@@ -29,6 +29,7 @@ extern "C"
 typedef unsigned long VuoBoolean;
 
 #define VuoBoolean_SUPPORTS_COMPARISON  ///< Instances of this type can be compared and sorted.
+#define VuoBoolean_SUPPORTS_HASHING  ///< Instances of this type can be hashed.
 #include "VuoList_VuoBoolean.h"
 
 VuoBoolean VuoBoolean_makeFromJson(struct json_object * js);
@@ -46,6 +47,7 @@ void VuoBoolean_release(VuoBoolean value);
 /// @}
 
 bool VuoBoolean_areEqual(const VuoBoolean value1, const VuoBoolean value2);
+unsigned long VuoBoolean_hash(const VuoBoolean value);
 bool VuoBoolean_isLessThan(const VuoBoolean a, const VuoBoolean b);
 
 /**
@@ -8,6 +8,7 @@
  */
 
 #include <sstream>
+#include "VuoDictionaryIndex.hh"
 
 extern "C"
 {
@@ -33,6 +34,14 @@ VuoModuleMetadata({
 /// @}
 }
 
+/**
+ * Returns the 1-based position of @a key in the dictionary's lists, or 0 if the key isn't found.
+ */
+static unsigned long VuoDictionary_VuoText_VuoReal_findKey(VuoDictionary_VuoText_VuoReal d, VuoText key)
+{
+	return VuoDictionaryIndex::find(d.index, d.keys, VuoListGetData_VuoText(d.keys), VuoListGetCount_VuoText(d.keys), key);
+}
+
 /**
  * @ingroup VuoDictionary_VuoText_VuoReal
  * Decodes the JSON object to create a new value.
@@ -55,6 +64,8 @@ VuoDictionary_VuoText_VuoReal VuoDictionary_VuoText_VuoReal_makeFromJson(json_ob
 	bool hasValues = json_object_object_get_ex(js, "values", &o);
 	d.values = VuoList_VuoReal_makeFromJson(hasValues ? o : NULL);
 
+	d.index = VuoDictionaryIndex::make();
+
 	return d;
 }
 
@@ -118,15 +129,17 @@ char * VuoDictionary_VuoText_VuoReal_getSummary(const VuoDictionary_VuoText_VuoR
  */
 VuoDictionary_VuoText_VuoReal VuoDictionaryCreate_VuoText_VuoReal(void)
 {
-    return (VuoDictionary_VuoText_VuoReal){VuoListCreate_VuoText(), VuoListCreate_VuoReal()};
+	return (VuoDictionary_VuoText_VuoReal){VuoListCreate_VuoText(), VuoListCreate_VuoReal(), VuoDictionaryIndex::make()};
 }
 
 /**
  * Creates a dictionary consisting of the specified keys and values.
+ *
+ * The dictionary gets its own copies of the lists, so later changes to @a keys and @a values don't affect it.
  */
 VuoDictionary_VuoText_VuoReal VuoDictionaryCreateWithLists_VuoText_VuoReal(const VuoList_VuoText keys, const VuoList_VuoReal values)
 {
-    return (VuoDictionary_VuoText_VuoReal){keys, values};
+	return (VuoDictionary_VuoText_VuoReal){VuoListCopy_VuoText(keys), VuoListCopy_VuoReal(values), VuoDictionaryIndex::make()};
 }
 
 /**
@@ -137,10 +150,9 @@ VuoDictionary_VuoText_VuoReal VuoDictionaryCreateWithLists_VuoText_VuoReal(const
  */
 VuoReal VuoDictionaryGetValueForKey_VuoText_VuoReal(VuoDictionary_VuoText_VuoReal d, VuoText key)
 {
-	unsigned long count = VuoListGetCount_VuoText(d.keys);
-	for (unsigned long i = 1; i <= count; ++i)
-		if (strcmp(key, VuoListGetValue_VuoText(d.keys, i)) == 0)
-			return VuoListGetValue_VuoReal(d.values, i);
+	unsigned long position = VuoDictionary_VuoText_VuoReal_findKey(d, key);
+	if (position)
+		return VuoListGetValue_VuoReal(d.values, position);
 
 	return 0;
 }
@@ -149,11 +161,17 @@ VuoReal VuoDictionaryGetValueForKey_VuoText_VuoReal(VuoDictionary_VuoText_VuoRea
  * @ingroup VuoDictionary_VuoText_VuoReal
  * Sets the value mapped from @a key in the dictionary to @a value.
  *
- * (Currently, this only allows adding a key-value mapping, not changing an existing one. When this type
- * is replaced with a generic VuoDictionary type, this function will allow the latter.)
+ * If the dictionary already contains @a key, its value is replaced. Otherwise, the key-value mapping is appended.
  */
 void VuoDictionarySetKeyValue_VuoText_VuoReal(VuoDictionary_VuoText_VuoReal d, VuoText key, VuoReal value)
 {
+	unsigned long position = VuoDictionary_VuoText_VuoReal_findKey(d, key);
+	if (position)
+	{
+		VuoListSetValue_VuoReal(d.values, value, position, false);
+		return;
+	}
+
 	VuoListAppendValue_VuoText(d.keys, key);
 	VuoListAppendValue_VuoReal(d.values, value);
 }
@@ -166,6 +184,7 @@ void VuoDictionary_VuoText_VuoReal_retain(VuoDictionary_VuoText_VuoReal value)
 {
 	VuoRetain(value.keys);
 	VuoRetain(value.values);
+	VuoRetain(value.index);
 }
 
 /**
@@ -176,4 +195,5 @@ void VuoDictionary_VuoText_VuoReal_release(VuoDictionary_VuoText_VuoReal value)
 {
 	VuoRelease(value.keys);
 	VuoRelease(value.values);
+	VuoRelease(value.index);
 }
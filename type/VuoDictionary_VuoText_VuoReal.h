@@ -29,11 +29,15 @@ extern "C" {
 
 /**
  * A mapping from keys to values.
+ *
+ * The dictionary owns `keys` and `values`. Modify them only through the VuoDictionary functions,
+ * since the dictionary's index assumes that keys are only appended.
  */
 typedef struct
 {
 	VuoList_VuoText keys;
 	VuoList_VuoReal values;
+	void *index;  ///< A hash index from keys to their positions in the lists, built the first time it's needed. If null, lookups scan `keys`.
 } VuoDictionary_VuoText_VuoReal;
 
 VuoDictionary_VuoText_VuoReal VuoDictionary_VuoText_VuoReal_makeFromJson(struct json_object * js);
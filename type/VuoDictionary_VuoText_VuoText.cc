@@ -8,6 +8,7 @@
  */
 
 #include <sstream>
+#include "VuoDictionaryIndex.hh"
 
 extern "C"
 {
@@ -31,6 +32,14 @@ VuoModuleMetadata({
 /// @}
 }
 
+/**
+ * Returns the 1-based position of @a key in the dictionary's lists, or 0 if the key isn't found.
+ */
+static unsigned long VuoDictionary_VuoText_VuoText_findKey(VuoDictionary_VuoText_VuoText d, VuoText key)
+{
+	return VuoDictionaryIndex::find(d.index, d.keys, VuoListGetData_VuoText(d.keys), VuoListGetCount_VuoText(d.keys), key);
+}
+
 /**
  * @ingroup VuoDictionary_VuoText_VuoText
  * Decodes the JSON object to create a new value.
@@ -53,6 +62,8 @@ VuoDictionary_VuoText_VuoText VuoDictionary_VuoText_VuoText_makeFromJson(json_ob
 	bool hasValues = json_object_object_get_ex(js, "values", &o);
 	d.values = VuoList_VuoText_makeFromJson(hasValues ? o : NULL);
 
+	d.index = VuoDictionaryIndex::make();
+
 	return d;
 }
 
@@ -117,15 +128,17 @@ char * VuoDictionary_VuoText_VuoText_getSummary(const VuoDictionary_VuoText_VuoT
  */
 VuoDictionary_VuoText_VuoText VuoDictionaryCreate_VuoText_VuoText(void)
 {
-    return (VuoDictionary_VuoText_VuoText){VuoListCreate_VuoText(), VuoListCreate_VuoText()};
+	return (VuoDictionary_VuoText_VuoText){VuoListCreate_VuoText(), VuoListCreate_VuoText(), VuoDictionaryIndex::make()};
 }
 
 /**
  * Creates a dictionary consisting of the specified keys and values.
+ *
+ * The dictionary gets its own copies of the lists, so later changes to @a keys and @a values don't affect it.
  */
 VuoDictionary_VuoText_VuoText VuoDictionaryCreateWithLists_VuoText_VuoText(const VuoList_VuoText keys, const VuoList_VuoText values)
 {
-    return (VuoDictionary_VuoText_VuoText){keys, values};
+	return (VuoDictionary_VuoText_VuoText){VuoListCopy_VuoText(keys), VuoListCopy_VuoText(values), VuoDictionaryIndex::make()};
 }
 
 /**
@@ -136,10 +149,9 @@ VuoDictionary_VuoText_VuoText VuoDictionaryCreateWithLists_VuoText_VuoText(const
  */
 VuoText VuoDictionaryGetValueForKey_VuoText_VuoText(VuoDictionary_VuoText_VuoText d, VuoText key)
 {
-	unsigned long count = VuoListGetCount_VuoText(d.keys);
-	for (unsigned long i = 1; i <= count; ++i)
-		if (strcmp(key, VuoListGetValue_VuoText(d.keys, i)) == 0)
-			return VuoListGetValue_VuoText(d.values, i);
+	unsigned long position = VuoDictionary_VuoText_VuoText_findKey(d, key);
+	if (position)
+		return VuoListGetValue_VuoText(d.values, position);
 
 	return VuoText_make("");
 }
@@ -148,11 +160,17 @@ VuoText VuoDictionaryGetValueForKey_VuoText_VuoText(VuoDictionary_VuoText_VuoTex
  * @ingroup VuoDictionary_VuoText_VuoText
  * Sets the value mapped from @a key in the dictionary to @a value.
  *
- * (Currently, this only allows adding a key-value mapping, not changing an existing one. When this type
- * is replaced with a generic VuoDictionary type, this function will allow the latter.)
+ * If the dictionary already contains @a key, its value is replaced. Otherwise, the key-value mapping is appended.
  */
 void VuoDictionarySetKeyValue_VuoText_VuoText(VuoDictionary_VuoText_VuoText d, VuoText key, VuoText value)
 {
+	unsigned long position = VuoDictionary_VuoText_VuoText_findKey(d, key);
+	if (position)
+	{
+		VuoListSetValue_VuoText(d.values, value, position, false);
+		return;
+	}
+
 	VuoListAppendValue_VuoText(d.keys, key);
 	VuoListAppendValue_VuoText(d.values, value);
 }
@@ -165,6 +183,7 @@ void VuoDictionary_VuoText_VuoText_retain(VuoDictionary_VuoText_VuoText value)
 {
 	VuoRetain(value.keys);
 	VuoRetain(value.values);
+	VuoRetain(value.index);
 }
 
 /**
@@ -175,4 +194,5 @@ void VuoDictionary_VuoText_VuoText_release(VuoDictionary_VuoText_VuoText value)
 {
 	VuoRelease(value.keys);
 	VuoRelease(value.values);
+	VuoRelease(value.index);
 }
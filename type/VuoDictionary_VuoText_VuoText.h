@@ -27,11 +27,15 @@ extern "C" {
 
 /**
  * A mapping from keys to values.
+ *
+ * The dictionary owns `keys` and `values`. Modify them only through the VuoDictionary functions,
+ * since the dictionary's index assumes that keys are only appended.
  */
 typedef struct
 {
 	VuoList_VuoText keys;
 	VuoList_VuoText values;
+	void *index;  ///< A hash index from keys to their positions in the lists, built the first time it's needed. If null, lookups scan `keys`.
 } VuoDictionary_VuoText_VuoText;
 
 VuoDictionary_VuoText_VuoText VuoDictionary_VuoText_VuoText_makeFromJson(struct json_object *js);
@@ -329,6 +329,14 @@ bool VuoInteger_areEqual(const VuoInteger value1, const VuoInteger value2)
 	return value1 == value2;
 }
 
+/**
+ * Returns a hash of the value.
+ */
+unsigned long VuoInteger_hash(const VuoInteger value)
+{
+	return value;
+}
+
 /**
  * Returns true if the two values are equal within `tolerance`.
  */
@@ -31,6 +31,7 @@ extern "C" {
 typedef int64_t VuoInteger;
 
 #define VuoInteger_SUPPORTS_COMPARISON  ///< Instances of this type can be compared and sorted.
+#define VuoInteger_SUPPORTS_HASHING  ///< Instances of this type can be hashed.
 #include "VuoList_VuoInteger.h"
 
 VuoInteger VuoInteger_makeFromJson(struct json_object * js);
@@ -122,6 +123,7 @@ static inline VuoInteger VuoInteger_snap(VuoInteger a, VuoInteger center, VuoInt
 }
 
 bool VuoInteger_areEqual(const VuoInteger value1, const VuoInteger value2);
+unsigned long VuoInteger_hash(const VuoInteger value);
 bool VuoInteger_areEqualListWithinTolerance(VuoList_VuoInteger values, VuoInteger tolerance);
 bool VuoInteger_isLessThan(const VuoInteger a, const VuoInteger b);
 bool VuoInteger_isWithinRange(VuoInteger value, VuoInteger minimum, VuoInteger maximum);
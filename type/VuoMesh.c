@@ -122,7 +122,7 @@ void VuoMesh_allocateCPUBuffers(unsigned int vertexCount,
 }
 
 /**
- * Frees the mesh and each of its submeshes, including the vertex and element arrays within it.
+ * Frees the vertex and element arrays within the mesh.
  */
 static void VuoMesh_free(void *value)
 {
@@ -136,8 +136,6 @@ static void VuoMesh_free(void *value)
 
 	VuoGlPool_release(VuoGlPool_ArrayBuffer, m->glUpload.combinedBufferSize, m->glUpload.combinedBuffer);
 	VuoGlPool_release(VuoGlPool_ElementArrayBuffer, m->glUpload.elementBufferSize, m->glUpload.elementBuffer);
-
-	free(m);
 }
 
 /**
@@ -145,8 +143,7 @@ static void VuoMesh_free(void *value)
  */
 static VuoMesh_internal *VuoMesh_makeInternal(void)
 {
-	VuoMesh_internal *m = (VuoMesh_internal *)calloc(1, sizeof(VuoMesh_internal));
-	VuoRegister(m, VuoMesh_free);
+	VuoMesh_internal *m = (VuoMesh_internal *)VuoHeap_allocRefCounted(sizeof(VuoMesh_internal), VuoMesh_free);
 	m->faceCulling = VuoMesh_CullBackfaces;
 	return m;
 }
@@ -115,7 +115,7 @@ uint64_t VuoSceneObject_getNextId(void)
 }
 
 /**
- * Frees the memory associated with the object.
+ * Releases the values the object refers to.
  *
  * @threadAny
  */
@@ -133,8 +133,6 @@ void VuoSceneObject_free(void *sceneObject)
 		VuoRelease(so->text.text);
 		VuoFont_release(so->text.font);
 	}
-
-	free(so);
 }
 
 /**
@@ -142,8 +140,7 @@ void VuoSceneObject_free(void *sceneObject)
  */
 VuoSceneObject VuoSceneObject_makeEmpty(void)
 {
-	VuoSceneObject_internal *so = (VuoSceneObject_internal *)calloc(1, sizeof(VuoSceneObject_internal));
-	VuoRegister(so, VuoSceneObject_free);
+	VuoSceneObject_internal *so = (VuoSceneObject_internal *)VuoHeap_allocRefCounted(sizeof(VuoSceneObject_internal), VuoSceneObject_free);
 
 	so->id = 0;
 	so->type = VuoSceneObjectSubType_Empty;
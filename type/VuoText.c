@@ -209,10 +209,13 @@ VuoText VuoText_makeWithoutCopying(const char *string)
  */
 VuoText VuoText_make(const char *string)
 {
-	if (string)
-		return VuoText_makeWithoutCopying(strdup(string));
-	else
-		return VuoText_makeWithoutCopying(strdup(""));
+	if (!string)
+		string = "";
+
+	size_t size = strlen(string) + 1;
+	char *text = (char *)VuoHeap_allocRefCounted(size, NULL);
+	memcpy(text, string, size);
+	return text;
 }
 
 /**
@@ -316,9 +319,10 @@ static const uint8_t utf8d[] = {
 };
 
 /**
- * Returns true if `data` is valid UTF-8 text.
+ * @ingroup VuoText
+ * Returns true if the first `size` bytes of `data` (or the bytes up to the first null byte, if sooner) are valid UTF-8 text.
  */
-static bool VuoText_isValidUtf8(const unsigned char *data, unsigned long size)
+bool VuoText_isValidUtf8(const unsigned char *data, unsigned long size)
 {
 	// Faster than CFStringCreateFromExternalRepresentation.
 	uint32_t codepoint;
@@ -413,6 +417,82 @@ VuoText VuoText_makeFromMacRoman(const char *string)
 	return t;
 }
 
+/**
+ * How a text's bytes are encoded, which determines how much of its processing can skip CFString.
+ */
+typedef enum
+{
+	VuoText_EncodingASCII,  ///< Each byte is one character, and no characters have alternate representations, so the bytes can be counted and compared directly.
+	VuoText_EncodingUTF8,   ///< Valid UTF-8 containing non-ASCII characters.  Characters can be counted and matched literally on the bytes, but comparisons need Unicode equivalence.
+	VuoText_EncodingOther,  ///< Invalid UTF-8, or UTF-8 starting with a byte-order mark (which CFString strips).
+} VuoText_Encoding;
+
+/**
+ * Returns the encoding cached in `text`'s VuoHeap type flags (plus 1), or 0 if it hasn't been cached.
+ *
+ * Texts are immutable, so once a text's encoding has been classified, it can be stored with the text.
+ * Only texts allocated from VuoHeap's pool have room for it (see @ref VuoHeap_setTypeFlags).
+ */
+static unsigned int VuoText_getCachedEncoding(const VuoText text)
+{
+	return VuoHeap_getTypeFlags(text) & 0x3;
+}
+
+/**
+ * If all bytes in `text` are between 0 and 127, outputs the text's length and returns true.
+ */
+static bool VuoText_getASCII7Length(const VuoText text, size_t *length)
+{
+	size_t byteCount = strlen(text);
+
+	unsigned int cachedEncoding = VuoText_getCachedEncoding(text);
+	if (cachedEncoding)
+	{
+		*length = byteCount;
+		return cachedEncoding - 1 == VuoText_EncodingASCII;
+	}
+
+	// Check 8 bytes at a time (which the compiler vectorizes further).
+	uint64_t highBits = 0;
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= byteCount; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, text + i, sizeof(uint64_t));
+		highBits |= word;
+	}
+	for (; i < byteCount; ++i)
+		highBits |= (unsigned char)text[i];
+
+	*length = byteCount;
+	bool isASCII = !(highBits & 0x8080808080808080ULL);
+	if (isASCII)
+		VuoHeap_setTypeFlags(text, VuoText_EncodingASCII + 1);
+	return isASCII;
+}
+
+/**
+ * Classifies `text`'s encoding, and outputs its length in bytes.
+ */
+static VuoText_Encoding VuoText_getEncoding(const VuoText text, size_t *byteCount)
+{
+	if (VuoText_getASCII7Length(text, byteCount))
+		return VuoText_EncodingASCII;
+
+	unsigned int cachedEncoding = VuoText_getCachedEncoding(text);
+	if (cachedEncoding)
+		return (VuoText_Encoding)(cachedEncoding - 1);
+
+	VuoText_Encoding encoding = VuoText_EncodingUTF8;
+	const unsigned char *bytes = (const unsigned char *)text;
+	if ((*byteCount >= 3 && bytes[0] == 0xef && bytes[1] == 0xbb && bytes[2] == 0xbf)
+	 || !VuoText_isValidUtf8(bytes, *byteCount))
+		encoding = VuoText_EncodingOther;
+
+	VuoHeap_setTypeFlags(text, encoding + 1);
+	return encoding;
+}
+
 /**
  * @ingroup VuoText
  * Returns the number of Unicode characters in the text.
@@ -422,6 +502,22 @@ size_t VuoText_length(const VuoText text)
 	if (! text)
 		return 0;
 
+	size_t byteCount;
+	VuoText_Encoding encoding = VuoText_getEncoding(text, &byteCount);
+	if (encoding == VuoText_EncodingASCII)
+		return byteCount;
+
+	if (encoding == VuoText_EncodingUTF8)
+	{
+		// Count UTF-16 code units (to match CFStringGetLength):
+		// one per lead byte, plus one more for each 4-byte sequence (which becomes a surrogate pair).
+		const unsigned char *bytes = (const unsigned char *)text;
+		size_t length = 0;
+		for (size_t i = 0; i < byteCount; ++i)
+			length += ((bytes[i] & 0xc0) != 0x80) + (bytes[i] >= 0xf0);
+		return length;
+	}
+
 	CFStringRef s = CFStringCreateWithCString(kCFAllocatorDefault, text, kCFStringEncodingUTF8);
 	if (!s)
 		return 0;
@@ -472,6 +568,11 @@ bool VuoText_areEqual(const VuoText text1, const VuoText text2)
 	if (! text1 || ! text2)
 		return (! text1 && ! text2);
 
+	// ASCII characters have no alternate representations, so ASCII texts are only equal if their bytes are.
+	size_t byteCount1, byteCount2;
+	if (VuoText_getASCII7Length(text1, &byteCount1) && VuoText_getASCII7Length(text2, &byteCount2))
+		return byteCount1 == byteCount2 && memcmp(text1, text2, byteCount1) == 0;
+
 	CFStringRef s1 = CFStringCreateWithCString(kCFAllocatorDefault, text1, kCFStringEncodingUTF8);
 	if (!s1)
 		return false;
@@ -490,6 +591,54 @@ bool VuoText_areEqual(const VuoText text1, const VuoText text2)
 	return (result == kCFCompareEqualTo);
 }
 
+/**
+ * Returns an FNV-1a hash of the first `byteCount` bytes of `bytes`.
+ */
+static unsigned long VuoText_hashBytes(const unsigned char *bytes, size_t byteCount)
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (size_t i = 0; i < byteCount; ++i)
+		hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+	return hash;
+}
+
+/**
+ * Returns a hash of `text`.
+ *
+ * Texts that are equal according to @ref VuoText_areEqual have the same hash,
+ * since the text is hashed in Unicode Normalization Form KC (which also unifies half-width and full-width characters).
+ */
+unsigned long VuoText_hash(const VuoText text)
+{
+	if (!text)
+		return 0;
+
+	// ASCII text is already in Normalization Form KC.
+	size_t byteCount;
+	if (VuoText_getASCII7Length(text, &byteCount))
+		return VuoText_hashBytes((const unsigned char *)text, byteCount);
+
+	CFStringRef s = CFStringCreateWithCString(kCFAllocatorDefault, text, kCFStringEncodingUTF8);
+	if (!s)
+		// Invalid UTF-8 text is only equal to itself.
+		return VuoText_hashBytes((const unsigned char *)text, byteCount);
+
+	CFMutableStringRef normalized = CFStringCreateMutableCopy(kCFAllocatorDefault, 0, s);
+	CFRelease(s);
+	CFStringNormalize(normalized, kCFStringNormalizationFormKC);
+
+	CFIndex normalizedLength = CFStringGetLength(normalized);
+	CFIndex maxByteCount = CFStringGetMaximumSizeForEncoding(normalizedLength, kCFStringEncodingUTF8);
+	unsigned char *normalizedBytes = (unsigned char *)malloc(maxByteCount);
+	CFIndex normalizedByteCount = 0;
+	CFStringGetBytes(normalized, CFRangeMake(0, normalizedLength), kCFStringEncodingUTF8, 0, false, normalizedBytes, maxByteCount, &normalizedByteCount);
+	CFRelease(normalized);
+
+	unsigned long hash = VuoText_hashBytes(normalizedBytes, normalizedByteCount);
+	free(normalizedBytes);
+	return hash;
+}
+
 /**
  * Helper for `VuoText_isLessThan*()`.
  */
@@ -500,6 +649,19 @@ static bool isLessThan(const VuoText text1, const VuoText text2, CFStringCompare
 	if (! text1 || ! text2)
 		return text1 && !text2;
 
+	// For ASCII text, CFString's ordering is byte order (after folding case, if requested).
+	size_t byteCount1, byteCount2;
+	if (VuoText_getASCII7Length(text1, &byteCount1) && VuoText_getASCII7Length(text2, &byteCount2))
+	{
+		if (!(flags & kCFCompareCaseInsensitive))
+			return strcmp(text1, text2) < 0;
+
+		const unsigned char *c1 = (const unsigned char *)text1;
+		const unsigned char *c2 = (const unsigned char *)text2;
+		for (; *c1 && tolower(*c1) == tolower(*c2); ++c1, ++c2);
+		return tolower(*c1) < tolower(*c2);
+	}
+
 	CFStringRef s1 = CFStringCreateWithCString(kCFAllocatorDefault, text1, kCFStringEncodingUTF8);
 	if (!s1)
 		return false;
@@ -647,6 +809,243 @@ bool VuoText_compare(VuoText text1, VuoTextComparison comparison, VuoText text2)
 	return match;
 }
 
+/**
+ * Returns a pointer to the first occurrence of the `needleLength` bytes at `needle`
+ * within the `haystackLength` bytes at `haystack`, or NULL if there is none.
+ *
+ * Uses the Two-Way string-matching algorithm (Crochemore and Perrin 1991), which takes linear time
+ * and constant space, so it doesn't slow down on repetitive text the way a naive search does.
+ *
+ * Based on the implementation in musl libc (see license/musl.txt).
+ */
+static const char *VuoText_findBytes(const char *haystack, size_t haystackLength, const char *needle, size_t needleLength)
+{
+	if (needleLength == 0)
+		return haystack;
+	if (haystackLength < needleLength)
+		return NULL;
+
+	// Skip ahead to the first possible match.
+	const unsigned char *h = memchr(haystack, needle[0], haystackLength);
+	if (!h || needleLength == 1)
+		return (const char *)h;
+
+	const unsigned char *z = (const unsigned char *)haystack + haystackLength;
+	const unsigned char *n = (const unsigned char *)needle;
+	size_t l = needleLength;
+
+	// Bytes that occur in the needle, and how far from its start each last occurs.
+	uint64_t byteset[4] = {0};
+	size_t shift[256];
+	for (size_t i = 0; i < l; ++i)
+	{
+		byteset[n[i] / 64] |= 1ULL << (n[i] % 64);
+		shift[n[i]] = i + 1;
+	}
+
+	// Compute the maximal suffix…
+	size_t ip = -1, jp = 0, k = 1, p = 1;
+	while (jp + k < l)
+	{
+		if (n[ip + k] == n[jp + k])
+		{
+			if (k == p)
+			{
+				jp += p;
+				k = 1;
+			}
+			else
+				++k;
+		}
+		else if (n[ip + k] > n[jp + k])
+		{
+			jp += k;
+			k = 1;
+			p = jp - ip;
+		}
+		else
+		{
+			ip = jp++;
+			k = p = 1;
+		}
+	}
+	size_t ms = ip;
+	size_t p0 = p;
+
+	// …and with the opposite comparison.
+	ip = -1; jp = 0; k = p = 1;
+	while (jp + k < l)
+	{
+		if (n[ip + k] == n[jp + k])
+		{
+			if (k == p)
+			{
+				jp += p;
+				k = 1;
+			}
+			else
+				++k;
+		}
+		else if (n[ip + k] < n[jp + k])
+		{
+			jp += k;
+			k = 1;
+			p = jp - ip;
+		}
+		else
+		{
+			ip = jp++;
+			k = p = 1;
+		}
+	}
+	if (ip + 1 > ms + 1)
+		ms = ip;
+	else
+		p = p0;
+
+	// Is the needle periodic?
+	size_t mem0;
+	if (memcmp(n, n + p, ms + 1))
+	{
+		mem0 = 0;
+		p = MAX(ms, l - ms - 1) + 1;
+	}
+	else
+		mem0 = l - p;
+	size_t mem = 0;
+
+	while ((size_t)(z - h) >= l)
+	{
+		// Check the last byte first; on mismatch, advance by the shift table.
+		if (byteset[h[l - 1] / 64] & (1ULL << (h[l - 1] % 64)))
+		{
+			k = l - shift[h[l - 1]];
+			if (k)
+			{
+				if (k < mem)
+					k = mem;
+				h += k;
+				mem = 0;
+				continue;
+			}
+		}
+		else
+		{
+			h += l;
+			mem = 0;
+			continue;
+		}
+
+		// Compare the right half.
+		for (k = MAX(ms + 1, mem); k < l && n[k] == h[k]; ++k);
+		if (k < l)
+		{
+			h += k - ms;
+			mem = 0;
+			continue;
+		}
+
+		// Compare the left half.
+		for (k = ms + 1; k > mem && n[k - 1] == h[k - 1]; --k);
+		if (k <= mem)
+			return (const char *)h;
+		h += p;
+		mem = mem0;
+	}
+
+	return NULL;
+}
+
+/**
+ * State for finding occurrences of one text within another, shared by the `VuoText_find*Occurrence*()` functions.
+ *
+ * If both texts are plain ASCII, each character is one byte, so the search runs directly on the bytes.
+ * Otherwise, each text is converted to a CFString once, and each candidate position is compared in place,
+ * using the same Unicode equivalence as @ref VuoText_areEqual.
+ */
+typedef struct
+{
+	VuoText string;  ///< The text to search within.
+	VuoText substring;  ///< The text to search for.
+	size_t stringLength;  ///< The number of Unicode characters (UTF-16 code units, as in @ref VuoText_length) in `string`.
+	size_t substringLength;  ///< The number of Unicode characters in `substring`.
+	bool isASCII7;  ///< True if both texts are plain ASCII.
+	CFStringRef stringCF;  ///< If not @ref isASCII7, `string` converted to a CFString.
+	CFStringRef substringCF;  ///< If not @ref isASCII7, `substring` converted to a CFString.
+} VuoText_Search;
+
+/**
+ * Prepares to find `substring` (which should be non-empty) in `string`.
+ *
+ * Returns false if either text can't be decoded (in which case there are no occurrences).
+ * Otherwise, call @ref VuoText_endSearch when done.
+ */
+static bool VuoText_beginSearch(VuoText_Search *search, const VuoText string, const VuoText substring)
+{
+	memset(search, 0, sizeof(VuoText_Search));
+	search->string = string;
+	search->substring = substring;
+
+	if (VuoText_getASCII7Length(string, &search->stringLength)
+	 && VuoText_getASCII7Length(substring, &search->substringLength))
+	{
+		search->isASCII7 = true;
+		return true;
+	}
+
+	search->stringCF = CFStringCreateWithCString(kCFAllocatorDefault, string, kCFStringEncodingUTF8);
+	search->substringCF = CFStringCreateWithCString(kCFAllocatorDefault, substring, kCFStringEncodingUTF8);
+	if (!search->stringCF || !search->substringCF)
+	{
+		if (search->stringCF)
+			CFRelease(search->stringCF);
+		if (search->substringCF)
+			CFRelease(search->substringCF);
+		return false;
+	}
+
+	search->stringLength = CFStringGetLength(search->stringCF);
+	search->substringLength = CFStringGetLength(search->substringCF);
+	return true;
+}
+
+/**
+ * Returns the index (starting at 1) of the first occurrence at index >= `startIndex`, or 0 if there is none.
+ */
+static size_t VuoText_searchFrom(VuoText_Search *search, size_t startIndex)
+{
+	if (startIndex < 1)
+		startIndex = 1;
+	if (search->stringLength < search->substringLength
+	 || startIndex > search->stringLength - search->substringLength + 1)
+		return 0;
+
+	if (search->isASCII7)
+	{
+		const char *found = VuoText_findBytes(search->string + startIndex - 1, search->stringLength - (startIndex - 1),
+											  search->substring, search->substringLength);
+		return found ? found - search->string + 1 : 0;
+	}
+
+	for (size_t i = startIndex; i <= search->stringLength - search->substringLength + 1; ++i)
+		if (CFStringCompareWithOptions(search->stringCF, search->substringCF, CFRangeMake(i - 1, search->substringLength),
+									   kCFCompareNonliteral | kCFCompareWidthInsensitive) == kCFCompareEqualTo)
+			return i;
+
+	return 0;
+}
+
+/**
+ * Releases the resources used by `search`.
+ */
+static void VuoText_endSearch(VuoText_Search *search)
+{
+	if (search->stringCF)
+		CFRelease(search->stringCF);
+	if (search->substringCF)
+		CFRelease(search->substringCF);
+}
+
 /**
  * @ingroup VuoText
  * Returns the index (starting at 1) of the first instance of @a substring in @a string
@@ -663,22 +1062,14 @@ size_t VuoText_findFirstOccurrence(const VuoText string, const VuoText substring
 	if (! string)
 		return 0;
 
-	size_t stringLength = VuoText_length(string);
-	size_t substringLength = VuoText_length(substring);
-	if (stringLength < substringLength)
+	VuoText_Search search;
+	if (!VuoText_beginSearch(&search, string, substring))
 		return 0;
 
-	for (size_t i = startIndex; i <= stringLength - substringLength + 1; ++i)
-	{
-		VuoText currSubstring = VuoText_substring(string, i, substringLength);
-		bool found = VuoText_areEqual(substring, currSubstring);
-		VuoRetain(currSubstring);
-		VuoRelease(currSubstring);
-		if (found)
-			return i;
-	}
+	size_t foundIndex = VuoText_searchFrom(&search, startIndex);
 
-	return 0;
+	VuoText_endSearch(&search);
+	return foundIndex;
 }
 
 /**
@@ -702,22 +1093,15 @@ size_t VuoText_findLastOccurrence(const VuoText string, const VuoText substring)
 	if (! string)
 		return 0;
 
-	size_t foundIndex = 0;
-
-	size_t stringLength = VuoText_length(string);
-	size_t substringLength = VuoText_length(substring);
-	if (stringLength < substringLength)
+	VuoText_Search search;
+	if (!VuoText_beginSearch(&search, string, substring))
 		return 0;
 
-	for (size_t i = 1; i <= stringLength - substringLength + 1; ++i)
-	{
-		VuoText currSubstring = VuoText_substring(string, i, substringLength);
-		if (VuoText_areEqual(substring, currSubstring))
-			foundIndex = i;
-		VuoRetain(currSubstring);
-		VuoRelease(currSubstring);
-	}
+	size_t foundIndex = 0;
+	for (size_t i = VuoText_searchFrom(&search, 1); i; i = VuoText_searchFrom(&search, i + 1))
+		foundIndex = i;
 
+	VuoText_endSearch(&search);
 	return foundIndex;
 }
 
@@ -732,20 +1116,21 @@ VuoList_VuoInteger VuoText_findOccurrences(const VuoText string, const VuoText s
 	if (VuoText_isEmpty(string) || VuoText_isEmpty(substring))
 		return NULL;
 
-	size_t stringLength = VuoText_length(string);
-	size_t substringLength = VuoText_length(substring);
-	if (stringLength < substringLength)
+	VuoText_Search search;
+	if (!VuoText_beginSearch(&search, string, substring))
 		return 0;
 
-	VuoList_VuoInteger found = VuoListCreate_VuoInteger();
-	for (size_t i = 1; i <= stringLength - substringLength + 1; ++i)
+	if (search.stringLength < search.substringLength)
 	{
-		VuoText currSubstring = VuoText_substring(string, i, substringLength);
-		VuoLocal(currSubstring);
-		if (VuoText_areEqual(substring, currSubstring))
-			VuoListAppendValue_VuoInteger(found, i);
+		VuoText_endSearch(&search);
+		return 0;
 	}
 
+	VuoList_VuoInteger found = VuoListCreate_VuoInteger();
+	for (size_t i = VuoText_searchFrom(&search, 1); i; i = VuoText_searchFrom(&search, i + 1))
+		VuoListAppendValue_VuoInteger(found, i);
+
+	VuoText_endSearch(&search);
 	return found;
 }
 
@@ -869,6 +1254,65 @@ VuoText VuoText_appendWithSeparator(VuoList_VuoText texts, VuoText separator, bo
 	return compositeText;
 }
 
+/**
+ * Appends a copy of the `byteCount` bytes at `bytes` to `*parts` (which is grown as needed), for @ref VuoText_split.
+ */
+static void VuoText_appendPart(const char *bytes, size_t byteCount, VuoText **parts, size_t *partsCount, size_t *partsCapacity)
+{
+	if (*partsCount == *partsCapacity)
+	{
+		*partsCapacity = *partsCapacity ? *partsCapacity * 2 : 16;
+		*parts = (VuoText *)realloc(*parts, *partsCapacity * sizeof(VuoText));
+	}
+
+	char *part = (char *)malloc(byteCount + 1);
+	memcpy(part, bytes, byteCount);
+	part[byteCount] = 0;
+	(*parts)[(*partsCount)++] = VuoText_makeWithoutCopying(part);
+}
+
+/**
+ * Implements @ref VuoText_split directly on the bytes of `text` and `separator`,
+ * without converting them to CFStrings.
+ *
+ * The separator is matched literally, the same as `CFStringFindWithOptions()` with no options.
+ * For valid UTF-8, a literal byte match is always a whole-character match, so this works for any UTF-8 text
+ * as long as the separator is non-empty.  Splitting into individual characters (empty separator) only works on ASCII text.
+ */
+static VuoText * VuoText_splitBytes(VuoText text, size_t textByteCount, VuoText separator, size_t separatorByteCount, bool includeEmptyParts, size_t *partsCount)
+{
+	VuoText *parts = NULL;
+	size_t partsCapacity = 0;
+	*partsCount = 0;
+
+	if (separatorByteCount > 0)
+	{
+		size_t start = 0;
+		while (start < textByteCount)
+		{
+			const char *found = VuoText_findBytes(text + start, textByteCount - start, separator, separatorByteCount);
+			size_t end = found ? found - text : textByteCount;
+
+			if (end > start || includeEmptyParts)
+				VuoText_appendPart(text + start, end - start, &parts, partsCount, &partsCapacity);
+
+			start = end + separatorByteCount;
+		}
+
+		// If the text ends with the separator, there's an empty part after it.
+		if (includeEmptyParts && textByteCount > 0 && start == textByteCount)
+			VuoText_appendPart("", 0, &parts, partsCount, &partsCapacity);
+	}
+	else
+		for (size_t i = 0; i < textByteCount; ++i)
+			VuoText_appendPart(text + i, 1, &parts, partsCount, &partsCapacity);
+
+	if (!parts)
+		parts = (VuoText *)malloc(0);
+
+	return parts;
+}
+
 /**
  * @ingroup VuoText
  * Splits @a text into parts (basically the inverse of VuoText_append()).
@@ -878,6 +1322,13 @@ VuoText * VuoText_split(VuoText text, VuoText separator, bool includeEmptyParts,
 	if (!text || !separator)
 		return NULL;
 
+	size_t textByteCount, separatorByteCount;
+	VuoText_Encoding textEncoding = VuoText_getEncoding(text, &textByteCount);
+	VuoText_Encoding separatorEncoding = VuoText_getEncoding(separator, &separatorByteCount);
+	if ((textEncoding == VuoText_EncodingASCII && separatorEncoding != VuoText_EncodingOther)
+	 || (textEncoding == VuoText_EncodingUTF8 && separatorEncoding != VuoText_EncodingOther && separatorByteCount > 0))
+		return VuoText_splitBytes(text, textByteCount, separator, separatorByteCount, includeEmptyParts, partsCount);
+
 	CFMutableArrayRef splitTexts = CFArrayCreateMutable(kCFAllocatorDefault, 0, &kCFTypeArrayCallBacks);
 
 	CFStringRef textCF = CFStringCreateWithCString(kCFAllocatorDefault, text, kCFStringEncodingUTF8);
@@ -968,6 +1419,36 @@ VuoText VuoText_replace(VuoText subject, VuoText stringToFind, VuoText replaceme
 	if (!stringToFind)
 		return subject;
 
+	// Optimized replacement for plain ASCII7 text.
+	size_t subjectLength, stringToFindLength;
+	if (stringToFind[0]
+	 && VuoText_getASCII7Length(subject, &subjectLength)
+	 && VuoText_getASCII7Length(stringToFind, &stringToFindLength))
+	{
+		size_t replacementLength = replacement ? strlen(replacement) : 0;
+
+		size_t occurrenceCount = 0;
+		for (const char *found = subject; (found = VuoText_findBytes(found, subjectLength - (found - subject), stringToFind, stringToFindLength)); found += stringToFindLength)
+			++occurrenceCount;
+
+		char *replacedSubject = (char *)malloc(subjectLength + occurrenceCount * replacementLength - occurrenceCount * stringToFindLength + 1);
+		char *dst = replacedSubject;
+		const char *src = subject;
+		for (const char *found; (found = VuoText_findBytes(src, subjectLength - (src - subject), stringToFind, stringToFindLength)); src = found + stringToFindLength)
+		{
+			memcpy(dst, src, found - src);
+			dst += found - src;
+			if (replacementLength)
+				memcpy(dst, replacement, replacementLength);
+			dst += replacementLength;
+		}
+		size_t remainingLength = subjectLength - (src - subject);
+		memcpy(dst, src, remainingLength);
+		dst[remainingLength] = 0;
+
+		return VuoText_makeWithoutCopying(replacedSubject);
+	}
+
 	CFMutableStringRef subjectCF = CFStringCreateMutable(NULL, 0);
 	CFStringAppendCString(subjectCF, subject, kCFStringEncodingUTF8);
 
@@ -1116,12 +1597,8 @@ VuoText VuoText_trim(const VuoText text)
  */
 static bool VuoText_isASCII7(VuoText text)
 {
-	size_t len = strlen(text);
-	for (size_t i = 0; i < len; ++i)
-		if (((unsigned char *)text)[i] > 127)
-			return false;
-
-	return true;
+	size_t len;
+	return VuoText_getASCII7Length(text, &len);
 }
 
 /**
@@ -37,6 +37,7 @@ extern "C"
 typedef const char * VuoText;
 
 #define VuoText_SUPPORTS_COMPARISON  ///< Instances of this type can be compared and sorted.
+#define VuoText_SUPPORTS_HASHING  ///< Instances of this type can be hashed.
 #include "VuoList_VuoText.h"
 
 /**
@@ -60,6 +61,7 @@ VuoText VuoText_makeWithoutCopying(const char *string);
 VuoText VuoText_makeWithMaxLength(const void *data, const size_t maxLength);
 VuoText VuoText_makeFromCFString(const void *cfString);
 VuoText VuoText_makeFromData(const unsigned char *data, const unsigned long size);
+bool VuoText_isValidUtf8(const unsigned char *data, unsigned long size);
 VuoText VuoText_makeFromUtf32(const uint32_t* data, size_t length);
 VuoText VuoText_makeFromMacRoman(const char *string);
 size_t VuoText_length(const VuoText text);
@@ -67,6 +69,7 @@ size_t VuoText_byteCount(const VuoText text);
 bool VuoText_isEmpty(const VuoText text);
 bool VuoText_isPopulated(const VuoText text);
 bool VuoText_areEqual(const VuoText text1, const VuoText text2);
+unsigned long VuoText_hash(const VuoText text);
 bool VuoText_isLessThan(const VuoText text1, const VuoText text2);
 bool VuoText_isLessThanCaseInsensitive(const VuoText text1, const VuoText text2);
 bool VuoText_isLessThanNumeric(const VuoText text1, const VuoText text2);
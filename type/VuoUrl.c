@@ -261,6 +261,14 @@ bool VuoUrl_areEqual(const VuoText a, const VuoText b)
 	return VuoText_areEqual(a,b);
 }
 
+/**
+ * Returns a hash of the URL, consistent with @ref VuoUrl_areEqual.
+ */
+unsigned long VuoUrl_hash(const VuoUrl value)
+{
+	return VuoText_hash(value);
+}
+
 /**
  * Returns true if a < b.
  */
@@ -32,6 +32,7 @@ extern "C"
 typedef VuoText VuoUrl;
 
 #define VuoUrl_SUPPORTS_COMPARISON  ///< Instances of this type can be compared and sorted.
+#define VuoUrl_SUPPORTS_HASHING  ///< Instances of this type can be hashed.
 
 VuoUrl VuoUrl_makeFromJson(struct json_object *js);
 struct json_object *VuoUrl_getJson(const VuoUrl value);
@@ -40,6 +41,7 @@ bool VuoUrl_getParts(const VuoUrl url, VuoText *scheme, VuoText *user, VuoText *
 bool VuoUrl_getFileParts(const VuoUrl url, VuoText *path, VuoText *folder, VuoText *filename, VuoText *extension) VuoWarnUnusedResult;
 
 bool VuoUrl_areEqual(const VuoText a, const VuoText b);
+unsigned long VuoUrl_hash(const VuoUrl value);
 bool VuoUrl_isLessThan(const VuoText a, const VuoText b);
 
 bool VuoUrl_isRelativePath(const VuoUrl url);
@@ -8,8 +8,10 @@
  */
 
 #include <algorithm>
+#include <new>
 #include <string>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 #include "VuoInteger.h"
 #include "VuoText.h"
@@ -31,6 +33,9 @@ extern void VuoGenericType1_release(VuoGenericType1 value);
 extern bool VuoGenericType1_isLessThan(const VuoGenericType1 a, const VuoGenericType1 b);
 extern bool VuoGenericType1_areEqual(const VuoGenericType1 a, const VuoGenericType1 b);
 #endif
+#ifdef VuoGenericType1_SUPPORTS_HASHING
+extern unsigned long VuoGenericType1_hash(const VuoGenericType1 value);
+#endif
 
 extern "C" {
 /// @{
@@ -55,6 +60,16 @@ VuoModuleMetadata({
  */
 void VuoListDestroy_VuoGenericType1(void *list);
 
+/**
+ * Constructs a `std::vector` in reference-counted memory, passing `args` to its constructor.
+ */
+template<typename... Args>
+static std::vector<VuoGenericType1> *VuoListMake_VuoGenericType1(Args&&... args)
+{
+	void *memory = VuoHeap_allocRefCounted(sizeof(std::vector<VuoGenericType1>), VuoListDestroy_VuoGenericType1);
+	return new (memory) std::vector<VuoGenericType1>(std::forward<Args>(args)...);
+}
+
 
 VuoList_VuoGenericType1 VuoList_VuoGenericType1_makeFromJson(json_object *js)
 {
@@ -149,15 +164,13 @@ char * VuoList_VuoGenericType1_getSummary(const VuoList_VuoGenericType1 value)
 
 VuoList_VuoGenericType1 VuoListCreate_VuoGenericType1(void)
 {
-	std::vector<VuoGenericType1> * l = new std::vector<VuoGenericType1>;
-	VuoRegister(l, VuoListDestroy_VuoGenericType1);
+	std::vector<VuoGenericType1> * l = VuoListMake_VuoGenericType1();
 	return reinterpret_cast<VuoList_VuoGenericType1>(l);
 }
 
 VuoList_VuoGenericType1 VuoListCreateWithCount_VuoGenericType1(const unsigned long count, const VuoGenericType1 value)
 {
-	std::vector<VuoGenericType1> * l = new std::vector<VuoGenericType1>(count, value);
-	VuoRegister(l, VuoListDestroy_VuoGenericType1);
+	std::vector<VuoGenericType1> * l = VuoListMake_VuoGenericType1(count, value);
 
 	for (unsigned long i = 0; i < count; ++i)
 		VuoGenericType1_retain(value);
@@ -167,8 +180,7 @@ VuoList_VuoGenericType1 VuoListCreateWithCount_VuoGenericType1(const unsigned lo
 
 VuoList_VuoGenericType1 VuoListCreateWithValueArray_VuoGenericType1(const VuoGenericType1 *values, const unsigned long valueCount)
 {
-	std::vector<VuoGenericType1> *l = new std::vector<VuoGenericType1>(values, values + valueCount);
-	VuoRegister(l, VuoListDestroy_VuoGenericType1);
+	std::vector<VuoGenericType1> *l = VuoListMake_VuoGenericType1(values, values + valueCount);
 
 	for (unsigned long i = 0; i < valueCount; ++i)
 		VuoGenericType1_retain(values[i]);
@@ -183,8 +195,7 @@ VuoList_VuoGenericType1 VuoListCopy_VuoGenericType1(const VuoList_VuoGenericType
 
 	std::vector<VuoGenericType1> *oldList = (std::vector<VuoGenericType1> *)list;
 
-	std::vector<VuoGenericType1> *newList = new std::vector<VuoGenericType1>(*oldList);
-	VuoRegister(newList, VuoListDestroy_VuoGenericType1);
+	std::vector<VuoGenericType1> *newList = VuoListMake_VuoGenericType1(*oldList);
 
 	for (std::vector<VuoGenericType1>::iterator i = newList->begin(); i != newList->end(); ++i)
 		VuoGenericType1_retain(*i);
@@ -199,8 +210,9 @@ void VuoListDestroy_VuoGenericType1(void *list)
 
 	VuoListRemoveAll_VuoGenericType1(reinterpret_cast<VuoList_VuoGenericType1>(list));
 
+	// The memory itself is freed by VuoHeap, since it came from VuoHeap_allocRefCounted().
 	std::vector<VuoGenericType1> * l = (std::vector<VuoGenericType1> *)list;
-	delete l;
+	l->~vector();
 }
 
 VuoGenericType1 VuoListGetValue_VuoGenericType1(const VuoList_VuoGenericType1 list, const unsigned long index)
@@ -451,10 +463,9 @@ VuoList_VuoGenericType1 VuoListSubset_VuoGenericType1(VuoList_VuoGenericType1 li
 	if (clampedStartIndex > clampedEndIndex)
 		return NULL;
 
-	std::vector<VuoGenericType1> *newList = new std::vector<VuoGenericType1>(
+	std::vector<VuoGenericType1> *newList = VuoListMake_VuoGenericType1(
 				l->begin() + clampedStartIndex,
 				l->begin() + clampedEndIndex + 1);
-	VuoRegister(newList, VuoListDestroy_VuoGenericType1);
 
 	for (std::vector<VuoGenericType1>::iterator i = newList->begin(); i != newList->end(); ++i)
 		VuoGenericType1_retain(*i);
@@ -463,6 +474,93 @@ VuoList_VuoGenericType1 VuoListSubset_VuoGenericType1(VuoList_VuoGenericType1 li
 }
 
 #ifdef VuoGenericType1_SUPPORTS_COMPARISON
+/**
+ * A set of items, where items are considered the same if @ref VuoGenericType1_areEqual says so.
+ *
+ * If the item type provides @ref VuoGenericType1_hash, items are bucketed by hash, so each operation takes constant time on average.
+ * Otherwise, each operation compares against every item in the set.
+ */
+class VuoListItemSet_VuoGenericType1
+{
+public:
+	/**
+	 * Creates a set with capacity for `count` items.
+	 */
+	VuoListItemSet_VuoGenericType1(size_t count)
+	{
+#ifdef VuoGenericType1_SUPPORTS_HASHING
+		items.reserve(count);
+#endif
+	}
+
+	/**
+	 * Returns true if the set contains an item equal to `item`.
+	 */
+	bool contains(const VuoGenericType1 &item) const
+	{
+#ifdef VuoGenericType1_SUPPORTS_HASHING
+		auto range = items.equal_range(VuoGenericType1_hash(item));
+		for (auto i = range.first; i != range.second; ++i)
+			if (VuoGenericType1_areEqual(item, i->second))
+				return true;
+#else
+		for (auto i = items.begin(); i != items.end(); ++i)
+			if (VuoGenericType1_areEqual(item, *i))
+				return true;
+#endif
+		return false;
+	}
+
+	/**
+	 * Adds `item` to the set if the set doesn't already contain an equal item.
+	 *
+	 * Returns true if `item` was added.
+	 */
+	bool insert(const VuoGenericType1 &item)
+	{
+#ifdef VuoGenericType1_SUPPORTS_HASHING
+		unsigned long hash = VuoGenericType1_hash(item);
+		auto range = items.equal_range(hash);
+		for (auto i = range.first; i != range.second; ++i)
+			if (VuoGenericType1_areEqual(item, i->second))
+				return false;
+		items.emplace_hint(range.second, hash, item);
+#else
+		if (contains(item))
+			return false;
+		items.push_back(item);
+#endif
+		return true;
+	}
+
+private:
+#ifdef VuoGenericType1_SUPPORTS_HASHING
+	std::unordered_multimap<unsigned long, VuoGenericType1> items;  ///< Each item, keyed by its hash.
+#else
+	std::vector<VuoGenericType1> items;
+#endif
+};
+
+/**
+ * Returns a new list, or NULL if `items` is empty.
+ *
+ * `items` should not yet have been retained; this function retains them.
+ */
+static VuoList_VuoGenericType1 VuoListMakeRetained_VuoGenericType1(std::vector<VuoGenericType1> *items)
+{
+	if (items->empty())
+	{
+		VuoRetain(items);
+		VuoRelease(items);
+		return NULL;
+	}
+
+	for (auto i = items->begin(); i != items->end(); ++i)
+		VuoGenericType1_retain(*i);
+
+	return reinterpret_cast<VuoList_VuoGenericType1>(items);
+}
+
 VuoList_VuoGenericType1 VuoListRemoveDuplicates_VuoGenericType1(VuoList_VuoGenericType1 list)
 {
 	if (!list)
@@ -474,26 +572,81 @@ VuoList_VuoGenericType1 VuoListRemoveDuplicates_VuoGenericType1(VuoList_VuoGener
 	if (size == 0)
 		return NULL;
 
-	auto *newList = new std::vector<VuoGenericType1>;
-	VuoRegister(newList, VuoListDestroy_VuoGenericType1);
+	auto *newList = VuoListMake_VuoGenericType1();
+	VuoListItemSet_VuoGenericType1 seen(size);
 
 	for (auto i = l->begin(); i != l->end(); ++i)
-	{
-		bool found = false;
-		for (auto j = newList->begin(); j != newList->end(); ++j)
-			if (VuoGenericType1_areEqual(*i, *j))
-			{
-				found = true;
-				break;
-			}
-		if (!found)
+		if (seen.insert(*i))
 			newList->push_back(*i);
-	}
 
-	for (auto i = newList->begin(); i != newList->end(); ++i)
-		VuoGenericType1_retain(*i);
+	return VuoListMakeRetained_VuoGenericType1(newList);
+}
 
-	return reinterpret_cast<VuoList_VuoGenericType1>(newList);
+VuoList_VuoGenericType1 VuoListUnion_VuoGenericType1(VuoList_VuoGenericType1 a, VuoList_VuoGenericType1 b)
+{
+	auto *la = (std::vector<VuoGenericType1> *)a;
+	auto *lb = (std::vector<VuoGenericType1> *)b;
+	size_t sizeA = la ? la->size() : 0;
+	size_t sizeB = lb ? lb->size() : 0;
+
+	auto *newList = VuoListMake_VuoGenericType1();
+	VuoListItemSet_VuoGenericType1 seen(sizeA + sizeB);
+
+	if (la)
+		for (auto i = la->begin(); i != la->end(); ++i)
+			if (seen.insert(*i))
+				newList->push_back(*i);
+
+	if (lb)
+		for (auto i = lb->begin(); i != lb->end(); ++i)
+			if (seen.insert(*i))
+				newList->push_back(*i);
+
+	return VuoListMakeRetained_VuoGenericType1(newList);
+}
+
+VuoList_VuoGenericType1 VuoListIntersection_VuoGenericType1(VuoList_VuoGenericType1 a, VuoList_VuoGenericType1 b)
+{
+	auto *la = (std::vector<VuoGenericType1> *)a;
+	auto *lb = (std::vector<VuoGenericType1> *)b;
+	if (!la || !lb || la->empty() || lb->empty())
+		return NULL;
+
+	VuoListItemSet_VuoGenericType1 inB(lb->size());
+	for (auto i = lb->begin(); i != lb->end(); ++i)
+		inB.insert(*i);
+
+	auto *newList = VuoListMake_VuoGenericType1();
+	VuoListItemSet_VuoGenericType1 seen(la->size());
+
+	for (auto i = la->begin(); i != la->end(); ++i)
+		if (inB.contains(*i) && seen.insert(*i))
+			newList->push_back(*i);
+
+	return VuoListMakeRetained_VuoGenericType1(newList);
+}
+
+VuoList_VuoGenericType1 VuoListDifference_VuoGenericType1(VuoList_VuoGenericType1 a, VuoList_VuoGenericType1 b)
+{
+	auto *la = (std::vector<VuoGenericType1> *)a;
+	auto *lb = (std::vector<VuoGenericType1> *)b;
+	if (!la || la->empty())
+		return NULL;
+
+	size_t sizeB = lb ? lb->size() : 0;
+	VuoListItemSet_VuoGenericType1 inB(sizeB);
+	if (lb)
+		for (auto i = lb->begin(); i != lb->end(); ++i)
+			inB.insert(*i);
+
+	auto *newList = VuoListMake_VuoGenericType1();
+	VuoListItemSet_VuoGenericType1 seen(la->size());
+
+	for (auto i = la->begin(); i != la->end(); ++i)
+		if (!inB.contains(*i) && seen.insert(*i))
+			newList->push_back(*i);
+
+	return VuoListMakeRetained_VuoGenericType1(newList);
 }
 #endif
 
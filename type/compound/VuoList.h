@@ -185,9 +185,33 @@ VuoList_VuoGenericType1 VuoListSubset_VuoGenericType1(VuoList_VuoGenericType1 li
  *
  * Items in the new list are retained (not copied) from the original list.
  *
+ * If `VuoGenericType1` supports hashing, this takes linear time; otherwise, quadratic.
+ *
  * @version200New
  */
 VuoList_VuoGenericType1 VuoListRemoveDuplicates_VuoGenericType1(VuoList_VuoGenericType1 list);
+
+/**
+ * Returns a new list containing the unique items that are in @a a or @a b (or both),
+ * in the order they first appear in @a a followed by @a b.
+ *
+ * Items in the new list are retained (not copied) from the original lists.
+ */
+VuoList_VuoGenericType1 VuoListUnion_VuoGenericType1(VuoList_VuoGenericType1 a, VuoList_VuoGenericType1 b);
+
+/**
+ * Returns a new list containing the unique items that are in both @a a and @a b, in the order they first appear in @a a.
+ *
+ * Items in the new list are retained (not copied) from @a a.
+ */
+VuoList_VuoGenericType1 VuoListIntersection_VuoGenericType1(VuoList_VuoGenericType1 a, VuoList_VuoGenericType1 b);
+
+/**
+ * Returns a new list containing the unique items that are in @a a but not in @a b, in the order they first appear in @a a.
+ *
+ * Items in the new list are retained (not copied) from @a a.
+ */
+VuoList_VuoGenericType1 VuoListDifference_VuoGenericType1(VuoList_VuoGenericType1 a, VuoList_VuoGenericType1 b);
 #endif
 
 /**
@@ -181,6 +181,23 @@ bool MyType_isLessThan(const MyType a, const MyType b);
  */
 #define MyType_SUPPORTS_COMPARISON
 
+/**
+ * Returns a hash of @a value.
+ *
+ * Values for which @ref MyType_areEqual returns true must have the same hash. (Types whose @ref MyType_areEqual
+ * allows a tolerance, such as VuoReal, can't satisfy this, so shouldn't implement this function.)
+ *
+ * This function is optional. If the type supports comparison and implements this function, then
+ * `VuoList_MyType` functions that search for equal items (such as removing duplicates) take linear time instead of quadratic.
+ */
+unsigned long MyType_hash(const MyType value);
+
+/**
+ * Tells the Vuo compiler that @ref MyType_hash is defined, so that it can enable functionality
+ * in `VuoList_MyType` that depends on it.
+ */
+#define MyType_SUPPORTS_HASHING
+
 /**
  * Serializes a @c MyType value to a JSON-formatted string. Calls MyType_getJson().
  *